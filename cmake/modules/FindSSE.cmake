@@ -29,6 +29,7 @@ option(ENABLE_AVX    "Enable compile-time AVX support."    ON)
 option(ENABLE_AVX2   "Enable compile-time AVX2 support."   ON)
 option(ENABLE_FMA    "Enable compile-time FMA support."    ON)
 option(ENABLE_AVX512 "Enable compile-time AVX512 support." ON)
+option(ENABLE_AESNI  "Enable compile-time AES-NI support."  ON)
 
 if (ENABLE_SSE)
     #
@@ -204,7 +205,39 @@ if (ENABLE_SSE)
         endif ()
     endif()
 
+    if (ENABLE_AESNI)
+
+        #
+        # Check compiler for AES-NI intrinsics
+        #
+        if (CMAKE_COMPILER_IS_GNUCC OR (CMAKE_C_COMPILER_ID MATCHES "Clang") OR (CMAKE_CXX_COMPILER_ID MATCHES "Clang"))
+            set(CMAKE_REQUIRED_FLAGS "-maes")
+            check_c_source_runs("
+            #include <wmmintrin.h>
+            int main()
+            {
+              __m128i a;
+              const int src[4] = { 0x0, 0x0, 0x0, 0x0 };
+              int dst[4];
+              a = _mm_loadu_si128( (__m128i*)src );
+              a = _mm_aesenclast_si128( a, a );
+              _mm_storeu_si128( (__m128i*)dst, a );
+              int i = 0;
+              for( i = 0; i < 4; i++ ){
+                if( dst[i] != 0x63636363 ){
+                  return -1;
+                }
+              }
+              return 0;
+            }"
+                    HAVE_AESNI)
+        endif()
+
+        if (HAVE_AESNI)
+            message(STATUS "AES-NI is enabled - target CPU must support it")
+        endif()
+    endif()
 
 endif()
 
-mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512)
+mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512, HAVE_AESNI)
@@ -67,22 +67,27 @@ float rf_gain = 70.0;
 char* rf_args = "";
 char* rf_dev  = "";
 
+double   wb_srate    = 0.0;
+uint32_t nof_threads = 4;
+
 void usage(char* prog)
 {
-  printf("Usage: %s [agsendtvb] -b band\n", prog);
+  printf("Usage: %s [agsendwtvb] -b band\n", prog);
   printf("\t-a RF args [Default %s]\n", rf_args);
   printf("\t-d RF devicename [Default %s]\n", rf_dev);
   printf("\t-g RF gain [Default %.2f dB]\n", rf_gain);
   printf("\t-s earfcn_start [Default All]\n");
   printf("\t-e earfcn_end [Default All]\n");
   printf("\t-n nof_frames_total [Default 100]\n");
+  printf("\t-w search several EARFCN at once in captures at this sampling rate in Hz [Default disabled]\n");
+  printf("\t-t number of wideband search threads [Default %d]\n", nof_threads);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "agsendvb")) != -1) {
+  while ((opt = getopt(argc, argv, "agsendwtvb")) != -1) {
     switch (opt) {
       case 'a':
         rf_args = argv[optind];
@@ -105,6 +110,12 @@ void parse_args(int argc, char** argv)
       case 'g':
         rf_gain = strtof(argv[optind], NULL);
         break;
+      case 'w':
+        wb_srate = strtod(argv[optind], NULL);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -140,6 +151,119 @@ static SRSRAN_AGC_CALLBACK(srsran_rf_set_rx_gain_wrapper)
   srsran_rf_set_rx_gain((srsran_rf_t*)h, gain_db);
 }
 
+/* Decodes the MIB of the cells found in a channel, the RF device shall be tuned to it */
+static int decode_cells(srsran_rf_t*                         rf,
+                        const srsran_ue_cellsearch_result_t* found_cells,
+                        const srsran_earfcn_t*               channel,
+                        uint32_t*                            n_found_cells)
+{
+  for (int i = 0; i < SRSRAN_NOF_NID_2; i++) {
+    if (found_cells[i].psr > 2.0) {
+      srsran_cell_t cell;
+      cell.id = found_cells[i].cell_id;
+      cell.cp = found_cells[i].cp;
+      int ret = rf_mib_decoder(rf, 1, &cell_detect_config, &cell, NULL);
+      if (ret < 0) {
+        ERROR("Error decoding MIB");
+        return SRSRAN_ERROR;
+      }
+      if (ret == SRSRAN_UE_MIB_FOUND) {
+        printf("Found CELL ID %d. %d PRB, %d ports\n", cell.id, cell.nof_prb, cell.nof_ports);
+        if (cell.nof_ports > 0) {
+          results[*n_found_cells].cell      = cell;
+          results[*n_found_cells].freq      = channel->fd;
+          results[*n_found_cells].dl_earfcn = channel->id;
+          results[*n_found_cells].power     = found_cells[i].peak;
+          (*n_found_cells)++;
+        }
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/* Searches all the EARFCN that fit in a capture at once, then decodes the MIB of the cells found one by one */
+static int search_wideband(srsran_rf_t* rf, const srsran_earfcn_t* channels, int nof_freqs, uint32_t* n_found_cells)
+{
+  srsran_ue_cellsearch_wb_t        cs_wb                                     = {};
+  srsran_ue_cellsearch_wb_args_t   args                                      = {};
+  srsran_ue_cellsearch_wb_result_t wb_results[SRSRAN_CS_WB_MAX_CARRIERS]     = {};
+  double                           freq_offset_hz[SRSRAN_CS_WB_MAX_CARRIERS] = {};
+  int                              ret                                       = SRSRAN_ERROR;
+
+  // Capture as many 5 ms frames as the narrowband search would look at for each EARFCN
+  uint32_t nsamples = (uint32_t)(wb_srate * FLEN_PERIOD) * cell_detect_config.max_frames_pss;
+  cf_t*    buffer   = srsran_vec_cf_malloc(nsamples);
+  if (buffer == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  args.srate_hz     = wb_srate;
+  args.max_nsamples = nsamples;
+  args.nof_threads  = nof_threads;
+  if (srsran_ue_cellsearch_wb_init(&cs_wb, &args)) {
+    ERROR("Error initiating wideband cell search");
+    goto clean_exit;
+  }
+
+  // The search bandwidth of the carriers at the edges shall fit in the capture
+  double max_span_hz = wb_srate - SRSRAN_CS_SAMP_FREQ;
+
+  int last = 0;
+  for (int first = 0; first < nof_freqs && !go_exit; first = last) {
+    last = first + 1;
+    while (last < nof_freqs && last - first < SRSRAN_CS_WB_MAX_CARRIERS &&
+           (channels[last].fd - channels[first].fd) * MHZ <= max_span_hz) {
+      last++;
+    }
+
+    double center_hz = (channels[first].fd + channels[last - 1].fd) / 2 * MHZ;
+    for (int i = first; i < last; i++) {
+      freq_offset_hz[i - first] = channels[i].fd * MHZ - center_hz;
+    }
+
+    printf("[%3d/%d]: EARFCN %d to %d looking for PSS at %.2f MHz.\n",
+           first,
+           nof_freqs,
+           channels[first].id,
+           channels[last - 1].id,
+           center_hz / MHZ);
+    fflush(stdout);
+
+    srsran_rf_set_rx_freq(rf, 0, center_hz);
+    srsran_rf_set_rx_srate(rf, wb_srate);
+    srsran_rf_start_rx_stream(rf, false);
+    int n = srsran_rf_recv_with_time(rf, buffer, nsamples, true, NULL, NULL);
+    srsran_rf_stop_rx_stream(rf);
+    if (n < 0) {
+      ERROR("Error receiving samples");
+      goto clean_exit;
+    }
+
+    n = srsran_ue_cellsearch_wb_scan(&cs_wb, buffer, (uint32_t)n, freq_offset_hz, last - first, wb_results);
+    if (n < 0) {
+      ERROR("Error searching cell");
+      goto clean_exit;
+    }
+
+    for (int i = first; i < last && n > 0; i++) {
+      if (wb_results[i - first].nof_cells == 0) {
+        continue;
+      }
+      srsran_rf_set_rx_freq(rf, 0, (double)channels[i].fd * MHZ);
+      if (decode_cells(rf, wb_results[i - first].cells, &channels[i], n_found_cells)) {
+        goto clean_exit;
+      }
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ue_cellsearch_wb_free(&cs_wb);
+  free(buffer);
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   int                           n;
@@ -150,6 +274,7 @@ int main(int argc, char** argv)
   srsran_earfcn_t               channels[MAX_EARFCN];
   uint32_t                      freq;
   uint32_t                      n_found_cells = 0;
+  struct timeval                t[3]          = {};
 
   srsran_debug_handle_crash(argc, argv);
 
@@ -204,7 +329,13 @@ int main(int argc, char** argv)
                              cell_detect_config.init_agc);
   }
 
-  for (freq = 0; freq < nof_freqs && !go_exit; freq++) {
+  gettimeofday(&t[1], NULL);
+
+  if (wb_srate > 0 && search_wideband(&rf, channels, nof_freqs, &n_found_cells)) {
+    exit(-1);
+  }
+
+  for (freq = 0; freq < nof_freqs && !go_exit && wb_srate <= 0; freq++) {
     /* set rf_freq */
     srsran_rf_set_rx_freq(&rf, 0, (double)channels[freq].fd * MHZ);
     INFO("Set rf_freq to %.3f MHz", (double)channels[freq].fd * MHZ / 1000000);
@@ -229,32 +360,16 @@ int main(int argc, char** argv)
       ERROR("Error searching cell");
       exit(-1);
     } else if (n > 0) {
-      for (int i = 0; i < 3; i++) {
-        if (found_cells[i].psr > 2.0) {
-          srsran_cell_t cell;
-          cell.id = found_cells[i].cell_id;
-          cell.cp = found_cells[i].cp;
-          int ret = rf_mib_decoder(&rf, 1, &cell_detect_config, &cell, NULL);
-          if (ret < 0) {
-            ERROR("Error decoding MIB");
-            exit(-1);
-          }
-          if (ret == SRSRAN_UE_MIB_FOUND) {
-            printf("Found CELL ID %d. %d PRB, %d ports\n", cell.id, cell.nof_prb, cell.nof_ports);
-            if (cell.nof_ports > 0) {
-              results[n_found_cells].cell      = cell;
-              results[n_found_cells].freq      = channels[freq].fd;
-              results[n_found_cells].dl_earfcn = channels[freq].id;
-              results[n_found_cells].power     = found_cells[i].peak;
-              n_found_cells++;
-            }
-          }
-        }
+      if (decode_cells(&rf, found_cells, &channels[freq], &n_found_cells)) {
+        exit(-1);
       }
     }
   }
 
-  printf("\n\nFound %d cells\n", n_found_cells);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  printf("\n\nFound %d cells in %.1f s\n", n_found_cells, t[0].tv_sec + t[0].tv_usec / 1e6);
   for (int i = 0; i < n_found_cells; i++) {
     printf("Found CELL %.1f MHz, EARFCN=%d, PHYID=%d, %d PRB, %d ports, PSS power=%.1f dBm\n",
            results[i].freq,
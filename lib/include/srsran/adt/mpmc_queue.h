@@ -0,0 +1,148 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MPMC_QUEUE_H
+#define SRSRAN_MPMC_QUEUE_H
+
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace srsran {
+
+/**
+ * Bounded lock-free queue for any number of producers and consumers.
+ *
+ * Every cell carries a sequence number that tells whether it is free for the producer of a given position, or
+ * written for the consumer of that position. Producers and consumers only contend on the CAS of their own position
+ * counter, and a push or pop never waits for another thread, it fails when the queue is full or empty.
+ * @tparam T Type of the elements, default constructible and move assignable
+ */
+template <typename T>
+class mpmc_bounded_queue
+{
+public:
+  /// @param capacity Maximum number of elements, rounded up to a power of two
+  explicit mpmc_bounded_queue(size_t capacity)
+  {
+    srsran_assert(capacity > 0, "Invalid queue capacity");
+    size_t n = 1;
+    while (n < capacity) {
+      n *= 2;
+    }
+    mask  = n - 1;
+    cells = std::unique_ptr<cell_t[]>(new cell_t[n]);
+    for (size_t i = 0; i < n; ++i) {
+      cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  mpmc_bounded_queue(const mpmc_bounded_queue&) = delete;
+  mpmc_bounded_queue& operator=(const mpmc_bounded_queue&) = delete;
+
+  size_t capacity() const { return mask + 1; }
+
+  /// Approximate number of elements, exact only when no other thread pushes or pops
+  size_t size() const
+  {
+    size_t head = dequeue_pos.load(std::memory_order_relaxed);
+    size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+    return tail >= head ? tail - head : 0;
+  }
+  bool empty() const { return size() == 0; }
+
+  /// Pushes an element, the element is left untouched when the queue is full
+  bool try_push(T&& t)
+  {
+    cell_t* cell = nullptr;
+    size_t  pos  = enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell         = &cells[pos & mask];
+      size_t   seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t df  = (intptr_t)seq - (intptr_t)pos;
+      if (df == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (df < 0) {
+        // The cell still holds the element of the previous lap
+        return false;
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(t);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+  bool try_push(const T& t)
+  {
+    T copy = t;
+    return try_push(std::move(copy));
+  }
+
+  /// Pops the oldest element, returns false when the queue is empty
+  bool try_pop(T& t)
+  {
+    cell_t* cell = nullptr;
+    size_t  pos  = dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell         = &cells[pos & mask];
+      size_t   seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t df  = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (df == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (df < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    t = std::move(cell->value);
+    // Release the resources of the moved-from element before handing the cell to the producer of the next lap
+    cell->value = T{};
+    cell->seq.store(pos + mask + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  struct cell_t {
+    std::atomic<size_t> seq;
+    T                   value;
+  };
+
+  // The positions are padded to separate cache lines, so that the producers do not invalidate the line of the consumers
+  static const size_t cache_line_size = 64;
+
+  std::atomic<size_t>       enqueue_pos{0};
+  char                      pad0[cache_line_size - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t>       dequeue_pos{0};
+  char                      pad1[cache_line_size - sizeof(std::atomic<size_t>)];
+  size_t                    mask = 0;
+  std::unique_ptr<cell_t[]> cells;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_MPMC_QUEUE_H
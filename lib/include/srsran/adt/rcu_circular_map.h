@@ -0,0 +1,272 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSRAN_RCU_CIRCULAR_MAP_H
+#define SRSRAN_RCU_CIRCULAR_MAP_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Epoch based deferred reclamation for data structures read without locks.
+ *
+ * Readers mark the epoch they entered in a record of their own, so that they never write to a cache line shared
+ * with other threads. A writer that unlinks an object advances the epoch, and the object can be freed once all the
+ * readers are out or entered after the advance. The threads beyond max_readers share a counter, and while any of them
+ * is inside nothing is freed.
+ */
+class rcu_domain
+{
+public:
+  static const uint32_t max_readers = 64;
+
+  rcu_domain()                  = default;
+  rcu_domain(const rcu_domain&) = delete;
+  rcu_domain& operator=(const rcu_domain&) = delete;
+
+  /// Enters a read-side critical section. Sections may be nested
+  void read_lock()
+  {
+    int idx = get_reader_idx();
+    if (idx < 0) {
+      overflow_readers.fetch_add(1, std::memory_order_relaxed);
+    } else if (readers[idx].nesting++ == 0) {
+      readers[idx].epoch.store(global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    } else {
+      return;
+    }
+    // The entry must be visible to the writers before the protected pointers are read
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  void read_unlock()
+  {
+    int idx = get_reader_idx();
+    if (idx < 0) {
+      overflow_readers.fetch_sub(1, std::memory_order_release);
+      return;
+    }
+    reader_t& r = readers[idx];
+    if (--r.nesting == 0) {
+      r.epoch.store(0, std::memory_order_release);
+    }
+  }
+
+  /// Called by the writer after unlinking objects. Returns the epoch from which they are no longer reachable
+  uint64_t advance_epoch() { return global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1; }
+
+  /// Whether all the readers that could have reached objects unlinked before the given epoch are gone
+  bool is_grace_period_over(uint64_t epoch) const
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (overflow_readers.load(std::memory_order_relaxed) > 0) {
+      return false;
+    }
+    for (const reader_t& r : readers) {
+      uint64_t e = r.epoch.load(std::memory_order_acquire);
+      if (e != 0 and e < epoch) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  struct reader_t {
+    std::atomic<uint64_t> epoch{0}; ///< epoch at the entry to the read-side section, or 0 when out of it
+    uint32_t              nesting = 0;
+    char                  padding[64 - sizeof(std::atomic<uint64_t>) - sizeof(uint32_t)];
+  };
+
+  /// Record index of the calling thread, shared by all domains. It is released when the thread exits
+  static int get_reader_idx()
+  {
+    struct registration_t {
+      registration_t()
+      {
+        for (uint32_t i = 0; i < max_readers; ++i) {
+          bool expected = false;
+          if (get_registry()[i].compare_exchange_strong(expected, true, std::memory_order_relaxed)) {
+            idx = i;
+            break;
+          }
+        }
+      }
+      ~registration_t()
+      {
+        if (idx >= 0) {
+          get_registry()[idx].store(false, std::memory_order_relaxed);
+        }
+      }
+      int idx = -1;
+    };
+    thread_local registration_t registration;
+    return registration.idx;
+  }
+  static std::array<std::atomic<bool>, max_readers>& get_registry()
+  {
+    static std::array<std::atomic<bool>, max_readers> registry = {};
+    return registry;
+  }
+
+  std::atomic<uint64_t>             global_epoch{1};
+  std::atomic<uint32_t>             overflow_readers{0};
+  std::array<reader_t, max_readers> readers;
+};
+
+/// Read-side critical section of a rcu_domain, until out of scope
+class rcu_read_guard
+{
+public:
+  explicit rcu_read_guard(rcu_domain& domain_) : domain(domain_) { domain.read_lock(); }
+  ~rcu_read_guard() { domain.read_unlock(); }
+  rcu_read_guard(const rcu_read_guard&) = delete;
+  rcu_read_guard& operator=(const rcu_read_guard&) = delete;
+
+private:
+  rcu_domain& domain;
+};
+
+/**
+ * Map of objects indexed by their key modulo N, as static_circular_map, with lookups that take no lock.
+ *
+ * Readers look up and use the objects within a read-side critical section of the map domain (see rcu_read_guard).
+ * Insertions and removals must be serialized by the caller, but they never wait for the readers: the objects removed
+ * are kept until reclaim() finds that no reader that could have found them is left.
+ * @tparam K unsigned integer key
+ * @tparam T type of the objects, owned by the map
+ */
+template <typename K, typename T, size_t N>
+class rcu_circular_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+
+public:
+  rcu_circular_map()                        = default;
+  rcu_circular_map(const rcu_circular_map&) = delete;
+  rcu_circular_map& operator=(const rcu_circular_map&) = delete;
+  ~rcu_circular_map()
+  {
+    // No reader is left at this point
+    for (std::atomic<node_t*>& slot : slots) {
+      delete slot.load(std::memory_order_relaxed);
+    }
+    for (retired_node_t& r : retired) {
+      delete r.node;
+    }
+  }
+
+  rcu_domain& get_domain() { return domain; }
+
+  /// Object of the key, or nullptr. Called within a read-side critical section, until which end the object is kept
+  T* find(K key) const
+  {
+    node_t* node = slots[key % N].load(std::memory_order_acquire);
+    return (node != nullptr and node->key == key) ? node->obj.get() : nullptr;
+  }
+  bool contains(K key) const { return find(key) != nullptr; }
+
+  /// Visits the objects in the map. Called within a read-side critical section
+  template <typename F>
+  void for_each(F&& f) const
+  {
+    for (const std::atomic<node_t*>& slot : slots) {
+      node_t* node = slot.load(std::memory_order_acquire);
+      if (node != nullptr) {
+        f(node->key, *node->obj);
+      }
+    }
+  }
+
+  // Writer interface, serialized by the caller
+
+  bool insert(K key, std::unique_ptr<T> obj)
+  {
+    std::atomic<node_t*>& slot = slots[key % N];
+    if (slot.load(std::memory_order_relaxed) != nullptr) {
+      return false;
+    }
+    slot.store(new node_t{key, std::move(obj)}, std::memory_order_release);
+    count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Unlinks the object of the key. It is freed by a later call to reclaim()
+  bool erase(K key)
+  {
+    std::atomic<node_t*>& slot = slots[key % N];
+    node_t*               node = slot.load(std::memory_order_relaxed);
+    if (node == nullptr or node->key != key) {
+      return false;
+    }
+    slot.store(nullptr, std::memory_order_relaxed);
+    retired.push_back(retired_node_t{domain.advance_epoch(), node});
+    count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Frees the removed objects that no reader can hold anymore. Returns the number of objects still pending
+  size_t reclaim()
+  {
+    size_t kept = 0;
+    for (retired_node_t& r : retired) {
+      if (domain.is_grace_period_over(r.epoch)) {
+        delete r.node;
+      } else {
+        retired[kept++] = r;
+      }
+    }
+    retired.resize(kept);
+    return kept;
+  }
+
+  bool   has_space(K key) const { return slots[key % N].load(std::memory_order_relaxed) == nullptr; }
+  size_t size() const { return count.load(std::memory_order_relaxed); }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() == N; }
+  size_t capacity() const { return N; }
+
+private:
+  struct node_t {
+    K                  key;
+    std::unique_ptr<T> obj;
+  };
+  struct retired_node_t {
+    uint64_t epoch;
+    node_t*  node;
+  };
+
+  rcu_domain                          domain;
+  std::array<std::atomic<node_t*>, N> slots = {};
+  std::atomic<size_t>                 count{0};
+  std::vector<retired_node_t>         retired;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RCU_CIRCULAR_MAP_H
@@ -22,14 +22,18 @@
 #ifndef SRSASN_COMMON_UTILS_H
 #define SRSASN_COMMON_UTILS_H
 
+#include "srsran/adt/pool/linear_allocator.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/support/srsran_assert.h"
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace asn1 {
 
@@ -184,6 +188,148 @@ public:
   SRSASN_CODE align_bytes_zero();
 };
 
+/*********************
+     memory arena
+*********************/
+
+/**
+ * Bump-pointer memory arena for decoded message trees. While an arena_scope is active in a thread, the dynamic
+ * containers of the ASN.1 types (dyn_array, ext_array and copy_ptr) allocate from the installed arena instead of the
+ * heap. Deallocations only update a counter, and the memory is released in one go by reset() or the destructor.
+ * Objects allocated from an arena must be destroyed before the arena is reset or destroyed.
+ */
+class mem_arena
+{
+public:
+  explicit mem_arena(size_t block_size_ = 16384) : block_size(block_size_) {}
+  mem_arena(const mem_arena&) = delete;
+  mem_arena& operator=(const mem_arena&) = delete;
+  ~mem_arena();
+
+  void* allocate(size_t sz, size_t alignment);
+  void  deallocate(void* p);
+
+  /// Makes all the arena memory available again. All the objects allocated from the arena must have been destroyed
+  void reset();
+
+  uint32_t nof_allocations() const { return nof_allocs; }
+  uint32_t nof_live_allocations() const { return nof_live; }
+  size_t   nof_bytes_allocated() const;
+  uint32_t nof_blocks() const { return blocks.size(); }
+
+private:
+  struct block_t {
+    std::unique_ptr<uint8_t[]> mem;
+    srsran::linear_allocator   alloc;
+  };
+
+  size_t               block_size;
+  std::vector<block_t> blocks;
+  uint32_t             cur_block  = 0;
+  uint32_t             nof_allocs = 0;
+  uint32_t             nof_live   = 0;
+};
+
+/// Installs an arena for the ASN.1 container allocations of the current thread until the scope ends
+class arena_scope
+{
+public:
+  explicit arena_scope(mem_arena& arena);
+  arena_scope(const arena_scope&) = delete;
+  arena_scope& operator=(const arena_scope&) = delete;
+  ~arena_scope();
+
+private:
+  mem_arena* prev;
+};
+
+/// Number of ASN.1 container allocations of the current thread, split by origin. Only counted once enabled
+struct alloc_stats_t {
+  uint32_t nof_heap_allocs  = 0;
+  uint32_t nof_arena_allocs = 0;
+};
+
+const alloc_stats_t& get_alloc_stats();
+void                 reset_alloc_stats();
+/// The counting is disabled by default, so that the allocations only pay for a relaxed load
+void set_alloc_stats_enabled(bool enabled);
+
+namespace detail {
+
+extern std::atomic<bool> alloc_stats_enabled;
+
+mem_arena* get_current_arena();
+void       count_alloc_enabled(const mem_arena* arena);
+
+inline void count_alloc(const mem_arena* arena)
+{
+  if (alloc_stats_enabled.load(std::memory_order_relaxed)) {
+    count_alloc_enabled(arena);
+  }
+}
+
+/// Header that precedes every dyn_array/ext_array buffer, it identifies who owns the memory
+struct alignas(16) array_header_t {
+  mem_arena* arena;
+  uint32_t   count;
+};
+
+void* allocate_array_mem(size_t sz);
+void  deallocate_array_mem(array_header_t* hdr);
+
+template <class T>
+T* new_array(uint32_t count)
+{
+  static_assert(alignof(T) <= alignof(array_header_t), "Unsupported alignment for ASN.1 array elements");
+  if (count == 0) {
+    return nullptr;
+  }
+  auto* hdr  = static_cast<array_header_t*>(allocate_array_mem(sizeof(array_header_t) + sizeof(T) * count));
+  hdr->count = count;
+  T* data    = reinterpret_cast<T*>(hdr + 1);
+  for (uint32_t i = 0; i < count; ++i) {
+    new (&data[i]) T;
+  }
+  return data;
+}
+
+template <class T>
+void delete_array(T* data)
+{
+  if (data == nullptr) {
+    return;
+  }
+  array_header_t* hdr = reinterpret_cast<array_header_t*>(data) - 1;
+  for (uint32_t i = 0; i < hdr->count; ++i) {
+    data[i].~T();
+  }
+  deallocate_array_mem(hdr);
+}
+
+template <class T, class... Args>
+T* new_obj(mem_arena*& arena, Args&&... args)
+{
+  arena = get_current_arena();
+  count_alloc(arena);
+  if (arena == nullptr) {
+    return new T(std::forward<Args>(args)...);
+  }
+  return new (arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+}
+
+template <class T>
+void delete_obj(T* p, mem_arena* arena)
+{
+  if (arena == nullptr) {
+    delete p;
+    return;
+  }
+  p->~T();
+  arena->deallocate(p);
+}
+
+} // namespace detail
+
 /*********************
   function helpers
 *********************/
@@ -196,25 +342,20 @@ public:
   using const_iterator = const T*;
 
   dyn_array() = default;
-  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = new T[size_]; }
+  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = detail::new_array<T>(size_); }
   dyn_array(const dyn_array<T>& other) : dyn_array(&other[0], other.size_) {}
   dyn_array(const T* ptr, uint32_t nof_items)
   {
     size_ = nof_items;
     cap_  = nof_items;
     if (ptr != NULL) {
-      data_ = new T[cap_];
+      data_ = detail::new_array<T>(cap_);
       std::copy(ptr, ptr + size_, data_);
     } else {
       data_ = NULL;
     }
   }
-  ~dyn_array()
-  {
-    if (data_ != NULL) {
-      delete[] data_;
-    }
-  }
+  ~dyn_array() { detail::delete_array(data_); }
   uint32_t      size() const { return size_; }
   uint32_t      capacity() const { return cap_; }
   T&            operator[](uint32_t idx) { return data_[idx]; }
@@ -241,7 +382,7 @@ public:
     T* old_data = data_;
     cap_        = new_size > new_cap ? new_size : new_cap;
     if (cap_ > 0) {
-      data_ = new T[cap_];
+      data_ = detail::new_array<T>(cap_);
       if (old_data != NULL) {
         srsran_assert(cap_ > size_, "Old size larger than new capacity in dyn_array\n");
         std::copy(&old_data[0], &old_data[size_], data_);
@@ -250,9 +391,7 @@ public:
       data_ = NULL;
     }
     size_ = new_size;
-    if (old_data != NULL) {
-      delete[] old_data;
-    }
+    detail::delete_array(old_data);
   }
   iterator erase(iterator it)
   {
@@ -366,7 +505,7 @@ public:
   ~ext_array()
   {
     if (not is_in_small_buffer()) {
-      delete[] head;
+      detail::delete_array(head);
     }
   }
   ext_array<T, Nthres>& operator=(const ext_array<T, Nthres>& other)
@@ -406,11 +545,11 @@ public:
     }
     T*       old_data = head;
     uint32_t newcap   = new_size + 5;
-    head              = new T[newcap];
-    std::copy(&small_buffer.data[0], &small_buffer.data[size_], head);
+    head              = detail::new_array<T>(newcap);
+    std::copy(&old_data[0], &old_data[size_], head);
     size_ = new_size;
     if (old_data != &small_buffer.data[0]) {
-      delete[] old_data;
+      detail::delete_array(old_data);
     }
     small_buffer.cap_ = newcap;
   }
@@ -1166,20 +1305,30 @@ class copy_ptr
 public:
   copy_ptr() : ptr(nullptr) {}
   explicit copy_ptr(T* ptr_) : ptr(ptr_) {}
-  copy_ptr(copy_ptr<T>&& other) noexcept : ptr(other.ptr) { other.ptr = nullptr; }
-  copy_ptr(const copy_ptr<T>& other) { ptr = (other.ptr == nullptr) ? nullptr : new T(*other.ptr); }
+  copy_ptr(copy_ptr<T>&& other) noexcept : ptr(other.ptr), arena(other.arena) { other.ptr = nullptr; }
+  copy_ptr(const copy_ptr<T>& other) : ptr(nullptr)
+  {
+    if (other.ptr != nullptr) {
+      ptr = detail::new_obj<T>(arena, *other.ptr);
+    }
+  }
   ~copy_ptr() { destroy_(); }
   copy_ptr<T>& operator=(const copy_ptr<T>& other)
   {
     if (this != &other) {
-      reset((other.ptr == nullptr) ? nullptr : new T(*other.ptr));
+      destroy_();
+      if (other.ptr != nullptr) {
+        ptr = detail::new_obj<T>(arena, *other.ptr);
+      }
     }
     return *this;
   }
   copy_ptr<T>& operator=(copy_ptr<T>&& other) noexcept
   {
     if (this != &other) {
+      destroy_();
       ptr       = other.ptr;
+      arena     = other.arena;
       other.ptr = nullptr;
     }
     return *this;
@@ -1194,7 +1343,12 @@ public:
   T*       release()
   {
     T* ret = ptr;
-    ptr    = nullptr;
+    if (arena != nullptr and ptr != nullptr) {
+      // The caller takes ownership with delete, so the object has to leave the arena
+      ret = new T(std::move(*ptr));
+      destroy_();
+    }
+    ptr = nullptr;
     return ret;
   }
   void reset(T* ptr_ = nullptr)
@@ -1204,10 +1358,9 @@ public:
   }
   void set_present(bool flag = true)
   {
+    destroy_();
     if (flag) {
-      reset(new T());
-    } else {
-      reset();
+      ptr = detail::new_obj<T>(arena);
     }
   }
   bool is_present() const { return get() != nullptr; }
@@ -1216,10 +1369,13 @@ private:
   void destroy_()
   {
     if (ptr != NULL) {
-      delete ptr;
+      detail::delete_obj(ptr, arena);
     }
+    ptr   = nullptr;
+    arena = nullptr;
   }
-  T* ptr;
+  T*         ptr;
+  mem_arena* arena = nullptr; ///< Arena that owns ptr, nullptr if it was allocated with new
 };
 
 template <class T>
@@ -1874,6 +2030,63 @@ public:
   }
 };
 
+/**
+ * Lazily decoded S1AP/NGAP PDU. unpack() only parses the envelope that both protocols share (PDU type, procedure code
+ * and criticality) and indexes the protocol IEs of the elementary procedure message, without decoding their values.
+ * IEs are then decoded on access with unpack_ie(), and the full PDU can still be decoded with unpack_pdu().
+ * The view points to the encoded buffer, which must outlive it.
+ */
+class ap_pdu_view
+{
+public:
+  static const uint32_t max_nof_ies = 32;
+
+  struct ie_t {
+    uint16_t id;
+    uint8_t  crit;
+    uint32_t offset; ///< Byte offset of the encoded IE value in the PDU buffer
+    uint32_t len;
+  };
+
+  SRSASN_CODE unpack(const uint8_t* buf_, uint32_t nof_bytes_);
+
+  /// Index of the PDU CHOICE, i.e. 0=initiatingMessage, 1=successfulOutcome and 2=unsuccessfulOutcome
+  uint8_t     pdu_type() const { return type_; }
+  uint16_t    proc_code() const { return proc_code_; }
+  uint8_t     crit() const { return crit_; }
+  bool        ext() const { return ext_; }
+  uint32_t    nof_ies() const { return ies.size(); }
+  const ie_t& ie(uint32_t idx) const { return ies[idx]; }
+  const ie_t* find_ie(uint32_t id) const;
+
+  template <typename T>
+  SRSASN_CODE unpack_ie(uint32_t id, T& value) const
+  {
+    const ie_t* ie_ptr = find_ie(id);
+    if (ie_ptr == nullptr) {
+      log_error("Missing IE id=%d in PDU with procedure code=%d", id, proc_code_);
+      return SRSASN_ERROR_DECODE_FAIL;
+    }
+    cbit_ref bref(buf + ie_ptr->offset, ie_ptr->len);
+    return value.unpack(bref);
+  }
+  template <typename Pdu>
+  SRSASN_CODE unpack_pdu(Pdu& pdu) const
+  {
+    cbit_ref bref(buf, nof_bytes);
+    return pdu.unpack(bref);
+  }
+
+private:
+  const uint8_t*                   buf        = nullptr;
+  uint32_t                         nof_bytes  = 0;
+  uint8_t                          type_      = 0;
+  uint16_t                         proc_code_ = 0;
+  uint8_t                          crit_      = 0;
+  bool                             ext_       = false;
+  bounded_array<ie_t, max_nof_ies> ies;
+};
+
 } // namespace asn1
 
 #endif // SRSASN_COMMON_UTILS_H
@@ -103,6 +103,59 @@ inline const char* get_drb_name(nr_drb drb_id)
                                 "DRB25", "DRB26", "DRB27", "DRB28", "DRB29", "invalid DRB id"};
   return names[(uint32_t)(drb_id < nr_drb::invalid ? drb_id : nr_drb::invalid) - 1];
 }
+
+/// Packet Delay Budget of the standardized 5QIs in msec, as in TS 23.501 Table 5.7.4-1. Returns 0 for unknown 5QIs
+inline uint32_t get_five_qi_delay_budget_ms(uint32_t five_qi)
+{
+  switch (five_qi) {
+    case 85:
+    case 86:
+    case 87:
+      return 5;
+    case 80:
+    case 82:
+    case 83:
+    case 88:
+      return 10;
+    case 89:
+      return 15;
+    case 90:
+      return 20;
+    case 84:
+      return 30;
+    case 3:
+    case 79:
+      return 50;
+    case 69:
+      return 60;
+    case 65:
+      return 75;
+    case 1:
+    case 5:
+    case 7:
+    case 66:
+    case 67:
+      return 100;
+    case 2:
+    case 71:
+      return 150;
+    case 70:
+      return 200;
+    case 4:
+    case 6:
+    case 8:
+    case 9:
+    case 72:
+    case 73:
+      return 300;
+    case 74:
+    case 76:
+      return 500;
+    default:
+      break;
+  }
+  return 0;
+}
 } // namespace srsran
 
 #endif // SRSRAN_COMMON_NR_H
\ No newline at end of file
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file cpu_topology.h
+ * @brief Discovery of the sockets, NUMA nodes, last level caches and SMT siblings of the host CPUs.
+ */
+
+#ifndef SRSRAN_CPU_TOPOLOGY_H
+#define SRSRAN_CPU_TOPOLOGY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/// Location of a logical CPU in the host. Cores and caches are identified by their first logical CPU, which is unique
+/// across sockets unlike the core_id of sysfs
+struct cpu_info_t {
+  uint32_t cpu     = 0;
+  uint32_t package = 0; ///< physical socket
+  uint32_t core    = 0; ///< first SMT sibling of the physical core
+  uint32_t llc     = 0; ///< first CPU sharing the last level cache
+  uint32_t node    = 0; ///< NUMA node
+};
+
+class cpu_topology
+{
+public:
+  /// Reads the online CPUs from sysfs. Without sysfs, every CPU is taken as a core of its own in node 0
+  static cpu_topology discover(const std::string& sysfs_root = "/sys/devices/system");
+
+  /// Parses a CPU list in the format of sysfs and cpusets, e.g. "0-3,8,10-11"
+  static bool parse_cpu_list(const std::string& str, std::vector<uint32_t>& cpus);
+  static std::string to_cpu_list(const std::vector<uint32_t>& cpus);
+
+  const std::vector<cpu_info_t>& get_cpus() const { return cpus; }
+  const cpu_info_t*              find_cpu(uint32_t cpu) const;
+
+  uint32_t nof_cpus() const { return cpus.size(); }
+  uint32_t nof_cores() const { return count_distinct(&cpu_info_t::core); }
+  uint32_t nof_llcs() const { return count_distinct(&cpu_info_t::llc); }
+  uint32_t nof_nodes() const { return count_distinct(&cpu_info_t::node); }
+  uint32_t nof_packages() const { return count_distinct(&cpu_info_t::package); }
+
+  std::string to_string() const;
+
+private:
+  uint32_t count_distinct(uint32_t cpu_info_t::*field) const;
+
+  std::vector<cpu_info_t> cpus;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_CPU_TOPOLOGY_H
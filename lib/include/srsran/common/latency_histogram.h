@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file latency_histogram.h
+ * @brief Lock-free latency histograms of the real-time paths, merged periodically into the metrics.
+ */
+
+#ifndef SRSRAN_LATENCY_HISTOGRAM_H
+#define SRSRAN_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/// Latency percentiles of a histogram over a metrics period
+struct latency_metrics_entry_t {
+  std::string name;
+  uint64_t    count   = 0;
+  double      mean_us = 0;
+  double      p50_us  = 0;
+  double      p99_us  = 0;
+  double      p999_us = 0;
+  double      max_us  = 0;
+};
+using latency_metrics_t = std::vector<latency_metrics_entry_t>;
+
+/**
+ * Histogram of durations in nanoseconds with log-linear buckets, as in HDR histograms: every power of two is split in
+ * 16 buckets, so that the values are kept with a relative error below 6.25% from 1 ns up to 2^40 ns.
+ * The counters are sharded by thread, so that the threads recording to the same histogram do not share cache lines.
+ * Recording takes no lock and the snapshots can be taken while recording.
+ */
+class latency_histogram
+{
+public:
+  static const uint32_t sub_bucket_bits = 4;
+  static const uint32_t nof_sub_buckets = 1U << sub_bucket_bits;
+  static const uint32_t max_value_bits  = 40;
+  static const uint32_t nof_buckets     = (max_value_bits - sub_bucket_bits + 1) * nof_sub_buckets;
+  static const uint32_t nof_shards      = 16;
+
+  struct snapshot_t {
+    std::array<uint64_t, nof_buckets> buckets = {};
+    uint64_t                          count   = 0;
+    uint64_t                          sum_ns  = 0;
+    uint64_t                          max_ns  = 0;
+
+    /// Upper bound of the bucket holding the q-th quantile, bounded by the max value
+    uint64_t quantile_ns(double q) const;
+  };
+
+  void record(uint64_t value_ns)
+  {
+    shard_t& shard = shards[get_shard_idx()];
+    // A shard is written by more than one thread only when there are more threads than shards
+    shard.buckets[get_bucket(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum_ns.fetch_add(value_ns, std::memory_order_relaxed);
+    uint64_t max_ns = shard.max_ns.load(std::memory_order_relaxed);
+    while (value_ns > max_ns and
+           not shard.max_ns.compare_exchange_weak(max_ns, value_ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Adds up the shards. The counters are cumulative, while the max value restarts at every snapshot
+  void get_snapshot(snapshot_t& snapshot);
+
+  static uint32_t get_bucket(uint64_t value_ns)
+  {
+    if (value_ns < nof_sub_buckets) {
+      return value_ns;
+    }
+    uint32_t msb = 63 - __builtin_clzll(value_ns);
+    if (msb >= max_value_bits) {
+      return nof_buckets - 1;
+    }
+    uint32_t shift = msb - sub_bucket_bits;
+    return (shift + 1) * nof_sub_buckets + ((value_ns >> shift) & (nof_sub_buckets - 1));
+  }
+  /// Smallest value counted in a bucket
+  static uint64_t get_bucket_min(uint32_t bucket);
+
+private:
+  struct shard_t {
+    std::array<std::atomic<uint64_t>, nof_buckets> buckets = {};
+    std::atomic<uint64_t>                          count{0};
+    std::atomic<uint64_t>                          sum_ns{0};
+    std::atomic<uint64_t>                          max_ns{0};
+    char                                           padding[64]; ///< keeps the counters of two shards apart
+  };
+
+  static uint32_t get_shard_idx()
+  {
+    static std::atomic<uint32_t> next_shard_idx{0};
+    thread_local uint32_t        shard_idx = next_shard_idx.fetch_add(1, std::memory_order_relaxed) % nof_shards;
+    return shard_idx;
+  }
+
+  std::array<shard_t, nof_shards> shards;
+};
+
+/// Histograms of the application, by name. The recording is enabled at startup, when the metrics export them
+class latency_histogram_registry
+{
+public:
+  static latency_histogram_registry& get_instance();
+
+  /// The histograms are never destroyed, so the callers can keep the reference
+  latency_histogram& get_histogram(const std::string& name);
+
+  void set_enabled(bool enabled_) { enabled.store(enabled_, std::memory_order_relaxed); }
+  bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+  /// Percentiles of every histogram since the previous call, in name order
+  void get_metrics(latency_metrics_t& metrics);
+
+private:
+  struct entry_t {
+    latency_histogram             hist;
+    latency_histogram::snapshot_t last; ///< counters at the previous call to get_metrics
+  };
+
+  std::atomic<bool>                               enabled{false};
+  std::mutex                                      mutex;
+  std::map<std::string, std::unique_ptr<entry_t>> histograms;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LATENCY_HISTOGRAM_H
@@ -323,6 +323,27 @@ security_milenage_f2345(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_t* res, ui
 
 uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_t* ak);
 
+/// Authentication vector computed by security_milenage_f12345_batch()
+struct milenage_vector_t {
+  uint8_t rand[16]; ///< Input random challenge
+  uint8_t sqn[6];   ///< Input sequence number
+  uint8_t mac_a[8];
+  uint8_t res[8];
+  uint8_t ck[16];
+  uint8_t ik[16];
+  uint8_t ak[6];
+};
+
+/**
+ * Computes the f1 and f2345 Milenage functions for several authentication vectors of the same subscriber. The AES key
+ * schedule is computed once and, with AES-NI, the blocks of the vectors are encrypted interleaved.
+ */
+int security_milenage_f12345_batch(const uint8_t*     k,
+                                   const uint8_t*     opc,
+                                   const uint8_t*     amf,
+                                   milenage_vector_t* vectors,
+                                   uint32_t           nof_vectors);
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak);
 int security_xor_f1(uint8_t* k, uint8_t* rand, uint8_t* sqn, uint8_t* amf, uint8_t* mac_a);
 
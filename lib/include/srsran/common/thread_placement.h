@@ -0,0 +1,125 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file thread_placement.h
+ * @brief Assignment of the application threads to CPUs by role, following the host topology.
+ */
+
+#ifndef SRSRAN_THREAD_PLACEMENT_H
+#define SRSRAN_THREAD_PLACEMENT_H
+
+#include "srsran/common/cpu_topology.h"
+#include "srsran/common/threads.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Places the threads of each role on the CPUs given by a policy. The policy is a comma separated list of
+ * "role:rule[@node]" items, where the rule is one of:
+ * - core: every thread of the role gets a physical core of its own. The SMT siblings of the core are left idle.
+ * - cpu: every thread of the role gets a logical CPU of its own.
+ * - node: the threads of the role share the CPUs of the NUMA node that no core or cpu rule took.
+ * - any: the threads of the role share the CPUs of all the nodes that no core or cpu rule took.
+ * - an explicit CPU list, e.g. 4-7,12: the threads of the role share these CPUs.
+ * The node is the one of the radio, 0 unless given. Dedicated cores and CPUs are taken in the order of the policy, and
+ * each last level cache is filled before moving to the next one, so that the threads passing samples to each other
+ * share it. The roles missing from the policy are not pinned, as are all the threads when the policy is empty.
+ * The policy "auto" gives dedicated cores to the PHY and stack threads of a LTE cell.
+ */
+class thread_placement
+{
+public:
+  /// Roles of the threads of the applications
+  static const std::vector<std::string>& get_roles();
+
+  /// Takes the number of threads of every role. The roles missing from nof_threads get no dedicated CPUs, their threads
+  /// share the CPUs of the node. Returns false if the policy is invalid
+  bool init(const std::string&                     policy,
+            const cpu_topology&                    topology_,
+            const std::map<std::string, uint32_t>& nof_threads = {});
+
+  bool is_enabled() const { return not roles.empty(); }
+
+  /// CPUs of the idx-th thread of a role. Returns false if the role is not pinned
+  bool get_cpuset(const std::string& role, uint32_t idx, cpu_set_t& cpuset) const;
+  /// NUMA node of the idx-th thread of a role, -1 if the role is not pinned
+  int get_node(const std::string& role, uint32_t idx) const;
+
+  /// Starts the thread on the CPUs of its role, or unpinned if the role is not placed
+  bool start(thread& t, const std::string& role, uint32_t idx, int prio) const;
+
+  /// Layout of the roles, one per line
+  std::string to_string() const;
+
+private:
+  struct role_placement_t {
+    std::string                         rule;
+    std::vector<std::vector<uint32_t> > thread_cpus; ///< CPUs of every thread, the last entry for the extra threads
+  };
+
+  bool apply_policy(const std::string& policy, const std::map<std::string, uint32_t>& nof_threads);
+  const std::vector<uint32_t>* find_cpus(const std::string& role, uint32_t idx) const;
+
+  cpu_topology                            topology;
+  std::map<std::string, role_placement_t> roles;
+  std::vector<std::string>                role_order;
+};
+
+/// Placement shared by the threads of the application, configured at startup
+thread_placement& get_thread_placement();
+
+/// Sets the affinity of the calling thread to the CPUs of a role while in scope, so that the threads it creates
+/// without explicit affinity, as the log backend, inherit them
+class scoped_thread_affinity
+{
+public:
+  scoped_thread_affinity(const std::string& role, uint32_t idx = 0);
+  ~scoped_thread_affinity();
+  scoped_thread_affinity(const scoped_thread_affinity&) = delete;
+  scoped_thread_affinity& operator=(const scoped_thread_affinity&) = delete;
+
+private:
+  bool      changed = false;
+  cpu_set_t old_cpuset;
+};
+
+/// Makes the memory first touched by the calling thread while in scope come from the NUMA node of the idx-th thread of
+/// a role, so that buffers allocated and zeroed at init are local to the thread that later processes them. Heap memory
+/// already touched before is not moved
+class scoped_numa_node
+{
+public:
+  scoped_numa_node(const std::string& role, uint32_t idx = 0);
+  ~scoped_numa_node();
+  scoped_numa_node(const scoped_numa_node&) = delete;
+  scoped_numa_node& operator=(const scoped_numa_node&) = delete;
+
+private:
+  bool changed = false;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_THREAD_PLACEMENT_H
@@ -75,6 +75,8 @@ public:
 
   thread_pool(uint32_t nof_workers_, std::string id_ = "");
   void        init_worker(uint32_t id, worker*, uint32_t prio = 0, uint32_t mask = 255);
+  /// Workers without CPU mask are started on the CPUs of this thread role, see thread_placement
+  void        set_placement_role(const std::string& role);
   void        stop();
   worker*     wait_worker_id(uint32_t id);
   worker*     wait_worker(uint32_t tti);
@@ -91,6 +93,7 @@ private:
   typedef enum { STOP, IDLE, START_WORK, WORKER_READY, WORKING } worker_status;
 
   std::string                          id; // id is prepended to every worker
+  std::string                          placement_role;
   std::vector<worker*>                 workers     = {};
   uint32_t                             nof_workers = 0;
   uint32_t                             max_workers = 0;
@@ -23,6 +23,7 @@
 #define SRSRAN_THREADS_H
 
 #include <pthread.h>
+#include <sched.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <sys/timerfd.h>
@@ -39,6 +40,11 @@ bool threads_new_rt(pthread_t* thread, void* (*start_routine)(void*), void* arg)
 bool threads_new_rt_prio(pthread_t* thread, void* (*start_routine)(void*), void* arg, int prio_offset);
 bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void* arg, int cpu, int prio_offset);
 bool threads_new_rt_mask(pthread_t* thread, void* (*start_routine)(void*), void* arg, int mask, int prio_offset);
+bool threads_new_rt_cpuset(pthread_t*       thread,
+                           void* (*start_routine)(void*),
+                           void*            arg,
+                           const cpu_set_t* cpuset,
+                           int              prio_offset);
 void threads_print_self();
 
 #ifdef __cplusplus
@@ -79,6 +85,11 @@ public:
     return threads_new_rt_mask(&_thread, thread_function_entry, this, mask, prio);
   }
 
+  bool start_cpuset(int prio, const cpu_set_t& cpuset)
+  {
+    return threads_new_rt_cpuset(&_thread, thread_function_entry, this, &cpuset, prio);
+  }
+
   void print_priority() { threads_print_self(); }
 
   void set_name(const std::string& name_)
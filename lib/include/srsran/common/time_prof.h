@@ -22,6 +22,7 @@
 #ifndef SRSRAN_TIME_PROF_H
 #define SRSRAN_TIME_PROF_H
 
+#include "srsran/common/latency_histogram.h"
 #include "srsran/srslog/srslog.h"
 #include <chrono>
 #include <mutex>
@@ -137,6 +138,47 @@ struct mutexed_tprof<Prof, false> {
   measure start() { return measure{}; }
 };
 
+/// Measures the durations into a histogram of the latency registry, from any number of threads without locking. Unlike
+/// the other tprofs, it is enabled at runtime through the registry, and does not read the clock while disabled
+class latency_tprof
+{
+public:
+  struct measure {
+  public:
+    measure() = default;
+    explicit measure(latency_histogram* h_) : h(h_) { meas.start(); }
+    measure(measure&& other) noexcept : meas(other.meas), h(other.h) { other.h = nullptr; }
+    measure(const measure&) = delete;
+    measure& operator=(const measure&) = delete;
+    measure& operator=(measure&&) = delete;
+    ~measure() { stop(); }
+
+    /// Records the duration, at the latest when the measure goes out of scope
+    std::chrono::nanoseconds stop()
+    {
+      if (h == nullptr) {
+        return std::chrono::nanoseconds{0};
+      }
+      auto d = meas.stop();
+      h->record(d.count());
+      h = nullptr;
+      return d;
+    }
+
+    tprof_measure      meas;
+    latency_histogram* h = nullptr;
+  };
+
+  explicit latency_tprof(const char* name) : hist(latency_histogram_registry::get_instance().get_histogram(name)) {}
+  measure start()
+  {
+    return latency_histogram_registry::get_instance().is_enabled() ? measure{&hist} : measure{};
+  }
+
+private:
+  latency_histogram& hist;
+};
+
 struct avg_time_stats {
   avg_time_stats(const char* name_, const char* logname, size_t print_period_);
   void operator()(std::chrono::nanoseconds duration);
@@ -32,11 +32,14 @@
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <inttypes.h>
 #include <limits>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -56,24 +59,34 @@ public:
  *   This deque will only grow in size. Erased timers are just tagged in the deque as empty, and can be reused for the
  *   creation of new timers. To avoid unnecessary runtime allocations, the user can set an initial capacity.
  * - free_list - intrusive forward linked list to keep track of the empty timers and speed up new timer creation.
- * - A large circular vector of size WHEEL_SIZE which works as a time wheel, storing and circularly indexing the
- *   currently running timers by their respective timeout value.
- *   For a number of running timers N, and uniform distribution of timeout values, the step_all() complexity
- *   should be O(N/WHEEL_SIZE). Thus, the performance should improve with a larger WHEEL_SIZE, at the expense of more
- *   used memory.
+ * - A hierarchical time wheel of NOF_LEVELS levels with LEVEL_SIZE slots each. The lowest level indexes the running
+ *   timers that expire in the next LEVEL_SIZE tics, each upper level covers LEVEL_SIZE times the range of the level
+ *   below. When the lower levels wrap around, the timers of the next slot of the level above are moved down. Every
+ *   timer is moved at most NOF_LEVELS - 1 times, and the memory of the wheel does not depend on the timer durations.
+ * Only the thread calling step_all() touches the wheel and writes the state of the timers, so its run(), stop() and
+ *   set() calls use no atomic read-modify-write operations. The calls of other threads store the requested state in
+ *   an atomic word of the timer, without locks, and push the timer to a lock-free list of pending timers. The next
+ *   step_all() applies the requests, and the thread of step_all() applies the pending request of a timer before
+ *   changing it, so the changes of a timer keep their order. The getters return the requested state when there is
+ *   one. A callback set by other thread is only installed when the timer expires, under a mutex. Until step_all() is
+ *   called for the first time, any thread changes the timers directly under a mutex. The creation and release of
+ *   timers also take a mutex.
  */
 class timer_handler
 {
   using tic_diff_t                      = uint32_t;
   using tic_t                           = uint32_t;
   constexpr static uint32_t INVALID_ID  = std::numeric_limits<uint32_t>::max();
-  constexpr static size_t   WHEEL_SHIFT = 16U;
-  constexpr static size_t   WHEEL_SIZE  = 1U << WHEEL_SHIFT;
-  constexpr static size_t   WHEEL_MASK  = WHEEL_SIZE - 1U;
+  constexpr static uint32_t LEVEL_SHIFT = 8U;
+  constexpr static uint32_t LEVEL_SIZE  = 1U << LEVEL_SHIFT;
+  constexpr static uint32_t LEVEL_MASK  = LEVEL_SIZE - 1U;
+  constexpr static uint32_t NOF_LEVELS  = 32U / LEVEL_SHIFT;
+  constexpr static uint32_t NOT_LINKED  = std::numeric_limits<uint32_t>::max();
 
   constexpr static uint64_t   STOPPED_FLAG       = 0U;
   constexpr static uint64_t   RUNNING_FLAG       = static_cast<uint64_t>(1U) << 63U;
   constexpr static uint64_t   EXPIRED_FLAG       = static_cast<uint64_t>(1U) << 62U;
+  constexpr static uint64_t   NO_REQUEST         = RUNNING_FLAG | EXPIRED_FLAG; ///< not a valid state
   constexpr static tic_diff_t MAX_TIMER_DURATION = 0x3FFFFFFFU;
 
   static bool       decode_is_running(uint64_t value) { return (value & RUNNING_FLAG) != 0; }
@@ -89,10 +102,20 @@ class timer_handler
     // const
     const uint32_t id;
     timer_handler& parent;
-    // writes protected by backend lock
-    bool                                  allocated = false;
-    std::atomic<uint64_t>                 state{0}; ///< read can be without lock, thus writes must be atomic
-    srsran::move_callback<void(uint32_t)> callback;
+    // cleared by any thread, set under the allocation lock
+    std::atomic<bool>     allocated{false};
+    std::atomic<uint64_t> state{0};            ///< only written by the thread of step_all()
+    std::atomic<uint64_t> request{NO_REQUEST}; ///< state requested by other threads
+    // position in the wheel, only accessed by step_all()
+    uint32_t wheel_pos = NOT_LINKED;
+    // pending list, written by any thread
+    std::atomic<bool> pending{false};
+    timer_impl*       next_pending = nullptr;
+    // The fields above are accessed on every start and stop, the callbacks are kept apart in the next cache lines
+    srsran::move_callback<void(uint32_t)> callback; ///< only accessed by the thread of step_all()
+    // callback set by other threads, written under the allocation lock and installed by step_all() before calling it
+    srsran::move_callback<void(uint32_t)> pending_callback;
+    std::atomic<bool>                     has_pending_callback{false};
 
     explicit timer_impl(timer_handler& parent_, uint32_t id_) : parent(parent_), id(id_) {}
     timer_impl(const timer_impl&) = delete;
@@ -101,13 +124,13 @@ class timer_handler
     timer_impl& operator=(timer_impl&&) = delete;
 
     // unprotected
-    bool       is_running_() const { return decode_is_running(state.load(std::memory_order_relaxed)); }
-    bool       is_expired_() const { return decode_is_expired(state.load(std::memory_order_relaxed)); }
-    uint32_t   duration_() const { return decode_duration(state.load(std::memory_order_relaxed)); }
+    bool       is_running_() const { return decode_is_running(get_state_()); }
+    bool       is_expired_() const { return decode_is_expired(get_state_()); }
+    uint32_t   duration_() const { return decode_duration(get_state_()); }
     bool       is_set_() const { return duration_() > 0; }
     tic_diff_t time_elapsed_() const
     {
-      uint64_t state_snapshot = state.load(std::memory_order_relaxed);
+      uint64_t state_snapshot = get_state_();
       bool     running = decode_is_running(state_snapshot), expired = decode_is_expired(state_snapshot);
       uint32_t duration = decode_duration(state_snapshot), timeout = decode_timeout(state_snapshot);
       return running ? duration - (timeout - parent.cur_time) : (expired ? duration : 0);
@@ -119,7 +142,6 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
       set_(duration_);
     }
 
@@ -129,42 +151,59 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      if (parent.is_wheel_owner_()) {
+        if (has_pending_callback.load(std::memory_order_relaxed)) {
+          parent.discard_pending_callback_(*this);
+        }
+        callback = std::move(callback_);
+      } else {
+        // step_all() may be calling the current callback, so the new one is only installed at the next expiry
+        std::lock_guard<std::mutex> lock(parent.alloc_mutex);
+        pending_callback = std::move(callback_);
+        has_pending_callback.store(true, std::memory_order_release);
+      }
       set_(duration_);
-      callback = std::move(callback_);
     }
 
     void run()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      parent.start_run_(*this);
+      parent.update_state_(*this, [this](uint64_t old_state) {
+        uint32_t duration = decode_duration(old_state);
+        return encode_state(RUNNING_FLAG, duration, parent.cur_time.load(std::memory_order_relaxed) + duration);
+      });
     }
 
     void stop()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
       // does not call callback
-      parent.stop_timer_(*this, false);
+      parent.update_state_(*this, [](uint64_t old_state) {
+        if (not decode_is_running(old_state)) {
+          return old_state;
+        }
+        return encode_state(STOPPED_FLAG, decode_duration(old_state), decode_timeout(old_state));
+      });
     }
 
-    void deallocate()
+    void deallocate() { parent.dealloc_timer_(*this); }
+
+  private:
+    /// State of the timer, including the change requested by other threads that step_all() did not apply yet
+    uint64_t get_state_() const
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      parent.dealloc_timer_(*this);
+      uint64_t requested_state = request.load(std::memory_order_acquire);
+      return requested_state != NO_REQUEST ? requested_state : state.load(std::memory_order_relaxed);
     }
 
-  private:
     void set_(uint32_t duration_)
     {
       duration_ = std::max(duration_, 1U); // the next step will be one place ahead of current one
-      // called in locked context
-      uint64_t old_state = state.load(std::memory_order_relaxed);
-      if (decode_is_running(old_state)) {
-        // if already running, just extends timer lifetime
-        parent.start_run_(*this, duration_);
-      } else {
-        state.store(encode_state(STOPPED_FLAG, duration_, 0), std::memory_order_relaxed);
-      }
+      parent.update_state_(*this, [this, duration_](uint64_t old_state) {
+        if (decode_is_running(old_state)) {
+          // if already running, just extends timer lifetime
+          return encode_state(RUNNING_FLAG, duration_, parent.cur_time.load(std::memory_order_relaxed) + duration_);
+        }
+        return encode_state(STOPPED_FLAG, duration_, 0);
+      });
     }
   };
 
@@ -232,9 +271,8 @@ public:
     timer_impl* handle = nullptr;
   };
 
-  explicit timer_handler(uint32_t capacity = 64)
+  explicit timer_handler(uint32_t capacity = 64) : time_wheel(NOF_LEVELS * LEVEL_SIZE)
   {
-    time_wheel.resize(WHEEL_SIZE);
     // Pre-reserve timers
     while (timer_list.size() < capacity) {
       timer_list.emplace_back(*this, timer_list.size());
@@ -243,59 +281,97 @@ public:
     for (auto it = timer_list.rbegin(); it != timer_list.rend(); ++it) {
       free_list.push_front(&(*it));
     }
-    nof_free_timers = timer_list.size();
   }
 
+  /// Advances the time by one tic. It must always be called from the same thread, which owns the wheel
   void step_all()
   {
-    std::unique_lock<std::mutex> lock(mutex);
-    uint32_t                     cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
-    auto&                        wheel_list     = time_wheel[cur_time_local & WHEEL_MASK];
-
-    for (auto it = wheel_list.begin(); it != wheel_list.end();) {
-      timer_impl& timer = timer_list[it->id];
-      ++it;
-      if (decode_timeout(timer.state.load(std::memory_order_relaxed)) == cur_time_local) {
-        // stop timer (callback has to see the timer has already expired)
-        stop_timer_(timer, true);
-
-        // Call callback if configured
-        if (not timer.callback.is_empty()) {
-          // unlock mutex. It can happen that the callback tries to run a timer too
-          lock.unlock();
-
-          timer.callback(timer.id);
-
-          // Lock again to keep protecting the wheel
-          lock.lock();
-        }
+    if (not is_wheel_owner_()) {
+      // wait for the changes made before the first step
+      std::lock_guard<std::mutex> lock(pre_owner_mutex);
+      owner_id.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    }
+    tic_t now = cur_time.load(std::memory_order_relaxed) + 1;
+    wheel_now = now;
+    stepping  = true;
+
+    // Move down the timers of the upper level slots that start with this tic
+    for (uint32_t level = NOF_LEVELS - 1; level > 0; --level) {
+      if ((now & ((1U << (level * LEVEL_SHIFT)) - 1U)) == 0) {
+        cascade_(level * LEVEL_SIZE + ((now >> (level * LEVEL_SHIFT)) & LEVEL_MASK));
       }
     }
 
-    cur_time.fetch_add(1, std::memory_order_relaxed);
+    // Apply the changes requested and the releases made by other threads since the last tic
+    timer_impl* t = nullptr;
+    if (pending_head.load(std::memory_order_relaxed) != nullptr) {
+      t = pending_head.exchange(nullptr, std::memory_order_acquire);
+    }
+    while (t != nullptr) {
+      timer_impl* next = t->next_pending;
+      t->pending.store(false);
+      if (t->allocated) {
+        apply_request_(*t, now);
+      } else {
+        free_timer_(*t);
+      }
+      t = next;
+    }
+
+    auto& wheel_list = time_wheel[now & LEVEL_MASK];
+    while (not wheel_list.empty()) {
+      timer_impl& timer = wheel_list.front();
+      wheel_list.pop_front();
+      timer.wheel_pos = NOT_LINKED;
+
+      if (timer.request.load(std::memory_order_relaxed) != NO_REQUEST) {
+        // changed by other thread since the start of the tic, the timer is placed again with its new state
+        apply_request_(timer, now);
+        continue;
+      }
+      uint64_t timer_state = timer.state.load(std::memory_order_relaxed);
+      if (not decode_is_running(timer_state)) {
+        continue;
+      }
+
+      // stop timer (callback has to see the timer has already expired)
+      apply_state_(timer, encode_state(EXPIRED_FLAG, decode_duration(timer_state), decode_timeout(timer_state)), now);
+
+      // Call callback if configured. It runs in the thread of step_all(), so it can start timers too
+      if (timer.has_pending_callback.load(std::memory_order_acquire)) {
+        install_pending_callback_(timer);
+      }
+      if (not timer.callback.is_empty()) {
+        timer.callback(timer.id);
+      }
+    }
+
+    stepping = false;
+    cur_time.store(now, std::memory_order_relaxed);
   }
 
   void stop_all()
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> lock(alloc_mutex);
     // does not call callback
     for (timer_impl& timer : timer_list) {
-      stop_timer_(timer, false);
+      timer.stop();
     }
   }
 
   unique_timer get_unique_timer() { return unique_timer(&alloc_timer()); }
 
-  uint32_t nof_timers() const
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    return timer_list.size() - nof_free_timers;
-  }
+  uint32_t nof_timers() const { return nof_timers_allocated_; }
 
-  uint32_t nof_running_timers() const
+  /// The timers started or stopped by other threads are only counted after the next step_all()
+  uint32_t nof_running_timers() const { return nof_timers_running_; }
+
+  /// True while a timer runs or other threads changed timers that the next step_all() did not apply yet. A timer
+  /// started by other thread is not counted as running until then, but the tic has to advance for it to expire
+  bool has_running_timers() const
   {
-    std::lock_guard<std::mutex> lock(mutex);
-    return nof_timers_running_;
+    return nof_timers_running_.load(std::memory_order_relaxed) > 0 or
+           pending_head.load(std::memory_order_acquire) != nullptr;
   }
 
   constexpr static uint32_t max_timer_duration() { return MAX_TIMER_DURATION; }
@@ -314,93 +390,202 @@ public:
   }
 
   // useful for testing
-  static size_t get_wheel_size() { return WHEEL_SIZE; }
+  static size_t get_wheel_size() { return LEVEL_SIZE; }
 
 private:
   timer_impl& alloc_timer()
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> lock(alloc_mutex);
     timer_impl*                 t;
     if (not free_list.empty()) {
       t = &free_list.front();
       srsran_assert(not t->allocated, "Invalid timer id=%d state", t->id);
       free_list.pop_front();
-      nof_free_timers--;
     } else {
       // Need to increase deque
       timer_list.emplace_back(*this, timer_list.size());
       t = &timer_list.back();
     }
     t->allocated = true;
+    nof_timers_allocated_++;
     return *t;
   }
 
+  /// Timers released by other threads or from a callback go back to the free list in the next step_all()
   void dealloc_timer_(timer_impl& timer)
   {
-    if (not timer.allocated) {
+    if (not timer.allocated.exchange(false)) {
       // already deallocated
       return;
     }
-    stop_timer_(timer, false);
-    timer.allocated = false;
-    timer.state.store(encode_state(STOPPED_FLAG, 0, 0), std::memory_order_relaxed);
+    timer.stop();
+    nof_timers_allocated_--;
+    if (is_wheel_owner_() and not stepping and not timer.pending) {
+      free_timer_(timer);
+    } else {
+      push_pending(timer);
+    }
+  }
+
+  void free_timer_(timer_impl& timer)
+  {
+    timer.request.store(NO_REQUEST, std::memory_order_relaxed);
+    apply_state_(timer, encode_state(STOPPED_FLAG, 0, 0), wheel_now + 1);
     timer.callback = srsran::move_callback<void(uint32_t)>();
+    std::lock_guard<std::mutex> lock(alloc_mutex);
+    timer.pending_callback = srsran::move_callback<void(uint32_t)>();
+    timer.has_pending_callback.store(false, std::memory_order_relaxed);
     free_list.push_front(&timer);
-    nof_free_timers++;
     // leave id unchanged.
   }
 
-  void start_run_(timer_impl& timer, uint32_t duration_ = 0)
+  void install_pending_callback_(timer_impl& timer)
+  {
+    std::lock_guard<std::mutex> lock(alloc_mutex);
+    timer.callback = std::move(timer.pending_callback);
+    timer.has_pending_callback.store(false, std::memory_order_relaxed);
+  }
+
+  void discard_pending_callback_(timer_impl& timer)
   {
-    uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
-    duration_                = duration_ == 0 ? decode_duration(timer_old_state) : duration_;
-    uint32_t new_timeout     = cur_time.load(std::memory_order_relaxed) + duration_;
-    size_t   new_wheel_pos   = new_timeout & WHEEL_MASK;
-
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    bool     was_running = decode_is_running(timer_old_state);
-    if (was_running and (old_timeout & WHEEL_MASK) == new_wheel_pos) {
-      // If no change in timer wheel position. Just update absolute timeout
-      timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(alloc_mutex);
+    timer.pending_callback = srsran::move_callback<void(uint32_t)>();
+    timer.has_pending_callback.store(false, std::memory_order_relaxed);
+  }
+
+  bool is_wheel_owner_() const { return owner_id.load(std::memory_order_relaxed) == std::this_thread::get_id(); }
+
+  /// Changes the state of a timer to func(current state). The thread of step_all() changes it right away, the other
+  /// threads request the change, that the next step_all() applies. Before the first step_all(), any thread changes it
+  /// under a mutex
+  template <typename F>
+  void update_state_(timer_impl& timer, const F& func)
+  {
+    std::thread::id owner = owner_id.load(std::memory_order_relaxed);
+    if (owner == std::this_thread::get_id()) {
+      apply_state_(timer, func(owner_state_(timer)), wheel_now + 1);
       return;
     }
+    if (owner == std::thread::id()) {
+      std::lock_guard<std::mutex> lock(pre_owner_mutex);
+      if (owner_id.load(std::memory_order_relaxed) == std::thread::id()) {
+        apply_state_(timer, func(owner_state_(timer)), wheel_now + 1);
+        return;
+      }
+    }
+
+    uint64_t old_request = timer.request.load(std::memory_order_relaxed);
+    uint64_t new_request;
+    do {
+      uint64_t old_state = old_request != NO_REQUEST ? old_request : timer.state.load(std::memory_order_relaxed);
+      new_request        = func(old_state);
+      if (new_request == old_state) {
+        return;
+      }
+    } while (not timer.request.compare_exchange_weak(old_request, new_request));
+    push_pending(timer);
+  }
+
+  /// State of the timer after applying the change requested by other threads. Only called by the wheel owner
+  uint64_t owner_state_(timer_impl& timer)
+  {
+    if (timer.request.load(std::memory_order_relaxed) != NO_REQUEST) {
+      apply_request_(timer, wheel_now + 1);
+    }
+    return timer.state.load(std::memory_order_relaxed);
+  }
 
-    // Stop timer if it was running, removing it from wheel in the process
-    if (was_running) {
-      time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-      nof_timers_running_--;
+  /// The state is stored before the request is cleared, so the getters of other threads never see an older state
+  void apply_request_(timer_impl& timer, tic_t min_timeout)
+  {
+    uint64_t requested_state = timer.request.load();
+    while (requested_state != NO_REQUEST) {
+      apply_state_(timer, requested_state, min_timeout);
+      if (timer.request.compare_exchange_weak(requested_state, NO_REQUEST)) {
+        break;
+      }
     }
+  }
 
-    // Insert timer in wheel
-    time_wheel[new_wheel_pos].push_front(&timer);
-    timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
-    nof_timers_running_++;
+  /// Only called by the wheel owner, so the running timers are counted without atomic read-modify-write operations
+  void apply_state_(timer_impl& timer, uint64_t new_state, tic_t min_timeout)
+  {
+    uint64_t old_state = timer.state.load(std::memory_order_relaxed);
+    if (decode_is_running(old_state) != decode_is_running(new_state)) {
+      uint32_t nof_running = nof_timers_running_.load(std::memory_order_relaxed);
+      nof_timers_running_.store(decode_is_running(new_state) ? nof_running + 1 : nof_running - 1,
+                                std::memory_order_relaxed);
+    }
+    timer.state.store(new_state, std::memory_order_relaxed);
+    unlink_(timer);
+    if (decode_is_running(new_state)) {
+      link_(timer, decode_timeout(new_state), min_timeout);
+    }
   }
 
-  /// called when user manually stops timer (as an alternative to expiry)
-  void stop_timer_(timer_impl& timer, bool expiry)
+  void push_pending(timer_impl& timer)
   {
-    uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
-    if (not decode_is_running(timer_old_state)) {
+    // A timer already in the list is placed with its latest state
+    if (timer.pending.load(std::memory_order_relaxed) or timer.pending.exchange(true)) {
       return;
     }
+    timer.next_pending = pending_head.load(std::memory_order_relaxed);
+    while (not pending_head.compare_exchange_weak(timer.next_pending, &timer, std::memory_order_release)) {
+    }
+  }
 
-    // If already running, need to disconnect it from previous wheel
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-    uint64_t new_state =
-        encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), old_timeout);
-    timer.state.store(new_state, std::memory_order_relaxed);
-    nof_timers_running_--;
+  void cascade_(uint32_t wheel_pos)
+  {
+    srsran::intrusive_double_linked_list<timer_impl> wheel_list = std::move(time_wheel[wheel_pos]);
+    while (not wheel_list.empty()) {
+      timer_impl& timer = wheel_list.front();
+      wheel_list.pop_front();
+      timer.wheel_pos      = NOT_LINKED;
+      uint64_t timer_state = timer.state.load();
+      if (decode_is_running(timer_state)) {
+        link_(timer, decode_timeout(timer_state), wheel_now);
+      }
+    }
+  }
+
+  /// The level is the one of the highest bit where the timeout and the current tic differ, so that the timer is moved
+  /// down when the tics reach its slot in that level. A timeout already passed is moved to min_timeout
+  void link_(timer_impl& timer, tic_t timeout, tic_t min_timeout)
+  {
+    if (static_cast<int32_t>(timeout - min_timeout) < 0) {
+      timeout = min_timeout;
+    }
+    uint32_t level = 0;
+    for (tic_t diff = (timeout ^ wheel_now) >> LEVEL_SHIFT; diff != 0; diff >>= LEVEL_SHIFT) {
+      level++;
+    }
+    timer.wheel_pos = level * LEVEL_SIZE + ((timeout >> (level * LEVEL_SHIFT)) & LEVEL_MASK);
+    time_wheel[timer.wheel_pos].push_front(&timer);
+  }
+
+  void unlink_(timer_impl& timer)
+  {
+    if (timer.wheel_pos != NOT_LINKED) {
+      time_wheel[timer.wheel_pos].pop(&timer);
+      timer.wheel_pos = NOT_LINKED;
+    }
   }
 
-  std::atomic<tic_t> cur_time{0};
-  size_t             nof_timers_running_ = 0, nof_free_timers = 0;
+  std::atomic<tic_t>    cur_time{0};
+  std::atomic<uint32_t> nof_timers_running_{0}; ///< only written by the thread of step_all()
+  std::atomic<uint32_t> nof_timers_allocated_{0};
   // using a deque to maintain reference validity on emplace_back. Also, this deque will only grow.
   std::deque<timer_impl>                                         timer_list;
   srsran::intrusive_forward_list<timer_impl>                     free_list;
+  std::atomic<timer_impl*>                                       pending_head{nullptr};
   std::vector<srsran::intrusive_double_linked_list<timer_impl> > time_wheel;
-  mutable std::mutex                                             mutex; // Protect priority queue
+  mutable std::mutex                                             alloc_mutex; // Protect timer_list and free_list
+  // Protect the changes of the timers before the first step_all()
+  std::mutex pre_owner_mutex;
+  // owned by the thread of step_all()
+  std::atomic<std::thread::id> owner_id{};
+  tic_t                        wheel_now = 0;
+  bool                         stepping  = false;
 };
 
 using unique_timer = timer_handler::unique_timer;
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file tti_deadline_monitor.h
+ * @brief Accounting of the time left to the TX deadline by the PHY workers, with a trace of the TTIs before a miss.
+ */
+
+#ifndef SRSRAN_TTI_DEADLINE_MONITOR_H
+#define SRSRAN_TTI_DEADLINE_MONITOR_H
+
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace srsran {
+
+/// Processing stages of a TTI timed by the PHY workers. The channel estimation is part of decode, as the PHY runs it
+/// within the reception of every PUSCH and PUCCH
+enum class tti_stage_t { fft = 0, decode, mac, encode, nof_stages };
+constexpr uint32_t nof_tti_stages = static_cast<uint32_t>(tti_stage_t::nof_stages);
+const char*        to_string(tti_stage_t stage);
+
+/// Time spent by a worker in every stage of a TTI, in microseconds
+struct tti_stage_times_t {
+  std::array<uint32_t, nof_tti_stages> us = {};
+};
+
+/// Adds the time spent to a stage, until stopped or out of scope
+class tti_stage_timer
+{
+public:
+  tti_stage_timer(tti_stage_times_t& times_, tti_stage_t stage_) :
+    times(times_), stage(stage_), t1(std::chrono::steady_clock::now())
+  {}
+  ~tti_stage_timer() { stop(); }
+  tti_stage_timer(const tti_stage_timer&) = delete;
+  tti_stage_timer& operator=(const tti_stage_timer&) = delete;
+
+  void stop()
+  {
+    if (stopped) {
+      return;
+    }
+    auto d = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t1);
+    times.us[static_cast<uint32_t>(stage)] += d.count();
+    stopped = true;
+  }
+
+private:
+  tti_stage_times_t&                    times;
+  tti_stage_t                           stage;
+  std::chrono::steady_clock::time_point t1;
+  bool                                  stopped = false;
+};
+
+struct tti_deadline_metrics_t {
+  uint64_t                             nof_ttis       = 0; ///< TTIs released in the period
+  uint64_t                             nof_late       = 0; ///< TTIs released after their deadline in the period
+  uint64_t                             nof_late_total = 0; ///< TTIs released after their deadline since start
+  float                                avg_slack_us   = 0;
+  int32_t                              min_slack_us   = 0;
+  std::array<float, nof_tti_stages>    avg_stage_us   = {};
+  std::array<uint32_t, nof_tti_stages> max_stage_us   = {};
+};
+
+/**
+ * Measures the slack of every TTI, the time left to its deadline when the worker releases it to the radio. The deadline
+ * is the TX time of the TTI in the local clock, taken from the reception of the samples. Being the time the samples are
+ * due, rather than the time the radio needs them, a TTI is late at least when its slack is negative. As the deadline
+ * follows the reception, the slack is also meaningful with radios that are not real-time, as ZMQ.
+ * The last TTIs are kept in a ring buffer, dumped to the log with the metrics after a TTI is late, out of the workers.
+ */
+class tti_deadline_monitor
+{
+public:
+  using time_point = std::chrono::steady_clock::time_point;
+
+  struct trace_entry_t {
+    uint32_t          tti      = 0;
+    int32_t           slack_us = 0;
+    bool              tx       = false; ///< the worker transmitted the TTI, being the last one of the TTI
+    tti_stage_times_t stages;
+  };
+
+  explicit tti_deadline_monitor(srslog::basic_logger& logger_, uint32_t trace_size = 32);
+
+  /// Accounts a TTI released by a worker at the current time. Returns the slack to the deadline in microseconds
+  int32_t release(uint32_t tti, bool tx, time_point deadline, const tti_stage_times_t& stages);
+
+  /// Metrics since the previous call, from the metrics thread. Logs the trace of the first late TTI since then
+  void get_metrics(tti_deadline_metrics_t& metrics);
+
+  uint64_t get_nof_late_total();
+
+private:
+  srslog::basic_logger& logger;
+  std::mutex            mutex;
+
+  std::vector<trace_entry_t> trace;
+  uint32_t                   trace_idx = 0;
+  uint32_t                   trace_len = 0;
+  std::vector<trace_entry_t> late_trace; ///< copy of the trace when the first TTI of the period was late
+  uint32_t                   late_trace_len = 0;
+  std::vector<trace_entry_t> dump_trace; ///< trace being logged, only accessed by get_metrics
+
+  tti_deadline_metrics_t               period;
+  int64_t                              slack_sum_us   = 0;
+  std::array<uint64_t, nof_tti_stages> stage_sum_us   = {};
+  uint64_t                             nof_late_total = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_TTI_DEADLINE_MONITOR_H
@@ -29,7 +29,9 @@
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsenb/hdr/stack/rrc/rrc_metrics.h"
 #include "srsenb/hdr/stack/s1ap/s1ap_metrics.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/common/tti_deadline_monitor.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
 #include "srsran/system/sys_metrics.h"
@@ -55,12 +57,15 @@ struct stack_metrics_t {
 };
 
 struct enb_metrics_t {
-  srsran::rf_metrics_t       rf;
-  std::vector<phy_metrics_t> phy;
-  stack_metrics_t            stack;
-  stack_metrics_t            nr_stack;
-  srsran::sys_metrics_t      sys;
-  bool                       running;
+  srsran::rf_metrics_t           rf;
+  std::vector<phy_metrics_t>     phy;
+  srsran::tti_deadline_metrics_t phy_deadline;
+  phy_nr_pipeline_metrics_t      phy_nr_pipeline;
+  stack_metrics_t                stack;
+  stack_metrics_t                nr_stack;
+  srsran::sys_metrics_t          sys;
+  srsran::latency_metrics_t      latency;
+  bool                           running;
 };
 
 // ENB interface
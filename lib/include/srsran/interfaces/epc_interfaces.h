@@ -24,6 +24,7 @@
 
 #include "srsran/asn1/gtpc_ies.h"
 #include "srsran/common/common.h"
+#include <memory>
 #include <netinet/sctp.h>
 #include <queue>
 
@@ -43,6 +44,7 @@ class gtpc_interface_nas // NAS -> GTP-C
 public:
   virtual bool send_create_session_request(uint64_t imsi)                                                         = 0;
   virtual bool send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify, srsran::gtp_fteid_t* enb_fteid) = 0;
+  virtual bool send_release_access_bearers_request(uint64_t imsi)                                                 = 0;
   virtual bool send_delete_session_request(uint64_t imsi)                                                         = 0;
   virtual bool send_downlink_data_notification_failure_indication(uint64_t                      imsi,
                                                                   enum srsran::gtpc_cause_value cause)            = 0;
@@ -57,30 +59,30 @@ public:
 class s1ap_interface_nas // NAS -> S1AP
 {
 public:
-  virtual uint32_t allocate_m_tmsi(uint64_t imsi)                                            = 0;
-  virtual uint32_t get_next_mme_ue_s1ap_id()                                                 = 0;
-  virtual bool     add_nas_ctx_to_imsi_map(nas* nas_ctx)                                     = 0;
-  virtual bool     add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)                           = 0;
-  virtual bool     add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)             = 0;
-  virtual bool     release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)                               = 0;
-  virtual bool     delete_ue_ctx(uint64_t imsi)                                              = 0;
-  virtual uint64_t find_imsi_from_m_tmsi(uint32_t m_tmsi)                                    = 0;
-  virtual nas*     find_nas_ctx_from_imsi(uint64_t imsi)                                     = 0;
-  virtual bool     send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup) = 0;
-  virtual bool     send_ue_context_release_command(uint32_t mme_ue_s1ap_id)                  = 0;
-  virtual bool     send_erab_release_command(uint32_t               enb_ue_s1ap_id,
-                                             uint32_t               mme_ue_s1ap_id,
-                                             std::vector<uint16_t>  erabs_to_release,
-                                             struct sctp_sndrcvinfo enb_sri)                 = 0;
-  virtual bool     send_erab_modify_request(uint32_t                     enb_ue_s1ap_id,
-                                            uint32_t                     mme_ue_s1ap_id,
-                                            std::map<uint16_t, uint16_t> erabs_to_modify,
-                                            srsran::byte_buffer_t*       nas_msg,
-                                            struct sctp_sndrcvinfo       enb_sri)                  = 0;
-  virtual bool     send_downlink_nas_transport(uint32_t               enb_ue_s1ap_id,
-                                               uint32_t               mme_ue_s1ap_id,
-                                               srsran::byte_buffer_t* nas_msg,
-                                               struct sctp_sndrcvinfo enb_sri)               = 0;
+  virtual uint32_t             allocate_m_tmsi(uint64_t imsi)                                            = 0;
+  virtual uint32_t             get_next_mme_ue_s1ap_id()                                                 = 0;
+  virtual bool                 add_nas_ctx_to_imsi_map(nas* nas_ctx)                                     = 0;
+  virtual bool                 add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)                           = 0;
+  virtual bool                 add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)             = 0;
+  virtual bool                 release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)                               = 0;
+  virtual bool                 delete_ue_ctx(uint64_t imsi)                                              = 0;
+  virtual uint64_t             find_imsi_from_m_tmsi(uint32_t m_tmsi)                                    = 0;
+  virtual std::shared_ptr<nas> find_nas_ctx_from_imsi(uint64_t imsi)                                     = 0;
+  virtual bool                 send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup) = 0;
+  virtual bool                 send_ue_context_release_command(uint32_t mme_ue_s1ap_id)                  = 0;
+  virtual bool                 send_erab_release_command(uint32_t               enb_ue_s1ap_id,
+                                                         uint32_t               mme_ue_s1ap_id,
+                                                         std::vector<uint16_t>  erabs_to_release,
+                                                         struct sctp_sndrcvinfo enb_sri)                 = 0;
+  virtual bool                 send_erab_modify_request(uint32_t                     enb_ue_s1ap_id,
+                                                        uint32_t                     mme_ue_s1ap_id,
+                                                        std::map<uint16_t, uint16_t> erabs_to_modify,
+                                                        srsran::byte_buffer_t*       nas_msg,
+                                                        struct sctp_sndrcvinfo       enb_sri)                  = 0;
+  virtual bool                 send_downlink_nas_transport(uint32_t               enb_ue_s1ap_id,
+                                                           uint32_t               mme_ue_s1ap_id,
+                                                           srsran::byte_buffer_t* nas_msg,
+                                                           struct sctp_sndrcvinfo enb_sri)               = 0;
 };
 
 class hss_interface_nas // NAS -> HSS
@@ -94,9 +96,9 @@ public:
 class mme_interface_nas // NAS -> MME
 {
 public:
-  virtual bool add_nas_timer(int timer_fd, enum nas_timer_type type, uint64_t imsi) = 0;
-  virtual bool is_nas_timer_running(enum nas_timer_type type, uint64_t imsi)        = 0;
-  virtual bool remove_nas_timer(enum nas_timer_type type, uint64_t imsi)            = 0;
+  virtual bool add_nas_timer(enum nas_timer_type type, uint64_t imsi, uint32_t timeout_ms) = 0;
+  virtual bool is_nas_timer_running(enum nas_timer_type type, uint64_t imsi)               = 0;
+  virtual bool remove_nas_timer(enum nas_timer_type type, uint64_t imsi)                   = 0;
 };
 
 class s1ap_interface_mme // MME -> S1AP
@@ -22,8 +22,10 @@
 #ifndef SRSRAN_PHY_COMMON_INTERFACE_H
 #define SRSRAN_PHY_COMMON_INTERFACE_H
 
+#include "srsran/common/tti_deadline_monitor.h"
 #include "../radio/rf_buffer.h"
 #include "../radio/rf_timestamp.h"
+#include <chrono>
 
 namespace srsran {
 
@@ -75,11 +77,16 @@ public:
     bool                   last       = false;   ///< Indicates this worker is the last one in the sub-frame processing
     srsran::rf_timestamp_t tx_time    = {};      ///< Transmit time, used only by last worker
 
+    std::chrono::steady_clock::time_point deadline    = {}; ///< Local time of the transmission, unset if not monitored
+    srsran::tti_stage_times_t             stage_times = {}; ///< Time spent by the worker in every processing stage
+
     void copy(const worker_context_t& other)
     {
-      sf_idx     = other.sf_idx;
-      worker_ptr = other.worker_ptr;
-      last       = other.last;
+      sf_idx      = other.sf_idx;
+      worker_ptr  = other.worker_ptr;
+      last        = other.last;
+      deadline    = other.deadline;
+      stage_times = other.stage_times;
       tx_time.copy(other.tx_time);
     }
 
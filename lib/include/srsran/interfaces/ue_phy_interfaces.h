@@ -100,10 +100,14 @@ struct phy_args_t {
   float       rx_gain_offset               = 62;
   bool        pdsch_csi_enabled            = true;
   bool        pdsch_8bit_decoder           = false;
+  float       pdcch_llr_threshold          = SRSRAN_PDCCH_DEFAULT_LLR_THRESHOLD;
   uint32_t    intra_freq_meas_len_ms       = 20;
   uint32_t    intra_freq_meas_period_ms    = 200;
+  uint32_t    intra_freq_meas_nof_workers  = 1;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
+  float       cell_search_wb_srate         = 0.0f; // Wideband cell search sampling rate, 0 to search each EARFCN
+  uint32_t    cell_search_wb_nof_threads   = 1;
 
   bool nr_store_pdsch_ko = false;
 
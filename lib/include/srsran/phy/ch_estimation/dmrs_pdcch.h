@@ -78,6 +78,9 @@ typedef struct SRSRAN_API {
   /// Channel estimates, size coreset_sz
   cf_t* ce;
 
+  /// Average pilot power of every CORESET PRB over the CORESET symbols, size coreset_bw
+  float* rb_epre;
+
   /// Frequency domain smoothing filter
   float*   filter;
   uint32_t filter_len;
@@ -173,6 +176,21 @@ SRSRAN_API int srsran_dmrs_pdcch_get_measure(const srsran_dmrs_pdcch_estimator_t
                                              const srsran_dci_location_t*         location,
                                              srsran_dmrs_pdcch_measure_t*         measure);
 
+/**
+ * @brief Measures the PDCCH DMRS EPRE of a given DCI location from the pilot power of its PRBs
+ *
+ * @note It gives the same EPRE as srsran_dmrs_pdcch_get_measure at a fraction of the cost, so that the candidates
+ * without enough energy can be discarded before measuring them
+ *
+ * @param[in] q provides PDCCH DMRS estimator object
+ * @param[in] location Provides the aggregation level and CCE resource
+ * @param[out] epre_dBfs Provides the measured EPRE in dBfs
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_dmrs_pdcch_get_epre(const srsran_dmrs_pdcch_estimator_t* q,
+                                         const srsran_dci_location_t*         location,
+                                         float*                               epre_dBfs);
+
 /**
  * @brief Extracts PDCCH DMRS channel estimates of a given PDCCH candidate for an aggregation level
  *
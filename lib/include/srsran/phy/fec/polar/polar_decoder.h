@@ -37,6 +37,11 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/*!
+ * \brief Maximum number of codewords decoded at once by srsran_polar_decoder_decode_batch_c().
+ */
+#define SRSRAN_POLAR_DECODER_MAX_BATCH 8
+
 /*!
  * Lists the different types of polar decoder.
  */
@@ -45,7 +50,9 @@ typedef enum SRSRAN_API {
   SRSRAN_POLAR_DECODER_SSC_S = 1, /*!< \brief Fixed-point (16 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C = 2, /*!< \brief Fixed-point (8 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C_AVX2 =
-      3 /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+      3, /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+  SRSRAN_POLAR_DECODER_SSC_C_BATCH_AVX2 =
+      4 /*!< \brief Fixed-point (8 bit, avx2) SSC decoder of several codewords of the same code at once. */
 } srsran_polar_decoder_type_t;
 
 /*!
@@ -72,7 +79,14 @@ typedef struct SRSRAN_API {
                   const uint8_t   n,
                   const uint16_t* frozen_set,
                   const uint16_t  frozen_set_size); /*!< \brief Pointer to the decoder function (8-bit version). */
-  void (*free)(void*);                             /*!< \brief Pointer to a "destructor". */
+  int (*decode_batch_c)(void*           ptr,
+                        const int8_t**  symbols,
+                        uint8_t**       data_decoded,
+                        const uint32_t  nof_codewords,
+                        const uint8_t   n,
+                        const uint16_t* frozen_set,
+                        const uint16_t  frozen_set_size); /*!< \brief Pointer to the batch decoder (8-bit version). */
+  void (*free)(void*);                                   /*!< \brief Pointer to a "destructor". */
 } srsran_polar_decoder_t;
 
 /*!
@@ -145,4 +159,25 @@ SRSRAN_API int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
                                              const uint16_t*         frozen_set,
                                              const uint16_t          frozen_set_size);
 
+/*!
+ * Decodes several input (int8_t) codewords of the same code with the specified polar decoder. The decoders of type
+ * ::SRSRAN_POLAR_DECODER_SSC_C_BATCH_AVX2 process up to \ref SRSRAN_POLAR_DECODER_MAX_BATCH codewords at once, the
+ * others decode them one by one.
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector of every codeword.
+ * \param[out] data_decoded The decoder output vector of every codeword.
+ * \param[in] nof_codewords The number of codewords.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vectors.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_batch_c(srsran_polar_decoder_t* q,
+                                                   const int8_t**          input_llr,
+                                                   uint8_t**               data_decoded,
+                                                   const uint32_t          nof_codewords,
+                                                   const uint8_t           code_size_log,
+                                                   const uint16_t*         frozen_set,
+                                                   const uint16_t          frozen_set_size);
+
 #endif // SRSRAN_POLARDECODER_H
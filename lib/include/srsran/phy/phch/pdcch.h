@@ -47,6 +47,22 @@
 
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
+/* Maximum number of decoded candidates kept between two calls to srsran_pdcch_extract_llr() */
+#define SRSRAN_PDCCH_MAX_DECODED_CANDIDATES 32
+
+/* Default minimum absolute LLR mean for a candidate to be Viterbi decoded */
+#define SRSRAN_PDCCH_DEFAULT_LLR_THRESHOLD 0.3f
+
+/* Result of decoding the LLRs of a location for a given payload size. The Viterbi output does not depend on the
+ * searched RNTI or DCI format, only on the location and the payload size, so it can be reused by all the candidates
+ * that share both. */
+typedef struct SRSRAN_API {
+  srsran_dci_location_t location;
+  uint32_t              nof_bits;
+  uint16_t              crc_rem;
+  uint8_t               payload[SRSRAN_DCI_MAX_BITS];
+} srsran_pdcch_candidate_t;
+
 /* PDCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -73,6 +89,17 @@ typedef struct SRSRAN_API {
   srsran_viterbi_t     decoder;
   srsran_crc_t         crc;
 
+  /* candidates decoded since the last LLR extraction */
+  srsran_pdcch_candidate_t decoded[SRSRAN_PDCCH_MAX_DECODED_CANDIDATES];
+  uint32_t                 nof_decoded;
+  float                    llr_threshold;
+
+  /* decoding statistics since the last LLR extraction */
+  uint32_t nof_candidates;
+  uint32_t nof_viterbi;
+  bool     meas_time_en;
+  uint32_t meas_time_us;
+
 } srsran_pdcch_t;
 
 SRSRAN_API int srsran_pdcch_init_ue(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
@@ -87,6 +114,12 @@ SRSRAN_API void srsran_pdcch_free(srsran_pdcch_t* q);
 
 SRSRAN_API float srsran_pdcch_coderate(uint32_t nof_bits, uint32_t l);
 
+/* Sets the minimum absolute LLR mean below which a candidate is skipped without decoding */
+SRSRAN_API void srsran_pdcch_set_llr_threshold(srsran_pdcch_t* q, float threshold);
+
+/* Enables the measurement of the time spent decoding candidates, accumulated in meas_time_us for each subframe */
+SRSRAN_API void srsran_pdcch_set_meas_time(srsran_pdcch_t* q, bool enable);
+
 /* Encoding function */
 SRSRAN_API int srsran_pdcch_encode(srsran_pdcch_t*     q,
                                    srsran_dl_sf_cfg_t* sf,
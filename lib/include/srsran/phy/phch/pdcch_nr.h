@@ -62,10 +62,12 @@ typedef struct SRSRAN_API {
   srsran_carrier_nr_t    carrier;
   srsran_coreset_t       coreset;
   srsran_crc_t           crc24c;
-  uint8_t*               c;         // Message bits with attached CRC
-  uint8_t*               d;         // encoded bits
-  uint8_t*               f;         // bits at the Rate matching output
-  uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output
+  uint8_t*               c;               // Message bits with attached CRC
+  uint8_t*               d;               // encoded bits
+  uint8_t*               f;               // bits at the Rate matching output
+  uint8_t*               allocated;       // Allocated polar bit buffer, encoder input, decoder output
+  int8_t*                d_batch;         // Decoder input of the batched candidates, NMAX apart
+  uint8_t*               allocated_batch; // Decoder output of the batched candidates, NMAX apart
   cf_t*                  symbols;
   srsran_modem_table_t   modem_table;
   srsran_evm_buffer_t*   evm_buffer;
@@ -154,6 +156,27 @@ SRSRAN_API int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
                                       srsran_dci_msg_nr_t*    dci_msg,
                                       srsran_pdcch_nr_res_t*  res);
 
+/**
+ * @brief Decodes several DCI candidates of the same size and aggregation level, sharing the polar code
+ *
+ * The polar decoder processes up to SRSRAN_POLAR_DECODER_MAX_BATCH candidates at once, which is faster than decoding
+ * them one by one. Each candidate gets the same result as with srsran_pdcch_nr_decode().
+ *
+ * @param[in,out] q provides PDCCH encoder/decoder object
+ * @param[in] slot_symbols provides slot resource grid
+ * @param[in] ce provides the channel estimated resource elements of every candidate, each one allocated apart
+ * @param[in,out] dci_msg Provides with the DCI message location, RNTI, RNTI type and data buffer of every candidate
+ * @param[out] res Provides the PDCCH result information of every candidate
+ * @param[in] nof_candidates Number of candidates
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_decode_batch(srsran_pdcch_nr_t*      q,
+                                            cf_t*                   slot_symbols,
+                                            srsran_dmrs_pdcch_ce_t* ce[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR],
+                                            srsran_dci_msg_nr_t     dci_msg[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR],
+                                            srsran_pdcch_nr_res_t   res[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR],
+                                            uint32_t                nof_candidates);
+
 /**
  * @brief Stringifies NR PDCCH decoding information from the latest encoded/decoded transmission
  *
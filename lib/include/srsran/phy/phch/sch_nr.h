@@ -54,6 +54,22 @@ typedef struct {
   float    avg_iter; ///< Average iterations
 } srsran_sch_tb_res_nr_t;
 
+/**
+ * @brief Number of bins of the transport block decode latency histogram. Bin 0 counts decodes under 2 us, bin i counts
+ * decodes in [2^i, 2^(i+1)) us and the last bin also accumulates every longer decode
+ */
+#define SRSRAN_SCH_NR_DECODE_HIST_NOF_BINS 16
+
+/**
+ * @brief Transport block decode latency statistics
+ */
+typedef struct {
+  uint32_t count;                                    ///< Number of decoded transport blocks
+  uint32_t max_us;                                   ///< Maximum decode latency in microseconds
+  uint64_t sum_us;                                   ///< Accumulated decode latency in microseconds
+  uint32_t hist[SRSRAN_SCH_NR_DECODE_HIST_NOF_BINS]; ///< Decode latency histogram
+} srsran_sch_nr_decode_stats_t;
+
 typedef struct SRSRAN_API {
   srsran_carrier_nr_t carrier;
 
@@ -76,6 +92,12 @@ typedef struct SRSRAN_API {
   /// LDPC Rate matcher
   srsran_ldpc_rm_t tx_rm;
   srsran_ldpc_rm_t rx_rm;
+
+  /// Code block decoder workers, NULL if the code blocks are decoded in the caller thread
+  void* decoder_pool;
+
+  /// Transport block decode latency statistics
+  srsran_sch_nr_decode_stats_t decode_stats;
 } srsran_sch_nr_t;
 
 /**
@@ -85,7 +107,8 @@ typedef struct SRSRAN_API {
   bool     disable_simd;
   bool     decoder_use_flooded;
   float    decoder_scaling_factor;
-  uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  uint32_t max_nof_iter;        ///< Maximum number of LDPC iterations
+  uint32_t nof_decoder_threads; ///< Number of threads decoding code blocks, set to 0 or 1 for the caller thread only
 } srsran_sch_nr_args_t;
 
 /**
@@ -189,6 +212,21 @@ SRSRAN_API int srsran_ulsch_nr_decode(srsran_sch_nr_t*        q,
                                       int8_t*                 e_bits,
                                       srsran_sch_tb_res_nr_t* res);
 
+/**
+ * @brief Writes the transport block decode latency statistics in a string
+ * @param q Points ats the SCH object
+ * @param str Destination string
+ * @param str_len Destination string length
+ * @return The number of characters written
+ */
+SRSRAN_API uint32_t srsran_sch_nr_decode_stats_info(const srsran_sch_nr_t* q, char* str, uint32_t str_len);
+
+/**
+ * @brief Clears the transport block decode latency statistics
+ * @param q Points ats the SCH object
+ */
+SRSRAN_API void srsran_sch_nr_decode_stats_reset(srsran_sch_nr_t* q);
+
 SRSRAN_API int
 srsran_sch_nr_tb_info(const srsran_sch_tb_t* tb, const srsran_sch_tb_res_nr_t* res, char* str, uint32_t str_len);
 
@@ -106,6 +106,84 @@ SRSRAN_API void srsran_resampler_fft_run(srsran_resampler_fft_t* q, const cf_t*
  */
 SRSRAN_API void srsran_resampler_fft_free(srsran_resampler_fft_t* q);
 
+/**
+ * @brief Polyphase FIR resampler internal buffers. It resamples by a rational ratio interp/decim, filtering with a
+ * Kaiser windowed sinc split into interp polyphase branches of nof_taps taps each.
+ */
+typedef struct {
+  uint32_t interp;       ///< Interpolation factor
+  uint32_t decim;        ///< Decimation factor
+  uint32_t nof_taps;     ///< Number of taps of each polyphase branch
+  uint32_t phase;        ///< Time of the next output sample at the interpolated rate, relative to the next input
+  uint32_t max_nsamples; ///< Maximum number of input samples the buffer can hold
+  cf_t*    buffer;       ///< Filter state followed by the input samples
+  float*   filter;       ///< Time reversed polyphase branches with the taps repeated for the real and imaginary parts
+} srsran_resampler_poly_t;
+
+/**
+ * Initialise a polyphase FIR resampler that converts the sampling rate by interp/decim. The ratio does not need to be
+ * integer, for example 3/4 or 5/4. It is reduced to the smallest terms.
+ * @param q Object pointer
+ * @param interp Interpolation factor
+ * @param decim Decimation factor
+ * @return SRSRAN_SUCCES if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t interp, uint32_t decim);
+
+/**
+ * @brief resets internal re-sampler state
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q);
+
+/**
+ * Get the group delay of the polyphase resampler
+ * @param q Object pointer
+ * @return the delay in number of output samples
+ */
+SRSRAN_API float srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q);
+
+/**
+ * Get the number of output samples that the next call to srsran_resampler_poly_run() produces for a given number of
+ * input samples. It is not constant when nsamples * interp is not a multiple of decim.
+ * @param q Object pointer
+ * @param nsamples Number of input samples
+ * @return the number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_nof_output(const srsran_resampler_poly_t* q, uint32_t nsamples);
+
+/**
+ * Get the largest number of input samples for which the next call to srsran_resampler_poly_run() produces at most
+ * nof_output samples. When decimating, it produces exactly nof_output samples.
+ * @param q Object pointer
+ * @param nof_output Number of output samples
+ * @return the number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output);
+
+/**
+ * @brief Run the polyphase resampler.
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ * @note The output must have room for srsran_resampler_poly_get_nof_output() samples
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param output Points at the output complex buffer
+ * @param nsamples Number of input samples
+ * @return the number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                              const cf_t*              input,
+                                              cf_t*                    output,
+                                              uint32_t                 nsamples);
+
+/**
+ * Free polyphase resampler buffers
+ * @param q  Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_free(srsran_resampler_poly_t* q);
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,18 @@ typedef struct {
   uint32_t peak_index;
 } srsran_refsignal_dl_sync_t;
 
+/**
+ * Spectrum of the correlation windows of a capture. It does not depend on the cell identity, so it can be computed
+ * once and shared by all the srsran_refsignal_dl_sync_t measuring different PCI in the same capture.
+ */
+typedef struct {
+  srsran_dft_plan_t plan;
+  cf_t*             fft;          ///< Spectrum of every window, one after the other
+  uint32_t          max_nsamples; ///< Maximum number of samples in the capture
+  uint32_t          sf_len;       ///< Subframe length the windows have been computed for
+  uint32_t          nof_windows;  ///< Number of windows in the capture
+} srsran_refsignal_dl_sync_spectrum_t;
+
 SRSRAN_API int srsran_refsignal_dl_sync_init(srsran_refsignal_dl_sync_t* q, srsran_cp_t cp);
 
 SRSRAN_API int srsran_refsignal_dl_sync_set_cell(srsran_refsignal_dl_sync_t* q, srsran_cell_t cell);
@@ -52,6 +64,27 @@ SRSRAN_API void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q);
 
 SRSRAN_API int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples);
 
+/**
+ * Same as srsran_refsignal_dl_sync_run() but the correlation takes the input spectrum from a shared object, computed
+ * for the same buffer. If the spectrum was computed for a different subframe length, it falls back to computing it.
+ */
+SRSRAN_API int srsran_refsignal_dl_sync_run_spectrum(srsran_refsignal_dl_sync_t*                q,
+                                                     const srsran_refsignal_dl_sync_spectrum_t* spectrum,
+                                                     cf_t*                                      buffer,
+                                                     uint32_t                                   nsamples);
+
+SRSRAN_API int srsran_refsignal_dl_sync_spectrum_init(srsran_refsignal_dl_sync_spectrum_t* q, uint32_t max_nsamples);
+
+SRSRAN_API void srsran_refsignal_dl_sync_spectrum_free(srsran_refsignal_dl_sync_spectrum_t* q);
+
+/**
+ * Computes the spectrum of every correlation window in the buffer for cells with the given subframe length
+ */
+SRSRAN_API int srsran_refsignal_dl_sync_spectrum_compute(srsran_refsignal_dl_sync_spectrum_t* q,
+                                                         uint32_t                             sf_len,
+                                                         const cf_t*                          buffer,
+                                                         uint32_t                             nsamples);
+
 SRSRAN_API void srsran_refsignal_dl_sync_measure_sf(srsran_refsignal_dl_sync_t* q,
                                                     cf_t*                       buffer,
                                                     uint32_t                    sf_idx,
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         ue_cell_search_wb.h
+ *
+ *  Description:  Wideband multi-carrier cell search.
+ *
+ *                Searches LTE cells in several carriers at once, from a buffer
+ *                of samples captured at a sampling rate wide enough to contain
+ *                all of them. Each carrier is shifted to baseband and decimated
+ *                to SRSRAN_CS_SAMP_FREQ, then the PSS/SSS are detected for every
+ *                carrier and N_id_2 hypothesis. Both stages are spread across a
+ *                pool of threads.
+ *
+ *                Unlike srsran_ue_cellsearch_scan(), the samples are not pulled
+ *                from a stream, so they can come from an RF device, a file or a
+ *                ZMQ socket.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_UE_CELL_SEARCH_WB_H
+#define SRSRAN_UE_CELL_SEARCH_WB_H
+
+#include <stdbool.h>
+
+#include "srsran/config.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+
+/**
+ * Maximum number of carriers searched in a single capture
+ */
+#define SRSRAN_CS_WB_MAX_CARRIERS 64
+
+/**
+ * @brief Wideband cell search arguments
+ */
+typedef struct SRSRAN_API {
+  double   srate_hz;       ///< Capture sampling rate in Hz, its ratio to SRSRAN_CS_SAMP_FREQ shall have small terms
+  uint32_t max_nsamples;   ///< Maximum number of samples per capture
+  uint32_t nof_threads;    ///< Number of search threads, set to 0 or 1 to search in the caller thread only
+  uint32_t min_nof_frames; ///< Minimum number of 5 ms frames with PSS/SSS to report a cell, 0 for half the capture
+} srsran_ue_cellsearch_wb_args_t;
+
+/**
+ * @brief Cell search result of a carrier, with the same meaning as the srsran_ue_cellsearch_scan() outputs
+ */
+typedef struct SRSRAN_API {
+  uint32_t                      nof_cells;                     ///< Number of N_id_2 where a cell was detected
+  uint32_t                      max_N_id_2;                    ///< N_id_2 of the strongest cell
+  srsran_ue_cellsearch_result_t cells[SRSRAN_NOF_NID_2];       ///< Strongest cell for each N_id_2
+  uint32_t                      nof_detected[SRSRAN_NOF_NID_2]; ///< Number of 5 ms frames with PSS/SSS detected
+} srsran_ue_cellsearch_wb_result_t;
+
+typedef struct SRSRAN_API {
+  srsran_ue_cellsearch_wb_args_t args;
+
+  /// Baseband samples of every carrier at SRSRAN_CS_SAMP_FREQ
+  cf_t*    nb_buffer[SRSRAN_CS_WB_MAX_CARRIERS];
+  uint32_t nb_max_nsamples;
+
+  /// Search workers, the first runs in the caller thread
+  void* pool;
+} srsran_ue_cellsearch_wb_t;
+
+SRSRAN_API int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t* q, const srsran_ue_cellsearch_wb_args_t* args);
+
+SRSRAN_API void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q);
+
+/**
+ * @brief Searches cells in a set of carriers contained in a wideband capture
+ *
+ * Every 5 ms frame of the capture is correlated with the three PSS of every carrier. For each N_id_2 detected in at
+ * least the configured minimum number of frames, the cell identity detected most often is reported. The carriers
+ * should not be closer to the capture edges than SRSRAN_CS_SAMP_FREQ / 2, or the anti-aliasing filter of the device
+ * might attenuate them.
+ *
+ * @param q Cell search object
+ * @param input Wideband samples at the configured sampling rate
+ * @param nsamples Number of input samples, it shall not exceed the configured maximum
+ * @param freq_offset_hz Offset of each carrier centre frequency from the capture centre frequency, in Hz
+ * @param nof_carriers Number of carriers to search, up to SRSRAN_CS_WB_MAX_CARRIERS
+ * @param results Search result of each carrier
+ * @return The number of carriers where a cell was found, or SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_scan(srsran_ue_cellsearch_wb_t*        q,
+                                            const cf_t*                       input,
+                                            uint32_t                          nsamples,
+                                            const double*                     freq_offset_hz,
+                                            uint32_t                          nof_carriers,
+                                            srsran_ue_cellsearch_wb_result_t* results);
+
+#endif // SRSRAN_UE_CELL_SEARCH_WB_H
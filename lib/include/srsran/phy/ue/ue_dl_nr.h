@@ -72,7 +72,7 @@ typedef struct SRSRAN_API {
 
   srsran_dmrs_pdcch_estimator_t dmrs_pdcch[SRSRAN_UE_DL_NR_MAX_NOF_CORESET];
   srsran_pdcch_nr_t             pdcch;
-  srsran_dmrs_pdcch_ce_t*       pdcch_ce;
+  srsran_dmrs_pdcch_ce_t*       pdcch_ce[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]; ///< One per batched candidate
 
   /// Store Blind-search information from all possible candidate locations for debug purposes
   srsran_ue_dl_nr_pdcch_info_t pdcch_info[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
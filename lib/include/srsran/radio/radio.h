@@ -108,8 +108,10 @@ private:
   std::mutex                                              rx_mutex;
   std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      tx_buffer;
   std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_buffer;
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>  interpolators      = {};
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>  decimators         = {};
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> poly_interpolators = {};
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> poly_decimators    = {};
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
 
   rf_timestamp_t    end_of_burst_time = {};
@@ -121,6 +123,7 @@ private:
   bool              is_initialized     = false;
   bool              radio_is_streaming = false;
   bool              continuous_tx      = false;
+  bool              use_poly_resampler = false; ///< Resample with the polyphase FIR instead of the FFT resampler
   double            freq_offset        = 0.0;
   double            cur_tx_srate       = 0.0;
   double            cur_rx_srate       = 0.0;
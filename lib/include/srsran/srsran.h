@@ -119,6 +119,7 @@ extern "C" {
 #include "srsran/phy/phch/uci_nr.h"
 
 #include "srsran/phy/ue/ue_cell_search.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
 #include "srsran/phy/ue/ue_dl.h"
 #include "srsran/phy/ue/ue_dl_nr.h"
 #include "srsran/phy/ue/ue_mib.h"
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/asn1/asn1_utils.h"
+#include <endian.h>
 
 namespace asn1 {
 
@@ -46,6 +47,129 @@ void assert_choice_type(uint32_t val, uint32_t choice_id)
   }
 }
 
+/************************
+      memory arena
+************************/
+
+mem_arena::~mem_arena()
+{
+  srsran_assert(nof_live == 0, "ASN.1 arena destroyed with %d objects still alive", nof_live);
+}
+
+void* mem_arena::allocate(size_t sz, size_t alignment)
+{
+  for (; cur_block < blocks.size(); ++cur_block) {
+    void* p = blocks[cur_block].alloc.allocate(sz, alignment);
+    if (p != nullptr) {
+      nof_allocs++;
+      nof_live++;
+      return p;
+    }
+  }
+  // Memory exhausted, grow the arena with a new block
+  size_t  blk_sz = std::max(block_size, sz + alignment);
+  block_t blk;
+  blk.mem.reset(new uint8_t[blk_sz]);
+  blk.alloc = srsran::linear_allocator(blk.mem.get(), blk_sz);
+  blocks.push_back(std::move(blk));
+  cur_block = blocks.size() - 1;
+  void* p   = blocks.back().alloc.allocate(sz, alignment);
+  nof_allocs++;
+  nof_live++;
+  return p;
+}
+
+void mem_arena::deallocate(void* p)
+{
+  srsran_assert(nof_live > 0, "Deallocation of a pointer not allocated from the ASN.1 arena");
+  nof_live--;
+}
+
+void mem_arena::reset()
+{
+  srsran_assert(nof_live == 0, "ASN.1 arena reset with %d objects still alive", nof_live);
+  for (block_t& blk : blocks) {
+    blk.alloc = srsran::linear_allocator(blk.mem.get(), blk.alloc.size());
+  }
+  cur_block  = 0;
+  nof_allocs = 0;
+}
+
+size_t mem_arena::nof_bytes_allocated() const
+{
+  size_t sum = 0;
+  for (const block_t& blk : blocks) {
+    sum += blk.alloc.nof_bytes_allocated();
+  }
+  return sum;
+}
+
+static thread_local mem_arena*    current_arena = nullptr;
+static thread_local alloc_stats_t alloc_stats;
+
+arena_scope::arena_scope(mem_arena& arena) : prev(current_arena)
+{
+  current_arena = &arena;
+}
+
+arena_scope::~arena_scope()
+{
+  current_arena = prev;
+}
+
+const alloc_stats_t& get_alloc_stats()
+{
+  return alloc_stats;
+}
+
+void reset_alloc_stats()
+{
+  alloc_stats = {};
+}
+
+void set_alloc_stats_enabled(bool enabled)
+{
+  detail::alloc_stats_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+namespace detail {
+
+std::atomic<bool> alloc_stats_enabled{false};
+
+mem_arena* get_current_arena()
+{
+  return current_arena;
+}
+
+void count_alloc_enabled(const mem_arena* arena)
+{
+  if (arena != nullptr) {
+    alloc_stats.nof_arena_allocs++;
+  } else {
+    alloc_stats.nof_heap_allocs++;
+  }
+}
+
+void* allocate_array_mem(size_t sz)
+{
+  mem_arena* arena = current_arena;
+  count_alloc(arena);
+  void* p = arena != nullptr ? arena->allocate(sz, alignof(array_header_t)) : ::operator new(sz);
+  static_cast<array_header_t*>(p)->arena = arena;
+  return p;
+}
+
+void deallocate_array_mem(array_header_t* hdr)
+{
+  if (hdr->arena != nullptr) {
+    hdr->arena->deallocate(hdr);
+  } else {
+    ::operator delete(hdr);
+  }
+}
+
+} // namespace detail
+
 /************************
      error handling
 ************************/
@@ -144,34 +268,73 @@ int bit_ref_impl<Ptr>::distance_bytes_end() const
   return ((int)(max_ptr - ptr)) - ((offset) ? 1 : 0);
 }
 
+/**
+ * Loads the 8 bytes starting at ptr as a big-endian word. Bytes at or beyond max_ptr are not accessed and read as zero.
+ */
+static inline uint64_t load_be64(const uint8_t* ptr, const uint8_t* max_ptr)
+{
+  uint64_t w = 0;
+  if (ptr + sizeof(w) <= max_ptr) {
+    memcpy(&w, ptr, sizeof(w));
+    return be64toh(w);
+  }
+  for (uint32_t i = 0; ptr + i < max_ptr; ++i) {
+    w |= (uint64_t)ptr[i] << (56u - 8u * i);
+  }
+  return w;
+}
+
+/**
+ * Stores a big-endian word in the 8 bytes starting at ptr. Bytes at or beyond max_ptr are not accessed.
+ */
+static inline void store_be64(uint8_t* ptr, const uint8_t* max_ptr, uint64_t w)
+{
+  if (ptr + sizeof(w) <= max_ptr) {
+    w = htobe64(w);
+    memcpy(ptr, &w, sizeof(w));
+    return;
+  }
+  for (uint32_t i = 0; ptr + i < max_ptr; ++i) {
+    ptr[i] = (uint8_t)(w >> (56u - 8u * i));
+  }
+}
+
 SRSASN_CODE bit_ref::pack(uint64_t val, uint32_t n_bits)
 {
   if (n_bits >= 64) {
     log_error("This method only supports packing up to 64 bits");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
-  uint64_t mask;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("pack: Buffer size limit was achieved");
-      return SRSASN_ERROR_ENCODE_FAIL;
-    }
-    mask             = ((1ul << n_bits) - 1ul);
-    val              = val & mask;
-    uint8_t keepmask = ((uint8_t)-1) - (uint8_t)((1u << (8u - offset)) - 1u);
-    if ((uint32_t)(8 - offset) > n_bits) {
-      auto bit = static_cast<uint8_t>(val << (8u - offset - n_bits));
-      *ptr     = ((*ptr) & keepmask) + bit;
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto bit = static_cast<uint8_t>(val >> (n_bits - 8u + offset));
-      *ptr     = (*ptr & keepmask) + bit;
-      n_bits -= (8 - offset);
-      offset = 0;
-      ptr++;
-    }
+  // Single bounds check for all the bytes the field touches
+  uint32_t end_bit = offset + n_bits;
+  if (ptr + (end_bit + 7u) / 8u > max_ptr) {
+    log_error("pack: Buffer size limit was achieved");
+    return SRSASN_ERROR_ENCODE_FAIL;
+  }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
   }
+  if (end_bit > 64) {
+    // The field spans nine bytes, write it in two parts. Both fit in the bytes already checked
+    pack(val >> 32u, n_bits - 32u);
+    return pack(val, 32u);
+  }
+
+  // Keep the bits preceding the field and the bytes following the last byte it touches. The trailing bits of the last
+  // byte are cleared
+  uint32_t nof_bytes = (end_bit + 7u) / 8u;
+  uint64_t keepmask  = ~(UINT64_MAX >> offset);
+  if (nof_bytes < 8) {
+    keepmask |= UINT64_MAX >> (8u * nof_bytes);
+  }
+  val &= (UINT64_C(1) << n_bits) - 1U;
+
+  uint64_t w = load_be64(ptr, max_ptr);
+  w          = (w & keepmask) | (val << (64u - end_bit));
+  store_be64(ptr, max_ptr, w);
+
+  ptr += end_bit / 8u;
+  offset = end_bit % 8u;
   return SRSASN_SUCCESS;
 }
 
@@ -183,24 +346,25 @@ SRSASN_CODE unpack_bits(T& val, Ptr& ptr, uint8_t& offset, const uint8_t* max_pt
     return SRSASN_ERROR_DECODE_FAIL;
   }
   val = 0;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("unpack_bits: Buffer size limit was achieved");
-      return SRSASN_ERROR_DECODE_FAIL;
-    }
-    if ((uint32_t)(8 - offset) > n_bits) {
-      uint8_t mask = (uint8_t)(1u << (8u - offset)) - (uint8_t)(1u << (8u - offset - n_bits));
-      val += ((uint32_t)((*ptr) & mask)) >> (8u - offset - n_bits);
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto mask = static_cast<uint8_t>((1u << (8u - offset)) - 1u);
-      val += static_cast<T>((*ptr) & mask) << (n_bits - 8 + offset);
-      n_bits -= 8 - offset;
-      offset = 0;
-      ptr++;
-    }
+  // Single bounds check for all the bytes the field touches
+  uint32_t end_bit = offset + n_bits;
+  if (ptr + (end_bit + 7u) / 8u > max_ptr) {
+    log_error("unpack_bits: Buffer size limit was achieved");
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
+  }
+
+  uint64_t w = load_be64(ptr, max_ptr) << offset;
+  if (end_bit > 64) {
+    // The field spans nine bytes, the ninth was covered by the bounds check
+    w |= (uint64_t)ptr[8] >> (8u - offset);
   }
+  val = static_cast<T>(w >> (64u - n_bits));
+
+  ptr += end_bit / 8u;
+  offset = end_bit % 8u;
   return SRSASN_SUCCESS;
 }
 
@@ -260,7 +424,15 @@ SRSASN_CODE bit_ref_impl<Ptr>::unpack_bytes(uint8_t* buf, uint32_t n_bytes)
       log_error("unpack_bytes (unaligned): Buffer size limit was achieved");
       return SRSASN_ERROR_DECODE_FAIL;
     }
-    for (uint32_t i = 0; i < n_bytes; ++i) {
+    // Eight bytes at a time, each word straddles nine input bytes which are within the checked limit
+    uint32_t i = 0;
+    for (; i + 8 <= n_bytes; i += 8) {
+      uint64_t w = (load_be64(ptr, max_ptr) << offset) | ((uint64_t)ptr[8] >> (8u - offset));
+      w          = htobe64(w);
+      memcpy(&buf[i], &w, sizeof(w));
+      ptr += 8;
+    }
+    for (; i < n_bytes; ++i) {
       HANDLE_CODE(unpack(buf[i], 8));
     }
   }
@@ -285,8 +457,8 @@ template <typename Ptr>
 SRSASN_CODE bit_ref_impl<Ptr>::advance_bits(uint32_t n_bits)
 {
   uint32_t extra_bits     = (offset + n_bits) % 8;
-  uint32_t bytes_required = ceilf((offset + n_bits) / 8.0f);
-  uint32_t bytes_offset   = floorf((offset + n_bits) / 8.0f);
+  uint32_t bytes_required = (offset + n_bits + 7) / 8;
+  uint32_t bytes_offset   = (offset + n_bits) / 8;
 
   if (ptr + bytes_required > max_ptr) {
     log_error("advance_bytes: Buffer size limit was achieved");
@@ -314,7 +486,8 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
   if (n_bytes == 0) {
     return SRSASN_SUCCESS;
   }
-  if (ptr + n_bytes >= max_ptr) {
+  // The unaligned case touches one extra byte
+  if (ptr + n_bytes + (offset ? 1 : 0) > max_ptr) {
     log_error("pack_bytes: Buffer size limit was achieved");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
@@ -323,7 +496,20 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
     memcpy(ptr, buf, n_bytes);
     ptr += n_bytes;
   } else {
-    for (uint32_t i = 0; i < n_bytes; ++i) {
+    // Eight bytes at a time, each word straddles nine output bytes which are within the checked limit
+    uint32_t i = 0;
+    for (; i + 8 <= n_bytes; i += 8) {
+      uint64_t v;
+      memcpy(&v, &buf[i], sizeof(v));
+      v = be64toh(v);
+
+      uint64_t w = load_be64(ptr, max_ptr);
+      w          = (w & ~(UINT64_MAX >> offset)) | (v >> offset);
+      store_be64(ptr, max_ptr, w);
+      ptr[8] = (uint8_t)(v << (8u - offset));
+      ptr += 8;
+    }
+    for (; i < n_bytes; ++i) {
       pack(buf[i], 8);
     }
   }
@@ -1452,9 +1638,7 @@ varlength_field_pack_guard::~varlength_field_pack_guard()
   pack_length(brefstart, nof_bytes, align);
 
   // pack encoded bytes
-  for (uint32_t i = 0; i < nof_bytes; ++i) {
-    brefstart.pack((*buffer_ptr)[i], 8);
-  }
+  brefstart.pack_bytes(buffer_ptr->data(), nof_bytes);
   *bref_tracker = brefstart;
 }
 
@@ -1471,6 +1655,68 @@ varlength_field_unpack_guard::~varlength_field_unpack_guard()
   bref_tracker->unpack(pad, len * 8 - bref_tracker->distance(bref0));
 }
 
+/*******************
+   Lazy AP decoding
+*******************/
+
+SRSASN_CODE ap_pdu_view::unpack(const uint8_t* buf_, uint32_t nof_bytes_)
+{
+  buf       = buf_;
+  nof_bytes = nof_bytes_;
+  ies.resize(0);
+  cbit_ref bref(buf, nof_bytes);
+
+  // PDU CHOICE, extensible with three root alternatives
+  bool choice_ext;
+  HANDLE_CODE(bref.unpack(choice_ext, 1));
+  HANDLE_CODE(bref.unpack(type_, 2));
+  if (choice_ext or type_ > 2) {
+    log_error("Unsupported PDU type=%d", type_);
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  HANDLE_CODE(unpack_integer(proc_code_, bref, (uint16_t)0u, (uint16_t)255u, false, true));
+  HANDLE_CODE(bref.unpack(crit_, 2));
+
+  // Open type with the elementary procedure message
+  uint32_t msg_len;
+  HANDLE_CODE(unpack_length(msg_len, bref, true));
+  if (bref.distance_bytes() + msg_len > nof_bytes) {
+    log_error("PDU message length=%d exceeds the buffer size=%d", msg_len, nof_bytes);
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  HANDLE_CODE(bref.unpack(ext_, 1));
+  uint32_t nof_ies = 0;
+  HANDLE_CODE(unpack_length(nof_ies, bref, 0u, 65535u, true));
+  if (nof_ies > max_nof_ies) {
+    // Not an encoding error, the caller falls back to the full decoder
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+
+  // Index the IEs, skipping their values
+  ies.resize(nof_ies);
+  for (ie_t& ie : ies) {
+    uint32_t id, len;
+    HANDLE_CODE(unpack_integer(id, bref, (uint32_t)0u, (uint32_t)65535u, false, true));
+    HANDLE_CODE(bref.unpack(ie.crit, 2));
+    HANDLE_CODE(unpack_length(len, bref, true));
+    ie.id     = id;
+    ie.offset = bref.distance_bytes();
+    ie.len    = len;
+    HANDLE_CODE(bref.advance_bits(len * 8));
+  }
+  return SRSASN_SUCCESS;
+}
+
+const ap_pdu_view::ie_t* ap_pdu_view::find_ie(uint32_t id) const
+{
+  for (const ie_t& ie : ies) {
+    if (ie.id == id) {
+      return &ie;
+    }
+  }
+  return nullptr;
+}
+
 /*******************
     JsonWriter
 *******************/
@@ -0,0 +1,197 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/cpu_topology.h"
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace srsran {
+
+static bool read_sysfs_line(const std::string& path, std::string& line)
+{
+  std::ifstream file(path);
+  if (not file.is_open() or not std::getline(file, line)) {
+    return false;
+  }
+  return true;
+}
+
+static bool read_sysfs_uint(const std::string& path, uint32_t& value)
+{
+  std::string line;
+  if (not read_sysfs_line(path, line)) {
+    return false;
+  }
+  char* end = nullptr;
+  value     = strtoul(line.c_str(), &end, 10);
+  return end != line.c_str();
+}
+
+/// First CPU of a sysfs CPU list file, used to identify the core or cache shared by the CPUs in the list
+static bool read_first_cpu(const std::string& path, uint32_t& cpu)
+{
+  std::string           line;
+  std::vector<uint32_t> list;
+  if (not read_sysfs_line(path, line) or not cpu_topology::parse_cpu_list(line, list) or list.empty()) {
+    return false;
+  }
+  cpu = *std::min_element(list.begin(), list.end());
+  return true;
+}
+
+bool cpu_topology::parse_cpu_list(const std::string& str, std::vector<uint32_t>& cpus_)
+{
+  std::stringstream ss(str);
+  std::string       range;
+  cpus_.clear();
+  while (std::getline(ss, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+    if (range.empty()) {
+      continue;
+    }
+    char*    end   = nullptr;
+    uint32_t first = strtoul(range.c_str(), &end, 10);
+    uint32_t last  = first;
+    if (end == range.c_str()) {
+      return false;
+    }
+    if (*end == '-') {
+      const char* last_str = end + 1;
+      last                 = strtoul(last_str, &end, 10);
+      if (end == last_str or last < first) {
+        return false;
+      }
+    }
+    if (*end != '\0') {
+      return false;
+    }
+    for (uint32_t cpu = first; cpu <= last; cpu++) {
+      cpus_.push_back(cpu);
+    }
+  }
+  std::sort(cpus_.begin(), cpus_.end());
+  cpus_.erase(std::unique(cpus_.begin(), cpus_.end()), cpus_.end());
+  return true;
+}
+
+std::string cpu_topology::to_cpu_list(const std::vector<uint32_t>& cpus_)
+{
+  std::vector<uint32_t> sorted = cpus_;
+  std::sort(sorted.begin(), sorted.end());
+  std::string str;
+  for (size_t i = 0; i < sorted.size();) {
+    size_t j = i;
+    while (j + 1 < sorted.size() and sorted[j + 1] == sorted[j] + 1) {
+      j++;
+    }
+    str += (str.empty() ? "" : ",") + std::to_string(sorted[i]);
+    if (j > i) {
+      str += "-" + std::to_string(sorted[j]);
+    }
+    i = j + 1;
+  }
+  return str;
+}
+
+cpu_topology cpu_topology::discover(const std::string& sysfs_root)
+{
+  cpu_topology          topo;
+  std::string           line;
+  std::vector<uint32_t> online;
+  if (not read_sysfs_line(sysfs_root + "/cpu/online", line) or not parse_cpu_list(line, online) or online.empty()) {
+    online.clear();
+    for (uint32_t cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1U); cpu++) {
+      online.push_back(cpu);
+    }
+  }
+
+  for (uint32_t cpu : online) {
+    cpu_info_t  info;
+    std::string cpu_path = sysfs_root + "/cpu/cpu" + std::to_string(cpu);
+    info.cpu             = cpu;
+    info.core            = cpu;
+    info.llc             = cpu;
+    read_sysfs_uint(cpu_path + "/topology/physical_package_id", info.package);
+    read_first_cpu(cpu_path + "/topology/thread_siblings_list", info.core);
+
+    // The last level cache is the unified or data cache with the highest level
+    uint32_t llc_level = 0;
+    for (uint32_t index = 0;; index++) {
+      std::string cache_path = cpu_path + "/cache/index" + std::to_string(index);
+      uint32_t    level      = 0;
+      if (not read_sysfs_uint(cache_path + "/level", level)) {
+        break;
+      }
+      if (read_sysfs_line(cache_path + "/type", line) and line == "Instruction") {
+        continue;
+      }
+      if (level > llc_level and read_first_cpu(cache_path + "/shared_cpu_list", info.llc)) {
+        llc_level = level;
+      }
+    }
+    topo.cpus.push_back(info);
+  }
+
+  // NUMA nodes list their CPUs. Without NUMA support all CPUs stay in node 0
+  std::vector<uint32_t> nodes;
+  if (read_sysfs_line(sysfs_root + "/node/online", line) and parse_cpu_list(line, nodes)) {
+    for (uint32_t node : nodes) {
+      std::vector<uint32_t> node_cpus;
+      if (not read_sysfs_line(sysfs_root + "/node/node" + std::to_string(node) + "/cpulist", line) or
+          not parse_cpu_list(line, node_cpus)) {
+        continue;
+      }
+      for (cpu_info_t& info : topo.cpus) {
+        if (std::binary_search(node_cpus.begin(), node_cpus.end(), info.cpu)) {
+          info.node = node;
+        }
+      }
+    }
+  }
+  return topo;
+}
+
+const cpu_info_t* cpu_topology::find_cpu(uint32_t cpu) const
+{
+  auto it = std::find_if(cpus.begin(), cpus.end(), [cpu](const cpu_info_t& info) { return info.cpu == cpu; });
+  return it != cpus.end() ? &(*it) : nullptr;
+}
+
+uint32_t cpu_topology::count_distinct(uint32_t cpu_info_t::*field) const
+{
+  std::set<uint32_t> values;
+  for (const cpu_info_t& info : cpus) {
+    values.insert(info.*field);
+  }
+  return values.size();
+}
+
+std::string cpu_topology::to_string() const
+{
+  return "sockets=" + std::to_string(nof_packages()) + " nodes=" + std::to_string(nof_nodes()) +
+         " llcs=" + std::to_string(nof_llcs()) + " cores=" + std::to_string(nof_cores()) +
+         " cpus=" + std::to_string(nof_cpus());
+}
+
+} // namespace srsran
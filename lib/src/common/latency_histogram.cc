@@ -0,0 +1,112 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace srsran {
+
+uint64_t latency_histogram::get_bucket_min(uint32_t bucket)
+{
+  if (bucket < nof_sub_buckets) {
+    return bucket;
+  }
+  uint32_t shift = bucket / nof_sub_buckets - 1;
+  return (uint64_t)(nof_sub_buckets + bucket % nof_sub_buckets) << shift;
+}
+
+uint64_t latency_histogram::snapshot_t::quantile_ns(double q) const
+{
+  if (count == 0) {
+    return 0;
+  }
+  uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(q * count));
+  uint64_t acc  = 0;
+  for (uint32_t i = 0; i < nof_buckets - 1; i++) {
+    acc += buckets[i];
+    if (acc >= rank) {
+      return std::min(get_bucket_min(i + 1) - 1, max_ns);
+    }
+  }
+  return max_ns;
+}
+
+void latency_histogram::get_snapshot(snapshot_t& snapshot)
+{
+  snapshot = {};
+  for (shard_t& shard : shards) {
+    for (uint32_t i = 0; i < nof_buckets; i++) {
+      snapshot.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count += shard.count.load(std::memory_order_relaxed);
+    snapshot.sum_ns += shard.sum_ns.load(std::memory_order_relaxed);
+    snapshot.max_ns = std::max(snapshot.max_ns, shard.max_ns.exchange(0, std::memory_order_relaxed));
+  }
+}
+
+latency_histogram_registry& latency_histogram_registry::get_instance()
+{
+  static latency_histogram_registry registry;
+  return registry;
+}
+
+latency_histogram& latency_histogram_registry::get_histogram(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<entry_t>&   entry = histograms[name];
+  if (entry == nullptr) {
+    entry.reset(new entry_t);
+  }
+  return entry->hist;
+}
+
+void latency_histogram_registry::get_metrics(latency_metrics_t& metrics)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  metrics.clear();
+  latency_histogram::snapshot_t current, period;
+  for (auto& it : histograms) {
+    entry_t& entry = *it.second;
+    entry.hist.get_snapshot(current);
+
+    // The buckets and counters are cumulative, the period is the difference with the previous call
+    for (uint32_t i = 0; i < latency_histogram::nof_buckets; i++) {
+      period.buckets[i] = current.buckets[i] - entry.last.buckets[i];
+    }
+    period.count  = current.count - entry.last.count;
+    period.sum_ns = current.sum_ns - entry.last.sum_ns;
+    period.max_ns = current.max_ns;
+    entry.last    = current;
+
+    latency_metrics_entry_t m;
+    m.name    = it.first;
+    m.count   = period.count;
+    m.mean_us = period.count > 0 ? period.sum_ns / 1e3 / period.count : 0;
+    m.p50_us  = period.quantile_ns(0.5) / 1e3;
+    m.p99_us  = period.quantile_ns(0.99) / 1e3;
+    m.p999_us = period.quantile_ns(0.999) / 1e3;
+    m.max_us  = period.max_ns / 1e3;
+    metrics.push_back(m);
+  }
+}
+
+} // namespace srsran
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/network_utils.h"
+#include "srsran/common/thread_placement.h"
 
 #include <netinet/sctp.h>
 #include <sys/socket.h>
@@ -400,7 +401,8 @@ socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslo
   // register control pipe fd
   int fd = pipe(pipefd);
   srsran_assert(fd != -1, "Failed to open control pipe");
-  start(thread_prio);
+  // Most of the packets read by this thread are GTP-U
+  get_thread_placement().start(*this, "gtpu", 0, thread_prio);
 }
 
 socket_manager::~socket_manager()
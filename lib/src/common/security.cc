@@ -25,7 +25,13 @@
 #include "srsran/common/s3g.h"
 #include "srsran/common/ssl.h"
 #include "srsran/config.h"
+#include <algorithm>
 #include <arpa/inet.h>
+#include <string.h>
+
+#ifdef LV_HAVE_AESNI
+#include <wmmintrin.h>
+#endif // LV_HAVE_AESNI
 
 #define FC_EPS_K_ASME_DERIVATION 0x10
 #define FC_EPS_K_ENB_DERIVATION 0x11
@@ -914,6 +920,152 @@ uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_
   return liblte_security_milenage_f5_star(k, op, rand, ak);
 }
 
+#ifdef LV_HAVE_AESNI
+
+/// Number of vectors computed together, their blocks are encrypted interleaved
+#define MILENAGE_BATCH_NOF_VECTORS 8
+
+static inline __m128i aesni_key_expand_128(__m128i key, __m128i keygened)
+{
+  keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, keygened);
+}
+
+static void aesni_set_key_128(const uint8_t* k, __m128i* rk)
+{
+  rk[0]  = _mm_loadu_si128((const __m128i*)k);
+  rk[1]  = aesni_key_expand_128(rk[0], _mm_aeskeygenassist_si128(rk[0], 0x01));
+  rk[2]  = aesni_key_expand_128(rk[1], _mm_aeskeygenassist_si128(rk[1], 0x02));
+  rk[3]  = aesni_key_expand_128(rk[2], _mm_aeskeygenassist_si128(rk[2], 0x04));
+  rk[4]  = aesni_key_expand_128(rk[3], _mm_aeskeygenassist_si128(rk[3], 0x08));
+  rk[5]  = aesni_key_expand_128(rk[4], _mm_aeskeygenassist_si128(rk[4], 0x10));
+  rk[6]  = aesni_key_expand_128(rk[5], _mm_aeskeygenassist_si128(rk[5], 0x20));
+  rk[7]  = aesni_key_expand_128(rk[6], _mm_aeskeygenassist_si128(rk[6], 0x40));
+  rk[8]  = aesni_key_expand_128(rk[7], _mm_aeskeygenassist_si128(rk[7], 0x80));
+  rk[9]  = aesni_key_expand_128(rk[8], _mm_aeskeygenassist_si128(rk[8], 0x1b));
+  rk[10] = aesni_key_expand_128(rk[9], _mm_aeskeygenassist_si128(rk[9], 0x36));
+}
+
+/// Encrypts independent blocks in place, each round is applied to all of them so that the AES pipeline stays full
+static inline void aesni_encrypt_blocks(const __m128i* rk, __m128i* blocks, uint32_t nof_blocks)
+{
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    blocks[i] = _mm_xor_si128(blocks[i], rk[0]);
+  }
+  for (uint32_t r = 1; r < 10; r++) {
+    for (uint32_t i = 0; i < nof_blocks; i++) {
+      blocks[i] = _mm_aesenc_si128(blocks[i], rk[r]);
+    }
+  }
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    blocks[i] = _mm_aesenclast_si128(blocks[i], rk[10]);
+  }
+}
+
+/// Loads a block rotated left by the given number of bytes, as the Milenage rot() function
+static inline __m128i milenage_rot(const uint8_t* in, uint32_t r)
+{
+  uint8_t out[16];
+  for (uint32_t i = 0; i < 16; i++) {
+    out[i] = in[(i + r) % 16];
+  }
+  return _mm_loadu_si128((const __m128i*)out);
+}
+
+static void milenage_f12345_batch_aesni(const uint8_t*     k,
+                                        const uint8_t*     opc,
+                                        const uint8_t*     amf,
+                                        milenage_vector_t* vectors,
+                                        uint32_t           nof_vectors)
+{
+  __m128i rk[11];
+  aesni_set_key_128(k, rk);
+
+  const __m128i opc_v = _mm_loadu_si128((const __m128i*)opc);
+  // Constants c2, c3 and c4 of TS 35.206, c1 is zero
+  const __m128i c2 = _mm_set_epi8(1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i c3 = _mm_set_epi8(2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i c4 = _mm_set_epi8(4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+  for (uint32_t v0 = 0; v0 < nof_vectors; v0 += MILENAGE_BATCH_NOF_VECTORS) {
+    uint32_t           n = std::min(nof_vectors - v0, (uint32_t)MILENAGE_BATCH_NOF_VECTORS);
+    milenage_vector_t* v = &vectors[v0];
+
+    // TEMP = E_K(RAND xor OPc)
+    __m128i temp[MILENAGE_BATCH_NOF_VECTORS];
+    for (uint32_t i = 0; i < n; i++) {
+      temp[i] = _mm_xor_si128(_mm_loadu_si128((const __m128i*)v[i].rand), opc_v);
+    }
+    aesni_encrypt_blocks(rk, temp, n);
+
+    // OUT1 (f1), OUT2 (f2 and f5), OUT3 (f3) and OUT4 (f4) of every vector
+    __m128i out[4 * MILENAGE_BATCH_NOF_VECTORS];
+    for (uint32_t i = 0; i < n; i++) {
+      // IN1 = SQN || AMF || SQN || AMF repeats every 8 bytes, so rot(IN1 xor OPc, 64) only rotates OPc
+      uint8_t in1_opc[16];
+      uint8_t temp_opc[16];
+      for (uint32_t j = 0; j < 16; j++) {
+        in1_opc[j] = opc[(j + 8) % 16] ^ ((j % 8) < 6 ? v[i].sqn[j % 8] : amf[j % 8 - 6]);
+      }
+      _mm_storeu_si128((__m128i*)temp_opc, _mm_xor_si128(temp[i], opc_v));
+
+      out[4 * i + 0] = _mm_xor_si128(temp[i], _mm_loadu_si128((const __m128i*)in1_opc));
+      out[4 * i + 1] = _mm_xor_si128(milenage_rot(temp_opc, 0), c2);
+      out[4 * i + 2] = _mm_xor_si128(milenage_rot(temp_opc, 4), c3);
+      out[4 * i + 3] = _mm_xor_si128(milenage_rot(temp_opc, 8), c4);
+    }
+    aesni_encrypt_blocks(rk, out, 4 * n);
+
+    for (uint32_t i = 0; i < n; i++) {
+      uint8_t out1[16];
+      uint8_t out2[16];
+      _mm_storeu_si128((__m128i*)out1, _mm_xor_si128(out[4 * i + 0], opc_v));
+      _mm_storeu_si128((__m128i*)out2, _mm_xor_si128(out[4 * i + 1], opc_v));
+      _mm_storeu_si128((__m128i*)v[i].ck, _mm_xor_si128(out[4 * i + 2], opc_v));
+      _mm_storeu_si128((__m128i*)v[i].ik, _mm_xor_si128(out[4 * i + 3], opc_v));
+      memcpy(v[i].mac_a, out1, sizeof(v[i].mac_a));
+      memcpy(v[i].res, &out2[8], sizeof(v[i].res));
+      memcpy(v[i].ak, out2, sizeof(v[i].ak));
+    }
+  }
+}
+
+#endif // LV_HAVE_AESNI
+
+int security_milenage_f12345_batch(const uint8_t*     k,
+                                   const uint8_t*     opc,
+                                   const uint8_t*     amf,
+                                   milenage_vector_t* vectors,
+                                   uint32_t           nof_vectors)
+{
+  if (k == nullptr || opc == nullptr || amf == nullptr || (vectors == nullptr && nof_vectors > 0)) {
+    return SRSRAN_ERROR;
+  }
+
+#ifdef LV_HAVE_AESNI
+  milenage_f12345_batch_aesni(k, opc, amf, vectors, nof_vectors);
+#else  // LV_HAVE_AESNI
+  uint8_t k_tmp[16];
+  uint8_t opc_tmp[16];
+  uint8_t amf_tmp[2];
+  memcpy(k_tmp, k, sizeof(k_tmp));
+  memcpy(opc_tmp, opc, sizeof(opc_tmp));
+  memcpy(amf_tmp, amf, sizeof(amf_tmp));
+  for (uint32_t i = 0; i < nof_vectors; i++) {
+    milenage_vector_t& v = vectors[i];
+    if (liblte_security_milenage_f2345(k_tmp, opc_tmp, v.rand, v.res, v.ck, v.ik, v.ak) != LIBLTE_SUCCESS ||
+        liblte_security_milenage_f1(k_tmp, opc_tmp, v.rand, v.sqn, amf_tmp, v.mac_a) != LIBLTE_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+#endif // LV_HAVE_AESNI
+
+  return SRSRAN_SUCCESS;
+}
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak)
 {
   uint8_t xdout[16];
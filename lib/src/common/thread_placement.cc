@@ -0,0 +1,303 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/thread_placement.h"
+#include "srsran/common/standard_streams.h"
+#include <algorithm>
+#include <linux/mempolicy.h>
+#include <set>
+#include <sstream>
+#include <sys/syscall.h>
+#include <tuple>
+
+namespace srsran {
+
+/// Dedicated cores for the real-time threads of a LTE cell, the rest share what is left in the node of the radio
+static const char* auto_policy = "txrx:core,sync:core,phy:core,prach:cpu,stack:core,gtpu:node,gw:node,log:node";
+
+const std::vector<std::string>& thread_placement::get_roles()
+{
+  static const std::vector<std::string> roles = {
+      "txrx", "sync", "phy", "phy_nr", "prach", "stack", "gtpu", "gw", "log"};
+  return roles;
+}
+
+bool thread_placement::init(const std::string&                     policy,
+                            const cpu_topology&                    topology_,
+                            const std::map<std::string, uint32_t>& nof_threads)
+{
+  topology = topology_;
+  roles.clear();
+  role_order.clear();
+  if (not apply_policy(policy, nof_threads)) {
+    roles.clear();
+    role_order.clear();
+    return false;
+  }
+  return true;
+}
+
+bool thread_placement::apply_policy(const std::string& policy, const std::map<std::string, uint32_t>& nof_threads)
+{
+  std::stringstream  ss(policy == "auto" ? auto_policy : policy);
+  std::string        item;
+  std::set<uint32_t> used_cpus;
+
+  // Dedicated cores and CPUs are taken in the order of the policy, filling a LLC before moving to the next
+  std::vector<cpu_info_t> cpus = topology.get_cpus();
+  std::sort(cpus.begin(), cpus.end(), [](const cpu_info_t& a, const cpu_info_t& b) {
+    return std::tie(a.llc, a.core, a.cpu) < std::tie(b.llc, b.core, b.cpu);
+  });
+
+  std::map<std::string, uint32_t> role_nodes;
+  std::vector<std::string>        items;
+  // Items may hold CPU lists with commas, which are glued to the previous item
+  while (std::getline(ss, item, ',')) {
+    item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+    if (item.empty()) {
+      continue;
+    }
+    if (item.find(':') == std::string::npos and not items.empty()) {
+      items.back() += "," + item;
+    } else {
+      items.push_back(item);
+    }
+  }
+
+  for (const std::string& it : items) {
+    size_t colon = it.find(':');
+    if (colon == std::string::npos) {
+      console_stderr("Invalid thread placement item \"%s\", expected role:rule\n", it.c_str());
+      return false;
+    }
+    std::string role = it.substr(0, colon);
+    std::string rule = it.substr(colon + 1);
+    if (std::find(get_roles().begin(), get_roles().end(), role) == get_roles().end()) {
+      console_stderr("Unknown thread role \"%s\" in thread placement\n", role.c_str());
+      return false;
+    }
+    if (roles.count(role) > 0) {
+      console_stderr("Thread role \"%s\" placed twice\n", role.c_str());
+      return false;
+    }
+
+    uint32_t node = 0;
+    size_t   at   = rule.find('@');
+    if (at != std::string::npos) {
+      char* end = nullptr;
+      node      = strtoul(rule.c_str() + at + 1, &end, 10);
+      if (end == rule.c_str() + at + 1 or *end != '\0') {
+        console_stderr("Invalid NUMA node in thread placement \"%s\"\n", it.c_str());
+        return false;
+      }
+      rule = rule.substr(0, at);
+    }
+    bool node_found = std::any_of(cpus.begin(), cpus.end(), [node](const cpu_info_t& c) { return c.node == node; });
+    if (not node_found) {
+      console_stderr("NUMA node %d of thread placement \"%s\" has no CPUs\n", node, it.c_str());
+      return false;
+    }
+
+    role_placement_t& placement = roles[role];
+    placement.rule              = rule;
+    role_order.push_back(role);
+    role_nodes[role] = node;
+
+    if (rule == "core" or rule == "cpu") {
+      auto     nof_it = nof_threads.find(role);
+      uint32_t count  = nof_it != nof_threads.end() ? nof_it->second : 0;
+      for (uint32_t i = 0; i < count; i++) {
+        auto free_it = std::find_if(cpus.begin(), cpus.end(), [&](const cpu_info_t& c) {
+          if (c.node != node or used_cpus.count(c.cpu) > 0) {
+            return false;
+          }
+          if (rule == "cpu") {
+            return true;
+          }
+          // A core is free when none of its SMT siblings is taken
+          return std::none_of(cpus.begin(), cpus.end(), [&](const cpu_info_t& s) {
+            return s.core == c.core and used_cpus.count(s.cpu) > 0;
+          });
+        });
+        if (free_it == cpus.end()) {
+          console_stderr("No free %s left in NUMA node %d for the thread %d of %s. It shares the CPUs of the node\n",
+                         rule.c_str(),
+                         node,
+                         i,
+                         role.c_str());
+          break;
+        }
+        for (const cpu_info_t& c : cpus) {
+          if (c.cpu == free_it->cpu or (rule == "core" and c.core == free_it->core)) {
+            used_cpus.insert(c.cpu);
+          }
+        }
+        placement.thread_cpus.push_back({free_it->cpu});
+      }
+    } else if (rule != "node" and rule != "any") {
+      std::vector<uint32_t> list;
+      if (not cpu_topology::parse_cpu_list(rule, list) or list.empty()) {
+        console_stderr("Invalid rule \"%s\" in thread placement of %s\n", rule.c_str(), role.c_str());
+        return false;
+      }
+      for (uint32_t cpu : list) {
+        if (topology.find_cpu(cpu) == nullptr) {
+          console_stderr("CPU %d in thread placement of %s is not online\n", cpu, role.c_str());
+          return false;
+        }
+      }
+      placement.thread_cpus.push_back(list);
+    }
+  }
+
+  // The shared rules, and the threads beyond the count of the dedicated ones, get what the dedicated rules left
+  for (auto& it : roles) {
+    role_placement_t& placement = it.second;
+    if (placement.rule != "core" and placement.rule != "cpu" and placement.rule != "node" and
+        placement.rule != "any") {
+      continue;
+    }
+    uint32_t              node = role_nodes[it.first];
+    bool                  any  = placement.rule == "any";
+    std::vector<uint32_t> shared, all;
+    for (const cpu_info_t& c : topology.get_cpus()) {
+      if (any or c.node == node) {
+        all.push_back(c.cpu);
+        if (used_cpus.count(c.cpu) == 0) {
+          shared.push_back(c.cpu);
+        }
+      }
+    }
+    placement.thread_cpus.push_back(shared.empty() ? all : shared);
+  }
+  return true;
+}
+
+const std::vector<uint32_t>* thread_placement::find_cpus(const std::string& role, uint32_t idx) const
+{
+  auto it = roles.find(role);
+  if (it == roles.end() or it->second.thread_cpus.empty()) {
+    return nullptr;
+  }
+  const std::vector<std::vector<uint32_t> >& thread_cpus = it->second.thread_cpus;
+  return &thread_cpus[std::min<size_t>(idx, thread_cpus.size() - 1)];
+}
+
+bool thread_placement::get_cpuset(const std::string& role, uint32_t idx, cpu_set_t& cpuset) const
+{
+  const std::vector<uint32_t>* cpus = find_cpus(role, idx);
+  if (cpus == nullptr) {
+    return false;
+  }
+  CPU_ZERO(&cpuset);
+  for (uint32_t cpu : *cpus) {
+    CPU_SET(cpu, &cpuset);
+  }
+  return true;
+}
+
+int thread_placement::get_node(const std::string& role, uint32_t idx) const
+{
+  const std::vector<uint32_t>* cpus = find_cpus(role, idx);
+  if (cpus == nullptr) {
+    return -1;
+  }
+  const cpu_info_t* info = topology.find_cpu(cpus->front());
+  return info != nullptr ? info->node : -1;
+}
+
+bool thread_placement::start(thread& t, const std::string& role, uint32_t idx, int prio) const
+{
+  cpu_set_t cpuset;
+  if (get_cpuset(role, idx, cpuset)) {
+    return t.start_cpuset(prio, cpuset);
+  }
+  return t.start(prio);
+}
+
+std::string thread_placement::to_string() const
+{
+  std::string str = "Thread placement on " + topology.to_string() + ":\n";
+  for (const std::string& role : role_order) {
+    const role_placement_t& placement = roles.at(role);
+    bool                    dedicated = placement.rule == "core" or placement.rule == "cpu";
+    // The threads beyond the dedicated ones share the last entry, only listed when there are no dedicated ones
+    size_t nof_entries = placement.thread_cpus.size() - (dedicated and placement.thread_cpus.size() > 1 ? 1 : 0);
+    for (uint32_t i = 0; i < nof_entries; i++) {
+      const std::vector<uint32_t>& cpus   = placement.thread_cpus[i];
+      bool                         shared = dedicated and i + 1 == placement.thread_cpus.size();
+      std::string                  name   = nof_entries > 1 ? role + "[" + std::to_string(i) + "]" : role;
+      char                         buffer[128];
+      snprintf(buffer,
+               sizeof(buffer),
+               "  %-10s %-6s CPU %s (node %d)\n",
+               name.c_str(),
+               shared ? "shared" : placement.rule.c_str(),
+               cpu_topology::to_cpu_list(cpus).c_str(),
+               get_node(role, i));
+      str += buffer;
+    }
+  }
+  return str;
+}
+
+thread_placement& get_thread_placement()
+{
+  static thread_placement placement;
+  return placement;
+}
+
+scoped_thread_affinity::scoped_thread_affinity(const std::string& role, uint32_t idx)
+{
+  cpu_set_t cpuset;
+  if (not get_thread_placement().get_cpuset(role, idx, cpuset) or
+      pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &old_cpuset) != 0) {
+    return;
+  }
+  changed = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+}
+
+scoped_thread_affinity::~scoped_thread_affinity()
+{
+  if (changed) {
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &old_cpuset);
+  }
+}
+
+scoped_numa_node::scoped_numa_node(const std::string& role, uint32_t idx)
+{
+  int node = get_thread_placement().get_node(role, idx);
+  if (node < 0 or node >= (int)(8 * sizeof(unsigned long))) {
+    return;
+  }
+  unsigned long mask = 1UL << (unsigned)node;
+  // Preferred rather than bound, so that the allocations fall back to other nodes when the node is full
+  changed = syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, 8 * sizeof(mask)) == 0;
+}
+
+scoped_numa_node::~scoped_numa_node()
+{
+  if (changed) {
+    syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+  }
+}
+
+} // namespace srsran
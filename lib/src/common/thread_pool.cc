@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/thread_pool.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/srslog/srslog.h"
 #include <assert.h>
 #include <chrono>
@@ -42,7 +43,7 @@ void thread_pool::worker::setup(uint32_t id, thread_pool* parent, uint32_t prio,
   my_parent = parent;
 
   if (mask == 255) {
-    start(prio);
+    get_thread_placement().start(*this, parent->placement_role, id, prio);
   } else {
     start_cpu_mask(prio, mask);
   }
@@ -94,6 +95,11 @@ void thread_pool::init_worker(uint32_t id, worker* obj, uint32_t prio, uint32_t
   }
 }
 
+void thread_pool::set_placement_role(const std::string& role)
+{
+  placement_role = role;
+}
+
 void thread_pool::stop()
 {
   {
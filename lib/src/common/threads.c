@@ -48,12 +48,39 @@ bool threads_new_rt_mask(pthread_t* thread, void* (*start_routine)(void*), void*
 }
 
 bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void* arg, int cpu, int prio_offset)
+{
+  cpu_set_t cpuset;
+
+  if (cpu > 0) {
+    if (cpu > 50) {
+      uint32_t mask;
+      mask = cpu / 100;
+
+      CPU_ZERO(&cpuset);
+      for (uint32_t i = 0; i < 8; i++) {
+        if (((mask >> i) & 0x01U) == 1U) {
+          CPU_SET((size_t)i, &cpuset);
+        }
+      }
+    } else {
+      CPU_ZERO(&cpuset);
+      CPU_SET((size_t)cpu, &cpuset);
+    }
+    return threads_new_rt_cpuset(thread, start_routine, arg, &cpuset, prio_offset);
+  }
+  return threads_new_rt_cpuset(thread, start_routine, arg, NULL, prio_offset);
+}
+
+bool threads_new_rt_cpuset(pthread_t*       thread,
+                           void* (*start_routine)(void*),
+                           void*            arg,
+                           const cpu_set_t* cpuset,
+                           int              prio_offset)
 {
   bool ret = false;
 
   pthread_attr_t     attr;
   struct sched_param param;
-  cpu_set_t          cpuset;
   bool               attr_enable = false;
 
 #ifdef PER_THREAD_PRIO
@@ -126,23 +153,8 @@ bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void*
       fprintf(stderr, "Error not enough privileges to set Scheduling priority\n");
     }
   }
-  if (cpu > 0) {
-    if (cpu > 50) {
-      uint32_t mask;
-      mask = cpu / 100;
-
-      CPU_ZERO(&cpuset);
-      for (uint32_t i = 0; i < 8; i++) {
-        if (((mask >> i) & 0x01U) == 1U) {
-          CPU_SET((size_t)i, &cpuset);
-        }
-      }
-    } else {
-      CPU_ZERO(&cpuset);
-      CPU_SET((size_t)cpu, &cpuset);
-    }
-
-    if (pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpuset)) {
+  if (cpuset != NULL) {
+    if (pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), cpuset)) {
       perror("pthread_attr_setaffinity_np");
     }
   }
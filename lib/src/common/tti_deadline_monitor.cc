@@ -0,0 +1,126 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tti_deadline_monitor.h"
+#include <algorithm>
+#include <inttypes.h>
+
+namespace srsran {
+
+const char* to_string(tti_stage_t stage)
+{
+  static const char* names[] = {"fft", "decode", "mac", "encode"};
+  return stage < tti_stage_t::nof_stages ? names[static_cast<uint32_t>(stage)] : "invalid";
+}
+
+tti_deadline_monitor::tti_deadline_monitor(srslog::basic_logger& logger_, uint32_t trace_size) :
+  logger(logger_),
+  trace(std::max(trace_size, 1U)),
+  late_trace(std::max(trace_size, 1U)),
+  dump_trace(std::max(trace_size, 1U))
+{}
+
+int32_t tti_deadline_monitor::release(uint32_t tti, bool tx, time_point deadline, const tti_stage_times_t& stages)
+{
+  auto    now      = std::chrono::steady_clock::now();
+  int32_t slack_us = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  trace_entry_t&              entry = trace[trace_idx];
+  entry.tti                         = tti;
+  entry.slack_us                    = slack_us;
+  entry.tx                          = tx;
+  entry.stages                      = stages;
+  trace_idx                         = (trace_idx + 1) % trace.size();
+  trace_len                         = std::min<uint32_t>(trace_len + 1, trace.size());
+
+  period.min_slack_us = period.nof_ttis == 0 ? slack_us : std::min(period.min_slack_us, slack_us);
+  period.nof_ttis++;
+  slack_sum_us += slack_us;
+  for (uint32_t i = 0; i < nof_tti_stages; i++) {
+    stage_sum_us[i] += stages.us[i];
+    period.max_stage_us[i] = std::max(period.max_stage_us[i], stages.us[i]);
+  }
+
+  if (slack_us < 0) {
+    period.nof_late++;
+    nof_late_total++;
+    // Only the first miss of the period is traced, the copy is logged out of the workers
+    if (late_trace_len == 0) {
+      for (uint32_t i = 0; i < trace_len; i++) {
+        late_trace[i] = trace[(trace_idx + trace.size() - trace_len + i) % trace.size()];
+      }
+      late_trace_len = trace_len;
+    }
+  }
+  return slack_us;
+}
+
+uint64_t tti_deadline_monitor::get_nof_late_total()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return nof_late_total;
+}
+
+void tti_deadline_monitor::get_metrics(tti_deadline_metrics_t& metrics)
+{
+  uint32_t dump_len = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    metrics                = period;
+    metrics.nof_late_total = nof_late_total;
+    if (period.nof_ttis > 0) {
+      metrics.avg_slack_us = (float)slack_sum_us / period.nof_ttis;
+      for (uint32_t i = 0; i < nof_tti_stages; i++) {
+        metrics.avg_stage_us[i] = (float)stage_sum_us[i] / period.nof_ttis;
+      }
+    }
+    period       = {};
+    slack_sum_us = 0;
+    stage_sum_us = {};
+
+    // Take the trace, so that the workers are not held while it is logged
+    std::swap(late_trace, dump_trace);
+    dump_len       = late_trace_len;
+    late_trace_len = 0;
+  }
+
+  if (dump_len == 0) {
+    return;
+  }
+  logger.warning("Deadline missed in %" PRIu64 " of %" PRIu64 " TTIs. Trace of the last %d TTIs to the first miss:",
+                 metrics.nof_late,
+                 metrics.nof_ttis,
+                 dump_len);
+  for (uint32_t i = 0; i < dump_len; i++) {
+    const trace_entry_t& e = dump_trace[i];
+    logger.warning("  tti=%d, tx=%s, slack=%d us, fft=%d us, decode=%d us, mac=%d us, encode=%d us",
+                   e.tti,
+                   e.tx ? "yes" : "no",
+                   e.slack_us,
+                   e.stages.us[static_cast<uint32_t>(tti_stage_t::fft)],
+                   e.stages.us[static_cast<uint32_t>(tti_stage_t::decode)],
+                   e.stages.us[static_cast<uint32_t>(tti_stage_t::mac)],
+                   e.stages.us[static_cast<uint32_t>(tti_stage_t::encode)]);
+  }
+}
+
+} // namespace srsran
@@ -235,6 +235,11 @@ int srsran_dmrs_pdcch_estimator_init(srsran_dmrs_pdcch_estimator_t* q,
       free(q->ce);
     }
     q->ce = srsran_vec_cf_malloc(coreset_sz);
+
+    if (q->rb_epre) {
+      free(q->rb_epre);
+    }
+    q->rb_epre = srsran_vec_f_malloc(coreset_bw);
   }
 
   if (q->filter == NULL) {
@@ -265,6 +270,10 @@ void srsran_dmrs_pdcch_estimator_free(srsran_dmrs_pdcch_estimator_t* q)
     free(q->ce);
   }
 
+  if (q->rb_epre) {
+    free(q->rb_epre);
+  }
+
   for (uint32_t i = 0; i < SRSRAN_CORESET_DURATION_MAX; i++) {
     if (q->lse[i]) {
       free(q->lse[i]);
@@ -360,6 +369,15 @@ int srsran_dmrs_pdcch_estimate(srsran_dmrs_pdcch_estimator_t* q,
     srsran_dmrs_pdcch_extract(q, cinit, &sf_symbols[l * q->carrier.nof_prb * SRSRAN_NRE], q->lse[l]);
   }
 
+  // Average pilot power of every PRB, for discarding the candidates without energy before measuring them
+  for (uint32_t rb = 0; rb < q->coreset_bw; rb++) {
+    float epre = 0.0f;
+    for (uint32_t l = 0; l < q->coreset.duration; l++) {
+      epre += srsran_vec_avg_power_cf(&q->lse[l][rb * NOF_PILOTS_X_RB], NOF_PILOTS_X_RB);
+    }
+    q->rb_epre[rb] = epre / (float)q->coreset.duration;
+  }
+
   // Time averaging and smoothing should be implemented here
   // ...
 
@@ -525,6 +543,41 @@ int srsran_dmrs_pdcch_get_measure(const srsran_dmrs_pdcch_estimator_t* q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_dmrs_pdcch_get_epre(const srsran_dmrs_pdcch_estimator_t* q,
+                               const srsran_dci_location_t*         dci_location,
+                               float*                               epre_dBfs)
+{
+  if (q == NULL || dci_location == NULL || epre_dBfs == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Calculate CCE-to-REG mapping mask
+  bool rb_mask[SRSRAN_MAX_PRB_NR] = {};
+  if (srsran_pdcch_nr_cce_to_reg_mapping(&q->coreset, dci_location, rb_mask) < SRSRAN_SUCCESS) {
+    ERROR("Error in CCE-to-REG mapping");
+    return SRSRAN_ERROR;
+  }
+
+  // Every symbol has the same PRBs, so the average of the PRBs is the average of the symbols
+  float    epre   = 0.0f;
+  uint32_t nof_rb = 0;
+  for (uint32_t rb = 0; rb < q->coreset_bw; rb++) {
+    if (rb_mask[rb]) {
+      epre += q->rb_epre[rb];
+      nof_rb++;
+    }
+  }
+
+  if (nof_rb == 0) {
+    ERROR("Error in DMRS EPRE. The DCI location has no PRB");
+    return SRSRAN_ERROR;
+  }
+
+  *epre_dBfs = srsran_convert_power_to_dB(epre / (float)nof_rb);
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_dmrs_pdcch_get_ce(const srsran_dmrs_pdcch_estimator_t* q,
                              const srsran_dci_location_t*         dci_location,
                              srsran_dmrs_pdcch_ce_t*              ce)
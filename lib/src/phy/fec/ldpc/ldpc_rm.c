@@ -33,6 +33,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "srsran/phy/fec/ldpc/ldpc_common.h" //FILLER_BIT definition
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
@@ -40,6 +41,10 @@
 
 #include "srsran/phy/utils/debug.h"
 
+#ifdef LV_HAVE_SSE
+#include <immintrin.h>
+#endif /* LV_HAVE_SSE */
+
 //#define debug
 /*!
  * \brief Look-up table: k0 indices
@@ -87,24 +92,21 @@ struct pRM_tx {
  * \brief Describes an rate dematcher (float version).
  */
 struct pRM_rx_f {
-  float*    tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  float* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
 };
 
 /*!
  * \brief Describes an rate dematcher (short version).
  */
 struct pRM_rx_s {
-  int16_t*  tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  int16_t* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
 };
 
 /*!
  * \brief Describes an rate dematcher (char version).
  */
 struct pRM_rx_c {
-  int8_t*   tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  int8_t* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
 };
 
 /*!
@@ -192,6 +194,117 @@ static void bit_selection_rm_tx(const uint8_t* input,
   } // while
 }
 
+/*!
+ * Adds soft bits to the circular buffer (float).
+ */
+static void combine_rm_rx(const float* input, float* output, const uint32_t len)
+{
+  srsran_vec_sum_fff(output, input, output, len);
+}
+
+/*!
+ * Adds soft bits to the circular buffer (int16_t). Messages use a 15-bit quantization: sums are saturated to
+ * +/- infinity15, since the remaining bit is used to denote infinity (filler bits).
+ */
+static void combine_rm_rx_s(const int16_t* input, int16_t* output, const uint32_t len)
+{
+  const int16_t infinity15 = (1U << 14U) - 1;
+
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX512
+  const __m512i max512 = _mm512_set1_epi16(infinity15);
+  const __m512i min512 = _mm512_set1_epi16(-infinity15);
+  for (; i + 32 <= len; i += 32) {
+    __m512i sum = _mm512_adds_epi16(_mm512_loadu_si512(output + i), _mm512_loadu_si512(input + i));
+    _mm512_storeu_si512(output + i, _mm512_max_epi16(_mm512_min_epi16(sum, max512), min512));
+  }
+#endif /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  const __m256i max256 = _mm256_set1_epi16(infinity15);
+  const __m256i min256 = _mm256_set1_epi16(-infinity15);
+  for (; i + 16 <= len; i += 16) {
+    __m256i sum =
+        _mm256_adds_epi16(_mm256_loadu_si256((__m256i*)(output + i)), _mm256_loadu_si256((__m256i*)(input + i)));
+    _mm256_storeu_si256((__m256i*)(output + i), _mm256_max_epi16(_mm256_min_epi16(sum, max256), min256));
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < len; i++) {
+    long tmp = (long)output[i] + input[i];
+    if (tmp > infinity15) {
+      tmp = infinity15;
+    }
+    if (tmp < -infinity15) {
+      tmp = -infinity15;
+    }
+    output[i] = (int16_t)tmp;
+  }
+}
+
+/*!
+ * Adds soft bits to the circular buffer (int8_t). Messages use a 7-bit quantization: sums are saturated to
+ * +/- infinity7, since the remaining bit is used to denote infinity (filler bits).
+ */
+static void combine_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t len)
+{
+  const int8_t infinity7 = (1U << 6U) - 1;
+
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX512
+  const __m512i max512 = _mm512_set1_epi8(infinity7);
+  const __m512i min512 = _mm512_set1_epi8(-infinity7);
+  for (; i + 64 <= len; i += 64) {
+    __m512i sum = _mm512_adds_epi8(_mm512_loadu_si512(output + i), _mm512_loadu_si512(input + i));
+    _mm512_storeu_si512(output + i, _mm512_max_epi8(_mm512_min_epi8(sum, max512), min512));
+  }
+#endif /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  const __m256i max256 = _mm256_set1_epi8(infinity7);
+  const __m256i min256 = _mm256_set1_epi8(-infinity7);
+  for (; i + 32 <= len; i += 32) {
+    __m256i sum =
+        _mm256_adds_epi8(_mm256_loadu_si256((__m256i*)(output + i)), _mm256_loadu_si256((__m256i*)(input + i)));
+    _mm256_storeu_si256((__m256i*)(output + i), _mm256_max_epi8(_mm256_min_epi8(sum, max256), min256));
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < len; i++) {
+    long tmp = (long)output[i] + input[i];
+    if (tmp > infinity7) {
+      tmp = infinity7;
+    }
+    if (tmp < -infinity7) {
+      tmp = -infinity7;
+    }
+    output[i] = (int8_t)tmp;
+  }
+}
+
+/*!
+ * Walks the circular buffer from k0 and splits it into runs of consecutive positions that do not wrap around nor
+ * cross the filler bits. The input soft bits are combined with each run in the same order as the rate-matcher reads
+ * them. Declared as a macro to generate the float, int16_t and int8_t versions.
+ */
+#define BIT_SELECTION_RM_RX_RUNS(COMBINE)                                                                              \
+  do {                                                                                                                 \
+    uint32_t k    = 0;                                                                                                 \
+    uint32_t icwd = k0;                                                                                                \
+    while (k < E) {                                                                                                    \
+      if (icwd >= Ncb) {                                                                                               \
+        icwd = 0;                                                                                                      \
+      }                                                                                                                \
+      if (icwd >= ini_exclude && icwd < end_exclude) { /* avoid filler bits */                                         \
+        icwd = end_exclude;                                                                                            \
+        continue;                                                                                                      \
+      }                                                                                                                \
+      uint32_t run_end = (icwd < ini_exclude) ? SRSRAN_MIN(ini_exclude, Ncb) : Ncb;                                   \
+      uint32_t run_len = SRSRAN_MIN(run_end - icwd, E - k);                                                            \
+      COMBINE(&input[k], &output[icwd], run_len);                                                                      \
+      k += run_len;                                                                                                    \
+      icwd += run_len;                                                                                                 \
+    }                                                                                                                  \
+  } while (false)
+
 /*!
  * Undoes bit selection for the rate-dematching block.
  * The output has the codeword length N. It inserts filler bits as INFINITY symbols
@@ -203,7 +316,6 @@ static void bit_selection_rm_tx(const uint8_t* input,
 static void bit_selection_rm_rx(const float*   input,
                                 const uint32_t in_len,
                                 float*         output,
-                                uint32_t*      indices,
                                 const uint32_t ini_exclude,
                                 const uint32_t end_exclude,
                                 const uint32_t k0,
@@ -211,27 +323,13 @@ static void bit_selection_rm_rx(const float*   input,
 {
   uint32_t E = in_len;
 
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
-
   // set filler bits to INFINITY
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
     output[i] = INFINITY;
   }
 
   // Add soft bits, in case of repetition
-  for (uint32_t i = 0; i < E; i++) {
-    output[indices[i]] = output[indices[i]] + input[i];
-  }
+  BIT_SELECTION_RM_RX_RUNS(combine_rm_rx);
 }
 
 /*!
@@ -245,7 +343,6 @@ static void bit_selection_rm_rx(const float*   input,
 static void bit_selection_rm_rx_s(const int16_t* input,
                                   const uint32_t in_len,
                                   int16_t*       output,
-                                  uint32_t*      indices,
                                   const uint32_t ini_exclude,
                                   const uint32_t end_exclude,
                                   const uint32_t k0,
@@ -253,18 +350,6 @@ static void bit_selection_rm_rx_s(const int16_t* input,
 {
   uint32_t E = in_len;
 
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
-
   // set filler bits to INFINITY
   const long infinity16 = (1U << 15U) - 1; // Max positive value in 16-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
@@ -272,20 +357,8 @@ static void bit_selection_rm_rx_s(const int16_t* input,
   }
 
   // Add soft bits, in case of repetition
-  const int16_t infinity15 =
-      (1U << 14U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
   // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity15) {
-      tmp = infinity15;
-    }
-    if (tmp < -infinity15) {
-      tmp = -infinity15;
-    }
-    output[indices[i]] = (int16_t)tmp;
-  }
+  BIT_SELECTION_RM_RX_RUNS(combine_rm_rx_s);
 }
 
 /*!
@@ -299,7 +372,6 @@ static void bit_selection_rm_rx_s(const int16_t* input,
 static void bit_selection_rm_rx_c(const int8_t*  input,
                                   const uint32_t in_len,
                                   int8_t*        output,
-                                  uint32_t*      indices,
                                   const uint32_t ini_exclude,
                                   const uint32_t end_exclude,
                                   const uint32_t k0,
@@ -307,18 +379,6 @@ static void bit_selection_rm_rx_c(const int8_t*  input,
 {
   uint32_t E = in_len;
 
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
-
   // set filler bits to INFINITY
   const long infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
@@ -326,20 +386,7 @@ static void bit_selection_rm_rx_c(const int8_t*  input,
   }
 
   // Add soft bits, in case of repetition
-  const int16_t infinity7 =
-      (1U << 6U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity7) {
-      tmp = infinity7;
-    }
-    if (tmp < -infinity7) {
-      tmp = -infinity7;
-    }
-    output[indices[i]] = (int8_t)tmp;
-  }
+  BIT_SELECTION_RM_RX_RUNS(combine_rm_rx_c);
 }
 
 /*!
@@ -359,18 +406,104 @@ bit_interleaver_rm_tx(const uint8_t* input, uint8_t* output, const uint32_t in_o
   }
 }
 
+#ifdef LV_HAVE_SSE
+
+/*!
+ * Bit deinterleaver for modulation order 6, generic on the size in bytes of the soft bits. Every 96 bytes of input
+ * (6 registers) contain 16 bytes of each of the 6 output rows, which are gathered with byte shuffles.
+ */
+static void bit_interleaver_rm_rx_qm6_sse(const uint8_t* input, uint8_t* output, const uint32_t cols, uint32_t size)
+{
+  const uint32_t rows       = 6;
+  const uint32_t block_cols = 16 / size;
+
+  __m128i shuffle[6][6];
+  for (uint32_t r = 0; r < rows; r++) {
+    for (uint32_t v = 0; v < rows; v++) {
+      uint8_t mask[16];
+      for (uint32_t b = 0; b < 16; b++) {
+        uint32_t idx = size * (rows * (b / size) + r) + b % size;
+        mask[b]      = (idx / 16 == v) ? (uint8_t)(idx % 16) : 0x80;
+      }
+      shuffle[r][v] = _mm_loadu_si128((__m128i*)mask);
+    }
+  }
+
+  uint32_t j = 0;
+  for (; j + block_cols <= cols; j += block_cols) {
+    const __m128i* in_ptr = (const __m128i*)&input[size * rows * j];
+    __m128i        in[6];
+    for (uint32_t v = 0; v < rows; v++) {
+      in[v] = _mm_loadu_si128(in_ptr + v);
+    }
+    for (uint32_t r = 0; r < rows; r++) {
+      __m128i acc = _mm_shuffle_epi8(in[0], shuffle[r][0]);
+      for (uint32_t v = 1; v < rows; v++) {
+        acc = _mm_or_si128(acc, _mm_shuffle_epi8(in[v], shuffle[r][v]));
+      }
+      _mm_storeu_si128((__m128i*)&output[size * (r * cols + j)], acc);
+    }
+  }
+
+  for (; j < cols; j++) {
+    for (uint32_t r = 0; r < rows; r++) {
+      memcpy(&output[size * (r * cols + j)], &input[size * (rows * j + r)], size);
+    }
+  }
+}
+
+#endif /* LV_HAVE_SSE */
+
+/*!
+ * Bit deinterleaver (float). Every row is written sequentially, a constant number of rows lets the compiler vectorize
+ * the strided reads.
+ */
+static inline void
+bit_interleaver_rm_rx_rows(const float* input, float* output, const uint32_t cols, const uint32_t rows)
+{
+  for (uint32_t i = 0; i < rows; i++) {
+    for (uint32_t j = 0; j < cols; j++) {
+      output[i * cols + j] = input[j * rows + i];
+    }
+  }
+}
+
 /*!
  * Bit deinterleaver (float)
  */
 static void
 bit_interleaver_rm_rx(const float* input, float* output, const uint32_t in_out_len, const uint32_t mod_order)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
+  uint32_t cols = in_out_len / mod_order;
+  switch (mod_order) {
+    case 2:
+      bit_interleaver_rm_rx_rows(input, output, cols, 2);
+      break;
+    case 4:
+      bit_interleaver_rm_rx_rows(input, output, cols, 4);
+      break;
+#ifdef LV_HAVE_SSE
+    case 6:
+      bit_interleaver_rm_rx_qm6_sse((const uint8_t*)input, (uint8_t*)output, cols, sizeof(float));
+      break;
+#endif /* LV_HAVE_SSE */
+    case 8:
+      bit_interleaver_rm_rx_rows(input, output, cols, 8);
+      break;
+    default:
+      bit_interleaver_rm_rx_rows(input, output, cols, mod_order);
+  }
+}
+
+/*!
+ * Bit deinterleaver (short). Every row is written sequentially, a constant number of rows lets the compiler vectorize
+ * the strided reads.
+ */
+static inline void
+bit_interleaver_rm_rx_rows_s(const int16_t* input, int16_t* output, const uint32_t cols, const uint32_t rows)
+{
+  for (uint32_t i = 0; i < rows; i++) {
+    for (uint32_t j = 0; j < cols; j++) {
       output[i * cols + j] = input[j * rows + i];
     }
   }
@@ -382,31 +515,65 @@ bit_interleaver_rm_rx(const float* input, float* output, const uint32_t in_out_l
 static void
 bit_interleaver_rm_rx_s(const int16_t* input, int16_t* output, const uint32_t in_out_len, const uint32_t mod_order)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
+  uint32_t cols = in_out_len / mod_order;
+  switch (mod_order) {
+    case 2:
+      bit_interleaver_rm_rx_rows_s(input, output, cols, 2);
+      break;
+    case 4:
+      bit_interleaver_rm_rx_rows_s(input, output, cols, 4);
+      break;
+#ifdef LV_HAVE_SSE
+    case 6:
+      bit_interleaver_rm_rx_qm6_sse((const uint8_t*)input, (uint8_t*)output, cols, sizeof(int16_t));
+      break;
+#endif /* LV_HAVE_SSE */
+    case 8:
+      bit_interleaver_rm_rx_rows_s(input, output, cols, 8);
+      break;
+    default:
+      bit_interleaver_rm_rx_rows_s(input, output, cols, mod_order);
+  }
+}
+
+/*!
+ * Bit deinterleaver (int8_t). Every row is written sequentially, a constant number of rows lets the compiler vectorize
+ * the strided reads.
+ */
+static inline void
+bit_interleaver_rm_rx_rows_c(const int8_t* input, int8_t* output, const uint32_t cols, const uint32_t rows)
+{
+  for (uint32_t i = 0; i < rows; i++) {
+    for (uint32_t j = 0; j < cols; j++) {
       output[i * cols + j] = input[j * rows + i];
     }
   }
 }
 
 /*!
- * Bit deinterleaver (short)
+ * Bit deinterleaver (int8_t)
  */
 static void
 bit_interleaver_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t in_out_len, const uint32_t mod_order)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
-    }
+  uint32_t cols = in_out_len / mod_order;
+  switch (mod_order) {
+    case 2:
+      bit_interleaver_rm_rx_rows_c(input, output, cols, 2);
+      break;
+    case 4:
+      bit_interleaver_rm_rx_rows_c(input, output, cols, 4);
+      break;
+#ifdef LV_HAVE_SSE
+    case 6:
+      bit_interleaver_rm_rx_qm6_sse((const uint8_t*)input, (uint8_t*)output, cols, sizeof(int8_t));
+      break;
+#endif /* LV_HAVE_SSE */
+    case 8:
+      bit_interleaver_rm_rx_rows_c(input, output, cols, 8);
+      break;
+    default:
+      bit_interleaver_rm_rx_rows_c(input, output, cols, mod_order);
   }
 }
 
@@ -453,11 +620,6 @@ int srsran_ldpc_rm_rx_init_f(srsran_ldpc_rm_t* p)
     return -1;
   }
 
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
-    free(pp);
-    return -1;
-  }
   return 0;
 }
 
@@ -481,12 +643,6 @@ int srsran_ldpc_rm_rx_init_s(srsran_ldpc_rm_t* p)
     return -1;
   }
 
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
-    free(pp);
-    return -1;
-  }
-
   return 0;
 }
 int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
@@ -509,12 +665,6 @@ int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
     return -1;
   }
 
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
-    free(pp);
-    return -1;
-  }
-
   return 0;
 }
 
@@ -539,9 +689,6 @@ void srsran_ldpc_rm_rx_free_f(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -555,9 +702,6 @@ void srsran_ldpc_rm_rx_free_s(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -571,9 +715,6 @@ void srsran_ldpc_rm_rx_free_c(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -627,15 +768,14 @@ int srsran_ldpc_rm_rx_f(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_f* pp            = q->ptr;
   float*           tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
   if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx(input, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   } else {
     bit_interleaver_rm_rx(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx(tmp_rm_symbol, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   }
   return 0;
 }
@@ -658,15 +798,14 @@ int srsran_ldpc_rm_rx_s(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_f* pp            = q->ptr;
   int16_t*         tmp_rm_symbol = (int16_t*)pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
   if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_s(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_s(input, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   } else {
     bit_interleaver_rm_rx_s(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_s(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_s(tmp_rm_symbol, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   }
 
   return 0;
@@ -690,15 +829,14 @@ int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_c* pp            = q->ptr;
   int8_t*          tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
   if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_c(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_c(input, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   } else {
     bit_interleaver_rm_rx_c(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   }
 
   // Return the number of useful LLR
@@ -27,6 +27,7 @@
  * and, finally, rate-dematched and decoded by all three types of
  * rate dematchers (float, int16_t, int8_t).
  * The rate-dematched codeword is compared against the transmitted codeword
+ * and the rate-dematching throughput of each implementation is reported.
  *
  * Synopsis: **ldpc_rm_test [options]**
  *
@@ -135,6 +136,11 @@ int main(int argc, char** argv)
   uint32_t r     = 0;
   int      error = 0;
 
+  struct timeval t[3];
+  double         elapsed_us_f = 0;
+  double         elapsed_us_s = 0;
+  double         elapsed_us_c = 0;
+
   parse_args(argc, argv);
 
   srsran_random_t random_gen = srsran_random_init(0);
@@ -256,19 +262,33 @@ int main(int argc, char** argv)
     bzero(unrm_symbols_s + r * N, N * sizeof(int16_t));
     bzero(unrm_symbols_c + r * N, N * sizeof(int8_t));
 
+    gettimeofday(&t[1], NULL);
     if (srsran_ldpc_rm_rx_f(
             &rm_rx, rm_symbols + r * E, unrm_symbols + r * N, E, F, base_graph, lift_size, rv, mod_type, Nref)) {
       exit(-1);
     }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_us_f += t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+    gettimeofday(&t[1], NULL);
     if (srsran_ldpc_rm_rx_s(
             &rm_rx_s, rm_symbols_s + r * E, unrm_symbols_s + r * N, E, F, base_graph, lift_size, rv, mod_type, Nref)) {
       exit(-1);
     }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_us_s += t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+    gettimeofday(&t[1], NULL);
     if (srsran_ldpc_rm_rx_c(
             &rm_rx_c, rm_symbols_c + r * E, unrm_symbols_c + r * N, E, F, base_graph, lift_size, rv, mod_type, Nref) <
         0) {
       exit(-1);
     }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_us_c += t[0].tv_sec * 1e6 + t[0].tv_usec;
 
     // Check self correctness for the float version
     error = 0;
@@ -338,6 +358,11 @@ int main(int argc, char** argv)
 
   } // codeblocks r
 
+  printf("\nRate-dematching throughput (%s, E = %d):\n", srsran_mod_string(mod_type), E);
+  printf("  float   -> %.2f Mbps\n", (double)C * E / elapsed_us_f);
+  printf("  int16_t -> %.2f Mbps\n", (double)C * E / elapsed_us_s);
+  printf("  int8_t  -> %.2f Mbps\n", (double)C * E / elapsed_us_c);
+
   free(unrm_symbols);
   free(unrm_symbols_s);
   free(unrm_symbols_c);
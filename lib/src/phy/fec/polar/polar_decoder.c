@@ -39,6 +39,7 @@
 
 #include "polar_decoder_ssc_c.h"
 #include "polar_decoder_ssc_c_avx2.h"
+#include "polar_decoder_ssc_c_batch_avx2.h"
 #include "polar_decoder_ssc_f.h"
 #include "polar_decoder_ssc_s.h"
 #include "srsran/phy/fec/polar/polar_decoder.h"
@@ -112,6 +113,35 @@ static int decode_ssc_c_avx2(void*           o,
 
   return 0;
 }
+
+/*! SSC Polar decoder AVX2 with int8_t LLR inputs of several codewords at once. */
+static int decode_batch_ssc_c_batch_avx2(void*           o,
+                                         const int8_t**  symbols,
+                                         uint8_t**       data,
+                                         const uint32_t  nof_codewords,
+                                         const uint8_t   n,
+                                         const uint16_t* frozen_set,
+                                         const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (init_polar_decoder_ssc_c_batch_avx2(q->ptr, symbols, nof_codewords, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  return polar_decoder_ssc_c_batch_avx2(q->ptr, data);
+}
+
+/*! SSC Polar decoder AVX2 with int8_t LLR inputs, as a batch of one codeword. */
+static int decode_ssc_c_batch_avx2(void*           o,
+                                   const int8_t*   symbols,
+                                   uint8_t*        data,
+                                   const uint8_t   n,
+                                   const uint16_t* frozen_set,
+                                   const uint16_t  frozen_set_size)
+{
+  return decode_batch_ssc_c_batch_avx2(o, &symbols, &data, 1, n, frozen_set, frozen_set_size);
+}
 #endif // LV_HAVE_AVX2
 
 /*! Destructor of a (float) SSC polar decoder. */
@@ -142,6 +172,13 @@ static void free_ssc_c_avx2(void* o)
   srsran_polar_decoder_t* q = o;
   delete_polar_decoder_ssc_c_avx2(q->ptr);
 }
+
+/*! Destructor of a (int8_t, avx2, batch) SSC polar decoder. */
+static void free_ssc_c_batch_avx2(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_ssc_c_batch_avx2(q->ptr);
+}
 #endif
 
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
@@ -201,6 +238,22 @@ static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
   }
   return 0;
 }
+
+/*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with uint8_t LLR inputs and AVX2
+ * instructions, decoding several codewords at once. */
+static int init_ssc_c_batch_avx2(srsran_polar_decoder_t* q)
+{
+  q->decode_c       = decode_ssc_c_batch_avx2;
+  q->decode_batch_c = decode_batch_ssc_c_batch_avx2;
+  q->free           = free_ssc_c_batch_avx2;
+
+  if ((q->ptr = create_polar_decoder_ssc_c_batch_avx2(q->nMax)) == NULL) {
+    ERROR("create_polar_decoder_ssc_c_batch_avx2 failed");
+    free_ssc_c_batch_avx2(q);
+    return -1;
+  }
+  return 0;
+}
 #endif
 
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
@@ -216,6 +269,8 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
 #ifdef LV_HAVE_AVX2
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
+    case SRSRAN_POLAR_DECODER_SSC_C_BATCH_AVX2:
+      return init_ssc_c_batch_avx2(q);
 #endif
     default:
       ERROR("Decoder not implemented");
@@ -273,3 +328,27 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_batch_c(srsran_polar_decoder_t* q,
+                                        const int8_t**          llr,
+                                        uint8_t**               data_decoded,
+                                        const uint32_t          nof_codewords,
+                                        const uint8_t           n,
+                                        const uint16_t*         frozen_set,
+                                        const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n) {
+    return -1;
+  }
+
+  if (q->decode_batch_c != NULL && nof_codewords <= SRSRAN_POLAR_DECODER_MAX_BATCH) {
+    return q->decode_batch_c(q, llr, data_decoded, nof_codewords, n, frozen_set, frozen_set_size);
+  }
+
+  for (uint32_t i = 0; i < nof_codewords; i++) {
+    if (q->decode_c(q, llr[i], data_decoded[i], n, frozen_set, frozen_set_size) < 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,331 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_batch_avx2.c
+ * \brief Definition of the SSC polar decoder inner functions working with
+ * 8-bit integer-valued LLRs and AVX2 instructions, decoding several codewords of the same code at once.
+ *
+ * All the codewords share the decoding tree, as it only depends on the frozen set. The LLRs and the estimated bits of
+ * the codewords are interleaved, so that the element \f$i\f$ of the codeword \f$c\f$ is stored at \f$i B + c\f$,
+ * with \f$B\f$ the number of codewords. Every node of the tree then processes \f$B\f$ times more contiguous
+ * elements, which fills the AVX2 registers in the lower stages of the tree, where the single codeword decoder
+ * leaves most of the register unused.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include "polar_decoder_ssc_c_batch_avx2.h"
+#include "../utils_avx2.h"
+#include "polar_decoder_vector_avx2.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/utils/vector.h"
+
+#ifdef LV_HAVE_AVX2
+
+/*!
+ * \brief Describes the state of a batch AVX2 SSC polar decoder
+ */
+struct StateBatchAVX2 {
+  uint8_t  stage;   /*!< \brief Current stage [0 - code_size_log] of the decoding algorithm. */
+  uint16_t bit_pos; /*!< \brief position of the next bit to be estimated in each codeword. */
+};
+
+/*!
+ * \brief Describes a batch SSC polar decoder (8-bit version).
+ */
+struct pSSC_c_batch_avx2 {
+  int8_t*                 llr_buffer;         /*!< \brief LLRs values at all stages. */
+  int8_t*                 llr0[NMAX_LOG + 1]; /*!< \brief Pointers to the upper half of LLRs values at all stages. */
+  int8_t*                 llr1[NMAX_LOG + 1]; /*!< \brief Pointers to the lower half of LLRs values at all stages. */
+  uint8_t*                est_bit;            /*!< \brief Pointer to the interleaved estimated bits. */
+  uint8_t*                codeword;           /*!< \brief Pointer to the estimated bits of a single codeword. */
+  uint32_t                nof_codewords;      /*!< \brief Number of codewords of the current batch. */
+  struct Params*          param;              /*!< \brief Pointer to a Params structure. */
+  struct StateBatchAVX2   state;              /*!< \brief State of the decoding tree. */
+  void*                   tmp_node_type;      /*!< \brief Pointer to a Tmp_node_type. */
+  srsran_polar_encoder_t* enc;                /*!< \brief Pointer to a srsran_polar_encoder_t. */
+};
+
+/*!
+ * Rounds up to a multiple of the AVX2 register size, so that the stores of the vectorized functions fit in the stage
+ * buffers whatever the number of codewords.
+ */
+static uint32_t ceil_avx2(uint32_t len)
+{
+  return ((len + SRSRAN_AVX2_B_SIZE - 1) / SRSRAN_AVX2_B_SIZE) * SRSRAN_AVX2_B_SIZE;
+}
+
+/*!
+ * Same as simplified_node() of the single codeword decoder, with all the vector lengths and bit positions scaled by
+ * the number of codewords.
+ */
+static void simplified_node(struct pSSC_c_batch_avx2* p);
+
+void delete_polar_decoder_ssc_c_batch_avx2(void* p)
+{
+  struct pSSC_c_batch_avx2* pp = p;
+
+  if (p != NULL) {
+    if (pp->llr_buffer) {
+      free(pp->llr_buffer);
+    }
+    if (pp->param) {
+      if (pp->param->node_type) {
+        if (pp->param->node_type[0]) {
+          free(pp->param->node_type[0]);
+        }
+        free(pp->param->node_type);
+      }
+      if (pp->param->code_stage_size) {
+        free(pp->param->code_stage_size);
+      }
+      free(pp->param);
+    }
+    if (pp->est_bit) {
+      free(pp->est_bit);
+    }
+    if (pp->codeword) {
+      free(pp->codeword);
+    }
+    if (pp->enc) {
+      srsran_polar_encoder_free(pp->enc);
+      free(pp->enc);
+    }
+    if (pp->tmp_node_type) {
+      delete_tmp_node_type(pp->tmp_node_type);
+    }
+    free(pp);
+  }
+}
+
+void* create_polar_decoder_ssc_c_batch_avx2(const uint8_t nMax)
+{
+  struct pSSC_c_batch_avx2* pp = SRSRAN_MEM_ALLOC(struct pSSC_c_batch_avx2, 1);
+  if (pp == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp, struct pSSC_c_batch_avx2, 1);
+
+  // encoder of maximum size
+  if ((pp->enc = SRSRAN_MEM_ALLOC(srsran_polar_encoder_t, 1)) == NULL) {
+    delete_polar_decoder_ssc_c_batch_avx2(pp);
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp->enc, srsran_polar_encoder_t, 1);
+  if (srsran_polar_encoder_init(pp->enc, SRSRAN_POLAR_ENCODER_AVX2, nMax) < 0) {
+    delete_polar_decoder_ssc_c_batch_avx2(pp);
+    return NULL;
+  }
+
+  // algorithm constants/parameters
+  if ((pp->param = SRSRAN_MEM_ALLOC(struct Params, 1)) == NULL) {
+    delete_polar_decoder_ssc_c_batch_avx2(pp);
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp->param, struct Params, 1);
+
+  if ((pp->param->code_stage_size = srsran_vec_u16_malloc(nMax + 1)) == NULL) {
+    delete_polar_decoder_ssc_c_batch_avx2(pp);
+    return NULL;
+  }
+  pp->param->code_stage_size[0] = 1;
+  for (uint8_t i = 1; i < nMax + 1; i++) {
+    pp->param->code_stage_size[i] = 2 * pp->param->code_stage_size[i - 1];
+  }
+
+  // Estimated bits of all the codewords, with extra SRSRAN_AVX2_B_SIZE bytes for the output of 256-bit instructions
+  uint32_t code_size_max = pp->param->code_stage_size[nMax];
+  pp->est_bit            = srsran_vec_u8_malloc(code_size_max * SRSRAN_POLAR_DECODER_MAX_BATCH + SRSRAN_AVX2_B_SIZE);
+  pp->codeword           = srsran_vec_u8_malloc(code_size_max + SRSRAN_AVX2_B_SIZE);
+
+  // Every stage buffer is a multiple of SRSRAN_AVX2_B_SIZE for the largest batch, which fits the smaller ones too.
+  // The extra SRSRAN_AVX2_B_SIZE bytes at the end keep the loads of the last stage in allocated memory
+  uint32_t llr_all_stages = SRSRAN_AVX2_B_SIZE;
+  for (uint8_t s = 0; s < nMax + 1; s++) {
+    llr_all_stages += ceil_avx2(pp->param->code_stage_size[s] * SRSRAN_POLAR_DECODER_MAX_BATCH);
+  }
+  pp->llr_buffer = srsran_vec_i8_malloc(llr_all_stages);
+
+  if (pp->est_bit == NULL || pp->codeword == NULL || pp->llr_buffer == NULL) {
+    delete_polar_decoder_ssc_c_batch_avx2(pp);
+    return NULL;
+  }
+
+  // allocate memory for node type pointers, one per stage. Stage s has 2^(N-s) nodes s=0,...,N.
+  pp->param->node_type = SRSRAN_MEM_ALLOC(uint8_t*, nMax + 1);
+  if (pp->param->node_type == NULL) {
+    delete_polar_decoder_ssc_c_batch_avx2(pp);
+    return NULL;
+  }
+  pp->param->node_type[0] = srsran_vec_u8_malloc(1U << (nMax + 1));
+  if (pp->param->node_type[0] == NULL) {
+    delete_polar_decoder_ssc_c_batch_avx2(pp);
+    return NULL;
+  }
+  for (uint8_t s = 1; s < nMax + 1; s++) {
+    pp->param->node_type[s] = pp->param->node_type[s - 1] + pp->param->code_stage_size[nMax - s + 1];
+  }
+
+  // memory allocation to compute node_type
+  pp->tmp_node_type = create_tmp_node_type(nMax);
+  if (pp->tmp_node_type == NULL) {
+    delete_polar_decoder_ssc_c_batch_avx2(pp);
+    return NULL;
+  }
+
+  return pp;
+}
+
+int init_polar_decoder_ssc_c_batch_avx2(void*           p,
+                                        const int8_t**  input_llr,
+                                        const uint32_t  nof_codewords,
+                                        const uint8_t   code_size_log,
+                                        const uint16_t* frozen_set,
+                                        const uint16_t  frozen_set_size)
+{
+  struct pSSC_c_batch_avx2* pp = p;
+
+  if (p == NULL || input_llr == NULL || nof_codewords == 0 || nof_codewords > SRSRAN_POLAR_DECODER_MAX_BATCH) {
+    return -1;
+  }
+
+  pp->param->code_size_log = code_size_log;
+  pp->nof_codewords        = nof_codewords;
+  uint32_t code_size       = pp->param->code_stage_size[code_size_log];
+
+  // Lay out the stage buffers for the number of codewords
+  pp->llr0[0] = pp->llr_buffer;
+  pp->llr1[0] = pp->llr0[0] + nof_codewords;
+  for (uint8_t s = 1; s < code_size_log + 1; s++) {
+    pp->llr0[s] = pp->llr0[s - 1] + ceil_avx2(pp->param->code_stage_size[s - 1] * nof_codewords);
+    pp->llr1[s] = pp->llr0[s] + pp->param->code_stage_size[s - 1] * nof_codewords;
+  }
+
+  // Initialize est_bit vector to all zeros
+  memset(pp->est_bit, 0, code_size * nof_codewords + SRSRAN_AVX2_B_SIZE);
+
+  // Initializes LLR buffer for the last stage/level with the interleaved input LLRs values
+  int8_t* llr = pp->llr0[code_size_log];
+  for (uint32_t c = 0; c < nof_codewords; c++) {
+    for (uint32_t i = 0; i < code_size; i++) {
+      llr[i * nof_codewords + c] = input_llr[c][i];
+    }
+  }
+
+  // Initializes the state of the decoding tree
+  pp->state.stage   = code_size_log + 1; // start from the only one node at the last stage + 1.
+  pp->state.bit_pos = 0;
+
+  // frozen_set
+  pp->param->frozen_set_size = frozen_set_size;
+
+  // computes the node types for the decoding tree
+  compute_node_type(pp->tmp_node_type, pp->param->node_type, frozen_set, code_size_log, frozen_set_size);
+
+  return 0;
+}
+
+int polar_decoder_ssc_c_batch_avx2(void* p, uint8_t** data_decoded)
+{
+  if (p == NULL || data_decoded == NULL) {
+    return -1;
+  }
+
+  struct pSSC_c_batch_avx2* pp = p;
+
+  simplified_node(pp);
+
+  // est_bit contains the interleaved coded bits. To obtain the messages, we call the encoder for every codeword
+  uint32_t code_size = pp->param->code_stage_size[pp->param->code_size_log];
+  uint32_t B         = pp->nof_codewords;
+  for (uint32_t c = 0; c < B; c++) {
+    for (uint32_t i = 0; i < code_size; i++) {
+      pp->codeword[i] = pp->est_bit[i * B + c];
+    }
+    srsran_polar_encoder_encode(pp->enc, pp->codeword, data_decoded[c], pp->param->code_size_log);
+
+    // transform {0,-128} into {0, 1}
+    srsran_vec_sign_to_bit_c_avx2(data_decoded[c], code_size);
+  }
+  return 0;
+}
+
+static void simplified_node(struct pSSC_c_batch_avx2* p)
+{
+  struct pSSC_c_batch_avx2* pp = p;
+
+  pp->state.stage--; // to child node.
+
+  uint8_t  stage    = pp->state.stage;
+  uint16_t bit_pos  = pp->state.bit_pos >> stage;
+  uint32_t B        = pp->nof_codewords;
+  uint8_t* estbits0 = NULL;
+  uint8_t* estbits1 = NULL;
+
+  uint16_t stage_size      = pp->param->code_stage_size[stage];
+  uint16_t stage_half_size = 0;
+
+  switch (pp->param->node_type[stage][bit_pos]) {
+    case RATE_1:
+      srsran_vec_hard_bit_cc_avx2(pp->llr0[stage], pp->est_bit + pp->state.bit_pos * B, stage_size * B);
+
+      pp->state.bit_pos = pp->state.bit_pos + stage_size;
+      break;
+
+    case RATE_0:
+      pp->state.bit_pos = pp->state.bit_pos + stage_size;
+      break;
+
+    case RATE_R:
+
+      stage_half_size = pp->param->code_stage_size[stage - 1];
+      srsran_vec_function_f_ccc_avx2(pp->llr0[stage], pp->llr1[stage], pp->llr0[stage - 1], stage_half_size * B);
+
+      // move to the child node to the left (up) of the tree.
+      simplified_node(pp);
+
+      estbits0 = pp->est_bit + (pp->state.bit_pos - stage_half_size) * B;
+      srsran_vec_function_g_bccc_avx2(
+          estbits0, pp->llr0[stage], pp->llr1[stage], pp->llr0[stage - 1], stage_half_size * B);
+
+      // move to the child node to the right (down) of the tree.
+      simplified_node(pp);
+
+      estbits0 = pp->est_bit + (pp->state.bit_pos - stage_size) * B;
+      estbits1 = estbits0 + stage_half_size * B;
+      srsran_vec_xor_bbb_avx2(estbits0, estbits1, estbits0, stage_half_size * B);
+
+      break;
+
+    default:
+      printf("ERROR: wrong node type %d\n", pp->param->node_type[stage][bit_pos]);
+      exit(-1);
+      break;
+  }
+
+  pp->state.stage++; // to parent node.
+}
+
+#endif // LV_HAVE_AVX2
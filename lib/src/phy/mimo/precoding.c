@@ -58,6 +58,17 @@ int srsran_predecoding_single_avx(cf_t* y[SRSRAN_MAX_PORTS],
                                   float scaling,
                                   float noise_estimate);
 #endif
+
+#ifdef LV_HAVE_AVX512
+#include <immintrin.h>
+int srsran_predecoding_single_avx512(cf_t* y[SRSRAN_MAX_PORTS],
+                                     cf_t* h[SRSRAN_MAX_PORTS],
+                                     cf_t* x,
+                                     int   nof_rxant,
+                                     int   nof_symbols,
+                                     float scaling,
+                                     float noise_estimate);
+#endif
 #include "srsran/phy/utils/mat.h"
 
 static srsran_mimo_decoder_t mimo_decoder = SRSRAN_MIMO_DECODER_MMSE;
@@ -284,6 +295,56 @@ int srsran_predecoding_single_avx(cf_t* y[SRSRAN_MAX_PORTS],
 
 #endif
 
+#ifdef LV_HAVE_AVX512
+
+int srsran_predecoding_single_avx512(cf_t* y[SRSRAN_MAX_PORTS],
+                                     cf_t* h[SRSRAN_MAX_PORTS],
+                                     cf_t* x,
+                                     int   nof_rxant,
+                                     int   nof_symbols,
+                                     float scaling,
+                                     float noise_estimate)
+{
+  int    i       = 0;
+  __m512 noise   = _mm512_set1_ps(noise_estimate);
+  __m512 norm    = _mm512_set1_ps(1.0f / scaling);
+  float* x_float = (float*)x;
+
+  for (; i < nof_symbols - 7; i += 8) {
+    __m512 r  = _mm512_setzero_ps();
+    __m512 hh = _mm512_setzero_ps();
+
+    for (int p = 0; p < nof_rxant; p++) {
+      __m512 yVal = _mm512_loadu_ps((float*)&y[p][i]);
+      __m512 hVal = _mm512_loadu_ps((float*)&h[p][i]);
+
+      /* y * conj(h): even lanes yr*hr + yi*hi, odd lanes yi*hr - yr*hi */
+      __m512 t = _mm512_mul_ps(_mm512_permute_ps(yVal, 0xB1), _mm512_movehdup_ps(hVal));
+      r        = _mm512_add_ps(r, _mm512_fmsubadd_ps(yVal, _mm512_moveldup_ps(hVal), t));
+
+      /* |h|^2 replicated in both real and imaginary lanes */
+      __m512 h2 = _mm512_mul_ps(hVal, hVal);
+      hh        = _mm512_add_ps(hh, _mm512_add_ps(h2, _mm512_permute_ps(h2, 0xB1)));
+    }
+
+    __m512 xVal = _mm512_div_ps(_mm512_mul_ps(r, norm), _mm512_add_ps(hh, noise));
+    _mm512_storeu_ps(&x_float[2 * i], xVal);
+  }
+
+  for (; i < nof_symbols; i++) {
+    cf_t r  = 0;
+    cf_t hh = 0;
+    for (int p = 0; p < nof_rxant; p++) {
+      r += y[p][i] * conjf(h[p][i]);
+      hh += conjf(h[p][i]) * h[p][i];
+    }
+    x[i] = r / ((hh + noise_estimate) * scaling);
+  }
+  return nof_symbols;
+}
+
+#endif /* LV_HAVE_AVX512 */
+
 int srsran_predecoding_single_gen(cf_t* y[SRSRAN_MAX_PORTS],
                                   cf_t* h[SRSRAN_MAX_PORTS],
                                   cf_t* x,
@@ -372,6 +433,13 @@ int srsran_predecoding_single(cf_t*  y_,
     return srsran_predecoding_single_csi(y, h, x, csi, nof_rxant, nof_symbols, scaling, noise_estimate);
   }
 
+#ifdef LV_HAVE_AVX512
+  if (nof_symbols > 32) {
+    return srsran_predecoding_single_avx512(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
+  } else {
+    return srsran_predecoding_single_gen(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
+  }
+#else
 #ifdef LV_HAVE_AVX
   if (nof_symbols > 32 && nof_rxant <= 2) {
     return srsran_predecoding_single_avx(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
@@ -389,6 +457,7 @@ int srsran_predecoding_single(cf_t*  y_,
   return srsran_predecoding_single_gen(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
 #endif
 #endif
+#endif /* LV_HAVE_AVX512 */
 }
 
 /* ZF/MMSE SISO equalizer x=y(h'h+no)^(-1)h' (ZF if n0=0.0)*/
@@ -405,15 +474,22 @@ int srsran_predecoding_single_multi(cf_t*  y[SRSRAN_MAX_PORTS],
     return srsran_predecoding_single_csi(y, h, x, csi[0], nof_rxant, nof_symbols, scaling, noise_estimate);
   }
 
-#ifdef LV_HAVE_AVX
+#ifdef LV_HAVE_AVX512
   if (nof_symbols > 32) {
+    return srsran_predecoding_single_avx512(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
+  } else {
+    return srsran_predecoding_single_gen(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
+  }
+#else
+#ifdef LV_HAVE_AVX
+  if (nof_symbols > 32 && nof_rxant <= 2) {
     return srsran_predecoding_single_avx(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
   } else {
     return srsran_predecoding_single_gen(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
   }
 #else
 #ifdef LV_HAVE_SSE
-  if (nof_symbols > 32) {
+  if (nof_symbols > 32 && nof_rxant <= 2) {
     return srsran_predecoding_single_sse(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
   } else {
     return srsran_predecoding_single_gen(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
@@ -422,6 +498,7 @@ int srsran_predecoding_single_multi(cf_t*  y[SRSRAN_MAX_PORTS],
   return srsran_predecoding_single_gen(y, h, x, nof_rxant, nof_symbols, scaling, noise_estimate);
 #endif
 #endif
+#endif /* LV_HAVE_AVX512 */
 }
 
 /* C implementatino of the SFBC equalizer */
@@ -1991,6 +2068,46 @@ int srsran_precoding_diversity(cf_t* x[SRSRAN_MAX_LAYERS],
   }
 }
 
+#ifdef LV_HAVE_AVX512
+
+int srsran_precoding_cdd_2x2_avx512(cf_t* x[SRSRAN_MAX_LAYERS],
+                                    cf_t* y[SRSRAN_MAX_PORTS],
+                                    int   nof_symbols,
+                                    float scaling)
+{
+  int    i        = 0;
+  __m512 norm_avx = _mm512_set1_ps(0.5f * scaling);
+
+  // Negate odd symbols of the first layer and even symbols of the second layer
+  __m512 sign0 = _mm512_maskz_mov_ps(0xCCCC, _mm512_set1_ps(-0.0f));
+  __m512 sign1 = _mm512_maskz_mov_ps(0x3333, _mm512_set1_ps(-0.0f));
+
+  for (; i < nof_symbols - 7; i += 8) {
+    __m512 x0 = _mm512_loadu_ps((float*)&x[0][i]);
+    __m512 x1 = _mm512_loadu_ps((float*)&x[1][i]);
+
+    __m512 y0 = _mm512_mul_ps(norm_avx, _mm512_add_ps(x0, x1));
+
+    x0 = _mm512_xor_ps(x0, sign0);
+    x1 = _mm512_xor_ps(x1, sign1);
+
+    __m512 y1 = _mm512_mul_ps(norm_avx, _mm512_add_ps(x0, x1));
+
+    _mm512_storeu_ps((float*)&y[0][i], y0);
+    _mm512_storeu_ps((float*)&y[1][i], y1);
+  }
+
+  scaling /= 2.0f;
+  for (; i < nof_symbols; i++) {
+    y[0][i] = (x[0][i] + x[1][i]) * scaling;
+    y[1][i] = ((i % 2) ? (-x[0][i] + x[1][i]) : (x[0][i] - x[1][i])) * scaling;
+  }
+
+  return 2 * nof_symbols;
+}
+
+#endif /* LV_HAVE_AVX512 */
+
 #ifdef LV_HAVE_AVX
 
 int srsran_precoding_cdd_2x2_avx(cf_t* x[SRSRAN_MAX_LAYERS], cf_t* y[SRSRAN_MAX_PORTS], int nof_symbols, float scaling)
@@ -2066,6 +2183,9 @@ int srsran_precoding_cdd(cf_t* x[SRSRAN_MAX_LAYERS],
       ERROR("Invalid number of layers %d for 2 ports", nof_layers);
       return -1;
     }
+#ifdef LV_HAVE_AVX512
+    return srsran_precoding_cdd_2x2_avx512(x, y, nof_symbols, scaling);
+#else
 #ifdef LV_HAVE_AVX
     return srsran_precoding_cdd_2x2_avx(x, y, nof_symbols, scaling);
 #else
@@ -2075,6 +2195,7 @@ int srsran_precoding_cdd(cf_t* x[SRSRAN_MAX_LAYERS],
     return srsran_precoding_cdd_2x2_gen(x, y, nof_symbols, scaling);
 #endif /* LV_HAVE_SSE */
 #endif /* LV_HAVE_AVX */
+#endif /* LV_HAVE_AVX512 */
   } else if (nof_ports == 4) {
     ERROR("Not implemented");
     return -1;
@@ -76,6 +76,10 @@
 void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #endif
 
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
 #define SCALE_SHORT_CONV_QPSK 100
 #define SCALE_SHORT_CONV_QAM16 400
 #define SCALE_SHORT_CONV_QAM64 700
@@ -86,17 +90,31 @@ void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #define SCALE_BYTE_CONV_QAM64 40
 #define SCALE_BYTE_CONV_QAM256 50
 
+/* Number of symbols demodulated in floating point before converting the LLRs to fixed point */
+#define DEMOD_SOFT_BLOCK_NSYMBOLS 32
+
+/* Saturating conversions for the scalar implementations, they behave as the saturating packs of the SIMD ones */
+static inline int16_t demod_soft_sat_s(float x)
+{
+  return (int16_t)SRSRAN_MAX(INT16_MIN, SRSRAN_MIN(INT16_MAX, x));
+}
+
+static inline int8_t demod_soft_sat_b(float x)
+{
+  return (int8_t)SRSRAN_MAX(INT8_MIN, SRSRAN_MIN(INT8_MAX, x));
+}
+
 void demod_bpsk_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
-    llr[i] = (int8_t)(-SCALE_BYTE_CONV_QPSK * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2);
+    llr[i] = demod_soft_sat_b(-SCALE_BYTE_CONV_QPSK * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2);
   }
 }
 
 void demod_bpsk_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
-    llr[i] = (short)(-SCALE_SHORT_CONV_QPSK * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2);
+    llr[i] = demod_soft_sat_s(-SCALE_SHORT_CONV_QPSK * (crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2);
   }
 }
 
@@ -135,6 +153,38 @@ void demod_16qam_lte(const cf_t* symbols, float* llr, int nsymbols)
   }
 }
 
+/*
+ * Scalar fixed point 16QAM demodulators, also used for the last symbols of the SIMD ones. The symbols are rounded and
+ * saturated and the threshold truncated as the SIMD implementations do, so that all of them give the same LLRs.
+ */
+static void demod_16qam_lte_s_scalar(const cf_t* symbols, short* llr, int nsymbols)
+{
+  const short threshold = 2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10);
+  for (int i = 0; i < nsymbols; i++) {
+    short yre = demod_soft_sat_s(rintf(-SCALE_SHORT_CONV_QAM16 * crealf(symbols[i])));
+    short yim = demod_soft_sat_s(rintf(-SCALE_SHORT_CONV_QAM16 * cimagf(symbols[i])));
+
+    llr[4 * i + 0] = yre;
+    llr[4 * i + 1] = yim;
+    llr[4 * i + 2] = abs(yre) - threshold;
+    llr[4 * i + 3] = abs(yim) - threshold;
+  }
+}
+
+static void demod_16qam_lte_b_scalar(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const int8_t threshold = 2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10);
+  for (int i = 0; i < nsymbols; i++) {
+    int8_t yre = demod_soft_sat_b(rintf(-SCALE_BYTE_CONV_QAM16 * crealf(symbols[i])));
+    int8_t yim = demod_soft_sat_b(rintf(-SCALE_BYTE_CONV_QAM16 * cimagf(symbols[i])));
+
+    llr[4 * i + 0] = yre;
+    llr[4 * i + 1] = yim;
+    llr[4 * i + 2] = abs(yre) - threshold;
+    llr[4 * i + 3] = abs(yim) - threshold;
+  }
+}
+
 #ifdef HAVE_NEONv8
 
 void demod_16qam_lte_s_neon(const cf_t* symbols, short* llr, int nsymbols)
@@ -175,15 +225,8 @@ void demod_16qam_lte_s_neon(const cf_t* symbols, short* llr, int nsymbols)
     resultPtr++;
   }
   // Demodulate last symbols
-  for (int i = 4 * (nsymbols / 4); i < nsymbols; i++) {
-    short yre = (short)(SCALE_SHORT_CONV_QAM16 * crealf(symbols[i]));
-    short yim = (short)(SCALE_SHORT_CONV_QAM16 * cimagf(symbols[i]));
-
-    llr[4 * i + 0] = -yre;
-    llr[4 * i + 1] = -yim;
-    llr[4 * i + 2] = abs(yre) - 2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10);
-    llr[4 * i + 3] = abs(yim) - 2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10);
-  }
+  int i = 4 * (nsymbols / 4);
+  demod_16qam_lte_s_scalar(&symbols[i], &llr[4 * i], nsymbols - i);
 }
 
 void demod_16qam_lte_b_neon(const cf_t* symbols, int8_t* llr, int nsymbols)
@@ -232,15 +275,8 @@ void demod_16qam_lte_b_neon(const cf_t* symbols, int8_t* llr, int nsymbols)
     resultPtr++;
   }
   // Demodulate last symbols
-  for (int i = 8 * (nsymbols / 8); i < nsymbols; i++) {
-    short yre = (int8_t)(SCALE_BYTE_CONV_QAM16 * crealf(symbols[i]));
-    short yim = (int8_t)(SCALE_BYTE_CONV_QAM16 * cimagf(symbols[i]));
-
-    llr[4 * i + 0] = -yre;
-    llr[4 * i + 1] = -yim;
-    llr[4 * i + 2] = abs(yre) - 2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10);
-    llr[4 * i + 3] = abs(yim) - 2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10);
-  }
+  int i = 8 * (nsymbols / 8);
+  demod_16qam_lte_b_scalar(&symbols[i], &llr[4 * i], nsymbols - i);
 }
 
 #endif
@@ -287,15 +323,8 @@ void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols)
     resultPtr++;
   }
   // Demodulate last symbols
-  for (int i = 4 * (nsymbols / 4); i < nsymbols; i++) {
-    short yre = (short)(SCALE_SHORT_CONV_QAM16 * crealf(symbols[i]));
-    short yim = (short)(SCALE_SHORT_CONV_QAM16 * cimagf(symbols[i]));
-
-    llr[4 * i + 0] = -yre;
-    llr[4 * i + 1] = -yim;
-    llr[4 * i + 2] = abs(yre) - 2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10);
-    llr[4 * i + 3] = abs(yim) - 2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10);
-  }
+  int i = 4 * (nsymbols / 4);
+  demod_16qam_lte_s_scalar(&symbols[i], &llr[4 * i], nsymbols - i);
 }
 
 void demod_16qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
@@ -347,36 +376,118 @@ void demod_16qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
     resultPtr++;
   }
   // Demodulate last symbols
-  for (int i = 8 * (nsymbols / 8); i < nsymbols; i++) {
-    short yre = (int8_t)(SCALE_BYTE_CONV_QAM16 * crealf(symbols[i]));
-    short yim = (int8_t)(SCALE_BYTE_CONV_QAM16 * cimagf(symbols[i]));
+  int i = 8 * (nsymbols / 8);
+  demod_16qam_lte_b_scalar(&symbols[i], &llr[4 * i], nsymbols - i);
+}
 
-    llr[4 * i + 0] = -yre;
-    llr[4 * i + 1] = -yim;
-    llr[4 * i + 2] = abs(yre) - 2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10);
-    llr[4 * i + 3] = abs(yim) - 2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10);
+#endif
+
+#ifdef LV_HAVE_AVX2
+
+/*
+ * Same algorithm as demod_16qam_lte_s_sse using 256-bit registers. The 32-bit pack interleaves the 128-bit lanes in
+ * such a way that each lane of the resulting LLR registers already holds consecutive symbols.
+ */
+static int demod_16qam_lte_s_avx2(const cf_t* symbols, short* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m256i*     resultPtr  = (__m256i*)llr;
+  __m256i      offset     = _mm256_set1_epi16(2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10));
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM16);
+  __m256i      shuffle_negated_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 7, 6, 5, 4, 0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0));
+  __m256i shuffle_abs_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(7, 6, 5, 4, 0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_negated_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8));
+  __m256i shuffle_abs_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8, 0xff, 0xff, 0xff, 0xff));
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m256i symbol_i1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr), scale_v));
+    __m256i symbol_i2 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 8), scale_v));
+    symbolsPtr += 16;
+
+    // Lane 0 holds symbols 0, 1, 4 and 5, lane 1 holds symbols 2, 3, 6 and 7
+    __m256i symbol_i   = _mm256_packs_epi32(symbol_i1, symbol_i2);
+    __m256i symbol_abs = _mm256_sub_epi16(_mm256_abs_epi16(symbol_i), offset);
+
+    __m256i result1n = _mm256_shuffle_epi8(symbol_i, shuffle_negated_1);
+    __m256i result1a = _mm256_shuffle_epi8(symbol_abs, shuffle_abs_1);
+    __m256i result2n = _mm256_shuffle_epi8(symbol_i, shuffle_negated_2);
+    __m256i result2a = _mm256_shuffle_epi8(symbol_abs, shuffle_abs_2);
+
+    _mm256_storeu_si256(resultPtr++, _mm256_or_si256(result1n, result1a));
+    _mm256_storeu_si256(resultPtr++, _mm256_or_si256(result2n, result2a));
   }
+
+  return i;
 }
 
-#endif
+/*
+ * Same algorithm as demod_16qam_lte_b_sse using 256-bit registers. The 32-bit and 16-bit packs interleave the 128-bit
+ * lanes, the 32-bit words (pairs of symbols) are reordered so that each lane holds 8 consecutive symbols.
+ */
+static int demod_16qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m256i*     resultPtr  = (__m256i*)llr;
+  __m256i      offset     = _mm256_set1_epi8(2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10));
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM16);
+  __m256i      reorder    = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  __m256i      shuffle_negated_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 7, 6, 0xff, 0xff, 5, 4, 0xff, 0xff, 3, 2, 0xff, 0xff, 1, 0));
+  __m256i shuffle_abs_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(7, 6, 0xff, 0xff, 5, 4, 0xff, 0xff, 3, 2, 0xff, 0xff, 1, 0, 0xff, 0xff));
+  __m256i shuffle_negated_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 15, 14, 0xff, 0xff, 13, 12, 0xff, 0xff, 11, 10, 0xff, 0xff, 9, 8));
+  __m256i shuffle_abs_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(15, 14, 0xff, 0xff, 13, 12, 0xff, 0xff, 11, 10, 0xff, 0xff, 9, 8, 0xff, 0xff));
+
+  int i = 0;
+  for (; i < nsymbols - 15; i += 16) {
+    __m256i symbol_i1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr), scale_v));
+    __m256i symbol_i2 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 8), scale_v));
+    __m256i symbol_i3 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 16), scale_v));
+    __m256i symbol_i4 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 24), scale_v));
+    symbolsPtr += 32;
+
+    __m256i symbol_12 = _mm256_packs_epi32(symbol_i1, symbol_i2);
+    __m256i symbol_34 = _mm256_packs_epi32(symbol_i3, symbol_i4);
+    __m256i symbol_i  = _mm256_permutevar8x32_epi32(_mm256_packs_epi16(symbol_12, symbol_34), reorder);
+
+    __m256i symbol_abs = _mm256_sub_epi8(_mm256_abs_epi8(symbol_i), offset);
+
+    __m256i result1 = _mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_1),
+                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_1));
+    __m256i result2 = _mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_2),
+                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_2));
+
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(result1, result2, 0x20));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(result1, result2, 0x31));
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX2 */
 
 void demod_16qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
 #ifdef LV_HAVE_SSE
+#ifdef LV_HAVE_AVX2
+  int i = demod_16qam_lte_s_avx2(symbols, llr, nsymbols);
+  symbols += i;
+  llr += 4 * i;
+  nsymbols -= i;
+#endif /* LV_HAVE_AVX2 */
   demod_16qam_lte_s_sse(symbols, llr, nsymbols);
 #else
 #ifdef HAVE_NEONv8
   demod_16qam_lte_s_neon(symbols, llr, nsymbols);
 #else
-  for (int i = 0; i < nsymbols; i++) {
-    short yre = (short)(SCALE_SHORT_CONV_QAM16 * crealf(symbols[i]));
-    short yim = (short)(SCALE_SHORT_CONV_QAM16 * cimagf(symbols[i]));
-
-    llr[4 * i + 0] = -yre;
-    llr[4 * i + 1] = -yim;
-    llr[4 * i + 2] = abs(yre) - 2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10);
-    llr[4 * i + 3] = abs(yim) - 2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10);
-  }
+  demod_16qam_lte_s_scalar(symbols, llr, nsymbols);
 #endif
 #endif
 }
@@ -384,20 +495,18 @@ void demod_16qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 void demod_16qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
 #ifdef LV_HAVE_SSE
+#ifdef LV_HAVE_AVX2
+  int i = demod_16qam_lte_b_avx2(symbols, llr, nsymbols);
+  symbols += i;
+  llr += 4 * i;
+  nsymbols -= i;
+#endif /* LV_HAVE_AVX2 */
   demod_16qam_lte_b_sse(symbols, llr, nsymbols);
 #else
 #ifdef HAVE_NEONv8
   demod_16qam_lte_b_neon(symbols, llr, nsymbols);
 #else
-  for (int i = 0; i < nsymbols; i++) {
-    int8_t yre = (int8_t)(SCALE_BYTE_CONV_QAM16 * crealf(symbols[i]));
-    int8_t yim = (int8_t)(SCALE_BYTE_CONV_QAM16 * cimagf(symbols[i]));
-
-    llr[4 * i + 0] = -yre;
-    llr[4 * i + 1] = -yim;
-    llr[4 * i + 2] = abs(yre) - 2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10);
-    llr[4 * i + 3] = abs(yim) - 2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10);
-  }
+  demod_16qam_lte_b_scalar(symbols, llr, nsymbols);
 #endif
 #endif
 }
@@ -416,6 +525,44 @@ void demod_64qam_lte(const cf_t* symbols, float* llr, int nsymbols)
     llr[6 * i + 5] = fabsf(llr[6 * i + 3]) - 2 / sqrtf(42);
   }
 }
+
+/*
+ * Scalar fixed point 64QAM demodulators, also used for the last symbols of the SIMD ones. Same quantization as the
+ * 16QAM ones.
+ */
+static void demod_64qam_lte_s_scalar(const cf_t* symbols, short* llr, int nsymbols)
+{
+  const short threshold1 = 4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
+  const short threshold2 = 2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
+  for (int i = 0; i < nsymbols; i++) {
+    short yre = demod_soft_sat_s(rintf(-SCALE_SHORT_CONV_QAM64 * crealf(symbols[i])));
+    short yim = demod_soft_sat_s(rintf(-SCALE_SHORT_CONV_QAM64 * cimagf(symbols[i])));
+
+    llr[6 * i + 0] = yre;
+    llr[6 * i + 1] = yim;
+    llr[6 * i + 2] = abs(yre) - threshold1;
+    llr[6 * i + 3] = abs(yim) - threshold1;
+    llr[6 * i + 4] = abs(llr[6 * i + 2]) - threshold2;
+    llr[6 * i + 5] = abs(llr[6 * i + 3]) - threshold2;
+  }
+}
+
+static void demod_64qam_lte_b_scalar(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const int8_t threshold1 = 4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
+  const int8_t threshold2 = 2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
+  for (int i = 0; i < nsymbols; i++) {
+    int8_t yre = demod_soft_sat_b(rintf(-SCALE_BYTE_CONV_QAM64 * crealf(symbols[i])));
+    int8_t yim = demod_soft_sat_b(rintf(-SCALE_BYTE_CONV_QAM64 * cimagf(symbols[i])));
+
+    llr[6 * i + 0] = yre;
+    llr[6 * i + 1] = yim;
+    llr[6 * i + 2] = abs(yre) - threshold1;
+    llr[6 * i + 3] = abs(yim) - threshold1;
+    llr[6 * i + 4] = abs(llr[6 * i + 2]) - threshold2;
+    llr[6 * i + 5] = abs(llr[6 * i + 3]) - threshold2;
+  }
+}
 #ifdef HAVE_NEONv8
 
 void demod_64qam_lte_s_neon(const cf_t* symbols, short* llr, int nsymbols)
@@ -467,17 +614,9 @@ void demod_64qam_lte_s_neon(const cf_t* symbols, short* llr, int nsymbols)
     vst1q_s16((int16_t*)resultPtr, result31);
     resultPtr++;
   }
-  for (int i = 4 * (nsymbols / 4); i < nsymbols; i++) {
-    float yre = (short)(SCALE_SHORT_CONV_QAM64 * crealf(symbols[i]));
-    float yim = (short)(SCALE_SHORT_CONV_QAM64 * cimagf(symbols[i]));
-
-    llr[6 * i + 0] = -yre;
-    llr[6 * i + 1] = -yim;
-    llr[6 * i + 2] = fabs(yre) - 4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 3] = fabs(yim) - 4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 4] = abs(llr[6 * i + 2]) - 2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 5] = abs(llr[6 * i + 3]) - 2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-  }
+  // Demodulate last symbols
+  int i = 4 * (nsymbols / 4);
+  demod_64qam_lte_s_scalar(&symbols[i], &llr[6 * i], nsymbols - i);
 }
 
 void demod_64qam_lte_b_neon(const cf_t* symbols, int8_t* llr, int nsymbols)
@@ -549,17 +688,9 @@ void demod_64qam_lte_b_neon(const cf_t* symbols, int8_t* llr, int nsymbols)
     vst1q_s8((int8_t*)resultPtr, result31);
     resultPtr++;
   }
-  for (int i = 8 * (nsymbols / 8); i < nsymbols; i++) {
-    float yre = (int8_t)(SCALE_BYTE_CONV_QAM64 * crealf(symbols[i]));
-    float yim = (int8_t)(SCALE_BYTE_CONV_QAM64 * cimagf(symbols[i]));
-
-    llr[6 * i + 0] = -yre;
-    llr[6 * i + 1] = -yim;
-    llr[6 * i + 2] = fabs(yre) - 4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 3] = fabs(yim) - 4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 4] = abs(llr[6 * i + 2]) - 2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 5] = abs(llr[6 * i + 3]) - 2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-  }
+  // Demodulate last symbols
+  int i = 8 * (nsymbols / 8);
+  demod_64qam_lte_b_scalar(&symbols[i], &llr[6 * i], nsymbols - i);
 }
 
 #endif
@@ -628,19 +759,9 @@ static void demod_64qam_lte_s_sse(const cf_t* symbols, int16_t* llr, int nsymbol
     resultPtr++;
   }
 
-  const int16_t threshold1 = 4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-  const int16_t threshold2 = 2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-  for (int i = 4 * (nsymbols / 4); i < nsymbols; i++) {
-    int16_t yre = SCALE_SHORT_CONV_QAM64 * crealf(symbols[i]);
-    int16_t yim = SCALE_SHORT_CONV_QAM64 * cimagf(symbols[i]);
-
-    llr[6 * i + 0] = -yre;
-    llr[6 * i + 1] = -yim;
-    llr[6 * i + 2] = (int16_t)abs(yre) - threshold1;
-    llr[6 * i + 3] = (int16_t)abs(yim) - threshold1;
-    llr[6 * i + 4] = (int16_t)abs(llr[6 * i + 2]) - threshold2;
-    llr[6 * i + 5] = (int16_t)abs(llr[6 * i + 3]) - threshold2;
-  }
+  // Demodulate last symbols
+  int i = 4 * (nsymbols / 4);
+  demod_64qam_lte_s_scalar(&symbols[i], &llr[6 * i], nsymbols - i);
 }
 
 void demod_64qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
@@ -714,42 +835,159 @@ void demod_64qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
     resultPtr++;
   }
 
-  const int8_t threshold1 = 4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-  const int8_t threshold2 = 2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-  for (int i = 8 * (nsymbols / 8); i < nsymbols; i++) {
-    int8_t yre = SCALE_BYTE_CONV_QAM64 * crealf(symbols[i]);
-    int8_t yim = SCALE_BYTE_CONV_QAM64 * cimagf(symbols[i]);
+  // Demodulate last symbols
+  int i = 8 * (nsymbols / 8);
+  demod_64qam_lte_b_scalar(&symbols[i], &llr[6 * i], nsymbols - i);
+}
 
-    llr[6 * i + 0] = -yre;
-    llr[6 * i + 1] = -yim;
-    llr[6 * i + 2] = (int8_t)abs(yre) - threshold1;
-    llr[6 * i + 3] = (int8_t)abs(yim) - threshold1;
-    llr[6 * i + 4] = (int8_t)abs(llr[6 * i + 2]) - threshold2;
-    llr[6 * i + 5] = (int8_t)abs(llr[6 * i + 3]) - threshold2;
+#endif
+
+#ifdef LV_HAVE_AVX2
+
+/*
+ * Same algorithm as demod_64qam_lte_s_sse using 256-bit registers. The 64-bit words (pairs of symbols) are reordered
+ * after the 32-bit pack so that each lane holds 4 consecutive symbols, then the per lane results are recombined.
+ */
+static int demod_64qam_lte_s_avx2(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m256i*     resultPtr  = (__m256i*)llr;
+  __m256i      offset1    = _mm256_set1_epi16(4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42));
+  __m256i      offset2    = _mm256_set1_epi16(2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42));
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM64);
+
+  __m256i shuffle_negated_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(7, 6, 5, 4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0));
+  __m256i shuffle_negated_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_negated_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(11, 10, 9, 8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 7, 6, 5, 4));
+  __m256i shuffle_abs_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs2_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 7, 6, 5, 4, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8));
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m256i symbol_i1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr), scale_v));
+    __m256i symbol_i2 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 8), scale_v));
+    symbolsPtr += 16;
+
+    __m256i symbol_i    = _mm256_permute4x64_epi64(_mm256_packs_epi32(symbol_i1, symbol_i2), 0xd8);
+    __m256i symbol_abs  = _mm256_sub_epi16(_mm256_abs_epi16(symbol_i), offset1);
+    __m256i symbol_abs2 = _mm256_sub_epi16(_mm256_abs_epi16(symbol_abs), offset2);
+
+    __m256i result1 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_1),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_1)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_1));
+    __m256i result2 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_2),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_2)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_2));
+    __m256i result3 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_3),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_3)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_3));
+
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(result1, result2, 0x20));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(result3, result1, 0x30));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(result2, result3, 0x31));
   }
+
+  return i;
 }
 
-#endif
+/*
+ * Same algorithm as demod_64qam_lte_b_sse using 256-bit registers. The 32-bit words (pairs of symbols) are reordered
+ * after the packs so that each lane holds 8 consecutive symbols, then the per lane results are recombined.
+ */
+static int demod_64qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m256i*     resultPtr  = (__m256i*)llr;
+  __m256i      offset1    = _mm256_set1_epi8(4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42));
+  __m256i      offset2    = _mm256_set1_epi8(2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42));
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM64);
+  __m256i      reorder    = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+  __m256i shuffle_negated_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 5, 4, 0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0));
+  __m256i shuffle_negated_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(11, 10, 0xff, 0xff, 0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff));
+  __m256i shuffle_negated_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(5, 4, 0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0, 0xff, 0xff));
+  __m256i shuffle_abs_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10));
+
+  __m256i shuffle_abs2_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff, 0xff, 0xff, 5, 4));
+  __m256i shuffle_abs2_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10, 0xff, 0xff));
+
+  int i = 0;
+  for (; i < nsymbols - 15; i += 16) {
+    __m256i symbol_i1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr), scale_v));
+    __m256i symbol_i2 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 8), scale_v));
+    __m256i symbol_i3 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 16), scale_v));
+    __m256i symbol_i4 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 24), scale_v));
+    symbolsPtr += 32;
+
+    __m256i symbol_12   = _mm256_packs_epi32(symbol_i1, symbol_i2);
+    __m256i symbol_34   = _mm256_packs_epi32(symbol_i3, symbol_i4);
+    __m256i symbol_i    = _mm256_permutevar8x32_epi32(_mm256_packs_epi16(symbol_12, symbol_34), reorder);
+    __m256i symbol_abs  = _mm256_sub_epi8(_mm256_abs_epi8(symbol_i), offset1);
+    __m256i symbol_abs2 = _mm256_sub_epi8(_mm256_abs_epi8(symbol_abs), offset2);
+
+    __m256i result1 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_1),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_1)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_1));
+    __m256i result2 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_2),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_2)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_2));
+    __m256i result3 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_3),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_3)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_3));
+
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(result1, result2, 0x20));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(result3, result1, 0x30));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(result2, result3, 0x31));
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX2 */
 
 void demod_64qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
 #ifdef LV_HAVE_SSE
+#ifdef LV_HAVE_AVX2
+  int i = demod_64qam_lte_s_avx2(symbols, llr, nsymbols);
+  symbols += i;
+  llr += 6 * i;
+  nsymbols -= i;
+#endif /* LV_HAVE_AVX2 */
   demod_64qam_lte_s_sse(symbols, llr, nsymbols);
 #else
 #ifdef HAVE_NEONv8
   demod_64qam_lte_s_neon(symbols, llr, nsymbols);
 #else
-  for (int i = 0; i < nsymbols; i++) {
-    float yre = (short)(SCALE_SHORT_CONV_QAM64 * crealf(symbols[i]));
-    float yim = (short)(SCALE_SHORT_CONV_QAM64 * cimagf(symbols[i]));
-
-    llr[6 * i + 0] = -yre;
-    llr[6 * i + 1] = -yim;
-    llr[6 * i + 2] = abs(yre) - 4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 3] = abs(yim) - 4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 4] = abs(llr[6 * i + 2]) - 2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 5] = abs(llr[6 * i + 3]) - 2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42);
-  }
+  demod_64qam_lte_s_scalar(symbols, llr, nsymbols);
 #endif
 #endif
 }
@@ -757,29 +995,117 @@ void demod_64qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
 #ifdef LV_HAVE_SSE
+#ifdef LV_HAVE_AVX2
+  int i = demod_64qam_lte_b_avx2(symbols, llr, nsymbols);
+  symbols += i;
+  llr += 6 * i;
+  nsymbols -= i;
+#endif /* LV_HAVE_AVX2 */
   demod_64qam_lte_b_sse(symbols, llr, nsymbols);
 #else
 #ifdef HAVE_NEONv8
   demod_64qam_lte_b_neon(symbols, llr, nsymbols);
 #else
-  for (int i = 0; i < nsymbols; i++) {
-    float yre = (int8_t)(SCALE_BYTE_CONV_QAM64 * crealf(symbols[i]));
-    float yim = (int8_t)(SCALE_BYTE_CONV_QAM64 * cimagf(symbols[i]));
-
-    llr[6 * i + 0] = -yre;
-    llr[6 * i + 1] = -yim;
-    llr[6 * i + 2] = abs(yre) - 4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 3] = abs(yim) - 4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 4] = abs(llr[6 * i + 2]) - 2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-    llr[6 * i + 5] = abs(llr[6 * i + 3]) - 2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42);
-  }
+  demod_64qam_lte_b_scalar(symbols, llr, nsymbols);
 #endif
 #endif
 }
 
+#ifdef LV_HAVE_AVX512
+
+/*
+ * Computes the four LLR stages of 8 symbols at once, then transposes them, as pairs of real and imaginary parts, into
+ * the symbol-major order of the scalar implementation. The result is bit-exact with the scalar implementation.
+ */
+static int demod_256qam_lte_avx512(const cf_t* symbols, float* llr, int nsymbols)
+{
+  const __m512 sign       = _mm512_set1_ps(-0.0f);
+  const __m512 threshold1 = _mm512_set1_ps(8.0f / sqrtf(170.0f));
+  const __m512 threshold2 = _mm512_set1_ps(4.0f / sqrtf(170.0f));
+  const __m512 threshold3 = _mm512_set1_ps(2.0f / sqrtf(170.0f));
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m512 stage1 = _mm512_xor_ps(_mm512_loadu_ps((const float*)&symbols[i]), sign);
+    __m512 stage2 = _mm512_sub_ps(_mm512_andnot_ps(sign, stage1), threshold1);
+    __m512 stage3 = _mm512_sub_ps(_mm512_andnot_ps(sign, stage2), threshold2);
+    __m512 stage4 = _mm512_sub_ps(_mm512_andnot_ps(sign, stage3), threshold3);
+
+    // Each 128-bit lane of a/c holds stages 1-2/3-4 of an even symbol, b/d of an odd symbol
+    __m512d a = _mm512_unpacklo_pd(_mm512_castps_pd(stage1), _mm512_castps_pd(stage2));
+    __m512d b = _mm512_unpackhi_pd(_mm512_castps_pd(stage1), _mm512_castps_pd(stage2));
+    __m512d c = _mm512_unpacklo_pd(_mm512_castps_pd(stage3), _mm512_castps_pd(stage4));
+    __m512d d = _mm512_unpackhi_pd(_mm512_castps_pd(stage3), _mm512_castps_pd(stage4));
+
+    __m512d ac_lo = _mm512_shuffle_f64x2(a, c, 0x44);
+    __m512d bd_lo = _mm512_shuffle_f64x2(b, d, 0x44);
+    __m512d ac_hi = _mm512_shuffle_f64x2(a, c, 0xee);
+    __m512d bd_hi = _mm512_shuffle_f64x2(b, d, 0xee);
+
+    double* ptr = (double*)&llr[8 * i];
+    _mm512_storeu_pd(ptr, _mm512_shuffle_f64x2(ac_lo, bd_lo, 0x88));
+    _mm512_storeu_pd(ptr + 8, _mm512_shuffle_f64x2(ac_lo, bd_lo, 0xdd));
+    _mm512_storeu_pd(ptr + 16, _mm512_shuffle_f64x2(ac_hi, bd_hi, 0x88));
+    _mm512_storeu_pd(ptr + 24, _mm512_shuffle_f64x2(ac_hi, bd_hi, 0xdd));
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+
+/*
+ * Computes the four LLR stages of 4 symbols at once, then transposes them, as pairs of real and imaginary parts, into
+ * the symbol-major order of the scalar implementation. The result is bit-exact with the scalar implementation.
+ */
+static int demod_256qam_lte_avx2(const cf_t* symbols, float* llr, int nsymbols)
+{
+  const __m256 sign       = _mm256_set1_ps(-0.0f);
+  const __m256 threshold1 = _mm256_set1_ps(8.0f / sqrtf(170.0f));
+  const __m256 threshold2 = _mm256_set1_ps(4.0f / sqrtf(170.0f));
+  const __m256 threshold3 = _mm256_set1_ps(2.0f / sqrtf(170.0f));
+
+  int i = 0;
+  for (; i < nsymbols - 3; i += 4) {
+    __m256 stage1 = _mm256_xor_ps(_mm256_loadu_ps((const float*)&symbols[i]), sign);
+    __m256 stage2 = _mm256_sub_ps(_mm256_andnot_ps(sign, stage1), threshold1);
+    __m256 stage3 = _mm256_sub_ps(_mm256_andnot_ps(sign, stage2), threshold2);
+    __m256 stage4 = _mm256_sub_ps(_mm256_andnot_ps(sign, stage3), threshold3);
+
+    // Each 128-bit lane of a/c holds stages 1-2/3-4 of an even symbol, b/d of an odd symbol
+    __m256d a = _mm256_unpacklo_pd(_mm256_castps_pd(stage1), _mm256_castps_pd(stage2));
+    __m256d b = _mm256_unpackhi_pd(_mm256_castps_pd(stage1), _mm256_castps_pd(stage2));
+    __m256d c = _mm256_unpacklo_pd(_mm256_castps_pd(stage3), _mm256_castps_pd(stage4));
+    __m256d d = _mm256_unpackhi_pd(_mm256_castps_pd(stage3), _mm256_castps_pd(stage4));
+
+    double* ptr = (double*)&llr[8 * i];
+    _mm256_storeu_pd(ptr, _mm256_permute2f128_pd(a, c, 0x20));
+    _mm256_storeu_pd(ptr + 4, _mm256_permute2f128_pd(b, d, 0x20));
+    _mm256_storeu_pd(ptr + 8, _mm256_permute2f128_pd(a, c, 0x31));
+    _mm256_storeu_pd(ptr + 12, _mm256_permute2f128_pd(b, d, 0x31));
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
 void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
+  int i = 0;
+
+#ifdef LV_HAVE_AVX512
+  i = demod_256qam_lte_avx512(symbols, llr, nsymbols);
+#endif /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  // Also demodulates the remainder of the AVX512 implementation, up to the last 3 symbols
+  i += demod_256qam_lte_avx2(&symbols[i], &llr[8 * i], nsymbols - i);
+#endif /* LV_HAVE_AVX2 */
+  llr += 8 * i;
+
+  for (; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
     *(llr++)   = real;
@@ -801,45 +1127,69 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 
 void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
+  int i = 0;
+
+#ifdef LV_HAVE_AVX2
+  // Demodulate blocks in floating point, the conversion truncates and saturates as the scalar implementation does
+  float llr_f[8 * DEMOD_SOFT_BLOCK_NSYMBOLS];
+  for (; i < nsymbols - DEMOD_SOFT_BLOCK_NSYMBOLS + 1; i += DEMOD_SOFT_BLOCK_NSYMBOLS) {
+    demod_256qam_lte(&symbols[i], llr_f, DEMOD_SOFT_BLOCK_NSYMBOLS);
+    srsran_vec_convert_fb(llr_f, SCALE_BYTE_CONV_QAM256, llr, 8 * DEMOD_SOFT_BLOCK_NSYMBOLS);
+    llr += 8 * DEMOD_SOFT_BLOCK_NSYMBOLS;
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
+    *(llr++)   = demod_soft_sat_b(SCALE_BYTE_CONV_QAM256 * real);
+    *(llr++)   = demod_soft_sat_b(SCALE_BYTE_CONV_QAM256 * imag);
     real       = fabsf(real) - 8.0f / sqrtf(170.0f);
     imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
+    *(llr++)   = demod_soft_sat_b(SCALE_BYTE_CONV_QAM256 * real);
+    *(llr++)   = demod_soft_sat_b(SCALE_BYTE_CONV_QAM256 * imag);
     real       = fabsf(real) - 4.0f / sqrtf(170.0f);
     imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
+    *(llr++)   = demod_soft_sat_b(SCALE_BYTE_CONV_QAM256 * real);
+    *(llr++)   = demod_soft_sat_b(SCALE_BYTE_CONV_QAM256 * imag);
     real       = fabsf(real) - 2.0f / sqrtf(170.0f);
     imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
+    *(llr++)   = demod_soft_sat_b(SCALE_BYTE_CONV_QAM256 * real);
+    *(llr++)   = demod_soft_sat_b(SCALE_BYTE_CONV_QAM256 * imag);
   }
 }
 
 void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
+  int i = 0;
+
+#ifdef LV_HAVE_AVX2
+  // Demodulate blocks in floating point, the conversion truncates and saturates as the scalar implementation does
+  float llr_f[8 * DEMOD_SOFT_BLOCK_NSYMBOLS];
+  for (; i < nsymbols - DEMOD_SOFT_BLOCK_NSYMBOLS + 1; i += DEMOD_SOFT_BLOCK_NSYMBOLS) {
+    demod_256qam_lte(&symbols[i], llr_f, DEMOD_SOFT_BLOCK_NSYMBOLS);
+    srsran_vec_convert_fi(llr_f, SCALE_SHORT_CONV_QAM256, llr, 8 * DEMOD_SOFT_BLOCK_NSYMBOLS);
+    llr += 8 * DEMOD_SOFT_BLOCK_NSYMBOLS;
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
+    *(llr++)   = demod_soft_sat_s(SCALE_SHORT_CONV_QAM256 * real);
+    *(llr++)   = demod_soft_sat_s(SCALE_SHORT_CONV_QAM256 * imag);
     real       = fabsf(real) - 8.0f / sqrtf(170.0f);
     imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
+    *(llr++)   = demod_soft_sat_s(SCALE_SHORT_CONV_QAM256 * real);
+    *(llr++)   = demod_soft_sat_s(SCALE_SHORT_CONV_QAM256 * imag);
     real       = fabsf(real) - 4.0f / sqrtf(170.0f);
     imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
+    *(llr++)   = demod_soft_sat_s(SCALE_SHORT_CONV_QAM256 * real);
+    *(llr++)   = demod_soft_sat_s(SCALE_SHORT_CONV_QAM256 * imag);
     real       = fabsf(real) - 2.0f / sqrtf(170.0f);
     imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
+    *(llr++)   = demod_soft_sat_s(SCALE_SHORT_CONV_QAM256 * real);
+    *(llr++)   = demod_soft_sat_s(SCALE_SHORT_CONV_QAM256 * imag);
   }
 }
 
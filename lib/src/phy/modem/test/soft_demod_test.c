@@ -36,7 +36,7 @@ static srsran_mod_t modulation = SRSRAN_MOD_NITEMS;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)\n", prog);
+  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-f nof_frames [Default %d]\n", nof_frames);
   printf("\t-v srsran_verbose [Default None]\n");
@@ -109,6 +109,110 @@ float mse_threshold()
   }
 }
 
+/* Scalar reference of the LTE soft demodulators, QAM LLRs are written as interleaved real/imaginary pairs per stage */
+static uint32_t demod_reference(const cf_t* symbols, float* llr, uint32_t nsymbols)
+{
+  float    thresholds[3] = {0.0f};
+  uint32_t nof_stages    = 0;
+  switch (modulation) {
+    case SRSRAN_MOD_BPSK:
+      for (uint32_t i = 0; i < nsymbols; i++) {
+        llr[i] = -(crealf(symbols[i]) + cimagf(symbols[i])) * M_SQRT1_2;
+      }
+      return nsymbols;
+    case SRSRAN_MOD_QPSK:
+      for (uint32_t i = 0; i < 2 * nsymbols; i++) {
+        llr[i] = ((const float*)symbols)[i] * (float)-M_SQRT2;
+      }
+      return 2 * nsymbols;
+    case SRSRAN_MOD_16QAM:
+      thresholds[0] = 2 / sqrtf(10);
+      nof_stages    = 2;
+      break;
+    case SRSRAN_MOD_64QAM:
+      thresholds[0] = 4 / sqrtf(42);
+      thresholds[1] = 2 / sqrtf(42);
+      nof_stages    = 3;
+      break;
+    case SRSRAN_MOD_256QAM:
+      thresholds[0] = 8.0f / sqrtf(170.0f);
+      thresholds[1] = 4.0f / sqrtf(170.0f);
+      thresholds[2] = 2.0f / sqrtf(170.0f);
+      nof_stages    = 4;
+      break;
+    default:
+      return 0;
+  }
+
+  for (uint32_t i = 0; i < nsymbols; i++) {
+    float real = -__real__ symbols[i];
+    float imag = -__imag__ symbols[i];
+    for (uint32_t j = 0; j < nof_stages; j++) {
+      if (j > 0) {
+        real = fabsf(real) - thresholds[j - 1];
+        imag = fabsf(imag) - thresholds[j - 1];
+      }
+      llr[2 * (nof_stages * i + j) + 0] = real;
+      llr[2 * (nof_stages * i + j) + 1] = imag;
+    }
+  }
+
+  return 2 * nof_stages * nsymbols;
+}
+
+static int32_t saturate(float x, int32_t max)
+{
+  return (int32_t)SRSRAN_MAX(-max - 1, SRSRAN_MIN(max, x));
+}
+
+/*
+ * Fixed point reference of the soft demodulators for the LLR at index idx. The 16QAM and 64QAM demodulators quantize
+ * the symbols, rounding and saturating, and compute the stages with truncated thresholds. The others quantize the
+ * floating point LLRs, truncating and saturating.
+ */
+static int32_t demod_reference_fixed(const cf_t* symbols, const float* llr_ref, uint32_t idx, bool is_byte)
+{
+  int32_t  max           = is_byte ? INT8_MAX : INT16_MAX;
+  float    scale         = 0.0f;
+  float    thresholds[2] = {0.0f};
+  uint32_t nof_stages    = 0;
+  switch (modulation) {
+    case SRSRAN_MOD_BPSK:
+    case SRSRAN_MOD_QPSK:
+      scale = is_byte ? 20 : 100;
+      break;
+    case SRSRAN_MOD_16QAM:
+      scale         = is_byte ? 30 : 400;
+      thresholds[0] = 2 * scale / sqrtf(10);
+      nof_stages    = 2;
+      break;
+    case SRSRAN_MOD_64QAM:
+      scale         = is_byte ? 40 : 700;
+      thresholds[0] = 4 * scale / sqrtf(42);
+      thresholds[1] = 2 * scale / sqrtf(42);
+      nof_stages    = 3;
+      break;
+    case SRSRAN_MOD_256QAM:
+      scale = is_byte ? 50 : 1000;
+      break;
+    default:
+      return 0;
+  }
+
+  if (nof_stages == 0) {
+    return saturate(scale * llr_ref[idx], max);
+  }
+
+  uint32_t symbol = idx / (2 * nof_stages);
+  uint32_t stage  = (idx % (2 * nof_stages)) / 2;
+  float    y      = (idx % 2 == 0) ? crealf(symbols[symbol]) : cimagf(symbols[symbol]);
+  int32_t  llr    = saturate(rintf(-scale * y), max);
+  for (uint32_t j = 0; j < stage; j++) {
+    llr = abs(llr) - (int32_t)thresholds[j];
+  }
+  return llr;
+}
+
 int main(int argc, char** argv)
 {
   int                  i;
@@ -118,6 +222,7 @@ int main(int argc, char** argv)
   float*               llr;
   short*               llr_s;
   int8_t*              llr_b;
+  float*               llr_ref;
 
   parse_args(argc, argv);
 
@@ -165,6 +270,12 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  llr_ref = srsran_vec_f_malloc(num_bits);
+  if (!llr_ref) {
+    perror("malloc");
+    exit(-1);
+  }
+
   /* generate random data */
   srand(0);
 
@@ -181,6 +292,11 @@ int main(int argc, char** argv)
     /* modulate */
     srsran_mod_modulate(&mod, input, symbols, num_bits);
 
+    /* amplify every other frame so that the fixed point LLRs saturate */
+    if (n % 2 == 1) {
+      srsran_vec_sc_prod_cfc(symbols, 8.0f, symbols, num_bits / mod.nbits_x_symbol);
+    }
+
     gettimeofday(&t[1], NULL);
     srsran_demod_soft_demodulate(modulation, symbols, llr, num_bits / mod.nbits_x_symbol);
     gettimeofday(&t[2], NULL);
@@ -226,17 +342,34 @@ int main(int argc, char** argv)
       srsran_vec_fprint_bs(stdout, llr_b, num_bits);
     }
 
-    // Check demodulation errors
-    for (int i = 0; i < num_bits; i++) {
+    // Check demodulation errors, the amplified frames are out of the constellation
+    for (int i = 0; i < num_bits && n % 2 == 0; i++) {
       if (input[i] != (llr[i] > 0 ? 1 : 0)) {
         printf("Error in bit %d\n", i);
         goto clean_exit;
       }
     }
+
+    // Check the vectorized demodulators are bit-exact with the scalar reference in floating point and within one unit
+    // in fixed point, where all of them saturate
+    uint32_t nof_llr = demod_reference(symbols, llr_ref, num_bits / mod.nbits_x_symbol);
+    for (uint32_t i = 0; i < nof_llr; i++) {
+      if (llr[i] != llr_ref[i]) {
+        printf("LLR %d mismatch: %f != %f\n", i, llr[i], llr_ref[i]);
+        goto clean_exit;
+      }
+      int32_t llr_s_ref = demod_reference_fixed(symbols, llr_ref, i, false);
+      int32_t llr_b_ref = demod_reference_fixed(symbols, llr_ref, i, true);
+      if (abs(llr_s[i] - llr_s_ref) > 1 || abs(llr_b[i] - llr_b_ref) > 1) {
+        printf("LLR %d fixed point mismatch: %d/%d != %d/%d\n", i, llr_s[i], llr_b[i], llr_s_ref, llr_b_ref);
+        goto clean_exit;
+      }
+    }
   }
   ret = 0;
 
 clean_exit:
+  free(llr_ref);
   free(llr_b);
   free(llr_s);
   free(llr);
@@ -50,6 +50,20 @@ float srsran_pdcch_coderate(uint32_t nof_bits, uint32_t l)
   return (float)(nof_bits + 16) / (nof_bits_x_symbol * PDCCH_FORMAT_NOF_REGS(l));
 }
 
+void srsran_pdcch_set_llr_threshold(srsran_pdcch_t* q, float threshold)
+{
+  if (q != NULL) {
+    q->llr_threshold = threshold;
+  }
+}
+
+void srsran_pdcch_set_meas_time(srsran_pdcch_t* q, bool enable)
+{
+  if (q != NULL) {
+    q->meas_time_en = enable;
+  }
+}
+
 /** Initializes the PDCCH transmitter and receiver */
 static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_antennas, bool is_ue)
 {
@@ -60,6 +74,7 @@ static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
     bzero(q, sizeof(srsran_pdcch_t));
     q->nof_rx_antennas = nof_rx_antennas;
     q->is_ue           = is_ue;
+    q->llr_threshold   = SRSRAN_PDCCH_DEFAULT_LLR_THRESHOLD;
     /* Allocate memory for the maximum number of PDCCH bits (CFI=3) */
     q->max_bits = max_prb * 3 * 12 * 2;
 
@@ -369,11 +384,26 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+/* Finds a candidate decoded since the last LLR extraction with the same location and payload size */
+static srsran_pdcch_candidate_t*
+pdcch_find_decoded(srsran_pdcch_t* q, const srsran_dci_location_t* location, uint32_t nof_bits)
+{
+  for (uint32_t i = 0; i < q->nof_decoded; i++) {
+    srsran_pdcch_candidate_t* c = &q->decoded[i];
+    if (c->nof_bits == nof_bits && c->location.ncce == location->ncce && c->location.L == location->L) {
+      return c;
+    }
+  }
+  return NULL;
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
  * The decoded message is stored in msg and the CRC remainder in msg->rnti
  *
+ * The Viterbi output of every location and payload size is kept until the next LLR extraction, so candidates searched
+ * for different RNTIs, formats of equal size or overlapping search spaces are decoded only once per subframe.
  */
 int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg)
 {
@@ -384,36 +414,75 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
     } else {
       ret = SRSRAN_SUCCESS;
 
+      struct timeval t[3];
+      if (q->meas_time_en) {
+        gettimeofday(&t[1], NULL);
+      }
+
       uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
       uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
 
-      // Compute absolute mean of the LLRs
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
-      }
-      mean /= e_bits;
-
-      if (mean > 0.3f) {
-        ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
-        if (ret == SRSRAN_SUCCESS) {
-          msg->nof_bits = nof_bits;
-          // Check format differentiation
-          if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
-            msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+      q->nof_candidates++;
+
+      srsran_pdcch_candidate_t* decoded = pdcch_find_decoded(q, &msg->location, nof_bits);
+      if (decoded != NULL) {
+        srsran_vec_u8_copy(msg->payload, decoded->payload, nof_bits);
+        msg->rnti     = decoded->crc_rem;
+        msg->nof_bits = nof_bits;
+        if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
+          msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+        }
+        DEBUG("Reusing decoded DCI: nCCE=%d, L=%d, msg_len=%d, crc_rem=0x%x",
+              msg->location.ncce,
+              msg->location.L,
+              nof_bits,
+              msg->rnti);
+      } else {
+        // Compute absolute mean of the LLRs
+        double mean = 0;
+        for (int i = 0; i < e_bits; i++) {
+          mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
+        }
+        mean /= e_bits;
+
+        if (mean > q->llr_threshold) {
+          ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+          if (ret == SRSRAN_SUCCESS) {
+            q->nof_viterbi++;
+            msg->nof_bits = nof_bits;
+
+            // Keep the result for other candidates with the same location and size
+            if (q->nof_decoded < SRSRAN_PDCCH_MAX_DECODED_CANDIDATES) {
+              decoded           = &q->decoded[q->nof_decoded++];
+              decoded->location = msg->location;
+              decoded->nof_bits = nof_bits;
+              decoded->crc_rem  = msg->rnti;
+              srsran_vec_u8_copy(decoded->payload, msg->payload, nof_bits);
+            }
+
+            // Check format differentiation
+            if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
+              msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+            }
+          } else {
+            ERROR("Error calling pdcch_dci_decode");
           }
+          INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, mean=%f, crc_rem=0x%x",
+               msg->location.ncce,
+               msg->location.L,
+               srsran_dci_format_string(msg->format),
+               nof_bits,
+               mean,
+               msg->rnti);
         } else {
-          ERROR("Error calling pdcch_dci_decode");
+          INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, mean);
         }
-        INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, mean=%f, crc_rem=0x%x",
-             msg->location.ncce,
-             msg->location.L,
-             srsran_dci_format_string(msg->format),
-             nof_bits,
-             mean,
-             msg->rnti);
-      } else {
-        INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, mean);
+      }
+
+      if (q->meas_time_en) {
+        gettimeofday(&t[2], NULL);
+        get_time_interval(t);
+        q->meas_time_us += (uint32_t)t[0].tv_usec;
       }
     }
   } else if (msg != NULL) {
@@ -463,6 +532,12 @@ int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
     ret             = SRSRAN_ERROR;
     srsran_vec_f_zero(q->llr, q->max_bits);
 
+    /* new LLRs invalidate the candidates decoded so far */
+    q->nof_decoded    = 0;
+    q->nof_candidates = 0;
+    q->nof_viterbi    = 0;
+    q->meas_time_us   = 0;
+
     DEBUG("Extracting LLRs: E: %d, SF: %d, CFI: %d", e_bits, sf->tti % 10, sf->cfi);
 
     /* number of layers equals number of ports */
@@ -230,7 +230,7 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
 
 #ifdef LV_HAVE_AVX2
   if (!args->disable_simd) {
-    decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    decoder_type = SRSRAN_POLAR_DECODER_SSC_C_BATCH_AVX2;
   }
 #endif // LV_HAVE_AVX2
 
@@ -238,6 +238,16 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     return SRSRAN_ERROR;
   }
 
+  q->d_batch = srsran_vec_i8_malloc(NMAX * SRSRAN_POLAR_DECODER_MAX_BATCH);
+  if (q->d_batch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->allocated_batch = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_MAX_BATCH);
+  if (q->allocated_batch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
   if (srsran_polar_rm_rx_init_c(&q->rm) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -285,6 +295,14 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     free(q->symbols);
   }
 
+  if (q->d_batch) {
+    free(q->d_batch);
+  }
+
+  if (q->allocated_batch) {
+    free(q->allocated_batch);
+  }
+
   srsran_modem_table_free(&q->modem_table);
 
   if (q->evm_buffer) {
@@ -569,38 +587,41 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   return SRSRAN_SUCCESS;
 }
 
-int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
-                           cf_t*                   slot_symbols,
-                           srsran_dmrs_pdcch_ce_t* ce,
-                           srsran_dci_msg_nr_t*    dci_msg,
-                           srsran_pdcch_nr_res_t*  res)
+/**
+ * @brief Computes the sizes and gets the polar code of the DCI messages of the given size and aggregation level
+ */
+static int pdcch_nr_decode_prepare(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg)
 {
-  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
-    return SRSRAN_ERROR;
-  }
-
-  struct timeval t[3];
-  if (q->meas_time_en) {
-    gettimeofday(&t[1], NULL);
-  }
-
   // Calculate...
   q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
   q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
   q->E = q->M * 2;                                                 // Number of Rate-Matched bits
 
-  // Check number of estimates is correct
-  if (ce->nof_re != q->M) {
-    ERROR("Invalid number of channel estimates (%d != %d)", q->M, ce->nof_re);
-    return SRSRAN_ERROR;
-  }
-
   // Get polar code
   if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
 
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Extracts, equalises and demodulates a PDCCH candidate, leaving the polar decoder input LLR in d
+ */
+static int pdcch_nr_decode_llr(srsran_pdcch_nr_t*         q,
+                               cf_t*                      slot_symbols,
+                               srsran_dmrs_pdcch_ce_t*    ce,
+                               const srsran_dci_msg_nr_t* dci_msg,
+                               srsran_pdcch_nr_res_t*     res,
+                               int8_t*                    d)
+{
+  // Check number of estimates is correct
+  if (ce->nof_re != q->M) {
+    ERROR("Invalid number of channel estimates (%d != %d)", q->M, ce->nof_re);
+    return SRSRAN_ERROR;
+  }
+
   // Get symbols from grid
   uint32_t m = pdcch_nr_cp(q, &dci_msg->ctx.location, slot_symbols, q->symbols, false);
   if (q->M != m) {
@@ -643,7 +664,6 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
 
   // Un-rate matching
-  int8_t* d = (int8_t*)q->d;
   if (srsran_polar_rm_rx_c(&q->rm, llr, d, q->E, q->code.n, q->K, PDCCH_NR_POLAR_RM_IBIL) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -654,15 +674,20 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     srsran_vec_fprint_bs(stdout, d, q->K);
   }
 
-  // Decode
-  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
+  return SRSRAN_SUCCESS;
+}
 
+/**
+ * @brief Recovers the DCI message from the polar decoder output and checks its CRC
+ */
+static void pdcch_nr_decode_check(srsran_pdcch_nr_t*     q,
+                                  const uint8_t*         allocated,
+                                  srsran_dci_msg_nr_t*   dci_msg,
+                                  srsran_pdcch_nr_res_t* res)
+{
   // De-allocate channel
   uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
-  srsran_polar_chanalloc_rx(q->allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+  srsran_polar_chanalloc_rx(allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
 
   // Set first L bits to ones, c will have an offset of 24 bits
   uint8_t* c = q->c;
@@ -700,6 +725,39 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
 
   // Copy DCI message
   srsran_vec_u8_copy(dci_msg->payload, c, dci_msg->nof_bits);
+}
+
+int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
+                           cf_t*                   slot_symbols,
+                           srsran_dmrs_pdcch_ce_t* ce,
+                           srsran_dci_msg_nr_t*    dci_msg,
+                           srsran_pdcch_nr_res_t*  res)
+{
+  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  if (pdcch_nr_decode_prepare(q, dci_msg) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  int8_t* d = (int8_t*)q->d;
+  if (pdcch_nr_decode_llr(q, slot_symbols, ce, dci_msg, res, d) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Decode
+  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
+      SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  pdcch_nr_decode_check(q, q->allocated, dci_msg, res);
 
   if (q->meas_time_en) {
     gettimeofday(&t[2], NULL);
@@ -716,6 +774,73 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_pdcch_nr_decode_batch(srsran_pdcch_nr_t*      q,
+                                 cf_t*                   slot_symbols,
+                                 srsran_dmrs_pdcch_ce_t* ce[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR],
+                                 srsran_dci_msg_nr_t     dci_msg[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR],
+                                 srsran_pdcch_nr_res_t   res[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR],
+                                 uint32_t                nof_candidates)
+{
+  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL ||
+      nof_candidates > SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR) {
+    return SRSRAN_ERROR;
+  }
+
+  if (nof_candidates == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // All the candidates must share the polar code
+  for (uint32_t i = 1; i < nof_candidates; i++) {
+    if (dci_msg[i].nof_bits != dci_msg[0].nof_bits || dci_msg[i].ctx.location.L != dci_msg[0].ctx.location.L) {
+      ERROR("Batched PDCCH candidates must have the same size and aggregation level");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  if (pdcch_nr_decode_prepare(q, &dci_msg[0]) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t first = 0; first < nof_candidates; first += SRSRAN_POLAR_DECODER_MAX_BATCH) {
+    uint32_t      count = SRSRAN_MIN(nof_candidates - first, SRSRAN_POLAR_DECODER_MAX_BATCH);
+    const int8_t* d[SRSRAN_POLAR_DECODER_MAX_BATCH];
+    uint8_t*      allocated[SRSRAN_POLAR_DECODER_MAX_BATCH];
+    for (uint32_t i = 0; i < count; i++) {
+      int8_t* d_i  = q->d_batch + i * NMAX;
+      d[i]         = d_i;
+      allocated[i] = q->allocated_batch + i * NMAX;
+      if (pdcch_nr_decode_llr(q, slot_symbols, ce[first + i], &dci_msg[first + i], &res[first + i], d_i) <
+          SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+
+    // Decode the candidates at once
+    if (srsran_polar_decoder_decode_batch_c(
+            &q->decoder, d, allocated, count, q->code.n, q->code.F_set, q->code.F_set_size) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+      pdcch_nr_decode_check(q, allocated[i], &dci_msg[first + i], &res[first + i]);
+    }
+  }
+
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_us = (uint32_t)t[0].tv_usec;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 uint32_t srsran_pdcch_nr_info(const srsran_pdcch_nr_t* q, const srsran_pdcch_nr_res_t* res, char* str, uint32_t str_len)
 {
   int len = 0;
@@ -28,6 +28,8 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <semaphore.h>
 
 #define SCH_INFO_TX(...) INFO("SCH Tx: " __VA_ARGS__)
 #define SCH_INFO_RX(...) INFO("SCH Rx: " __VA_ARGS__)
@@ -216,6 +218,298 @@ static inline int sch_nr_init_common(srsran_sch_nr_t* q)
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * @brief Describes the decoding of a single code block
+ */
+typedef struct {
+  uint32_t r;      ///< Code block index within the transport block
+  uint32_t E;      ///< Rate matching output sequence number of bits
+  int8_t*  input;  ///< Received code block soft bits
+  int      ret;    ///< Decode status
+  uint32_t n_iter; ///< Number of LDPC decoder iterations
+} sch_nr_cb_job_t;
+
+struct sch_nr_decoder_pool_s;
+
+/**
+ * @brief Code block decoder worker, it owns a complete SCH receiver because LDPC decoders, rate matcher and CRC objects
+ * keep internal state
+ */
+typedef struct {
+  srsran_sch_nr_t               sch;
+  struct sch_nr_decoder_pool_s* pool;
+  pthread_t                     pthread;
+  sem_t                         start;
+  bool                          started;
+  bool                          quit;
+} sch_nr_decoder_worker_t;
+
+/**
+ * @brief Shares the code blocks of a transport block between the caller thread and the decoder workers
+ */
+typedef struct sch_nr_decoder_pool_s {
+  sch_nr_decoder_worker_t* workers;
+  uint32_t                 nof_workers;
+
+  /* Job description: it must be set before posting start semaphores */
+  const srsran_sch_nr_tb_info_t* cfg;
+  const srsran_sch_tb_t*         tb;
+  sch_nr_cb_job_t*               jobs;
+  uint32_t                       nof_jobs;
+
+  /* Next job to claim, protected by mutex */
+  uint32_t        next_job;
+  pthread_mutex_t mutex;
+
+  /* Posted by every worker once there are no jobs left */
+  sem_t finish;
+} sch_nr_decoder_pool_t;
+
+/**
+ * @brief De-rate-matches, decodes and checks the CRC of a code block; it stores the CRC result and, if it matches, the
+ * packed code block in the softbuffer
+ */
+static int sch_nr_decode_cb(srsran_sch_nr_t*               q,
+                            const srsran_sch_nr_tb_info_t* cfg,
+                            const srsran_sch_tb_t*         tb,
+                            sch_nr_cb_job_t*               job)
+{
+  uint32_t               r         = job->r;
+  int8_t*                rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
+  srsran_ldpc_decoder_t* decoder   = (cfg->bg == BG1) ? q->decoder_bg1[cfg->Z] : q->decoder_bg2[cfg->Z];
+
+  // LDPC Rate matching
+  SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
+              r,
+              job->E,
+              cfg->F,
+              cfg->bg == BG1 ? 1 : 2,
+              cfg->Z,
+              tb->rv,
+              cfg->Qm,
+              cfg->Nref);
+  int n_llr = srsran_ldpc_rm_rx_c(
+      &q->rx_rm, job->input, rm_buffer, job->E, cfg->F, cfg->bg, cfg->Z, tb->rv, tb->mod, cfg->Nref);
+  if (n_llr < SRSRAN_SUCCESS) {
+    ERROR("Error in LDPC rate mateching");
+    return SRSRAN_ERROR;
+  }
+
+  // Select CB or TB early stop CRC
+  srsran_crc_t* crc = (cfg->L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+  if (cfg->L_cb) {
+    crc = &q->crc_cb;
+  }
+
+  // Decode. if CRC=KO, then ret=0
+  int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB");
+    return SRSRAN_ERROR;
+  }
+
+  // Compute number of iterations
+  job->n_iter = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
+
+  // Check if CB is all zeros
+  uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+  tb->softbuffer.rx->cb_crc[r] = (ret != 0);
+  SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg->C, job->n_iter, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+
+  // CB Debug trace
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+    DEBUG("CB %d/%d:", r, cfg->C);
+    srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
+  }
+
+  // Pack only if CRC is match
+  if (tb->softbuffer.rx->cb_crc[r]) {
+    srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Claims and decodes code blocks from the pool until there are none left
+ */
+static void sch_nr_decoder_pool_run(sch_nr_decoder_pool_t* pool, srsran_sch_nr_t* q)
+{
+  for (;;) {
+    pthread_mutex_lock(&pool->mutex);
+    uint32_t idx = pool->next_job++;
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (idx >= pool->nof_jobs) {
+      return;
+    }
+
+    sch_nr_cb_job_t* job = &pool->jobs[idx];
+    job->ret             = sch_nr_decode_cb(q, pool->cfg, pool->tb, job);
+  }
+}
+
+static void* sch_nr_decoder_thread(void* arg)
+{
+  sch_nr_decoder_worker_t* w = (sch_nr_decoder_worker_t*)arg;
+
+  sem_wait(&w->start);
+  while (!w->quit) {
+    sch_nr_decoder_pool_run(w->pool, &w->sch);
+
+    /* Post finish semaphore */
+    sem_post(&w->pool->finish);
+
+    /* Wait for next transport block */
+    sem_wait(&w->start);
+  }
+
+  return NULL;
+}
+
+static void sch_nr_decoder_pool_free(srsran_sch_nr_t* q)
+{
+  sch_nr_decoder_pool_t* pool = (sch_nr_decoder_pool_t*)q->decoder_pool;
+  if (pool == NULL) {
+    return;
+  }
+
+  if (pool->workers) {
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      sch_nr_decoder_worker_t* w = &pool->workers[i];
+
+      /* Stop threads */
+      if (w->started) {
+        w->quit = true;
+        sem_post(&w->start);
+        pthread_join(w->pthread, NULL);
+      }
+      sem_destroy(&w->start);
+      srsran_sch_nr_free(&w->sch);
+    }
+    free(pool->workers);
+  }
+
+  sem_destroy(&pool->finish);
+  pthread_mutex_destroy(&pool->mutex);
+  free(pool);
+
+  q->decoder_pool = NULL;
+}
+
+static int sch_nr_decoder_pool_init(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
+{
+  // The caller thread decodes code blocks too, so it needs one worker less than threads
+  if (q->decoder_pool != NULL || args->nof_decoder_threads <= 1) {
+    return SRSRAN_SUCCESS;
+  }
+
+  sch_nr_decoder_pool_t* pool = SRSRAN_MEM_ALLOC(sch_nr_decoder_pool_t, 1);
+  if (pool == NULL) {
+    ERROR("Error: calloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool, sch_nr_decoder_pool_t, 1);
+  q->decoder_pool = pool;
+
+  if (pthread_mutex_init(&pool->mutex, NULL) || sem_init(&pool->finish, 0, 0)) {
+    ERROR("Error creating decoder pool synchronization");
+    free(pool);
+    q->decoder_pool = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  pool->workers = SRSRAN_MEM_ALLOC(sch_nr_decoder_worker_t, args->nof_decoder_threads - 1);
+  if (pool->workers == NULL) {
+    ERROR("Error: calloc");
+    sch_nr_decoder_pool_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool->workers, sch_nr_decoder_worker_t, args->nof_decoder_threads - 1);
+
+  srsran_sch_nr_args_t worker_args = *args;
+  worker_args.nof_decoder_threads  = 0;
+
+  for (uint32_t i = 0; i < args->nof_decoder_threads - 1; i++) {
+    sch_nr_decoder_worker_t* w = &pool->workers[i];
+    w->pool                    = pool;
+
+    if (sem_init(&w->start, 0, 0)) {
+      ERROR("Error creating semaphore");
+      sch_nr_decoder_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+    pool->nof_workers++;
+
+    if (srsran_sch_nr_init_rx(&w->sch, &worker_args) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising SCH decoder worker %d", i);
+      sch_nr_decoder_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    if (pthread_create(&w->pthread, NULL, sch_nr_decoder_thread, w)) {
+      ERROR("Error creating SCH decoder thread %d", i);
+      sch_nr_decoder_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+    w->started = true;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Decodes a list of code blocks, spreading them across the decoder workers if there are any
+ */
+static void sch_nr_decode_cb_jobs(srsran_sch_nr_t*               q,
+                                  const srsran_sch_nr_tb_info_t* cfg,
+                                  const srsran_sch_tb_t*         tb,
+                                  sch_nr_cb_job_t*               jobs,
+                                  uint32_t                       nof_jobs)
+{
+  sch_nr_decoder_pool_t* pool = (sch_nr_decoder_pool_t*)q->decoder_pool;
+
+  // Decode sequentially if there is nothing to share
+  if (pool == NULL || nof_jobs <= 1) {
+    for (uint32_t i = 0; i < nof_jobs; i++) {
+      jobs[i].ret = sch_nr_decode_cb(q, cfg, tb, &jobs[i]);
+    }
+    return;
+  }
+
+  pool->cfg      = cfg;
+  pool->tb       = tb;
+  pool->jobs     = jobs;
+  pool->nof_jobs = nof_jobs;
+  pool->next_job = 0;
+
+  // Wake up only as many workers as code blocks are left for them
+  uint32_t nof_workers = SRSRAN_MIN(pool->nof_workers, nof_jobs - 1);
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    sem_post(&pool->workers[i].start);
+  }
+
+  sch_nr_decoder_pool_run(pool, q);
+
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    sem_wait(&pool->finish);
+  }
+}
+
+static void sch_nr_decode_stats_add(srsran_sch_nr_decode_stats_t* stats, uint32_t time_us)
+{
+  uint32_t bin = 0;
+  while (bin < SRSRAN_SCH_NR_DECODE_HIST_NOF_BINS - 1 && (time_us >> (bin + 1)) != 0) {
+    bin++;
+  }
+
+  stats->hist[bin]++;
+  stats->count++;
+  stats->sum_us += time_us;
+  stats->max_us = SRSRAN_MAX(stats->max_us, time_us);
+}
+
 int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
 {
   int ret = sch_nr_init_common(q);
@@ -356,6 +650,11 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
+  if (sch_nr_decoder_pool_init(q, args) < SRSRAN_SUCCESS) {
+    ERROR("Error: initialising %d SCH decoder threads", args->nof_decoder_threads);
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -377,6 +676,8 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
     return;
   }
 
+  sch_nr_decoder_pool_free(q);
+
   if (q->temp_cb) {
     free(q->temp_cb);
   }
@@ -574,6 +875,9 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     return SRSRAN_ERROR;
   }
 
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+
   int8_t*  input_ptr    = e_bits;
   uint32_t nof_iter_sum = 0;
 
@@ -607,12 +911,13 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   uint32_t cb_ok = 0;
   res->crc       = false;
 
-  // For each code block...
-  uint32_t j = 0;
+  // For each code block, select the ones that need decoding
+  sch_nr_cb_job_t jobs[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
+  uint32_t        nof_jobs = 0;
+  uint32_t        j        = 0;
   for (uint32_t r = 0; r < cfg.C; r++) {
-    bool    decoded   = tb->softbuffer.rx->cb_crc[r];
-    int8_t* rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
-    if (!rm_buffer) {
+    bool decoded = tb->softbuffer.rx->cb_crc[r];
+    if (!tb->softbuffer.tx->buffer_b[r]) {
       ERROR("Error: soft-buffer provided NULL buffer for cb_idx=%d", r);
       return SRSRAN_ERROR;
     }
@@ -630,69 +935,38 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     uint32_t E = sch_nr_get_E(&cfg, j);
     j++;
 
-    // Skip CB if it has a matched CRC
+    // Skip CB if it has a matched CRC, its soft bits are still present in the input
     if (decoded) {
       SCH_INFO_RX("RM CB %d: CRC OK ... Skipping", r);
       cb_ok++;
+      input_ptr += E;
       continue;
     }
 
-    // LDPC Rate matching
-    SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
-                r,
-                E,
-                cfg.F,
-                cfg.bg == BG1 ? 1 : 2,
-                cfg.Z,
-                tb->rv,
-                cfg.Qm,
-                cfg.Nref);
-    int n_llr =
-        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg.F, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
-    if (n_llr < SRSRAN_SUCCESS) {
-      ERROR("Error in LDPC rate mateching");
-      return SRSRAN_ERROR;
-    }
-
-    // Select CB or TB early stop CRC
-    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
-    if (cfg.L_cb) {
-      crc = &q->crc_cb;
-    }
+    jobs[nof_jobs].r      = r;
+    jobs[nof_jobs].E      = E;
+    jobs[nof_jobs].input  = input_ptr;
+    jobs[nof_jobs].ret    = SRSRAN_ERROR;
+    jobs[nof_jobs].n_iter = 0;
+    nof_jobs++;
 
-    // Decode. if CRC=KO, then ret=0
-    int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
-    if (ret < SRSRAN_SUCCESS) {
-      ERROR("Error decoding CB");
-      return SRSRAN_ERROR;
-    }
-
-    // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
-    nof_iter_sum += n_iter_cb;
-
-    // Check if CB is all zeros
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
+    input_ptr += E;
+  }
 
-    tb->softbuffer.rx->cb_crc[r] = (ret != 0);
-    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg.C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+  // Decode the selected code blocks, possibly in parallel
+  sch_nr_decode_cb_jobs(q, &cfg, tb, jobs, nof_jobs);
 
-    // CB Debug trace
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-      DEBUG("CB %d/%d:", r, cfg.C);
-      srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
+  // Combine code block results
+  for (uint32_t i = 0; i < nof_jobs; i++) {
+    if (jobs[i].ret < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
     }
 
-    // Pack and count CRC OK only if CRC is match
-    if (tb->softbuffer.rx->cb_crc[r]) {
-      srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
+    nof_iter_sum += jobs[i].n_iter;
+    if (tb->softbuffer.rx->cb_crc[jobs[i].r]) {
       cb_ok++;
     }
-
-    input_ptr += E;
   }
-  // Set average number of iterations
-  res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
 
   // Set average number of iterations
   if (cfg.C > 0) {
@@ -703,6 +977,9 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
 
   // Not all CB are decoded, skip TB union and CRC check
   if (cb_ok != cfg.C) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    sch_nr_decode_stats_add(&q->decode_stats, (uint32_t)(t[0].tv_sec * 1000000 + t[0].tv_usec));
     return SRSRAN_SUCCESS;
   }
 
@@ -746,6 +1023,10 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     srsran_vec_fprint_byte(stdout, res->payload, tb->tbs / 8);
   }
 
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  sch_nr_decode_stats_add(&q->decode_stats, (uint32_t)(t[0].tv_sec * 1000000 + t[0].tv_usec));
+
   return SRSRAN_SUCCESS;
 }
 
@@ -807,3 +1088,46 @@ int srsran_sch_nr_tb_info(const srsran_sch_tb_t* tb, const srsran_sch_tb_res_nr_
 
   return len;
 }
+
+uint32_t srsran_sch_nr_decode_stats_info(const srsran_sch_nr_t* q, char* str, uint32_t str_len)
+{
+  uint32_t len = 0;
+
+  if (q == NULL || str == NULL || str_len == 0) {
+    return 0;
+  }
+
+  const srsran_sch_nr_decode_stats_t* stats = &q->decode_stats;
+  if (stats->count == 0) {
+    return srsran_print_check(str, str_len, len, "decode: n=0");
+  }
+
+  len = srsran_print_check(str,
+                           str_len,
+                           len,
+                           "decode: n=%d avg=%.1f max=%d us hist={",
+                           stats->count,
+                           (double)stats->sum_us / (double)stats->count,
+                           stats->max_us);
+
+  // Print only populated bins, labelled with their lower bound in microseconds
+  bool first = true;
+  for (uint32_t i = 0; i < SRSRAN_SCH_NR_DECODE_HIST_NOF_BINS; i++) {
+    if (stats->hist[i] == 0) {
+      continue;
+    }
+    len   = srsran_print_check(str, str_len, len, "%s%d:%d", first ? "" : " ", i == 0 ? 0 : 1U << i, stats->hist[i]);
+    first = false;
+  }
+
+  return srsran_print_check(str, str_len, len, "}");
+}
+
+void srsran_sch_nr_decode_stats_reset(srsran_sch_nr_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  SRSRAN_MEM_ZERO(&q->decode_stats, srsran_sch_nr_decode_stats_t, 1);
+}
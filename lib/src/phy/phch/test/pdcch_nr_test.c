@@ -35,14 +35,17 @@ typedef struct {
   uint64_t count;
 } proc_time_t;
 
-static proc_time_t enc_time[SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR] = {};
-static proc_time_t dec_time[SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR] = {};
-
-static int test(srsran_pdcch_nr_t*      tx,
-                srsran_pdcch_nr_t*      rx,
-                cf_t*                   grid,
-                srsran_dmrs_pdcch_ce_t* ce,
-                srsran_dci_msg_nr_t*    dci_msg_tx)
+static proc_time_t enc_time[SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR]   = {};
+static proc_time_t dec_time[SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR]   = {};
+static proc_time_t batch_time[SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR] = {};
+
+static int test(srsran_pdcch_nr_t*         tx,
+                srsran_pdcch_nr_t*         rx,
+                cf_t*                      grid,
+                srsran_dmrs_pdcch_ce_t**   ce,
+                const srsran_dci_msg_nr_t* dci_msg_tx,
+                const uint32_t*            locations,
+                uint32_t                   nof_locations)
 {
   // Encode PDCCH
   TESTASSERT(srsran_pdcch_nr_encode(tx, dci_msg_tx, grid) == SRSRAN_SUCCESS);
@@ -50,20 +53,46 @@ static int test(srsran_pdcch_nr_t*      tx,
   enc_time[dci_msg_tx->ctx.location.L].time_us += tx->meas_time_us;
   enc_time[dci_msg_tx->ctx.location.L].count++;
 
-  // Init Rx MSG
-  srsran_pdcch_nr_res_t res        = {};
-  srsran_dci_msg_nr_t   dci_msg_rx = *dci_msg_tx;
-  srsran_vec_u8_zero(dci_msg_rx.payload, dci_msg_rx.nof_bits);
+  // Decode every candidate of the aggregation level, one by one
+  srsran_pdcch_nr_res_t res[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]              = {};
+  srsran_dci_msg_nr_t   dci_msg_rx[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]       = {};
+  srsran_pdcch_nr_res_t res_batch[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]        = {};
+  srsran_dci_msg_nr_t   dci_msg_rx_batch[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+  for (uint32_t i = 0; i < nof_locations; i++) {
+    // Init Rx MSG
+    dci_msg_rx[i]                   = *dci_msg_tx;
+    dci_msg_rx[i].ctx.location.ncce = locations[i];
+    srsran_vec_u8_zero(dci_msg_rx[i].payload, dci_msg_rx[i].nof_bits);
+    dci_msg_rx_batch[i] = dci_msg_rx[i];
+
+    // Decode PDCCH
+    TESTASSERT(srsran_pdcch_nr_decode(rx, grid, ce[i], &dci_msg_rx[i], &res[i]) == SRSRAN_SUCCESS);
+
+    dec_time[dci_msg_tx->ctx.location.L].time_us += rx->meas_time_us;
+    dec_time[dci_msg_tx->ctx.location.L].count++;
+  }
 
-  // Decode PDCCH
-  TESTASSERT(srsran_pdcch_nr_decode(rx, grid, ce, &dci_msg_rx, &res) == SRSRAN_SUCCESS);
+  // Decode every candidate of the aggregation level at once
+  TESTASSERT(srsran_pdcch_nr_decode_batch(rx, grid, ce, dci_msg_rx_batch, res_batch, nof_locations) ==
+             SRSRAN_SUCCESS);
 
-  dec_time[dci_msg_tx->ctx.location.L].time_us += rx->meas_time_us;
-  dec_time[dci_msg_tx->ctx.location.L].count++;
+  batch_time[dci_msg_tx->ctx.location.L].time_us += rx->meas_time_us;
+  batch_time[dci_msg_tx->ctx.location.L].count += nof_locations;
 
   // Assert
-  TESTASSERT(res.evm < 0.01f);
-  TESTASSERT(res.crc);
+  bool found = false;
+  for (uint32_t i = 0; i < nof_locations; i++) {
+    TESTASSERT(res_batch[i].crc == res[i].crc);
+    TESTASSERT(memcmp(dci_msg_rx_batch[i].payload, dci_msg_rx[i].payload, dci_msg_rx[i].nof_bits) == 0);
+
+    if (locations[i] == dci_msg_tx->ctx.location.ncce) {
+      TESTASSERT(res[i].evm < 0.01f);
+      TESTASSERT(res[i].crc);
+      TESTASSERT(memcmp(dci_msg_rx[i].payload, dci_msg_tx->payload, dci_msg_tx->nof_bits) == 0);
+      found = true;
+    }
+  }
+  TESTASSERT(found);
 
   return SRSRAN_SUCCESS;
 }
@@ -115,20 +144,29 @@ int main(int argc, char** argv)
   srsran_pdcch_nr_t pdcch_tx = {};
   srsran_pdcch_nr_t pdcch_rx = {};
 
+  // One channel estimate for every candidate of an aggregation level
+  srsran_dmrs_pdcch_ce_t* ce[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+
   if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
-  uint32_t                grid_sz  = carrier.nof_prb * SRSRAN_NRE * SRSRAN_NSYMB_PER_SLOT_NR;
-  srsran_random_t         rand_gen = srsran_random_init(1234);
-  srsran_dmrs_pdcch_ce_t* ce       = SRSRAN_MEM_ALLOC(srsran_dmrs_pdcch_ce_t, 1);
-  cf_t*                   buffer   = srsran_vec_cf_malloc(grid_sz);
-  if (rand_gen == NULL || ce == NULL || buffer == NULL) {
+  uint32_t        grid_sz  = carrier.nof_prb * SRSRAN_NRE * SRSRAN_NSYMB_PER_SLOT_NR;
+  srsran_random_t rand_gen = srsran_random_init(1234);
+  cf_t*           buffer   = srsran_vec_cf_malloc(grid_sz);
+  if (rand_gen == NULL || buffer == NULL) {
     ERROR("Error malloc");
     goto clean_exit;
   }
 
-  SRSRAN_MEM_ZERO(ce, srsran_dmrs_pdcch_ce_t, 1);
+  for (uint32_t i = 0; i < SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR; i++) {
+    ce[i] = SRSRAN_MEM_ALLOC(srsran_dmrs_pdcch_ce_t, 1);
+    if (ce[i] == NULL) {
+      ERROR("Error malloc");
+      goto clean_exit;
+    }
+    SRSRAN_MEM_ZERO(ce[i], srsran_dmrs_pdcch_ce_t, 1);
+  }
 
   if (srsran_pdcch_nr_init_tx(&pdcch_tx, &args) < SRSRAN_SUCCESS) {
     ERROR("Error init");
@@ -242,13 +280,15 @@ int main(int argc, char** argv)
             }
 
             // Set channel estimate number of elements and set out-of-range values to zero
-            ce->nof_re = (SRSRAN_NRE - 3) * 6 * L;
-            for (uint32_t i = 0; i < SRSRAN_PDCCH_MAX_RE; i++) {
-              ce->ce[i] = (i < ce->nof_re) ? 1.0f : 0.0f;
+            for (uint32_t j = 0; j < n; j++) {
+              ce[j]->nof_re = (SRSRAN_NRE - 3) * 6 * L;
+              for (uint32_t i = 0; i < SRSRAN_PDCCH_MAX_RE; i++) {
+                ce[j]->ce[i] = (i < ce[j]->nof_re) ? 1.0f : 0.0f;
+              }
+              ce[j]->noise_var = 0.0f;
             }
-            ce->noise_var = 0.0f;
 
-            if (test(&pdcch_tx, &pdcch_rx, buffer, ce, &dci_msg) < SRSRAN_SUCCESS) {
+            if (test(&pdcch_tx, &pdcch_rx, buffer, ce, &dci_msg, dci_locations, n) < SRSRAN_SUCCESS) {
               ERROR("test failed");
               goto clean_exit;
             }
@@ -258,28 +298,31 @@ int main(int argc, char** argv)
     }
   }
 
-  printf("+--------+--------+--------+--------+\n");
-  printf("| %6s | %6s | %6s | %6s |\n", " ", " ", " Time ", " Time ");
-  printf("| %6s | %6s | %6s | %6s |\n", "  L  ", "Count", "Encode", "Decode");
-  printf("| %6s | %6s | %6s | %6s |\n", " ", " ", " (us) ", " (us) ");
-  printf("+--------+--------+--------+--------+\n");
+  printf("+--------+--------+--------+--------+--------+\n");
+  printf("| %6s | %6s | %6s | %6s | %6s |\n", " ", " ", " Time ", " Time ", " Time ");
+  printf("| %6s | %6s | %6s | %6s | %6s |\n", "  L  ", "Count", "Encode", "Decode", "Batch ");
+  printf("| %6s | %6s | %6s | %6s | %6s |\n", " ", " ", " (us) ", " (us) ", " (us) ");
+  printf("+--------+--------+--------+--------+--------+\n");
   for (uint32_t i = 0; i < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR; i++) {
-    if (enc_time[i].count > 0 && dec_time[i].count) {
-      printf("| %6" PRIu32 "| %6" PRIu64 " | %6.1f | %6.1f |\n",
+    if (enc_time[i].count > 0 && dec_time[i].count > 0 && batch_time[i].count > 0) {
+      printf("| %6" PRIu32 "| %6" PRIu64 " | %6.1f | %6.1f | %6.1f |\n",
              i,
              enc_time[i].count,
              (double)enc_time[i].time_us / (double)enc_time[i].count,
-             (double)dec_time[i].time_us / (double)dec_time[i].count);
+             (double)dec_time[i].time_us / (double)dec_time[i].count,
+             (double)batch_time[i].time_us / (double)batch_time[i].count);
     }
   }
-  printf("+--------+--------+--------+--------+\n");
+  printf("+--------+--------+--------+--------+--------+\n");
 
   ret = SRSRAN_SUCCESS;
 clean_exit:
   srsran_random_free(rand_gen);
 
-  if (ce) {
-    free(ce);
+  for (uint32_t i = 0; i < SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR; i++) {
+    if (ce[i]) {
+      free(ce[i]);
+    }
   }
 
   if (buffer) {
@@ -325,6 +325,18 @@ static int test_case1()
 
           // Assert received message
           TESTASSERT(payload_match);
+
+          // Decoding the same candidate again must reuse the previous Viterbi output
+          if (location_match) {
+            uint32_t         nof_viterbi = pdcch_rx.nof_viterbi;
+            srsran_dci_msg_t dci_rx2     = {};
+            dci_rx2.location             = locations[loc_rx];
+            dci_rx2.format               = format;
+            TESTASSERT(srsran_pdcch_decode_msg(&pdcch_rx, &dl_sf_cfg, &dci_cfg, &dci_rx2) == SRSRAN_SUCCESS);
+            TESTASSERT(pdcch_rx.nof_viterbi == nof_viterbi);
+            TESTASSERT(dci_rx2.rnti == dci_rx.rnti);
+            TESTASSERT(memcmp(dci_rx2.payload, dci_rx.payload, dci_rx.nof_bits) == 0);
+          }
         }
       }
     }
@@ -33,10 +33,11 @@ static uint32_t            n_prb     = 0;  // Set to 0 for steering
 static uint32_t            mcs       = 30; // Set to 30 for steering
 static uint32_t            rv        = 4;  // Set to 30 for steering
 static srsran_sch_cfg_nr_t pdsch_cfg = {};
+static uint32_t            nof_threads = 0; // Set to 0 or 1 for decoding in the caller thread
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [prTL] \n", prog);
+  printf("Usage: %s [prTLt] \n", prog);
   printf("\t-P Number of carrier PRB [Default %d]\n", carrier.nof_prb);
   printf("\t-p Number of grant PRB, set to 0 for steering [Default %d]\n", n_prb);
   printf("\t-r Redundancy version, set to 4 or higher for steering [Default %d]\n", rv);
@@ -44,13 +45,14 @@ static void usage(char* prog)
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-t Number of decoder threads [Default %d]\n", nof_threads);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "PpmTLvr")) != -1) {
+  while ((opt = getopt(argc, argv, "PpmTLtvr")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +72,9 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -82,6 +87,101 @@ int parse_args(int argc, char** argv)
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * Decodes a multi code block transport block whose last code block is corrupted, then retransmits it. The code blocks
+ * decoded in the first transmission are skipped and the corrupted one must be read from its own position in the input.
+ */
+static int test_retransmission(srsran_random_t         rand_gen,
+                               srsran_sch_nr_t*        sch_nr_tx,
+                               srsran_sch_nr_t*        sch_nr_rx,
+                               srsran_softbuffer_tx_t* softbuffer_tx,
+                               srsran_softbuffer_rx_t* softbuffer_rx,
+                               uint8_t*                data_tx,
+                               uint8_t*                encoded,
+                               int8_t*                 llr,
+                               uint8_t*                data_rx)
+{
+  for (uint32_t n = 0; n < SRSRAN_MAX_PRB_NR; n++) {
+    pdsch_cfg.grant.prb_idx[n] = (n < carrier.nof_prb);
+  }
+  pdsch_cfg.grant.nof_dmrs_cdm_groups_without_data = 1;
+
+  srsran_sch_tb_t tb = {};
+  tb.rv              = 0;
+  if (srsran_ra_nr_fill_tb(&pdsch_cfg, &pdsch_cfg.grant, 20, &tb) < SRSRAN_SUCCESS) {
+    ERROR("Error filing tb");
+    return SRSRAN_ERROR;
+  }
+  tb.softbuffer.tx = softbuffer_tx;
+  tb.softbuffer.rx = softbuffer_rx;
+
+  srsran_sch_nr_tb_info_t cfg = {};
+  if (srsran_sch_nr_fill_tb_info(&carrier, &pdsch_cfg.sch_cfg, &tb, &cfg) < SRSRAN_SUCCESS) {
+    ERROR("Error filing tb info");
+    return SRSRAN_ERROR;
+  }
+
+  // The skipped code blocks must precede the erased one
+  if (cfg.C < 2) {
+    ERROR("Retransmission test requires more than one code block; TBS=%d;", tb.tbs);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < tb.tbs / 8; i++) {
+    data_tx[i] = (uint8_t)i;
+  }
+
+  if (srsran_dlsch_nr_encode(sch_nr_tx, &pdsch_cfg.sch_cfg, &tb, data_tx, encoded) < SRSRAN_SUCCESS) {
+    ERROR("Error encoding");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < tb.nof_bits; i++) {
+    llr[i] = encoded[i] ? -10 : +10;
+  }
+
+  // Replace the last code block by weak noise, it takes at least nof_bits / C bits at the end of the input. Zeros
+  // would decode to the all-zero code block, which matches its CRC.
+  uint32_t nof_corrupted = tb.nof_bits / cfg.C;
+  for (uint32_t i = tb.nof_bits - nof_corrupted; i < tb.nof_bits; i++) {
+    llr[i] = (int8_t)srsran_random_uniform_int_dist(rand_gen, -3, 3);
+  }
+
+  srsran_softbuffer_rx_reset(softbuffer_rx);
+  srsran_sch_tb_res_nr_t res = {};
+  res.payload                = data_rx;
+  if (srsran_dlsch_nr_decode(sch_nr_rx, &pdsch_cfg.sch_cfg, &tb, llr, &res) < SRSRAN_SUCCESS) {
+    ERROR("Error decoding");
+    return SRSRAN_ERROR;
+  }
+
+  if (res.crc || softbuffer_rx->cb_crc[cfg.C - 1] || !softbuffer_rx->cb_crc[0]) {
+    ERROR("Unexpected first transmission result; C=%d; CRC=%s;", cfg.C, res.crc ? "OK" : "KO");
+    return SRSRAN_ERROR;
+  }
+
+  // Retransmit the same redundancy version without corruption, keeping the soft-buffer
+  for (uint32_t i = 0; i < tb.nof_bits; i++) {
+    llr[i] = encoded[i] ? -10 : +10;
+  }
+
+  res         = (srsran_sch_tb_res_nr_t){};
+  res.payload = data_rx;
+  if (srsran_dlsch_nr_decode(sch_nr_rx, &pdsch_cfg.sch_cfg, &tb, llr, &res) < SRSRAN_SUCCESS) {
+    ERROR("Error decoding");
+    return SRSRAN_ERROR;
+  }
+
+  if (!res.crc || memcmp(data_tx, data_rx, tb.tbs / 8) != 0) {
+    ERROR("Failed to decode retransmission; C=%d; TBS=%d;", cfg.C, tb.tbs);
+    return SRSRAN_ERROR;
+  }
+
+  INFO("Retransmission C=%d; TBS=%d; PASSED!\n", cfg.C, tb.tbs);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int             ret       = SRSRAN_ERROR;
@@ -110,6 +210,7 @@ int main(int argc, char** argv)
   args.decoder_use_flooded    = false;
   args.decoder_scaling_factor = 0.8;
   args.max_nof_iter           = 20;
+  args.nof_decoder_threads    = nof_threads;
   if (srsran_sch_nr_init_tx(&sch_nr_tx, &args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating SCH NR for Tx");
     goto clean_exit;
@@ -234,6 +335,16 @@ int main(int argc, char** argv)
     }
   }
 
+  if (test_retransmission(
+          rand_gen, &sch_nr_tx, &sch_nr_rx, &softbuffer_tx, &softbuffer_rx, data_tx, encoded, llr, data_rx) <
+      SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  char str[512];
+  srsran_sch_nr_decode_stats_info(&sch_nr_rx, str, (uint32_t)sizeof(str));
+  printf("%s\n", str);
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
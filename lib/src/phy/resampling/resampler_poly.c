@@ -0,0 +1,274 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Number of taps of each polyphase branch. It is a multiple of the AVX512 register size in complex samples, so the
+ * branch dot products do not need a scalar tail.
+ */
+#define RESAMPLER_POLY_NOF_TAPS 32
+
+/**
+ * Kaiser window shape parameter, it gives about 80 dB of stop band attenuation
+ */
+#define RESAMPLER_POLY_KAISER_BETA 8.0
+
+/**
+ * Maximum interpolation and decimation factors after reducing the ratio
+ */
+#define RESAMPLER_POLY_MAX_FACTOR 256
+
+/**
+ * Initial number of input samples the buffer can hold, it grows on demand
+ */
+#define RESAMPLER_POLY_INIT_NSAMPLES 1920
+
+static uint32_t resampler_poly_gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  return a;
+}
+
+// Zeroth order modified Bessel function of the first kind
+static double resampler_poly_bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+  for (uint32_t k = 1; k < 64 && term > 1e-12 * sum; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t interp, uint32_t decim)
+{
+  if (q == NULL || interp == 0 || decim == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t gcd = resampler_poly_gcd(interp, decim);
+  interp /= gcd;
+  decim /= gcd;
+  if (interp > RESAMPLER_POLY_MAX_FACTOR || decim > RESAMPLER_POLY_MAX_FACTOR) {
+    ERROR("Unsupported resampling ratio %d/%d", interp, decim);
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+
+  if (q->filter != NULL && q->interp == interp && q->decim == decim) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure resampler is freed
+  srsran_resampler_poly_free(q);
+
+  q->interp       = interp;
+  q->decim        = decim;
+  q->nof_taps     = RESAMPLER_POLY_NOF_TAPS;
+  q->max_nsamples = RESAMPLER_POLY_INIT_NSAMPLES;
+
+  q->buffer = srsran_vec_cf_malloc(q->nof_taps - 1 + q->max_nsamples);
+  if (q->buffer == NULL) {
+    srsran_resampler_poly_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t filter_len = interp * q->nof_taps;
+  q->filter           = srsran_vec_f_malloc(2 * filter_len);
+  if (q->filter == NULL) {
+    srsran_resampler_poly_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // Prototype low pass filter at the interpolated rate. The cut-off sits at the Nyquist frequency of the lowest of the
+  // input and output rates, and the window keeps the images and aliases of the occupied band away from the pass band
+  double fc     = 0.5 / (double)SRSRAN_MAX(interp, decim);
+  double center = (double)(filter_len - 1) / 2.0;
+  double i0     = resampler_poly_bessel_i0(RESAMPLER_POLY_KAISER_BETA);
+  double sum    = 0.0;
+  float* h      = srsran_vec_f_malloc(filter_len);
+  if (h == NULL) {
+    srsran_resampler_poly_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < filter_len; i++) {
+    double t    = (double)i - center;
+    double sinc = isnormal(t) ? sin(2.0 * M_PI * fc * t) / (M_PI * t) : 2.0 * fc;
+    double r    = t / center;
+    double w    = resampler_poly_bessel_i0(RESAMPLER_POLY_KAISER_BETA * sqrt(SRSRAN_MAX(0.0, 1.0 - r * r))) / i0;
+    h[i]        = (float)(sinc * w);
+    sum += sinc * w;
+  }
+
+  // Normalise for unit DC gain at the output rate, and split into polyphase branches. Each branch is stored time
+  // reversed so the output is the dot product of the branch and contiguous input samples
+  for (uint32_t p = 0; p < interp; p++) {
+    float* branch = &q->filter[2 * q->nof_taps * p];
+    for (uint32_t j = 0; j < q->nof_taps; j++) {
+      float coeff       = (float)(h[(q->nof_taps - 1 - j) * interp + p] * interp / sum);
+      branch[2 * j]     = coeff;
+      branch[2 * j + 1] = coeff;
+    }
+  }
+  free(h);
+
+  srsran_resampler_poly_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q)
+{
+  q->phase = 0;
+  srsran_vec_cf_zero(q->buffer, q->nof_taps - 1);
+}
+
+float srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->decim == 0) {
+    return NAN;
+  }
+
+  return (float)(q->interp * q->nof_taps - 1) / (float)(2 * q->decim);
+}
+
+uint32_t srsran_resampler_poly_get_nof_output(const srsran_resampler_poly_t* q, uint32_t nsamples)
+{
+  uint64_t end = (uint64_t)nsamples * q->interp;
+  if (end <= q->phase) {
+    return 0;
+  }
+  return (uint32_t)SRSRAN_CEIL(end - q->phase, q->decim);
+}
+
+uint32_t srsran_resampler_poly_get_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output)
+{
+  return (uint32_t)(((uint64_t)q->phase + (uint64_t)nof_output * q->decim) / q->interp);
+}
+
+// Dot product of len interleaved complex samples and the real taps of a branch, repeated for each complex component
+static inline cf_t resampler_poly_dot(const cf_t* x, const float* h, uint32_t len)
+{
+  const float* xf = (const float*)x;
+  float        re = 0.0f;
+  float        im = 0.0f;
+  uint32_t     i  = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  simd_f_t acc0 = srsran_simd_f_zero();
+  simd_f_t acc1 = srsran_simd_f_zero();
+  for (; i + 2 * SRSRAN_SIMD_F_SIZE <= 2 * len; i += 2 * SRSRAN_SIMD_F_SIZE) {
+    simd_f_t x0 = srsran_simd_f_loadu(&xf[i]);
+    simd_f_t x1 = srsran_simd_f_loadu(&xf[i + SRSRAN_SIMD_F_SIZE]);
+    acc0        = srsran_simd_f_add(acc0, srsran_simd_f_mul(x0, srsran_simd_f_load(&h[i])));
+    acc1        = srsran_simd_f_add(acc1, srsran_simd_f_mul(x1, srsran_simd_f_load(&h[i + SRSRAN_SIMD_F_SIZE])));
+  }
+
+  srsran_simd_aligned float acc[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_f_store(acc, srsran_simd_f_add(acc0, acc1));
+  for (uint32_t k = 0; k < SRSRAN_SIMD_F_SIZE; k += 2) {
+    re += acc[k];
+    im += acc[k + 1];
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  for (; i < 2 * len; i += 2) {
+    re += xf[i] * h[i];
+    im += xf[i + 1] * h[i + 1];
+  }
+
+  return re + I * im;
+}
+
+uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q, const cf_t* input, cf_t* output, uint32_t nsamples)
+{
+  if (q == NULL || q->buffer == NULL || output == NULL) {
+    return 0;
+  }
+
+  uint32_t state_len = q->nof_taps - 1;
+
+  // Grow the buffer if the number of samples exceeds its capacity, keeping the filter state
+  if (nsamples > q->max_nsamples) {
+    cf_t* buffer = srsran_vec_cf_malloc(state_len + nsamples);
+    if (buffer == NULL) {
+      return 0;
+    }
+    srsran_vec_cf_copy(buffer, q->buffer, state_len);
+    free(q->buffer);
+    q->buffer       = buffer;
+    q->max_nsamples = nsamples;
+  }
+
+  // Append the input after the filter state
+  if (input) {
+    srsran_vec_cf_copy(&q->buffer[state_len], input, nsamples);
+  } else {
+    srsran_vec_cf_zero(&q->buffer[state_len], nsamples);
+  }
+
+  // Each output sample takes the polyphase branch given by its time at the interpolated rate, and the window of input
+  // samples that ends at the latest input not after it
+  uint32_t count = 0;
+  uint64_t t     = q->phase;
+  uint64_t end   = (uint64_t)nsamples * q->interp;
+  for (; t < end; t += q->decim) {
+    uint32_t idx    = (uint32_t)(t / q->interp);
+    uint32_t branch = (uint32_t)(t % q->interp);
+    output[count++] = resampler_poly_dot(&q->buffer[idx], &q->filter[2 * q->nof_taps * branch], q->nof_taps);
+  }
+  q->phase = (uint32_t)(t - end);
+
+  // Keep the last input samples as filter state
+  memmove(q->buffer, &q->buffer[nsamples], sizeof(cf_t) * state_len);
+
+  return count;
+}
+
+void srsran_resampler_poly_free(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->buffer) {
+    free(q->buffer);
+  }
+  if (q->filter) {
+    free(q->filter);
+  }
+
+  memset(q, 0, sizeof(srsran_resampler_poly_t));
+}
@@ -0,0 +1,194 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of the FFT and polyphase resamplers. For every ratio it measures the throughput in input samples per
+ * second and the group delay, taken as the position of the peak of the impulse response, in output samples. The FFT
+ * resampler only supports integer ratios, so it is skipped for the fractional ones.
+ */
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static uint32_t buffer_size = 1920;
+static uint32_t repetitions = 1000;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sr]\n", prog);
+  printf("\t-s Buffer size at the low rate [Default %d]\n", buffer_size);
+  printf("\t-r Number of repetitions [Default %d]\n", repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "sr")) != -1) {
+    switch (opt) {
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t elapsed_us(struct timeval t[3])
+{
+  get_time_interval(t);
+  return (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+}
+
+static uint32_t peak_index(const cf_t* x, uint32_t len)
+{
+  uint32_t idx = 0;
+  for (uint32_t i = 1; i < len; i++) {
+    if (cabsf(x[i]) > cabsf(x[idx])) {
+      idx = i;
+    }
+  }
+  return idx;
+}
+
+static void print_result(const char* name, uint32_t interp, uint32_t decim, uint32_t delay, uint64_t duration_us)
+{
+  printf("%-5s %3d/%-3d delay=%4d samples; %8.1f Msps\n",
+         name,
+         interp,
+         decim,
+         delay,
+         (double)buffer_size * (interp < decim ? decim : 1) * repetitions / (double)duration_us);
+}
+
+static int bench_fft(srsran_resampler_mode_t mode, uint32_t factor, cf_t* in, cf_t* out)
+{
+  struct timeval         t[3] = {};
+  srsran_resampler_fft_t q    = {};
+  uint32_t               nin  = (mode == SRSRAN_RESAMPLER_MODE_INTERPOLATE) ? buffer_size : buffer_size * factor;
+  uint32_t               nout = (mode == SRSRAN_RESAMPLER_MODE_INTERPOLATE) ? buffer_size * factor : buffer_size;
+
+  if (srsran_resampler_fft_init(&q, mode, factor)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Impulse response, the input delta sits on a sample of both rates
+  srsran_vec_cf_zero(in, nin);
+  in[0] = 1.0f;
+  srsran_resampler_fft_run(&q, in, out, nin);
+  uint32_t delay = peak_index(out, nout);
+
+  srsran_vec_gen_sine(1.0f, 0.01f, in, nin);
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    srsran_resampler_fft_run(&q, in, out, nin);
+  }
+  gettimeofday(&t[2], NULL);
+
+  if (mode == SRSRAN_RESAMPLER_MODE_INTERPOLATE) {
+    print_result("fft", factor, 1, delay, elapsed_us(t));
+  } else {
+    print_result("fft", 1, factor, delay, elapsed_us(t));
+  }
+
+  srsran_resampler_fft_free(&q);
+  return SRSRAN_SUCCESS;
+}
+
+static int bench_poly(uint32_t interp, uint32_t decim, cf_t* in, cf_t* out)
+{
+  struct timeval          t[3] = {};
+  srsran_resampler_poly_t q    = {};
+  uint32_t                nin  = buffer_size * (interp < decim ? decim : 1);
+
+  if (srsran_resampler_poly_init(&q, interp, decim)) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_vec_cf_zero(in, nin);
+  in[0]          = 1.0f;
+  uint32_t nout  = srsran_resampler_poly_run(&q, in, out, nin);
+  uint32_t delay = peak_index(out, nout);
+
+  srsran_resampler_poly_reset_state(&q);
+  srsran_vec_gen_sine(1.0f, 0.01f, in, nin);
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    srsran_resampler_poly_run(&q, in, out, nin);
+  }
+  gettimeofday(&t[2], NULL);
+
+  print_result("poly", q.interp, q.decim, delay, elapsed_us(t));
+
+  srsran_resampler_poly_free(&q);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  static const uint32_t ratios[][2] = {{2, 1}, {1, 2}, {4, 1}, {1, 4}, {4, 3}, {3, 4}, {5, 4}, {4, 5}};
+
+  parse_args(argc, argv);
+
+  uint32_t max_size = buffer_size * 5 + 1;
+  cf_t*    in       = srsran_vec_cf_malloc(max_size);
+  cf_t*    out      = srsran_vec_cf_malloc(max_size);
+  int      ret      = SRSRAN_SUCCESS;
+  if (in == NULL || out == NULL) {
+    ret = SRSRAN_ERROR;
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < sizeof(ratios) / sizeof(ratios[0]) && ret == SRSRAN_SUCCESS; i++) {
+    uint32_t interp = ratios[i][0];
+    uint32_t decim  = ratios[i][1];
+
+    if (decim == 1) {
+      ret = bench_fft(SRSRAN_RESAMPLER_MODE_INTERPOLATE, interp, in, out);
+    } else if (interp == 1) {
+      ret = bench_fft(SRSRAN_RESAMPLER_MODE_DECIMATE, decim, in, out);
+    }
+
+    if (ret == SRSRAN_SUCCESS) {
+      ret = bench_poly(interp, decim, in, out);
+    }
+  }
+
+clean_exit:
+  if (in) {
+    free(in);
+  }
+  if (out) {
+    free(out);
+  }
+
+  return ret;
+}
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+
+static uint32_t buffer_size = 1920;
+static uint32_t interp      = 4;
+static uint32_t decim       = 3;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sid]\n", prog);
+  printf("\t-s Buffer size at the low rate [Default %d]\n", buffer_size);
+  printf("\t-i Interpolation factor [Default %d]\n", interp);
+  printf("\t-d Decimation factor [Default %d]\n", decim);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "sidv")) != -1) {
+    switch (opt) {
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'i':
+        interp = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        decim = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  srsran_resampler_poly_t up   = {};
+  srsran_resampler_poly_t down = {};
+  int                     ret  = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  uint32_t high_size = SRSRAN_CEIL(buffer_size * interp, decim) + 1;
+  cf_t*    src       = srsran_vec_cf_malloc(buffer_size);
+  cf_t*    high      = srsran_vec_cf_malloc(high_size);
+  cf_t*    high_ref  = srsran_vec_cf_malloc(high_size);
+  cf_t*    recovered = srsran_vec_cf_malloc(buffer_size + 1);
+  if (src == NULL || high == NULL || high_ref == NULL || recovered == NULL) {
+    goto clean_exit;
+  }
+
+  if (srsran_resampler_poly_init(&up, interp, decim) || srsran_resampler_poly_init(&down, decim, interp)) {
+    goto clean_exit;
+  }
+
+  // Low frequency complex exponential, well inside the pass band
+  const float freq = 0.01f;
+  for (uint32_t i = 0; i < buffer_size; i++) {
+    src[i] = cexpf(I * 2.0f * (float)M_PI * freq * i);
+  }
+
+  // Resample the whole buffer in one go
+  uint32_t expected_high = srsran_resampler_poly_get_nof_output(&up, buffer_size);
+  uint32_t nof_high      = srsran_resampler_poly_run(&up, src, high_ref, buffer_size);
+  if (nof_high != expected_high) {
+    ERROR("Number of output samples %d does not match the expected %d", nof_high, expected_high);
+    goto clean_exit;
+  }
+
+  // Resampling in uneven chunks must give the same result, as the state and the phase carry over between calls
+  srsran_resampler_poly_reset_state(&up);
+  uint32_t count = 0;
+  uint32_t chunk = 1;
+  for (uint32_t i = 0; i < buffer_size; i += chunk, chunk = (chunk * 7 + 3) % 97 + 1) {
+    uint32_t n        = SRSRAN_MIN(chunk, buffer_size - i);
+    uint32_t expected = srsran_resampler_poly_get_nof_output(&up, n);
+    uint32_t nof_out  = srsran_resampler_poly_run(&up, &src[i], &high[count], n);
+    if (nof_out != expected) {
+      ERROR("Number of output samples %d does not match the expected %d", nof_out, expected);
+      goto clean_exit;
+    }
+    count += nof_out;
+  }
+  if (count != nof_high) {
+    ERROR("Chunked resampling produced %d samples instead of %d", count, nof_high);
+    goto clean_exit;
+  }
+  srsran_vec_sub_ccc(high, high_ref, high_ref, nof_high);
+  float chunk_err = sqrtf(srsran_vec_avg_power_cf(high_ref, nof_high));
+
+  // Resample back to the original rate, and compare with the delayed input once both filters have been filled
+  uint32_t nof_rec = srsran_resampler_poly_run(&down, high, recovered, nof_high);
+  float    delay   = srsran_resampler_poly_get_delay(&up) * (float)up.decim / (float)up.interp +
+                srsran_resampler_poly_get_delay(&down);
+  uint32_t start = (uint32_t)ceilf(2.0f * delay) + 1;
+  uint32_t len   = SRSRAN_MIN(nof_rec, buffer_size) - start;
+  for (uint32_t i = 0; i < len; i++) {
+    recovered[i] = recovered[start + i] - cexpf(I * 2.0f * (float)M_PI * freq * ((float)(start + i) - delay));
+  }
+  float mse = sqrtf(srsran_vec_avg_power_cf(recovered, len));
+
+  printf("Ratio %d/%d; delay: %.2f samples; chunk error: %.2e; MSE: %.6f\n", interp, decim, delay, chunk_err, mse);
+
+  ret = (chunk_err < 1e-6f && mse < 1e-3f) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+
+clean_exit:
+  srsran_resampler_poly_free(&up);
+  srsran_resampler_poly_free(&down);
+  if (src) {
+    free(src);
+  }
+  if (high) {
+    free(high);
+  }
+  if (high_ref) {
+    free(high_ref);
+  }
+  if (recovered) {
+    free(recovered);
+  }
+
+  return ret;
+}
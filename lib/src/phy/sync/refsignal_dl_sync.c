@@ -88,11 +88,21 @@ static inline void refsignal_sf_prepare_correlation(srsran_refsignal_dl_sync_t*
   srsran_dft_run_c(&q->conv_fft_cc.filter_plan, ptr_filt, ptr_filt);
 }
 
-static inline void
-refsignal_sf_correlate(srsran_refsignal_dl_sync_t* q, cf_t* ptr_in, float* peak_value, uint32_t* peak_idx, float* rms)
+static inline void refsignal_sf_correlate(srsran_refsignal_dl_sync_t* q,
+                                          cf_t*                       ptr_in,
+                                          const cf_t*                 ptr_in_fft,
+                                          float*                      peak_value,
+                                          uint32_t*                   peak_idx,
+                                          float*                      rms)
 {
-  // Correlate
-  srsran_corr_fft_cc_run_opt(&q->conv_fft_cc, ptr_in, q->conv_fft_cc.filter_fft, q->correlation);
+  // Correlate, reusing the input spectrum if available
+  if (ptr_in_fft) {
+    srsran_conv_fft_cc_t* conv = &q->conv_fft_cc;
+    srsran_vec_prod_conj_ccc(ptr_in_fft, conv->filter_fft, conv->output_fft, conv->output_len);
+    srsran_dft_run_c(&conv->output_plan, conv->output_fft, q->correlation);
+  } else {
+    srsran_corr_fft_cc_run_opt(&q->conv_fft_cc, ptr_in, q->conv_fft_cc.filter_fft, q->correlation);
+  }
 
   // Find maximum, calculate RMS and peak
   uint32_t imax = srsran_vec_max_abs_ci(q->correlation, q->ifft.sf_sz);
@@ -309,7 +319,10 @@ void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q)
   }
 }
 
-int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t*                q,
+                                const srsran_refsignal_dl_sync_spectrum_t* spectrum,
+                                cf_t*                                      buffer,
+                                uint32_t                                   nsamples)
 {
   int   ret        = SRSRAN_ERROR;
   float peak_value = 0.0f;
@@ -321,16 +334,27 @@ int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uin
     return SRSRAN_ERROR;
   }
 
+  // The shared spectrum is only valid if it was computed with the same window length
+  if (spectrum != NULL && spectrum->sf_len != sf_len) {
+    spectrum = NULL;
+  }
+
   // Load correlation sequence and convert to frequency domain
   refsignal_sf_prepare_correlation(q);
 
   // Correlation
-  for (uint32_t n = 0; n + q->conv_fft_cc.filter_len < nsamples; n += q->conv_fft_cc.input_len) {
+  uint32_t w = 0;
+  for (uint32_t n = 0; n + q->conv_fft_cc.filter_len < nsamples; n += q->conv_fft_cc.input_len, w++) {
+    const cf_t* in_fft = NULL;
+    if (spectrum != NULL && w < spectrum->nof_windows) {
+      in_fft = &spectrum->fft[w * q->conv_fft_cc.output_len];
+    }
+
     // Correlate, find maximum, calculate RMS and peak
     uint32_t imax = 0;
     float    peak = 0.0f;
     float    rms  = 0.0f;
-    refsignal_sf_correlate(q, &buffer[n], &peak, &imax, &rms);
+    refsignal_sf_correlate(q, &buffer[n], in_fft, &peak, &imax, &rms);
 
     rms_avg += rms;
 
@@ -377,6 +401,14 @@ int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uin
 }
 
 int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  return srsran_refsignal_dl_sync_run_spectrum(q, NULL, buffer, nsamples);
+}
+
+int srsran_refsignal_dl_sync_run_spectrum(srsran_refsignal_dl_sync_t*                q,
+                                          const srsran_refsignal_dl_sync_spectrum_t* spectrum,
+                                          cf_t*                                      buffer,
+                                          uint32_t                                   nsamples)
 {
   if (q == NULL || buffer == NULL) {
     return SRSRAN_ERROR_INVALID_INPUTS;
@@ -396,7 +428,7 @@ int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, ui
   bool     false_alarm            = false;
 
   // Stage 1: find peak
-  int peak_idx = refsignal_dl_sync_find_peak(q, buffer, nsamples);
+  int peak_idx = refsignal_dl_sync_find_peak(q, spectrum, buffer, nsamples);
 
   // Stage 2: Proccess subframes
   if (peak_idx >= 0) {
@@ -526,6 +558,71 @@ int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, ui
   return SRSRAN_SUCCESS;
 }
 
+int srsran_refsignal_dl_sync_spectrum_init(srsran_refsignal_dl_sync_spectrum_t* q, uint32_t max_nsamples)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_refsignal_dl_sync_spectrum_t));
+  q->max_nsamples = max_nsamples;
+
+  // Every window spans two subframes and starts one subframe after the previous
+  q->fft = srsran_vec_cf_malloc(2 * max_nsamples);
+  if (q->fft == NULL) {
+    perror("Allocating spectrum\n");
+    return SRSRAN_ERROR;
+  }
+
+  // Same length and normalisation as the input plan of the correlation
+  if (srsran_dft_plan(&q->plan, 2 * SRSRAN_SF_LEN_MAX, SRSRAN_DFT_FORWARD, SRSRAN_DFT_COMPLEX)) {
+    ERROR("Error initiating spectrum plan");
+    return SRSRAN_ERROR;
+  }
+  srsran_dft_plan_set_norm(&q->plan, true);
+  q->sf_len = SRSRAN_SF_LEN_MAX;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_refsignal_dl_sync_spectrum_free(srsran_refsignal_dl_sync_spectrum_t* q)
+{
+  if (q) {
+    if (q->fft) {
+      free(q->fft);
+    }
+    srsran_dft_plan_free(&q->plan);
+    memset(q, 0, sizeof(srsran_refsignal_dl_sync_spectrum_t));
+  }
+}
+
+int srsran_refsignal_dl_sync_spectrum_compute(srsran_refsignal_dl_sync_spectrum_t* q,
+                                              uint32_t                             sf_len,
+                                              const cf_t*                          buffer,
+                                              uint32_t                             nsamples)
+{
+  if (q == NULL || buffer == NULL || sf_len == 0 || sf_len > SRSRAN_SF_LEN_MAX || nsamples > q->max_nsamples) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->sf_len != sf_len) {
+    if (srsran_dft_replan(&q->plan, 2 * sf_len)) {
+      ERROR("Error replanning spectrum");
+      return SRSRAN_ERROR;
+    }
+    q->sf_len = sf_len;
+  }
+
+  // Same windows as the correlation in refsignal_dl_sync_find_peak()
+  q->nof_windows = 0;
+  for (uint32_t n = 0; n + sf_len < nsamples; n += sf_len) {
+    srsran_dft_run_c(&q->plan, &buffer[n], &q->fft[q->nof_windows * 2 * sf_len]);
+    q->nof_windows++;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_refsignal_dl_sync_measure_sf(srsran_refsignal_dl_sync_t* q,
                                          cf_t*                       buffer,
                                          uint32_t                    sf_idx,
@@ -0,0 +1,288 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/dft/ofdm.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/sync/pss.h"
+#include "srsran/phy/sync/sss.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define NOF_PRB 6
+#define SF_LEN SRSRAN_SF_LEN_PRB(NOF_PRB)
+
+static double   srate_hz    = 11.52e6;
+static uint32_t nof_threads = 4;
+static uint32_t nof_sf      = 40;
+static float    snr_dB      = 0.0f;
+
+/* Cells transmitted in the capture, the last carrier is searched but it is empty */
+static const struct {
+  uint32_t pci;
+  double   freq_offset_hz;
+  uint32_t delay;
+} cells[] = {{101, -3.0e6, 0}, {302, 0.0, 3517}, {17, 2.4e6, 8123}};
+static const double empty_freq_offset_hz = 4.0e6;
+
+#define NOF_CELLS (sizeof(cells) / sizeof(cells[0]))
+#define NOF_CARRIERS (NOF_CELLS + 1)
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sntSv]\n", prog);
+  printf("\t-s Capture sampling rate in Hz [Default %.2f MHz]\n", srate_hz / 1e6);
+  printf("\t-n Number of subframes [Default %d]\n", nof_sf);
+  printf("\t-t Number of search threads [Default %d]\n", nof_threads);
+  printf("\t-S SNR of the synchronization signals in dB [Default %.1f]\n", snr_dB);
+  printf("\t-v increase verbosity\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "sntSv")) != -1) {
+    switch (opt) {
+      case 's':
+        srate_hz = strtod(argv[optind], NULL);
+        break;
+      case 'n':
+        nof_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'S':
+        snr_dB = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Generates a 6 PRB signal at 1.92 MHz that carries only the PSS and SSS of a cell */
+static int gen_sync_signals(uint32_t pci, cf_t* output, uint32_t nof_samples)
+{
+  srsran_ofdm_t ifft = {};
+  cf_t          pss[SRSRAN_PSS_LEN];
+  float         sss0[SRSRAN_SSS_LEN];
+  float         sss5[SRSRAN_SSS_LEN];
+  cf_t*         grid      = srsran_vec_cf_malloc(SF_LEN);
+  cf_t*         sf_buffer = srsran_vec_cf_malloc(SF_LEN);
+  int           ret       = SRSRAN_ERROR;
+
+  if (grid == NULL || sf_buffer == NULL) {
+    goto clean_exit;
+  }
+
+  if (srsran_ofdm_tx_init(&ifft, SRSRAN_CP_NORM, grid, sf_buffer, NOF_PRB)) {
+    ERROR("Error creating iFFT object");
+    goto clean_exit;
+  }
+
+  srsran_pss_generate(pss, pci % SRSRAN_NOF_NID_2);
+  srsran_sss_generate(sss0, sss5, pci);
+
+  for (uint32_t i = 0; i < nof_samples; i += SF_LEN) {
+    uint32_t sf_idx = (i / SF_LEN) % SRSRAN_NOF_SF_X_FRAME;
+
+    srsran_vec_cf_zero(grid, SF_LEN);
+    if (sf_idx == 0 || sf_idx == 5) {
+      srsran_pss_put_slot(pss, grid, NOF_PRB, SRSRAN_CP_NORM);
+      srsran_sss_put_slot(sf_idx == 0 ? sss0 : sss5, grid, NOF_PRB, SRSRAN_CP_NORM);
+    }
+    srsran_ofdm_tx_sf(&ifft);
+
+    srsran_vec_cf_copy(&output[i], sf_buffer, SRSRAN_MIN(SF_LEN, nof_samples - i));
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ofdm_tx_free(&ifft);
+  if (grid) {
+    free(grid);
+  }
+  if (sf_buffer) {
+    free(sf_buffer);
+  }
+  return ret;
+}
+
+/* Generates the wideband capture with every cell at its frequency offset and delay */
+static int gen_capture(cf_t* capture, uint32_t nof_samples)
+{
+  srsran_resampler_poly_t interp = {};
+  srsran_channel_awgn_t   awgn   = {};
+  uint32_t                nof_nb = nof_sf * SF_LEN;
+  cf_t*                   nb     = srsran_vec_cf_malloc(nof_nb);
+  cf_t*                   wb     = srsran_vec_cf_malloc(nof_samples + 1);
+  int                     ret    = SRSRAN_ERROR;
+
+  if (nb == NULL || wb == NULL) {
+    goto clean_exit;
+  }
+
+  if (srsran_resampler_poly_init(&interp, (uint32_t)srate_hz, (uint32_t)SRSRAN_CS_SAMP_FREQ)) {
+    goto clean_exit;
+  }
+
+  srsran_vec_cf_zero(capture, nof_samples);
+  for (uint32_t c = 0; c < NOF_CELLS; c++) {
+    // Each cell has its own frame timing
+    srsran_vec_cf_zero(nb, cells[c].delay);
+    if (gen_sync_signals(cells[c].pci, &nb[cells[c].delay], nof_nb - cells[c].delay)) {
+      goto clean_exit;
+    }
+
+    // Interpolate to the capture rate and shift to the carrier frequency
+    srsran_resampler_poly_reset_state(&interp);
+    uint32_t n = srsran_resampler_poly_run(&interp, nb, wb, nof_nb);
+    srsran_vec_apply_cfo(wb, (float)(cells[c].freq_offset_hz / srate_hz), wb, SRSRAN_MIN(n, nof_samples));
+    srsran_vec_sum_ccc(capture, wb, capture, SRSRAN_MIN(n, nof_samples));
+  }
+
+  // Power of a PSS symbol, all the cells have the same. The SNR is given in the 1.92 MHz band the cells are searched
+  // in, so the noise power over the whole capture band is larger by the oversampling factor
+  uint32_t symbol_sz = SRSRAN_SYMBOL_SZ(srsran_symbol_sz(NOF_PRB), SRSRAN_CP_NORM);
+  float    pss_pow   = srsran_vec_avg_power_cf(nb, nof_nb) * (float)(SF_LEN * 5) / (2.0f * symbol_sz);
+  pss_pow *= (float)srate_hz / (float)SRSRAN_CS_SAMP_FREQ;
+
+  if (srsran_channel_awgn_init(&awgn, 1234)) {
+    goto clean_exit;
+  }
+  srsran_channel_awgn_set_n0(&awgn, srsran_convert_power_to_dB(pss_pow) - snr_dB);
+  srsran_channel_awgn_run_c(&awgn, capture, capture, nof_samples);
+  srsran_channel_awgn_free(&awgn);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_resampler_poly_free(&interp);
+  if (nb) {
+    free(nb);
+  }
+  if (wb) {
+    free(wb);
+  }
+  return ret;
+}
+
+static int run_search(uint32_t                          threads,
+                      const cf_t*                       capture,
+                      uint32_t                          nof_samples,
+                      const double*                     freq_offset_hz,
+                      srsran_ue_cellsearch_wb_result_t* results)
+{
+  srsran_ue_cellsearch_wb_t      cs   = {};
+  srsran_ue_cellsearch_wb_args_t args = {};
+  struct timeval                 t[3] = {};
+
+  args.srate_hz     = srate_hz;
+  args.max_nsamples = nof_samples;
+  args.nof_threads  = threads;
+  if (srsran_ue_cellsearch_wb_init(&cs, &args)) {
+    ERROR("Error initialising wideband cell search");
+    return SRSRAN_ERROR;
+  }
+
+  gettimeofday(&t[1], NULL);
+  int n = srsran_ue_cellsearch_wb_scan(&cs, capture, nof_samples, freq_offset_hz, NOF_CARRIERS, results);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  printf("Searched %d carriers in %.1f ms with %d threads, found %d cells\n",
+         (uint32_t)NOF_CARRIERS,
+         (t[0].tv_sec * 1e6 + t[0].tv_usec) / 1e3,
+         SRSRAN_MAX(1, threads),
+         n);
+
+  srsran_ue_cellsearch_wb_free(&cs);
+  return n;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_ue_cellsearch_wb_result_t results_serial[SRSRAN_CS_WB_MAX_CARRIERS]   = {};
+  srsran_ue_cellsearch_wb_result_t results_parallel[SRSRAN_CS_WB_MAX_CARRIERS] = {};
+  double                           freq_offset_hz[SRSRAN_CS_WB_MAX_CARRIERS]   = {};
+  int                              ret                                         = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  uint32_t nof_samples = (uint32_t)((double)nof_sf * SF_LEN * srate_hz / SRSRAN_CS_SAMP_FREQ);
+  cf_t*    capture     = srsran_vec_cf_malloc(nof_samples);
+  if (capture == NULL || gen_capture(capture, nof_samples)) {
+    goto clean_exit;
+  }
+
+  for (uint32_t c = 0; c < NOF_CELLS; c++) {
+    freq_offset_hz[c] = cells[c].freq_offset_hz;
+  }
+  freq_offset_hz[NOF_CELLS] = empty_freq_offset_hz;
+
+  // The parallel search shall give exactly the same results as the search in the caller thread
+  int n_serial   = run_search(1, capture, nof_samples, freq_offset_hz, results_serial);
+  int n_parallel = run_search(nof_threads, capture, nof_samples, freq_offset_hz, results_parallel);
+  if (n_serial != (int)NOF_CELLS || n_parallel != n_serial ||
+      memcmp(results_serial, results_parallel, sizeof(srsran_ue_cellsearch_wb_result_t) * NOF_CARRIERS) != 0) {
+    ERROR("Serial and parallel searches found %d and %d cells, expected %d", n_serial, n_parallel, (int)NOF_CELLS);
+    goto clean_exit;
+  }
+
+  for (uint32_t c = 0; c < NOF_CARRIERS; c++) {
+    const srsran_ue_cellsearch_wb_result_t* r = &results_parallel[c];
+    if (r->nof_cells == 0) {
+      printf("Carrier %+.2f MHz: no cell\n", freq_offset_hz[c] / 1e6);
+      continue;
+    }
+    printf("Carrier %+.2f MHz: PCI=%d; PSR=%.2f; frames=%d; CFO=%+.1f Hz\n",
+           freq_offset_hz[c] / 1e6,
+           r->cells[r->max_N_id_2].cell_id,
+           r->cells[r->max_N_id_2].psr,
+           r->nof_detected[r->max_N_id_2],
+           r->cells[r->max_N_id_2].cfo);
+    if (c >= NOF_CELLS || r->cells[r->max_N_id_2].cell_id != cells[c].pci) {
+      ERROR("Wrong cell detected in carrier %d", c);
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (capture) {
+    free(capture);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
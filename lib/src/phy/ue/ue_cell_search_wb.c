@@ -0,0 +1,466 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/sync/sync.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <string.h>
+
+#define CS_WB_FFT_SIZE 128
+#define CS_WB_SF_LEN SRSRAN_SF_LEN(CS_WB_FFT_SIZE)
+#define CS_WB_FRAME_LEN (5 * CS_WB_SF_LEN)
+
+/* PSS peak threshold, the same ue_sync uses for searching cells */
+#define CS_WB_THRESHOLD 2.0f
+
+/* Number of wideband samples shifted to baseband at once, it keeps the mixer phase error negligible */
+#define CS_WB_MIX_LEN 1920
+
+typedef enum {
+  CS_WB_STAGE_MIX = 0, ///< Shift a carrier to baseband and decimate it
+  CS_WB_STAGE_DETECT,  ///< Detect PSS/SSS for a carrier and N_id_2 pair
+} cs_wb_stage_t;
+
+struct cs_wb_pool_s;
+
+/**
+ * @brief Search worker, it owns the objects that keep state between calls: the decimator and the PSS/SSS detector
+ */
+typedef struct {
+  struct cs_wb_pool_s*    pool;
+  srsran_resampler_poly_t decimator;
+  srsran_sync_t           sync;
+  cf_t*                   mix_buffer;
+  uint32_t                nid1_count[SRSRAN_NOF_NID_1];
+  uint32_t                nid1_fdd[SRSRAN_NOF_NID_1];
+  pthread_t               pthread;
+  sem_t                   start;
+  bool                    started;
+  bool                    quit;
+} cs_wb_worker_t;
+
+typedef struct cs_wb_pool_s {
+  srsran_ue_cellsearch_wb_t* q;
+  cs_wb_worker_t*            workers;
+  uint32_t                   nof_workers;
+
+  /* Job description: it must be set before posting start semaphores */
+  cs_wb_stage_t                     stage;
+  const cf_t*                       input;
+  uint32_t                          nsamples;
+  uint32_t                          nb_nsamples;
+  uint32_t                          min_nof_frames;
+  const double*                     freq_offset_hz;
+  srsran_ue_cellsearch_wb_result_t* results;
+  uint32_t                          nof_jobs;
+
+  /* Next job to claim, protected by mutex */
+  uint32_t        next_job;
+  pthread_mutex_t mutex;
+
+  /* Posted by every thread once there are no jobs left */
+  sem_t finish;
+} cs_wb_pool_t;
+
+static void cs_wb_mix(cs_wb_worker_t* w, uint32_t carrier)
+{
+  cs_wb_pool_t*              pool  = w->pool;
+  srsran_ue_cellsearch_wb_t* q     = pool->q;
+  double                     freq  = -pool->freq_offset_hz[carrier] / q->args.srate_hz;
+  cf_t*                      out   = q->nb_buffer[carrier];
+  uint32_t                   count = 0;
+
+  srsran_resampler_poly_reset_state(&w->decimator);
+
+  for (uint32_t i = 0; i < pool->nsamples; i += CS_WB_MIX_LEN) {
+    uint32_t len = SRSRAN_MIN(CS_WB_MIX_LEN, pool->nsamples - i);
+
+    // The oscillator restarts in every block, so rotate it to the phase of the first sample
+    double phase = freq * i - floor(freq * i);
+    srsran_vec_apply_cfo(&pool->input[i], (float)freq, w->mix_buffer, len);
+    srsran_vec_sc_prod_ccc(w->mix_buffer, cexpf(_Complex_I * 2.0f * (float)M_PI * (float)phase), w->mix_buffer, len);
+
+    count += srsran_resampler_poly_run(&w->decimator, w->mix_buffer, &out[count], len);
+  }
+}
+
+static void cs_wb_detect(cs_wb_worker_t* w, uint32_t carrier, uint32_t N_id_2)
+{
+  cs_wb_pool_t*                  pool         = w->pool;
+  const cf_t*                    input        = pool->q->nb_buffer[carrier];
+  srsran_ue_cellsearch_result_t* result       = &pool->results[carrier].cells[N_id_2];
+  srsran_sync_t*                 sync         = &w->sync;
+  uint32_t                       nof_detected = 0;
+  float                          peak_sum     = 0.0f;
+
+  srsran_sync_set_N_id_2(sync, N_id_2);
+  srsran_sync_reset(sync);
+  srsran_sync_cfo_reset(sync, 0.0f);
+  memset(w->nid1_count, 0, sizeof(w->nid1_count));
+  memset(w->nid1_fdd, 0, sizeof(w->nid1_fdd));
+
+  // Every window holds one PSS, the SSS is found in the samples before it even if they belong to the previous window
+  for (uint32_t offset = 0; offset + CS_WB_FRAME_LEN <= pool->nb_nsamples; offset += CS_WB_FRAME_LEN) {
+    uint32_t peak_pos = 0;
+    if (srsran_sync_find(sync, input, offset, &peak_pos) != SRSRAN_SYNC_FOUND || !srsran_sync_sss_detected(sync)) {
+      continue;
+    }
+
+    int cell_id = srsran_sync_get_cell_id(sync);
+    if (cell_id < 0) {
+      continue;
+    }
+
+    uint32_t N_id_1 = (uint32_t)cell_id / SRSRAN_NOF_NID_2;
+    w->nid1_count[N_id_1]++;
+    if (sync->frame_type == SRSRAN_FDD) {
+      w->nid1_fdd[N_id_1]++;
+    }
+    peak_sum += srsran_sync_get_peak_value(sync);
+    nof_detected++;
+  }
+
+  // Sporadic PSS correlation peaks from noise or the neighbour carriers are not reported
+  pool->results[carrier].nof_detected[N_id_2] = nof_detected;
+  if (nof_detected == 0 || nof_detected < pool->min_nof_frames) {
+    return;
+  }
+
+  // Report the most frequent cell identity, as srsran_ue_cellsearch_scan() does
+  uint32_t N_id_1 = 0;
+  for (uint32_t i = 1; i < SRSRAN_NOF_NID_1; i++) {
+    if (w->nid1_count[i] > w->nid1_count[N_id_1]) {
+      N_id_1 = i;
+    }
+  }
+
+  result->cell_id    = N_id_1 * SRSRAN_NOF_NID_2 + N_id_2;
+  result->cp         = SRSRAN_CP_NORM;
+  result->frame_type = (w->nid1_fdd[N_id_1] > w->nid1_count[N_id_1] / 2) ? SRSRAN_FDD : SRSRAN_TDD;
+  result->peak       = peak_sum / nof_detected;
+  result->psr        = result->peak;
+  result->mode       = (float)w->nid1_count[N_id_1] / nof_detected;
+  result->cfo        = 15000 * srsran_sync_get_cfo(sync);
+}
+
+/**
+ * @brief Claims and runs jobs of the current stage until there are none left
+ */
+static void cs_wb_pool_run(cs_wb_worker_t* w)
+{
+  cs_wb_pool_t* pool = w->pool;
+
+  for (;;) {
+    pthread_mutex_lock(&pool->mutex);
+    uint32_t idx = pool->next_job++;
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (idx >= pool->nof_jobs) {
+      return;
+    }
+
+    if (pool->stage == CS_WB_STAGE_MIX) {
+      cs_wb_mix(w, idx);
+    } else {
+      cs_wb_detect(w, idx / SRSRAN_NOF_NID_2, idx % SRSRAN_NOF_NID_2);
+    }
+  }
+}
+
+static void* cs_wb_thread(void* arg)
+{
+  cs_wb_worker_t* w = (cs_wb_worker_t*)arg;
+
+  sem_wait(&w->start);
+  while (!w->quit) {
+    cs_wb_pool_run(w);
+
+    /* Post finish semaphore */
+    sem_post(&w->pool->finish);
+
+    /* Wait for next stage */
+    sem_wait(&w->start);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Runs a stage, sharing its jobs between the caller thread and the worker threads
+ */
+static void cs_wb_pool_stage(cs_wb_pool_t* pool, cs_wb_stage_t stage, uint32_t nof_jobs)
+{
+  pool->stage    = stage;
+  pool->nof_jobs = nof_jobs;
+  pool->next_job = 0;
+
+  // Wake up only as many threads as jobs are left for them, the first worker is the caller thread
+  uint32_t nof_threads = SRSRAN_MIN(pool->nof_workers - 1, nof_jobs - 1);
+  for (uint32_t i = 1; i <= nof_threads; i++) {
+    sem_post(&pool->workers[i].start);
+  }
+
+  cs_wb_pool_run(&pool->workers[0]);
+
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    sem_wait(&pool->finish);
+  }
+}
+
+static int cs_wb_worker_init(srsran_ue_cellsearch_wb_t* q, cs_wb_worker_t* w)
+{
+  if (srsran_resampler_poly_init(&w->decimator, (uint32_t)SRSRAN_CS_SAMP_FREQ, (uint32_t)q->args.srate_hz)) {
+    ERROR("Error initialising decimator for %.2f MHz", q->args.srate_hz / 1e6);
+    return SRSRAN_ERROR;
+  }
+
+  w->mix_buffer = srsran_vec_cf_malloc(CS_WB_MIX_LEN);
+  if (w->mix_buffer == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_sync_init(&w->sync, CS_WB_FRAME_LEN, CS_WB_FRAME_LEN, CS_WB_FFT_SIZE)) {
+    ERROR("Error initialising PSS/SSS detector");
+    return SRSRAN_ERROR;
+  }
+
+  // Same detector configuration as the ue_sync find state while searching cells
+  srsran_sync_set_cfo_i_enable(&w->sync, false);
+  srsran_sync_set_cfo_pss_enable(&w->sync, true);
+  srsran_sync_set_pss_filt_enable(&w->sync, true);
+  srsran_sync_set_sss_eq_enable(&w->sync, false);
+  srsran_sync_cp_en(&w->sync, false);
+  srsran_sync_sss_en(&w->sync, true);
+  srsran_sync_set_cp(&w->sync, SRSRAN_CP_NORM);
+  srsran_sync_set_em_alpha(&w->sync, 1);
+  srsran_sync_set_threshold(&w->sync, CS_WB_THRESHOLD);
+  srsran_sync_set_cfo_ema_alpha(&w->sync, 0.1);
+
+  return SRSRAN_SUCCESS;
+}
+
+static void cs_wb_pool_free(srsran_ue_cellsearch_wb_t* q)
+{
+  cs_wb_pool_t* pool = (cs_wb_pool_t*)q->pool;
+  if (pool == NULL) {
+    return;
+  }
+
+  if (pool->workers) {
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      cs_wb_worker_t* w = &pool->workers[i];
+
+      /* Stop threads */
+      if (w->started) {
+        w->quit = true;
+        sem_post(&w->start);
+        pthread_join(w->pthread, NULL);
+      }
+      sem_destroy(&w->start);
+      srsran_sync_free(&w->sync);
+      srsran_resampler_poly_free(&w->decimator);
+      if (w->mix_buffer) {
+        free(w->mix_buffer);
+      }
+    }
+    free(pool->workers);
+  }
+
+  sem_destroy(&pool->finish);
+  pthread_mutex_destroy(&pool->mutex);
+  free(pool);
+
+  q->pool = NULL;
+}
+
+static int cs_wb_pool_init(srsran_ue_cellsearch_wb_t* q)
+{
+  uint32_t nof_workers = SRSRAN_MAX(1, q->args.nof_threads);
+
+  cs_wb_pool_t* pool = SRSRAN_MEM_ALLOC(cs_wb_pool_t, 1);
+  if (pool == NULL) {
+    ERROR("Error: calloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool, cs_wb_pool_t, 1);
+  pool->q = q;
+  q->pool = pool;
+
+  if (pthread_mutex_init(&pool->mutex, NULL) || sem_init(&pool->finish, 0, 0)) {
+    ERROR("Error creating search pool synchronization");
+    free(pool);
+    q->pool = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  pool->workers = SRSRAN_MEM_ALLOC(cs_wb_worker_t, nof_workers);
+  if (pool->workers == NULL) {
+    ERROR("Error: calloc");
+    cs_wb_pool_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool->workers, cs_wb_worker_t, nof_workers);
+
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    cs_wb_worker_t* w = &pool->workers[i];
+    w->pool           = pool;
+
+    if (sem_init(&w->start, 0, 0)) {
+      ERROR("Error creating semaphore");
+      cs_wb_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+    pool->nof_workers++;
+
+    if (cs_wb_worker_init(q, w) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising cell search worker %d", i);
+      cs_wb_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    // The first worker runs in the caller thread
+    if (i > 0) {
+      if (pthread_create(&w->pthread, NULL, cs_wb_thread, w)) {
+        ERROR("Error creating cell search thread %d", i);
+        cs_wb_pool_free(q);
+        return SRSRAN_ERROR;
+      }
+      w->started = true;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t* q, const srsran_ue_cellsearch_wb_args_t* args)
+{
+  if (q == NULL || args == NULL || !isnormal(args->srate_hz) || args->max_nsamples == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ue_cellsearch_wb_t, 1);
+  q->args = *args;
+
+  if (cs_wb_pool_init(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // All the workers decimate with the same ratio, so any of them gives the baseband buffer size
+  cs_wb_pool_t* pool = (cs_wb_pool_t*)q->pool;
+  q->nb_max_nsamples = srsran_resampler_poly_get_nof_output(&pool->workers[0].decimator, args->max_nsamples);
+
+  for (uint32_t i = 0; i < SRSRAN_CS_WB_MAX_CARRIERS; i++) {
+    q->nb_buffer[i] = srsran_vec_cf_malloc(q->nb_max_nsamples);
+    if (q->nb_buffer[i] == NULL) {
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  cs_wb_pool_free(q);
+
+  for (uint32_t i = 0; i < SRSRAN_CS_WB_MAX_CARRIERS; i++) {
+    if (q->nb_buffer[i]) {
+      free(q->nb_buffer[i]);
+    }
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ue_cellsearch_wb_t, 1);
+}
+
+int srsran_ue_cellsearch_wb_scan(srsran_ue_cellsearch_wb_t*        q,
+                                 const cf_t*                       input,
+                                 uint32_t                          nsamples,
+                                 const double*                     freq_offset_hz,
+                                 uint32_t                          nof_carriers,
+                                 srsran_ue_cellsearch_wb_result_t* results)
+{
+  if (q == NULL || q->pool == NULL || input == NULL || freq_offset_hz == NULL || results == NULL ||
+      nsamples > q->args.max_nsamples || nof_carriers > SRSRAN_CS_WB_MAX_CARRIERS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (nof_carriers == 0) {
+    return 0;
+  }
+
+  cs_wb_pool_t* pool = (cs_wb_pool_t*)q->pool;
+  SRSRAN_MEM_ZERO(results, srsran_ue_cellsearch_wb_result_t, nof_carriers);
+
+  pool->input          = input;
+  pool->nsamples       = nsamples;
+  pool->freq_offset_hz = freq_offset_hz;
+  pool->results        = results;
+
+  // Shift every carrier to baseband and decimate. The ratio is fixed and every carrier starts from a reset decimator,
+  // so they all produce the same number of samples
+  pool->nb_nsamples    = srsran_resampler_poly_get_nof_output(&pool->workers[0].decimator, nsamples);
+  pool->min_nof_frames = q->args.min_nof_frames;
+  if (pool->min_nof_frames == 0) {
+    pool->min_nof_frames = SRSRAN_MAX(1, pool->nb_nsamples / CS_WB_FRAME_LEN / 2);
+  }
+  cs_wb_pool_stage(pool, CS_WB_STAGE_MIX, nof_carriers);
+
+  // Detect PSS/SSS for every carrier and N_id_2 hypothesis
+  cs_wb_pool_stage(pool, CS_WB_STAGE_DETECT, nof_carriers * SRSRAN_NOF_NID_2);
+
+  // Select the strongest cell of every carrier
+  int nof_found = 0;
+  for (uint32_t c = 0; c < nof_carriers; c++) {
+    srsran_ue_cellsearch_wb_result_t* r = &results[c];
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      if (r->nof_detected[N_id_2] == 0 || r->nof_detected[N_id_2] < pool->min_nof_frames) {
+        continue;
+      }
+      if (r->nof_cells == 0 || r->cells[N_id_2].peak > r->cells[r->max_N_id_2].peak) {
+        r->max_N_id_2 = N_id_2;
+      }
+      r->nof_cells++;
+    }
+
+    if (r->nof_cells > 0) {
+      INFO("CELL SEARCH WB: carrier %+.2f MHz: Found %d cells, strongest PCI=%d PSR=%.2f CFO=%.1f kHz",
+           freq_offset_hz[c] / 1e6,
+           r->nof_cells,
+           r->cells[r->max_N_id_2].cell_id,
+           r->cells[r->max_N_id_2].psr,
+           r->cells[r->max_N_id_2].cfo / 1000);
+      nof_found++;
+    }
+  }
+
+  return nof_found;
+}
@@ -111,10 +111,12 @@ int srsran_ue_dl_nr_init(srsran_ue_dl_nr_t* q, cf_t* input[SRSRAN_MAX_PORTS], co
     return SRSRAN_ERROR;
   }
 
-  q->pdcch_ce = SRSRAN_MEM_ALLOC(srsran_dmrs_pdcch_ce_t, 1);
-  if (q->pdcch_ce == NULL) {
-    ERROR("Error alloc");
-    return SRSRAN_ERROR;
+  for (uint32_t i = 0; i < SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR; i++) {
+    q->pdcch_ce[i] = SRSRAN_MEM_ALLOC(srsran_dmrs_pdcch_ce_t, 1);
+    if (q->pdcch_ce[i] == NULL) {
+      ERROR("Error alloc");
+      return SRSRAN_ERROR;
+    }
   }
 
   return SRSRAN_SUCCESS;
@@ -143,8 +145,10 @@ void srsran_ue_dl_nr_free(srsran_ue_dl_nr_t* q)
   }
   srsran_pdcch_nr_free(&q->pdcch);
 
-  if (q->pdcch_ce) {
-    free(q->pdcch_ce);
+  for (uint32_t i = 0; i < SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR; i++) {
+    if (q->pdcch_ce[i]) {
+      free(q->pdcch_ce[i]);
+    }
   }
 
   SRSRAN_MEM_ZERO(q, srsran_ue_dl_nr_t, 1);
@@ -236,10 +240,15 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
   }
 }
 
-static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
-                                  srsran_dci_msg_nr_t*   dci_msg,
-                                  srsran_pdcch_nr_res_t* pdcch_res,
-                                  uint32_t               coreset_id)
+/**
+ * @brief Measures a PDCCH candidate and extracts its channel estimates if it is worth decoding
+ * @return 1 if the candidate shall be decoded, 0 if it is discarded, SRSRAN_ERROR code otherwise
+ */
+static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*             q,
+                                  const srsran_dci_msg_nr_t*     dci_msg,
+                                  uint32_t                       coreset_id,
+                                  srsran_dmrs_pdcch_ce_t*        ce,
+                                  srsran_ue_dl_nr_pdcch_info_t** pdcch_info_ptr)
 {
   // Select debug information
   srsran_ue_dl_nr_pdcch_info_t* pdcch_info = NULL;
@@ -254,9 +263,24 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   pdcch_info->dci_ctx            = dci_msg->ctx;
   pdcch_info->nof_bits           = dci_msg->nof_bits;
   srsran_dmrs_pdcch_measure_t* m = &pdcch_info->measure;
+  *pdcch_info_ptr                = pdcch_info;
 
-  // Measures the PDCCH transmission DMRS
+  // Compare the EPRE with threshold before the full measurement, as most of the candidates are empty
   srsran_dci_location_t location = dci_msg->ctx.location;
+  if (srsran_dmrs_pdcch_get_epre(&q->dmrs_pdcch[coreset_id], &location, &m->epre_dBfs) < SRSRAN_SUCCESS) {
+    ERROR("Error getting EPRE location L=%d, ncce=%d", location.L, location.ncce);
+    return SRSRAN_ERROR;
+  }
+  if (!(m->epre_dBfs >= q->pdcch_dmrs_epre_thr)) {
+    INFO("Discarded PDCCH candidate L=%d;ncce=%d; EPRE is too weak (%.1f<%.1f);",
+         location.L,
+         location.ncce,
+         m->epre_dBfs,
+         q->pdcch_dmrs_epre_thr);
+    return 0;
+  }
+
+  // Measures the PDCCH transmission DMRS
   if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[coreset_id], &location, m) < SRSRAN_SUCCESS) {
     ERROR("Error getting measure location L=%d, ncce=%d", location.L, location.ncce);
     return SRSRAN_ERROR;
@@ -265,17 +289,7 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   // If measured correlation is invalid, early return
   if (!isnormal(m->norm_corr)) {
     INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", location.L, location.ncce);
-    return SRSRAN_SUCCESS;
-  }
-
-  // Compare EPRE with threshold
-  if (m->epre_dBfs < q->pdcch_dmrs_epre_thr) {
-    INFO("Discarded PDCCH candidate L=%d;ncce=%d; EPRE is too weak (%.1f<%.1f);",
-         location.L,
-         location.ncce,
-         m->epre_dBfs,
-         q->pdcch_dmrs_epre_thr);
-    return SRSRAN_SUCCESS;
+    return 0;
   }
 
   // Compare DMRS correlation with threshold
@@ -287,35 +301,16 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
          q->pdcch_dmrs_corr_thr,
          m->epre_dBfs,
          m->rsrp_dBfs);
-    return SRSRAN_SUCCESS;
+    return 0;
   }
 
   // Extract PDCCH channel estimates
-  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], &location, q->pdcch_ce) < SRSRAN_SUCCESS) {
+  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], &location, ce) < SRSRAN_SUCCESS) {
     ERROR("Error extracting PDCCH DMRS");
     return SRSRAN_ERROR;
   }
 
-  // Decode PDCCH
-  if (srsran_pdcch_nr_decode(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, dci_msg, pdcch_res) < SRSRAN_SUCCESS) {
-    ERROR("Error decoding PDCCH");
-    return SRSRAN_ERROR;
-  }
-
-#if 0
-  static uint32_t num_pdcch = 0;
-  char            tmpstr[64];
-  snprintf(tmpstr, 64, "pdcch_symbols%d.dat", num_pdcch);
-  printf("save %d syms to %s\n", q->pdcch.M / 4, tmpstr);
-  srsran_vec_save_file(tmpstr, q->pdcch.symbols, q->pdcch.M / 4 * sizeof(cf_t));
-  // srsran_vec_fprint_c(stdout, q->pdcch.symbols, q->pdcch.M/4);
-  num_pdcch++;
-#endif
-
-  // Save information
-  pdcch_info->result = *pdcch_res;
-
-  return SRSRAN_SUCCESS;
+  return 1;
 }
 
 static bool find_dci_msg(srsran_dci_msg_nr_t* dci_msg, uint32_t nof_dci_msg, srsran_dci_msg_nr_t* match)
@@ -334,6 +329,57 @@ static bool find_dci_msg(srsran_dci_msg_nr_t* dci_msg, uint32_t nof_dci_msg, srs
   return found;
 }
 
+/**
+ * @brief Saves a DCI message with valid CRC in the pending UL grant list or in the DL list
+ */
+static void ue_dl_nr_save_dci(srsran_ue_dl_nr_t* q, srsran_dci_msg_nr_t* dci_msg)
+{
+  // Detect if the DCI is the right direction
+  if (!srsran_dci_nr_valid_direction(dci_msg)) {
+    // Change grant format direction
+    switch (dci_msg->ctx.format) {
+      case srsran_dci_format_nr_0_0:
+        dci_msg->ctx.format = srsran_dci_format_nr_1_0;
+        break;
+      case srsran_dci_format_nr_0_1:
+        dci_msg->ctx.format = srsran_dci_format_nr_1_1;
+        break;
+      case srsran_dci_format_nr_1_0:
+        dci_msg->ctx.format = srsran_dci_format_nr_0_0;
+        break;
+      case srsran_dci_format_nr_1_1:
+        dci_msg->ctx.format = srsran_dci_format_nr_0_1;
+        break;
+      default:
+        return;
+    }
+  }
+
+  // If UL grant, enqueue in UL list
+  if (dci_msg->ctx.format == srsran_dci_format_nr_0_0 || dci_msg->ctx.format == srsran_dci_format_nr_0_1) {
+    // If the pending UL grant list is full or has the dci message, keep moving
+    if (q->ul_dci_count >= SRSRAN_MAX_DCI_MSG_NR || find_dci_msg(q->ul_dci_msg, q->ul_dci_count, dci_msg)) {
+      return;
+    }
+
+    // Save the grant in the pending UL grant list
+    q->ul_dci_msg[q->ul_dci_count] = *dci_msg;
+    q->ul_dci_count++;
+    return;
+  }
+
+  // Check if the grant exists already in the DL list
+  if (find_dci_msg(q->dl_dci_msg, q->dl_dci_msg_count, dci_msg)) {
+    // The same DCI is in the list, keep moving
+    return;
+  }
+
+  INFO("Found DCI in L=%d,ncce=%d", dci_msg->ctx.location.L, dci_msg->ctx.location.ncce);
+  // Append DCI message into the list
+  q->dl_dci_msg[q->dl_dci_msg_count] = *dci_msg;
+  q->dl_dci_msg_count++;
+}
+
 static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
                                 const srsran_slot_cfg_t*     slot_cfg,
                                 const srsran_search_space_t* search_space,
@@ -400,8 +446,11 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         return SRSRAN_ERROR;
       }
 
-      // Iterate over the candidates
-      for (int ncce_idx = 0; ncce_idx < nof_candidates && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; ncce_idx++) {
+      // Measure the candidates, keeping the ones worth decoding
+      srsran_dci_msg_nr_t           dci_msg[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]    = {};
+      srsran_ue_dl_nr_pdcch_info_t* pdcch_info[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+      uint32_t                      nof_decode                                            = 0;
+      for (int ncce_idx = 0; ncce_idx < nof_candidates; ncce_idx++) {
         // Build DCI context
         srsran_dci_ctx_t ctx = {};
         ctx.location.L       = L;
@@ -414,67 +463,33 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         ctx.format           = dci_format;
 
         // Build DCI message
-        srsran_dci_msg_nr_t dci_msg = {};
-        dci_msg.ctx                 = ctx;
-        dci_msg.nof_bits            = (uint32_t)dci_nof_bits;
+        dci_msg[nof_decode].ctx      = ctx;
+        dci_msg[nof_decode].nof_bits = (uint32_t)dci_nof_bits;
 
-        // Find and decode PDCCH transmission in the given ncce
-        srsran_pdcch_nr_res_t res = {};
-        if (ue_dl_nr_find_dci_ncce(q, &dci_msg, &res, coreset_id) < SRSRAN_SUCCESS) {
+        int ret = ue_dl_nr_find_dci_ncce(
+            q, &dci_msg[nof_decode], coreset_id, q->pdcch_ce[nof_decode], &pdcch_info[nof_decode]);
+        if (ret < SRSRAN_SUCCESS) {
           return SRSRAN_ERROR;
         }
-
-        // If the CRC was not match, move to next candidate
-        if (!res.crc) {
-          continue;
-        }
-
-        // Detect if the DCI is the right direction
-        if (!srsran_dci_nr_valid_direction(&dci_msg)) {
-          // Change grant format direction
-          switch (dci_msg.ctx.format) {
-            case srsran_dci_format_nr_0_0:
-              dci_msg.ctx.format = srsran_dci_format_nr_1_0;
-              break;
-            case srsran_dci_format_nr_0_1:
-              dci_msg.ctx.format = srsran_dci_format_nr_1_1;
-              break;
-            case srsran_dci_format_nr_1_0:
-              dci_msg.ctx.format = srsran_dci_format_nr_0_0;
-              break;
-            case srsran_dci_format_nr_1_1:
-              dci_msg.ctx.format = srsran_dci_format_nr_0_1;
-              break;
-            default:
-              continue;
-          }
+        if (ret > 0) {
+          nof_decode++;
         }
+      }
 
-        // If UL grant, enqueue in UL list
-        if (dci_msg.ctx.format == srsran_dci_format_nr_0_0 || dci_msg.ctx.format == srsran_dci_format_nr_0_1) {
-          // If the pending UL grant list is full or has the dci message, keep moving
-          if (q->ul_dci_count >= SRSRAN_MAX_DCI_MSG_NR || find_dci_msg(q->ul_dci_msg, q->ul_dci_count, &dci_msg)) {
-            continue;
-          }
-
-          // Save the grant in the pending UL grant list
-          q->ul_dci_msg[q->ul_dci_count] = dci_msg;
-          q->ul_dci_count++;
-
-          // Move to next candidate
-          continue;
-        }
+      // Decode the candidates at once, they share the DCI size and the aggregation level
+      srsran_pdcch_nr_res_t res[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+      if (srsran_pdcch_nr_decode_batch(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, dci_msg, res, nof_decode) <
+          SRSRAN_SUCCESS) {
+        ERROR("Error decoding PDCCH");
+        return SRSRAN_ERROR;
+      }
 
-        // Check if the grant exists already in the DL list
-        if (find_dci_msg(q->dl_dci_msg, q->dl_dci_msg_count, &dci_msg)) {
-          // The same DCI is in the list, keep moving
-          continue;
+      // Save the DCI messages in the order of the candidates
+      for (uint32_t i = 0; i < nof_decode; i++) {
+        pdcch_info[i]->result = res[i];
+        if (res[i].crc && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR) {
+          ue_dl_nr_save_dci(q, &dci_msg[i]);
         }
-
-        INFO("Found DCI in L=%d,ncce=%d", dci_msg.ctx.location.L, dci_msg.ctx.location.ncce);
-        // Append DCI message into the list
-        q->dl_dci_msg[q->dl_dci_msg_count] = dci_msg;
-        q->dl_dci_msg_count++;
       }
     }
   }
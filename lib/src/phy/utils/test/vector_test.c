@@ -20,6 +20,7 @@
  */
 
 #include "srsran/srsran.h"
+#include "srsran/phy/utils/simd.h"
 #include <srsran/phy/utils/random.h>
 
 bool zf_solver   = false;
@@ -57,10 +58,11 @@ static srsran_random_t random_h = NULL;
     strncpy(func_name, #X, 32);                                                                                        \
     CODE;                                                                                                              \
     passed = (mse < MAX_MSE);                                                                                          \
-    printf("%32s (%5d) ... %7.1f MSamp/s ... %3s Passed (%.6f)\n",                                                     \
+    printf("%32s (%5d) ... %7.1f MSamp/s ... %7.3f ns/samp ... %3s Passed (%.6f)\n",                                 \
            func_name,                                                                                                  \
            block_size,                                                                                                 \
            (double)block_size* nof_repetitions / *timing,                                                              \
+           *timing * 1000.0 / ((double)block_size * nof_repetitions),                                                  \
            passed ? "" : "Not",                                                                                        \
            mse);                                                                                                       \
     return passed;                                                                                                     \
@@ -79,6 +81,23 @@ static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
   }
 }
 
+static const char* simd_isa_name()
+{
+#if defined(LV_HAVE_AVX512)
+  return "AVX512";
+#elif defined(LV_HAVE_AVX2)
+  return "AVX2";
+#elif defined(LV_HAVE_AVX)
+  return "AVX";
+#elif defined(LV_HAVE_SSE)
+  return "SSE";
+#elif defined(HAVE_NEON)
+  return "NEON";
+#else
+  return "none";
+#endif
+}
+
 float squared_error(cf_t a, cf_t b)
 {
   float diff_re = __real__ a - __real__ b;
@@ -502,6 +521,25 @@ TEST(
     free(x);
     free(z);)
 
+TEST(
+    srsran_vec_convert_fb, MALLOC(float, x); MALLOC(int8_t, z); float scale = 100.0f;
+
+    int8_t gold;
+    for (int i = 0; i < block_size; i++) { x[i] = (float)RANDOM_F(); }
+
+    TEST_CALL(srsran_vec_convert_fb(x, scale, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          gold       = (int8_t)((x[i] * scale));
+          double err = fabsf((float)gold - (float)z[i]);
+          if (err > mse) {
+            mse = err;
+          }
+        }
+
+    free(x);
+    free(z);)
+
 TEST(
     srsran_vec_prod_fff, MALLOC(float, x); MALLOC(float, y); MALLOC(float, z);
 
@@ -892,6 +930,8 @@ int main(int argc, char** argv)
     nof_repetitions = (uint32_t)strtol(argv[1], NULL, 10);
   }
 
+  printf("SIMD: %s (%d floats per register)\n", simd_isa_name(), SRSRAN_SIMD_F_SIZE);
+
   for (uint32_t block_size = 1; block_size <= 1024 * 32; block_size *= 2) {
     func_count = 0;
 
@@ -963,6 +1003,10 @@ int main(int argc, char** argv)
         test_srsran_vec_convert_if(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_convert_fb(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_prod_fff(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -407,6 +407,26 @@ void srsran_vec_convert_if_simd(const int16_t* x, float* z, const float scale, c
   int         i    = 0;
   const float gain = 1.0f / scale;
 
+#ifdef LV_HAVE_AVX512
+  __m512 s512 = _mm512_set1_ps(gain);
+  for (; i < len - 15; i += 16) {
+    __m256i i16 = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m512  fl  = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(i16));
+
+    _mm512_storeu_ps(&z[i], _mm512_mul_ps(fl, s512));
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  __m256 s256 = _mm256_set1_ps(gain);
+  for (; i < len - 7; i += 8) {
+    __m128i i16 = _mm_loadu_si128((__m128i*)&x[i]);
+    __m256  fl  = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(i16));
+
+    _mm256_storeu_ps(&z[i], _mm256_mul_ps(fl, s256));
+  }
+#endif /* LV_HAVE_AVX2 */
+
 #ifdef LV_HAVE_SSE
   __m128 s = _mm_set1_ps(gain);
   if (SRSRAN_IS_ALIGNED(z)) {
@@ -466,8 +486,10 @@ void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, c
   }
 #endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
 
+  // Saturate the remaining samples as the SIMD packs do
   for (; i < len; i++) {
-    z[i] = (int16_t)(x[i] * scale);
+    float v = x[i] * scale;
+    z[i]    = (int16_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
   }
 }
 
@@ -526,7 +548,16 @@ void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
   int i = 0;
 
   // Force the use of SSE here instead of AVX since the implementations requires too many permutes across 128-bit
-  // boundaries
+  // boundaries. AVX512 provides a saturated 32 to 8 bit conversion that does not need any permute.
+
+#ifdef LV_HAVE_AVX512
+  __m512 s512 = _mm512_set1_ps(scale);
+  for (; i < len - 16 + 1; i += 16) {
+    __m512i i32 = _mm512_cvttps_epi32(_mm512_mul_ps(_mm512_loadu_ps(&x[i]), s512));
+
+    _mm_storeu_si128((__m128i*)&z[i], _mm512_cvtsepi32_epi8(i32));
+  }
+#endif /* LV_HAVE_AVX512 */
 
 #ifdef LV_HAVE_SSE
   __m128 s = _mm_set1_ps(scale);
@@ -555,10 +586,10 @@ void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
     }
   } else {
     for (; i < len - 16 + 1; i += 16) {
-      __m128 a = _mm_load_ps(&x[i]);
-      __m128 b = _mm_load_ps(&x[i + 1 * 4]);
-      __m128 c = _mm_load_ps(&x[i + 2 * 4]);
-      __m128 d = _mm_load_ps(&x[i + 3 * 4]);
+      __m128 a = _mm_loadu_ps(&x[i]);
+      __m128 b = _mm_loadu_ps(&x[i + 1 * 4]);
+      __m128 c = _mm_loadu_ps(&x[i + 2 * 4]);
+      __m128 d = _mm_loadu_ps(&x[i + 3 * 4]);
 
       __m128 sa = _mm_mul_ps(a, s);
       __m128 sb = _mm_mul_ps(b, s);
@@ -583,8 +614,10 @@ void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
 #pragma message "srsran_vec_convert_fb_simd not implemented in neon"
 #endif /* HAVE_NEON */
 
+  // Saturate the remaining samples as the SIMD packs do
   for (; i < len; i++) {
-    z[i] = (int8_t)(x[i] * scale);
+    float v = x[i] * scale;
+    z[i]    = (int8_t)(v > INT8_MAX ? INT8_MAX : (v < INT8_MIN ? INT8_MIN : v));
   }
 }
 
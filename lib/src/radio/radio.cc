@@ -47,6 +47,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_poly_t& q : poly_interpolators) {
+    srsran_resampler_poly_free(&q);
+  }
+
+  for (srsran_resampler_poly_t& q : poly_decimators) {
+    srsran_resampler_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -152,6 +160,11 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
   if (args.continuous_tx != "auto") {
     continuous_tx = (args.continuous_tx == "yes");
   }
+  if (args.resampler == "poly") {
+    use_poly_resampler = true;
+  } else if (not args.resampler.empty() and args.resampler != "fft") {
+    logger.warning("Invalid resampler '%s', using the FFT resampler", args.resampler.c_str());
+  }
 
   // Set fixed gain options
   if (args.rx_gain < 0) {
@@ -295,25 +308,31 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
 
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
-  uint32_t ratio = 1; // No decimation by default
+  uint32_t ratio    = 1; // No decimation by default
+  bool     use_poly = false;
   if (decimator_busy) {
     lock.unlock();
+  } else if (use_poly_resampler) {
+    use_poly = poly_decimators[0].interp != poly_decimators[0].decim;
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
   }
+  bool resample = ratio > 1 or use_poly;
 
-  // Calculate number of samples, considering the decimation ratio
-  uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  // Calculate number of samples, considering the decimation ratio. The polyphase resampler ratio may be fractional, so
+  // it tells how many samples it needs for the requested output
+  uint32_t nof_samples = use_poly ? srsran_resampler_poly_get_nof_input(&poly_decimators[0], buffer.get_nof_samples())
+                                  : buffer.get_nof_samples() * ratio;
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if (resample && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -327,7 +346,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, resample ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -349,7 +368,19 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   }
 
   // Perform decimation
-  if (ratio > 1) {
+  if (use_poly) {
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      if (buffer.get(ch) and buffer_rx.get(ch)) {
+        uint32_t n = srsran_resampler_poly_run(
+            &poly_decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
+
+        // Fill with zeros if the resampler did not produce the requested number of samples
+        if (n < buffer.get_nof_samples()) {
+          srsran_vec_cf_zero(&buffer.get(ch)[n], buffer.get_nof_samples() - n);
+        }
+      }
+    }
+  } else if (ratio > 1) {
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
       if (buffer.get(ch) and buffer_rx.get(ch)) {
         srsran_resampler_fft_run(&decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
@@ -423,27 +454,48 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
   std::unique_lock<std::mutex> lock(tx_mutex);
   uint32_t                     ratio = interpolators[0].ratio;
 
+  // Use the polyphase resampler when it has been set with a ratio other than one
+  bool use_poly = use_poly_resampler and poly_interpolators[0].interp != poly_interpolators[0].decim;
+
   // Get number of samples at the low rate
   uint32_t nof_samples = buffer.get_nof_samples();
 
+  // Number of samples after the interpolation
+  size_t nof_tx_samples = use_poly ? srsran_resampler_poly_get_nof_output(&poly_interpolators[0], nof_samples)
+                                   : (size_t)nof_samples * (size_t)ratio;
+
   // Check that number of the interpolated samples does not exceed the buffer size
-  if (ratio > 1 && (size_t)nof_samples * (size_t)ratio > tx_buffer[0].size()) {
+  if ((ratio > 1 or use_poly) && nof_tx_samples > tx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Tx number of samples ({}/{}) exceeds buffer size ({})\n",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_tx_samples,
                    tx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
     // Limit number of samples to transmit
-    nof_samples = tx_buffer[0].size() / ratio;
+    nof_samples = use_poly ? srsran_resampler_poly_get_nof_input(&poly_interpolators[0], tx_buffer[0].size())
+                           : tx_buffer[0].size() / ratio;
   }
 
   // If the interpolator have been set, interpolate
-  if (interpolators[0].ratio > 1) {
+  if (use_poly) {
+    uint32_t nof_interp_samples = 0;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      // The number of output samples varies between calls for fractional ratios
+      nof_interp_samples =
+          srsran_resampler_poly_run(&poly_interpolators[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+
+      // Set the buffer pointer
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+
+    // Set buffer size after applying the interpolation
+    buffer.set_nof_samples(nof_interp_samples);
+  } else if (interpolators[0].ratio > 1) {
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
       // Perform actual interpolation
       srsran_resampler_fft_run(&interpolators[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
@@ -746,17 +798,26 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+    if (use_poly_resampler) {
+      // Update decimators, the polyphase resampler reduces the ratio between the rates to its simplest fraction
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        if (srsran_resampler_poly_init(&poly_decimators[ch], (uint32_t)srate, (uint32_t)cur_rx_srate)) {
+          logger.error("Error setting the Rx resampling ratio (%.2f MHz / %.2f MHz)", cur_rx_srate / 1e6, srate / 1e6);
+        }
+      }
+    } else {
+      // Assert ratio is integer
+      srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
+                    "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
+                    cur_rx_srate / 1e6,
+                    srate / 1e6,
+                    cur_rx_srate / srate);
+
+      // Update decimators
+      uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      }
     }
 
     decimator_busy = false;
@@ -1002,17 +1063,26 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+    if (use_poly_resampler) {
+      // Update interpolators, the polyphase resampler reduces the ratio between the rates to its simplest fraction
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        if (srsran_resampler_poly_init(&poly_interpolators[ch], (uint32_t)cur_tx_srate, (uint32_t)srate)) {
+          logger.error("Error setting the Tx resampling ratio (%.2f MHz / %.2f MHz)", cur_tx_srate / 1e6, srate / 1e6);
+        }
+      }
+    } else {
+      // Assert ratio is integer
+      srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
+                    "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
+                    cur_rx_srate / 1e6,
+                    srate / 1e6,
+                    cur_rx_srate / srate);
+
+      // Update interpolators
+      uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
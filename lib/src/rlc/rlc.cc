@@ -21,6 +21,7 @@
 
 #include "srsran/rlc/rlc.h"
 #include "srsran/common/rwlock_guard.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/rlc/rlc_am_base.h"
 #include "srsran/rlc/rlc_tm.h"
 #include "srsran/rlc/rlc_um_lte.h"
@@ -282,7 +283,9 @@ uint32_t rlc::get_total_mch_buffer_state(uint32_t lcid)
 
 uint32_t rlc::read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
-  uint32_t ret = 0;
+  static srsran::latency_tprof read_pdu_tprof("rlc_read_pdu");
+  auto                         read_pdu_meas = read_pdu_tprof.start();
+  uint32_t                     ret           = 0;
 
   rwlock_read_guard lock(rwlock);
   if (valid_lcid(lcid)) {
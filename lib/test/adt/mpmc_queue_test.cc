@@ -0,0 +1,164 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/move_callback.h"
+#include "srsran/adt/mpmc_queue.h"
+#include "srsran/common/test_common.h"
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+void test_mpmc_queue_fifo()
+{
+  mpmc_bounded_queue<int> queue(10);
+  TESTASSERT(queue.capacity() == 16);
+  TESTASSERT(queue.empty());
+
+  int val = 0;
+  TESTASSERT(not queue.try_pop(val));
+
+  // Fill, wrapping around the cells several times
+  for (int lap = 0; lap < 3; ++lap) {
+    for (int i = 0; i < 16; ++i) {
+      TESTASSERT(queue.try_push(lap * 16 + i));
+    }
+    TESTASSERT(queue.size() == 16);
+    TESTASSERT(not queue.try_push(-1));
+    for (int i = 0; i < 16; ++i) {
+      TESTASSERT(queue.try_pop(val));
+      TESTASSERT(val == lap * 16 + i);
+    }
+    TESTASSERT(queue.empty());
+  }
+}
+
+void test_mpmc_queue_move_only()
+{
+  mpmc_bounded_queue<std::unique_ptr<int> > queue(2);
+
+  std::unique_ptr<int> p(new int(5));
+  TESTASSERT(queue.try_push(std::move(p)));
+  TESTASSERT(p == nullptr);
+  TESTASSERT(queue.try_push(std::unique_ptr<int>(new int(6))));
+
+  // A failed push leaves the element to the caller
+  p.reset(new int(7));
+  TESTASSERT(not queue.try_push(std::move(p)));
+  TESTASSERT(p != nullptr and *p == 7);
+
+  TESTASSERT(queue.try_pop(p));
+  TESTASSERT(*p == 5);
+  TESTASSERT(queue.try_pop(p));
+  TESTASSERT(*p == 6);
+
+  // Tasks with captures above the inline storage of the callback
+  mpmc_bounded_queue<move_task_t> tasks(4);
+  std::array<int, 32>             v;
+  int                             sum = 0;
+  v.fill(1);
+  TESTASSERT(tasks.try_push([v, &sum]() {
+    for (int i : v) {
+      sum += i;
+    }
+  }));
+  move_task_t task;
+  TESTASSERT(tasks.try_pop(task));
+  task();
+  TESTASSERT(sum == 32);
+}
+
+void test_mpmc_queue_threads()
+{
+  const uint32_t nof_producers = 4;
+  const uint32_t nof_consumers = 2;
+  const uint64_t nof_values    = 100000;
+
+  mpmc_bounded_queue<uint64_t> queue(64);
+  std::vector<std::thread>     threads;
+  std::vector<uint64_t>        sums(nof_consumers, 0);
+  std::vector<uint64_t>        counts(nof_consumers, 0);
+  std::atomic<uint64_t>        nof_popped{0};
+
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    threads.emplace_back([&queue, p]() {
+      for (uint64_t i = 1; i <= nof_values; ++i) {
+        while (not queue.try_push(i * nof_producers + p)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (uint32_t c = 0; c < nof_consumers; ++c) {
+    threads.emplace_back([&, c]() {
+      uint64_t val                 = 0;
+      uint64_t last[nof_producers] = {};
+      while (nof_popped.load() < nof_values * nof_producers) {
+        if (not queue.try_pop(val)) {
+          std::this_thread::yield();
+          continue;
+        }
+        nof_popped++;
+        // The values of a producer reach a consumer in the order they were pushed
+        TESTASSERT(val / nof_producers > last[val % nof_producers]);
+        last[val % nof_producers] = val / nof_producers;
+        sums[c] += val;
+        counts[c]++;
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  uint64_t sum   = 0;
+  uint64_t count = 0;
+  for (uint32_t c = 0; c < nof_consumers; ++c) {
+    sum += sums[c];
+    count += counts[c];
+  }
+  uint64_t expected = 0;
+  for (uint64_t i = 1; i <= nof_values; ++i) {
+    for (uint32_t p = 0; p < nof_producers; ++p) {
+      expected += i * nof_producers + p;
+    }
+  }
+  TESTASSERT(count == nof_values * nof_producers);
+  TESTASSERT(sum == expected);
+  TESTASSERT(queue.empty());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_mpmc_queue_fifo();
+  srsran::test_mpmc_queue_move_only();
+  srsran::test_mpmc_queue_threads();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/adt/rcu_circular_map.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+
+namespace srsran {
+
+struct rcu_test_obj {
+  explicit rcu_test_obj(uint32_t key_) : key(key_) { nof_alive++; }
+  ~rcu_test_obj()
+  {
+    key = -1;
+    nof_alive--;
+  }
+  std::atomic<uint32_t>        key;
+  static std::atomic<int32_t> nof_alive;
+};
+std::atomic<int32_t> rcu_test_obj::nof_alive{0};
+
+void test_rcu_map_single_thread()
+{
+  rcu_circular_map<uint16_t, rcu_test_obj, 4> map;
+  TESTASSERT(map.empty() and not map.full());
+
+  TESTASSERT(map.insert(1, std::unique_ptr<rcu_test_obj>(new rcu_test_obj(1))));
+  TESTASSERT(map.insert(2, std::unique_ptr<rcu_test_obj>(new rcu_test_obj(2))));
+  TESTASSERT(not map.has_space(5) and map.has_space(4));
+  TESTASSERT(not map.insert(5, std::unique_ptr<rcu_test_obj>(new rcu_test_obj(5))));
+  TESTASSERT_EQ(2, rcu_test_obj::nof_alive.load());
+  TESTASSERT_EQ(2, map.size());
+
+  {
+    rcu_read_guard guard(map.get_domain());
+    TESTASSERT(map.find(1) != nullptr and map.find(1)->key == 1);
+    TESTASSERT(map.find(5) == nullptr);
+    uint32_t count = 0;
+    map.for_each([&count](uint16_t key, rcu_test_obj& obj) {
+      TESTASSERT(obj.key == key);
+      count++;
+    });
+    TESTASSERT_EQ(2, count);
+  }
+
+  // Objects removed while a reader is inside are kept until it leaves
+  map.get_domain().read_lock();
+  TESTASSERT(map.erase(1));
+  TESTASSERT(not map.erase(1));
+  TESTASSERT(not map.contains(1) and map.size() == 1);
+  TESTASSERT_EQ(1, map.reclaim());
+  TESTASSERT_EQ(2, rcu_test_obj::nof_alive.load());
+  map.get_domain().read_unlock();
+  TESTASSERT_EQ(0, map.reclaim());
+  TESTASSERT_EQ(1, rcu_test_obj::nof_alive.load());
+
+  // Readers that enter after the removal do not hold it back
+  {
+    rcu_read_guard guard(map.get_domain());
+    TESTASSERT(map.erase(2));
+    TESTASSERT_EQ(1, map.reclaim());
+  }
+  {
+    rcu_read_guard guard(map.get_domain());
+    TESTASSERT_EQ(0, map.reclaim());
+  }
+  TESTASSERT_EQ(0, rcu_test_obj::nof_alive.load());
+}
+
+void test_rcu_map_concurrent()
+{
+  const uint32_t nof_readers = 4, nof_keys = 16, nof_iters = 100000;
+
+  rcu_circular_map<uint16_t, rcu_test_obj, nof_keys> map;
+  std::atomic<bool>                                  stop{false};
+  std::atomic<uint32_t>                              nof_found{0};
+
+  std::vector<std::thread> readers;
+  for (uint32_t i = 0; i < nof_readers; ++i) {
+    readers.emplace_back([&map, &stop, &nof_found]() {
+      uint32_t found = 0;
+      while (not stop.load(std::memory_order_relaxed)) {
+        rcu_read_guard guard(map.get_domain());
+        for (uint16_t key = 0; key < nof_keys; ++key) {
+          rcu_test_obj* obj = map.find(key);
+          if (obj != nullptr) {
+            // The object must not be freed while the reader is inside
+            TESTASSERT(obj->key == key);
+            found++;
+          }
+        }
+      }
+      nof_found += found;
+    });
+  }
+
+  for (uint32_t i = 0; i < nof_iters; ++i) {
+    uint16_t key = i % nof_keys;
+    if (not map.erase(key)) {
+      map.insert(key, std::unique_ptr<rcu_test_obj>(new rcu_test_obj(key)));
+    }
+    map.reclaim();
+  }
+  stop = true;
+  for (std::thread& t : readers) {
+    t.join();
+  }
+
+  TESTASSERT(nof_found > 0);
+  TESTASSERT_EQ(0, map.reclaim());
+  TESTASSERT_EQ((int)map.size(), rcu_test_obj::nof_alive.load());
+}
+
+} // namespace srsran
+
+int main()
+{
+  srsran::test_rcu_map_single_thread();
+  srsran::test_rcu_map_concurrent();
+  printf("Success\n");
+  return 0;
+}
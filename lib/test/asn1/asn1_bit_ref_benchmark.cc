@@ -0,0 +1,270 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of the ASN.1 PER bit reader/writer. It compares bit_ref with the former byte-at-a-time implementation over
+ * a stream of PER-like fields, and measures the unpack/pack time of captured S1AP and RRC messages.
+ */
+
+#include "srsran/asn1/rrc.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/config.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace asn1;
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+/// Byte-at-a-time bit writer, as bit_ref::pack was implemented before the word-at-a-time version
+struct legacy_bit_writer {
+  uint8_t*       ptr;
+  uint8_t        offset;
+  const uint8_t* max_ptr;
+
+  bool pack(uint64_t val, uint32_t n_bits)
+  {
+    while (n_bits > 0) {
+      if (ptr >= max_ptr) {
+        return false;
+      }
+      val              = val & ((UINT64_C(1) << n_bits) - 1U);
+      uint8_t keepmask = ((uint8_t)-1) - (uint8_t)((1u << (8u - offset)) - 1u);
+      if ((uint32_t)(8 - offset) > n_bits) {
+        *ptr = ((*ptr) & keepmask) + static_cast<uint8_t>(val << (8u - offset - n_bits));
+        offset += n_bits;
+        n_bits = 0;
+      } else {
+        *ptr = (*ptr & keepmask) + static_cast<uint8_t>(val >> (n_bits - 8u + offset));
+        n_bits -= (8 - offset);
+        offset = 0;
+        ptr++;
+      }
+    }
+    return true;
+  }
+};
+
+/// Byte-at-a-time bit reader, as unpack_bits was implemented before the word-at-a-time version
+struct legacy_bit_reader {
+  const uint8_t* ptr;
+  uint8_t        offset;
+  const uint8_t* max_ptr;
+
+  bool unpack(uint64_t& val, uint32_t n_bits)
+  {
+    val = 0;
+    while (n_bits > 0) {
+      if (ptr >= max_ptr) {
+        return false;
+      }
+      if ((uint32_t)(8 - offset) > n_bits) {
+        uint8_t mask = (uint8_t)(1u << (8u - offset)) - (uint8_t)(1u << (8u - offset - n_bits));
+        val += ((uint32_t)((*ptr) & mask)) >> (8u - offset - n_bits);
+        offset += n_bits;
+        n_bits = 0;
+      } else {
+        auto mask = static_cast<uint8_t>((1u << (8u - offset)) - 1u);
+        val += static_cast<uint64_t>((*ptr) & mask) << (n_bits - 8 + offset);
+        n_bits -= 8 - offset;
+        offset = 0;
+        ptr++;
+      }
+    }
+    return true;
+  }
+};
+
+struct field_t {
+  uint32_t n_bits;
+  uint64_t value;
+};
+
+/// Generates a stream of fields whose widths resemble PER encoded messages: mostly presence flags and small enums
+std::vector<field_t> generate_fields(std::mt19937& rgen, uint32_t nof_fields)
+{
+  std::vector<field_t>                    fields(nof_fields);
+  std::uniform_int_distribution<uint32_t> kind_dist(0, 99);
+  std::uniform_int_distribution<uint64_t> val_dist;
+  for (field_t& f : fields) {
+    uint32_t kind = kind_dist(rgen);
+    if (kind < 50) {
+      f.n_bits = 1;
+    } else if (kind < 80) {
+      f.n_bits = 2 + kind % 7;
+    } else if (kind < 95) {
+      f.n_bits = 9 + kind % 24;
+    } else {
+      f.n_bits = 33 + kind % 31;
+    }
+    f.value = val_dist(rgen) & ((UINT64_C(1) << f.n_bits) - 1U);
+  }
+  return fields;
+}
+
+int bench_bit_stream(uint32_t nof_repetitions)
+{
+  std::mt19937         rgen(1234);
+  std::vector<field_t> fields = generate_fields(rgen, 100000);
+
+  uint32_t total_bits = 0;
+  for (const field_t& f : fields) {
+    total_bits += f.n_bits;
+  }
+  uint32_t             nof_bytes = (total_bits + 7) / 8;
+  std::vector<uint8_t> buf_legacy(nof_bytes), buf_new(nof_bytes);
+
+  bench_clock::duration legacy_pack_time{}, legacy_unpack_time{}, pack_time{}, unpack_time{};
+  for (uint32_t rep = 0; rep < nof_repetitions; ++rep) {
+    auto              t0 = bench_clock::now();
+    legacy_bit_writer w  = {buf_legacy.data(), 0, buf_legacy.data() + nof_bytes};
+    bool              ok = true;
+    for (const field_t& f : fields) {
+      ok &= w.pack(f.value, f.n_bits);
+    }
+    auto    t1 = bench_clock::now();
+    bit_ref bref(buf_new.data(), nof_bytes);
+    for (const field_t& f : fields) {
+      ok &= bref.pack(f.value, f.n_bits) == SRSASN_SUCCESS;
+    }
+    auto t2 = bench_clock::now();
+    legacy_pack_time += t1 - t0;
+    pack_time += t2 - t1;
+
+    if (not ok or buf_legacy != buf_new) {
+      fprintf(stderr, "Packed bit streams do not match\n");
+      return SRSRAN_ERROR;
+    }
+
+    uint64_t          legacy_sum = 0, new_sum = 0, val = 0;
+    legacy_bit_reader r          = {buf_legacy.data(), 0, buf_legacy.data() + nof_bytes};
+    auto              t3         = bench_clock::now();
+    for (const field_t& f : fields) {
+      ok &= r.unpack(val, f.n_bits);
+      legacy_sum += val;
+    }
+    auto     t4 = bench_clock::now();
+    cbit_ref cbref(buf_new.data(), nof_bytes);
+    for (const field_t& f : fields) {
+      ok &= cbref.unpack(val, f.n_bits) == SRSASN_SUCCESS;
+      new_sum += val;
+    }
+    auto t5 = bench_clock::now();
+    legacy_unpack_time += t4 - t3;
+    unpack_time += t5 - t4;
+
+    if (not ok or legacy_sum != new_sum) {
+      fprintf(stderr, "Unpacked bit streams do not match\n");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  double nof_fields = (double)fields.size() * nof_repetitions;
+  auto   ns_field   = [nof_fields](bench_clock::duration d) {
+    return std::chrono::duration<double, std::nano>(d).count() / nof_fields;
+  };
+  printf("bit stream (%d fields, %d bytes):\n", (int)fields.size(), nof_bytes);
+  printf("  pack:   legacy %.2f ns/field, bit_ref %.2f ns/field\n", ns_field(legacy_pack_time), ns_field(pack_time));
+  printf(
+      "  unpack: legacy %.2f ns/field, bit_ref %.2f ns/field\n", ns_field(legacy_unpack_time), ns_field(unpack_time));
+
+  return SRSRAN_SUCCESS;
+}
+
+template <typename Msg>
+int bench_msg(const char* name, const uint8_t* msg, uint32_t msg_len, uint32_t nof_repetitions)
+{
+  uint8_t               buf[1024];
+  bench_clock::duration unpack_time{}, pack_time{};
+
+  for (uint32_t rep = 0; rep < nof_repetitions; ++rep) {
+    Msg      pdu;
+    cbit_ref bref(msg, msg_len);
+    auto     t0        = bench_clock::now();
+    bool     unpack_ok = pdu.unpack(bref) == SRSASN_SUCCESS;
+    auto     t1        = bench_clock::now();
+    bit_ref  bref2(buf, sizeof(buf));
+    bool     pack_ok = pdu.pack(bref2) == SRSASN_SUCCESS;
+    auto     t2      = bench_clock::now();
+    unpack_time += t1 - t0;
+    pack_time += t2 - t1;
+
+    if (not unpack_ok or not pack_ok) {
+      fprintf(stderr, "%s: unpack/pack failed\n", name);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  auto ns_msg = [nof_repetitions](bench_clock::duration d) {
+    return std::chrono::duration<double, std::nano>(d).count() / nof_repetitions;
+  };
+  printf(
+      "%s (%d bytes): unpack %.0f ns/msg, pack %.0f ns/msg\n", name, msg_len, ns_msg(unpack_time), ns_msg(pack_time));
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  uint32_t nof_repetitions = (argc > 1) ? (uint32_t)strtol(argv[1], nullptr, 10) : 100;
+
+  srslog::init();
+
+  // S1AP InitialContextSetupRequest
+  static const uint8_t s1ap_msg[] = {
+      0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+      0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+      0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+      0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+      0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+      0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+      0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+      0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+      0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+      0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+      0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+  // RRC DL-DCCH RRCConnectionReconfiguration with mobility control info
+  static const uint8_t rrc_msg[] = {0x20, 0x1b, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x01, 0xa9, 0x08, 0x80, 0x00, 0x00, 0x29,
+                                    0x00, 0x97, 0x80, 0x00, 0x00, 0x00, 0x01, 0x04, 0x22, 0x14, 0x00, 0xf8, 0x02, 0x0a,
+                                    0xc0, 0x60, 0x00, 0xa0, 0x0c, 0x80, 0x42, 0x02, 0x9f, 0x43, 0x07, 0xda, 0xbc, 0xf8,
+                                    0x4b, 0x32, 0x18, 0x34, 0xc0, 0x00, 0x2d, 0x68, 0x08, 0x5e, 0x18, 0x00, 0x16, 0x80,
+                                    0x00};
+
+  int ret = bench_bit_stream(nof_repetitions);
+  if (ret == SRSRAN_SUCCESS) {
+    ret = bench_msg<s1ap::s1ap_pdu_c>(
+        "S1AP InitialContextSetupRequest", s1ap_msg, sizeof(s1ap_msg), 100 * nof_repetitions);
+  }
+  if (ret == SRSRAN_SUCCESS) {
+    ret = bench_msg<rrc::dl_dcch_msg_s>(
+        "RRC RRCConnectionReconfiguration", rrc_msg, sizeof(rrc_msg), 100 * nof_repetitions);
+  }
+
+  srslog::flush();
+
+  return ret;
+}
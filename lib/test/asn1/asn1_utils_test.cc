@@ -177,6 +177,38 @@ int test_bit_ref()
     TESTASSERT(memcmp(buf2, buf3, nof_bytes) == 0);
   }
 
+  // random field widths, including wide fields straddling nine bytes and the last bytes of the buffer
+  {
+    std::uniform_int_distribution<uint32_t>     width_dist(1, 63);
+    std::uniform_int_distribution<uint64_t>     val_dist;
+    std::vector<std::pair<uint32_t, uint64_t> > fields;
+    uint32_t                                    nof_bits = 0;
+    while (nof_bits < 8 * 100) {
+      uint32_t n = width_dist(g);
+      fields.emplace_back(n, val_dist(g) & ((UINT64_C(1) << n) - 1U));
+      nof_bits += n;
+    }
+    uint32_t nof_bytes = (nof_bits + 7) / 8;
+    memset(buf, 0xff, sizeof(buf));
+    bit_ref bref(&buf[0], nof_bytes);
+    for (auto& f : fields) {
+      TESTASSERT(bref.pack(f.second, f.first) == SRSASN_SUCCESS);
+    }
+    TESTASSERT(bref.distance() == (int)nof_bits);
+    TESTASSERT(buf[nof_bytes] == 0xff);
+    TESTASSERT(bref.pack(0, 8) != SRSASN_SUCCESS);
+    cbit_ref bref2(&buf[0], nof_bytes);
+    for (auto& f : fields) {
+      uint64_t val;
+      TESTASSERT(bref2.unpack(val, f.first) == SRSASN_SUCCESS);
+      TESTASSERT(val == f.second);
+    }
+    uint8_t val;
+    TESTASSERT(bref2.unpack(val, 8) != SRSASN_SUCCESS);
+    TESTASSERT(test_spy->get_error_counter() == 2);
+    test_spy->reset_counters();
+  }
+
   // test advance bits
   {
     bit_ref bref(&buf[0], sizeof(buf));
@@ -527,6 +559,72 @@ int test_copy_ptr()
   return 0;
 }
 
+int test_mem_arena()
+{
+  mem_arena arena(64);
+  set_alloc_stats_enabled(true);
+  reset_alloc_stats();
+  {
+    dyn_array<uint32_t>                   vec;
+    ext_array<uint8_t>                    ext;
+    copy_ptr<fixed_octstring<10> >        cptr;
+    dyn_array<copy_ptr<dyn_array<int> > > nested;
+    {
+      arena_scope scope(arena);
+      for (uint32_t i = 0; i < 100; ++i) {
+        vec.push_back(i);
+        ext.push_back(i);
+      }
+      cptr.set_present();
+      (*cptr)[0] = 5;
+      nested.resize(2);
+      nested[1].set_present();
+      nested[1]->resize(3);
+      (*nested[1])[2] = 7;
+    }
+    TESTASSERT(get_alloc_stats().nof_heap_allocs == 0);
+    TESTASSERT(get_alloc_stats().nof_arena_allocs == arena.nof_allocations());
+    TESTASSERT(arena.nof_blocks() > 1); // allocations larger than the block size spill to new blocks
+    for (uint32_t i = 0; i < 100; ++i) {
+      TESTASSERT(vec[i] == i and ext[i] == i);
+    }
+    TESTASSERT((*nested[1])[2] == 7);
+
+    // Copies made outside of the scope go to the heap
+    dyn_array<copy_ptr<dyn_array<int> > > nested2 = nested;
+    TESTASSERT(get_alloc_stats().nof_heap_allocs == 3);
+    TESTASSERT((*nested2[1])[2] == 7);
+
+    // Released pointers are moved out of the arena, so they can be deleted by the caller
+    fixed_octstring<10>* s = cptr.release();
+    TESTASSERT((*s)[0] == 5);
+    delete s;
+  }
+  TESTASSERT(arena.nof_live_allocations() == 0);
+  TESTASSERT(arena.nof_bytes_allocated() > 0);
+
+  // The arena memory is recycled after a reset
+  uint32_t nof_blocks = arena.nof_blocks();
+  arena.reset();
+  TESTASSERT(arena.nof_bytes_allocated() == 0);
+  {
+    arena_scope         scope(arena);
+    dyn_array<uint32_t> vec(10);
+    TESTASSERT(arena.nof_live_allocations() == 1);
+  }
+  TESTASSERT(arena.nof_blocks() == nof_blocks);
+
+  // Nothing is counted once the statistics are disabled
+  set_alloc_stats_enabled(false);
+  reset_alloc_stats();
+  {
+    dyn_array<uint32_t> vec(10);
+  }
+  TESTASSERT(get_alloc_stats().nof_heap_allocs == 0);
+
+  return 0;
+}
+
 class EnumTest
 {
 public:
@@ -694,6 +792,7 @@ int main()
   TESTASSERT(test_bitstring() == 0);
   TESTASSERT(test_seq_of() == 0);
   TESTASSERT(test_copy_ptr() == 0);
+  TESTASSERT(test_mem_arena() == 0);
   TESTASSERT(test_enum() == 0);
   TESTASSERT(test_big_integers() == 0);
   test_varlength_field_pack();
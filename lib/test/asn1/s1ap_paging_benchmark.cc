@@ -0,0 +1,145 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of the S1AP Paging dispatch. It compares the throughput of decoding the full s1ap_pdu_c tree with the
+ * lazy ap_pdu_view, which only indexes the IEs and decodes the UE identity IEs that the eNB needs.
+ */
+
+#include "srsran/asn1/s1ap.h"
+#include "srsran/config.h"
+#include <chrono>
+#include <cstdlib>
+
+using namespace asn1;
+using namespace asn1::s1ap;
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+/// Builds a Paging message with nof_tais entries in the TAI list
+uint32_t build_paging(uint8_t* buf, uint32_t buf_len, uint32_t nof_tais)
+{
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_PAGING);
+  paging_s& paging = pdu.init_msg().value.paging();
+
+  paging->ue_id_idx_value.value.from_number(0x2d3);
+  s_tmsi_s& s_tmsi = paging->ue_paging_id.value.set_s_tmsi();
+  s_tmsi.mmec[0]   = 0x1a;
+  for (uint32_t i = 0; i < s_tmsi.m_tmsi.size(); ++i) {
+    s_tmsi.m_tmsi[i] = 0x10 + i;
+  }
+  paging->cn_domain.value.value = cn_domain_opts::ps;
+  paging->tai_list.value.resize(nof_tais);
+  for (uint32_t i = 0; i < nof_tais; ++i) {
+    paging->tai_list.value[i].load_info_obj(ASN1_S1AP_ID_TAI_ITEM);
+    tai_s& tai = paging->tai_list.value[i]->tai_item().tai;
+    tai.plm_nid.from_number(0x00f110);
+    tai.tac.from_number(i + 1);
+  }
+  paging->paging_drx_present     = true;
+  paging->paging_drx.value.value = paging_drx_opts::v128;
+
+  bit_ref bref(buf, buf_len);
+  if (pdu.pack(bref) != SRSASN_SUCCESS) {
+    return 0;
+  }
+  return bref.distance_bytes();
+}
+
+bool full_decode(const uint8_t* buf, uint32_t len, uint32_t& ueid, uint32_t& m_tmsi)
+{
+  cbit_ref   bref(buf, len);
+  s1ap_pdu_c pdu;
+  if (pdu.unpack(bref) != SRSASN_SUCCESS or pdu.type().value != s1ap_pdu_c::types_opts::init_msg or
+      pdu.init_msg().value.type().value != s1ap_elem_procs_o::init_msg_c::types_opts::paging) {
+    return false;
+  }
+  const paging_s& paging = pdu.init_msg().value.paging();
+  ueid                   = paging->ue_id_idx_value.value.to_number();
+  m_tmsi                 = paging->ue_paging_id.value.s_tmsi().m_tmsi.to_number();
+  return true;
+}
+
+bool lazy_decode(const uint8_t* buf, uint32_t len, uint32_t& ueid, uint32_t& m_tmsi)
+{
+  ap_pdu_view view;
+  if (view.unpack(buf, len) != SRSASN_SUCCESS or view.pdu_type() != s1ap_pdu_c::types_opts::init_msg or
+      view.proc_code() != ASN1_S1AP_ID_PAGING) {
+    return false;
+  }
+  fixed_bitstring<10, false, true> ue_id_idx_value;
+  ue_paging_id_c                   ue_paging_id;
+  if (view.unpack_ie(ASN1_S1AP_ID_UE_ID_IDX_VALUE, ue_id_idx_value) != SRSASN_SUCCESS or
+      view.unpack_ie(ASN1_S1AP_ID_UE_PAGING_ID, ue_paging_id) != SRSASN_SUCCESS) {
+    return false;
+  }
+  ueid   = ue_id_idx_value.to_number();
+  m_tmsi = ue_paging_id.s_tmsi().m_tmsi.to_number();
+  return true;
+}
+
+template <typename DecodeFunc>
+double bench_decode(DecodeFunc decode, const uint8_t* buf, uint32_t len, uint32_t nof_reps, bool& ok)
+{
+  uint32_t ueid = 0, m_tmsi = 0;
+  auto     tp   = bench_clock::now();
+  for (uint32_t i = 0; i < nof_reps; ++i) {
+    ok &= decode(buf, len, ueid, m_tmsi);
+  }
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - tp).count();
+  ok &= (ueid == 0x2d3 and m_tmsi == 0x10111213);
+  return nof_reps * 1e9 / ns;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  uint32_t nof_reps = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+
+  srslog::init();
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t nof_tais : {1, 16, 256}) {
+    uint8_t  buf[4096];
+    uint32_t len = build_paging(buf, sizeof(buf), nof_tais);
+    bool     ok  = len > 0;
+
+    double full_rate = bench_decode(full_decode, buf, len, nof_reps, ok);
+    double lazy_rate = bench_decode(lazy_decode, buf, len, nof_reps, ok);
+    printf("Paging with %3d TAIs (%4d B): full decode=%.2f Mmsg/s, lazy decode=%.2f Mmsg/s, speedup=%.1fx%s\n",
+           nof_tais,
+           len,
+           full_rate / 1e6,
+           lazy_rate / 1e6,
+           lazy_rate / full_rate,
+           ok ? "" : " [FAILED]");
+    if (not ok) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  srslog::flush();
+  return ret;
+}
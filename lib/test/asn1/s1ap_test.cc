@@ -22,6 +22,7 @@
 #include "srsran/asn1/s1ap.h"
 #include "srsran/common/test_common.h"
 #include <arpa/inet.h>
+#include <chrono>
 #include <sys/socket.h>
 
 using namespace asn1;
@@ -62,23 +63,23 @@ int test_s1setup_request()
   return 0;
 }
 
+static const uint8_t init_ctxt_setup_req_msg[] = {
+    0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+    0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+    0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+    0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+    0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+    0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+    0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+    0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+    0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+    0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+// 00090080c60000060000000200640008000200010042000a183b9aca00603b9aca000018007800003400734500093c0f800a0021f0b7361c5664273e5b04b7020742023e060009f107000700375266c101091b0774657374313233066d6e63303730066d636339303104677072730501c0a80302270e8080210a0300000a810608080808500bf609f107800101f67e72691309f10700012305f4f67e7269006b000518000c0000004900204525e49a77c8d5cf263363eb5bb9c3439b9eb3861fa8a7cf435407ae422b63b9
+
 int test_init_ctxt_setup_req()
 {
-  uint8_t s1ap_msg[] = {
-      0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
-      0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
-      0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
-      0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
-      0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
-      0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
-      0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
-      0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
-      0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
-      0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
-      0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
-  // 00090080c60000060000000200640008000200010042000a183b9aca00603b9aca000018007800003400734500093c0f800a0021f0b7361c5664273e5b04b7020742023e060009f107000700375266c101091b0774657374313233066d6e63303730066d636339303104677072730501c0a80302270e8080210a0300000a810608080808500bf609f107800101f67e72691309f10700012305f4f67e7269006b000518000c0000004900204525e49a77c8d5cf263363eb5bb9c3439b9eb3861fa8a7cf435407ae422b63b9
-
-  cbit_ref   bref(&s1ap_msg[0], sizeof(s1ap_msg));
+  cbit_ref   bref(&init_ctxt_setup_req_msg[0], sizeof(init_ctxt_setup_req_msg));
   s1ap_pdu_c pdu;
   TESTASSERT(pdu.unpack(bref) == SRSASN_SUCCESS);
 
@@ -362,6 +363,126 @@ int test_paging()
   return SRSRAN_SUCCESS;
 }
 
+int test_paging_lazy_decode()
+{
+  uint8_t buffer[] = {0x00, 0x0a, 0x40, 0x2a, 0x00, 0x00, 0x04, 0x00, 0x50, 0x40, 0x02, 0xb4, 0xc0, 0x00, 0x2b, 0x40,
+                      0x09, 0x68, 0x54, 0x02, 0x04, 0x30, 0x68, 0x74, 0x05, 0xf7, 0x00, 0x6d, 0x40, 0x01, 0x00, 0x00,
+                      0x2e, 0x40, 0x0b, 0x00, 0x00, 0x2f, 0x40, 0x06, 0x00, 0x54, 0xf2, 0x40, 0x04, 0xd2};
+
+  ap_pdu_view view;
+  TESTASSERT(view.unpack(buffer, sizeof(buffer)) == SRSASN_SUCCESS);
+  TESTASSERT(view.pdu_type() == s1ap_pdu_c::types_opts::init_msg);
+  TESTASSERT(view.proc_code() == ASN1_S1AP_ID_PAGING);
+  TESTASSERT(view.crit() == crit_opts::ignore);
+  TESTASSERT(not view.ext());
+  TESTASSERT(view.nof_ies() == 4);
+  TESTASSERT(view.find_ie(ASN1_S1AP_ID_PAGING_DRX) == nullptr);
+
+  // IEs decoded on access must match the fully decoded message
+  cbit_ref   bref(buffer, sizeof(buffer));
+  s1ap_pdu_c pdu;
+  TESTASSERT(pdu.unpack(bref) == SRSASN_SUCCESS);
+  const paging_s& paging = pdu.init_msg().value.paging();
+
+  fixed_bitstring<10, false, true> ue_id_idx_value;
+  ue_paging_id_c                   ue_paging_id;
+  TESTASSERT(view.unpack_ie(ASN1_S1AP_ID_UE_ID_IDX_VALUE, ue_id_idx_value) == SRSASN_SUCCESS);
+  TESTASSERT(view.unpack_ie(ASN1_S1AP_ID_UE_PAGING_ID, ue_paging_id) == SRSASN_SUCCESS);
+  TESTASSERT(ue_id_idx_value == paging->ue_id_idx_value.value);
+  TESTASSERT(ue_paging_id.type().value == ue_paging_id_c::types_opts::imsi);
+  TESTASSERT(ue_paging_id.imsi() == paging->ue_paging_id.value.imsi());
+  TESTASSERT(view.ie(3).id == ASN1_S1AP_ID_TAI_LIST);
+  TESTASSERT(view.ie(3).offset + view.ie(3).len == sizeof(buffer));
+
+  // The envelope of a truncated PDU is rejected
+  TESTASSERT(view.unpack(buffer, sizeof(buffer) - 1) != SRSASN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_ue_ids_lazy_decode()
+{
+  ap_pdu_view view;
+  TESTASSERT(view.unpack(&init_ctxt_setup_req_msg[0], sizeof(init_ctxt_setup_req_msg)) == SRSASN_SUCCESS);
+  TESTASSERT(view.pdu_type() == s1ap_pdu_c::types_opts::init_msg);
+  TESTASSERT(view.proc_code() == ASN1_S1AP_ID_INIT_CONTEXT_SETUP);
+
+  cbit_ref   bref(&init_ctxt_setup_req_msg[0], sizeof(init_ctxt_setup_req_msg));
+  s1ap_pdu_c pdu;
+  TESTASSERT(pdu.unpack(bref) == SRSASN_SUCCESS);
+  const init_context_setup_request_s& req = pdu.init_msg().value.init_context_setup_request();
+
+  // The UE S1AP IDs are available without decoding the E-RAB list and the security context
+  mme_ue_s1ap_id_t mme_ue_s1ap_id;
+  enb_ue_s1ap_id_t enb_ue_s1ap_id;
+  TESTASSERT(view.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) == SRSASN_SUCCESS);
+  TESTASSERT(view.unpack_ie(ASN1_S1AP_ID_ENB_UE_S1AP_ID, enb_ue_s1ap_id) == SRSASN_SUCCESS);
+  TESTASSERT(mme_ue_s1ap_id.value == req->mme_ue_s1ap_id.value.value);
+  TESTASSERT(enb_ue_s1ap_id.value == req->enb_ue_s1ap_id.value.value);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_arena_decode()
+{
+  const uint32_t nof_decodes = 1000;
+  uint8_t        heap_buf[512], arena_buf[512];
+  bit_ref        heap_bref(heap_buf, sizeof(heap_buf)), arena_bref(arena_buf, sizeof(arena_buf));
+
+  // Decode with the heap
+  set_alloc_stats_enabled(true);
+  reset_alloc_stats();
+  auto tp = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_decodes; ++i) {
+    cbit_ref   bref(&init_ctxt_setup_req_msg[0], sizeof(init_ctxt_setup_req_msg));
+    s1ap_pdu_c pdu;
+    TESTASSERT(pdu.unpack(bref) == SRSASN_SUCCESS);
+    if (i == 0) {
+      TESTASSERT(pdu.pack(heap_bref) == SRSASN_SUCCESS);
+    }
+  }
+  auto     heap_ns     = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+  uint32_t heap_allocs = get_alloc_stats().nof_heap_allocs / nof_decodes;
+  TESTASSERT(heap_allocs > 0);
+
+  // Decode with an arena, reused across messages
+  mem_arena arena;
+  reset_alloc_stats();
+  tp = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_decodes; ++i) {
+    {
+      cbit_ref   bref(&init_ctxt_setup_req_msg[0], sizeof(init_ctxt_setup_req_msg));
+      s1ap_pdu_c pdu;
+      {
+        arena_scope scope(arena);
+        TESTASSERT(pdu.unpack(bref) == SRSASN_SUCCESS);
+      }
+      if (i == 0) {
+        TESTASSERT(arena.nof_allocations() == heap_allocs);
+        TESTASSERT(pdu.pack(arena_bref) == SRSASN_SUCCESS);
+      }
+    }
+    // The decoded tree is gone, the arena memory can be recycled for the next message
+    TESTASSERT(arena.nof_live_allocations() == 0);
+    arena.reset();
+  }
+  auto arena_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+  TESTASSERT(get_alloc_stats().nof_heap_allocs == 0);
+  TESTASSERT(get_alloc_stats().nof_arena_allocs == heap_allocs * nof_decodes);
+
+  // Both decoded trees must encode to the same message
+  TESTASSERT(heap_bref.distance_bytes() == arena_bref.distance_bytes());
+  TESTASSERT(std::equal(heap_buf, heap_buf + heap_bref.distance_bytes(), arena_buf));
+
+  printf("InitialContextSetupRequest decode: %u allocations/msg, heap=%.1f usec/msg, arena=%.1f usec/msg (%u blocks)\n",
+         heap_allocs,
+         heap_ns.count() / (1000.0 * nof_decodes),
+         arena_ns.count() / (1000.0 * nof_decodes),
+         arena.nof_blocks());
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup the log spy to intercept error and warning log entries.
@@ -397,6 +518,9 @@ int main()
   TESTASSERT(test_initial_ctxt_setup_response() == 0);
   TESTASSERT(test_eci_pack() == 0);
   TESTASSERT(test_paging() == 0);
+  TESTASSERT(test_paging_lazy_decode() == 0);
+  TESTASSERT(test_ue_ids_lazy_decode() == 0);
+  TESTASSERT(test_arena_decode() == 0);
 
   srslog::flush();
 
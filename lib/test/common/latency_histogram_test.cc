@@ -0,0 +1,140 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/latency_histogram.h"
+#include "srsran/common/test_common.h"
+#include "srsran/common/time_prof.h"
+#include <thread>
+
+using namespace srsran;
+
+int test_buckets()
+{
+  // Exact below the number of sub-buckets, then within the relative error
+  for (uint64_t v = 0; v < latency_histogram::nof_sub_buckets; v++) {
+    TESTASSERT(latency_histogram::get_bucket(v) == v);
+    TESTASSERT(latency_histogram::get_bucket_min(v) == v);
+  }
+  for (uint64_t v = 16; v < (1ULL << latency_histogram::max_value_bits); v = v * 3 / 2 + 1) {
+    uint32_t bucket = latency_histogram::get_bucket(v);
+    TESTASSERT(latency_histogram::get_bucket_min(bucket) <= v);
+    TESTASSERT(latency_histogram::get_bucket_min(bucket + 1) > v);
+    TESTASSERT(v - latency_histogram::get_bucket_min(bucket) <= v / latency_histogram::nof_sub_buckets);
+  }
+  // Values beyond the range are kept in the last bucket
+  TESTASSERT(latency_histogram::get_bucket(1ULL << 50) == latency_histogram::nof_buckets - 1);
+  return SRSRAN_SUCCESS;
+}
+
+int test_quantiles()
+{
+  std::unique_ptr<latency_histogram> hist(new latency_histogram);
+  for (uint64_t v = 1; v <= 1000; v++) {
+    hist->record(v * 1000);
+  }
+  std::unique_ptr<latency_histogram::snapshot_t> snapshot(new latency_histogram::snapshot_t);
+  hist->get_snapshot(*snapshot);
+  TESTASSERT(snapshot->count == 1000);
+  TESTASSERT(snapshot->sum_ns == 500500 * 1000);
+  TESTASSERT(snapshot->max_ns == 1000000);
+
+  // The quantiles are the upper bound of their bucket
+  uint64_t p50 = snapshot->quantile_ns(0.5);
+  TESTASSERT(p50 >= 500000 and p50 <= 500000 * 17 / 16);
+  uint64_t p99 = snapshot->quantile_ns(0.99);
+  TESTASSERT(p99 >= 990000 and p99 <= 1000000);
+  TESTASSERT(snapshot->quantile_ns(1) == 1000000);
+
+  // The max restarts with every snapshot
+  hist->get_snapshot(*snapshot);
+  TESTASSERT(snapshot->count == 1000);
+  TESTASSERT(snapshot->max_ns == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int test_concurrent_record()
+{
+  const uint32_t                     nof_threads = 2 * latency_histogram::nof_shards;
+  const uint32_t                     nof_values  = 10000;
+  std::unique_ptr<latency_histogram> hist(new latency_histogram);
+  std::vector<std::thread>           threads;
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    threads.emplace_back([&hist, i]() {
+      for (uint32_t v = 0; v < nof_values; v++) {
+        hist->record(i + 1);
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  std::unique_ptr<latency_histogram::snapshot_t> snapshot(new latency_histogram::snapshot_t);
+  hist->get_snapshot(*snapshot);
+  TESTASSERT(snapshot->count == nof_threads * nof_values);
+  TESTASSERT(snapshot->max_ns == nof_threads);
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    TESTASSERT(snapshot->buckets[latency_histogram::get_bucket(i + 1)] >= nof_values);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_registry()
+{
+  latency_histogram_registry& registry = latency_histogram_registry::get_instance();
+  latency_tprof               tprof("test_tprof");
+  latency_metrics_t           metrics;
+
+  // Nothing is measured while disabled
+  tprof.start().stop();
+  registry.get_metrics(metrics);
+  TESTASSERT(metrics.size() == 1 and metrics[0].name == "test_tprof");
+  TESTASSERT(metrics[0].count == 0);
+
+  registry.set_enabled(true);
+  for (uint32_t i = 0; i < 10; i++) {
+    auto meas = tprof.start();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  registry.get_histogram("test_other").record(5000);
+  registry.get_metrics(metrics);
+  TESTASSERT(metrics.size() == 2);
+  TESTASSERT(metrics[0].name == "test_other" and metrics[0].count == 1);
+  TESTASSERT(metrics[0].max_us == 5);
+  TESTASSERT(metrics[1].count == 10);
+  TESTASSERT(metrics[1].p50_us >= 100 and metrics[1].max_us >= metrics[1].p999_us);
+
+  // Every call covers the period since the previous one
+  tprof.start().stop();
+  registry.get_metrics(metrics);
+  TESTASSERT(metrics[0].count == 0);
+  TESTASSERT(metrics[1].count == 1);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_buckets() == SRSRAN_SUCCESS);
+  TESTASSERT(test_quantiles() == SRSRAN_SUCCESS);
+  TESTASSERT(test_concurrent_record() == SRSRAN_SUCCESS);
+  TESTASSERT(test_registry() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/security.h"
@@ -162,6 +163,59 @@ int test_set_2()
   return SRSRAN_SUCCESS;
 }
 
+/*
+  Batch Milenage, the first vector is test set 2 and the rest are checked against the single vector functions
+*/
+
+int test_milenage_batch()
+{
+  uint8_t k[]    = {0x46, 0x5b, 0x5c, 0xe8, 0xb1, 0x99, 0xb4, 0x9f, 0xaa, 0x5f, 0x0a, 0x2e, 0xe2, 0x38, 0xa6, 0xbc};
+  uint8_t rand[] = {0x23, 0x55, 0x3c, 0xbe, 0x96, 0x37, 0xa8, 0x9d, 0x21, 0x8a, 0xe6, 0x4d, 0xae, 0x47, 0xbf, 0x35};
+  uint8_t sqn[]  = {0xff, 0x9b, 0xb4, 0xd0, 0xb6, 0x07};
+  uint8_t amf[]  = {0xb9, 0xb9};
+  uint8_t opc[]  = {0xcd, 0x63, 0xcb, 0x71, 0x95, 0x4a, 0x9f, 0x4e, 0x48, 0xa5, 0x99, 0x4e, 0x37, 0xa0, 0x2b, 0xaf};
+
+  // Not a multiple of the number of vectors interleaved
+  srsran::milenage_vector_t vectors[19] = {};
+  memcpy(vectors[0].rand, rand, sizeof(rand));
+  memcpy(vectors[0].sqn, sqn, sizeof(sqn));
+  for (uint32_t i = 1; i < 19; i++) {
+    for (uint32_t j = 0; j < sizeof(vectors[i].rand); j++) {
+      vectors[i].rand[j] = (uint8_t)(rand[j] * (i + 1) + 31 * j);
+    }
+    memcpy(vectors[i].sqn, sqn, sizeof(sqn));
+    vectors[i].sqn[5] += 32 * i;
+  }
+  TESTASSERT(srsran::security_milenage_f12345_batch(k, opc, amf, vectors, 19) == SRSRAN_SUCCESS);
+
+  uint8_t mac_a[] = {0x4a, 0x9f, 0xfa, 0xc3, 0x54, 0xdf, 0xaf, 0xb3};
+  uint8_t res[]   = {0xa5, 0x42, 0x11, 0xd5, 0xe3, 0xba, 0x50, 0xbf};
+  uint8_t ck[]    = {0xb4, 0x0b, 0xa9, 0xa3, 0xc5, 0x8b, 0x2a, 0x05, 0xbb, 0xf0, 0xd9, 0x87, 0xb2, 0x1b, 0xf8, 0xcb};
+  uint8_t ik[]    = {0xf7, 0x69, 0xbc, 0xd7, 0x51, 0x04, 0x46, 0x04, 0x12, 0x76, 0x72, 0x71, 0x1c, 0x6d, 0x34, 0x41};
+  uint8_t ak[]    = {0xaa, 0x68, 0x9c, 0x64, 0x83, 0x70};
+  TESTASSERT(arrcmp(vectors[0].mac_a, mac_a, sizeof(mac_a)) == 0);
+  TESTASSERT(arrcmp(vectors[0].res, res, sizeof(res)) == 0);
+  TESTASSERT(arrcmp(vectors[0].ck, ck, sizeof(ck)) == 0);
+  TESTASSERT(arrcmp(vectors[0].ik, ik, sizeof(ik)) == 0);
+  TESTASSERT(arrcmp(vectors[0].ak, ak, sizeof(ak)) == 0);
+
+  for (uint32_t i = 1; i < 19; i++) {
+    uint8_t mac_o[8];
+    uint8_t res_o[8];
+    uint8_t ck_o[16];
+    uint8_t ik_o[16];
+    uint8_t ak_o[6];
+    TESTASSERT(liblte_security_milenage_f1(k, opc, vectors[i].rand, vectors[i].sqn, amf, mac_o) == LIBLTE_SUCCESS);
+    TESTASSERT(liblte_security_milenage_f2345(k, opc, vectors[i].rand, res_o, ck_o, ik_o, ak_o) == LIBLTE_SUCCESS);
+    TESTASSERT(arrcmp(vectors[i].mac_a, mac_o, sizeof(mac_o)) == 0);
+    TESTASSERT(arrcmp(vectors[i].res, res_o, sizeof(res_o)) == 0);
+    TESTASSERT(arrcmp(vectors[i].ck, ck_o, sizeof(ck_o)) == 0);
+    TESTASSERT(arrcmp(vectors[i].ik, ik_o, sizeof(ik_o)) == 0);
+    TESTASSERT(arrcmp(vectors[i].ak, ak_o, sizeof(ak_o)) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 /*
   Own test sets
 */
@@ -224,5 +278,6 @@ int main(int argc, char* argv[])
 
   TESTASSERT(test_set_2() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_xor_own_set_1() == SRSRAN_SUCCESS);
+  TESTASSERT(test_milenage_batch() == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
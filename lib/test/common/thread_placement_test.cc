@@ -0,0 +1,226 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/thread_placement.h"
+#include <fstream>
+#include <sys/stat.h>
+
+using namespace srsran;
+
+static void write_file(const std::string& path, const std::string& content)
+{
+  // Create the parent directories first
+  for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+    mkdir(path.substr(0, pos).c_str(), 0755);
+  }
+  std::ofstream file(path);
+  file << content << "\n";
+}
+
+/// Two sockets with a NUMA node and a LLC each, 4 cores per socket with 2 SMT siblings numbered as Linux does: CPUs 0-7
+/// are the first sibling of the 8 cores, CPUs 8-15 the second one
+static std::string create_dual_socket_sysfs()
+{
+  char  root_template[] = "/tmp/thread_placement_testXXXXXX";
+  char* root            = mkdtemp(root_template);
+  TESTASSERT(root != nullptr);
+  std::string sysfs = root;
+
+  write_file(sysfs + "/cpu/online", "0-15");
+  for (uint32_t cpu = 0; cpu < 16; cpu++) {
+    uint32_t    core     = cpu % 8;
+    uint32_t    socket   = core / 4;
+    std::string cpu_path = sysfs + "/cpu/cpu" + std::to_string(cpu);
+    write_file(cpu_path + "/topology/physical_package_id", std::to_string(socket));
+    write_file(cpu_path + "/topology/thread_siblings_list", std::to_string(core) + "," + std::to_string(core + 8));
+    write_file(cpu_path + "/cache/index0/level", "1");
+    write_file(cpu_path + "/cache/index0/type", "Data");
+    write_file(cpu_path + "/cache/index0/shared_cpu_list", std::to_string(core) + "," + std::to_string(core + 8));
+    write_file(cpu_path + "/cache/index1/level", "1");
+    write_file(cpu_path + "/cache/index1/type", "Instruction");
+    write_file(cpu_path + "/cache/index1/shared_cpu_list", std::to_string(core) + "," + std::to_string(core + 8));
+    write_file(cpu_path + "/cache/index2/level", "3");
+    write_file(cpu_path + "/cache/index2/type", "Unified");
+    write_file(cpu_path + "/cache/index2/shared_cpu_list", socket == 0 ? "0-3,8-11" : "4-7,12-15");
+  }
+  write_file(sysfs + "/node/online", "0-1");
+  write_file(sysfs + "/node/node0/cpulist", "0-3,8-11");
+  write_file(sysfs + "/node/node1/cpulist", "4-7,12-15");
+  return sysfs;
+}
+
+static std::string cpus_of(const thread_placement& placement, const std::string& role, uint32_t idx)
+{
+  cpu_set_t cpuset;
+  if (not placement.get_cpuset(role, idx, cpuset)) {
+    return "";
+  }
+  std::vector<uint32_t> cpus;
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &cpuset)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpu_topology::to_cpu_list(cpus);
+}
+
+int test_cpu_list()
+{
+  std::vector<uint32_t> cpus;
+  bool                  ret = cpu_topology::parse_cpu_list("0-3,8, 10-11", cpus);
+  TESTASSERT(ret);
+  TESTASSERT(cpus == std::vector<uint32_t>({0, 1, 2, 3, 8, 10, 11}));
+  TESTASSERT(cpu_topology::to_cpu_list(cpus) == "0-3,8,10-11");
+  ret = cpu_topology::parse_cpu_list("", cpus);
+  TESTASSERT(ret and cpus.empty());
+
+  for (const char* invalid : {"3-1", "a", "1-"}) {
+    ret = cpu_topology::parse_cpu_list(invalid, cpus);
+    TESTASSERT(not ret);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_discover(const cpu_topology& topo)
+{
+  TESTASSERT(topo.nof_cpus() == 16);
+  TESTASSERT(topo.nof_cores() == 8);
+  TESTASSERT(topo.nof_llcs() == 2);
+  TESTASSERT(topo.nof_nodes() == 2);
+  TESTASSERT(topo.nof_packages() == 2);
+
+  const cpu_info_t* info = topo.find_cpu(13);
+  TESTASSERT(info != nullptr);
+  TESTASSERT(info->core == 5);
+  TESTASSERT(info->llc == 4);
+  TESTASSERT(info->node == 1);
+  TESTASSERT(info->package == 1);
+
+  // Without sysfs every CPU is a core of its own
+  cpu_topology fallback = cpu_topology::discover("/nonexistent");
+  TESTASSERT(fallback.nof_cpus() > 0);
+  TESTASSERT(fallback.nof_cores() == fallback.nof_cpus());
+  TESTASSERT(fallback.nof_nodes() == 1);
+  return SRSRAN_SUCCESS;
+}
+
+int test_policy(const cpu_topology& topo)
+{
+  thread_placement placement;
+  bool             ret = placement.init("", topo);
+  TESTASSERT(ret);
+  TESTASSERT(not placement.is_enabled());
+  TESTASSERT(cpus_of(placement, "phy", 0).empty());
+  TESTASSERT(placement.get_node("phy", 0) == -1);
+
+  ret = placement.init("txrx:core, phy:core, prach:cpu, stack:node, log:any, gw:core@1, gtpu:12-13,15",
+                       topo,
+                       {{"txrx", 1}, {"phy", 2}, {"prach", 1}, {"gw", 1}});
+  TESTASSERT(ret);
+  TESTASSERT(placement.is_enabled());
+
+  // The cores leave their SMT sibling idle, the CPU rule takes the first free CPU
+  TESTASSERT(cpus_of(placement, "txrx", 0) == "0");
+  TESTASSERT(cpus_of(placement, "phy", 0) == "1");
+  TESTASSERT(cpus_of(placement, "phy", 1) == "2");
+  TESTASSERT(cpus_of(placement, "prach", 0) == "3");
+  TESTASSERT(cpus_of(placement, "gw", 0) == "4");
+  TESTASSERT(placement.get_node("gw", 0) == 1);
+
+  // The shared rules and the extra threads get what is left
+  TESTASSERT(cpus_of(placement, "stack", 0) == "11");
+  TESTASSERT(cpus_of(placement, "stack", 3) == "11");
+  TESTASSERT(cpus_of(placement, "phy", 2) == "11");
+  TESTASSERT(cpus_of(placement, "log", 0) == "5-7,11,13-15");
+  TESTASSERT(cpus_of(placement, "gtpu", 0) == "12-13,15");
+  TESTASSERT(placement.get_node("gtpu", 0) == 1);
+
+  // Roles missing from the policy are not pinned
+  TESTASSERT(cpus_of(placement, "sync", 0).empty());
+  TESTASSERT(placement.to_string().find("phy[1]") != std::string::npos);
+
+  // Running out of cores in the node, the rest of the threads share it
+  ret = placement.init("phy:core@1", topo, {{"phy", 6}});
+  TESTASSERT(ret);
+  TESTASSERT(cpus_of(placement, "phy", 3) == "7");
+  TESTASSERT(cpus_of(placement, "phy", 4) == "4-7,12-15");
+
+  // Invalid policies leave the placement disabled
+  for (const char* invalid : {"foo:core", "phy:socket", "phy:core@2", "phy:core,phy:cpu", "phy:16", "phy"}) {
+    ret = placement.init(invalid, topo);
+    TESTASSERT(not ret);
+    TESTASSERT(not placement.is_enabled());
+  }
+
+  ret = placement.init("auto", topo, {{"txrx", 1}, {"phy", 3}, {"stack", 1}});
+  TESTASSERT(ret);
+  TESTASSERT(cpus_of(placement, "phy", 2) == "3");
+  // No core left in the node of the radio for the stack
+  TESTASSERT(cpus_of(placement, "stack", 0) == "0-3,8-11");
+  return SRSRAN_SUCCESS;
+}
+
+class affinity_thread : public thread
+{
+public:
+  affinity_thread() : thread("AFFINITY_TEST") {}
+  cpu_set_t cpuset;
+
+protected:
+  void run_thread() override { pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset); }
+};
+
+int test_start_thread()
+{
+  // Pin a thread to the first CPU of the host
+  cpu_topology     topo = cpu_topology::discover();
+  thread_placement placement;
+  std::string      first_cpu = std::to_string(topo.get_cpus().front().cpu);
+  bool             ret       = placement.init("stack:" + first_cpu, topo);
+  TESTASSERT(ret);
+
+  affinity_thread t;
+  ret = placement.start(t, "stack", 0, -1);
+  TESTASSERT(ret);
+  t.wait_thread_finish();
+  TESTASSERT(CPU_COUNT(&t.cpuset) == 1);
+  TESTASSERT(CPU_ISSET(topo.get_cpus().front().cpu, &t.cpuset));
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  std::string  sysfs = create_dual_socket_sysfs();
+  cpu_topology topo  = cpu_topology::discover(sysfs);
+  int          ret   = SRSRAN_SUCCESS;
+  if (test_cpu_list() != SRSRAN_SUCCESS or test_discover(topo) != SRSRAN_SUCCESS or
+      test_policy(topo) != SRSRAN_SUCCESS or test_start_thread() != SRSRAN_SUCCESS) {
+    ret = SRSRAN_ERROR;
+  }
+  if (system(("rm -rf " + sysfs).c_str()) != 0) {
+    printf("Could not remove %s\n", sysfs.c_str());
+  }
+  if (ret == SRSRAN_SUCCESS) {
+    printf("Success\n");
+  }
+  return ret;
+}
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/timers.h"
+#include "srsran/support/srsran_test.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+static uint32_t nof_timers  = 10000;
+static uint32_t nof_threads = 3;
+static uint32_t duration_ms = 500;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ntd]\n", prog);
+  printf("\t-n Number of timers [Default %d]\n", nof_timers);
+  printf("\t-t Number of threads starting and stopping timers besides the stack thread [Default %d]\n", nof_threads);
+  printf("\t-d Duration of the multithreaded test in ms [Default %d]\n", duration_ms);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "ntd")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_timers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        duration_ms = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_s(std::chrono::steady_clock::time_point tp)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - tp).count();
+}
+
+/// Starts and stops every timer from the stack thread, as RLC and PDCP do on every PDU
+static void benchmark_start_stop()
+{
+  timer_handler             timers(nof_timers);
+  std::vector<unique_timer> t(nof_timers);
+  for (uint32_t i = 0; i < nof_timers; i++) {
+    t[i] = timers.get_unique_timer();
+    t[i].set(10 + i % 1000);
+  }
+
+  const uint32_t nof_rounds = 100;
+  auto           tp         = std::chrono::steady_clock::now();
+  for (uint32_t round = 0; round < nof_rounds; round++) {
+    for (unique_timer& u : t) {
+      u.run();
+    }
+    timers.step_all();
+    for (unique_timer& u : t) {
+      u.stop();
+    }
+    timers.step_all();
+  }
+  double secs = elapsed_s(tp);
+  TESTASSERT(timers.nof_running_timers() == 0);
+
+  printf("Start/stop of %d timers: %.1f Mops/s\n", nof_timers, 2.0 * nof_rounds * nof_timers / secs / 1e6);
+}
+
+/// Lets every timer expire with a random duration, restarting it from its callback
+static void benchmark_expiry()
+{
+  timer_handler             timers(nof_timers);
+  std::vector<unique_timer> t(nof_timers);
+  std::mt19937              rng(1234);
+  uint64_t                  nof_expired = 0;
+  for (uint32_t i = 0; i < nof_timers; i++) {
+    t[i] = timers.get_unique_timer();
+    t[i].set(1 + rng() % 2000, [&t, &nof_expired](uint32_t tid) {
+      nof_expired++;
+      t[tid].run();
+    });
+    t[i].run();
+  }
+
+  const uint32_t nof_tics = 20000;
+  auto           tp       = std::chrono::steady_clock::now();
+  for (uint32_t tic = 0; tic < nof_tics; tic++) {
+    timers.step_all();
+  }
+  double secs = elapsed_s(tp);
+  TESTASSERT(nof_expired > 0);
+  TESTASSERT(timers.nof_running_timers() == nof_timers);
+
+  printf("Expiry of %d timers: %.1f us/tic, %.1f M expirations/s\n",
+         nof_timers,
+         secs * 1e6 / nof_tics,
+         nof_expired / secs / 1e6);
+}
+
+/// Starts and stops timers from several threads while the stack thread steps the time
+static void benchmark_multithread()
+{
+  timer_handler             timers(nof_timers);
+  std::vector<unique_timer> t(nof_timers);
+  for (uint32_t i = 0; i < nof_timers; i++) {
+    t[i] = timers.get_unique_timer();
+    t[i].set(5 + i % 100);
+  }
+
+  std::atomic<bool>        run{true};
+  std::atomic<uint64_t>    nof_ops{0};
+  std::vector<std::thread> threads;
+  for (uint32_t th = 0; th < nof_threads; th++) {
+    threads.emplace_back([&, th]() {
+      uint64_t ops = 0;
+      while (run) {
+        for (uint32_t i = th; i < nof_timers; i += nof_threads) {
+          if (ops % 3 == 0) {
+            t[i].stop();
+          } else {
+            t[i].run();
+          }
+          ops++;
+        }
+      }
+      nof_ops += ops;
+    });
+  }
+
+  // The stack thread steps the time and restarts its own timers
+  uint64_t nof_tics = 0;
+  auto     tp       = std::chrono::steady_clock::now();
+  while (elapsed_s(tp) * 1e3 < duration_ms) {
+    timers.step_all();
+    nof_tics++;
+  }
+  run = false;
+  for (std::thread& th : threads) {
+    th.join();
+  }
+  double secs = elapsed_s(tp);
+
+  printf("Start/stop of %d timers from %d threads: %.1f Mops/s, stack thread at %.0f ktics/s\n",
+         nof_timers,
+         nof_threads,
+         nof_ops / secs / 1e6,
+         nof_tics / secs / 1e3);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  benchmark_start_stop();
+  benchmark_expiry();
+  benchmark_multithread();
+
+  printf("Success\n");
+  return 0;
+}
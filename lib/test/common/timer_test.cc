@@ -21,6 +21,7 @@
 
 #include "srsran/common/timers.h"
 #include "srsran/support/srsran_test.h"
+#include <atomic>
 #include <iostream>
 #include <random>
 #include <srsran/common/tti_sync_cv.h>
@@ -448,6 +449,83 @@ void timers_test7()
   TESTASSERT(timers.nof_running_timers() == 1 and timers.nof_timers() == 3);
 }
 
+/**
+ * Description: Callbacks set by another thread while step_all() is running
+ */
+void timers_test8()
+{
+  timer_handler             timers;
+  const uint32_t            nof_timers = 16, nof_rounds = 2000;
+  std::vector<unique_timer> utimers;
+  std::vector<uint32_t>     last_cb(nof_timers, 0);
+  std::atomic<uint32_t>     nof_calls{0};
+  std::atomic<bool>         stop{false};
+
+  for (uint32_t i = 0; i < nof_timers; i++) {
+    utimers.push_back(timers.get_unique_timer());
+  }
+
+  // The first step_all() makes this thread the owner of the timers
+  timers.step_all();
+
+  std::thread thread([&]() {
+    for (uint32_t r = 1; r <= nof_rounds; r++) {
+      for (uint32_t i = 0; i < nof_timers; i++) {
+        utimers[i].set(1 + r % 3, [&nof_calls, &last_cb, i, r](uint32_t tid) {
+          last_cb[i] = r;
+          nof_calls++;
+        });
+        utimers[i].run();
+      }
+    }
+    stop = true;
+  });
+
+  while (not stop) {
+    timers.step_all();
+  }
+  thread.join();
+
+  // The callbacks installed last must be the ones called
+  for (uint32_t d = 0; d < 4; d++) {
+    timers.step_all();
+  }
+  TESTASSERT(nof_calls > 0);
+  for (uint32_t i = 0; i < nof_timers; i++) {
+    TESTASSERT(utimers[i].is_expired());
+    TESTASSERT(last_cb[i] == nof_rounds);
+  }
+  TESTASSERT(timers.nof_running_timers() == 0);
+}
+
+/**
+ * Description: A timer started by another thread keeps the timers active before step_all() counts it as running
+ */
+void timers_test9()
+{
+  timer_handler timers;
+  unique_timer  t = timers.get_unique_timer();
+  timers.step_all();
+  TESTASSERT(not timers.has_running_timers());
+
+  std::thread thread([&t]() {
+    t.set(2);
+    t.run();
+  });
+  thread.join();
+  TESTASSERT(timers.nof_running_timers() == 0);
+  TESTASSERT(timers.has_running_timers());
+  TESTASSERT(t.is_running());
+
+  timers.step_all();
+  TESTASSERT(timers.nof_running_timers() == 1);
+  TESTASSERT(timers.has_running_timers());
+  timers.step_all();
+  timers.step_all();
+  TESTASSERT(t.is_expired());
+  TESTASSERT(not timers.has_running_timers());
+}
+
 int main()
 {
   timers_test1();
@@ -457,6 +535,8 @@ int main()
   timers_test5();
   timers_test6();
   timers_test7();
+  timers_test8();
+  timers_test9();
   printf("Success\n");
   return 0;
 }
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/tti_deadline_monitor.h"
+#include <thread>
+
+using namespace srsran;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+int test_stage_timer()
+{
+  tti_stage_times_t times;
+  {
+    tti_stage_timer fft_timer(times, tti_stage_t::fft);
+    std::this_thread::sleep_for(milliseconds(2));
+  }
+  tti_stage_timer encode_timer(times, tti_stage_t::encode);
+  encode_timer.stop();
+  // Stopping again, or at the end of the scope, adds nothing
+  encode_timer.stop();
+
+  TESTASSERT(times.us[(uint32_t)tti_stage_t::fft] >= 2000);
+  TESTASSERT(times.us[(uint32_t)tti_stage_t::decode] == 0);
+  TESTASSERT(times.us[(uint32_t)tti_stage_t::encode] < 1000);
+  TESTASSERT(std::string(to_string(tti_stage_t::decode)) == "decode");
+  return SRSRAN_SUCCESS;
+}
+
+int test_slack()
+{
+  auto&                  logger = srslog::fetch_basic_logger("TEST", false);
+  tti_deadline_monitor   monitor(logger, 4);
+  tti_deadline_metrics_t metrics;
+  tti_stage_times_t      stages;
+  stages.us = {100, 200, 50, 300};
+
+  // Nothing released yet
+  monitor.get_metrics(metrics);
+  TESTASSERT(metrics.nof_ttis == 0 and metrics.nof_late == 0);
+
+  for (uint32_t tti = 0; tti < 10; tti++) {
+    int32_t slack = monitor.release(tti, true, steady_clock::now() + milliseconds(3), stages);
+    TESTASSERT(slack > 2000 and slack <= 3000);
+  }
+  int32_t slack = monitor.release(10, true, steady_clock::now() - milliseconds(1), stages);
+  TESTASSERT(slack <= -1000);
+  monitor.release(11, false, steady_clock::now() - milliseconds(1), stages);
+
+  monitor.get_metrics(metrics);
+  TESTASSERT(metrics.nof_ttis == 12);
+  TESTASSERT(metrics.nof_late == 2);
+  TESTASSERT(metrics.nof_late_total == 2);
+  TESTASSERT(metrics.min_slack_us <= -1000);
+  TESTASSERT(metrics.avg_slack_us > 1000);
+  TESTASSERT(metrics.avg_stage_us[(uint32_t)tti_stage_t::encode] == 300);
+  TESTASSERT(metrics.max_stage_us[(uint32_t)tti_stage_t::decode] == 200);
+
+  // The period restarts, the total count of late TTIs does not
+  monitor.release(12, true, steady_clock::now() + milliseconds(3), stages);
+  monitor.get_metrics(metrics);
+  TESTASSERT(metrics.nof_ttis == 1);
+  TESTASSERT(metrics.nof_late == 0);
+  TESTASSERT(metrics.nof_late_total == 2);
+  TESTASSERT(monitor.get_nof_late_total() == 2);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+  TESTASSERT(test_stage_timer() == SRSRAN_SUCCESS);
+  TESTASSERT(test_slack() == SRSRAN_SUCCESS);
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
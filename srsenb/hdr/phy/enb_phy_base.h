@@ -28,6 +28,7 @@
 #define SRSENB_PHY_BASE_H
 
 #include "srsenb/hdr/phy/phy_metrics.h"
+#include "srsran/common/tti_deadline_monitor.h"
 #include <vector>
 
 namespace srsenb {
@@ -46,6 +47,10 @@ public:
 
   virtual void get_metrics(std::vector<phy_metrics_t>& m) = 0;
 
+  virtual void get_deadline_metrics(srsran::tti_deadline_metrics_t& m) = 0;
+
+  virtual void get_nr_pipeline_metrics(phy_nr_pipeline_metrics_t& m) = 0;
+
   virtual void cmd_cell_gain(uint32_t cell_idx, float gain_db) = 0;
 
   virtual void cmd_cell_measure() = 0;
@@ -55,11 +55,15 @@ public:
   int  read_pucch_d(cf_t* pusch_d);
   void start_plot();
 
-  void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
+  /// The time spent in every processing stage is added to stage_times
+  void work_ul(const srsran_ul_sf_cfg_t&            ul_sf,
+               stack_interface_phy_lte::ul_sched_t& ul_grants,
+               srsran::tti_stage_times_t&           stage_times);
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
-               srsran_mbsfn_cfg_t*                  mbsfn_cfg);
+               srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+               srsran::tti_stage_times_t&           stage_times);
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
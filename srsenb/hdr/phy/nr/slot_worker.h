@@ -27,6 +27,7 @@
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include <array>
 
 namespace srsenb {
 namespace nr {
@@ -34,12 +35,25 @@ namespace nr {
 /**
  * The slot_worker class handles the PHY processing, UL and DL procedures associated with 1 slot.
  *
- * A slot_worker object is executed by a thread within the thread_pool.
+ * A slot_worker object is executed by a thread within the thread_pool. The processing of a slot is split in two stages:
+ * the DL stage encodes the slot and the UL stage decodes the received slot. The scheduling results are retrieved and
+ * the UL results are delivered to the stack in slot order, through the sync_interface.
+ *
+ * By default the UL stage runs first, so the stack gets the UL results, such as HARQ-ACK and CRC, before it schedules
+ * the DL slot of the worker, as the scheduler expects. With pipeline_ul the DL stage runs first and releases the slot
+ * to the radio, then the UL stage runs while the next workers of the pool encode the following slots. The UL results
+ * reach the stack after the scheduling of the DL slot, and up to the number of workers minus one slots later, since a
+ * worker is not reused before its UL stage ends. The scheduler takes the HARQ-ACK missing by then as a NACK, so the DL
+ * transport blocks acknowledged late are retransmitted and the UL retransmissions are scheduled before their CRC.
  */
 
 class slot_worker final : public srsran::thread_pool::worker
 {
 public:
+  /// Pipeline stages of a slot, the DL one ends when the slot is ready for the radio and the UL one when the UL results
+  /// are delivered to the stack
+  enum class stage_t { dl = 0, ul, nof_stages };
+
   /**
    * @brief Slot worker synchronization interface
    */
@@ -56,18 +70,38 @@ public:
      * @brief Releases the current worker
      */
     virtual void release() = 0;
+
+    /**
+     * @brief Wait for the workers of the previous slots to deliver their UL results to the stack
+     * @param w Worker pointer
+     */
+    virtual void wait_ul(slot_worker* w) = 0;
+
+    /**
+     * @brief Releases the UL results delivery of the current worker
+     */
+    virtual void release_ul() = 0;
+
+    /**
+     * @brief Accounts the end of a processing stage of a slot against the TX deadline of the slot
+     * @param stage Processing stage
+     * @param w_ctx Worker context, holding the deadline and the time spent in every step
+     */
+    virtual void stage_end(stage_t stage, const srsran::phy_common_interface::worker_context_t& w_ctx) = 0;
   };
 
   struct args_t {
-    uint32_t                    cell_index       = 0;
-    uint32_t                    nof_max_prb      = SRSRAN_MAX_PRB_NR;
-    uint32_t                    nof_tx_ports     = 1;
-    uint32_t                    nof_rx_ports     = 1;
-    uint32_t                    rf_port          = 0;
-    srsran_subcarrier_spacing_t scs              = srsran_subcarrier_spacing_15kHz;
-    uint32_t                    pusch_max_its    = 10;
-    float                       pusch_min_snr_dB = -10.0f;
-    double                      srate_hz         = 0.0;
+    uint32_t                    cell_index        = 0;
+    uint32_t                    nof_max_prb       = SRSRAN_MAX_PRB_NR;
+    uint32_t                    nof_tx_ports      = 1;
+    uint32_t                    nof_rx_ports      = 1;
+    uint32_t                    rf_port           = 0;
+    srsran_subcarrier_spacing_t scs               = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    pusch_max_its     = 10;
+    uint32_t                    pusch_dec_threads = 0; ///< Threads decoding the PUSCH code blocks, 0 or 1 for none
+    float                       pusch_min_snr_dB  = -10.0f;
+    double                      srate_hz          = 0.0;
+    bool                        pipeline_ul       = false; ///< Runs the UL stage after releasing the slot to the radio
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -95,13 +129,23 @@ private:
   void work_imp() override;
 
   /**
-   * @brief Retrieves the scheduling results for the UL processing and performs reception
+   * @brief Performs the reception of the UL scheduling results copied by work_dl, keeping the decoded results
    * @return True if no error occurs, false otherwise
    */
   bool work_ul();
 
   /**
-   * @brief Retrieves the scheduling results for the DL processing and performs transmission
+   * @brief Delivers the decoded UL results to the stack, to be called in slot order
+   */
+  void deliver_ul();
+
+  /**
+   * @brief Runs the UL stage, decoding the slot and delivering its results once the previous slots delivered theirs
+   */
+  void ul_stage();
+
+  /**
+   * @brief Retrieves the scheduling results in slot order, the UL ones if pipelined, and performs the DL transmission
    * @return True if no error occurs, false otherwise
    */
   bool work_dl();
@@ -123,6 +167,37 @@ private:
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
+
+  bool pipeline_ul = false; ///< Runs the UL stage after the DL one, see the class description
+
+  /// PUCCH grant, with the candidates in a fixed array so that copying it does not construct them
+  struct pucch_grant_t {
+    srsran_pucch_nr_common_cfg_t                                                                        pucch_cfg;
+    std::array<stack_interface_phy_nr::pucch_candidate_t, stack_interface_phy_nr::MAX_PUCCH_CANDIDATES> candidates;
+    uint32_t                                                                                            nof_candidates;
+  };
+
+  /// UL grants of the slot. They are copied, as the stack reuses its results once the following slots are scheduled.
+  /// Only the grants in use are copied, and of their UCI configuration only the HARQ-ACK bits and CSI reports in use
+  std::array<stack_interface_phy_nr::pusch_t, stack_interface_phy_nr::MAX_GRANTS> pusch_grants     = {};
+  std::array<pucch_grant_t, stack_interface_phy_nr::MAX_GRANTS>                  pucch_grants     = {};
+  uint32_t                                                                       nof_pusch_grants = 0;
+  uint32_t                                                                       nof_pucch_grants = 0;
+  bool                                                                           ul_sched_valid   = false;
+
+  /**
+   * @brief Retrieves the UL scheduling results of the slot from the stack and copies its grants
+   */
+  void get_ul_grants();
+
+  /**
+   * @brief Copies the UL grants of the stack into the worker
+   */
+  void copy_ul_grants(const stack_interface_phy_nr::ul_sched_t& ul_sched);
+
+  /// UL results of the slot, kept until the previous slots deliver theirs
+  srsran::bounded_vector<stack_interface_phy_nr::pucch_info_t, stack_interface_phy_nr::MAX_GRANTS> pucch_res;
+  srsran::bounded_vector<stack_interface_phy_nr::pusch_info_t, stack_interface_phy_nr::MAX_GRANTS> pusch_res;
 };
 
 } // namespace nr
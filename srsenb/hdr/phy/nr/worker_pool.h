@@ -24,6 +24,7 @@
 
 #include "slot_worker.h"
 #include "srsenb/hdr/phy/phy_interfaces.h"
+#include "srsenb/hdr/phy/phy_metrics.h"
 #include "srsenb/hdr/phy/prach_worker.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/common/tti_sempahore.h"
@@ -37,8 +38,14 @@ class worker_pool final : private slot_worker::sync_interface
 {
 private:
   srsran::tti_semaphore<slot_worker*> slot_sync; ///< Slot synchronization semaphore
+  srsran::tti_semaphore<slot_worker*> ul_sync;   ///< Slot order of the UL results delivery to the stack
   void                                wait(slot_worker* w) override { slot_sync.wait(w); }
   void                                release() override { slot_sync.release(); }
+  void                                wait_ul(slot_worker* w) override { ul_sync.wait(w); }
+  void                                release_ul() override { ul_sync.release(); }
+
+  /// Accounts the slack of the stages in their own monitors, besides the common one of the radio release
+  void stage_end(slot_worker::stage_t stage, const srsran::phy_common_interface::worker_context_t& w_ctx) override;
 
   class prach_stack_adaptor_t : public stack_interface_phy_lte
   {
@@ -98,6 +105,8 @@ private:
   prach_stack_adaptor_t                      prach_stack_adaptor;
   uint32_t                                   nof_prach_workers = 0;
   double                                     srate_hz          = 0.0; ///< Current sampling rate in Hz
+  srsran::tti_deadline_monitor               dl_monitor;              ///< Slack of the DL stage to the TX deadline
+  srsran::tti_deadline_monitor               ul_monitor;              ///< Slack of the UL stage to the TX deadline
 
 public:
   struct args_t {
@@ -106,6 +115,8 @@ public:
     uint32_t               nof_prach_workers = 0;
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
+    uint32_t               pusch_dec_threads = 0;
+    bool                   pipeline_ul       = false;
     float                  pusch_min_snr_dB  = -10;
     srsran::phy_log_args_t log               = {};
   };
@@ -121,6 +132,7 @@ public:
   void         start_worker(slot_worker* w);
   void         stop();
   int          set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg);
+  void         get_metrics(phy_nr_pipeline_metrics_t& metrics);
 };
 
 } // namespace nr
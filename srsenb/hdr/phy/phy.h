@@ -73,6 +73,8 @@ public:
   void complete_config(uint16_t rnti) override;
 
   void get_metrics(std::vector<phy_metrics_t>& metrics) override;
+  void get_deadline_metrics(srsran::tti_deadline_metrics_t& metrics) override;
+  void get_nr_pipeline_metrics(phy_nr_pipeline_metrics_t& metrics) override;
 
   void cmd_cell_gain(uint32_t cell_id, float gain_db) override;
   void cmd_cell_measure() override;
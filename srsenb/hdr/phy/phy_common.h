@@ -58,6 +58,11 @@ public:
    */
   srsran::tti_semaphore<void*> semaphore;
 
+  /**
+   * Slack of the workers to the TX deadline, accounted when they release their TTI in worker_end
+   */
+  srsran::tti_deadline_monitor deadline_monitor{srslog::fetch_basic_logger("PHY")};
+
   /**
    * Performs common end worker transmission tasks such as transmission and stack TTI execution
    *
@@ -22,6 +22,7 @@
 #ifndef SRSENB_PHY_METRICS_H
 #define SRSENB_PHY_METRICS_H
 
+#include "srsran/common/tti_deadline_monitor.h"
 #include <limits>
 
 namespace srsenb {
@@ -53,6 +54,13 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// Slack of the pipeline stages of the NR slot workers to the TX deadline of their slot
+
+struct phy_nr_pipeline_metrics_t {
+  srsran::tti_deadline_metrics_t dl; ///< Up to the slot being ready for the radio
+  srsran::tti_deadline_metrics_t ul; ///< Up to the delivery of the UL results to the stack
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
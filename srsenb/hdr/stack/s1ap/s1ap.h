@@ -164,6 +164,7 @@ private:
   bool handle_successfuloutcome(const asn1::s1ap::successful_outcome_s& msg);
   bool handle_unsuccessfuloutcome(const asn1::s1ap::unsuccessful_outcome_s& msg);
   bool handle_paging(const asn1::s1ap::paging_s& msg);
+  bool handle_paging(const asn1::ap_pdu_view& msg);
 
   bool handle_s1setupresponse(const asn1::s1ap::s1_setup_resp_s& msg);
 
@@ -359,6 +360,7 @@ private:
   };
 
   ue*         handle_s1apmsg_ue_id(uint32_t enb_id, uint32_t mme_id);
+  bool        check_ue_s1ap_ids(const asn1::ap_pdu_view& msg);
   std::string get_cause(const asn1::s1ap::cause_c& c);
   void        log_s1ap_msg(const asn1::s1ap::s1ap_pdu_c& msg, srsran::const_span<uint8_t> sdu, bool is_rx);
 
@@ -212,6 +212,8 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_deadline_metrics(m->phy_deadline);
+  phy->get_nr_pipeline_metrics(m->phy_nr_pipeline);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
@@ -220,6 +222,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   m->running = true;
   m->sys     = sys_proc.get_metrics();
+  srsran::latency_histogram_registry::get_instance().get_metrics(m->latency);
   return true;
 }
 
@@ -29,6 +29,8 @@
 #include "srsran/common/common_helper.h"
 #include "srsran/common/config_file.h"
 #include "srsran/common/crash_handler.h"
+#include "srsran/common/latency_histogram.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/common/tsan_options.h"
 #include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
@@ -112,6 +114,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.device_name",       bpo::value<string>(&args->rf.device_name)->default_value("auto"),       "Front-end device name")
     ("rf.device_args",       bpo::value<string>(&args->rf.device_args)->default_value("auto"),       "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
+    ("rf.resampler",         bpo::value<string>(&args->rf.resampler)->default_value("fft"), "Resampler used when the fixed sampling rate differs from the cell rate (fft/poly). The polyphase resampler supports fractional ratios")
 
     ("gui.enable",        bpo::value<bool>(&args->gui.enable)->default_value(false),          "Enable GUI plots")
 
@@ -255,6 +258,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.stdout_ts_enable", bpo::value<bool>(&stdout_ts_enable)->default_value(false), "Prints once per second the timestamp into stdout.")
     ("expert.rrc_inactivity_timer", bpo::value<uint32_t>(&args->general.rrc_inactivity_timer)->default_value(30000), "Inactivity timer in ms.")
     ("expert.print_buffer_state", bpo::value<bool>(&args->general.print_buffer_state)->default_value(false), "Prints on the console the buffer state every 10 seconds.")
+    ("expert.thread_placement", bpo::value<string>(&args->general.thread_placement)->default_value(""), "CPU placement of the threads by role, as a list of role:rule[@node] (core, cpu, node, any or a CPU list), or auto. Empty for no placement.")
     ("expert.eea_pref_list", bpo::value<string>(&args->general.eea_pref_list)->default_value("EEA0, EEA2, EEA1"), "Ordered preference list for the selection of encryption algorithm (EEA) (default: EEA0, EEA2, EEA1).")
     ("expert.eia_pref_list", bpo::value<string>(&args->general.eia_pref_list)->default_value("EIA2, EIA1, EIA0"), "Ordered preference list for the selection of integrity algorithm (EIA) (default: EIA2, EIA1, EIA0).")
     ("expert.nof_prealloc_ues", bpo::value<uint32_t>(&args->stack.mac.nof_prealloc_ues)->default_value(8), "Number of UE resources to preallocate during eNB initialization.")
@@ -286,7 +290,11 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_policy", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy)->default_value("time_rr"), "NR DL and UL data scheduling policy (E.g. time_rr, time_pf)")
+    ("scheduler.nr_policy_args", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy_args)->default_value("1"), "NR scheduler policy-specific arguments")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
+    ("expert.nr_pusch_dec_threads", bpo::value<uint32_t>(&args->phy.nr_pusch_dec_threads)->default_value(0), "Number of threads decoding the NR PUSCH code blocks of each PHY worker, 0 or 1 for the worker thread only.")
+    ("expert.nr_pipeline_ul", bpo::value<bool>(&args->phy.nr_pipeline_ul)->default_value(false), "Decode the NR UL slot after releasing the DL slot to the radio. The scheduler gets the HARQ feedback late and retransmits.")
   ;
 
   // Positional options - config file location
@@ -632,8 +640,27 @@ int main(int argc, char* argv[])
   }
 #endif
 
+  // Place the threads on the CPUs before any of them is created
+  if (not args.general.thread_placement.empty()) {
+    srsran::thread_placement&       placement   = srsran::get_thread_placement();
+    std::map<std::string, uint32_t> nof_threads = {{"txrx", 1},
+                                                   {"phy", args.phy.nof_phy_threads},
+                                                   {"phy_nr", args.phy.nof_phy_threads},
+                                                   {"prach", args.phy.nof_prach_threads},
+                                                   {"stack", 1},
+                                                   {"gtpu", 1},
+                                                   {"log", 1}};
+    if (not placement.init(args.general.thread_placement, srsran::cpu_topology::discover(), nof_threads)) {
+      return SRSRAN_ERROR;
+    }
+    srsran::console("%s", placement.to_string().c_str());
+  }
+
   // Start the log backend.
-  srslog::init();
+  {
+    srsran::scoped_thread_affinity log_affinity("log");
+    srslog::init();
+  }
 
   srslog::fetch_basic_logger("ALL").set_level(srslog::basic_levels::warning);
   srslog::fetch_basic_logger("POOL").set_level(srslog::basic_levels::warning);
@@ -679,6 +706,8 @@ int main(int argc, char* argv[])
   srsenb::metrics_json json_metrics(json_channel, enb.get());
   if (args.general.report_json_enable) {
     metricshub.add_listener(&json_metrics);
+    // The latency histograms are only exported in the JSON metrics
+    srsran::latency_histogram_registry::get_instance().set_enabled(true);
   }
 
   // create input thread
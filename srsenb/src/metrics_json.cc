@@ -95,13 +95,68 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// Latency histogram container metrics.
+DECLARE_METRIC("name", metric_latency_name, std::string, "");
+DECLARE_METRIC("count", metric_latency_count, uint64_t, "");
+DECLARE_METRIC("mean_us", metric_latency_mean, double, "");
+DECLARE_METRIC("p50_us", metric_latency_p50, double, "");
+DECLARE_METRIC("p99_us", metric_latency_p99, double, "");
+DECLARE_METRIC("p999_us", metric_latency_p999, double, "");
+DECLARE_METRIC("max_us", metric_latency_max, double, "");
+DECLARE_METRIC_SET("latency_container",
+                   mset_latency_container,
+                   metric_latency_name,
+                   metric_latency_count,
+                   metric_latency_mean,
+                   metric_latency_p50,
+                   metric_latency_p99,
+                   metric_latency_p999,
+                   metric_latency_max);
+
+/// PHY deadline container metrics.
+DECLARE_METRIC("name", metric_stage_name, std::string, "");
+DECLARE_METRIC("avg_us", metric_stage_avg, float, "");
+DECLARE_METRIC("max_us", metric_stage_max, uint32_t, "");
+DECLARE_METRIC_SET("stage_container", mset_stage_container, metric_stage_name, metric_stage_avg, metric_stage_max);
+DECLARE_METRIC("nof_ttis", metric_nof_ttis, uint64_t, "");
+DECLARE_METRIC("nof_late", metric_nof_late, uint64_t, "");
+DECLARE_METRIC("nof_late_total", metric_nof_late_total, uint64_t, "");
+DECLARE_METRIC("avg_slack_us", metric_avg_slack, float, "");
+DECLARE_METRIC("min_slack_us", metric_min_slack, int32_t, "");
+DECLARE_METRIC_LIST("stage_list", mlist_stages, std::vector<mset_stage_container>);
+DECLARE_METRIC_SET("phy_deadline",
+                   mset_phy_deadline,
+                   metric_nof_ttis,
+                   metric_nof_late,
+                   metric_nof_late_total,
+                   metric_avg_slack,
+                   metric_min_slack,
+                   mlist_stages);
+
+/// NR PHY pipeline stage container metrics.
+DECLARE_METRIC_SET("pipeline_stage_container",
+                   mset_pipeline_stage_container,
+                   metric_stage_name,
+                   metric_nof_ttis,
+                   metric_nof_late,
+                   metric_nof_late_total,
+                   metric_avg_slack,
+                   metric_min_slack);
+DECLARE_METRIC_LIST("phy_nr_pipeline", mlist_nr_pipeline, std::vector<mset_pipeline_stage_container>);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
+DECLARE_METRIC_LIST("latency_list", mlist_latency, std::vector<mset_latency_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag,
+                                                    metric_timestamp_tag,
+                                                    mlist_cell,
+                                                    mset_phy_deadline,
+                                                    mlist_nr_pipeline,
+                                                    mlist_latency>;
 
 } // namespace
 
@@ -238,6 +293,51 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // Slack of the PHY workers to the TX deadline over the period.
+  auto& deadline = ctx.get<mset_phy_deadline>();
+  deadline.write<metric_nof_ttis>(m.phy_deadline.nof_ttis);
+  deadline.write<metric_nof_late>(m.phy_deadline.nof_late);
+  deadline.write<metric_nof_late_total>(m.phy_deadline.nof_late_total);
+  deadline.write<metric_avg_slack>(m.phy_deadline.avg_slack_us);
+  deadline.write<metric_min_slack>(m.phy_deadline.min_slack_us);
+  for (uint32_t i = 0; i < srsran::nof_tti_stages; ++i) {
+    deadline.get<mlist_stages>().emplace_back();
+    auto& stage = deadline.get<mlist_stages>().back();
+    stage.write<metric_stage_name>(srsran::to_string(static_cast<srsran::tti_stage_t>(i)));
+    stage.write<metric_stage_avg>(m.phy_deadline.avg_stage_us[i]);
+    stage.write<metric_stage_max>(m.phy_deadline.max_stage_us[i]);
+  }
+
+  // Slack of the DL and UL stages of the NR slot workers to the TX deadline over the period.
+  const phy_nr_pipeline_metrics_t& pipeline = m.phy_nr_pipeline;
+  if (pipeline.dl.nof_ttis > 0 or pipeline.ul.nof_ttis > 0) {
+    const std::pair<const char*, const srsran::tti_deadline_metrics_t*> pipeline_stages[] = {{"dl", &pipeline.dl},
+                                                                                            {"ul", &pipeline.ul}};
+    for (const auto& it : pipeline_stages) {
+      ctx.get<mlist_nr_pipeline>().emplace_back();
+      auto& stage = ctx.get<mlist_nr_pipeline>().back();
+      stage.write<metric_stage_name>(it.first);
+      stage.write<metric_nof_ttis>(it.second->nof_ttis);
+      stage.write<metric_nof_late>(it.second->nof_late);
+      stage.write<metric_nof_late_total>(it.second->nof_late_total);
+      stage.write<metric_avg_slack>(it.second->avg_slack_us);
+      stage.write<metric_min_slack>(it.second->min_slack_us);
+    }
+  }
+
+  // Latency histograms of the real-time paths over the period.
+  for (const auto& hist : m.latency) {
+    ctx.get<mlist_latency>().emplace_back();
+    auto& latency = ctx.get<mlist_latency>().back();
+    latency.write<metric_latency_name>(hist.name);
+    latency.write<metric_latency_count>(hist.count);
+    latency.write<metric_latency_mean>(hist.mean_us);
+    latency.write<metric_latency_p50>(hist.p50_us);
+    latency.write<metric_latency_p99>(hist.p99_us);
+    latency.write<metric_latency_p999>(hist.p999_us);
+    latency.write<metric_latency_max>(hist.max_us);
+  }
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
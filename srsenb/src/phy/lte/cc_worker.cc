@@ -212,16 +212,22 @@ uint32_t cc_worker::get_nof_rnti()
   return ue_db.size();
 }
 
-void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
+void cc_worker::work_ul(const srsran_ul_sf_cfg_t&            ul_sf_cfg,
+                        stack_interface_phy_lte::ul_sched_t& ul_grants,
+                        srsran::tti_stage_times_t&           stage_times)
 {
   std::lock_guard<std::mutex> lock(mutex);
   ul_sf = ul_sf_cfg;
   logger.set_context(ul_sf.tti);
 
   // Process UL signal
-  srsran_enb_ul_fft(&enb_ul);
+  {
+    srsran::tti_stage_timer fft_timer(stage_times, srsran::tti_stage_t::fft);
+    srsran_enb_ul_fft(&enb_ul);
+  }
 
   // Decode pending UL grants for the tti they were scheduled
+  srsran::tti_stage_timer decode_timer(stage_times, srsran::tti_stage_t::decode);
   decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
@@ -231,9 +237,11 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::dl_sched_t& dl_grants,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
-                        srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+                        srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+                        srsran::tti_stage_times_t&           stage_times)
 {
   std::lock_guard<std::mutex> lock(mutex);
+  srsran::tti_stage_timer     encode_timer(stage_times, srsran::tti_stage_t::encode);
   dl_sf = dl_sf_cfg;
 
   // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/threads.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/lte/sf_worker.h"
@@ -149,7 +150,9 @@ uint32_t sf_worker::get_nof_rnti()
 
 void sf_worker::work_imp()
 {
-  std::lock_guard<std::mutex> lock(work_mutex);
+  static srsran::latency_tprof work_tprof("phy_lte_sf");
+  std::lock_guard<std::mutex>  lock(work_mutex);
+  auto                         work_meas = work_tprof.start();
 
   srsran_ul_sf_cfg_t ul_sf = {};
   srsran_dl_sf_cfg_t dl_sf = {};
@@ -190,10 +193,11 @@ void sf_worker::work_imp()
 
   // Process UL
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc], context.stage_times);
   }
 
   // Get DL scheduling for the TX TTI from MAC
+  srsran::tti_stage_timer mac_timer(context.stage_times, srsran::tti_stage_t::mac);
   if (sf_type == SRSRAN_SF_NORM) {
     if (stack->get_dl_sched(tti_tx_dl, dl_grants) < 0) {
       Error("Getting DL scheduling from MAC");
@@ -215,6 +219,7 @@ void sf_worker::work_imp()
     phy->worker_end(context, true, tx_buffer);
     return;
   }
+  mac_timer.stop();
 
   // Configure DL subframe
   dl_sf.tti              = tti_tx_dl;
@@ -231,7 +236,7 @@ void sf_worker::work_imp()
     dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
     dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg, context.stage_times);
   }
 
   // Save grants
@@ -244,6 +249,9 @@ void sf_worker::work_imp()
     }
   }
 
+  // The wait for the previous worker in worker_end is not part of the processing time
+  work_meas.stop();
+
   Debug("Sending to radio");
   phy->worker_end(context, true, tx_buffer);
 
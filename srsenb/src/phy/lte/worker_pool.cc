@@ -19,6 +19,7 @@
  *
  */
 #include "srsenb/hdr/phy/lte/worker_pool.h"
+#include "srsran/common/thread_placement.h"
 
 namespace srsenb {
 namespace lte {
@@ -29,13 +30,18 @@ bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink&
 {
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
+  pool.set_placement_role("phy");
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
+    {
+      // The sample buffers are first touched on the NUMA node of the worker
+      srsran::scoped_numa_node numa_node("phy", i);
+      w->init(common);
+    }
     pool.init_worker(i, w.get(), prio);
     workers.push_back(std::move(w));
   }
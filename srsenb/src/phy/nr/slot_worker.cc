@@ -20,8 +20,14 @@
  */
 
 #include "srsenb/hdr/phy/nr/slot_worker.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include "srsran/common/time_prof.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 
 //#define DEBUG_WRITE_FILE
 
@@ -50,8 +56,9 @@ bool slot_worker::init(const args_t& args)
   sf_len = (uint32_t)(args.srate_hz / 1000.0);
 
   // Copy common configurations
-  cell_index = args.cell_index;
-  rf_port    = args.rf_port;
+  cell_index  = args.cell_index;
+  rf_port     = args.rf_port;
+  pipeline_ul = args.pipeline_ul;
 
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
@@ -89,14 +96,15 @@ bool slot_worker::init(const args_t& args)
   }
 
   // Prepare UL arguments
-  srsran_gnb_ul_args_t ul_args   = {};
-  ul_args.pusch.measure_time     = true;
-  ul_args.pusch.measure_evm      = true;
-  ul_args.pusch.max_layers       = args.nof_rx_ports;
-  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
-  ul_args.pusch.max_prb          = args.nof_max_prb;
-  ul_args.nof_max_prb            = args.nof_max_prb;
-  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+  srsran_gnb_ul_args_t ul_args          = {};
+  ul_args.pusch.measure_time            = true;
+  ul_args.pusch.measure_evm             = true;
+  ul_args.pusch.max_layers              = args.nof_rx_ports;
+  ul_args.pusch.sch.max_nof_iter        = args.pusch_max_its;
+  ul_args.pusch.sch.nof_decoder_threads = args.pusch_dec_threads;
+  ul_args.pusch.max_prb                 = args.nof_max_prb;
+  ul_args.nof_max_prb                   = args.nof_max_prb;
+  ul_args.pusch_min_snr_dB              = args.pusch_min_snr_dB;
 
   // Initialise UL
   if (srsran_gnb_ul_init(&gnb_ul, rx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
@@ -166,30 +174,34 @@ void slot_worker::set_context(const srsran::phy_common_interface::worker_context
 
 bool slot_worker::work_ul()
 {
-  stack_interface_phy_nr::ul_sched_t* ul_sched = stack.get_ul_sched(ul_slot_cfg);
-  if (ul_sched == nullptr) {
-    logger.error("Error retrieving UL scheduling");
+  pucch_res.clear();
+  pusch_res.clear();
+
+  if (not ul_sched_valid) {
     return false;
   }
 
-  if (ul_sched->pucch.empty() && ul_sched->pusch.empty()) {
+  if (nof_pucch_grants == 0 && nof_pusch_grants == 0) {
     // early exit if nothing has been scheduled
     return true;
   }
 
   // Demodulate
+  srsran::tti_stage_timer fft_timer(context.stage_times, srsran::tti_stage_t::fft);
   if (srsran_gnb_ul_fft(&gnb_ul) < SRSRAN_SUCCESS) {
     logger.error("Error in demodulation");
     return false;
   }
+  fft_timer.stop();
+  srsran::tti_stage_timer decode_timer(context.stage_times, srsran::tti_stage_t::decode);
 
   // For each PUCCH...
-  for (stack_interface_phy_nr::pucch_t& pucch : ul_sched->pucch) {
+  for (pucch_grant_t& pucch : srsran::span<pucch_grant_t>(pucch_grants.data(), nof_pucch_grants)) {
     srsran::bounded_vector<stack_interface_phy_nr::pucch_info_t, stack_interface_phy_nr::MAX_PUCCH_CANDIDATES>
-        pucch_info(pucch.candidates.size());
+        pucch_info(pucch.nof_candidates);
 
     // For each candidate decode PUCCH
-    for (uint32_t i = 0; i < (uint32_t)pucch.candidates.size(); i++) {
+    for (uint32_t i = 0; i < pucch.nof_candidates; i++) {
       pucch_info[i].uci_data.cfg = pucch.candidates[i].uci_cfg;
 
       // Decode PUCCH
@@ -214,11 +226,8 @@ bool slot_worker::work_ul()
       }
     }
 
-    // Inform stack
-    if (stack.pucch_info(ul_slot_cfg, pucch_info[best_candidate]) < SRSRAN_SUCCESS) {
-      logger.error("Error pushing PUCCH information to stack");
-      return false;
-    }
+    // Keep it for the stack
+    pucch_res.push_back(pucch_info[best_candidate]);
 
     // Log PUCCH decoding
     if (logger.info.enabled()) {
@@ -235,7 +244,8 @@ bool slot_worker::work_ul()
   }
 
   // For each PUSCH...
-  for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
+  for (stack_interface_phy_nr::pusch_t& pusch :
+       srsran::span<stack_interface_phy_nr::pusch_t>(pusch_grants.data(), nof_pusch_grants)) {
     // Prepare PUSCH
     stack_interface_phy_nr::pusch_info_t pusch_info = {};
     pusch_info.uci_cfg                              = pusch.sch.uci;
@@ -250,21 +260,24 @@ bool slot_worker::work_ul()
     pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
 
     // Decode PUSCH
+    srsran_sch_nr_decode_stats_t decode_stats = gnb_ul.pusch.sch.decode_stats;
     if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
         SRSRAN_SUCCESS) {
       logger.error("Error getting PUSCH");
       return false;
     }
 
+    // Report the transport block decode latency, as measured by the SCH decoder, in the latency metrics
+    static srsran::latency_histogram& decode_hist =
+        srsran::latency_histogram_registry::get_instance().get_histogram("phy_nr_pusch_decode");
+    if (srsran::latency_histogram_registry::get_instance().is_enabled() and
+        gnb_ul.pusch.sch.decode_stats.count != decode_stats.count) {
+      decode_hist.record((gnb_ul.pusch.sch.decode_stats.sum_us - decode_stats.sum_us) * 1000);
+    }
+
     // Extract DMRS information
     pusch_info.csi = gnb_ul.dmrs.csi;
 
-    // Inform stack
-    if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
-      logger.error("Error pushing PUSCH information to stack");
-      return false;
-    }
-
     // Log PUSCH decoding
     if (logger.info.enabled()) {
       std::array<char, 512> str;
@@ -278,18 +291,110 @@ bool slot_worker::work_ul()
         logger.info("PUSCH: %s", str.data());
       }
     }
+
+    // Keep it for the stack, the payload stays in the PDU buffer
+    pusch_res.push_back(std::move(pusch_info));
   }
 
   return true;
 }
 
+void slot_worker::deliver_ul()
+{
+  // Deliver the results decoded before any error
+  for (const stack_interface_phy_nr::pucch_info_t& pucch_info : pucch_res) {
+    if (stack.pucch_info(ul_slot_cfg, pucch_info) < SRSRAN_SUCCESS) {
+      logger.error("Error pushing PUCCH information to stack");
+    }
+  }
+  for (stack_interface_phy_nr::pusch_info_t& pusch_info : pusch_res) {
+    if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
+      logger.error("Error pushing PUSCH information to stack");
+    }
+  }
+  pucch_res.clear();
+  pusch_res.clear();
+}
+
+/// Copies the bytes in [begin, end) of a C configuration structure
+template <typename T>
+static void copy_cfg_bytes(T& dst, const T& src, size_t begin, size_t end)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+  std::memcpy((uint8_t*)&dst + begin, (const uint8_t*)&src + begin, end - begin);
+}
+
+/// Copies a UCI configuration with only the HARQ-ACK bits and CSI reports in use, the unused ones take most of its size
+static void copy_uci_cfg(srsran_uci_cfg_nr_t& dst, const srsran_uci_cfg_nr_t& src)
+{
+  size_t bits_begin = offsetof(srsran_uci_cfg_nr_t, ack.bits);
+  size_t bits_end   = bits_begin + sizeof(src.ack.bits);
+  size_t csi_begin  = offsetof(srsran_uci_cfg_nr_t, csi);
+  size_t csi_end    = csi_begin + sizeof(src.csi);
+
+  copy_cfg_bytes(dst, src, 0, bits_begin);
+  std::copy(src.ack.bits, src.ack.bits + SRSRAN_MIN(src.ack.count, SRSRAN_HARQ_ACK_MAX_NOF_BITS), dst.ack.bits);
+  copy_cfg_bytes(dst, src, bits_end, csi_begin);
+  std::copy(src.csi, src.csi + SRSRAN_MIN(src.nof_csi, SRSRAN_CSI_SLOT_MAX_NOF_REPORT), dst.csi);
+  copy_cfg_bytes(dst, src, csi_end, sizeof(src));
+}
+
+void slot_worker::get_ul_grants()
+{
+  srsran::tti_stage_timer             mac_timer(context.stage_times, srsran::tti_stage_t::mac);
+  stack_interface_phy_nr::ul_sched_t* ul_sched_ptr = stack.get_ul_sched(ul_slot_cfg);
+  ul_sched_valid                                   = ul_sched_ptr != nullptr;
+  if (ul_sched_valid) {
+    copy_ul_grants(*ul_sched_ptr);
+  } else {
+    logger.error("Error retrieving UL scheduling");
+  }
+}
+
+void slot_worker::copy_ul_grants(const stack_interface_phy_nr::ul_sched_t& ul_sched)
+{
+  nof_pusch_grants = (uint32_t)ul_sched.pusch.size();
+  for (uint32_t i = 0; i < nof_pusch_grants; i++) {
+    const stack_interface_phy_nr::pusch_t& src = ul_sched.pusch[i];
+    stack_interface_phy_nr::pusch_t&       dst = pusch_grants[i];
+
+    size_t uci_begin = offsetof(srsran_sch_cfg_nr_t, uci);
+    size_t uci_end   = uci_begin + sizeof(src.sch.uci);
+    dst.pid          = src.pid;
+    copy_cfg_bytes(dst.sch, src.sch, 0, uci_begin);
+    copy_uci_cfg(dst.sch.uci, src.sch.uci);
+    copy_cfg_bytes(dst.sch, src.sch, uci_end, sizeof(src.sch));
+  }
+
+  nof_pucch_grants = (uint32_t)ul_sched.pucch.size();
+  for (uint32_t i = 0; i < nof_pucch_grants; i++) {
+    const stack_interface_phy_nr::pucch_t& src = ul_sched.pucch[i];
+    pucch_grant_t&                         dst = pucch_grants[i];
+
+    dst.pucch_cfg      = src.pucch_cfg;
+    dst.nof_candidates = (uint32_t)src.candidates.size();
+    for (uint32_t c = 0; c < dst.nof_candidates; c++) {
+      dst.candidates[c].resource = src.candidates[c].resource;
+      copy_uci_cfg(dst.candidates[c].uci_cfg, src.candidates[c].uci_cfg);
+    }
+  }
+}
+
 bool slot_worker::work_dl()
 {
   // The Scheduler interface needs to be called synchronously, wait for the sync to be available
   sync.wait(this);
 
+  // Retrieve Scheduling for the current processing UL slot, when it is decoded after the DL slot. It is copied before
+  // the next worker schedules its DL slot, which recycles the UL results of the older slots
+  if (pipeline_ul) {
+    get_ul_grants();
+  }
+
   // Retrieve Scheduling for the current processing DL slot
+  srsran::tti_stage_timer                   mac_timer(context.stage_times, srsran::tti_stage_t::mac);
   const stack_interface_phy_nr::dl_sched_t* dl_sched_ptr = stack.get_dl_sched(dl_slot_cfg);
+  mac_timer.stop();
 
   // Releases synchronization lock and allow next worker to retrieve scheduling results
   sync.release();
@@ -299,6 +404,7 @@ bool slot_worker::work_dl()
     return false;
   }
 
+  srsran::tti_stage_timer encode_timer(context.stage_times, srsran::tti_stage_t::encode);
   if (srsran_gnb_dl_base_zero(&gnb_dl) < SRSRAN_SUCCESS) {
     logger.error("Error zeroing RE grid");
     return false;
@@ -401,8 +507,25 @@ bool slot_worker::work_dl()
   return true;
 }
 
+void slot_worker::ul_stage()
+{
+  static srsran::latency_tprof ul_tprof("phy_nr_slot_ul");
+  auto                         ul_meas = ul_tprof.start();
+  work_ul();
+  ul_meas.stop();
+
+  // Deliver the uplink results in slot order, even if the decoding failed
+  sync.wait_ul(this);
+  deliver_ul();
+  sync.release_ul();
+  sync.stage_end(stage_t::ul, context);
+}
+
 void slot_worker::work_imp()
 {
+  static srsran::latency_tprof work_tprof("phy_nr_slot");
+  auto                         work_meas = work_tprof.start();
+
   // Inform Scheduler about new slot
   stack.slot_indication(dl_slot_cfg);
 
@@ -414,22 +537,21 @@ void slot_worker::work_imp()
     tx_rf_buffer.set(rf_port, a, nof_ant, tx_buffer[a]);
   }
 
-  // Process uplink
-  if (not work_ul()) {
-    // Wait and release synchronization
-    sync.wait(this);
-    sync.release();
-    common.worker_end(context, false, tx_rf_buffer);
-    return;
+  // Without pipelining, the uplink results reach the stack before it schedules the downlink slot, as the scheduler
+  // expects the HARQ-ACK of the received slot by then. The uplink results of this slot are reset once the next worker
+  // schedules its slot, which waits for this worker to schedule the downlink slot
+  if (not pipeline_ul) {
+    get_ul_grants();
+    ul_stage();
   }
 
   // Process downlink
-  if (not work_dl()) {
-    common.worker_end(context, false, tx_rf_buffer);
-    return;
-  }
+  bool dl_ok = work_dl();
+  sync.stage_end(stage_t::dl, context);
 
-  common.worker_end(context, true, tx_rf_buffer);
+  // The wait for the previous worker in worker_end is not part of the processing time
+  work_meas.stop();
+  common.worker_end(context, dl_ok, tx_rf_buffer);
 
 #ifdef DEBUG_WRITE_FILE
   if (num_slots++ < slots_to_dump) {
@@ -440,6 +562,12 @@ void slot_worker::work_imp()
     fclose(f);
   }
 #endif
+
+  // Process uplink while the next workers process the following slots. The worker stays busy until the end, so its
+  // receive buffer is not overwritten in the meantime
+  if (pipeline_ul) {
+    ul_stage();
+  }
 }
 
 bool slot_worker::set_common_cfg(const srsran_carrier_nr_t&   carrier,
@@ -20,6 +20,7 @@
  */
 #include "srsenb/hdr/phy/nr/worker_pool.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/thread_placement.h"
 
 namespace srsenb {
 namespace nr {
@@ -33,7 +34,9 @@ worker_pool::worker_pool(srsran::phy_common_interface& common_,
   stack(stack_),
   log_sink(log_sink_),
   logger(srslog::fetch_basic_logger("PHY-NR", log_sink)),
-  prach_stack_adaptor(stack_)
+  prach_stack_adaptor(stack_),
+  dl_monitor(logger),
+  ul_monitor(logger)
 {
   // Do nothing
 }
@@ -52,6 +55,7 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   // Configure logger
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   logger.set_level(log_level);
+  pool.set_placement_role("phy_nr");
 
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
@@ -72,8 +76,12 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.rf_port                 = cell_list[cell_index].rf_port;
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
+    w_args.pusch_dec_threads       = args.pusch_dec_threads;
+    w_args.pipeline_ul             = args.pipeline_ul;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
 
+    // The sample buffers are first touched on the NUMA node of the worker
+    srsran::scoped_numa_node numa_node("phy_nr", i);
     if (not w->init(w_args)) {
       return false;
     }
@@ -84,8 +92,9 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
 
 void worker_pool::start_worker(slot_worker* w)
 {
-  // Push worker into synchronization queue
+  // Push worker into synchronization queues
   slot_sync.push(w);
+  ul_sync.push(w);
 
   // Feed PRACH detection before start processing
   prach.new_tti(0, current_tti, w->get_buffer_rx(0));
@@ -94,6 +103,22 @@ void worker_pool::start_worker(slot_worker* w)
   pool.start_worker(w);
 }
 
+void worker_pool::stage_end(slot_worker::stage_t stage, const srsran::phy_common_interface::worker_context_t& w_ctx)
+{
+  if (w_ctx.deadline == std::chrono::steady_clock::time_point{}) {
+    return;
+  }
+  // The UL stage keeps the TX deadline of the slot, which is when its results used to reach the stack
+  srsran::tti_deadline_monitor& monitor = stage == slot_worker::stage_t::dl ? dl_monitor : ul_monitor;
+  monitor.release(w_ctx.sf_idx, true, w_ctx.deadline, w_ctx.stage_times);
+}
+
+void worker_pool::get_metrics(phy_nr_pipeline_metrics_t& metrics)
+{
+  dl_monitor.get_metrics(metrics.dl);
+  ul_monitor.get_metrics(metrics.ul);
+}
+
 slot_worker* worker_pool::wait_worker(uint32_t tti)
 {
   slot_worker* w = (slot_worker*)pool.wait_worker(tti);
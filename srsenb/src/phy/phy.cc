@@ -23,6 +23,7 @@
 #include "srsran/common/band_helper.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/threads.h"
+#include <inttypes.h>
 #include <pthread.h>
 #include <sstream>
 #include <string.h>
@@ -212,6 +213,11 @@ void phy::stop()
     }
     prach.stop();
 
+    uint64_t nof_late = workers_common.deadline_monitor.get_nof_late_total();
+    if (nof_late > 0) {
+      srsran::console("PHY: %" PRIu64 " TTIs were released after their TX deadline\n", nof_late);
+    }
+
     initialized = false;
   }
 }
@@ -247,6 +253,18 @@ void phy::set_activation_deactivation_scell(uint16_t rnti, const std::array<bool
   }
 }
 
+void phy::get_deadline_metrics(srsran::tti_deadline_metrics_t& metrics)
+{
+  workers_common.deadline_monitor.get_metrics(metrics);
+}
+
+void phy::get_nr_pipeline_metrics(phy_nr_pipeline_metrics_t& metrics)
+{
+  if (nr_workers != nullptr) {
+    nr_workers->get_metrics(metrics);
+  }
+}
+
 void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
   std::vector<phy_metrics_t> metrics_tmp;
@@ -376,6 +394,8 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.pusch_dec_threads       = args.nr_pusch_dec_threads;
+  worker_args.pipeline_ul             = args.nr_pipeline_ul;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
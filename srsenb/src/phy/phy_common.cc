@@ -123,6 +123,10 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
   // Wait for the green light to transmit in the current TTI
   semaphore.wait(w_ctx.worker_ptr);
 
+  if (w_ctx.deadline != std::chrono::steady_clock::time_point{}) {
+    deadline_monitor.release(w_ctx.sf_idx, w_ctx.last, w_ctx.deadline, w_ctx.stage_times);
+  }
+
   // For combine buffer with previous buffers
   if (tx_enable) {
     tx_buffer.set_nof_samples(buffer.get_nof_samples());
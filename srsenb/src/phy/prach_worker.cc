@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/phy/prach_worker.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/srsran.h"
 
@@ -52,7 +53,7 @@ int prach_worker::init(const srsran_cell_t&      cell_,
   nof_sf = (uint32_t)ceilf(prach.T_tot * 1000);
 
   if (nof_workers > 0) {
-    start(priority);
+    srsran::get_thread_placement().start(*this, "prach", cc_idx, priority);
   }
 
   initiated = true;
@@ -23,6 +23,7 @@
 
 #include "srsenb/hdr/phy/txrx.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
@@ -68,7 +69,7 @@ bool txrx::init(enb_time_interface*          enb_,
         new srsran::channel(worker_com->params.ul_channel_args, worker_com->get_nof_rf_channels(), logger));
   }
 
-  start(prio_);
+  srsran::get_thread_placement().start(*this, "txrx", 0, prio_);
   return true;
 }
 
@@ -188,6 +189,9 @@ void txrx::run_thread()
     buffer.set_nof_samples(sf_len);
     radio_h->rx_now(buffer, timestamp);
 
+    // The subframe just received ends now, its TX time comes FDD_HARQ_DELAY_UL_MS after its start
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(FDD_HARQ_DELAY_UL_MS - 1);
+
     if (ul_channel) {
       ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
     }
@@ -212,6 +216,7 @@ void txrx::run_thread()
       context.sf_idx     = tti;
       context.worker_ptr = nr_worker;
       context.last       = (lte_worker == nullptr); // Set last if standalone
+      context.deadline   = deadline;
       context.tx_time.copy(timestamp);
 
       nr_worker->set_context(context);
@@ -227,6 +232,7 @@ void txrx::run_thread()
       context.sf_idx     = tti;
       context.worker_ptr = lte_worker;
       context.last       = true;
+      context.deadline   = deadline;
       context.tx_time.copy(timestamp);
 
       lte_worker->set_context(context);
@@ -23,6 +23,7 @@
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/enb.h"
 #include "srsenb/hdr/stack/upper/gtpu_pdcp_adapter.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_x2_interfaces.h"
 #include "srsran/rlc/bearer_mem_pool.h"
@@ -157,7 +158,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   }
 
   started = true;
-  start(STACK_MAIN_THREAD_PRIO);
+  srsran::get_thread_placement().start(*this, "stack", 0, STACK_MAIN_THREAD_PRIO);
 
   return SRSRAN_SUCCESS;
 }
@@ -25,6 +25,7 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/srslog/srslog.h"
 
 #define Console(fmt, ...) srsran::console(fmt, ##__VA_ARGS__)
@@ -359,12 +360,14 @@ int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::
 ///       configurations (e.g. different set of activated SCells) in different CC decisions
 void sched::new_tti(tti_point tti_rx)
 {
+  static srsran::latency_tprof sched_tprof("sched_lte");
   last_tti = std::max(last_tti, tti_rx);
 
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
       // Generate carrier scheduling result
+      auto sched_meas = sched_tprof.start();
       carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
     }
   }
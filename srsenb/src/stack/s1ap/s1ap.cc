@@ -686,6 +686,21 @@ bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
+  // Paging only needs a couple of IEs, so it is dispatched without decoding the whole message tree. UE-associated
+  // messages with unknown or inconsistent UE S1AP IDs are discarded before the full decode. If the lazy decode fails
+  // (e.g. too many IEs), the full decode below handles the message.
+  asn1::ap_pdu_view pdu_view;
+  if (pdu_view.unpack(pdu->msg, pdu->N_bytes) == asn1::SRSASN_SUCCESS) {
+    if (pdu_view.pdu_type() == s1ap_pdu_c::types_opts::init_msg and pdu_view.proc_code() == ASN1_S1AP_ID_PAGING) {
+      logger.info(pdu->msg, pdu->N_bytes, "Rx S1AP SDU - Paging");
+      return handle_paging(pdu_view);
+    }
+    if (not check_ue_s1ap_ids(pdu_view)) {
+      logger.info(pdu->msg, pdu->N_bytes, "Rx S1AP SDU - Discarded (procedure code=%d)", pdu_view.proc_code());
+      return false;
+    }
+  }
+
   s1ap_pdu_c     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
 
@@ -720,10 +735,10 @@ bool s1ap::handle_initiatingmessage(const init_msg_s& msg)
       return handle_dlnastransport(msg.value.dl_nas_transport());
     case s1ap_elem_procs_o::init_msg_c::types_opts::init_context_setup_request:
       return handle_initialctxtsetuprequest(msg.value.init_context_setup_request());
-    case s1ap_elem_procs_o::init_msg_c::types_opts::ue_context_release_cmd:
-      return handle_uectxtreleasecommand(msg.value.ue_context_release_cmd());
     case s1ap_elem_procs_o::init_msg_c::types_opts::paging:
       return handle_paging(msg.value.paging());
+    case s1ap_elem_procs_o::init_msg_c::types_opts::ue_context_release_cmd:
+      return handle_uectxtreleasecommand(msg.value.ue_context_release_cmd());
     case s1ap_elem_procs_o::init_msg_c::types_opts::erab_setup_request:
       return handle_erabsetuprequest(msg.value.erab_setup_request());
     case s1ap_elem_procs_o::init_msg_c::types_opts::erab_release_cmd:
@@ -909,12 +924,30 @@ bool s1ap::handle_initialctxtsetuprequest(const init_context_setup_request_s& ms
 bool s1ap::handle_paging(const asn1::s1ap::paging_s& msg)
 {
   WarnUnsupportFeature(msg.ext, "S1AP message extension");
-
   uint32_t ueid = msg->ue_id_idx_value.value.to_number();
   rrc->add_paging_id(ueid, msg->ue_paging_id.value);
   return true;
 }
 
+bool s1ap::handle_paging(const asn1::ap_pdu_view& msg)
+{
+  WarnUnsupportFeature(msg.ext(), "S1AP message extension");
+
+  asn1::fixed_bitstring<10, false, true> ue_id_idx_value;
+  ue_paging_id_c                         ue_paging_id;
+  if (msg.unpack_ie(ASN1_S1AP_ID_UE_ID_IDX_VALUE, ue_id_idx_value) != asn1::SRSASN_SUCCESS or
+      msg.unpack_ie(ASN1_S1AP_ID_UE_PAGING_ID, ue_paging_id) != asn1::SRSASN_SUCCESS) {
+    logger.error("Failed to unpack Paging IEs");
+    cause_c cause;
+    cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
+    send_error_indication(cause);
+    return false;
+  }
+
+  rrc->add_paging_id(ue_id_idx_value.to_number(), ue_paging_id);
+  return true;
+}
+
 bool s1ap::handle_erabsetuprequest(const erab_setup_request_s& msg)
 {
   WarnUnsupportFeature(msg.ext, "S1AP message extension");
@@ -2053,6 +2086,62 @@ bool s1ap::sctp_send_s1ap_pdu(const asn1::s1ap::s1ap_pdu_c& tx_pdu, uint32_t rnt
   return true;
 }
 
+/**
+ * Helper method to check the UE S1AP IDs of a received UE-associated message before it is fully decoded. Only the ID
+ * IEs are decoded, and the same checks as in handle_s1apmsg_ue_id() apply.
+ * @param msg lazily decoded S1AP PDU
+ * @return false if the IDs do not identify a UE, in which case the message has been handled and must be discarded
+ */
+bool s1ap::check_ue_s1ap_ids(const asn1::ap_pdu_view& msg)
+{
+  switch (msg.proc_code()) {
+    case ASN1_S1AP_ID_DL_NAS_TRANSPORT:
+    case ASN1_S1AP_ID_INIT_CONTEXT_SETUP:
+    case ASN1_S1AP_ID_ERAB_SETUP:
+    case ASN1_S1AP_ID_ERAB_MODIFY:
+    case ASN1_S1AP_ID_ERAB_RELEASE:
+    case ASN1_S1AP_ID_UE_CONTEXT_MOD:
+    case ASN1_S1AP_ID_MME_STATUS_TRANSFER:
+      if (msg.pdu_type() != s1ap_pdu_c::types_opts::init_msg) {
+        return true;
+      }
+      break;
+    case ASN1_S1AP_ID_HO_PREP:
+      // Handover Command or Handover Preparation Failure
+      if (msg.pdu_type() == s1ap_pdu_c::types_opts::init_msg) {
+        return true;
+      }
+      break;
+    case ASN1_S1AP_ID_UE_CONTEXT_RELEASE: {
+      ue_s1ap_ids_c ue_s1ap_ids;
+      if (msg.pdu_type() != s1ap_pdu_c::types_opts::init_msg or
+          msg.unpack_ie(ASN1_S1AP_ID_UE_S1AP_IDS, ue_s1ap_ids) != asn1::SRSASN_SUCCESS) {
+        return true;
+      }
+      if (ue_s1ap_ids.type().value == ue_s1ap_ids_c::types_opts::ue_s1ap_id_pair) {
+        const auto& idpair = ue_s1ap_ids.ue_s1ap_id_pair();
+        return handle_s1apmsg_ue_id(idpair.enb_ue_s1ap_id, idpair.mme_ue_s1ap_id) != nullptr;
+      }
+      if (users.find_ue_mmeid(ue_s1ap_ids.mme_ue_s1ap_id()) == nullptr) {
+        logger.warning("UE for mme_ue_s1ap_id:%d not found - discarding message", ue_s1ap_ids.mme_ue_s1ap_id());
+        return false;
+      }
+      return true;
+    }
+    default:
+      return true;
+  }
+
+  // Malformed ID IEs are reported by the full decode
+  mme_ue_s1ap_id_t mme_ue_s1ap_id;
+  enb_ue_s1ap_id_t enb_ue_s1ap_id;
+  if (msg.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) != asn1::SRSASN_SUCCESS or
+      msg.unpack_ie(ASN1_S1AP_ID_ENB_UE_S1AP_ID, enb_ue_s1ap_id) != asn1::SRSASN_SUCCESS) {
+    return true;
+  }
+  return handle_s1apmsg_ue_id(enb_ue_s1ap_id.value, mme_ue_s1ap_id.value) != nullptr;
+}
+
 /**
  * Helper method to find user based on the enb_ue_s1ap_id stored in an S1AP Msg, and update mme_ue_s1ap_id
  * @param enb_id enb_ue_s1ap_id value stored in S1AP message
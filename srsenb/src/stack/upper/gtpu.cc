@@ -24,6 +24,7 @@
 #include "srsran/common/network_utils.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/support/srsran_assert.h"
@@ -437,6 +438,9 @@ void gtpu::stop()
 // gtpu_interface_pdcp
 void gtpu::write_pdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_buffer_t pdu)
 {
+  static srsran::latency_tprof tx_tprof("gtpu_s1u_tx");
+  auto                         tx_meas = tx_tprof.start();
+
   srsran::span<gtpu_tunnel_manager::bearer_teid_pair> teids = tunnels.find_rnti_bearer_tunnels(rnti, eps_bearer_id);
   if (teids.empty()) {
     logger.warning("The rnti=0x%x, eps-BearerID=%d does not have any pdcp_active tunnel", rnti, eps_bearer_id);
@@ -614,6 +618,8 @@ void gtpu::handle_end_marker(const gtpu_tunnel& rx_tunnel)
 void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr)
 {
   srsran_assert(pdu != nullptr, "Called with null PDU");
+  static srsran::latency_tprof rx_tprof("gtpu_s1u_rx");
+  auto                         rx_meas = rx_tprof.start();
 
   logger.debug("Received %d bytes from S1-U interface", pdu->N_bytes);
   pdu->set_timestamp();
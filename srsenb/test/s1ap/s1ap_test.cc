@@ -119,9 +119,14 @@ struct rrc_tester : public rrc_dummy {
     return std::count(next_erabs_failed_to_modify.begin(), next_erabs_failed_to_modify.end(), erab_id) == 0;
   }
   void release_ue(uint16_t rnti) override { last_released_rnti = rnti; }
+  void add_paging_id(uint32_t ueid, const asn1::s1ap::ue_paging_id_c& ue_paging_id) override
+  {
+    paging_ueids.push_back(ueid);
+  }
 
   uint16_t              last_released_rnti = SRSRAN_INVALID_RNTI;
   std::vector<uint16_t> next_erabs_failed_to_modify, last_erabs_modified;
+  std::vector<uint32_t> paging_ueids;
 };
 
 void run_s1_setup(s1ap& s1ap_obj, mme_dummy& mme)
@@ -206,7 +211,7 @@ void add_rnti(s1ap& s1ap_obj, mme_dummy& mme)
   TESTASSERT(not resp->erab_failed_to_setup_list_ctxt_su_res_present);
 }
 
-enum class test_event { success, wrong_erabid_mod, wrong_mme_s1ap_id, repeated_erabid_mod };
+enum class test_event { success, wrong_erabid_mod, wrong_mme_s1ap_id, wrong_enb_s1ap_id, repeated_erabid_mod };
 
 void test_s1ap_erab_setup(test_event event)
 {
@@ -248,7 +253,7 @@ void test_s1ap_erab_setup(test_event event)
   asn1::s1ap::s1ap_pdu_c mod_req_pdu;
   mod_req_pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_ERAB_MODIFY);
   auto& protocols                 = mod_req_pdu.init_msg().value.erab_modify_request();
-  protocols->enb_ue_s1ap_id.value = 1;
+  protocols->enb_ue_s1ap_id.value = event == test_event::wrong_enb_s1ap_id ? 2 : 1;
   protocols->mme_ue_s1ap_id.value = event == test_event::wrong_mme_s1ap_id ? 2 : 1;
   auto& erab_list                 = protocols->erab_to_be_modified_list_bearer_mod_req.value;
   erab_list.resize(2);
@@ -291,6 +296,19 @@ void test_s1ap_erab_setup(test_event event)
     TESTASSERT(rrc.last_released_rnti == 0x46);
     return;
   }
+  if (event == test_event::wrong_enb_s1ap_id) {
+    // The message is discarded before its E-RAB list is decoded
+    TESTASSERT(s1ap_pdu.type().value == asn1::s1ap::s1ap_pdu_c::types_opts::init_msg);
+    TESTASSERT(s1ap_pdu.init_msg().proc_code == ASN1_S1AP_ID_ERROR_IND);
+    auto& err_ind = s1ap_pdu.init_msg().value.error_ind();
+    TESTASSERT(err_ind->mme_ue_s1ap_id_present and err_ind->mme_ue_s1ap_id.value.value == 1);
+    TESTASSERT(err_ind->enb_ue_s1ap_id_present and err_ind->enb_ue_s1ap_id.value.value == 2);
+    TESTASSERT(err_ind->cause_present and err_ind->cause.value.radio_network().value ==
+               asn1::s1ap::cause_radio_network_opts::unknown_enb_ue_s1ap_id);
+    TESTASSERT(rrc.last_released_rnti == 0x46);
+    TESTASSERT(rrc.last_erabs_modified.empty());
+    return;
+  }
 
   TESTASSERT(s1ap_pdu.type().value == asn1::s1ap::s1ap_pdu_c::types_opts::successful_outcome);
   TESTASSERT(s1ap_pdu.successful_outcome().proc_code == ASN1_S1AP_ID_ERAB_MODIFY);
@@ -326,6 +344,63 @@ void test_s1ap_erab_setup(test_event event)
   TESTASSERT(erab_item.erab_id == 5);
 }
 
+void test_s1ap_paging()
+{
+  srsran::task_scheduler task_sched;
+  srslog::basic_logger&  logger = srslog::fetch_basic_logger("S1AP");
+  dummy_socket_manager   rx_sockets;
+  s1ap                   s1ap_obj(&task_sched, logger, &rx_sockets);
+  rrc_tester             rrc;
+
+  const char*    mme_addr_str = "127.0.0.1";
+  const uint32_t MME_PORT     = 36412;
+  mme_dummy      mme(mme_addr_str, MME_PORT);
+
+  s1ap_args_t args   = {};
+  args.cell_id       = 0x01;
+  args.enb_id        = 0x19B;
+  args.mcc           = 907;
+  args.mnc           = 70;
+  args.s1c_bind_addr = "127.0.0.100";
+  args.tac           = 7;
+  args.gtp_bind_addr = "127.0.0.100";
+  args.mme_addr      = mme_addr_str;
+  args.enb_name      = "srsenb01";
+
+  TESTASSERT(s1ap_obj.init(args, &rrc) == SRSRAN_SUCCESS);
+  task_sched.run_next_task();
+  run_s1_setup(s1ap_obj, mme);
+
+  // Paging IEs with an IMSI UE Paging ID and UE Identity Index Value=723
+  std::vector<uint8_t> ies = {0x00, 0x50, 0x40, 0x02, 0xb4, 0xc0, 0x00, 0x2b, 0x40, 0x09, 0x68, 0x54, 0x02,
+                              0x04, 0x30, 0x68, 0x74, 0x05, 0xf7, 0x00, 0x6d, 0x40, 0x01, 0x00, 0x00, 0x2e,
+                              0x40, 0x0b, 0x00, 0x00, 0x2f, 0x40, 0x06, 0x00, 0x54, 0xf2, 0x40, 0x04, 0xd2};
+  sockaddr_in     mme_addr = {};
+  sctp_sndrcvinfo rcvinfo  = {};
+  int             flags    = 0;
+  for (uint32_t nof_ies : {4u, asn1::ap_pdu_view::max_nof_ies + 1}) {
+    // Repeating the Paging DRX IE past the IEs indexed by asn1::ap_pdu_view forces the full decode
+    std::vector<uint8_t> pdu_ies = ies;
+    for (uint32_t i = 4; i < nof_ies; ++i) {
+      pdu_ies.insert(pdu_ies.end(), {0x00, 0x2c, 0x40, 0x01, 0x00});
+    }
+    uint32_t             msg_len = pdu_ies.size() + 3;
+    std::vector<uint8_t> pdu     = {0x00, ASN1_S1AP_ID_PAGING, 0x40};
+    if (msg_len >= 128) {
+      pdu.push_back(0x80 | (msg_len >> 8));
+    }
+    pdu.push_back(msg_len & 0xff);
+    pdu.insert(pdu.end(), {0x00, (uint8_t)(nof_ies >> 8), (uint8_t)(nof_ies & 0xff)});
+    pdu.insert(pdu.end(), pdu_ies.begin(), pdu_ies.end());
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    sdu->append_bytes(pdu.data(), pdu.size());
+
+    TESTASSERT(s1ap_obj.handle_mme_rx_msg(std::move(sdu), mme_addr, rcvinfo, flags));
+    TESTASSERT(rrc.paging_ueids.size() == 1 and rrc.paging_ueids.back() == 723);
+    rrc.paging_ueids.clear();
+  }
+}
+
 int main(int argc, char** argv)
 {
   // Setup logging.
@@ -339,5 +414,7 @@ int main(int argc, char** argv)
   test_s1ap_erab_setup(test_event::success);
   test_s1ap_erab_setup(test_event::wrong_erabid_mod);
   test_s1ap_erab_setup(test_event::wrong_mme_s1ap_id);
+  test_s1ap_erab_setup(test_event::wrong_enb_s1ap_id);
   test_s1ap_erab_setup(test_event::repeated_erabid_mod);
+  test_s1ap_paging();
 }
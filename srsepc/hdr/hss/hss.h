@@ -28,6 +28,8 @@
 #ifndef SRSEPC_HSS_H
 #define SRSEPC_HSS_H
 
+#include "srsepc/hdr/hss/hss_auth_cache.h"
+#include "srsepc/hdr/hss/hss_db.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
@@ -35,6 +37,7 @@
 #include <cstddef>
 
 #include <map>
+#include <mutex>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
 #define LTE_FDD_ENB_IND_HE_MASK 0x1FUL
@@ -47,6 +50,9 @@ struct hss_args_t {
   std::string db_file;
   uint16_t    mcc;
   uint16_t    mnc;
+  uint32_t    auth_cache_size;    ///< Subscribers with pre-generated authentication vectors, 0 to disable
+  uint32_t    auth_cache_vectors; ///< Authentication vectors generated per subscriber at a time
+  bool        db_sync;            ///< Flush every SQN update of a subscriber database to the storage
 };
 
 enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
@@ -87,6 +93,19 @@ public:
 
   std::map<std::string, uint64_t> get_ip_to_imsi() const;
 
+  /// Converts a user database .csv file into a subscriber database, which the HSS maps instead of parsing
+  static bool convert_db_file(const std::string& csv_file, const std::string& db_file);
+
+  /// SQN that follows the given one, incremented as in 3GPP TS 33.102 Annex C
+  static void increment_sqn(const uint8_t* sqn, uint8_t* next_sqn);
+
+  /// Authentication vectors served from the cache and computed on request
+  uint64_t get_auth_cache_hits() { return m_auth_cache.get_nof_hits(); }
+  uint64_t get_auth_cache_misses() { return m_auth_cache.get_nof_misses(); }
+
+  /// Waits until the authentication vectors requested so far are generated
+  void wait_auth_cache_idle() { m_auth_cache.wait_idle(); }
+
 private:
   hss();
   virtual ~hss();
@@ -107,7 +126,7 @@ private:
 
   void increment_ue_sqn(hss_ue_ctx_t* ue_ctx);
   void increment_seq_after_resync(hss_ue_ctx_t* ue_ctx);
-  void increment_sqn(uint8_t* sqn, uint8_t* next_sqn);
+  void store_sqn(hss_ue_ctx_t* ue_ctx);
 
   bool          set_auth_algo(std::string auth_algo);
   bool          read_db_file(std::string db_file);
@@ -116,7 +135,12 @@ private:
 
   std::string hex_string(uint8_t* hex, int size);
 
-  std::string db_file;
+  // The S1AP workers of the MME query the HSS concurrently
+  std::mutex m_mutex;
+
+  std::string    db_file;
+  hss_db         m_db; ///< Subscriber database, the contexts are only created for the subscribers that attach
+  hss_auth_cache m_auth_cache;
 
   /*Logs*/
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
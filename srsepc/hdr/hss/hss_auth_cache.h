@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_auth_cache.h
+ * Description: Cache of pre-generated Milenage authentication vectors.
+ *
+ *              A background thread computes batches of vectors for the
+ *              consecutive SQNs of a subscriber, so that an authentication
+ *              information request only takes a vector from the cache.
+ *              A vector is served only when its SQN is the current SQN of
+ *              the subscriber, and the HSS advances and stores the SQN when
+ *              it is served, exactly as for a vector computed on request.
+ *              Vectors that were generated but never served do not change
+ *              the SQN, so they are lost without consequence.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_AUTH_CACHE_H
+#define SRSEPC_HSS_AUTH_CACHE_H
+
+#include "srsran/common/security.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace srsepc {
+
+/// Authentication vector, as returned in an authentication information answer
+struct hss_auth_vector_t {
+  uint8_t sqn[6];
+  uint8_t rand[16];
+  uint8_t xres[8];
+  uint8_t autn[16];
+  uint8_t k_asme[32];
+};
+
+/// Subscriber parameters used to generate authentication vectors
+struct hss_auth_subscriber_t {
+  uint64_t imsi;
+  uint8_t  key[16];
+  uint8_t  opc[16];
+  uint8_t  amf[2];
+  uint8_t  sqn[6]; ///< Current SQN, the SQN of the next vector served
+};
+
+class hss_auth_cache : public srsran::thread
+{
+public:
+  hss_auth_cache();
+  ~hss_auth_cache();
+
+  /**
+   * @brief Starts the generation thread
+   * @param max_subscribers Maximum number of subscribers with cached vectors, the least recently used are evicted
+   * @param nof_vectors Number of vectors generated per subscriber at a time
+   */
+  void init(uint32_t max_subscribers, uint32_t nof_vectors, uint16_t mcc, uint16_t mnc);
+  void stop();
+
+  bool is_enabled() const { return running; }
+
+  /**
+   * @brief Takes the vector for the current SQN of a subscriber
+   *
+   * The cache is refilled in the background when it runs low. On a miss, the vectors starting from the SQN after the
+   * current one are requested, since the caller computes the vector of the current SQN itself.
+   * @return true if a vector was found, false if the caller shall compute it
+   */
+  bool pop(const hss_auth_subscriber_t& sub, hss_auth_vector_t* vector);
+
+  /// Requests vectors for a subscriber without cached vectors, starting from its current SQN
+  void prefetch(const hss_auth_subscriber_t& sub);
+
+  /// Drops the vectors of a subscriber, after its SQN changed other than by serving a vector
+  void invalidate(uint64_t imsi);
+
+  uint64_t get_nof_hits();
+  uint64_t get_nof_misses();
+
+  /// Number of cached vectors of a subscriber
+  uint32_t size(uint64_t imsi);
+
+  /// Waits until there are no vectors pending generation
+  void wait_idle();
+
+private:
+  struct refill_request_t {
+    hss_auth_subscriber_t sub; ///< Subscriber, with the SQN of the first vector to generate
+    uint64_t              epoch;
+  };
+
+  struct entry_t {
+    std::deque<hss_auth_vector_t> vectors;
+    std::list<uint64_t>::iterator lru_it;
+    uint64_t                      epoch   = 0; ///< Changes when the vectors are dropped, discards refills in flight
+    bool                          pending = false;
+  };
+
+  void     run_thread() override;
+  void     generate(const refill_request_t&                 request,
+                    std::vector<srsran::milenage_vector_t>& milenage,
+                    std::vector<hss_auth_vector_t>&         vectors);
+  entry_t& get_entry(uint64_t imsi);
+  void     request_refill(entry_t& entry, const hss_auth_subscriber_t& sub, const uint8_t* first_sqn);
+
+  srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
+
+  /// RAND source of the generation thread. It draws from the entropy of the OS, unlike the rand() of the HSS thread
+  std::random_device rand_source;
+
+  uint32_t max_subscribers = 0;
+  uint32_t nof_vectors     = 0;
+  uint16_t mcc             = 0;
+  uint16_t mnc             = 0;
+  bool     running         = false;
+
+  std::mutex                            mutex;
+  std::condition_variable               cvar;
+  std::condition_variable               idle_cvar;
+  std::unordered_map<uint64_t, entry_t> entries;
+  std::list<uint64_t>                   lru; ///< Most recently used first
+  std::deque<refill_request_t>          requests;
+  bool                                  busy       = false;
+  uint64_t                              next_epoch = 1;
+  uint64_t                              nof_hits   = 0;
+  uint64_t                              nof_misses = 0;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_HSS_AUTH_CACHE_H
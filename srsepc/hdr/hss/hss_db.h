@@ -0,0 +1,155 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_db.h
+ * Description: Memory-mapped HSS subscriber database.
+ *
+ *              The subscribers are stored as fixed size records followed by
+ *              an open addressing hash index by IMSI, so the file is mapped
+ *              at startup instead of parsed. SQN updates are appended to a
+ *              log next to the database, which is replayed when the database
+ *              is opened and folded back into the records on compaction.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_DB_H
+#define SRSEPC_HSS_DB_H
+
+#include "srsran/srslog/srslog.h"
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace srsepc {
+
+#define HSS_DB_NAME_LEN 32
+
+/// Subscriber record, as stored in the database file
+struct hss_db_record_t {
+  uint64_t imsi;
+  uint8_t  key[16];
+  uint8_t  op[16];
+  uint8_t  opc[16];
+  uint8_t  amf[2];
+  uint8_t  sqn[6];
+  uint16_t qci;
+  uint8_t  algo;           ///< hss_auth_algo
+  uint8_t  op_configured;  ///< 1 if the OP was given and the OPc derived from it
+  uint32_t static_ip_addr; ///< Static IPv4 address in network byte order, 0 for dynamic allocation
+  char     name[HSS_DB_NAME_LEN];
+};
+
+class hss_db
+{
+public:
+  hss_db() = default;
+  ~hss_db();
+  hss_db(const hss_db&) = delete;
+  hss_db& operator=(const hss_db&) = delete;
+
+  /// Returns true if the file exists and starts like a subscriber database
+  static bool is_db_file(const std::string& db_file);
+
+  /// Writes a new database with the given records, replacing any previous database and SQN log
+  static bool create(const std::string& db_file, const std::vector<hss_db_record_t>& records);
+
+  /**
+   * @brief Maps the database and replays the SQN log
+   * @param db_file Database file, the SQN log is the same file name with ".sqn" appended
+   * @param sync_log Flush every SQN update to the storage before returning, not only to the page cache
+   */
+  bool open(const std::string& db_file, bool sync_log = true);
+
+  /// Folds the SQN log into the database and unmaps it
+  void close();
+
+  bool is_open() const { return records != nullptr; }
+
+  /// Returns the record of a subscriber, or nullptr if the IMSI is unknown
+  const hss_db_record_t* find(uint64_t imsi) const;
+
+  /// Stores the SQN of a subscriber, it is persisted once the update is in the log
+  bool update_sqn(uint64_t imsi, const uint8_t* sqn);
+
+  /// Writes the SQN updates into the database file and empties the log
+  bool compact();
+
+  uint64_t               size() const { return nof_records; }
+  const hss_db_record_t* begin() const { return records; }
+  const hss_db_record_t* end() const { return records + nof_records; }
+
+private:
+  /// Compact once the log holds this many updates
+  static const uint32_t max_log_entries = 65536;
+
+  struct header_t {
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t nof_records;
+    uint64_t nof_slots;
+    uint64_t records_offset;
+    uint64_t index_offset;
+    uint8_t  reserved[16];
+  };
+
+  /// Hash index slot, the IMSI is repeated so that probing does not touch the records
+  struct slot_t {
+    uint64_t imsi;
+    uint32_t record_idx; ///< Record index plus one, 0 for an empty slot
+    uint32_t reserved;
+  };
+
+  /// SQN log entry, the check detects entries torn by a crash while appending
+  struct log_entry_t {
+    uint64_t imsi;
+    uint8_t  sqn[6];
+    uint16_t check;
+  };
+
+  static uint64_t hash(uint64_t imsi);
+  static uint16_t log_check(const log_entry_t& entry);
+  static bool     write_all(int fd, const void* data, size_t len);
+
+  hss_db_record_t* find_record(uint64_t imsi) const;
+
+  /// Applies the valid SQN log entries, returns the length of the log up to the first torn entry or -1 on error
+  off_t replay_log();
+
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("HSS");
+
+  std::string           log_file;
+  int                   db_fd       = -1;
+  int                   log_fd      = -1;
+  bool                  sync        = true;
+  void*                 map         = nullptr;
+  size_t                map_len     = 0;
+  hss_db_record_t*      records     = nullptr;
+  uint64_t              nof_records = 0;
+  const slot_t*         slots       = nullptr;
+  uint64_t              slot_mask   = 0;
+  std::vector<uint32_t> dirty; ///< Records with an SQN update only in the log
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_HSS_DB_H
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        concurrent_map.h
+ * Description: Hash map shared by the S1AP workers.
+ *
+ *              The keys are spread over stripes, each one a hash map with
+ *              its own mutex, so that workers looking up different UEs
+ *              rarely wait for each other. An operation only locks the
+ *              stripe of its key, the values are copied out of the map.
+ *****************************************************************************/
+
+#ifndef SRSEPC_CONCURRENT_MAP_H
+#define SRSEPC_CONCURRENT_MAP_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace srsepc {
+
+template <typename K, typename V, uint32_t NofStripes = 64>
+class concurrent_map
+{
+public:
+  /// Inserts a value, returns false if the key is already present
+  bool insert(const K& key, const V& value)
+  {
+    stripe_t&                   s = get_stripe(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.map.emplace(key, value).second;
+  }
+
+  void insert_or_assign(const K& key, const V& value)
+  {
+    stripe_t&                   s = get_stripe(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.map[key] = value;
+  }
+
+  /// Copies the value of a key, returns false if the key is not present
+  bool find(const K& key, V& value) const
+  {
+    const stripe_t&             s = get_stripe(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto                        it = s.map.find(key);
+    if (it == s.map.end()) {
+      return false;
+    }
+    value = it->second;
+    return true;
+  }
+
+  bool contains(const K& key) const
+  {
+    const stripe_t&             s = get_stripe(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.map.count(key) > 0;
+  }
+
+  bool erase(const K& key)
+  {
+    stripe_t&                   s = get_stripe(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.map.erase(key) > 0;
+  }
+
+  /// Erases a key only if it still maps to the given value
+  bool erase(const K& key, const V& value)
+  {
+    stripe_t&                   s = get_stripe(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto                        it = s.map.find(key);
+    if (it == s.map.end() || not(it->second == value)) {
+      return false;
+    }
+    s.map.erase(it);
+    return true;
+  }
+
+  /// Calls func(key, value) for every element, one stripe locked at a time
+  template <typename Func>
+  void for_each(Func&& func)
+  {
+    for (stripe_t& s : stripes) {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      for (auto& it : s.map) {
+        func(it.first, it.second);
+      }
+    }
+  }
+
+  size_t size() const
+  {
+    size_t n = 0;
+    for (const stripe_t& s : stripes) {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      n += s.map.size();
+    }
+    return n;
+  }
+
+  void clear()
+  {
+    for (stripe_t& s : stripes) {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      s.map.clear();
+    }
+  }
+
+private:
+  struct stripe_t {
+    mutable std::mutex       mutex;
+    std::unordered_map<K, V> map;
+  };
+
+  // Consecutive identifiers, as the MME UE S1AP Ids, land in consecutive stripes
+  static uint32_t stripe_idx(const K& key) { return std::hash<K>{}(key) % NofStripes; }
+  stripe_t&       get_stripe(const K& key) { return stripes[stripe_idx(key)]; }
+  const stripe_t& get_stripe(const K& key) const { return stripes[stripe_idx(key)]; }
+
+  std::array<stripe_t, NofStripes> stripes;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_CONCURRENT_MAP_H
@@ -29,10 +29,17 @@
 #define SRSEPC_MME_H
 
 #include "s1ap.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/epoll_helper.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
+#include "srsran/common/timers.h"
+#include <atomic>
 #include <cstddef>
+#include <mutex>
+#include <unordered_map>
 
 namespace srsepc {
 
@@ -42,11 +49,38 @@ typedef struct {
   // gtpc_args_t gtpc_args;
 } mme_args_t;
 
-typedef struct {
-  int                 fd;
-  uint64_t            imsi;
-  enum nas_timer_type type;
-} mme_timer_t;
+/// Period of the NAS timer wheel
+#define MME_TIMER_TICK_MS 10
+
+/// Maximum number of events handled per wakeup of the MME thread
+#define MME_MAX_EVENTS 16
+
+/// Maximum number of tasks of the S1AP workers waiting for the MME thread
+#define MME_TASK_QUEUE_SIZE 4096
+
+class mme;
+
+/**
+ * GTP-C interface of the NAS contexts when S1AP runs on worker threads.
+ *
+ * The GTP-C contexts belong to the MME thread, so the requests are handed off to it. The arguments are copied, and
+ * the return value only tells whether the request was queued.
+ */
+class mme_gtpc_handoff : public gtpc_interface_nas
+{
+public:
+  mme_gtpc_handoff(mme* mme_, mme_gtpc* gtpc_) : m_mme(mme_), m_gtpc(gtpc_) {}
+
+  bool send_create_session_request(uint64_t imsi) override;
+  bool send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify, srsran::gtp_fteid_t* enb_fteid) override;
+  bool send_release_access_bearers_request(uint64_t imsi) override;
+  bool send_delete_session_request(uint64_t imsi) override;
+  bool send_downlink_data_notification_failure_indication(uint64_t imsi, enum srsran::gtpc_cause_value cause) override;
+
+private:
+  mme*      m_mme;
+  mme_gtpc* m_gtpc;
+};
 
 class mme : public srsran::thread, public mme_interface_nas
 {
@@ -60,10 +94,16 @@ public:
   void run_thread();
 
   // Timer Methods
-  virtual bool add_nas_timer(int timer_fd, enum nas_timer_type type, uint64_t imsi);
+  virtual bool add_nas_timer(enum nas_timer_type type, uint64_t imsi, uint32_t timeout_ms);
   virtual bool is_nas_timer_running(enum nas_timer_type type, uint64_t imsi);
   virtual bool remove_nas_timer(enum nas_timer_type type, uint64_t imsi);
 
+  /// GTP-C interface of the NAS contexts, it hands off the requests to the MME thread when S1AP runs on workers
+  gtpc_interface_nas* get_gtpc_if();
+
+  /// Runs a task on the MME thread. It can be called from any thread, without blocking
+  bool defer_task(srsran::move_task_t task);
+
 private:
   mme();
   virtual ~mme();
@@ -71,14 +111,37 @@ private:
   s1ap*       m_s1ap;
   mme_gtpc*   m_mme_gtpc;
 
-  bool   m_running;
-  fd_set m_set;
+  bool m_running;
+  int  m_epoll_fd   = -1;
+  int  m_tick_fd    = -1;
+  bool m_tick_armed = false;
+
+  // Tasks of the S1AP workers. Only the first task since the last wakeup writes the eventfd
+  uint32_t                                        m_nof_s1ap_workers = 0;
+  mme_gtpc_handoff                                m_gtpc_handoff;
+  srsran::mpmc_bounded_queue<srsran::move_task_t> m_tasks;
+  int                                             m_task_fd = -1;
+  std::atomic<bool>                               m_task_signalled{false};
 
-  // Timer map
-  std::vector<mme_timer_t> timers;
+  // NAS timers, indexed by IMSI and type. The wheel is only stepped while any of them runs.
+  // The S1AP workers start and stop timers, so the wheel is locked
+  std::mutex                                         m_timers_mutex;
+  srsran::timer_handler                              m_timers;
+  std::unordered_map<uint64_t, srsran::unique_timer> m_nas_timers;
+  std::vector<uint64_t>                              m_expired_nas_timers;
+
+  // Event handling
+  void handle_s1mme(int s1mme);
+  void handle_s11(int s11, srsran::byte_buffer_t* pdu);
 
   // Timer Methods
-  void handle_timer_expire(int timer_fd);
+  static uint64_t nas_timer_key(enum nas_timer_type type, uint64_t imsi) { return (imsi << 4U) | type; }
+  void            step_nas_timers(uint64_t nof_ticks);
+  void            update_tick_timer();
+
+  // Task Methods
+  void wake_up();
+  void run_deferred_tasks();
 
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
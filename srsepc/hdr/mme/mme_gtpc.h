@@ -52,7 +52,7 @@ public:
   bool         handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu);
   virtual bool send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify, srsran::gtp_fteid_t* enb_fteid);
   void         handle_modify_bearer_response(srsran::gtpc_pdu* mb_resp_pdu);
-  void         send_release_access_bearers_request(uint64_t imsi);
+  virtual bool send_release_access_bearers_request(uint64_t imsi);
   virtual bool send_delete_session_request(uint64_t imsi);
   bool         handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu);
   void         send_downlink_data_notification_acknowledge(uint64_t imsi, enum srsran::gtpc_cause_value cause);
@@ -28,6 +28,7 @@
 #include "srsran/common/security.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <memory>
 #include <netinet/sctp.h>
 
 namespace srsepc {
@@ -152,7 +153,8 @@ typedef struct {
   mme_interface_nas*  mme;
 } nas_if_t;
 
-class nas
+/// UE context, shared by the S1AP maps and by the S1AP workers handling an event of the UE
+class nas : public std::enable_shared_from_this<nas>
 {
 public:
   nas(const nas_init_t& args, const nas_if_t& itf);
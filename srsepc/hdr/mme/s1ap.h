@@ -21,6 +21,7 @@
 #ifndef SRSEPC_S1AP_H
 #define SRSEPC_S1AP_H
 
+#include "concurrent_map.h"
 #include "mme_gtpc.h"
 #include "nas.h"
 #include "s1ap_ctx_mngmt_proc.h"
@@ -29,16 +30,22 @@
 #include "s1ap_nas_transport.h"
 #include "s1ap_paging.h"
 #include "srsepc/hdr/hss/hss.h"
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/move_callback.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/asn1/s1ap.h"
 #include "srsran/common/common.h"
 #include "srsran/common/s1ap_pcap.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <arpa/inet.h>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <netinet/sctp.h>
 #include <set>
 #include <strings.h>
@@ -50,6 +57,9 @@ namespace srsepc {
 
 const uint16_t S1MME_PORT = 36412;
 
+/// Maximum number of PDUs and UE events waiting for an S1AP worker
+const uint32_t S1AP_WORKER_QUEUE_SIZE = 4096;
+
 using s1ap_pdu_t = asn1::s1ap::s1ap_pdu_c;
 
 class s1ap : public s1ap_interface_nas, public s1ap_interface_gtpc, public s1ap_interface_mme
@@ -68,6 +78,21 @@ public:
 
   bool s1ap_tx_pdu(const s1ap_pdu_t& pdu, struct sctp_sndrcvinfo* enb_sri);
   void handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+
+  /**
+   * S1AP workers. With workers, the MME thread only reads the S1-MME socket, and every SCTP association is processed
+   * in order by the worker it maps to. A UE is owned by the worker of the association it was last seen on. The S1AP
+   * messages of the UE received on other associations, and the events the MME thread raises for it (S11 responses,
+   * NAS timers) run on that worker. A message or event still queued on the previous worker when the UE moves is
+   * forwarded to the new one. The UE contexts are shared pointers, so a context
+   * deleted by one worker stays valid for an event of another worker that already looked it up.
+   */
+  void     dispatch_s1ap_rx_pdu(srsran::unique_byte_buffer_t pdu, const struct sctp_sndrcvinfo& enb_sri);
+  void     dispatch_enb_shutdown(int32_t assoc_id);
+  void     run_ue_task(uint64_t imsi, srsran::move_task_t task);
+  uint32_t get_nof_workers() const { return m_workers.size(); }
+  void     start_workers(uint32_t nof_workers);
+  void     stop_workers();
   void handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri);
   void handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg);
 
@@ -81,13 +106,14 @@ public:
   enb_ctx_t* find_enb_ctx(uint16_t enb_id);
   void       add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinfo* enb_sri);
   void       get_enb_ctx(uint16_t sctp_stream);
+  bool       send_to_all_enbs(const s1ap_pdu_t& pdu);
 
   bool add_nas_ctx_to_imsi_map(nas* nas_ctx);
   bool add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx);
   bool add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id);
 
-  virtual nas* find_nas_ctx_from_imsi(uint64_t imsi);
-  nas*         find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id);
+  virtual std::shared_ptr<nas> find_nas_ctx_from_imsi(uint64_t imsi);
+  std::shared_ptr<nas>         find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id);
 
   bool         release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id);
   void         release_ues_ecm_ctx_in_enb(int32_t enb_assoc);
@@ -105,8 +131,7 @@ public:
   s1ap_erab_mngmt_proc* m_s1ap_erab_mngmt_proc;
   s1ap_paging*          m_s1ap_paging;
 
-  std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
-  std::map<uint16_t, enb_ctx_t*> m_active_enbs;
+  concurrent_map<uint32_t, uint64_t> m_tmsi_to_imsi;
 
   // Interfaces
   virtual bool send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup);
@@ -132,26 +157,63 @@ private:
   s1ap();
   virtual ~s1ap();
 
+  /// Processes the tasks pushed to it in order, on its own thread
+  class worker : public srsran::thread
+  {
+  public:
+    explicit worker(uint32_t id);
+    ~worker();
+
+    bool push(srsran::move_task_t task) { return not tasks.push_blocking(std::move(task)).is_error(); }
+    void stop();
+
+  private:
+    void run_thread() override;
+
+    srsran::dyn_blocking_queue<srsran::move_task_t> tasks;
+  };
+
   static s1ap* m_instance;
 
   uint32_t m_plmn;
 
-  hss_interface_nas*                     m_hss;
-  int                                    m_s1mme;
+  hss_interface_nas* m_hss;
+  int                m_s1mme;
+
+  // eNB contexts, indexed by eNB Id and by SCTP association. They only change on S1 Setup and SCTP shutdown
+  std::mutex                             m_enb_mutex;
+  std::map<uint16_t, enb_ctx_t*>         m_active_enbs;
   std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
   std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
 
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+  concurrent_map<uint64_t, std::shared_ptr<nas> > m_imsi_to_nas_ctx;
+  concurrent_map<uint32_t, std::shared_ptr<nas> > m_mme_ue_s1ap_id_to_nas_ctx;
+
+  std::atomic<uint32_t> m_next_mme_ue_s1ap_id;
+  std::atomic<uint32_t> m_next_m_tmsi;
+
+  // Workers, and the worker owning each UE
+  std::vector<std::unique_ptr<worker> > m_workers;
+  concurrent_map<uint64_t, uint32_t>    m_imsi_to_worker;
 
-  uint32_t m_next_mme_ue_s1ap_id;
-  uint32_t m_next_m_tmsi;
+  uint32_t get_worker_idx(int32_t assoc_id) const { return (uint32_t)assoc_id % m_workers.size(); }
+  uint32_t get_ue_worker_idx(uint64_t imsi) const;
+  void     set_ue_worker(const nas* nas_ctx);
+  void     push_ue_task(uint32_t worker_idx, uint64_t imsi, srsran::move_task_t task);
+  void     push_s1ap_rx_pdu(uint32_t                      worker_idx,
+                            srsran::unique_byte_buffer_t  pdu,
+                            const struct sctp_sndrcvinfo& enb_sri);
+  void     route_s1ap_rx_pdu(uint32_t                      worker_idx,
+                             srsran::unique_byte_buffer_t  pdu,
+                             const struct sctp_sndrcvinfo& enb_sri);
+  uint64_t find_imsi_from_pdu(const srsran::byte_buffer_t& pdu);
 
-  // GTP-C Interface
-  mme_gtpc* m_mme_gtpc;
+  // GTP-C Interface, the requests of the workers are handed off to the MME thread
+  gtpc_interface_nas* m_gtpc;
 
   // PCAP
-  bool              m_pcap_enable;
+  bool              m_pcap_enable = false;
+  std::mutex        m_pcap_mutex;
   srsran::s1ap_pcap m_pcap;
 };
 
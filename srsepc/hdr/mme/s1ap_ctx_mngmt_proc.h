@@ -56,7 +56,7 @@ private:
 
   s1ap_args_t m_s1ap_args;
 
-  mme_gtpc* m_mme_gtpc;
+  gtpc_interface_nas* m_gtpc;
 };
 
 } // namespace srsepc
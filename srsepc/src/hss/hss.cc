@@ -44,6 +44,53 @@ hss::~hss()
   return;
 }
 
+static void ue_ctx_to_db_record(const hss_ue_ctx_t& ue_ctx, hss_db_record_t* record)
+{
+  *record      = {};
+  record->imsi = ue_ctx.imsi;
+  memcpy(record->key, ue_ctx.key, sizeof(record->key));
+  memcpy(record->op, ue_ctx.op, sizeof(record->op));
+  memcpy(record->opc, ue_ctx.opc, sizeof(record->opc));
+  memcpy(record->amf, ue_ctx.amf, sizeof(record->amf));
+  memcpy(record->sqn, ue_ctx.sqn, sizeof(record->sqn));
+  record->qci           = ue_ctx.qci;
+  record->algo          = ue_ctx.algo;
+  record->op_configured = ue_ctx.op_configured ? 1 : 0;
+  if (ue_ctx.static_ip_addr != "0.0.0.0") {
+    inet_pton(AF_INET, ue_ctx.static_ip_addr.c_str(), &record->static_ip_addr);
+  }
+  // Longer names are truncated, the HSS does not use them
+  strncpy(record->name, ue_ctx.name.c_str(), sizeof(record->name) - 1);
+}
+
+static void ue_ctx_to_auth_subscriber(const hss_ue_ctx_t& ue_ctx, hss_auth_subscriber_t* sub)
+{
+  sub->imsi = ue_ctx.imsi;
+  memcpy(sub->key, ue_ctx.key, sizeof(sub->key));
+  memcpy(sub->opc, ue_ctx.opc, sizeof(sub->opc));
+  memcpy(sub->amf, ue_ctx.amf, sizeof(sub->amf));
+  memcpy(sub->sqn, ue_ctx.sqn, sizeof(sub->sqn));
+}
+
+static void db_record_to_ue_ctx(const hss_db_record_t& record, hss_ue_ctx_t* ue_ctx)
+{
+  char ip_str[INET_ADDRSTRLEN] = {};
+  inet_ntop(AF_INET, &record.static_ip_addr, ip_str, sizeof(ip_str));
+
+  ue_ctx->name = std::string(record.name, strnlen(record.name, sizeof(record.name)));
+  ue_ctx->imsi = record.imsi;
+  ue_ctx->algo = (hss_auth_algo)record.algo;
+  memcpy(ue_ctx->key, record.key, sizeof(ue_ctx->key));
+  ue_ctx->op_configured = record.op_configured != 0;
+  memcpy(ue_ctx->op, record.op, sizeof(ue_ctx->op));
+  memcpy(ue_ctx->opc, record.opc, sizeof(ue_ctx->opc));
+  memcpy(ue_ctx->amf, record.amf, sizeof(ue_ctx->amf));
+  memcpy(ue_ctx->sqn, record.sqn, sizeof(ue_ctx->sqn));
+  ue_ctx->qci = record.qci;
+  memset(ue_ctx->last_rand, 0, sizeof(ue_ctx->last_rand));
+  ue_ctx->static_ip_addr = ip_str;
+}
+
 hss* hss::get_instance()
 {
   pthread_mutex_lock(&hss_instance_mutex);
@@ -68,8 +115,20 @@ int hss::init(hss_args_t* hss_args)
 {
   srand(time(NULL));
 
-  /*Read user information from DB*/
-  if (read_db_file(hss_args->db_file) == false) {
+  /*Read user information from DB. A subscriber database is mapped, a .csv file is parsed*/
+  if (hss_db::is_db_file(hss_args->db_file)) {
+    if (not m_db.open(hss_args->db_file, hss_args->db_sync)) {
+      srsran::console("Error opening subscriber database %s\n", hss_args->db_file.c_str());
+      return -1;
+    }
+    for (const hss_db_record_t& record : m_db) {
+      if (record.static_ip_addr != 0) {
+        char ip_str[INET_ADDRSTRLEN] = {};
+        inet_ntop(AF_INET, &record.static_ip_addr, ip_str, sizeof(ip_str));
+        m_ip_to_imsi.insert(std::make_pair(std::string(ip_str), record.imsi));
+      }
+    }
+  } else if (read_db_file(hss_args->db_file) == false) {
     srsran::console("Error reading user database file %s\n", hss_args->db_file.c_str());
     return -1;
   }
@@ -79,6 +138,34 @@ int hss::init(hss_args_t* hss_args)
 
   db_file = hss_args->db_file;
 
+  // Start generating the vectors of the first subscribers, up to the cache size
+  m_auth_cache.init(hss_args->auth_cache_size, hss_args->auth_cache_vectors, mcc, mnc);
+  hss_auth_subscriber_t sub      = {};
+  uint32_t              nof_subs = 0;
+  if (m_db.is_open()) {
+    for (const hss_db_record_t* record = m_db.begin(); record != m_db.end() && nof_subs < hss_args->auth_cache_size;
+         record++) {
+      if (record->algo == HSS_ALGO_MILENAGE) {
+        sub.imsi = record->imsi;
+        memcpy(sub.key, record->key, sizeof(sub.key));
+        memcpy(sub.opc, record->opc, sizeof(sub.opc));
+        memcpy(sub.amf, record->amf, sizeof(sub.amf));
+        memcpy(sub.sqn, record->sqn, sizeof(sub.sqn));
+        m_auth_cache.prefetch(sub);
+        nof_subs++;
+      }
+    }
+  } else {
+    for (auto it = m_imsi_to_ue_ctx.begin(); it != m_imsi_to_ue_ctx.end() && nof_subs < hss_args->auth_cache_size;
+         ++it) {
+      if (it->second->algo == HSS_ALGO_MILENAGE) {
+        ue_ctx_to_auth_subscriber(*it->second, &sub);
+        m_auth_cache.prefetch(sub);
+        nof_subs++;
+      }
+    }
+  }
+
   m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d", hss_args->db_file.c_str(), mcc, mnc);
   srsran::console("HSS Initialized.\n");
   return 0;
@@ -86,10 +173,33 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  m_auth_cache.stop();
+
+  // The subscriber database already holds every SQN update, the .csv file is rewritten with them
+  if (m_db.is_open()) {
+    m_db.close();
+  } else {
+    write_db_file(db_file);
+  }
   return;
 }
 
+bool hss::convert_db_file(const std::string& csv_file, const std::string& db_file)
+{
+  // Parse with a standalone HSS, so that the .csv file goes through the same checks as when it is used directly
+  hss csv_hss;
+  if (not csv_hss.read_db_file(csv_file)) {
+    return false;
+  }
+
+  std::vector<hss_db_record_t> records(csv_hss.m_imsi_to_ue_ctx.size());
+  uint32_t                     i = 0;
+  for (const auto& ue_ctx : csv_hss.m_imsi_to_ue_ctx) {
+    ue_ctx_to_db_record(*ue_ctx.second, &records[i++]);
+  }
+  return hss_db::create(db_file, records);
+}
+
 bool hss::read_db_file(std::string db_filename)
 {
   std::ifstream m_db_file;
@@ -256,6 +366,7 @@ bool hss::write_db_file(std::string db_filename)
 
 bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
 
   m_logger.debug("Generating AUTH info answer");
   hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
@@ -289,15 +400,35 @@ void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
   uint8_t* opc = ue_ctx->opc;
   uint8_t* sqn = ue_ctx->sqn;
 
-  // Temp variables
-  uint8_t ck[16];
-  uint8_t ik[16];
-  uint8_t ak[6];
-  uint8_t mac[8];
+  // Serve a pre-generated vector for the current SQN if there is one
+  hss_auth_subscriber_t sub    = {};
+  hss_auth_vector_t     vector = {};
+  ue_ctx_to_auth_subscriber(*ue_ctx, &sub);
+  if (m_auth_cache.is_enabled() && m_auth_cache.pop(sub, &vector)) {
+    memcpy(rand, vector.rand, sizeof(vector.rand));
+    memcpy(xres, vector.xres, sizeof(vector.xres));
+    memcpy(autn, vector.autn, sizeof(vector.autn));
+    memcpy(k_asme, vector.k_asme, sizeof(vector.k_asme));
+    m_logger.debug(rand, 16, "User Rand (cached): ");
+    m_logger.debug(sqn, 6, "User SQN : ");
+    m_logger.debug(autn, 16, "User AUTN: ");
+    ue_ctx->set_last_rand(rand);
+    return;
+  }
 
   gen_rand(rand);
 
-  srsran::security_milenage_f2345(k, opc, rand, xres, ck, ik, ak);
+  // f1 and f2345 as a batch of one vector, so that the AES key schedule is computed once
+  srsran::milenage_vector_t milenage = {};
+  memcpy(milenage.rand, rand, sizeof(milenage.rand));
+  memcpy(milenage.sqn, sqn, sizeof(milenage.sqn));
+  srsran::security_milenage_f12345_batch(k, opc, amf, &milenage, 1);
+  memcpy(xres, milenage.res, sizeof(milenage.res));
+
+  const uint8_t* ck  = milenage.ck;
+  const uint8_t* ik  = milenage.ik;
+  const uint8_t* ak  = milenage.ak;
+  const uint8_t* mac = milenage.mac_a;
 
   m_logger.debug(k, 16, "User Key : ");
   m_logger.debug(opc, 16, "User OPc : ");
@@ -307,8 +438,6 @@ void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
   m_logger.debug(ik, 16, "User IK: ");
   m_logger.debug(ak, 6, "User AK: ");
 
-  srsran::security_milenage_f1(k, opc, rand, sqn, amf, mac);
-
   m_logger.debug(sqn, 6, "User SQN : ");
   m_logger.debug(mac, 8, "User MAC : ");
 
@@ -440,13 +569,12 @@ void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_
 
 bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
-    m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
+  if (ue_ctx == nullptr) {
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     return false;
   }
-  const std::unique_ptr<hss_ue_ctx_t>& ue_ctx = ue_ctx_it->second;
   m_logger.info("Found User %015" PRIu64 "", imsi);
   *qci = ue_ctx->qci;
   return true;
@@ -454,6 +582,7 @@ bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 
 bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   m_logger.debug("Re-syncing SQN");
   hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
   if (ue_ctx == nullptr) {
@@ -472,6 +601,10 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
   }
 
   increment_seq_after_resync(ue_ctx);
+  store_sqn(ue_ctx);
+
+  // The cached vectors follow the previous SQN
+  m_auth_cache.invalidate(imsi);
   return true;
 }
 
@@ -540,9 +673,18 @@ void hss::increment_ue_sqn(hss_ue_ctx_t* ue_ctx)
   increment_sqn(ue_ctx->sqn, ue_ctx->sqn);
   m_logger.debug("Incremented SQN  -- IMSI: %015" PRIu64 "", ue_ctx->imsi);
   m_logger.debug(ue_ctx->sqn, 6, "SQN: ");
+  store_sqn(ue_ctx);
 }
 
-void hss::increment_sqn(uint8_t* sqn, uint8_t* next_sqn)
+void hss::store_sqn(hss_ue_ctx_t* ue_ctx)
+{
+  // Only the subscriber database persists each update, the .csv file is written on stop
+  if (m_db.is_open() && not m_db.update_sqn(ue_ctx->imsi, ue_ctx->sqn)) {
+    m_logger.error("Error storing SQN -- IMSI: %015" PRIu64 "", ue_ctx->imsi);
+  }
+}
+
+void hss::increment_sqn(const uint8_t* sqn, uint8_t* next_sqn)
 {
   // The following SQN incrementation function is implemented according to 3GPP TS 33.102 version 11.5.1 Annex C
   uint64_t seq;
@@ -613,12 +755,21 @@ void hss::gen_rand(uint8_t rand_[16])
 hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
 {
   std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
+  if (ue_ctx_it != m_imsi_to_ue_ctx.end()) {
+    return ue_ctx_it->second.get();
+  }
+
+  // Create the context of a subscriber from the database the first time it is used
+  const hss_db_record_t* record = m_db.find(imsi);
+  if (record == nullptr) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     return nullptr;
   }
+  std::unique_ptr<hss_ue_ctx_t> ue_ctx = std::unique_ptr<hss_ue_ctx_t>(new hss_ue_ctx_t);
+  db_record_to_ue_ctx(*record, ue_ctx.get());
+  m_logger.debug("Loaded user from DB, IMSI: %015" PRIu64 "", imsi);
 
-  return ue_ctx_it->second.get();
+  return m_imsi_to_ue_ctx.insert(std::make_pair(imsi, std::move(ue_ctx))).first->second.get();
 }
 
 std::map<std::string, uint64_t> hss::get_ip_to_imsi(void) const
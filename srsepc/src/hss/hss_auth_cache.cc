@@ -0,0 +1,258 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsepc/hdr/hss/hss_auth_cache.h"
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/security.h"
+#include <algorithm>
+#include <cstring>
+#include <inttypes.h> // for printing uint64_t
+
+namespace srsepc {
+
+hss_auth_cache::hss_auth_cache() : thread("HSS_AUTH") {}
+
+hss_auth_cache::~hss_auth_cache()
+{
+  stop();
+}
+
+void hss_auth_cache::init(uint32_t max_subscribers_, uint32_t nof_vectors_, uint16_t mcc_, uint16_t mnc_)
+{
+  if (max_subscribers_ == 0 || nof_vectors_ == 0) {
+    m_logger.info("Authentication vector cache disabled");
+    return;
+  }
+  max_subscribers = max_subscribers_;
+  nof_vectors     = nof_vectors_;
+  mcc             = mcc_;
+  mnc             = mnc_;
+  running         = true;
+  start();
+  m_logger.info("Authentication vector cache of %d subscribers, %d vectors generated at a time",
+                max_subscribers,
+                nof_vectors);
+}
+
+void hss_auth_cache::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cvar.notify_all();
+  wait_thread_finish();
+
+  entries.clear();
+  lru.clear();
+  requests.clear();
+}
+
+hss_auth_cache::entry_t& hss_auth_cache::get_entry(uint64_t imsi)
+{
+  auto it = entries.find(imsi);
+  if (it != entries.end()) {
+    lru.splice(lru.begin(), lru, it->second.lru_it);
+    return it->second;
+  }
+
+  if (entries.size() >= max_subscribers) {
+    entries.erase(lru.back());
+    lru.pop_back();
+  }
+  lru.push_front(imsi);
+  entry_t& entry = entries[imsi];
+  entry.lru_it   = lru.begin();
+  entry.epoch    = next_epoch++;
+  return entry;
+}
+
+void hss_auth_cache::request_refill(entry_t& entry, const hss_auth_subscriber_t& sub, const uint8_t* first_sqn)
+{
+  refill_request_t request = {};
+  request.sub              = sub;
+  request.epoch            = entry.epoch;
+  memcpy(request.sub.sqn, first_sqn, sizeof(request.sub.sqn));
+  requests.push_back(request);
+  entry.pending = true;
+  cvar.notify_one();
+}
+
+bool hss_auth_cache::pop(const hss_auth_subscriber_t& sub, hss_auth_vector_t* vector)
+{
+  uint8_t                     next_sqn[6];
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Vectors are generated in SQN order, the ones before the current SQN were skipped by a vector computed on request
+  entry_t& entry = get_entry(sub.imsi);
+  auto     it    = std::find_if(entry.vectors.begin(), entry.vectors.end(), [&sub](const hss_auth_vector_t& v) {
+    return memcmp(v.sqn, sub.sqn, sizeof(v.sqn)) == 0;
+  });
+  if (it == entry.vectors.end()) {
+    nof_misses++;
+    entry.vectors.clear();
+    if (not entry.pending) {
+      hss::increment_sqn(sub.sqn, next_sqn);
+      request_refill(entry, sub, next_sqn);
+    }
+    return false;
+  }
+
+  nof_hits++;
+  *vector = *it;
+  entry.vectors.erase(entry.vectors.begin(), it + 1);
+
+  // Refill before running out, so that the vectors of the following attaches are ready
+  if (not entry.pending && entry.vectors.size() <= nof_vectors / 2) {
+    hss::increment_sqn(entry.vectors.empty() ? vector->sqn : entry.vectors.back().sqn, next_sqn);
+    request_refill(entry, sub, next_sqn);
+  }
+  return true;
+}
+
+void hss_auth_cache::prefetch(const hss_auth_subscriber_t& sub)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (not running) {
+    return;
+  }
+  entry_t& entry = get_entry(sub.imsi);
+  if (entry.vectors.empty() && not entry.pending) {
+    request_refill(entry, sub, sub.sqn);
+  }
+}
+
+void hss_auth_cache::invalidate(uint64_t imsi)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  auto                        it = entries.find(imsi);
+  if (it == entries.end()) {
+    return;
+  }
+  it->second.vectors.clear();
+  it->second.epoch   = next_epoch++;
+  it->second.pending = false;
+  m_logger.debug("Dropped authentication vectors -- IMSI: %015" PRIu64 "", imsi);
+}
+
+uint64_t hss_auth_cache::get_nof_hits()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return nof_hits;
+}
+
+uint64_t hss_auth_cache::get_nof_misses()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return nof_misses;
+}
+
+uint32_t hss_auth_cache::size(uint64_t imsi)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  auto                        it = entries.find(imsi);
+  return it != entries.end() ? it->second.vectors.size() : 0;
+}
+
+void hss_auth_cache::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  idle_cvar.wait(lock, [this]() { return not running || (requests.empty() && not busy); });
+}
+
+void hss_auth_cache::generate(const refill_request_t&                 request,
+                              std::vector<srsran::milenage_vector_t>& milenage,
+                              std::vector<hss_auth_vector_t>&         vectors)
+{
+  const hss_auth_subscriber_t& sub = request.sub;
+
+  milenage.resize(nof_vectors);
+  vectors.resize(nof_vectors);
+  uint8_t sqn[6];
+  memcpy(sqn, sub.sqn, sizeof(sqn));
+  for (srsran::milenage_vector_t& m : milenage) {
+    for (uint32_t i = 0; i < sizeof(m.rand); i += sizeof(uint32_t)) {
+      uint32_t r = rand_source();
+      memcpy(&m.rand[i], &r, std::min(sizeof(r), sizeof(m.rand) - i));
+    }
+    memcpy(m.sqn, sqn, sizeof(m.sqn));
+    hss::increment_sqn(sqn, sqn);
+  }
+  srsran::security_milenage_f12345_batch(sub.key, sub.opc, sub.amf, milenage.data(), nof_vectors);
+
+  for (uint32_t i = 0; i < nof_vectors; i++) {
+    const srsran::milenage_vector_t& m = milenage[i];
+    hss_auth_vector_t&               v = vectors[i];
+
+    // AUTN = SQN xor AK || AMF || MAC
+    memcpy(v.sqn, m.sqn, sizeof(v.sqn));
+    memcpy(v.rand, m.rand, sizeof(v.rand));
+    memcpy(v.xres, m.res, sizeof(v.xres));
+    for (int j = 0; j < 6; j++) {
+      v.autn[j] = m.sqn[j] ^ m.ak[j];
+    }
+    memcpy(&v.autn[6], sub.amf, sizeof(sub.amf));
+    memcpy(&v.autn[8], m.mac_a, sizeof(m.mac_a));
+    srsran::security_generate_k_asme(m.ck, m.ik, v.autn, mcc, mnc, v.k_asme);
+  }
+}
+
+void hss_auth_cache::run_thread()
+{
+  std::vector<srsran::milenage_vector_t> milenage;
+  std::vector<hss_auth_vector_t>         vectors;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    if (requests.empty()) {
+      idle_cvar.notify_all();
+      cvar.wait(lock);
+      continue;
+    }
+    refill_request_t request = requests.front();
+    requests.pop_front();
+
+    // Skip the subscribers evicted or invalidated since the request
+    auto it = entries.find(request.sub.imsi);
+    if (it == entries.end() || it->second.epoch != request.epoch) {
+      continue;
+    }
+
+    busy = true;
+    lock.unlock();
+    generate(request, milenage, vectors);
+    lock.lock();
+    busy = false;
+
+    it = entries.find(request.sub.imsi);
+    if (it == entries.end() || it->second.epoch != request.epoch) {
+      continue;
+    }
+    it->second.vectors.insert(it->second.vectors.end(), vectors.begin(), vectors.end());
+    it->second.pending = false;
+    m_logger.debug("Generated %zd authentication vectors -- IMSI: %015" PRIu64 "", vectors.size(), request.sub.imsi);
+  }
+  idle_cvar.notify_all();
+}
+
+} // namespace srsepc
@@ -0,0 +1,338 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsepc/hdr/hss/hss_db.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <inttypes.h> // for printing uint64_t
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace srsepc {
+
+static const char     hss_db_magic[8] = {'S', 'R', 'S', 'H', 'S', 'S', 'D', 'B'};
+static const uint32_t hss_db_version  = 1;
+
+hss_db::~hss_db()
+{
+  close();
+}
+
+uint64_t hss_db::hash(uint64_t imsi)
+{
+  // Fibonacci hashing, the high bits are folded into the low bits used by the slot mask
+  uint64_t h = imsi * 0x9E3779B97F4A7C15ULL;
+  return h ^ (h >> 29);
+}
+
+uint16_t hss_db::log_check(const log_entry_t& entry)
+{
+  // Fletcher-16 over the entry without the check. The first sum starts at 1 so that a zeroed entry is not valid
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(&entry);
+  uint32_t       sum1 = 1;
+  uint32_t       sum2 = 0;
+  for (size_t i = 0; i < offsetof(log_entry_t, check); i++) {
+    sum1 = (sum1 + data[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return (uint16_t)((sum2 << 8) | sum1);
+}
+
+bool hss_db::write_all(int fd, const void* data, size_t len)
+{
+  const uint8_t* ptr = static_cast<const uint8_t*>(data);
+  while (len > 0) {
+    ssize_t n = write(fd, ptr, len);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    ptr += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool hss_db::is_db_file(const std::string& db_file)
+{
+  char magic[sizeof(hss_db_magic)] = {};
+  int  fd                          = ::open(db_file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  ssize_t n = pread(fd, magic, sizeof(magic), 0);
+  ::close(fd);
+  return n == (ssize_t)sizeof(magic) && memcmp(magic, hss_db_magic, sizeof(magic)) == 0;
+}
+
+bool hss_db::create(const std::string& db_file, const std::vector<hss_db_record_t>& records)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("HSS");
+
+  // Index with at least twice as many slots as records, so that probe sequences stay short
+  uint64_t nof_slots = 16;
+  while (nof_slots < 2 * records.size()) {
+    nof_slots *= 2;
+  }
+  std::vector<slot_t> index(nof_slots, slot_t{});
+  for (uint32_t i = 0; i < records.size(); i++) {
+    uint64_t s = hash(records[i].imsi) & (nof_slots - 1);
+    while (index[s].record_idx != 0) {
+      if (index[s].imsi == records[i].imsi) {
+        logger.error("Duplicate IMSI %015" PRIu64 " in subscriber database", records[i].imsi);
+        return false;
+      }
+      s = (s + 1) & (nof_slots - 1);
+    }
+    index[s].imsi       = records[i].imsi;
+    index[s].record_idx = i + 1;
+  }
+
+  header_t header = {};
+  memcpy(header.magic, hss_db_magic, sizeof(header.magic));
+  header.version        = hss_db_version;
+  header.record_size    = sizeof(hss_db_record_t);
+  header.nof_records    = records.size();
+  header.nof_slots      = nof_slots;
+  header.records_offset = sizeof(header_t);
+  header.index_offset   = header.records_offset + records.size() * sizeof(hss_db_record_t);
+
+  // Write a temporary file and rename it, so that the previous database stays valid until the new one is complete
+  std::string tmp_file = db_file + ".tmp";
+  int         fd       = ::open(tmp_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    logger.error("Error creating subscriber database %s: %s", tmp_file.c_str(), strerror(errno));
+    return false;
+  }
+  bool ok = write_all(fd, &header, sizeof(header)) &&
+            write_all(fd, records.data(), records.size() * sizeof(hss_db_record_t)) &&
+            write_all(fd, index.data(), index.size() * sizeof(slot_t)) && fsync(fd) == 0;
+  ::close(fd);
+  if (not ok || rename(tmp_file.c_str(), db_file.c_str()) != 0) {
+    logger.error("Error writing subscriber database %s: %s", db_file.c_str(), strerror(errno));
+    unlink(tmp_file.c_str());
+    return false;
+  }
+
+  // The SQN log of a previous database does not apply to the new one
+  unlink((db_file + ".sqn").c_str());
+  return true;
+}
+
+bool hss_db::open(const std::string& db_file, bool sync_log)
+{
+  close();
+
+  db_fd = ::open(db_file.c_str(), O_RDWR);
+  if (db_fd < 0) {
+    logger.error("Error opening subscriber database %s: %s", db_file.c_str(), strerror(errno));
+    return false;
+  }
+
+  struct stat st     = {};
+  header_t    header = {};
+  if (fstat(db_fd, &st) != 0 || pread(db_fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+      memcmp(header.magic, hss_db_magic, sizeof(header.magic)) != 0 || header.version != hss_db_version ||
+      header.record_size != sizeof(hss_db_record_t) || header.nof_slots == 0 ||
+      (header.nof_slots & (header.nof_slots - 1)) != 0 ||
+      header.index_offset != header.records_offset + header.nof_records * sizeof(hss_db_record_t) ||
+      (uint64_t)st.st_size < header.index_offset + header.nof_slots * sizeof(slot_t)) {
+    logger.error("Invalid subscriber database %s", db_file.c_str());
+    close();
+    return false;
+  }
+
+  // The mapping is private, the SQN updates reach the file through the log and compaction only
+  map_len = st.st_size;
+  map     = mmap(nullptr, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, db_fd, 0);
+  if (map == MAP_FAILED) {
+    logger.error("Error mapping subscriber database %s: %s", db_file.c_str(), strerror(errno));
+    map = nullptr;
+    close();
+    return false;
+  }
+  records     = reinterpret_cast<hss_db_record_t*>(static_cast<uint8_t*>(map) + header.records_offset);
+  nof_records = header.nof_records;
+  slots       = reinterpret_cast<const slot_t*>(static_cast<uint8_t*>(map) + header.index_offset);
+  slot_mask   = header.nof_slots - 1;
+
+  sync     = sync_log;
+  log_file = db_file + ".sqn";
+  log_fd   = ::open(log_file.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (log_fd < 0) {
+    logger.error("Error opening SQN log %s: %s", log_file.c_str(), strerror(errno));
+    close();
+    return false;
+  }
+
+  // Drop a torn entry at the end of the log, the next updates are appended after the last valid one
+  off_t log_len = replay_log();
+  if (log_len < 0 || ftruncate(log_fd, log_len) != 0 || not compact()) {
+    logger.error("Error recovering SQN log %s", log_file.c_str());
+    close();
+    return false;
+  }
+
+  logger.info("Opened subscriber database %s with %" PRIu64 " subscribers", db_file.c_str(), nof_records);
+  return true;
+}
+
+void hss_db::close()
+{
+  if (records != nullptr && log_fd >= 0) {
+    compact();
+  }
+  if (map != nullptr) {
+    munmap(map, map_len);
+  }
+  if (log_fd >= 0) {
+    ::close(log_fd);
+  }
+  if (db_fd >= 0) {
+    ::close(db_fd);
+  }
+  db_fd       = -1;
+  log_fd      = -1;
+  map         = nullptr;
+  map_len     = 0;
+  records     = nullptr;
+  nof_records = 0;
+  slots       = nullptr;
+  slot_mask   = 0;
+  dirty.clear();
+}
+
+hss_db_record_t* hss_db::find_record(uint64_t imsi) const
+{
+  if (records == nullptr) {
+    return nullptr;
+  }
+  for (uint64_t s = hash(imsi) & slot_mask; slots[s].record_idx != 0; s = (s + 1) & slot_mask) {
+    if (slots[s].imsi == imsi) {
+      return &records[slots[s].record_idx - 1];
+    }
+  }
+  return nullptr;
+}
+
+const hss_db_record_t* hss_db::find(uint64_t imsi) const
+{
+  return find_record(imsi);
+}
+
+bool hss_db::update_sqn(uint64_t imsi, const uint8_t* sqn)
+{
+  hss_db_record_t* record = find_record(imsi);
+  if (record == nullptr) {
+    return false;
+  }
+  memcpy(record->sqn, sqn, sizeof(record->sqn));
+
+  log_entry_t entry = {};
+  entry.imsi        = imsi;
+  memcpy(entry.sqn, sqn, sizeof(entry.sqn));
+  entry.check = log_check(entry);
+  if (not write_all(log_fd, &entry, sizeof(entry)) || (sync && fdatasync(log_fd) != 0)) {
+    logger.error("Error writing SQN log %s: %s", log_file.c_str(), strerror(errno));
+    return false;
+  }
+  dirty.push_back(record - records);
+
+  if (dirty.size() >= max_log_entries) {
+    return compact();
+  }
+  return true;
+}
+
+off_t hss_db::replay_log()
+{
+  struct stat st = {};
+  if (fstat(log_fd, &st) != 0) {
+    logger.error("Error reading SQN log %s: %s", log_file.c_str(), strerror(errno));
+    return -1;
+  }
+
+  std::vector<log_entry_t> entries(st.st_size / sizeof(log_entry_t));
+  size_t                   len = entries.size() * sizeof(log_entry_t);
+  if (pread(log_fd, entries.data(), len, 0) != (ssize_t)len) {
+    logger.error("Error reading SQN log %s: %s", log_file.c_str(), strerror(errno));
+    return -1;
+  }
+
+  // Stop at the first torn entry, nothing after it was acknowledged
+  uint32_t nof_valid   = 0;
+  uint32_t nof_applied = 0;
+  for (const log_entry_t& entry : entries) {
+    if (entry.check != log_check(entry)) {
+      break;
+    }
+    nof_valid++;
+    hss_db_record_t* record = find_record(entry.imsi);
+    if (record == nullptr) {
+      logger.warning("SQN log entry for unknown IMSI %015" PRIu64 "", entry.imsi);
+      continue;
+    }
+    memcpy(record->sqn, entry.sqn, sizeof(record->sqn));
+    dirty.push_back(record - records);
+    nof_applied++;
+  }
+  off_t valid_len = nof_valid * sizeof(log_entry_t);
+  if (valid_len < st.st_size) {
+    logger.warning("Ignoring %" PRId64 " torn SQN log bytes after %d updates",
+                   (int64_t)(st.st_size - valid_len),
+                   nof_valid);
+  }
+  if (nof_applied > 0) {
+    logger.info("Replayed %d SQN updates from %s", nof_applied, log_file.c_str());
+  }
+  return valid_len;
+}
+
+bool hss_db::compact()
+{
+  if (dirty.empty()) {
+    return true;
+  }
+
+  // The log is only emptied once the records are on the storage, a crash in between replays the same updates again
+  uint64_t records_offset = reinterpret_cast<uint8_t*>(records) - static_cast<uint8_t*>(map);
+  for (uint32_t idx : dirty) {
+    off_t offset = records_offset + idx * sizeof(hss_db_record_t) + offsetof(hss_db_record_t, sqn);
+    if (pwrite(db_fd, records[idx].sqn, sizeof(records[idx].sqn), offset) != (ssize_t)sizeof(records[idx].sqn)) {
+      logger.error("Error writing subscriber database: %s", strerror(errno));
+      return false;
+    }
+  }
+  if (fdatasync(db_fd) != 0 || ftruncate(log_fd, 0) != 0 || (sync && fdatasync(log_fd) != 0)) {
+    logger.error("Error compacting SQN log %s: %s", log_file.c_str(), strerror(errno));
+    return false;
+  }
+
+  logger.debug("Compacted %zd SQN updates into the subscriber database", dirty.size());
+  dirty.clear();
+  return true;
+}
+
+} // namespace srsepc
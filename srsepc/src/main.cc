@@ -126,7 +126,11 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("mme.paging_timer",    bpo::value<uint16_t>(&paging_timer)->default_value(2),           "Set paging timer value in seconds (T3413)")
     ("mme.request_imeisv",  bpo::value<bool>(&request_imeisv)->default_value(false),         "Enable IMEISV request in Security mode command")
     ("mme.lac",             bpo::value<string>(&lac)->default_value("0x01"),                 "Location Area Code")
-    ("hss.db_file",         bpo::value<string>(&hss_db_file)->default_value("ue_db.csv"),    ".csv file that stores UE's keys")
+    ("mme.s1ap_workers",    bpo::value<uint32_t>(&args->mme_args.s1ap_args.nof_workers)->default_value(0), "Number of S1AP worker threads, 0 to handle S1AP on the MME thread")
+    ("hss.db_file",         bpo::value<string>(&hss_db_file)->default_value("ue_db.csv"),    ".csv file or subscriber database that stores UE's keys")
+    ("hss.db_sync",         bpo::value<bool>(&args->hss_args.db_sync)->default_value(true),  "Flush every SQN update of a subscriber database to the storage before answering")
+    ("hss.auth_cache_size",    bpo::value<uint32_t>(&args->hss_args.auth_cache_size)->default_value(16384), "Number of subscribers with pre-generated authentication vectors, 0 to disable")
+    ("hss.auth_cache_vectors", bpo::value<uint32_t>(&args->hss_args.auth_cache_vectors)->default_value(8),  "Number of authentication vectors generated per subscriber at a time")
     ("spgw.gtpu_bind_addr", bpo::value<string>(&spgw_bind_addr)->default_value("127.0.0.1"), "IP address of SP-GW for the S1-U connection")
     ("spgw.sgi_if_addr",    bpo::value<string>(&sgi_if_addr)->default_value("176.16.0.1"),   "IP address of TUN interface for the SGi connection")
     ("spgw.sgi_if_name",    bpo::value<string>(&sgi_if_name)->default_value("srs_spgw_sgi"), "Name of TUN interface for the SGi connection")
@@ -23,6 +23,7 @@
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
@@ -31,7 +32,11 @@ namespace srsepc {
 mme*            mme::m_instance    = NULL;
 pthread_mutex_t mme_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-mme::mme() : m_running(false), thread("MME")
+mme::mme() :
+  m_running(false),
+  thread("MME"),
+  m_gtpc_handoff(this, mme_gtpc::get_instance()),
+  m_tasks(MME_TASK_QUEUE_SIZE)
 {
   return;
 }
@@ -63,6 +68,14 @@ void mme::cleanup(void)
 
 int mme::init(mme_args_t* args)
 {
+  // The S1AP workers hand off tasks to the MME thread, so the eventfd exists before they start
+  m_nof_s1ap_workers = args->s1ap_args.nof_workers;
+  m_task_fd          = eventfd(0, EFD_NONBLOCK);
+  if (m_task_fd < 0) {
+    m_s1ap_logger.error("Error creating MME task eventfd: %s", strerror(errno));
+    exit(-1);
+  }
+
   /*Init S1AP*/
   m_s1ap = s1ap::get_instance();
   if (m_s1ap->init(args->s1ap_args)) {
@@ -92,6 +105,10 @@ void mme::stop()
     thread_cancel();
     wait_thread_finish();
   }
+  if (m_task_fd >= 0) {
+    close(m_task_fd);
+    m_task_fd = -1;
+  }
   return;
 }
 
@@ -102,14 +119,6 @@ void mme::run_thread()
     m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
     return;
   }
-  uint32_t                     sz  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
-
-  struct sockaddr_in     enb_addr;
-  struct sctp_sndrcvinfo sri;
-  socklen_t              fromlen = sizeof(enb_addr);
-  bzero(&enb_addr, sizeof(enb_addr));
-  int rd_sz;
-  int msg_flags = 0;
 
   // Mark the thread as running
   m_running = true;
@@ -118,122 +127,283 @@ void mme::run_thread()
   int s1mme = m_s1ap->get_s1_mme();
   int s11   = m_mme_gtpc->get_s11();
 
+  // A single epoll set waits for both sockets, the tick of the NAS timer wheel and the tasks of the S1AP workers
+  m_epoll_fd = epoll_create1(0);
+  m_tick_fd  = timerfd_create(CLOCK_MONOTONIC, 0);
+  if (m_epoll_fd < 0 || m_tick_fd < 0 || add_epoll(s1mme, m_epoll_fd) != SRSRAN_SUCCESS ||
+      add_epoll(s11, m_epoll_fd) != SRSRAN_SUCCESS || add_epoll(m_tick_fd, m_epoll_fd) != SRSRAN_SUCCESS ||
+      add_epoll(m_task_fd, m_epoll_fd) != SRSRAN_SUCCESS) {
+    m_s1ap_logger.error("Error creating MME event loop: %s", strerror(errno));
+    srsran::console("Error creating MME event loop: %s\n", strerror(errno));
+    return;
+  }
+
+  struct epoll_event events[MME_MAX_EVENTS];
   while (m_running) {
-    pdu->clear();
-    int max_fd = std::max(s1mme, s11);
-
-    FD_ZERO(&m_set);
-    FD_SET(s1mme, &m_set);
-    FD_SET(s11, &m_set);
-
-    // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
-      FD_SET(it->fd, &m_set);
-      max_fd = std::max(max_fd, it->fd);
-      m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
-    }
+    update_tick_timer();
 
     m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
-    int n = select(max_fd + 1, &m_set, NULL, NULL, NULL);
+    int n = epoll_wait(m_epoll_fd, events, MME_MAX_EVENTS, -1);
     if (n == -1) {
-      m_s1ap_logger.error("Error from select");
-    } else if (n) {
-      // Handle S1-MME
-      if (FD_ISSET(s1mme, &m_set)) {
-        rd_sz = sctp_recvmsg(s1mme, pdu->msg, sz, (struct sockaddr*)&enb_addr, &fromlen, &sri, &msg_flags);
-        if (rd_sz == -1 && errno != EAGAIN) {
-          m_s1ap_logger.error("Error reading from SCTP socket: %s", strerror(errno));
-        } else if (rd_sz == -1 && errno == EAGAIN) {
-          m_s1ap_logger.debug("Socket timeout reached");
-        } else {
-          if (msg_flags & MSG_NOTIFICATION) {
-            // Received notification
-            union sctp_notification* notification = (union sctp_notification*)pdu->msg;
-            m_s1ap_logger.debug("SCTP Notification %d", notification->sn_header.sn_type);
-            if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
-              m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
-              srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
-              m_s1ap->delete_enb_ctx(sri.sinfo_assoc_id);
-            }
-          } else {
-            // Received data
-            pdu->N_bytes = rd_sz;
-            m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
-            m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
-          }
-        }
-      }
-      // Handle S11
-      if (FD_ISSET(s11, &m_set)) {
-        pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
+      if (errno != EINTR) {
+        m_s1ap_logger.error("Error from epoll_wait: %s", strerror(errno));
       }
-      // Handle NAS Timers
-      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
-        if (FD_ISSET(it->fd, &m_set)) {
-          m_s1ap_logger.info("Timer expired");
-          uint64_t exp;
-          rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
-          close(it->fd);
-          timers.erase(it);
-        } else {
-          ++it;
+      continue;
+    }
+
+    // Handle every event of the wakeup before waiting again
+    for (int i = 0; i < n; i++) {
+      int fd = events[i].data.fd;
+      if (fd == s1mme) {
+        handle_s1mme(s1mme);
+      } else if (fd == s11) {
+        handle_s11(s11, pdu.get());
+      } else if (fd == m_tick_fd) {
+        uint64_t nof_ticks = 0;
+        if (read(m_tick_fd, &nof_ticks, sizeof(nof_ticks)) == sizeof(nof_ticks)) {
+          step_nas_timers(nof_ticks);
         }
+      } else if (fd == m_task_fd) {
+        run_deferred_tasks();
       }
-    } else {
-      m_s1ap_logger.debug("No data from select.");
     }
   }
+
+  close(m_tick_fd);
+  close(m_epoll_fd);
   return;
 }
 
+void mme::handle_s1mme(int s1mme)
+{
+  // Each message gets its own buffer, since it may be handled on an S1AP worker after the next one is read
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer("mme::handle_s1mme");
+  if (pdu == nullptr) {
+    m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    return;
+  }
+
+  uint32_t               sz = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  struct sockaddr_in     enb_addr;
+  struct sctp_sndrcvinfo sri;
+  socklen_t              fromlen = sizeof(enb_addr);
+  bzero(&enb_addr, sizeof(enb_addr));
+  int msg_flags = 0;
+
+  int rd_sz = sctp_recvmsg(s1mme, pdu->msg, sz, (struct sockaddr*)&enb_addr, &fromlen, &sri, &msg_flags);
+  if (rd_sz == -1 && errno != EAGAIN) {
+    m_s1ap_logger.error("Error reading from SCTP socket: %s", strerror(errno));
+  } else if (rd_sz == -1 && errno == EAGAIN) {
+    m_s1ap_logger.debug("Socket timeout reached");
+  } else {
+    if (msg_flags & MSG_NOTIFICATION) {
+      // Received notification
+      union sctp_notification* notification = (union sctp_notification*)pdu->msg;
+      m_s1ap_logger.debug("SCTP Notification %d", notification->sn_header.sn_type);
+      if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
+        m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
+        srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
+        m_s1ap->dispatch_enb_shutdown(sri.sinfo_assoc_id);
+      }
+    } else {
+      // Received data
+      pdu->N_bytes = rd_sz;
+      m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
+      m_s1ap->dispatch_s1ap_rx_pdu(std::move(pdu), sri);
+    }
+  }
+}
+
+void mme::handle_s11(int s11, srsran::byte_buffer_t* pdu)
+{
+  uint32_t sz = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+
+  pdu->clear();
+  pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
+  m_mme_gtpc->handle_s11_pdu(pdu);
+}
+
+/*
+ * Task Handling
+ */
+gtpc_interface_nas* mme::get_gtpc_if()
+{
+  if (m_nof_s1ap_workers > 0) {
+    return &m_gtpc_handoff;
+  }
+  return mme_gtpc::get_instance();
+}
+
+bool mme::defer_task(srsran::move_task_t task)
+{
+  if (not m_tasks.try_push(std::move(task))) {
+    m_s1ap_logger.error("MME task queue is full, dropping task");
+    return false;
+  }
+  wake_up();
+  return true;
+}
+
+void mme::wake_up()
+{
+  if (m_task_signalled.exchange(true)) {
+    // The MME thread was already woken up and did not drain the queue yet
+    return;
+  }
+  uint64_t one = 1;
+  if (write(m_task_fd, &one, sizeof(one)) != sizeof(one)) {
+    m_s1ap_logger.error("Error waking up the MME thread: %s", strerror(errno));
+  }
+}
+
+void mme::run_deferred_tasks()
+{
+  uint64_t nof_wakeups = 0;
+  if (read(m_task_fd, &nof_wakeups, sizeof(nof_wakeups)) != sizeof(nof_wakeups)) {
+    return;
+  }
+  // Cleared before draining, so that a task pushed meanwhile wakes the thread again
+  m_task_signalled.exchange(false);
+
+  srsran::move_task_t task;
+  while (m_tasks.try_pop(task)) {
+    task();
+  }
+}
+
+bool mme_gtpc_handoff::send_create_session_request(uint64_t imsi)
+{
+  mme_gtpc* gtpc = m_gtpc;
+  return m_mme->defer_task([gtpc, imsi]() { gtpc->send_create_session_request(imsi); });
+}
+
+bool mme_gtpc_handoff::send_modify_bearer_request(uint64_t             imsi,
+                                                  uint16_t             erab_to_modify,
+                                                  srsran::gtp_fteid_t* enb_fteid)
+{
+  mme_gtpc*           gtpc  = m_gtpc;
+  srsran::gtp_fteid_t fteid = *enb_fteid;
+  return m_mme->defer_task([gtpc, imsi, erab_to_modify, fteid]() mutable {
+    gtpc->send_modify_bearer_request(imsi, erab_to_modify, &fteid);
+  });
+}
+
+bool mme_gtpc_handoff::send_release_access_bearers_request(uint64_t imsi)
+{
+  mme_gtpc* gtpc = m_gtpc;
+  return m_mme->defer_task([gtpc, imsi]() { gtpc->send_release_access_bearers_request(imsi); });
+}
+
+bool mme_gtpc_handoff::send_delete_session_request(uint64_t imsi)
+{
+  mme_gtpc* gtpc = m_gtpc;
+  return m_mme->defer_task([gtpc, imsi]() { gtpc->send_delete_session_request(imsi); });
+}
+
+bool mme_gtpc_handoff::send_downlink_data_notification_failure_indication(uint64_t                      imsi,
+                                                                          enum srsran::gtpc_cause_value cause)
+{
+  mme_gtpc* gtpc = m_gtpc;
+  return m_mme->defer_task(
+      [gtpc, imsi, cause]() { gtpc->send_downlink_data_notification_failure_indication(imsi, cause); });
+}
+
 /*
  * Timer Handling
  */
-bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
+bool mme::add_nas_timer(nas_timer_type type, uint64_t imsi, uint32_t timeout_ms)
 {
-  m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, timer_fd);
+  m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Timeout: %d ms", imsi, type, timeout_ms);
+
+  {
+    std::lock_guard<std::mutex> lock(m_timers_mutex);
+    uint64_t                    key   = nas_timer_key(type, imsi);
+    srsran::unique_timer&       timer = m_nas_timers[key];
+    if (not timer.is_valid()) {
+      timer = m_timers.get_unique_timer();
+    }
 
-  mme_timer_t timer;
-  timer.fd   = timer_fd;
-  timer.type = type;
-  timer.imsi = imsi;
+    // The expiry is only recorded here, the NAS context is notified once the wheel is not being stepped
+    uint32_t nof_ticks = std::max(1U, (timeout_ms + MME_TIMER_TICK_MS - 1) / MME_TIMER_TICK_MS);
+    timer.set(nof_ticks, [this, key](uint32_t tid) { m_expired_nas_timers.push_back(key); });
+    timer.run();
+  }
 
-  timers.push_back(timer);
+  // A timer started on an S1AP worker needs the MME thread to arm the tick, even if it is blocked waiting for events
+  if (m_nof_s1ap_workers > 0) {
+    wake_up();
+  }
   return true;
 }
 
 bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      return true; // found timer
-    }
-  }
-  return false;
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+  auto                        it = m_nas_timers.find(nas_timer_key(type, imsi));
+  return it != m_nas_timers.end() && it->second.is_running();
 }
 
 bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      break; // found timer to remove
-    }
-  }
-  if (it == timers.end()) {
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+  auto                        it = m_nas_timers.find(nas_timer_key(type, imsi));
+  if (it == m_nas_timers.end()) {
     m_s1ap_logger.warning("Could not find timer to remove. IMSI %" PRIu64 ", Type %d", imsi, type);
     return false;
   }
 
   // removing timer
-  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
-  close(it->fd);
-  timers.erase(it);
+  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d", imsi, type);
+  m_nas_timers.erase(it);
   return true;
 }
 
+void mme::step_nas_timers(uint64_t nof_ticks)
+{
+  // Release the expired timers before the NAS contexts handle them, so that they can start them again
+  std::vector<uint64_t> expired;
+  {
+    std::lock_guard<std::mutex> lock(m_timers_mutex);
+    for (uint64_t i = 0; i < nof_ticks; i++) {
+      m_timers.step_all();
+    }
+    expired.swap(m_expired_nas_timers);
+    for (uint64_t key : expired) {
+      m_nas_timers.erase(key);
+    }
+  }
+
+  // The NAS context is notified on the S1AP worker of the UE
+  for (uint64_t key : expired) {
+    m_s1ap_logger.info("Timer expired");
+    nas_timer_type type = (nas_timer_type)(key & 0xfU);
+    uint64_t       imsi = key >> 4U;
+    m_s1ap->run_ue_task(imsi, [this, type, imsi]() { m_s1ap->expire_nas_timer(type, imsi); });
+  }
+}
+
+void mme::update_tick_timer()
+{
+  // The tick only runs while a NAS timer is running, so that an idle MME does not wake up. The timers started on the
+  // S1AP workers are only counted as running after the next tick, so the tick is also armed while they are queued
+  bool arm = false;
+  {
+    std::lock_guard<std::mutex> lock(m_timers_mutex);
+    arm = m_timers.has_running_timers();
+  }
+  struct itimerspec ts = {};
+  if (arm == m_tick_armed) {
+    return;
+  }
+  if (arm) {
+    ts.it_value.tv_nsec    = MME_TIMER_TICK_MS * 1000000;
+    ts.it_interval.tv_nsec = MME_TIMER_TICK_MS * 1000000;
+  }
+  if (timerfd_settime(m_tick_fd, 0, &ts, NULL) < 0) {
+    m_s1ap_logger.error("Error setting NAS timer tick: %s", strerror(errno));
+    return;
+  }
+  m_tick_armed = arm;
+}
+
 } // namespace srsepc
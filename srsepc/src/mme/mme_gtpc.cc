@@ -249,19 +249,6 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
     return false;
   }
 
-  // Save create session response info to E-RAB context
-  nas* nas_ctx = m_s1ap->find_nas_ctx_from_imsi(imsi);
-  if (nas_ctx == NULL) {
-    m_logger.error("Could not find UE context. IMSI %015" PRIu64 "", imsi);
-    return false;
-  }
-  emm_ctx_t* emm_ctx = &nas_ctx->m_emm_ctx;
-  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
-
-  // Save UE IP to nas ctxt
-  emm_ctx->ue_ip.s_addr = cs_resp->paa.ipv4;
-  srsran::console("SPGW Allocated IP %s to IMSI %015" PRIu64 "\n", inet_ntoa(emm_ctx->ue_ip), emm_ctx->imsi);
-
   // Save SGW ctrl F-TEID in GTP-C context
   std::map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_g == m_imsi_to_gtpc_ctx.end()) {
@@ -272,13 +259,29 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   gtpc_ctx_t* gtpc_ctx    = &it_g->second;
   gtpc_ctx->sgw_ctr_fteid = sgw_ctr_fteid;
 
-  // Set EPS bearer context
-  // TODO default EPS bearer is hard-coded
-  int        default_bearer = 5;
-  esm_ctx_t* esm_ctx        = &nas_ctx->m_esm_ctx[default_bearer];
-  esm_ctx->pdn_addr_alloc   = cs_resp->paa;
-  esm_ctx->sgw_s1u_fteid    = cs_resp->eps_bearer_context_created.s1_u_sgw_f_teid;
-  m_s1ap->m_s1ap_ctx_mngmt_proc->send_initial_context_setup_request(nas_ctx, default_bearer);
+  // Save create session response info to E-RAB context, on the S1AP worker that owns the UE
+  srsran::gtpc_pdn_address_allocation_ie paa           = cs_resp->paa;
+  srsran::gtp_fteid_t                    sgw_s1u_fteid = cs_resp->eps_bearer_context_created.s1_u_sgw_f_teid;
+  m_s1ap->run_ue_task(imsi, [this, imsi, paa, sgw_s1u_fteid]() {
+    std::shared_ptr<nas> nas_ctx = m_s1ap->find_nas_ctx_from_imsi(imsi);
+    if (nas_ctx == NULL) {
+      m_logger.error("Could not find UE context. IMSI %015" PRIu64 "", imsi);
+      return;
+    }
+    emm_ctx_t* emm_ctx = &nas_ctx->m_emm_ctx;
+
+    // Save UE IP to nas ctxt
+    emm_ctx->ue_ip.s_addr = paa.ipv4;
+    srsran::console("SPGW Allocated IP %s to IMSI %015" PRIu64 "\n", inet_ntoa(emm_ctx->ue_ip), emm_ctx->imsi);
+
+    // Set EPS bearer context
+    // TODO default EPS bearer is hard-coded
+    int        default_bearer = 5;
+    esm_ctx_t* esm_ctx        = &nas_ctx->m_esm_ctx[default_bearer];
+    esm_ctx->pdn_addr_alloc   = paa;
+    esm_ctx->sgw_s1u_fteid    = sgw_s1u_fteid;
+    m_s1ap->m_s1ap_ctx_mngmt_proc->send_initial_context_setup_request(nas_ctx.get(), default_bearer);
+  });
   return true;
 }
 
@@ -325,8 +328,9 @@ void mme_gtpc::handle_modify_bearer_response(srsran::gtpc_pdu* mb_resp_pdu)
   }
 
   uint8_t ebi = mb_resp_pdu->choice.modify_bearer_response.eps_bearer_context_modified.ebi;
+  uint64_t imsi = imsi_it->second;
   m_logger.debug("Activating EPS bearer with id %d", ebi);
-  m_s1ap->activate_eps_bearer(imsi_it->second, ebi);
+  m_s1ap->run_ue_task(imsi, [this, imsi, ebi]() { m_s1ap->activate_eps_bearer(imsi, ebi); });
 
   return;
 }
@@ -371,7 +375,7 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   return true;
 }
 
-void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
+bool mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
 {
   // The GTP-C connection will not be torn down, just the user plane bearers.
   m_logger.info("Sending GTP-C Release Access Bearers Request");
@@ -383,7 +387,7 @@ void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
   std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
-    return;
+    return false;
   }
   sgw_ctr_fteid = it_ctx->second.sgw_ctr_fteid;
 
@@ -399,7 +403,7 @@ void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
   // Send msg to SPGW
   send_s11_pdu(rel_req_pdu);
 
-  return;
+  return true;
 }
 
 bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
@@ -419,7 +423,8 @@ bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
   uint8_t ebi = dl_not->eps_bearer_id;
   m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi_it->second, ebi);
 
-  m_s1ap->send_paging(imsi_it->second, ebi);
+  uint64_t imsi = imsi_it->second;
+  m_s1ap->run_ue_task(imsi, [this, imsi, ebi]() { m_s1ap->send_paging(imsi, ebi); });
   return true;
 }
 
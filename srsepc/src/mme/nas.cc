@@ -26,7 +26,6 @@
 #include <cmath>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
-#include <sys/timerfd.h>
 #include <time.h>
 
 namespace srsepc {
@@ -176,7 +175,7 @@ bool nas::handle_attach_request(uint32_t                enb_ue_s1ap_id,
                   pdn_con_req.esm_info_transfer_flag_present ? "true" : "false");
 
   // Get NAS Context if UE is known
-  nas* nas_ctx = s1ap->find_nas_ctx_from_imsi(imsi);
+  std::shared_ptr<nas> nas_ctx = s1ap->find_nas_ctx_from_imsi(imsi);
   if (nas_ctx == NULL) {
     // Get attach type from attach request
     if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
@@ -191,10 +190,10 @@ bool nas::handle_attach_request(uint32_t                enb_ue_s1ap_id,
     srsran::console("Attach Request -- Found previously attach UE.\n");
     if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
       nas::handle_imsi_attach_request_known_ue(
-          nas_ctx, enb_ue_s1ap_id, enb_sri, attach_req, pdn_con_req, nas_rx, args, itf);
+          nas_ctx.get(), enb_ue_s1ap_id, enb_sri, attach_req, pdn_con_req, nas_rx, args, itf);
     } else if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
       nas::handle_guti_attach_request_known_ue(
-          nas_ctx, enb_ue_s1ap_id, enb_sri, attach_req, pdn_con_req, nas_rx, args, itf);
+          nas_ctx.get(), enb_ue_s1ap_id, enb_sri, attach_req, pdn_con_req, nas_rx, args, itf);
     } else {
       return false;
     }
@@ -209,7 +208,7 @@ bool nas::handle_imsi_attach_request_unknown_ue(uint32_t
                                                 const nas_init_t&                                     args,
                                                 const nas_if_t&                                       itf)
 {
-  nas*                         nas_ctx;
+  std::shared_ptr<nas>         nas_ctx;
   srsran::unique_byte_buffer_t nas_tx;
   auto&                        nas_logger = srslog::fetch_basic_logger("NAS");
 
@@ -225,7 +224,7 @@ bool nas::handle_imsi_attach_request_unknown_ue(uint32_t
   }
 
   // Create UE context
-  nas_ctx = new nas(args, itf);
+  nas_ctx = std::make_shared<nas>(args, itf);
 
   // Save IMSI, eNB UE S1AP Id, MME UE S1AP Id and make sure UE is EMM_DEREGISTERED
   nas_ctx->m_emm_ctx.imsi           = imsi;
@@ -281,8 +280,8 @@ bool nas::handle_imsi_attach_request_unknown_ue(uint32_t
   nas_ctx->m_sec_ctx.eksi = 0;
 
   // Save the UE context
-  s1ap->add_nas_ctx_to_imsi_map(nas_ctx);
-  s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx);
+  s1ap->add_nas_ctx_to_imsi_map(nas_ctx.get());
+  s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx.get());
   s1ap->add_ue_to_enb_set(enb_sri->sinfo_assoc_id, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
 
   // Pack NAS Authentication Request in Downlink NAS Transport msg
@@ -342,7 +341,7 @@ bool nas::handle_guti_attach_request_unknown_ue(uint32_t
                                                 const nas_if_t&                                       itf)
 
 {
-  nas*                         nas_ctx;
+  std::shared_ptr<nas>         nas_ctx;
   srsran::unique_byte_buffer_t nas_tx;
 
   // Interfaces
@@ -351,7 +350,7 @@ bool nas::handle_guti_attach_request_unknown_ue(uint32_t
   gtpc_interface_nas* gtpc = itf.gtpc;
 
   // Create new NAS context.
-  nas_ctx = new nas(args, itf);
+  nas_ctx = std::make_shared<nas>(args, itf);
 
   // Could not find IMSI from M-TMSI, send Id request
   // The IMSI will be set when the identity response is received
@@ -395,7 +394,7 @@ bool nas::handle_guti_attach_request_unknown_ue(uint32_t
   }
 
   // Store temporary ue context
-  s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx);
+  s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx.get());
   s1ap->add_ue_to_enb_set(enb_sri->sinfo_assoc_id, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
 
   // Send Identity Request
@@ -619,7 +618,7 @@ bool nas::handle_service_request(uint32_t                m_tmsi,
     return true;
   }
 
-  nas* nas_ctx = s1ap->find_nas_ctx_from_imsi(imsi);
+  std::shared_ptr<nas> nas_ctx = s1ap->find_nas_ctx_from_imsi(imsi);
   if (nas_ctx == NULL || nas_ctx->m_emm_ctx.state != EMM_STATE_REGISTERED) {
     srsran::console("UE is not EMM-Registered.\n");
     nas_logger.error("UE is not EMM-Registered.");
@@ -689,7 +688,7 @@ bool nas::handle_service_request(uint32_t                m_tmsi,
     }
 
     // Save UE ctx to MME UE S1AP id
-    s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx);
+    s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx.get());
     s1ap->send_initial_context_setup_request(imsi, 5);
     sec_ctx->ul_nas_count++;
   } else {
@@ -709,7 +708,7 @@ bool nas::handle_service_request(uint32_t                m_tmsi,
     memcpy(&ecm_ctx->enb_sri, enb_sri, sizeof(struct sctp_sndrcvinfo));
     ecm_ctx->enb_ue_s1ap_id = enb_ue_s1ap_id;
     ecm_ctx->mme_ue_s1ap_id = s1ap->get_next_mme_ue_s1ap_id();
-    s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx);
+    s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx.get());
     s1ap->add_ue_to_enb_set(enb_sri->sinfo_assoc_id, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     srsran::unique_byte_buffer_t nas_tx = srsran::make_byte_buffer();
     if (nas_tx == nullptr) {
@@ -761,7 +760,7 @@ bool nas::handle_detach_request(uint32_t                m_tmsi,
     return true;
   }
 
-  nas* nas_ctx = s1ap->find_nas_ctx_from_imsi(imsi);
+  std::shared_ptr<nas> nas_ctx = s1ap->find_nas_ctx_from_imsi(imsi);
   if (nas_ctx == NULL) {
     srsran::console("Could not find UE context from IMSI\n");
     nas_logger.error("Could not find UE context from IMSI");
@@ -1226,7 +1225,7 @@ bool nas::handle_identity_response(srsran::byte_buffer_t* nas_rx)
   m_sec_ctx.eksi = 0;
 
   // Make sure UE context was not previously stored in IMSI map
-  nas* nas_ctx = m_s1ap->find_nas_ctx_from_imsi(imsi);
+  std::shared_ptr<nas> nas_ctx = m_s1ap->find_nas_ctx_from_imsi(imsi);
   if (nas_ctx != nullptr) {
     m_logger.warning("UE context already exists.");
     m_s1ap->delete_ue_ctx(imsi);
@@ -2050,25 +2049,7 @@ bool nas::start_t3413()
     return false;
   }
 
-  int fdt = timerfd_create(CLOCK_MONOTONIC, 0);
-  if (fdt < 0) {
-    m_logger.error("Error creating timer. %s", strerror(errno));
-    return false;
-  }
-  struct itimerspec t_value;
-  t_value.it_value.tv_sec     = m_t3413;
-  t_value.it_value.tv_nsec    = 0;
-  t_value.it_interval.tv_sec  = 0;
-  t_value.it_interval.tv_nsec = 0;
-
-  if (timerfd_settime(fdt, 0, &t_value, NULL) == -1) {
-    m_logger.error("Could not set timer");
-    close(fdt);
-    return false;
-  }
-
-  m_mme->add_nas_timer(fdt, T_3413, m_emm_ctx.imsi); // TODO timers without IMSI?
-  return true;
+  return m_mme->add_nas_timer(T_3413, m_emm_ctx.imsi, m_t3413 * 1000); // TODO timers without IMSI?
 }
 
 bool nas::expire_t3413()
@@ -20,8 +20,10 @@
  */
 
 #include "srsepc/hdr/mme/s1ap.h"
+#include "srsepc/hdr/mme/mme.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/bcd_helpers.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/network_utils.h"
 #include <cmath>
@@ -33,7 +35,7 @@ namespace srsepc {
 s1ap*           s1ap::m_instance    = NULL;
 pthread_mutex_t s1ap_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-s1ap::s1ap() : m_s1mme(-1), m_next_mme_ue_s1ap_id(1), m_mme_gtpc(NULL) {}
+s1ap::s1ap() : m_s1mme(-1), m_next_mme_ue_s1ap_id(1), m_gtpc(NULL) {}
 
 s1ap::~s1ap()
 {
@@ -73,6 +75,9 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   // Get pointer to the HSS
   m_hss = hss::get_instance();
 
+  // Get GTP-C interface, before the message handlers that use it
+  m_gtpc = mme::get_instance()->get_gtpc_if();
+
   // Init message handlers
   m_s1ap_mngmt_proc = s1ap_mngmt_proc::get_instance(); // Managment procedures
   m_s1ap_mngmt_proc->init();
@@ -85,9 +90,6 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   m_s1ap_paging = s1ap_paging::get_instance(); // Paging
   m_s1ap_paging->init();
 
-  // Get pointer to GTP-C class
-  m_mme_gtpc = mme_gtpc::get_instance();
-
   // Initialize S1-MME
   m_s1mme = enb_listen();
   if (m_s1mme == SRSRAN_ERROR) {
@@ -99,30 +101,57 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   if (m_pcap_enable) {
     m_pcap.open(s1ap_args.pcap_filename.c_str());
   }
+
+  start_workers(s1ap_args.nof_workers);
   m_logger.info("S1AP Initialized");
   return SRSRAN_SUCCESS;
 }
 
+void s1ap::start_workers(uint32_t nof_workers)
+{
+  // Every eNB SCTP association is processed by one of the workers
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    m_workers.emplace_back(new worker(i));
+  }
+  if (not m_workers.empty()) {
+    m_logger.info("S1AP processed by %zd workers", m_workers.size());
+  }
+}
+
+void s1ap::stop_workers()
+{
+  for (std::unique_ptr<worker>& w : m_workers) {
+    w->stop();
+  }
+  m_workers.clear();
+}
+
 void s1ap::stop()
 {
+  // Stop the workers before deleting the contexts they use
+  stop_workers();
+
   if (m_s1mme != -1) {
     close(m_s1mme);
   }
-  std::map<uint16_t, enb_ctx_t*>::iterator enb_it = m_active_enbs.begin();
-  while (enb_it != m_active_enbs.end()) {
-    m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_it->second->enb_id);
-    srsran::console("Deleting eNB context. eNB Id: 0x%x\n", enb_it->second->enb_id);
-    delete enb_it->second;
-    m_active_enbs.erase(enb_it++);
+  {
+    std::lock_guard<std::mutex>              lock(m_enb_mutex);
+    std::map<uint16_t, enb_ctx_t*>::iterator enb_it = m_active_enbs.begin();
+    while (enb_it != m_active_enbs.end()) {
+      m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_it->second->enb_id);
+      srsran::console("Deleting eNB context. eNB Id: 0x%x\n", enb_it->second->enb_id);
+      delete enb_it->second;
+      m_active_enbs.erase(enb_it++);
+    }
   }
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
-  while (ue_it != m_imsi_to_nas_ctx.end()) {
-    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
-    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
-    delete ue_it->second;
-    m_imsi_to_nas_ctx.erase(ue_it++);
-  }
+  m_imsi_to_nas_ctx.for_each([this](uint64_t imsi, const std::shared_ptr<nas>& nas_ctx) {
+    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", imsi);
+    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", imsi);
+  });
+  m_imsi_to_nas_ctx.clear();
+  m_mme_ue_s1ap_id_to_nas_ctx.clear();
+  m_imsi_to_worker.clear();
 
   // Cleanup message handlers
   s1ap_mngmt_proc::cleanup();
@@ -223,6 +252,7 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(buf->msg, buf->N_bytes);
   }
 
@@ -233,6 +263,7 @@ void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo
 {
   // Save PCAP
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
@@ -262,6 +293,194 @@ void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo
   }
 }
 
+// S1AP workers
+s1ap::worker::worker(uint32_t id) : thread("S1AP_" + std::to_string(id)), tasks(S1AP_WORKER_QUEUE_SIZE)
+{
+  start();
+}
+
+s1ap::worker::~worker()
+{
+  stop();
+}
+
+void s1ap::worker::stop()
+{
+  if (not tasks.is_stopped()) {
+    tasks.stop();
+    wait_thread_finish();
+  }
+}
+
+void s1ap::worker::run_thread()
+{
+  while (true) {
+    bool                success;
+    srsran::move_task_t task = tasks.pop_blocking(&success);
+    if (not success) {
+      break;
+    }
+    task();
+  }
+}
+
+void s1ap::dispatch_s1ap_rx_pdu(srsran::unique_byte_buffer_t pdu, const struct sctp_sndrcvinfo& enb_sri)
+{
+  struct sctp_sndrcvinfo sri = enb_sri;
+  if (m_workers.empty()) {
+    handle_s1ap_rx_pdu(pdu.get(), &sri);
+    return;
+  }
+  // The worker queue only blocks the MME thread when the worker is behind, the workers never wait for the MME thread
+  push_s1ap_rx_pdu(get_worker_idx(sri.sinfo_assoc_id), std::move(pdu), sri);
+}
+
+void s1ap::push_s1ap_rx_pdu(uint32_t                      worker_idx,
+                            srsran::unique_byte_buffer_t  pdu,
+                            const struct sctp_sndrcvinfo& enb_sri)
+{
+  bool pushed = m_workers[worker_idx]->push([this, worker_idx, enb_sri, pdu = std::move(pdu)]() mutable {
+    route_s1ap_rx_pdu(worker_idx, std::move(pdu), enb_sri);
+  });
+  if (not pushed) {
+    m_logger.warning("Dropped S1AP PDU, S1AP workers stopped");
+  }
+}
+
+void s1ap::route_s1ap_rx_pdu(uint32_t                      worker_idx,
+                             srsran::unique_byte_buffer_t  pdu,
+                             const struct sctp_sndrcvinfo& enb_sri)
+{
+  // A UE can send S1AP messages through two associations, e.g. when it reattaches through another eNB. They are handled
+  // by the worker owning the UE, so that they never run concurrently on its NAS context. The owner is checked again
+  // when the forwarded PDU runs, as for the UE events
+  uint64_t imsi      = find_imsi_from_pdu(*pdu);
+  uint32_t owner_idx = 0;
+  if (imsi != 0 and m_imsi_to_worker.find(imsi, owner_idx) and owner_idx != worker_idx) {
+    m_logger.debug("Forwarding S1AP PDU of IMSI %015" PRIu64 " from S1AP worker %d to %d", imsi, worker_idx, owner_idx);
+    push_s1ap_rx_pdu(owner_idx, std::move(pdu), enb_sri);
+    return;
+  }
+  struct sctp_sndrcvinfo sri = enb_sri;
+  handle_s1ap_rx_pdu(pdu.get(), &sri);
+}
+
+uint64_t s1ap::find_imsi_from_pdu(const srsran::byte_buffer_t& pdu)
+{
+  // Only the IEs that identify the UE are decoded, the full PDU is decoded by the worker that handles it
+  asn1::ap_pdu_view pdu_view;
+  if (pdu_view.unpack(pdu.msg, pdu.N_bytes) != asn1::SRSASN_SUCCESS) {
+    return 0;
+  }
+
+  // UE associated messages after the Initial UE Message
+  if (pdu_view.find_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID) != nullptr) {
+    asn1::s1ap::mme_ue_s1ap_id_t mme_ue_s1ap_id;
+    if (pdu_view.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) != asn1::SRSASN_SUCCESS) {
+      return 0;
+    }
+    std::shared_ptr<nas> nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id.value);
+    return nas_ctx != nullptr ? nas_ctx->m_emm_ctx.imsi : 0;
+  }
+  if (pdu_view.pdu_type() != s1ap_pdu_t::types_opts::init_msg or pdu_view.proc_code() != ASN1_S1AP_ID_INIT_UE_MSG) {
+    return 0;
+  }
+
+  // Initial UE Message of a UE with a GUTI
+  if (pdu_view.find_ie(ASN1_S1AP_ID_S_TMSI) != nullptr) {
+    asn1::s1ap::s_tmsi_s s_tmsi;
+    uint32_t             m_tmsi = 0;
+    if (pdu_view.unpack_ie(ASN1_S1AP_ID_S_TMSI, s_tmsi) != asn1::SRSASN_SUCCESS) {
+      return 0;
+    }
+    srsran::uint8_to_uint32(s_tmsi.m_tmsi.data(), &m_tmsi);
+    return find_imsi_from_m_tmsi(m_tmsi);
+  }
+
+  // Otherwise, only the Attach Request identifies the UE, by IMSI or GUTI
+  asn1::unbounded_octstring<false> nas_pdu;
+  srsran::unique_byte_buffer_t     nas_msg = srsran::make_byte_buffer();
+  if (nas_msg == nullptr or pdu_view.unpack_ie(ASN1_S1AP_ID_NAS_PDU, nas_pdu) != asn1::SRSASN_SUCCESS or
+      nas_pdu.size() > nas_msg->get_tailroom()) {
+    return 0;
+  }
+  memcpy(nas_msg->msg, nas_pdu.data(), nas_pdu.size());
+  nas_msg->N_bytes = nas_pdu.size();
+
+  uint8_t pd, msg_type;
+  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  if (msg_type != LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST or
+      liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &attach_req) != LIBLTE_SUCCESS) {
+    return 0;
+  }
+  if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
+    uint64_t imsi = 0;
+    for (int i = 0; i <= 14; i++) {
+      imsi += attach_req.eps_mobile_id.imsi[i] * std::pow(10, 14 - i);
+    }
+    return imsi;
+  }
+  if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
+    return find_imsi_from_m_tmsi(attach_req.eps_mobile_id.guti.m_tmsi);
+  }
+  return 0;
+}
+
+void s1ap::dispatch_enb_shutdown(int32_t assoc_id)
+{
+  if (m_workers.empty()) {
+    delete_enb_ctx(assoc_id);
+    return;
+  }
+  m_workers[get_worker_idx(assoc_id)]->push([this, assoc_id]() { delete_enb_ctx(assoc_id); });
+}
+
+void s1ap::run_ue_task(uint64_t imsi, srsran::move_task_t task)
+{
+  if (m_workers.empty()) {
+    task();
+    return;
+  }
+  push_ue_task(get_ue_worker_idx(imsi), imsi, std::move(task));
+}
+
+uint32_t s1ap::get_ue_worker_idx(uint64_t imsi) const
+{
+  uint32_t idx = 0;
+  if (not m_imsi_to_worker.find(imsi, idx)) {
+    // A UE without association has no S1AP messages to be ordered with
+    idx = imsi % m_workers.size();
+  }
+  return idx;
+}
+
+void s1ap::push_ue_task(uint32_t worker_idx, uint64_t imsi, srsran::move_task_t task)
+{
+  // The UE may move to another worker while the event is queued. The event is then forwarded to the new owner, so that
+  // it runs after the S1AP message that moved the UE and never concurrently with the UE's other messages
+  bool pushed = m_workers[worker_idx]->push([this, worker_idx, imsi, task = std::move(task)]() mutable {
+    uint32_t owner_idx = get_ue_worker_idx(imsi);
+    if (owner_idx != worker_idx) {
+      m_logger.debug("Forwarding event of IMSI %015" PRIu64 " from S1AP worker %d to %d", imsi, worker_idx, owner_idx);
+      push_ue_task(owner_idx, imsi, std::move(task));
+      return;
+    }
+    task();
+  });
+  if (not pushed) {
+    m_logger.warning("Dropped event of IMSI %015" PRIu64 ", S1AP workers stopped", imsi);
+  }
+}
+
+void s1ap::set_ue_worker(const nas* nas_ctx)
+{
+  if (m_workers.empty() || nas_ctx->m_emm_ctx.imsi == 0) {
+    return;
+  }
+  m_imsi_to_worker.insert_or_assign(nas_ctx->m_emm_ctx.imsi, get_worker_idx(nas_ctx->m_ecm_ctx.enb_sri.sinfo_assoc_id));
+}
+
 void s1ap::handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri)
 {
   using init_msg_type_opts_t = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts;
@@ -314,9 +533,10 @@ void s1ap::handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg
 void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinfo* enb_sri)
 {
   m_logger.info("Adding new eNB context. eNB ID %d", enb_ctx.enb_id);
-  std::set<uint32_t> ue_set;
-  enb_ctx_t*         enb_ptr = new enb_ctx_t;
-  *enb_ptr                   = enb_ctx;
+  std::set<uint32_t>          ue_set;
+  enb_ctx_t*                  enb_ptr = new enb_ctx_t;
+  *enb_ptr                            = enb_ctx;
+  std::lock_guard<std::mutex> lock(m_enb_mutex);
   m_active_enbs.insert(std::pair<uint16_t, enb_ctx_t*>(enb_ptr->enb_id, enb_ptr));
   m_sctp_to_enb_id.insert(std::pair<int32_t, uint16_t>(enb_sri->sinfo_assoc_id, enb_ptr->enb_id));
   m_enb_assoc_to_ue_ids.insert(std::pair<int32_t, std::set<uint32_t> >(enb_sri->sinfo_assoc_id, ue_set));
@@ -324,6 +544,7 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
 
 enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 {
+  std::lock_guard<std::mutex>              lock(m_enb_mutex);
   std::map<uint16_t, enb_ctx_t*>::iterator it = m_active_enbs.find(enb_id);
   if (it == m_active_enbs.end()) {
     return nullptr;
@@ -332,15 +553,30 @@ enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
   }
 }
 
-void s1ap::delete_enb_ctx(int32_t assoc_id)
+bool s1ap::send_to_all_enbs(const s1ap_pdu_t& pdu)
 {
-  std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
-  uint16_t                              enb_id   = it_assoc->second;
+  std::lock_guard<std::mutex> lock(m_enb_mutex);
+  for (std::map<uint16_t, enb_ctx_t*>::iterator it = m_active_enbs.begin(); it != m_active_enbs.end(); it++) {
+    enb_ctx_t* enb_ctx = it->second;
+    if (!s1ap_tx_pdu(pdu, &enb_ctx->sri)) {
+      m_logger.error("Error sending S1AP PDU to eNB. eNB Id: 0x%x.", enb_ctx->enb_id);
+      return false;
+    }
+  }
+  return true;
+}
 
-  std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
-  if (it_ctx == m_active_enbs.end() || it_assoc == m_sctp_to_enb_id.end()) {
-    m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
-    return;
+void s1ap::delete_enb_ctx(int32_t assoc_id)
+{
+  uint16_t enb_id = 0;
+  {
+    std::lock_guard<std::mutex>           lock(m_enb_mutex);
+    std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
+    if (it_assoc == m_sctp_to_enb_id.end() || m_active_enbs.count(it_assoc->second) == 0) {
+      m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
+      return;
+    }
+    enb_id = it_assoc->second;
   }
 
   m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_id);
@@ -350,28 +586,30 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
   release_ues_ecm_ctx_in_enb(assoc_id);
 
   // Delete eNB
+  std::lock_guard<std::mutex>              lock(m_enb_mutex);
+  std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
   delete it_ctx->second;
   m_active_enbs.erase(it_ctx);
-  m_sctp_to_enb_id.erase(it_assoc);
+  m_sctp_to_enb_id.erase(assoc_id);
   return;
 }
 
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
-  if (ctx_it != m_imsi_to_nas_ctx.end()) {
-    m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
-    return false;
-  }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-    if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
+    std::shared_ptr<nas> other_ctx;
+    if (m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, other_ctx) &&
+        other_ctx.get() != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
     }
   }
-  m_imsi_to_nas_ctx.insert(std::pair<uint64_t, nas*>(nas_ctx->m_emm_ctx.imsi, nas_ctx));
+  if (not m_imsi_to_nas_ctx.insert(nas_ctx->m_emm_ctx.imsi, nas_ctx->shared_from_this())) {
+    m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
+    return false;
+  }
+  set_ue_worker(nas_ctx);
   m_logger.debug("Saved UE context corresponding to IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
   return true;
 }
@@ -382,25 +620,19 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-  if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  if (not m_mme_ue_s1ap_id_to_nas_ctx.insert(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_ctx->shared_from_this())) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
-  if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-    if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
-      m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
-      return false;
-    }
-  }
-  m_mme_ue_s1ap_id_to_nas_ctx.insert(std::pair<uint32_t, nas*>(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_ctx));
+  // The UE is now connected through the association of this worker
+  set_ue_worker(nas_ctx);
   m_logger.debug("Saved UE context corresponding to MME UE S1AP Id %d", nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   return true;
 }
 
 bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 {
+  std::lock_guard<std::mutex>                      lock(m_enb_mutex);
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
@@ -416,43 +648,42 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
   return true;
 }
 
-nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
+std::shared_ptr<nas> s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
-    return NULL;
-  } else {
-    return it->second;
-  }
+  std::shared_ptr<nas> nas_ctx;
+  m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id, nas_ctx);
+  return nas_ctx;
 }
 
-nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
+std::shared_ptr<nas> s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
-  if (it == m_imsi_to_nas_ctx.end()) {
-    return NULL;
-  } else {
-    return it->second;
-  }
+  std::shared_ptr<nas> nas_ctx;
+  m_imsi_to_nas_ctx.find(imsi, nas_ctx);
+  return nas_ctx;
 }
 
 void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 {
   srsran::console("Releasing UEs context\n");
+  std::lock_guard<std::mutex>                      lock(m_enb_mutex);
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   std::set<uint32_t>::iterator                     ue_id      = ues_in_enb->second.begin();
   if (ue_id == ues_in_enb->second.end()) {
     srsran::console("No UEs to be released\n");
   } else {
     while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
+      std::shared_ptr<nas> nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(*ue_id);
+      if (nas_ctx == NULL) {
+        ues_in_enb->second.erase(ue_id++);
+        continue;
+      }
+      emm_ctx_t* emm_ctx = &nas_ctx->m_emm_ctx;
+      ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
       m_logger.info(
           "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
       if (emm_ctx->state == EMM_STATE_REGISTERED) {
-        m_mme_gtpc->send_delete_session_request(emm_ctx->imsi);
+        m_gtpc->send_delete_session_request(emm_ctx->imsi);
         emm_ctx->state = EMM_STATE_DEREGISTERED;
       }
       srsran::console("Releasing UE ECM context. UE-MME S1AP Id: %d\n", ecm_ctx->mme_ue_s1ap_id);
@@ -466,7 +697,7 @@ void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 
 bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
 {
-  nas* nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  std::shared_ptr<nas> nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
   if (nas_ctx == NULL) {
     m_logger.error("Cannot release UE ECM context, UE not found. MME-UE S1AP Id: %d", mme_ue_s1ap_id);
     return false;
@@ -474,18 +705,21 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
   ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
   // Delete UE within eNB UE set
-  std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (it == m_sctp_to_enb_id.end()) {
-    m_logger.error("Could not find eNB for UE release request.");
-    return false;
-  }
-  uint16_t                                         enb_id = it->second;
-  std::map<int32_t, std::set<uint32_t> >::iterator ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (ue_set == m_enb_assoc_to_ue_ids.end()) {
-    m_logger.error("Could not find the eNB's UEs.");
-    return false;
+  {
+    std::lock_guard<std::mutex>           lock(m_enb_mutex);
+    std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (it == m_sctp_to_enb_id.end()) {
+      m_logger.error("Could not find eNB for UE release request.");
+      return false;
+    }
+    std::map<int32_t, std::set<uint32_t> >::iterator ue_set =
+        m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (ue_set == m_enb_assoc_to_ue_ids.end()) {
+      m_logger.error("Could not find the eNB's UEs.");
+      return false;
+    }
+    ue_set->second.erase(mme_ue_s1ap_id);
   }
-  ue_set->second.erase(mme_ue_s1ap_id);
 
   // Release UE ECM context
   m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
@@ -499,7 +733,7 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
 
 bool s1ap::delete_ue_ctx(uint64_t imsi)
 {
-  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+  std::shared_ptr<nas> nas_ctx = find_nas_ctx_from_imsi(imsi);
   if (nas_ctx == NULL) {
     m_logger.info("Cannot delete UE context, UE not found. IMSI: %" PRIu64 "", imsi);
     return false;
@@ -510,9 +744,9 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
     release_ue_ecm_ctx(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   }
 
-  // Delete UE context
+  // Delete UE context, it is freed once the events of other workers holding it are done
   m_imsi_to_nas_ctx.erase(imsi);
-  delete nas_ctx;
+  m_imsi_to_worker.erase(imsi);
   m_logger.info("Deleted UE Context.");
   return true;
 }
@@ -520,21 +754,20 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
+  std::shared_ptr<nas> nas_ctx = find_nas_ctx_from_imsi(imsi);
+  if (nas_ctx == NULL) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  uint32_t mme_ue_s1ap_id = nas_ctx->m_ecm_ctx.mme_ue_s1ap_id;
+  if (not m_mme_ue_s1ap_id_to_nas_ctx.contains(mme_ue_s1ap_id)) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
   }
 
-  ecm_ctx_t* ecm_ctx = &ue_ctx_it->second->m_ecm_ctx;
-  esm_ctx_t* esm_ctx = &ue_ctx_it->second->m_esm_ctx[ebi];
+  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
+  esm_ctx_t* esm_ctx = &nas_ctx->m_esm_ctx[ebi];
   if (esm_ctx->state != ERAB_CTX_SETUP) {
     m_logger.error(
         "Could not be activate EPS Bearer, bearer in wrong state: MME S1AP Id %d, EPS Bearer id %d, state %d",
@@ -557,20 +790,24 @@ void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 
 uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 {
-  uint32_t m_tmsi = m_next_m_tmsi;
-  m_next_m_tmsi   = (m_next_m_tmsi + 1) % UINT32_MAX;
+  // The M-TMSIs wrap before 0xFFFFFFFF, the initial value included
+  uint32_t next   = m_next_m_tmsi.load(std::memory_order_relaxed);
+  uint32_t m_tmsi = 0;
+  do {
+    m_tmsi = next % UINT32_MAX;
+  } while (not m_next_m_tmsi.compare_exchange_weak(next, (m_tmsi + 1) % UINT32_MAX, std::memory_order_relaxed));
 
-  m_tmsi_to_imsi.insert(std::pair<uint32_t, uint64_t>(m_tmsi, imsi));
+  m_tmsi_to_imsi.insert(m_tmsi, imsi);
   m_logger.debug("Allocated M-TMSI 0x%x to IMSI %015" PRIu64 ",", m_tmsi, imsi);
   return m_tmsi;
 }
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
-  if (it != m_tmsi_to_imsi.end()) {
-    m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
-    return it->second;
+  uint64_t imsi = 0;
+  if (m_tmsi_to_imsi.find(m_tmsi, imsi)) {
+    m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", imsi, m_tmsi);
+    return imsi;
   } else {
     m_logger.debug("Could not find IMSI from M-TMSI 0x%x", m_tmsi);
     return SRSRAN_SUCCESS;
@@ -616,24 +853,24 @@ bool s1ap::send_paging(uint64_t imsi, uint16_t erab_to_setup)
 // GTP-C || NAS -> S1AP interface
 bool s1ap::send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup)
 {
-  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+  std::shared_ptr<nas> nas_ctx = find_nas_ctx_from_imsi(imsi);
   if (nas_ctx == NULL) {
     m_logger.error("Error finding NAS context when sending initial context Setup Request");
     return false;
   }
-  m_s1ap_ctx_mngmt_proc->send_initial_context_setup_request(nas_ctx, erab_to_setup);
+  m_s1ap_ctx_mngmt_proc->send_initial_context_setup_request(nas_ctx.get(), erab_to_setup);
   return true;
 }
 
 // NAS -> S1AP interface
 bool s1ap::send_ue_context_release_command(uint32_t mme_ue_s1ap_id)
 {
-  nas* nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  std::shared_ptr<nas> nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
   if (nas_ctx == NULL) {
     m_logger.error("Error finding NAS context when sending UE Context Setup Release");
     return false;
   }
-  m_s1ap_ctx_mngmt_proc->send_ue_context_release_command(nas_ctx);
+  m_s1ap_ctx_mngmt_proc->send_ue_context_release_command(nas_ctx.get());
   return true;
 }
 
@@ -666,7 +903,7 @@ bool s1ap::send_downlink_nas_transport(uint32_t               enb_ue_s1ap_id,
 
 bool s1ap::expire_nas_timer(enum nas_timer_type type, uint64_t imsi)
 {
-  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+  std::shared_ptr<nas> nas_ctx = find_nas_ctx_from_imsi(imsi);
   if (nas_ctx == NULL) {
     m_logger.error("Error finding NAS context to handle timer");
     return false;
@@ -20,6 +20,7 @@
  */
 
 #include "srsepc/hdr/mme/s1ap_ctx_mngmt_proc.h"
+#include "srsepc/hdr/mme/mme.h"
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsran/common/bcd_helpers.h"
 #include "srsran/common/buffer_pool.h"
@@ -64,7 +65,7 @@ void s1ap_ctx_mngmt_proc::cleanup()
 void s1ap_ctx_mngmt_proc::init()
 {
   m_s1ap      = s1ap::get_instance();
-  m_mme_gtpc  = mme_gtpc::get_instance();
+  m_gtpc      = mme::get_instance()->get_gtpc_if();
   m_s1ap_args = m_s1ap->m_s1ap_args;
 }
 
@@ -180,8 +181,8 @@ bool s1ap_ctx_mngmt_proc::send_initial_context_setup_request(nas* nas_ctx, uint1
 bool s1ap_ctx_mngmt_proc::handle_initial_context_setup_response(
     const asn1::s1ap::init_context_setup_resp_s& in_ctxt_resp)
 {
-  uint32_t mme_ue_s1ap_id = in_ctxt_resp->mme_ue_s1ap_id.value.value;
-  nas*     nas_ctx        = m_s1ap->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  uint32_t             mme_ue_s1ap_id = in_ctxt_resp->mme_ue_s1ap_id.value.value;
+  std::shared_ptr<nas> nas_ctx        = m_s1ap->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
   if (nas_ctx == nullptr) {
     m_logger.error("Could not find UE's context in active UE's map");
     return false;
@@ -230,7 +231,7 @@ bool s1ap_ctx_mngmt_proc::handle_initial_context_setup_response(
   if (emm_ctx->state == EMM_STATE_REGISTERED) {
     srsran::console("Initial Context Setup Response triggered from Service Request.\n");
     srsran::console("Sending Modify Bearer Request.\n");
-    m_mme_gtpc->send_modify_bearer_request(emm_ctx->imsi, 5, &nas_ctx->m_esm_ctx[5].enb_fteid);
+    m_gtpc->send_modify_bearer_request(emm_ctx->imsi, 5, &nas_ctx->m_esm_ctx[5].enb_fteid);
   }
   return true;
 }
@@ -242,7 +243,7 @@ bool s1ap_ctx_mngmt_proc::handle_ue_context_release_request(const asn1::s1ap::ue
   m_logger.info("Received UE Context Release Request. MME-UE S1AP Id: %d", mme_ue_s1ap_id);
   srsran::console("Received UE Context Release Request. MME-UE S1AP Id %d\n", mme_ue_s1ap_id);
 
-  nas* nas_ctx = m_s1ap->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  std::shared_ptr<nas> nas_ctx = m_s1ap->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
   if (nas_ctx == nullptr) {
     m_logger.info("No UE context to release found. MME-UE S1AP Id: %d", mme_ue_s1ap_id);
     srsran::console("No UE context to release found. MME-UE S1AP Id: %d\n", mme_ue_s1ap_id);
@@ -254,7 +255,7 @@ bool s1ap_ctx_mngmt_proc::handle_ue_context_release_request(const asn1::s1ap::ue
 
   // Send release context command to eNB, so that it can release it's bearers
   if (ecm_ctx->state == ECM_STATE_CONNECTED) {
-    send_ue_context_release_command(nas_ctx);
+    send_ue_context_release_command(nas_ctx.get());
   } else {
     // No ECM Context to release
     m_logger.info("UE is not ECM connected. No need to release S1-U. MME UE S1AP Id %d", mme_ue_s1ap_id);
@@ -297,7 +298,7 @@ bool s1ap_ctx_mngmt_proc::send_ue_context_release_command(nas* nas_ctx)
 
     // The handle_release_access_bearers_response function will make sure to mark E-RABS DEACTIVATED
     // It will release the UEs downstream S1-u and keep the upstream S1-U connection active.
-    m_mme_gtpc->send_release_access_bearers_request(emm_ctx->imsi);
+    m_gtpc->send_release_access_bearers_request(emm_ctx->imsi);
   }
 
   // Mark ECM state as IDLE and de-activate E-RABs
@@ -333,7 +334,7 @@ bool s1ap_ctx_mngmt_proc::handle_ue_context_release_complete(const asn1::s1ap::u
   m_logger.info("Received UE Context Release Complete. MME-UE S1AP Id: %d", mme_ue_s1ap_id);
   srsran::console("Received UE Context Release Complete. MME-UE S1AP Id %d\n", mme_ue_s1ap_id);
 
-  nas* nas_ctx = m_s1ap->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  std::shared_ptr<nas> nas_ctx = m_s1ap->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
   if (nas_ctx == nullptr) {
     m_logger.info("No UE context to release found. MME-UE S1AP Id: %d", mme_ue_s1ap_id);
     srsran::console("No UE context to release found. MME-UE S1AP Id: %d\n", mme_ue_s1ap_id);
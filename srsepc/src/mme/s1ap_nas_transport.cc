@@ -85,7 +85,7 @@ void s1ap_nas_transport::init()
 
   // Init NAS interface
   m_nas_if.s1ap = s1ap::get_instance();
-  m_nas_if.gtpc = mme_gtpc::get_instance();
+  m_nas_if.gtpc = mme::get_instance()->get_gtpc_if();
   m_nas_if.hss  = hss::get_instance();
   m_nas_if.mme  = mme::get_instance();
 }
@@ -151,7 +151,7 @@ bool s1ap_nas_transport::handle_uplink_nas_transport(const asn1::s1ap::ul_nas_tr
   bool     increase_ul_nas_cnt = true;
 
   // Get UE NAS context
-  nas* nas_ctx = m_s1ap->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  std::shared_ptr<nas> nas_ctx = m_s1ap->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
   if (nas_ctx == nullptr) {
     m_logger.warning("Received uplink NAS, but could not find UE NAS context. MME-UE S1AP id: %d", mme_ue_s1ap_id);
     return false;
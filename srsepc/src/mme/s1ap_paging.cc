@@ -50,7 +50,7 @@ bool s1ap_paging::send_paging(uint64_t imsi, uint16_t erab_to_setup)
   asn1::s1ap::paging_s& paging = tx_pdu.init_msg().value.paging();
 
   // Getting UE NAS Context
-  nas* nas_ctx = m_s1ap->find_nas_ctx_from_imsi(imsi);
+  std::shared_ptr<nas> nas_ctx = m_s1ap->find_nas_ctx_from_imsi(imsi);
   if (nas_ctx == nullptr) {
     m_logger.error("Could not find UE to page NAS context");
     return false;
@@ -85,13 +85,9 @@ bool s1ap_paging::send_paging(uint64_t imsi, uint16_t erab_to_setup)
     return false;
   }
 
-  for (std::map<uint16_t, enb_ctx_t*>::iterator it = m_s1ap->m_active_enbs.begin(); it != m_s1ap->m_active_enbs.end();
-       it++) {
-    enb_ctx_t* enb_ctx = it->second;
-    if (!m_s1ap->s1ap_tx_pdu(tx_pdu, &enb_ctx->sri)) {
-      m_logger.error("Error paging to eNB. eNB Id: 0x%x.", enb_ctx->enb_id);
-      return false;
-    }
+  if (!m_s1ap->send_to_all_enbs(tx_pdu)) {
+    m_logger.error("Error paging to eNBs.");
+    return false;
   }
 
   return true;
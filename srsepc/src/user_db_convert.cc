@@ -0,0 +1,72 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        user_db_convert.cc
+ * Description: Converts a user database .csv file into the memory-mapped
+ *              subscriber database that the HSS can load instead.
+ *****************************************************************************/
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/srslog/srslog.h"
+#include <iostream>
+#include <sys/time.h>
+
+using namespace srsepc;
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3) {
+    std::cout << "Usage: " << argv[0] << " <user_db.csv> <subscriber database>" << std::endl;
+    std::cout << "  Set the hss.db_file option to the subscriber database to use it instead of the .csv file."
+              << std::endl;
+    std::cout << "  SQN updates are stored next to it, in a file with the same name and a .sqn extension."
+              << std::endl;
+    return -1;
+  }
+
+  srslog::init();
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::warning);
+
+  struct timeval t[2] = {};
+  gettimeofday(&t[0], nullptr);
+  bool ok = hss::convert_db_file(argv[1], argv[2]);
+  gettimeofday(&t[1], nullptr);
+
+  if (not ok) {
+    std::cout << "Error converting " << argv[1] << std::endl;
+    srslog::flush();
+    return -1;
+  }
+
+  hss_db db;
+  if (not db.open(argv[2])) {
+    std::cout << "Error opening " << argv[2] << std::endl;
+    srslog::flush();
+    return -1;
+  }
+  std::cout << "Converted " << db.size() << " subscribers into " << argv[2] << " in "
+            << (t[1].tv_sec - t[0].tv_sec) * 1000 + (t[1].tv_usec - t[0].tv_usec) / 1000 << " ms" << std::endl;
+  db.close();
+
+  srslog::flush();
+  return 0;
+}
@@ -0,0 +1,270 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <fstream>
+#include <getopt.h>
+#include <inttypes.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using namespace srsepc;
+
+static uint32_t nof_subscribers = 1000;
+static uint32_t nof_rounds      = 3;
+
+static const char* csv_file = "hss_auth_cache_test.csv";
+
+static const uint16_t mcc = 0xf001;
+static const uint16_t mnc = 0xff01;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nr]\n", prog);
+  printf("\t-n Number of subscribers of the attach storm [Default %d]\n", nof_subscribers);
+  printf("\t-r Number of attaches of every subscriber [Default %d]\n", nof_rounds);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "nr")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_subscribers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_rounds = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_ms(const struct timeval& begin)
+{
+  struct timeval end = {};
+  gettimeofday(&end, nullptr);
+  return (end.tv_sec - begin.tv_sec) * 1e3 + (end.tv_usec - begin.tv_usec) / 1e3;
+}
+
+static uint64_t test_imsi(uint32_t i)
+{
+  return 1010123456000000ULL / 10 + i;
+}
+
+/// Subscriber parameters as written in the .csv file, the SQN is the one expected in the next vector
+struct test_subscriber_t {
+  uint8_t key[16];
+  uint8_t opc[16];
+  uint8_t amf[2];
+  uint8_t sqn[6];
+};
+
+static std::vector<test_subscriber_t> write_csv(uint32_t nof_users)
+{
+  std::vector<test_subscriber_t> subs(nof_users);
+  std::ofstream                  csv(csv_file);
+  csv << "# Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\n";
+  for (uint32_t i = 0; i < nof_users; i++) {
+    char line[256];
+    snprintf(line,
+             sizeof(line),
+             "ue%u,mil,%015" PRIu64 ",%032x,opc,%032x,8000,%012x,9,dynamic\n",
+             i,
+             test_imsi(i),
+             i * 7 + 1,
+             i * 3 + 2,
+             i * 32);
+    csv << line;
+
+    test_subscriber_t& sub = subs[i];
+    memset(&sub, 0, sizeof(sub));
+    for (int j = 0; j < 4; j++) {
+      sub.key[12 + j] = ((i * 7 + 1) >> (24 - 8 * j)) & 0xff;
+      sub.opc[12 + j] = ((i * 3 + 2) >> (24 - 8 * j)) & 0xff;
+      sub.sqn[2 + j]  = ((i * 32) >> (24 - 8 * j)) & 0xff;
+    }
+    sub.amf[0] = 0x80;
+  }
+  return subs;
+}
+
+static hss* init_hss(uint32_t auth_cache_size)
+{
+  hss_args_t args         = {};
+  args.db_file            = csv_file;
+  args.mcc                = mcc;
+  args.mnc                = mnc;
+  args.auth_cache_size    = auth_cache_size;
+  args.auth_cache_vectors = 8;
+
+  hss* h = hss::get_instance();
+  TESTASSERT(h->init(&args) == 0);
+  return h;
+}
+
+/// Checks an authentication vector against the Milenage functions computed on request
+static void check_vector(test_subscriber_t& sub, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
+{
+  uint8_t res[8];
+  uint8_t ck[16];
+  uint8_t ik[16];
+  uint8_t ak[6];
+  uint8_t mac[8];
+  uint8_t k_asme_ref[32];
+
+  TESTASSERT(srsran::security_milenage_f2345(sub.key, sub.opc, rand, res, ck, ik, ak) == SRSRAN_SUCCESS);
+  TESTASSERT(memcmp(res, xres, sizeof(res)) == 0);
+  for (int i = 0; i < 6; i++) {
+    TESTASSERT((autn[i] ^ ak[i]) == sub.sqn[i]);
+  }
+  TESTASSERT(memcmp(&autn[6], sub.amf, sizeof(sub.amf)) == 0);
+  TESTASSERT(srsran::security_milenage_f1(sub.key, sub.opc, rand, sub.sqn, sub.amf, mac) == SRSRAN_SUCCESS);
+  TESTASSERT(memcmp(&autn[8], mac, sizeof(mac)) == 0);
+  TESTASSERT(srsran::security_generate_k_asme(ck, ik, autn, mcc, mnc, k_asme_ref) == SRSRAN_SUCCESS);
+  TESTASSERT(memcmp(k_asme, k_asme_ref, sizeof(k_asme_ref)) == 0);
+
+  hss::increment_sqn(sub.sqn, sub.sqn);
+}
+
+static void test_sqn_consistency()
+{
+  std::vector<test_subscriber_t> subs = write_csv(20);
+
+  hss* h = init_hss(16);
+
+  uint8_t k_asme[32];
+  uint8_t autn[16];
+  uint8_t rand[16];
+  uint8_t xres[16];
+
+  // Fewer subscribers than cached ones, once the cache is filled every vector comes from it
+  h->wait_auth_cache_idle();
+  for (uint32_t round = 0; round < 20; round++) {
+    for (uint32_t i = 0; i < 12; i++) {
+      TESTASSERT(h->gen_auth_info_answer(test_imsi(i), k_asme, autn, rand, xres));
+      check_vector(subs[i], k_asme, autn, rand, xres);
+    }
+    h->wait_auth_cache_idle();
+  }
+  TESTASSERT(h->get_auth_cache_hits() == 20 * 12);
+  TESTASSERT(h->get_auth_cache_misses() == 0);
+
+  // More subscribers than cached ones, the evicted subscribers get vectors computed on request
+  for (uint32_t round = 0; round < 20; round++) {
+    for (uint32_t i = 0; i < subs.size(); i++) {
+      TESTASSERT(h->gen_auth_info_answer(test_imsi(i), k_asme, autn, rand, xres));
+      check_vector(subs[i], k_asme, autn, rand, xres);
+    }
+  }
+  TESTASSERT(h->get_auth_cache_misses() > 0);
+
+  // After a resynchronization, the vectors follow the SQN of the UE
+  uint8_t sqn_ms[6] = {0x00, 0x00, 0x12, 0x34, 0x56, 0x40};
+  uint8_t ak[6];
+  uint8_t auts[14] = {};
+  TESTASSERT(h->gen_auth_info_answer(test_imsi(3), k_asme, autn, rand, xres));
+  check_vector(subs[3], k_asme, autn, rand, xres);
+  TESTASSERT(srsran::security_milenage_f5_star(subs[3].key, subs[3].opc, rand, ak) == SRSRAN_SUCCESS);
+  for (int i = 0; i < 6; i++) {
+    auts[i] = sqn_ms[i] ^ ak[i];
+  }
+  TESTASSERT(h->resync_sqn(test_imsi(3), auts));
+
+  // The HSS only increments the SEQ part of the UE SQN
+  uint64_t seq_ms = 0;
+  for (int i = 0; i < 6; i++) {
+    seq_ms = (seq_ms << 8) | sqn_ms[i];
+  }
+  uint64_t ind_ms = seq_ms & LTE_FDD_ENB_IND_HE_MASK;
+  seq_ms          = (((seq_ms >> LTE_FDD_ENB_IND_HE_N_BITS) + 1) << LTE_FDD_ENB_IND_HE_N_BITS) | ind_ms;
+  for (int i = 0; i < 6; i++) {
+    subs[3].sqn[i] = (seq_ms >> (5 - i) * 8) & 0xff;
+  }
+  for (uint32_t round = 0; round < 12; round++) {
+    TESTASSERT(h->gen_auth_info_answer(test_imsi(3), k_asme, autn, rand, xres));
+    check_vector(subs[3], k_asme, autn, rand, xres);
+  }
+
+  h->stop();
+  hss::cleanup();
+}
+
+/// Authenticates every subscriber once per round, as the attach requests after an eNB restart
+static void attach_storm(uint32_t auth_cache_size)
+{
+  write_csv(nof_subscribers);
+  hss* h = init_hss(auth_cache_size);
+
+  uint8_t k_asme[32];
+  uint8_t autn[16];
+  uint8_t rand[16];
+  uint8_t xres[16];
+
+  double total_ms = 0;
+  for (uint32_t round = 0; round < nof_rounds; round++) {
+    // The attaches between two storms give the cache time to refill
+    h->wait_auth_cache_idle();
+
+    struct timeval t = {};
+    gettimeofday(&t, nullptr);
+    for (uint32_t i = 0; i < nof_subscribers; i++) {
+      TESTASSERT(h->gen_auth_info_answer(test_imsi(i), k_asme, autn, rand, xres));
+    }
+    total_ms += elapsed_ms(t);
+  }
+
+  printf("Attach storm of %d subscribers, cache of %d: %.0f attaches/s, %" PRIu64 " vectors from the cache, %" PRIu64
+         " on request\n",
+         nof_subscribers,
+         auth_cache_size,
+         nof_subscribers * nof_rounds / (total_ms / 1e3),
+         h->get_auth_cache_hits(),
+         h->get_auth_cache_misses());
+
+  h->stop();
+  hss::cleanup();
+}
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::warning);
+
+  parse_args(argc, argv);
+
+  test_sqn_consistency();
+
+  attach_storm(0);
+  attach_storm(nof_subscribers);
+
+  unlink(csv_file);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
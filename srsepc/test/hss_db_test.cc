@@ -0,0 +1,309 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+#include <fstream>
+#include <getopt.h>
+#include <inttypes.h>
+#include <random>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace srsepc;
+
+static uint32_t nof_subscribers = 10000;
+
+static const char* csv_file = "hss_db_test.csv";
+static const char* db_file  = "hss_db_test.db";
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n Number of subscribers of the startup and lookup benchmark [Default %d]\n", nof_subscribers);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_subscribers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_ms(const struct timeval& begin)
+{
+  struct timeval end = {};
+  gettimeofday(&end, nullptr);
+  return (end.tv_sec - begin.tv_sec) * 1e3 + (end.tv_usec - begin.tv_usec) / 1e3;
+}
+
+static uint64_t test_imsi(uint32_t i)
+{
+  return 1010123456000000ULL / 10 + i;
+}
+
+static void write_csv(uint32_t nof_users)
+{
+  std::ofstream csv(csv_file);
+  csv << "# Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\n";
+  csv << "ue_static,mil,001010123456780,00112233445566778899aabbccddeeff,op,63bfa50ee6523365ff14c1f45f88737d,"
+         "8000,000000001234,7,172.16.0.2\n";
+  for (uint32_t i = 0; i < nof_users; i++) {
+    char line[256];
+    snprintf(line,
+             sizeof(line),
+             "ue%u,%s,%015" PRIu64 ",%032x,opc,%032x,9001,%012x,9,dynamic\n",
+             i,
+             (i % 2) ? "xor" : "mil",
+             test_imsi(i),
+             i,
+             i * 3,
+             i * 32);
+    csv << line;
+  }
+}
+
+static void test_convert()
+{
+  write_csv(100);
+  TESTASSERT(not hss_db::is_db_file(csv_file));
+  TESTASSERT(hss::convert_db_file(csv_file, db_file));
+  TESTASSERT(hss_db::is_db_file(db_file));
+
+  hss_db db;
+  TESTASSERT(db.open(db_file));
+  TESTASSERT(db.size() == 101);
+
+  // Subscriber with the OP and a static IP
+  const hss_db_record_t* record = db.find(1010123456780ULL);
+  TESTASSERT(record != nullptr);
+  TESTASSERT(std::string(record->name) == "ue_static");
+  TESTASSERT(record->algo == HSS_ALGO_MILENAGE);
+  TESTASSERT(record->op_configured == 1);
+  TESTASSERT(record->key[0] == 0x00 && record->key[15] == 0xff);
+  TESTASSERT(record->op[0] == 0x63 && record->op[15] == 0x7d);
+  TESTASSERT(record->amf[0] == 0x80 && record->amf[1] == 0x00);
+  TESTASSERT(record->sqn[4] == 0x12 && record->sqn[5] == 0x34);
+  TESTASSERT(record->qci == 7);
+  TESTASSERT(record->static_ip_addr == inet_addr("172.16.0.2"));
+
+  // Subscribers with the OPc and a dynamic IP
+  for (uint32_t i = 0; i < 100; i++) {
+    record = db.find(test_imsi(i));
+    TESTASSERT(record != nullptr);
+    TESTASSERT(record->imsi == test_imsi(i));
+    TESTASSERT(record->algo == ((i % 2) ? HSS_ALGO_XOR : HSS_ALGO_MILENAGE));
+    TESTASSERT(record->op_configured == 0);
+    TESTASSERT(record->key[15] == (i & 0xff));
+    TESTASSERT(record->opc[15] == ((i * 3) & 0xff));
+    TESTASSERT(record->qci == 9);
+    TESTASSERT(record->static_ip_addr == 0);
+  }
+  TESTASSERT(db.find(test_imsi(100)) == nullptr);
+  TESTASSERT(db.find(0) == nullptr);
+}
+
+static void test_sqn_log()
+{
+  const uint8_t sqn_a[6] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+  const uint8_t sqn_b[6] = {0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+
+  // Update and crash before the log is compacted
+  pid_t pid = fork();
+  TESTASSERT(pid >= 0);
+  if (pid == 0) {
+    hss_db db;
+    if (not db.open(db_file) || not db.update_sqn(test_imsi(3), sqn_a) || not db.update_sqn(test_imsi(3), sqn_b) ||
+        not db.update_sqn(test_imsi(7), sqn_a) || db.update_sqn(test_imsi(100), sqn_a)) {
+      _exit(1);
+    }
+    _exit(0);
+  }
+  int status = 0;
+  TESTASSERT(waitpid(pid, &status, 0) == pid);
+  TESTASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  // An entry torn by the crash is ignored
+  {
+    std::ofstream log(std::string(db_file) + ".sqn", std::ios::app | std::ios::binary);
+    log.write("torn", 4);
+  }
+
+  hss_db db;
+  TESTASSERT(db.open(db_file));
+  TESTASSERT(memcmp(db.find(test_imsi(3))->sqn, sqn_b, 6) == 0);
+  TESTASSERT(memcmp(db.find(test_imsi(7))->sqn, sqn_a, 6) == 0);
+
+  // The replayed updates are compacted into the database
+  std::ifstream log(std::string(db_file) + ".sqn", std::ios::ate | std::ios::binary);
+  TESTASSERT(log.tellg() == 0);
+  db.close();
+
+  TESTASSERT(db.open(db_file));
+  TESTASSERT(memcmp(db.find(test_imsi(3))->sqn, sqn_b, 6) == 0);
+  TESTASSERT(memcmp(db.find(test_imsi(7))->sqn, sqn_a, 6) == 0);
+  TESTASSERT(memcmp(db.find(test_imsi(8))->sqn, sqn_a, 6) != 0);
+}
+
+static off_t log_size()
+{
+  std::ifstream log(std::string(db_file) + ".sqn", std::ios::ate | std::ios::binary);
+  return log.tellg();
+}
+
+/// Updates the SQNs and exits without closing the database, as a crash does
+static void update_and_crash(const std::vector<std::pair<uint64_t, const uint8_t*> >& updates)
+{
+  pid_t pid = fork();
+  TESTASSERT(pid >= 0);
+  if (pid == 0) {
+    hss_db db;
+    if (not db.open(db_file)) {
+      _exit(1);
+    }
+    for (const auto& update : updates) {
+      if (not db.update_sqn(update.first, update.second)) {
+        _exit(1);
+      }
+    }
+    _exit(0);
+  }
+  int status = 0;
+  TESTASSERT(waitpid(pid, &status, 0) == pid);
+  TESTASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+static void test_torn_log()
+{
+  const uint8_t sqn_a[6] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16};
+  const uint8_t sqn_b[6] = {0x21, 0x22, 0x23, 0x24, 0x25, 0x26};
+  const uint8_t sqn_c[6] = {0x31, 0x32, 0x33, 0x34, 0x35, 0x36};
+  std::string   log_file = std::string(db_file) + ".sqn";
+
+  // Cut the log in the middle of the second entry, the first one is still replayed
+  update_and_crash({{test_imsi(20), sqn_a}, {test_imsi(21), sqn_b}});
+  off_t entry_len = log_size() / 2;
+  TESTASSERT(entry_len > 0);
+  TESTASSERT(truncate(log_file.c_str(), entry_len + entry_len / 2) == 0);
+  {
+    hss_db db;
+    TESTASSERT(db.open(db_file));
+    TESTASSERT(memcmp(db.find(test_imsi(20))->sqn, sqn_a, 6) == 0);
+    TESTASSERT(memcmp(db.find(test_imsi(21))->sqn, sqn_b, 6) != 0);
+    TESTASSERT(log_size() == 0);
+  }
+
+  // Cut the log in the middle of its only entry, no record is updated by the replay
+  update_and_crash({{test_imsi(22), sqn_a}});
+  TESTASSERT(truncate(log_file.c_str(), entry_len / 2) == 0);
+
+  // The torn bytes are removed when opening, so that the next updates are not appended after them
+  update_and_crash({{test_imsi(23), sqn_c}});
+  TESTASSERT(log_size() == entry_len);
+
+  hss_db db;
+  TESTASSERT(db.open(db_file));
+  TESTASSERT(memcmp(db.find(test_imsi(22))->sqn, sqn_a, 6) != 0);
+  TESTASSERT(memcmp(db.find(test_imsi(23))->sqn, sqn_c, 6) == 0);
+  TESTASSERT(log_size() == 0);
+}
+
+static void test_duplicate_imsi()
+{
+  std::vector<hss_db_record_t> records(2, hss_db_record_t{});
+  records[0].imsi = records[1].imsi = test_imsi(0);
+  TESTASSERT(not hss_db::create("hss_db_test_duplicate.db", records));
+}
+
+static void bench_startup_and_lookup()
+{
+  struct timeval t = {};
+
+  write_csv(nof_subscribers);
+
+  // Parsing the .csv file is what the HSS did at every startup
+  gettimeofday(&t, nullptr);
+  TESTASSERT(hss::convert_db_file(csv_file, db_file));
+  printf("Parse and convert %d subscribers: %.1f ms\n", nof_subscribers + 1, elapsed_ms(t));
+
+  hss_db db;
+  gettimeofday(&t, nullptr);
+  TESTASSERT(db.open(db_file, false));
+  printf("Open subscriber database: %.3f ms\n", elapsed_ms(t));
+
+  std::mt19937                            rng(1234);
+  std::uniform_int_distribution<uint32_t> dist(0, nof_subscribers - 1);
+  std::vector<uint64_t>                   imsis(1000000);
+  for (uint64_t& imsi : imsis) {
+    imsi = test_imsi(dist(rng));
+  }
+
+  uint32_t nof_found = 0;
+  gettimeofday(&t, nullptr);
+  for (uint64_t imsi : imsis) {
+    nof_found += db.find(imsi) != nullptr ? 1 : 0;
+  }
+  double lookup_ms = elapsed_ms(t);
+  TESTASSERT(nof_found == imsis.size());
+  printf("Random lookups: %.1f ns per lookup\n", lookup_ms * 1e6 / imsis.size());
+
+  const uint32_t nof_updates = 10000;
+  uint8_t        sqn[6]      = {};
+  gettimeofday(&t, nullptr);
+  for (uint32_t i = 0; i < nof_updates; i++) {
+    sqn[5] = i & 0xff;
+    TESTASSERT(db.update_sqn(imsis[i], sqn));
+  }
+  printf("SQN updates without sync: %.2f us per update\n", elapsed_ms(t) * 1e3 / nof_updates);
+}
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::warning);
+
+  parse_args(argc, argv);
+
+  test_convert();
+  test_sqn_log();
+  test_torn_log();
+  test_duplicate_imsi();
+  bench_startup_and_lookup();
+
+  unlink(csv_file);
+  unlink(db_file);
+  unlink((std::string(db_file) + ".sqn").c_str());
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,359 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Attach load generator for the MME. Every emulated eNB connects over SCTP, completes the S1 Setup and sends the
+ * Initial UE Messages of its UEs, each one with an IMSI attach request. An attach is counted once the MME answers with
+ * the Downlink NAS Transport of the authentication request, which covers the S1AP, NAS and HSS work of the attach.
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsepc/hdr/mme/mme.h"
+#include "srsran/asn1/liblte_mme.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/bcd_helpers.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <fcntl.h>
+#include <fstream>
+#include <getopt.h>
+#include <inttypes.h>
+#include <netinet/sctp.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace srsepc;
+using namespace asn1::s1ap;
+
+static uint32_t nof_workers = 2;
+static uint32_t nof_enbs    = 4;
+static uint32_t nof_ues     = 250;
+
+static const char* csv_file = "mme_s1ap_load_test.csv";
+
+static const uint16_t mcc = 0xf001;
+static const uint16_t mnc = 0xff01;
+static const uint16_t tac = 7;
+
+static std::atomic<uint32_t> nof_attaches{0};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [weu]\n", prog);
+  printf("\t-w Number of S1AP worker threads, 0 for the MME thread [Default %d]\n", nof_workers);
+  printf("\t-e Number of eNBs [Default %d]\n", nof_enbs);
+  printf("\t-u Number of UEs attaching through each eNB [Default %d]\n", nof_ues);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "weu")) != -1) {
+    switch (opt) {
+      case 'w':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        nof_enbs = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_ms(const struct timeval& begin)
+{
+  struct timeval end = {};
+  gettimeofday(&end, nullptr);
+  return (end.tv_sec - begin.tv_sec) * 1e3 + (end.tv_usec - begin.tv_usec) / 1e3;
+}
+
+static uint64_t test_imsi(uint32_t enb, uint32_t ue)
+{
+  return 1010000000000ULL + enb * nof_ues + ue;
+}
+
+static void write_csv()
+{
+  std::ofstream csv(csv_file);
+  csv << "# Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\n";
+  for (uint32_t enb = 0; enb < nof_enbs; enb++) {
+    for (uint32_t ue = 0; ue < nof_ues; ue++) {
+      char line[256];
+      snprintf(line,
+               sizeof(line),
+               "ue%u,mil,%015" PRIu64 ",%032x,opc,%032x,8000,%012x,9,dynamic\n",
+               enb * nof_ues + ue,
+               test_imsi(enb, ue),
+               ue * 7 + 1,
+               ue * 3 + 2,
+               ue * 32);
+      csv << line;
+    }
+  }
+}
+
+static bool send_s1ap_pdu(int fd, const s1ap_pdu_c& pdu, uint16_t stream_id)
+{
+  uint8_t       buf[1024];
+  asn1::bit_ref bref(buf, sizeof(buf));
+  if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  return sctp_sendmsg(fd,
+                      buf,
+                      bref.distance_bytes(),
+                      NULL,
+                      0,
+                      htonl((uint32_t)srsran::net_utils::ppid_values::S1AP),
+                      0,
+                      stream_id,
+                      0,
+                      0) > 0;
+}
+
+static bool recv_s1ap_pdu(int fd, s1ap_pdu_c& pdu)
+{
+  uint8_t                buf[2048];
+  struct sctp_sndrcvinfo sri   = {};
+  int                    flags = 0;
+  int                    n     = sctp_recvmsg(fd, buf, sizeof(buf), NULL, NULL, &sri, &flags);
+  if (n <= 0) {
+    return false;
+  }
+  asn1::cbit_ref bref(buf, n);
+  return pdu.unpack(bref) == asn1::SRSASN_SUCCESS;
+}
+
+static bool send_s1_setup_request(int fd, uint32_t enb_id)
+{
+  uint32_t plmn = 0;
+  srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+  plmn           = htonl(plmn);
+  uint16_t tac_n = htons(tac);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_S1_SETUP);
+  s1_setup_request_s& container             = pdu.init_msg().value.s1_setup_request();
+  container->global_enb_id.value.plm_nid[0] = ((uint8_t*)&plmn)[1];
+  container->global_enb_id.value.plm_nid[1] = ((uint8_t*)&plmn)[2];
+  container->global_enb_id.value.plm_nid[2] = ((uint8_t*)&plmn)[3];
+  container->global_enb_id.value.enb_id.set_macro_enb_id().from_number(enb_id);
+
+  container->supported_tas.value.resize(1);
+  memcpy(container->supported_tas.value[0].tac.data(), (uint8_t*)&tac_n, 2);
+  container->supported_tas.value[0].broadcast_plmns.resize(1);
+  container->supported_tas.value[0].broadcast_plmns[0][0] = ((uint8_t*)&plmn)[1];
+  container->supported_tas.value[0].broadcast_plmns[0][1] = ((uint8_t*)&plmn)[2];
+  container->supported_tas.value[0].broadcast_plmns[0][2] = ((uint8_t*)&plmn)[3];
+
+  container->default_paging_drx.value.value = paging_drx_opts::v128;
+  return send_s1ap_pdu(fd, pdu, 0);
+}
+
+static bool send_initial_ue_message(int fd, uint32_t enb_id, uint32_t enb_ue_s1ap_id, uint64_t imsi)
+{
+  // IMSI attach request, with the PDN connectivity request of the default bearer
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  attach_req.eps_attach_type                      = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+  for (uint32_t i = 0; i < 8; i++) {
+    attach_req.ue_network_cap.eea[i] = true;
+    attach_req.ue_network_cap.eia[i] = true;
+  }
+  attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+  attach_req.nas_ksi.tsc_flag         = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+  attach_req.nas_ksi.nas_ksi          = LIBLTE_MME_NAS_KEY_SET_IDENTIFIER_NO_KEY_AVAILABLE;
+  for (int i = 14; i >= 0; i--) {
+    attach_req.eps_mobile_id.imsi[i] = imsi % 10;
+    imsi /= 10;
+  }
+
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+  pdn_con_req.eps_bearer_id                                  = 0x00;
+  pdn_con_req.proc_transaction_id                            = 0x01;
+  pdn_con_req.request_type                                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+  pdn_con_req.pdn_type                                       = LIBLTE_MME_PDN_TYPE_IPV4;
+  liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+
+  LIBLTE_BYTE_MSG_STRUCT nas_msg = {};
+  if (liblte_mme_pack_attach_request_msg(&attach_req, &nas_msg) != LIBLTE_SUCCESS) {
+    return false;
+  }
+
+  uint32_t plmn = 0;
+  srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+  init_ue_msg_s& container        = pdu.init_msg().value.init_ue_msg();
+  container->enb_ue_s1ap_id.value = enb_ue_s1ap_id;
+  container->nas_pdu.value.resize(nas_msg.N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas_msg.msg, nas_msg.N_bytes);
+  container->tai.value.plm_nid.from_number(plmn);
+  container->tai.value.tac.from_number(tac);
+  container->eutran_cgi.value.plm_nid.from_number(plmn);
+  container->eutran_cgi.value.cell_id.from_number(enb_id << 8U);
+  container->rrc_establishment_cause.value = rrc_establishment_cause_opts::mo_sig;
+
+  // The UE-associated signalling does not use the stream of the common procedures
+  return send_s1ap_pdu(fd, pdu, 1);
+}
+
+/// Emulates an eNB, returns once the MME answered the attach of every UE or stopped answering
+static void run_enb(uint32_t enb_idx)
+{
+  uint32_t enb_id = 0x19B + enb_idx;
+
+  int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_SCTP);
+  TESTASSERT(fd >= 0);
+  struct timeval timeout = {5, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  struct sockaddr_in mme_addr = {};
+  TESTASSERT(srsran::net_utils::set_sockaddr(&mme_addr, "127.0.0.1", S1MME_PORT));
+  TESTASSERT(connect(fd, (struct sockaddr*)&mme_addr, sizeof(mme_addr)) == 0);
+
+  s1ap_pdu_c pdu;
+  TESTASSERT(send_s1_setup_request(fd, enb_id));
+  TESTASSERT(recv_s1ap_pdu(fd, pdu));
+  TESTASSERT(pdu.type().value == s1ap_pdu_c::types_opts::successful_outcome);
+  TESTASSERT(pdu.successful_outcome().value.type().value ==
+             s1ap_elem_procs_o::successful_outcome_c::types_opts::s1_setup_resp);
+
+  for (uint32_t ue = 0; ue < nof_ues; ue++) {
+    TESTASSERT(send_initial_ue_message(fd, enb_id, ue + 1, test_imsi(enb_idx, ue)));
+  }
+
+  uint32_t nof_answers = 0;
+  while (nof_answers < nof_ues && recv_s1ap_pdu(fd, pdu)) {
+    if (pdu.type().value == s1ap_pdu_c::types_opts::init_msg &&
+        pdu.init_msg().value.type().value == s1ap_elem_procs_o::init_msg_c::types_opts::dl_nas_transport) {
+      nof_answers++;
+    }
+  }
+  nof_attaches += nof_answers;
+
+  close(fd);
+}
+
+static void test_attach_load()
+{
+  write_csv();
+
+  hss_args_t hss_args         = {};
+  hss_args.db_file            = csv_file;
+  hss_args.mcc                = mcc;
+  hss_args.mnc                = mnc;
+  hss_args.auth_cache_size    = 0;
+  hss_args.auth_cache_vectors = 8;
+  hss* h                      = hss::get_instance();
+  TESTASSERT(h->init(&hss_args) == 0);
+
+  mme_args_t mme_args                = {};
+  mme_args.s1ap_args.mme_code        = 0x1a;
+  mme_args.s1ap_args.mme_group       = 0x0001;
+  mme_args.s1ap_args.tac             = tac;
+  mme_args.s1ap_args.mcc             = mcc;
+  mme_args.s1ap_args.mnc             = mnc;
+  mme_args.s1ap_args.paging_timer    = 2;
+  mme_args.s1ap_args.mme_bind_addr   = "127.0.0.1";
+  mme_args.s1ap_args.mme_name        = "srsmme01";
+  mme_args.s1ap_args.dns_addr        = "8.8.8.8";
+  mme_args.s1ap_args.full_net_name   = "Software Radio Systems RAN";
+  mme_args.s1ap_args.short_net_name  = "srsRAN";
+  mme_args.s1ap_args.encryption_algo = srsran::CIPHERING_ALGORITHM_ID_EEA0;
+  mme_args.s1ap_args.integrity_algo  = srsran::INTEGRITY_ALGORITHM_ID_128_EIA1;
+  mme_args.s1ap_args.lac             = 6;
+  mme_args.s1ap_args.nof_workers     = nof_workers;
+
+  mme* m = mme::get_instance();
+  TESTASSERT(m->init(&mme_args) == 0);
+  m->start();
+
+  // The MME prints every message on the console, which would dominate the measurement
+  fflush(stdout);
+  int stdout_fd = dup(STDOUT_FILENO);
+  int null_fd   = open("/dev/null", O_WRONLY);
+  dup2(null_fd, STDOUT_FILENO);
+
+  struct timeval t = {};
+  gettimeofday(&t, nullptr);
+  std::vector<std::thread> enbs;
+  for (uint32_t enb = 0; enb < nof_enbs; enb++) {
+    enbs.emplace_back(run_enb, enb);
+  }
+  for (std::thread& enb : enbs) {
+    enb.join();
+  }
+  double total_ms = elapsed_ms(t);
+
+  fflush(stdout);
+  dup2(stdout_fd, STDOUT_FILENO);
+  close(stdout_fd);
+  close(null_fd);
+
+  printf("Attach load of %d eNBs with %d UEs each, %d S1AP workers: %.0f attaches/s\n",
+         nof_enbs,
+         nof_ues,
+         nof_workers,
+         nof_attaches / (total_ms / 1e3));
+  TESTASSERT(nof_attaches == nof_enbs * nof_ues);
+
+  m->stop();
+  mme::cleanup();
+  h->stop();
+  hss::cleanup();
+}
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+  srslog::fetch_basic_logger("S1AP", false).set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("NAS", false).set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::warning);
+
+  parse_args(argc, argv);
+
+  // The test needs the SCTP support of the kernel
+  int fd = socket(AF_INET, SOCK_SEQPACKET, IPPROTO_SCTP);
+  if (fd < 0) {
+    printf("SCTP not available, skipping test\n");
+    return SRSRAN_SUCCESS;
+  }
+  close(fd);
+
+  test_attach_load();
+
+  unlink(csv_file);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
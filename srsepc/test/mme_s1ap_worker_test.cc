@@ -0,0 +1,211 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Handoff of a UE between S1AP workers, without sockets. The UE contexts are added to the S1AP maps as the NAS does,
+ * and the S11 responses are emulated with UE events.
+ */
+
+#include "srsepc/hdr/mme/mme.h"
+#include "srsepc/hdr/mme/s1ap.h"
+#include "srsran/common/test_common.h"
+#include <future>
+#include <thread>
+
+using namespace srsepc;
+
+static const uint32_t nof_workers = 2;
+
+/// IMSIs without context, their events run on the worker IMSI % nof_workers
+static const uint64_t worker0_imsi = 2;
+static const uint64_t worker1_imsi = 3;
+
+static void add_enb(s1ap* s, uint16_t enb_id, int32_t assoc_id)
+{
+  enb_ctx_t              enb_ctx = {};
+  struct sctp_sndrcvinfo sri     = {};
+  enb_ctx.enb_id                 = enb_id;
+  sri.sinfo_assoc_id             = assoc_id;
+  s->add_new_enb_ctx(enb_ctx, &sri);
+}
+
+/// Connects the UE through the eNB of an association, as an Initial UE Message does
+static void connect_ue(s1ap* s, nas* nas_ctx, int32_t assoc_id)
+{
+  if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
+    TESTASSERT(s->release_ue_ecm_ctx(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id));
+  }
+  nas_ctx->m_ecm_ctx.enb_sri.sinfo_assoc_id = assoc_id;
+  nas_ctx->m_ecm_ctx.mme_ue_s1ap_id         = s->get_next_mme_ue_s1ap_id();
+  TESTASSERT(s->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx));
+  TESTASSERT(s->add_ue_to_enb_set(assoc_id, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id));
+}
+
+static std::thread::id get_worker_thread(s1ap* s, uint64_t imsi)
+{
+  std::promise<std::thread::id> id;
+  s->run_ue_task(imsi, [&id]() { id.set_value(std::this_thread::get_id()); });
+  return id.get_future().get();
+}
+
+static std::shared_ptr<nas> create_ue(s1ap* s, uint64_t imsi, int32_t assoc_id)
+{
+  nas_init_t           args    = {};
+  nas_if_t             itf     = {};
+  itf.s1ap                     = s;
+  std::shared_ptr<nas> nas_ctx = std::make_shared<nas>(args, itf);
+  nas_ctx->m_emm_ctx.imsi      = imsi;
+  connect_ue(s, nas_ctx.get(), assoc_id);
+  TESTASSERT(s->add_nas_ctx_to_imsi_map(nas_ctx.get()));
+  return nas_ctx;
+}
+
+/// An event queued on the previous worker of a UE runs on the new one, after the message that moved the UE
+static void test_event_forwarded_to_new_worker(s1ap* s)
+{
+  const uint64_t       imsi    = 1010123456001;
+  std::shared_ptr<nas> nas_ctx = create_ue(s, imsi, 0);
+  std::thread::id      worker0 = get_worker_thread(s, worker0_imsi);
+  std::thread::id      worker1 = get_worker_thread(s, worker1_imsi);
+  TESTASSERT(worker0 != worker1);
+  TESTASSERT(get_worker_thread(s, imsi) == worker0);
+
+  // Keep worker 0 busy while the S11 response of the UE is queued behind
+  std::promise<void> unblock;
+  std::future<void>  unblocked = unblock.get_future();
+  s->run_ue_task(worker0_imsi, [&unblocked]() { unblocked.wait(); });
+
+  std::promise<std::thread::id> event_thread;
+  s->run_ue_task(imsi, [s, imsi, &event_thread]() {
+    std::shared_ptr<nas> ctx = s->find_nas_ctx_from_imsi(imsi);
+    TESTASSERT(ctx != nullptr && ctx->m_ecm_ctx.enb_sri.sinfo_assoc_id == 1);
+    event_thread.set_value(std::this_thread::get_id());
+  });
+
+  // The UE reconnects through the eNB of worker 1 before worker 0 gets to the event
+  connect_ue(s, nas_ctx.get(), 1);
+  unblock.set_value();
+  TESTASSERT(event_thread.get_future().get() == worker1);
+  TESTASSERT(get_worker_thread(s, imsi) == worker1);
+
+  TESTASSERT(s->delete_ue_ctx(imsi));
+}
+
+/// A context deleted while an event of another worker holds it stays valid until the event is done
+static void test_ctx_deleted_during_event(s1ap* s)
+{
+  const uint64_t     imsi = 1010123456002;
+  std::weak_ptr<nas> weak_ctx;
+  {
+    std::shared_ptr<nas> nas_ctx = create_ue(s, imsi, 1);
+    weak_ctx                     = nas_ctx;
+  }
+
+  std::promise<void> found, deleted, done;
+  std::future<void>  deleted_future = deleted.get_future();
+  s->run_ue_task(imsi, [s, imsi, &found, &deleted_future, &done]() {
+    std::shared_ptr<nas> ctx = s->find_nas_ctx_from_imsi(imsi);
+    TESTASSERT(ctx != nullptr);
+    found.set_value();
+    deleted_future.wait();
+    TESTASSERT(ctx->m_emm_ctx.imsi == imsi);
+    TESTASSERT(s->find_nas_ctx_from_imsi(imsi) == nullptr);
+    done.set_value();
+  });
+
+  // Delete the UE from another thread, as a reattach through another worker does
+  found.get_future().wait();
+  TESTASSERT(s->delete_ue_ctx(imsi));
+  TESTASSERT(not weak_ctx.expired());
+  deleted.set_value();
+  done.get_future().wait();
+
+  // The event was the last holder of the context
+  get_worker_thread(s, worker1_imsi);
+  TESTASSERT(weak_ctx.expired());
+}
+
+/// A UE message received on the association of another worker is handled by the worker owning the UE
+static void test_pdu_forwarded_to_owner(s1ap* s)
+{
+  const uint64_t       imsi           = 1010123456003;
+  std::shared_ptr<nas> nas_ctx        = create_ue(s, imsi, 1);
+  uint32_t             mme_ue_s1ap_id = nas_ctx->m_ecm_ctx.mme_ue_s1ap_id;
+
+  // UE Context Release Complete of the UE, from the eNB of worker 0
+  s1ap_pdu_t tx_pdu;
+  tx_pdu.set_successful_outcome().load_info_obj(ASN1_S1AP_ID_UE_CONTEXT_RELEASE);
+  auto& container                 = tx_pdu.successful_outcome().value.ue_context_release_complete();
+  container->enb_ue_s1ap_id.value = 1;
+  container->mme_ue_s1ap_id.value = mme_ue_s1ap_id;
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  TESTASSERT(pdu != nullptr);
+  asn1::bit_ref bref(pdu->msg, pdu->get_tailroom());
+  TESTASSERT(tx_pdu.pack(bref) == asn1::SRSASN_SUCCESS);
+  pdu->N_bytes = bref.distance_bytes();
+
+  // Keep worker 1 busy while worker 0 receives the message
+  std::promise<void> unblock;
+  std::future<void>  unblocked = unblock.get_future();
+  s->run_ue_task(imsi, [&unblocked]() { unblocked.wait(); });
+
+  struct sctp_sndrcvinfo sri = {};
+  sri.sinfo_assoc_id         = 0;
+  s->dispatch_s1ap_rx_pdu(std::move(pdu), sri);
+  get_worker_thread(s, worker0_imsi);
+  TESTASSERT(s->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id) != nullptr);
+
+  // The release runs once worker 1 is free
+  unblock.set_value();
+  get_worker_thread(s, imsi);
+  TESTASSERT(s->find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id) == nullptr);
+
+  TESTASSERT(s->delete_ue_ctx(imsi));
+}
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+  srslog::fetch_basic_logger("S1AP", false).set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("NAS", false).set_level(srslog::basic_levels::warning);
+
+  s1ap* s                   = s1ap::get_instance();
+  s->m_s1ap_ctx_mngmt_proc = s1ap_ctx_mngmt_proc::get_instance();
+  s->m_s1ap_ctx_mngmt_proc->init();
+  s->start_workers(nof_workers);
+  add_enb(s, 1, 0);
+  add_enb(s, 2, 1);
+
+  test_event_forwarded_to_new_worker(s);
+  test_ctx_deleted_during_event(s);
+  test_pdu_forwarded_to_owner(s);
+
+  s->stop_workers();
+  s->delete_enb_ctx(0);
+  s->delete_enb_ctx(1);
+  s1ap::cleanup();
+  s1ap_ctx_mngmt_proc::cleanup();
+  mme::cleanup();
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
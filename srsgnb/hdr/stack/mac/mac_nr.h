@@ -22,6 +22,7 @@
 #ifndef SRSENB_MAC_NR_H
 #define SRSENB_MAC_NR_H
 
+#include "srsran/adt/rcu_circular_map.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/mac_pcap.h"
 
@@ -94,8 +95,9 @@ private:
   uint16_t alloc_ue(uint32_t enb_cc_idx);
 
   // internal misc helpers
-  bool is_rnti_valid_nolock(uint16_t rnti);
-  bool is_rnti_active_nolock(uint16_t rnti);
+  bool   is_rnti_valid_nolock(uint16_t rnti);
+  /// Active UE of the RNTI, or nullptr. Called within a read-side section of ue_db, or holding ue_db_mutex
+  ue_nr* find_active_ue_nolock(uint16_t rnti);
 
   // handle UCI data from either PUCCH or PUSCH
   bool handle_uci_data(uint16_t rnti, const srsran_uci_cfg_nr_t& cfg, const srsran_uci_value_nr_t& value);
@@ -131,10 +133,11 @@ private:
   std::unique_ptr<srsenb::sched_nr> sched;
   std::vector<sched_nr_cell_cfg_t>  cell_config;
 
-  // Map of active UEs
-  pthread_rwlock_t                                                              rwmutex    = {};
-  static const uint16_t                                                         FIRST_RNTI = 0x4601;
-  srsran::static_circular_map<uint16_t, std::unique_ptr<ue_nr>, SRSENB_MAX_UES> ue_db;
+  // Map of active UEs. The slot workers look up the UEs without locks, while the stack serializes the insertions and
+  // removals, which are freed once no worker can hold them
+  static const uint16_t                                     FIRST_RNTI = 0x4601;
+  std::mutex                                                ue_db_mutex;
+  srsran::rcu_circular_map<uint16_t, ue_nr, SRSENB_MAX_UES> ue_db;
 
   std::atomic<uint16_t> ue_counter{0};
 
@@ -148,7 +151,7 @@ private:
   srsran::unique_byte_buffer_t bcch_bch_payload = nullptr;
 
   // Number of rach preambles detected for a CC
-  std::vector<uint32_t> detected_rachs;
+  std::array<std::atomic<uint32_t>, SRSRAN_MAX_CARRIERS> detected_rachs = {};
 
   // Decoding of UL PDUs
   std::unique_ptr<mac_nr_rx> rx;
@@ -52,6 +52,7 @@ struct sched_nr_ue_cc_cfg_t {
 struct sched_nr_ue_lc_ch_cfg_t {
   uint32_t        lcid; // 1..32
   mac_lc_ch_cfg_t cfg;
+  uint32_t        five_qi = 0; // 5QI of the bearer, 0 if it has none
 };
 
 struct sched_nr_ue_cfg_t {
@@ -122,6 +123,8 @@ public:
     bool        auto_refill_buffer = false;
     int         fixed_dl_mcs       = 28;
     int         fixed_ul_mcs       = 28;
+    std::string sched_policy       = "time_rr";
+    std::string sched_policy_args  = "1";
     std::string logger_name        = "MAC-NR";
   };
 
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+#include <vector>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Time-domain Proportional Fair scheduler with QoS awareness. UEs are served in decreasing order of r / R^fairness,
+ * where r is the instantaneous rate estimate of the UE and R its averaged allocated rate. The PF metric is weighted by
+ * how long the data of each LCG of the UE has waited, relative to the Packet Delay Budget of the 5QIs of the LCG.
+ * The UEs with data that has waited over a fifth of its budget go before the others, the closest to its budget first.
+ * HARQ retxs go first.
+ * Only the UEs that had data or pending retxs in the last averaging window are tracked.
+ */
+class sched_nr_time_pf : public sched_nr_base
+{
+public:
+  explicit sched_nr_time_pf(const bwp_params_t& bwp_cfg_);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  struct ue_ctxt {
+    explicit ue_ctxt(uint16_t rnti_) : rnti(rnti_) {}
+    float dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
+    float ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
+    void  save_dl_alloc(uint32_t alloc_bytes);
+    void  save_ul_alloc(uint32_t alloc_bytes);
+
+    uint16_t   rnti;
+    slot_point last_active_slot;
+
+    // Candidacy and priority in the current slot
+    bool  dl_retx        = false;
+    bool  dl_newtx       = false;
+    bool  ul_retx        = false;
+    bool  ul_newtx       = false;
+    float dl_prio        = 0;
+    float ul_prio        = 0;
+    float dl_delay_ratio = 0; ///< highest ratio of waited time to delay budget of the LCGs with DL data
+    float ul_delay_ratio = 0; ///< same, for the LCGs with UL data in the BSR
+    float dl_slack_ms    = 0; ///< lowest time left to the delay budget of the LCGs with DL data
+    float ul_slack_ms    = 0; ///< same, for the LCGs with UL data in the BSR
+
+    /// Slot since which each LCG has data waiting without being served
+    std::array<slot_point, SCHED_NR_MAX_LC_GROUP + 1> dl_pending_since;
+    std::array<slot_point, SCHED_NR_MAX_LC_GROUP + 1> ul_pending_since;
+
+  private:
+    float    dl_avg_rate_   = 0;
+    float    ul_avg_rate_   = 0;
+    uint32_t dl_nof_samples = 0;
+    uint32_t ul_nof_samples = 0;
+  };
+
+  void  new_slot(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc);
+  float update_delay_ratio(const slot_ue&                                     ue,
+                           bool                                               is_dl,
+                           std::array<slot_point, SCHED_NR_MAX_LC_GROUP + 1>& pending_since,
+                           float&                                             slack_ms) const;
+  float get_pf_prio(float r, float R) const;
+  float get_dl_rate(const slot_ue& ue) const;
+  bool  try_dl_alloc(ue_ctxt& ctxt, slot_ue& ue, bwp_slot_allocator& slot_alloc) const;
+  bool  try_ul_alloc(ue_ctxt& ctxt, slot_ue& ue, bwp_slot_allocator& slot_alloc) const;
+
+  static void restart_pending(std::array<slot_point, SCHED_NR_MAX_LC_GROUP + 1>& pending_since, slot_point slot);
+
+  const bwp_params_t* bwp_cfg;
+  float               fairness_coeff = 1;
+  uint32_t            slots_per_ms   = 1;
+
+  slot_point          current_slot;
+  rnti_map_t<ue_ctxt> ue_history_db;
+
+  std::vector<ue_ctxt*> dl_queue;
+  std::vector<ue_ctxt*> ul_queue;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
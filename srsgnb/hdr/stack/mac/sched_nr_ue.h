@@ -72,6 +72,8 @@ public:
     explicit pdu_builder(uint32_t cc_, ue_buffer_manager& parent_) : cc(cc_), parent(&parent_) {}
     bool     alloc_subpdus(uint32_t rem_bytes, sched_nr_interface::dl_pdu_t& pdu);
     uint32_t pending_bytes(uint32_t lcid) const { return parent->get_dl_tx(lcid); }
+    uint32_t pending_lcg_bytes(uint32_t lcg) const;
+    uint32_t pending_ul_lcg_bytes(uint32_t lcg) const { return parent->get_bsr(lcg); }
 
   private:
     uint32_t           cc     = SRSRAN_MAX_CARRIERS;
@@ -197,6 +199,10 @@ public:
 
   bool get_pending_bytes(uint32_t lcid) const { return ue->pdu_builder.pending_bytes(lcid); }
 
+  /// Pending DL bytes and UL BSR of a Logical Channel Group
+  uint32_t get_dl_lcg_bytes(uint32_t lcg) const { return ue->pdu_builder.pending_lcg_bytes(lcg); }
+  uint32_t get_ul_lcg_bytes(uint32_t lcg) const { return ue->pdu_builder.pending_ul_lcg_bytes(lcg); }
+
   /// Channel Information Getters
   uint32_t dl_cqi() const { return ue->dl_cqi; }
   uint32_t ul_cqi() const { return ue->ul_cqi; }
@@ -30,10 +30,14 @@ namespace sched_nr_impl {
 using ue_cc_cfg_list = srsran::bounded_vector<sched_nr_ue_cc_cfg_t, SCHED_NR_MAX_CARRIERS>;
 
 struct ue_cfg_manager {
-  uint32_t                                       maxharq_tx = 4;
+  uint32_t                                       maxharq_tx         = 4;
   ue_cc_cfg_list                                 carriers;
-  std::array<mac_lc_ch_cfg_t, SCHED_NR_MAX_LCID> ue_bearers = {};
-  srsran::phy_cfg_nr_t                           phy_cfg    = {};
+  std::array<mac_lc_ch_cfg_t, SCHED_NR_MAX_LCID> ue_bearers         = {};
+  std::array<uint32_t, SCHED_NR_MAX_LCID>        ue_bearers_five_qi = {};
+  srsran::phy_cfg_nr_t                           phy_cfg            = {};
+
+  /// Tightest Packet Delay Budget of the bearers of every LCG in msec, 0 if none of its bearers has a 5QI
+  std::array<uint32_t, SCHED_NR_MAX_LC_GROUP + 1> lcg_delay_budget_ms = {};
 
   explicit ue_cfg_manager(uint32_t enb_cc_idx = 0);
   explicit ue_cfg_manager(const sched_nr_ue_cfg_t& cfg_req);
@@ -29,6 +29,8 @@
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/mac/bsr_nr.h"
 #include "srsran/mac/mac_sch_pdu_nr.h"
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -61,19 +63,19 @@ public:
 
   int generate_pdu(srsran::byte_buffer_t* pdu, uint32_t grant_size, srsran::const_span<uint32_t> subpdu_lcids);
 
-  std::mutex metrics_mutex = {};
-  void       metrics_read(mac_ue_metrics_t* metrics_);
-  void       metrics_rx(bool crc, uint32_t tbs);
-  void       metrics_tx(bool crc, uint32_t tbs);
-  void       metrics_phr(float phr);
-  void       metrics_dl_ri(uint32_t dl_cqi);
-  void       metrics_dl_pmi(uint32_t dl_cqi);
-  void       metrics_dl_cqi(const srsran_uci_cfg_nr_t& cfg_, uint32_t dl_cqi);
-  void       metrics_dl_mcs(uint32_t mcs);
-  void       metrics_ul_mcs(uint32_t mcs);
-  void       metrics_pucch_sinr(float sinr);
-  void       metrics_pusch_sinr(float sinr);
-  void       metrics_cnt();
+  // Metrics, updated without locks from any thread
+  void metrics_read(mac_ue_metrics_t* metrics_);
+  void metrics_rx(bool crc, uint32_t tbs);
+  void metrics_tx(bool crc, uint32_t tbs);
+  void metrics_phr(float phr);
+  void metrics_dl_ri(uint32_t dl_cqi);
+  void metrics_dl_pmi(uint32_t dl_cqi);
+  void metrics_dl_cqi(const srsran_uci_cfg_nr_t& cfg_, uint32_t dl_cqi);
+  void metrics_dl_mcs(uint32_t mcs);
+  void metrics_ul_mcs(uint32_t mcs);
+  void metrics_pucch_sinr(float sinr);
+  void metrics_pusch_sinr(float sinr);
+  void metrics_cnt();
 
   uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) final;
 
@@ -91,15 +93,54 @@ private:
 
   std::atomic<bool> active_state{true};
 
-  // TODO: some counters are kept as members of class ue_nr, while some others (i.e., mcs) are kept in the ue_metrics
-  // We should make these counters more uniform
-  uint32_t         phr_counter          = 0;
-  uint32_t         dl_cqi_valid_counter = 0;
-  uint32_t         dl_ri_counter        = 0;
-  uint32_t         dl_pmi_counter       = 0;
-  uint32_t         pucch_sinr_counter   = 0;
-  uint32_t         pusch_sinr_counter   = 0;
-  mac_ue_metrics_t ue_metrics           = {};
+  /// Counters of the UE metrics, cumulative since the creation of the UE. The SINR sums are in thousandths of dB
+  enum metrics_counter_t {
+    nof_tti,
+    tx_pkts,
+    tx_errors,
+    tx_bits,
+    rx_pkts,
+    rx_errors,
+    rx_bits,
+    dl_cqi_sum,
+    dl_cqi_samples,
+    dl_mcs_sum,
+    dl_mcs_samples,
+    ul_mcs_sum,
+    ul_mcs_samples,
+    pucch_sinr_sum,
+    pucch_sinr_samples,
+    pusch_sinr_sum,
+    pusch_sinr_samples,
+    nof_metrics_counters
+  };
+  using metrics_counters_t = std::array<uint64_t, nof_metrics_counters>;
+
+  /// The counters are sharded by thread, as in latency_histogram, so that the slot workers and the stack update the
+  /// metrics of a UE without a lock and without sharing cache lines. The shards are added up by metrics_read
+  static const uint32_t nof_metrics_shards = 16;
+  struct metrics_shard_t {
+    std::array<std::atomic<uint64_t>, nof_metrics_counters> counters = {};
+    char                                                    padding[64]; ///< keeps the counters of two shards apart
+  };
+
+  void metrics_add(metrics_counter_t counter, uint64_t value)
+  {
+    metrics_shards[get_metrics_shard_idx()].counters[counter].fetch_add(value, std::memory_order_relaxed);
+  }
+  void metrics_merge(metrics_counters_t& total) const;
+
+  static uint32_t get_metrics_shard_idx()
+  {
+    static std::atomic<uint32_t> next_shard_idx{0};
+    thread_local uint32_t        shard_idx =
+        next_shard_idx.fetch_add(1, std::memory_order_relaxed) % nof_metrics_shards;
+    return shard_idx;
+  }
+
+  std::array<metrics_shard_t, nof_metrics_shards> metrics_shards;
+  std::mutex         metrics_mutex; ///< guards the counters at the previous read, only taken by metrics_read and reset
+  metrics_counters_t last_metrics = {};
 
   // UE-specific buffer for MAC PDU packing, unpacking and handling
   srsran::mac_sch_pdu_nr                    mac_pdu_dl, mac_pdu_ul;
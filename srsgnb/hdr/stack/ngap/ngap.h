@@ -199,7 +199,8 @@ private:
     ngap* ngap_ptr = nullptr;
   };
 
-  ue* handle_ngapmsg_ue_id(uint32_t gnb_id, uint64_t amf_id);
+  ue*  handle_ngapmsg_ue_id(uint32_t gnb_id, uint64_t amf_id);
+  bool check_ue_ngap_ids(const asn1::ap_pdu_view& msg);
 
   srsran::proc_t<ng_setup_proc_t> ngsetup_proc;
 
@@ -23,7 +23,6 @@
 #include "srsgnb/hdr/stack/mac/sched_nr.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/phy_cfg_nr_default.h"
-#include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/time_prof.h"
@@ -276,16 +275,21 @@ void mac_nr::get_metrics(srsenb::mac_metrics_t& metrics)
 
 void mac_nr::get_metrics_nolock(srsenb::mac_metrics_t& metrics)
 {
-  srsran::rwlock_read_guard lock(rwmutex);
+  {
+    // Free the UEs removed since the previous period, out of the read-side section which would hold them back
+    std::lock_guard<std::mutex> lock(ue_db_mutex);
+    ue_db.reclaim();
+  }
+  srsran::rcu_read_guard rcu_lock(ue_db.get_domain());
   metrics.ues.reserve(ue_db.size());
-  for (auto& u : ue_db) {
+  ue_db.for_each([&metrics](uint16_t rnti, ue_nr& u) {
     metrics.ues.emplace_back();
-    u.second->metrics_read(&metrics.ues.back());
-  }
-  metrics.cc_info.resize(detected_rachs.size());
-  for (unsigned cc = 0, e = detected_rachs.size(); cc != e; ++cc) {
-    metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
-    metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].pci : 0;
+    u.metrics_read(&metrics.ues.back());
+  });
+  metrics.cc_info.resize(std::min<size_t>(cell_config.size(), detected_rachs.size()));
+  for (unsigned cc = 0, e = metrics.cc_info.size(); cc != e; ++cc) {
+    metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc].load(std::memory_order_relaxed);
+    metrics.cc_info[cc].pci             = cell_config[cc].pci;
   }
 }
 
@@ -293,7 +297,6 @@ int mac_nr::cell_cfg(const std::vector<srsenb::sched_nr_cell_cfg_t>& nr_cells)
 {
   cell_config = nr_cells;
   sched->config(args.sched_cfg, nr_cells);
-  detected_rachs.resize(nr_cells.size());
 
   // read SIBs from RRC (SIB1 for now only)
   for (uint32_t i = 0; i < nr_cells[0].sibs.size(); i++) {
@@ -351,10 +354,7 @@ void mac_nr::rach_detected(const rach_info_t& rach_info)
     uint16_t rnti = alloc_ue(enb_cc_idx);
 
     // Log this event.
-    {
-      srsran::rwlock_write_guard lock(rwmutex);
-      ++detected_rachs[enb_cc_idx];
-    }
+    detected_rachs[enb_cc_idx].fetch_add(1, std::memory_order_relaxed);
 
     // Trigger scheduler RACH
     srsenb::sched_nr_interface::rar_info_t rar_info = {};
@@ -383,36 +383,32 @@ void mac_nr::rach_detected(const rach_info_t& rach_info)
 
 uint16_t mac_nr::alloc_ue(uint32_t enb_cc_idx)
 {
-  ue_nr*   inserted_ue = nullptr;
-  uint16_t rnti        = SRSRAN_INVALID_RNTI;
+  bool     inserted = false;
+  uint16_t rnti     = SRSRAN_INVALID_RNTI;
 
   do {
     // Assign new RNTI
     rnti = FIRST_RNTI + (ue_counter.fetch_add(1, std::memory_order_relaxed) % 60000);
 
     // Pre-check if rnti is valid
-    {
-      srsran::rwlock_read_guard read_lock(rwmutex);
-      if (not is_rnti_valid_nolock(rnti)) {
-        continue;
-      }
+    if (not is_rnti_valid_nolock(rnti)) {
+      continue;
     }
 
     // Allocate and initialize UE object
     std::unique_ptr<ue_nr> ue_ptr(new ue_nr(rnti, enb_cc_idx, sched.get(), rrc, rlc, phy, logger));
 
     // Add UE to rnti map
-    srsran::rwlock_write_guard rw_lock(rwmutex);
+    std::lock_guard<std::mutex> lock(ue_db_mutex);
+    ue_db.reclaim();
     if (not is_rnti_valid_nolock(rnti)) {
       continue;
     }
-    auto ret = ue_db.insert(rnti, std::move(ue_ptr));
-    if (ret.has_value()) {
-      inserted_ue = ret.value()->second.get();
-    } else {
+    inserted = ue_db.insert(rnti, std::move(ue_ptr));
+    if (not inserted) {
       logger.info("Failed to allocate rnti=0x%x. Attempting a different rnti.", rnti);
     }
-  } while (inserted_ue == nullptr);
+  } while (not inserted);
 
   return rnti;
 }
@@ -420,10 +416,12 @@ uint16_t mac_nr::alloc_ue(uint32_t enb_cc_idx)
 // Remove UE from the perspective of L2/L3
 int mac_nr::remove_ue(uint16_t rnti)
 {
-  srsran::rwlock_write_guard lock(rwmutex);
-  if (is_rnti_active_nolock(rnti)) {
+  std::lock_guard<std::mutex> lock(ue_db_mutex);
+  if (find_active_ue_nolock(rnti) != nullptr) {
     sched->ue_rem(rnti);
+    // The UE is freed once the slot workers that may still use it are done
     ue_db.erase(rnti);
+    ue_db.reclaim();
   } else {
     logger.error("User rnti=0x%x not found", rnti);
     return SRSRAN_ERROR;
@@ -449,13 +447,14 @@ bool mac_nr::is_rnti_valid_nolock(uint16_t rnti)
   return true;
 }
 
-bool mac_nr::is_rnti_active_nolock(uint16_t rnti)
+ue_nr* mac_nr::find_active_ue_nolock(uint16_t rnti)
 {
-  if (not ue_db.contains(rnti)) {
+  ue_nr* u = ue_db.find(rnti);
+  if (u == nullptr) {
     logger.error("User rnti=0x%x not found", rnti);
-    return false;
+    return nullptr;
   }
-  return ue_db[rnti]->is_active();
+  return u->is_active() ? u : nullptr;
 }
 
 int mac_nr::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue)
@@ -476,9 +475,10 @@ int mac_nr::slot_indication(const srsran_slot_cfg_t& slot_cfg)
 
 void mac_nr::store_msg3(uint16_t rnti, srsran::unique_byte_buffer_t pdu)
 {
-  srsran::rwlock_read_guard rw_lock(rwmutex);
-  if (is_rnti_active_nolock(rnti)) {
-    ue_db[rnti]->store_msg3(std::move(pdu));
+  srsran::rcu_read_guard rcu_lock(ue_db.get_domain());
+  ue_nr*                 u = find_active_ue_nolock(rnti);
+  if (u != nullptr) {
+    u->store_msg3(std::move(pdu));
   } else {
     logger.error("User rnti=0x%x not found. Can't store Msg3.", rnti);
   }
@@ -500,25 +500,26 @@ mac_nr::dl_sched_t* mac_nr::get_dl_sched(const srsran_slot_cfg_t& slot_cfg)
   }
 
   // Generate MAC DL PDUs
-  uint32_t                  rar_count = 0, si_count = 0, data_count = 0;
-  srsran::rwlock_read_guard rw_lock(rwmutex);
+  uint32_t               rar_count = 0, si_count = 0, data_count = 0;
+  srsran::rcu_read_guard rcu_lock(ue_db.get_domain());
   for (pdsch_t& pdsch : dl_res->phy.pdsch) {
     if (pdsch.sch.grant.rnti_type == srsran_rnti_type_c) {
       uint16_t rnti = pdsch.sch.grant.rnti;
-      if (not is_rnti_active_nolock(rnti)) {
+      ue_nr*   u    = find_active_ue_nolock(rnti);
+      if (u == nullptr) {
         continue;
       }
       for (auto& tb_data : pdsch.data) {
         if (tb_data != nullptr and tb_data->N_bytes == 0) {
           // TODO: exclude retx from packing
           const sched_nr_interface::dl_pdu_t& pdu = dl_res->data[data_count++];
-          ue_db[rnti]->generate_pdu(tb_data, pdsch.sch.grant.tb->tbs / 8, pdu.subpdus);
+          u->generate_pdu(tb_data, pdsch.sch.grant.tb->tbs / 8, pdu.subpdus);
 
           if (pcap != nullptr) {
             uint32_t pid = 0; // TODO: get PID from PDCCH struct?
             pcap->write_dl_crnti_nr(tb_data->msg, tb_data->N_bytes, rnti, pid, slot_cfg.idx);
           }
-          ue_db[rnti]->metrics_dl_mcs(pdsch.sch.grant.tb->mcs);
+          u->metrics_dl_mcs(pdsch.sch.grant.tb->mcs);
         }
       }
     } else if (pdsch.sch.grant.rnti_type == srsran_rnti_type_ra) {
@@ -539,9 +540,7 @@ mac_nr::dl_sched_t* mac_nr::get_dl_sched(const srsran_slot_cfg_t& slot_cfg)
 #endif
     }
   }
-  for (auto& u : ue_db) {
-    u.second->metrics_cnt();
-  }
+  ue_db.for_each([](uint16_t rnti, ue_nr& u) { u.metrics_cnt(); });
 
   return &dl_res->phy;
 }
@@ -551,10 +550,11 @@ mac_nr::ul_sched_t* mac_nr::get_ul_sched(const srsran_slot_cfg_t& slot_cfg)
   slot_point  pusch_slot = srsran::slot_point{NUMEROLOGY_IDX, slot_cfg.idx};
   ul_sched_t* ul_sched   = sched->get_ul_sched(pusch_slot, 0);
 
-  srsran::rwlock_read_guard rw_lock(rwmutex);
+  srsran::rcu_read_guard rcu_lock(ue_db.get_domain());
   for (auto& pusch : ul_sched->pusch) {
-    if (ue_db.contains(pusch.sch.grant.rnti)) {
-      ue_db[pusch.sch.grant.rnti]->metrics_ul_mcs(pusch.sch.grant.tb->mcs);
+    ue_nr* u = ue_db.find(pusch.sch.grant.rnti);
+    if (u != nullptr) {
+      u->metrics_ul_mcs(pusch.sch.grant.tb->mcs);
     }
   }
   return ul_sched;
@@ -568,10 +568,11 @@ int mac_nr::pucch_info(const srsran_slot_cfg_t& slot_cfg, const mac_interface_ph
   }
 
   // process PUCCH SNR
-  uint16_t                  rnti = pucch_info.uci_data.cfg.pucch.rnti;
-  srsran::rwlock_read_guard rw_lock(rwmutex);
-  if (ue_db.contains(rnti)) {
-    ue_db[rnti]->metrics_pucch_sinr(pucch_info.csi.snr_dB);
+  uint16_t               rnti = pucch_info.uci_data.cfg.pucch.rnti;
+  srsran::rcu_read_guard rcu_lock(ue_db.get_domain());
+  ue_nr*                 u = ue_db.find(rnti);
+  if (u != nullptr) {
+    u->metrics_pucch_sinr(pucch_info.csi.snr_dB);
   }
 
   return SRSRAN_SUCCESS;
@@ -584,9 +585,10 @@ bool mac_nr::handle_uci_data(uint16_t rnti, const srsran_uci_cfg_nr_t& cfg_, con
     const srsran_harq_ack_bit_t* ack_bit = &cfg_.ack.bits[i];
     bool                         is_ok   = (value.ack[i] == 1) and value.valid;
     sched->dl_ack_info(rnti, 0, ack_bit->pid, 0, is_ok);
-    srsran::rwlock_read_guard rw_lock(rwmutex);
-    if (ue_db.contains(rnti)) {
-      ue_db[rnti]->metrics_tx(is_ok, 0 /*TODO get size of packet from scheduler somehow*/);
+    srsran::rcu_read_guard rcu_lock(ue_db.get_domain());
+    ue_nr*                 u = ue_db.find(rnti);
+    if (u != nullptr) {
+      u->metrics_tx(is_ok, 0 /*TODO get size of packet from scheduler somehow*/);
     }
   }
 
@@ -607,9 +609,10 @@ bool mac_nr::handle_uci_data(uint16_t rnti, const srsran_uci_cfg_nr_t& cfg_, con
     sched->dl_cqi_info(rnti, 0, value.csi->wideband_cri_ri_pmi_cqi.cqi);
 
     // 2. Save CQI report for metrics stats
-    srsran::rwlock_read_guard rw_lock(rwmutex);
-    if (ue_db.contains(rnti) && value.valid) {
-      ue_db[rnti]->metrics_dl_cqi(cfg_, value.csi->wideband_cri_ri_pmi_cqi.cqi);
+    srsran::rcu_read_guard rcu_lock(ue_db.get_domain());
+    ue_nr*                 u = ue_db.find(rnti);
+    if (u != nullptr && value.valid) {
+      u->metrics_dl_cqi(cfg_, value.csi->wideband_cri_ri_pmi_cqi.cqi);
     }
   }
 
@@ -639,10 +642,11 @@ int mac_nr::pusch_info(const srsran_slot_cfg_t& slot_cfg, mac_interface_phy_nr::
     // Decode and send PDU to upper layers
     rx->handle_pdu(rnti, std::move(pusch_info.pdu));
   }
-  srsran::rwlock_read_guard rw_lock(rwmutex);
-  if (ue_db.contains(rnti)) {
-    ue_db[rnti]->metrics_rx(pusch_info.pusch_data.tb[0].crc, nof_bytes);
-    ue_db[rnti]->metrics_pusch_sinr(pusch_info.csi.snr_dB);
+  srsran::rcu_read_guard rcu_lock(ue_db.get_domain());
+  ue_nr*                 u = ue_db.find(rnti);
+  if (u != nullptr) {
+    u->metrics_rx(pusch_info.pusch_data.tb[0].crc, nof_bytes);
+    u->metrics_pusch_sinr(pusch_info.csi.snr_dB);
   }
   return SRSRAN_SUCCESS;
 }
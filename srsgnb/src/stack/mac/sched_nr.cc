@@ -27,6 +27,7 @@
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/thread_pool.h"
+#include "srsran/common/time_prof.h"
 
 namespace srsenb {
 
@@ -408,7 +409,10 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
   }
 
   // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
-  sched_nr::dl_res_t* ret = cc_workers[cc]->run_slot(pdsch_tti, ue_db);
+  static srsran::latency_tprof sched_tprof("sched_nr");
+  auto                         sched_meas = sched_tprof.start();
+  sched_nr::dl_res_t*          ret        = cc_workers[cc]->run_slot(pdsch_tti, ue_db);
+  sched_meas.stop();
 
   // decrement the number of active workers
   int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
@@ -0,0 +1,284 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Smoothing factor of the averaged rates. Its inverse is the averaging window in slots
+static const float exp_avg_alpha = 0.01;
+
+/// Fraction of the delay budget waited after which a UE goes before the UEs ranked by PF. It leaves room for the UL
+/// slots of TDD before the budget of the low latency 5QIs runs out
+static const float urgent_delay_ratio = 0.2;
+
+/// Order: HARQ retxs, UEs close to their delay budget by increasing time left, and the others by decreasing PF
+static std::tuple<bool, bool, float> get_sort_key(bool retx, float delay_ratio, float slack_ms, float prio)
+{
+  bool urgent = delay_ratio >= urgent_delay_ratio;
+  return std::make_tuple(retx, urgent, urgent ? -slack_ms : prio);
+}
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg_) :
+  bwp_cfg(&bwp_cfg_), slots_per_ms(1U << bwp_cfg_.cfg.numerology_idx)
+{
+  if (not bwp_cfg->sched_cfg.sched_policy_args.empty()) {
+    fairness_coeff = std::stof(bwp_cfg->sched_cfg.sched_policy_args);
+  }
+  dl_queue.reserve(SRSENB_MAX_UES);
+  ul_queue.reserve(SRSENB_MAX_UES);
+}
+
+void sched_nr_time_pf::new_slot(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  current_slot      = slot_alloc.get_pdcch_tti();
+  slot_point tti_rx = slot_alloc.get_tti_rx();
+  dl_queue.clear();
+  ul_queue.clear();
+
+  // Stop tracking the UEs that were removed or that have been idle for longer than the averaging window
+  const int window_slots = std::lround(1 / exp_avg_alpha);
+  for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
+    if (not ue_db.contains(it->first) or current_slot - it->second.last_active_slot > window_slots) {
+      it = ue_history_db.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  for (auto& u : ue_db) {
+    slot_ue& ue       = u.second;
+    bool     dl_retx  = ue.h_dl != nullptr and ue.h_dl->has_pending_retx(tti_rx);
+    bool     dl_newtx = not dl_retx and ue.dl_bytes > 0 and ue.h_dl != nullptr and ue.h_dl->empty();
+    bool     ul_retx  = ue.h_ul != nullptr and ue.h_ul->has_pending_retx(tti_rx);
+    bool     ul_newtx = not ul_retx and ue.ul_bytes > 0 and ue.h_ul != nullptr and ue.h_ul->empty();
+    bool     active   = dl_retx or dl_newtx or ul_retx or ul_newtx;
+
+    auto it = ue_history_db.find(u.first);
+    if (it == ue_history_db.end()) {
+      if (not active) {
+        continue;
+      }
+      auto ret = ue_history_db.insert(u.first, ue_ctxt{u.first});
+      if (not ret.has_value()) {
+        logger.warning("SCHED: Failed to track rnti=0x%x in the PF scheduler", u.first);
+        continue;
+      }
+      it = ret.value();
+    }
+    ue_ctxt& ctxt = it->second;
+
+    // The waiting time of the LCGs is also kept for UEs with data but no free HARQs
+    ctxt.dl_delay_ratio = update_delay_ratio(ue, true, ctxt.dl_pending_since, ctxt.dl_slack_ms);
+    ctxt.ul_delay_ratio = update_delay_ratio(ue, false, ctxt.ul_pending_since, ctxt.ul_slack_ms);
+    if (not active) {
+      continue;
+    }
+    ctxt.last_active_slot = current_slot;
+    ctxt.dl_retx          = dl_retx;
+    ctxt.dl_newtx         = dl_newtx;
+    ctxt.ul_retx          = ul_retx;
+    ctxt.ul_newtx         = ul_newtx;
+
+    if (dl_retx or dl_newtx) {
+      ctxt.dl_prio = get_pf_prio(get_dl_rate(ue), ctxt.dl_avg_rate()) * (1 + ctxt.dl_delay_ratio);
+      dl_queue.push_back(&ctxt);
+    }
+    if (ul_retx or ul_newtx) {
+      // The UL MCS is fixed, so the instantaneous rate is the same for all UEs
+      ctxt.ul_prio = get_pf_prio(1, ctxt.ul_avg_rate()) * (1 + ctxt.ul_delay_ratio);
+      ul_queue.push_back(&ctxt);
+    }
+  }
+
+  std::sort(dl_queue.begin(), dl_queue.end(), [](const ue_ctxt* lhs, const ue_ctxt* rhs) {
+    return get_sort_key(lhs->dl_retx, lhs->dl_delay_ratio, lhs->dl_slack_ms, lhs->dl_prio) >
+           get_sort_key(rhs->dl_retx, rhs->dl_delay_ratio, rhs->dl_slack_ms, rhs->dl_prio);
+  });
+  std::sort(ul_queue.begin(), ul_queue.end(), [](const ue_ctxt* lhs, const ue_ctxt* rhs) {
+    return get_sort_key(lhs->ul_retx, lhs->ul_delay_ratio, lhs->ul_slack_ms, lhs->ul_prio) >
+           get_sort_key(rhs->ul_retx, rhs->ul_delay_ratio, rhs->ul_slack_ms, rhs->ul_prio);
+  });
+}
+
+/*****************************************************************
+ *                         Downlink
+ *****************************************************************/
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc);
+  }
+
+  for (ue_ctxt* ctxt : dl_queue) {
+    slot_ue& ue          = ue_db[ctxt->rnti];
+    uint32_t alloc_bytes = 0;
+    if (try_dl_alloc(*ctxt, ue, slot_alloc)) {
+      // NOTE: The HARQ TBS is in bits
+      alloc_bytes = ue.h_dl->tbs() / 8;
+      restart_pending(ctxt->dl_pending_since, current_slot);
+    }
+    ctxt->save_dl_alloc(alloc_bytes);
+  }
+}
+
+bool sched_nr_time_pf::try_dl_alloc(ue_ctxt& ctxt, slot_ue& ue, bwp_slot_allocator& slot_alloc) const
+{
+  int ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
+  if (ctxt.dl_retx) {
+    return slot_alloc.alloc_pdsch(ue, ss_id, ue.h_dl->prbs()) == alloc_result::success;
+  }
+  if (ss_id < 0) {
+    return false;
+  }
+  prb_grant prbs = find_optimal_dl_grant(slot_alloc, ue, ss_id);
+  if (prbs.is_alloc_type1() and prbs.prbs().empty()) {
+    // A UE allocated before took the remaining PRBs
+    return false;
+  }
+  return slot_alloc.alloc_pdsch(ue, ss_id, prbs) == alloc_result::success;
+}
+
+float sched_nr_time_pf::get_dl_rate(const slot_ue& ue) const
+{
+  if (ue->fixed_pdsch_mcs() >= 0 or ue.cfg().phy().csi.reports[0].type == SRSRAN_CSI_REPORT_TYPE_NONE) {
+    // The MCS does not depend on the channel, so neither does the rate
+    return 1;
+  }
+  return std::max(srsran_ra_nr_cqi_to_se(ue.dl_cqi(), ue.cfg().phy().csi.reports[0].cqi_table), 0.0);
+}
+
+/*****************************************************************
+ *                         Uplink
+ *****************************************************************/
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc);
+  }
+
+  for (ue_ctxt* ctxt : ul_queue) {
+    slot_ue& ue          = ue_db[ctxt->rnti];
+    uint32_t alloc_bytes = 0;
+    if (try_ul_alloc(*ctxt, ue, slot_alloc)) {
+      alloc_bytes = ue.h_ul->tbs() / 8;
+      restart_pending(ctxt->ul_pending_since, current_slot);
+    }
+    ctxt->save_ul_alloc(alloc_bytes);
+  }
+}
+
+bool sched_nr_time_pf::try_ul_alloc(ue_ctxt& ctxt, slot_ue& ue, bwp_slot_allocator& slot_alloc) const
+{
+  if (ctxt.ul_retx) {
+    return slot_alloc.alloc_pusch(ue, ue.h_ul->prbs()) == alloc_result::success;
+  }
+  const prb_bitmap& used_prbs = slot_alloc.occupied_ul_prbs(ue.pusch_slot);
+  prb_interval      prbs      = find_empty_interval_of_length(used_prbs, used_prbs.size());
+  if (prbs.empty()) {
+    return false;
+  }
+  return slot_alloc.alloc_pusch(ue, prbs) == alloc_result::success;
+}
+
+/*****************************************************************
+ *                          UE history
+ *****************************************************************/
+
+float sched_nr_time_pf::get_pf_prio(float r, float R) const
+{
+  if (R == 0) {
+    // UEs with no history go first
+    return r == 0 ? 0 : std::numeric_limits<float>::max();
+  }
+  return r / std::pow(R, fairness_coeff);
+}
+
+float sched_nr_time_pf::update_delay_ratio(const slot_ue&                                     ue,
+                                           bool                                               is_dl,
+                                           std::array<slot_point, SCHED_NR_MAX_LC_GROUP + 1>& pending_since,
+                                           float&                                             slack_ms) const
+{
+  const auto& delay_budgets = ue->ue_cfg().lcg_delay_budget_ms;
+  float       max_ratio     = 0;
+  slack_ms                  = std::numeric_limits<float>::max();
+  for (uint32_t lcg = 0; lcg < delay_budgets.size(); ++lcg) {
+    if (delay_budgets[lcg] == 0) {
+      continue;
+    }
+    uint32_t pending_bytes = is_dl ? ue.get_dl_lcg_bytes(lcg) : ue.get_ul_lcg_bytes(lcg);
+    if (pending_bytes == 0) {
+      pending_since[lcg].clear();
+      continue;
+    }
+    if (not pending_since[lcg].valid()) {
+      pending_since[lcg] = current_slot;
+    }
+    float waited_ms = (current_slot - pending_since[lcg]) / static_cast<float>(slots_per_ms);
+    max_ratio       = std::max(max_ratio, waited_ms / delay_budgets[lcg]);
+    slack_ms        = std::min(slack_ms, delay_budgets[lcg] - waited_ms);
+  }
+  return max_ratio;
+}
+
+void sched_nr_time_pf::restart_pending(std::array<slot_point, SCHED_NR_MAX_LC_GROUP + 1>& pending_since,
+                                       slot_point                                         slot)
+{
+  // The data left after the allocation waits since now
+  for (slot_point& since : pending_since) {
+    if (since.valid()) {
+      since = slot;
+    }
+  }
+}
+
+void sched_nr_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes)
+{
+  if (dl_nof_samples < 1 / exp_avg_alpha) {
+    // fast start
+    dl_avg_rate_ = dl_avg_rate_ + (alloc_bytes - dl_avg_rate_) / (dl_nof_samples + 1);
+  } else {
+    dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + exp_avg_alpha * alloc_bytes;
+  }
+  dl_nof_samples++;
+}
+
+void sched_nr_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes)
+{
+  if (ul_nof_samples < 1 / exp_avg_alpha) {
+    // fast start
+    ul_avg_rate_ = ul_avg_rate_ + (alloc_bytes - ul_avg_rate_) / (ul_nof_samples + 1);
+  } else {
+    ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + exp_avg_alpha * alloc_bytes;
+  }
+  ul_nof_samples++;
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
@@ -79,6 +79,17 @@ bool ue_buffer_manager::pdu_builder::alloc_subpdus(uint32_t rem_bytes, sched_nr_
   return true;
 }
 
+uint32_t ue_buffer_manager::pdu_builder::pending_lcg_bytes(uint32_t lcg) const
+{
+  uint32_t bytes = 0;
+  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
+    if (parent->is_bearer_dl(lcid) and parent->get_cfg(lcid).group == (int)lcg) {
+      bytes += parent->get_dl_tx_total(lcid);
+    }
+  }
+  return bytes;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 slot_ue::slot_ue(ue_carrier& ue_, slot_point slot_tx_) : ue(&ue_), pdcch_slot(slot_tx_)
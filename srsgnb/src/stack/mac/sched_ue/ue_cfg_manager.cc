@@ -50,11 +50,26 @@ int ue_cfg_manager::apply_config_request(const sched_nr_ue_cfg_t& cfg_req)
   }
   for (uint32_t lcid : cfg_req.lc_ch_to_rem) {
     assert(lcid > 0 && "LCID=0 cannot be removed");
-    ue_bearers[lcid] = {};
+    ue_bearers[lcid]         = {};
+    ue_bearers_five_qi[lcid] = 0;
   }
   for (const sched_nr_ue_lc_ch_cfg_t& lc_ch : cfg_req.lc_ch_to_add) {
     assert(lc_ch.lcid > 0 && "LCID=0 cannot be configured");
-    ue_bearers[lc_ch.lcid] = lc_ch.cfg;
+    ue_bearers[lc_ch.lcid]         = lc_ch.cfg;
+    ue_bearers_five_qi[lc_ch.lcid] = lc_ch.five_qi;
+  }
+
+  // Derive the delay budget of every LCG from the 5QIs of its bearers
+  lcg_delay_budget_ms = {};
+  for (uint32_t lcid = 0; lcid < SCHED_NR_MAX_LCID; ++lcid) {
+    uint32_t budget_ms = srsran::get_five_qi_delay_budget_ms(ue_bearers_five_qi[lcid]);
+    uint32_t lcg       = ue_bearers[lcid].group;
+    if (not ue_bearers[lcid].is_active() or budget_ms == 0 or lcg >= lcg_delay_budget_ms.size()) {
+      continue;
+    }
+    if (lcg_delay_budget_ms[lcg] == 0 or budget_ms < lcg_delay_budget_ms[lcg]) {
+      lcg_delay_budget_ms[lcg] = budget_ms;
+    }
   }
 
   return SRSRAN_SUCCESS;
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/test_common.h"
+#include <random>
+
+uint32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+
+namespace srsenb {
+
+std::default_random_engine rand_gen;
+
+/// Full buffer UEs with channels of different quality, plus one UE with a low latency bearer (5QI 85)
+class sched_pf_tester : public sched_nr_base_test_bench
+{
+public:
+  sched_pf_tester(const sched_nr_interface::sched_args_t& sched_args,
+                  const std::vector<sched_nr_cell_cfg_t>& cell_params_,
+                  std::string                             test_name,
+                  uint16_t                                ll_rnti_) :
+    sched_nr_base_test_bench(sched_args, cell_params_, test_name), ll_rnti(ll_rnti_)
+  {}
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& enb_ctxt, srsran::const_span<cc_result_t> cc_out) override
+  {
+    for (auto& cc : cc_out) {
+      for (auto& pdsch : cc.res.dl->phy.pdsch) {
+        if (pdsch.sch.grant.rnti_type != srsran_rnti_type_c) {
+          continue;
+        }
+        uint16_t rnti = pdsch.sch.grant.rnti;
+        if (measure_start.valid() and get_slot_tx() >= measure_start) {
+          dl_bytes[rnti] += pdsch.sch.grant.tb[0].tbs / 8u;
+        }
+        if (rnti == ll_rnti and ll_arrival.valid()) {
+          ll_max_delay = std::max(ll_max_delay, get_slot_tx() - ll_arrival);
+          ll_arrival.clear();
+        }
+      }
+    }
+  }
+
+  void set_external_slot_events(const sim_nr_ue_ctxt_t& ue_ctxt, ue_nr_slot_events& pending_events) override
+  {
+    for (auto& cc_events : pending_events.cc_list) {
+      // The CQI of each UE varies around its mean, so that there is multi-user diversity to exploit
+      if (cc_events.cqi >= 0) {
+        int mean_cqi  = mean_cqis.count(ue_ctxt.rnti) > 0 ? mean_cqis[ue_ctxt.rnti] : 15;
+        cc_events.cqi = std::max(1, std::min(15, mean_cqi + std::uniform_int_distribution<int>{-3, 3}(rand_gen)));
+      }
+    }
+  }
+
+  void add_ll_packet(uint32_t lcid, uint32_t pdu_size)
+  {
+    add_rlc_dl_bytes(ll_rnti, lcid, pdu_size);
+    if (not ll_arrival.valid()) {
+      ll_arrival = get_slot_tx();
+    }
+  }
+
+  /// Jain's fairness index of the DL throughput of the full buffer UEs
+  double fairness_index() const
+  {
+    double sum = 0, sum_sq = 0;
+    for (auto& u : dl_bytes) {
+      if (u.first != ll_rnti) {
+        sum += u.second;
+        sum_sq += (double)u.second * u.second;
+      }
+    }
+    return sum_sq > 0 ? sum * sum / ((dl_bytes.size() - (dl_bytes.count(ll_rnti) > 0 ? 1 : 0)) * sum_sq) : 0;
+  }
+
+  double cell_throughput_mbps(uint32_t nof_slots) const
+  {
+    uint64_t tot_bytes = 0;
+    for (auto& u : dl_bytes) {
+      tot_bytes += u.second;
+    }
+    // 15 kHz SCS, so one slot per msec
+    return tot_bytes * 8 / (nof_slots * 1000.0);
+  }
+
+  std::map<uint16_t, int>      mean_cqis;
+  std::map<uint16_t, uint64_t> dl_bytes;
+  slot_point                   measure_start;
+  uint16_t                     ll_rnti;
+  slot_point                   ll_arrival;
+  int                          ll_max_delay = 0;
+};
+
+struct sched_pf_results_t {
+  double throughput_mbps = 0;
+  double fairness        = 0;
+  int    ll_max_delay    = 0;
+};
+
+sched_pf_results_t run_sched_nr_policy(const std::string& policy)
+{
+  const uint32_t nof_ues = 4, max_nof_ttis = 3000, measure_start_tti = 500, ll_period = 20, ll_pdu_size = 100;
+  const uint32_t ll_lcid = 5;
+  const uint16_t ll_rnti = 0x4601 + nof_ues;
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer                     = false;
+  cfg.fixed_dl_mcs                           = -1;
+  cfg.sched_policy                           = policy;
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(1);
+
+  std::string     test_name = "Test " + policy + " policy";
+  sched_pf_tester tester(cfg, cells_cfg, test_name, ll_rnti);
+
+  const int mean_cqis[nof_ues] = {4, 8, 11, 14};
+  for (uint32_t nof_slots = 0; nof_slots < max_nof_ttis; ++nof_slots) {
+    slot_point slot_rx(0, nof_slots % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+
+    if (nof_slots % 20 == 9 and nof_slots < 20 * (nof_ues + 1)) {
+      // PRACHs are spaced to fit their RARs in the window
+      tester.rach_ind(0x4601 + nof_slots / 20, 0, slot_rx, 0);
+    } else if (nof_slots == 150) {
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        uint16_t                     rnti  = 0x4601 + i;
+        sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(1);
+        uecfg.lc_ch_to_add.emplace_back();
+        uecfg.lc_ch_to_add.back().lcid          = 4;
+        uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+        uecfg.lc_ch_to_add.back().cfg.group     = 1;
+        uecfg.lc_ch_to_add.back().five_qi       = 9;
+        tester.user_cfg(rnti, uecfg);
+        tester.mean_cqis[rnti] = mean_cqis[i];
+      }
+      sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(1);
+      uecfg.lc_ch_to_add.emplace_back();
+      uecfg.lc_ch_to_add.back().lcid          = ll_lcid;
+      uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+      uecfg.lc_ch_to_add.back().cfg.group     = 2;
+      uecfg.lc_ch_to_add.back().five_qi       = 85;
+      tester.user_cfg(ll_rnti, uecfg);
+    } else if (nof_slots == 160) {
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        tester.add_rlc_dl_bytes(0x4601 + i, 4, 100000000);
+      }
+    } else if (nof_slots == measure_start_tti) {
+      tester.measure_start = slot_tx;
+    }
+    if (nof_slots >= measure_start_tti and nof_slots % ll_period == 0) {
+      tester.add_ll_packet(ll_lcid, ll_pdu_size);
+    }
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+
+  sched_pf_results_t results;
+  results.throughput_mbps = tester.cell_throughput_mbps(max_nof_ttis - measure_start_tti);
+  results.fairness        = tester.fairness_index();
+  results.ll_max_delay    = tester.ll_max_delay;
+  fmt::print("{} policy: cell DL throughput={:.2f} Mbps, fairness index={:.3f}, 5QI 85 max delay={} slots\n",
+             policy,
+             results.throughput_mbps,
+             results.fairness,
+             results.ll_max_delay);
+  for (auto& u : tester.dl_bytes) {
+    fmt::print("  0x{:x}: DL bytes={}\n", u.first, u.second);
+  }
+  return results;
+}
+
+void test_sched_nr_time_pf()
+{
+  rand_gen.seed(seed);
+  sched_pf_results_t rr = run_sched_nr_policy("time_rr");
+  rand_gen.seed(seed);
+  sched_pf_results_t pf = run_sched_nr_policy("time_pf");
+
+  TESTASSERT(rr.throughput_mbps > 0 and pf.throughput_mbps > 0);
+  // All the full buffer UEs get a share of the resources
+  TESTASSERT(pf.fairness > 0.5);
+  // Serving the UEs on their channel peaks does not cost cell throughput
+  TESTASSERT(pf.throughput_mbps >= 0.9 * rr.throughput_mbps);
+  // The low latency bearer is served within its delay budget of 5 msec
+  TESTASSERT(pf.ll_max_delay <= 5);
+}
+
+} // namespace srsenb
+
+int main()
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::error);
+
+  // Start the log backend.
+  srslog::init();
+
+  printf("Test random seed=%u\n\n", seed);
+
+  srsenb::test_sched_nr_time_pf();
+}
@@ -52,8 +52,11 @@ ue_nr::~ue_nr() {}
 void ue_nr::reset()
 {
   {
+    // Restart the metrics period from the current counters
+    metrics_counters_t total = {};
+    metrics_merge(total);
     std::lock_guard<std::mutex> lock(metrics_mutex);
-    ue_metrics = {};
+    last_metrics = total;
   }
   nof_failures = 0;
 }
@@ -161,32 +164,66 @@ int ue_nr::generate_pdu(srsran::byte_buffer_t* pdu, uint32_t grant_size, srsran:
 }
 
 /******* METRICS interface ***************/
+void ue_nr::metrics_merge(metrics_counters_t& total) const
+{
+  // The shards are read while being updated, so the counters of a period may lag by the updates in flight
+  for (const metrics_shard_t& shard : metrics_shards) {
+    for (uint32_t i = 0; i < nof_metrics_counters; ++i) {
+      total[i] += shard.counters[i].load(std::memory_order_relaxed);
+    }
+  }
+}
+
 void ue_nr::metrics_read(mac_ue_metrics_t* metrics_)
 {
   uint32_t ul_buffer = 0; // sched->get_ul_buffer(rnti);
   uint32_t dl_buffer = 0; // sched->get_dl_buffer(rnti);
 
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.rnti      = rnti;
-  ue_metrics.ul_buffer = ul_buffer;
-  ue_metrics.dl_buffer = dl_buffer;
+  metrics_counters_t total = {};
+  metrics_merge(total);
+
+  // Counters of the period since the previous read
+  metrics_counters_t period = {};
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    for (uint32_t i = 0; i < nof_metrics_counters; ++i) {
+      period[i] = total[i] - last_metrics[i];
+    }
+    last_metrics = total;
+  }
+  auto avg = [&period](metrics_counter_t sum, metrics_counter_t samples, float scale) {
+    return period[samples] > 0 ? (int64_t)period[sum] * scale / period[samples] : 0.0f;
+  };
+
+  mac_ue_metrics_t ue_metrics = {};
+  ue_metrics.rnti             = rnti;
+  ue_metrics.ul_buffer        = ul_buffer;
+  ue_metrics.dl_buffer        = dl_buffer;
 
   // set PCell sector id
   // TODO: use ue_cfg when multiple NR carriers are supported
   ue_metrics.cc_idx = 0;
 
-  *metrics_            = ue_metrics;
-  phr_counter          = 0;
-  dl_cqi_valid_counter = 0;
-  pucch_sinr_counter   = 0;
-  pusch_sinr_counter   = 0;
-  ue_metrics           = {};
+  ue_metrics.nof_tti        = period[nof_tti];
+  ue_metrics.tx_pkts        = period[tx_pkts];
+  ue_metrics.tx_errors      = period[tx_errors];
+  ue_metrics.tx_brate       = period[tx_bits];
+  ue_metrics.rx_pkts        = period[rx_pkts];
+  ue_metrics.rx_errors      = period[rx_errors];
+  ue_metrics.rx_brate       = period[rx_bits];
+  ue_metrics.dl_cqi         = avg(dl_cqi_sum, dl_cqi_samples, 1.0f);
+  ue_metrics.dl_mcs         = avg(dl_mcs_sum, dl_mcs_samples, 1.0f);
+  ue_metrics.dl_mcs_samples = period[dl_mcs_samples];
+  ue_metrics.ul_mcs         = avg(ul_mcs_sum, ul_mcs_samples, 1.0f);
+  ue_metrics.ul_mcs_samples = period[ul_mcs_samples];
+  ue_metrics.pucch_sinr     = avg(pucch_sinr_sum, pucch_sinr_samples, 1e-3f);
+  ue_metrics.pusch_sinr     = avg(pusch_sinr_sum, pusch_sinr_samples, 1e-3f);
+
+  *metrics_ = ue_metrics;
 }
 
 void ue_nr::metrics_dl_cqi(const srsran_uci_cfg_nr_t& cfg_, uint32_t dl_cqi)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-
   // Process CQI
   for (uint32_t i = 0; i < cfg_.nof_csi; i++) {
     // Skip if invalid or not supported CSI report
@@ -196,70 +233,64 @@ void ue_nr::metrics_dl_cqi(const srsran_uci_cfg_nr_t& cfg_, uint32_t dl_cqi)
     }
 
     // Add statistics
-    ue_metrics.dl_cqi = SRSRAN_VEC_SAFE_CMA(dl_cqi, ue_metrics.dl_cqi, dl_cqi_valid_counter);
-    dl_cqi_valid_counter++;
+    metrics_add(dl_cqi_sum, dl_cqi);
+    metrics_add(dl_cqi_samples, 1);
   }
 }
 
 void ue_nr::metrics_rx(bool crc, uint32_t tbs)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
   if (crc) {
-    ue_metrics.rx_brate += tbs * 8;
+    metrics_add(rx_bits, tbs * 8);
   } else {
-    ue_metrics.rx_errors++;
+    metrics_add(rx_errors, 1);
   }
-  ue_metrics.rx_pkts++;
+  metrics_add(rx_pkts, 1);
 }
 
 void ue_nr::metrics_tx(bool crc, uint32_t tbs)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
   if (crc) {
-    ue_metrics.tx_brate += tbs * 8;
+    metrics_add(tx_bits, tbs * 8);
   } else {
-    ue_metrics.tx_errors++;
+    metrics_add(tx_errors, 1);
   }
-  ue_metrics.tx_pkts++;
+  metrics_add(tx_pkts, 1);
 }
 
 void ue_nr::metrics_dl_mcs(uint32_t mcs)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.dl_mcs = SRSRAN_VEC_CMA((float)mcs, ue_metrics.dl_mcs, ue_metrics.dl_mcs_samples);
-  ue_metrics.dl_mcs_samples++;
+  metrics_add(dl_mcs_sum, mcs);
+  metrics_add(dl_mcs_samples, 1);
 }
 
 void ue_nr::metrics_ul_mcs(uint32_t mcs)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.ul_mcs = SRSRAN_VEC_CMA((float)mcs, ue_metrics.ul_mcs, ue_metrics.ul_mcs_samples);
-  ue_metrics.ul_mcs_samples++;
+  metrics_add(ul_mcs_sum, mcs);
+  metrics_add(ul_mcs_samples, 1);
 }
 
 void ue_nr::metrics_cnt()
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.nof_tti++;
+  metrics_add(nof_tti, 1);
 }
 
 void ue_nr::metrics_pucch_sinr(float sinr)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
   // discard nan or inf values for average SINR
   if (!std::isinf(sinr) && !std::isnan(sinr)) {
-    ue_metrics.pucch_sinr = SRSRAN_VEC_SAFE_CMA((float)sinr, ue_metrics.pucch_sinr, pucch_sinr_counter);
-    pucch_sinr_counter++;
+    // Negative values wrap around the unsigned counter, and back when the sum is read as signed
+    metrics_add(pucch_sinr_sum, (uint64_t)std::lround(sinr * 1000));
+    metrics_add(pucch_sinr_samples, 1);
   }
 }
 
 void ue_nr::metrics_pusch_sinr(float sinr)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
   // discard nan or inf values for average SINR
   if (!std::isinf(sinr) && !std::isnan(sinr)) {
-    ue_metrics.pusch_sinr = SRSRAN_VEC_SAFE_CMA((float)sinr, ue_metrics.pusch_sinr, pusch_sinr_counter);
-    pusch_sinr_counter++;
+    metrics_add(pusch_sinr_sum, (uint64_t)std::lround(sinr * 1000));
+    metrics_add(pusch_sinr_samples, 1);
   }
 }
 
@@ -402,6 +402,13 @@ bool ngap::handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_ngap(pdu->msg, pdu->N_bytes);
   }
 
+  // UE-associated messages with unknown or inconsistent UE NGAP IDs are discarded before the full decode
+  asn1::ap_pdu_view pdu_view;
+  if (pdu_view.unpack(pdu->msg, pdu->N_bytes) == asn1::SRSASN_SUCCESS and not check_ue_ngap_ids(pdu_view)) {
+    logger.info(pdu->msg, pdu->N_bytes, "Rx - Discarded (procedure code=%d)", pdu_view.proc_code());
+    return false;
+  }
+
   // Unpack
   ngap_pdu_c     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
@@ -783,6 +790,47 @@ bool ngap::sctp_send_ngap_pdu(const asn1::ngap::ngap_pdu_c& tx_pdu, uint32_t rnt
   return true;
 }
 
+/**
+ * Helper method to check the UE NGAP IDs of a received UE-associated message before it is fully decoded. Only the ID
+ * IEs are decoded, and the same checks as in handle_ngapmsg_ue_id() apply.
+ * @param msg lazily decoded NGAP PDU
+ * @return false if the IDs do not identify a UE, in which case the message has been handled and must be discarded
+ */
+bool ngap::check_ue_ngap_ids(const asn1::ap_pdu_view& msg)
+{
+  if (msg.pdu_type() != ngap_pdu_c::types_opts::init_msg) {
+    return true;
+  }
+  switch (msg.proc_code()) {
+    case ASN1_NGAP_ID_DL_NAS_TRANSPORT:
+    case ASN1_NGAP_ID_INIT_CONTEXT_SETUP:
+    case ASN1_NGAP_ID_PDU_SESSION_RES_SETUP:
+      break;
+    case ASN1_NGAP_ID_UE_CONTEXT_RELEASE: {
+      ue_ngap_ids_c ue_ngap_ids;
+      if (msg.unpack_ie(ASN1_NGAP_ID_UE_NGAP_IDS, ue_ngap_ids) != asn1::SRSASN_SUCCESS) {
+        return true;
+      }
+      if (ue_ngap_ids.type().value == ue_ngap_ids_c::types_opts::ue_ngap_id_pair) {
+        const ue_ngap_id_pair_s& idpair = ue_ngap_ids.ue_ngap_id_pair();
+        return handle_ngapmsg_ue_id(idpair.ran_ue_ngap_id, idpair.amf_ue_ngap_id) != nullptr;
+      }
+      return true;
+    }
+    default:
+      return true;
+  }
+
+  // Malformed ID IEs are reported by the full decode
+  amf_ue_ngap_id_t amf_ue_ngap_id;
+  ran_ue_ngap_id_t ran_ue_ngap_id;
+  if (msg.unpack_ie(ASN1_NGAP_ID_AMF_UE_NGAP_ID, amf_ue_ngap_id) != asn1::SRSASN_SUCCESS or
+      msg.unpack_ie(ASN1_NGAP_ID_RAN_UE_NGAP_ID, ran_ue_ngap_id) != asn1::SRSASN_SUCCESS) {
+    return true;
+  }
+  return handle_ngapmsg_ue_id(ran_ue_ngap_id.value, amf_ue_ngap_id.value) != nullptr;
+}
+
 /**
  * Helper method to find user based on the ran_ue_ngap_id stored in an S1AP Msg, and update amf_ue_ngap_id
  * @param gnb_id ran_ue_ngap_id value stored in NGAP message
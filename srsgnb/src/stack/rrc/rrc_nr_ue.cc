@@ -708,6 +708,7 @@ void rrc_nr::ue::crnti_ce_received()
       uecfg.lc_ch_to_add.back().lcid          = drb.lc_ch_id;
       uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
       uecfg.lc_ch_to_add.back().cfg.group     = drb.mac_lc_ch_cfg.ul_specific_params.lc_ch_group;
+      uecfg.lc_ch_to_add.back().five_qi       = drb.lc_ch_id == drb1_lcid ? drb1_five_qi : 0;
     }
 
     // Update UE phy params
@@ -741,6 +742,7 @@ int rrc_nr::ue::add_drb(uint32_t five_qi)
     parent->logger.error("No bearer config for 5QI %d present. Aborting DRB addition.", five_qi);
     return SRSRAN_ERROR;
   }
+  drb1_five_qi = five_qi;
 
   // RLC for DRB1 (with fixed LCID) inside cell_group_cfg
   auto& cell_group_cfg_pack = cell_group_cfg;
@@ -1500,6 +1502,9 @@ int rrc_nr::ue::update_mac(const cell_group_cfg_s& cell_group_config, bool is_co
         lch.group    = bearer.mac_lc_ch_cfg.ul_specific_params.lc_ch_group;
         // TODO: remaining fields
       }
+      if (bearer.lc_ch_id == drb1_lcid) {
+        uecfg.lc_ch_to_add.back().five_qi = drb1_five_qi;
+      }
     }
 
     if (cell_group_config.sp_cell_cfg_present and cell_group_config.sp_cell_cfg.sp_cell_cfg_ded_present and
@@ -24,6 +24,7 @@
 
 #include "srsran/srsran.h"
 #include <array>
+#include <vector>
 
 namespace srsue {
 
@@ -42,17 +43,19 @@ struct info_metrics_t {
 struct sync_metrics_t {
   typedef std::array<sync_metrics_t, SRSRAN_MAX_CARRIERS> array_t;
 
-  float ta_us       = 0.0;
-  float distance_km = 0.0;
-  float speed_kmph  = 0.0;
-  float cfo         = 0.0;
-  float sfo         = 0.0;
+  float ta_us         = 0.0;
+  float distance_km   = 0.0;
+  float speed_kmph    = 0.0;
+  float cfo           = 0.0;
+  float sfo           = 0.0;
+  float intra_meas_ms = 0.0; ///< Duration of the last intra-frequency neighbour cell measurement, in milliseconds
 
   void set(const sync_metrics_t& other)
   {
-    ta_us       = other.ta_us;
-    distance_km = other.distance_km;
-    speed_kmph  = other.speed_kmph;
+    ta_us         = other.ta_us;
+    distance_km   = other.distance_km;
+    speed_kmph    = other.speed_kmph;
+    intra_meas_ms = other.intra_meas_ms;
     PHY_METRICS_SET(cfo);
     PHY_METRICS_SET(sfo);
     count++;
@@ -60,12 +63,13 @@ struct sync_metrics_t {
 
   void reset()
   {
-    count       = 0;
-    ta_us       = 0.0f;
-    distance_km = 0.0f;
-    speed_kmph  = 0.0f;
-    cfo         = 0.0f;
-    sfo         = 0.0f;
+    count         = 0;
+    ta_us         = 0.0f;
+    distance_km   = 0.0f;
+    speed_kmph    = 0.0f;
+    cfo           = 0.0f;
+    sfo           = 0.0f;
+    intra_meas_ms = 0.0f;
   }
 
 private:
@@ -123,6 +127,7 @@ struct dl_metrics_t {
   float fec_iters = 0.0;
   float mcs       = 0.0;
   float evm       = 0.0;
+  float pdcch_us  = 0.0; ///< Time spent decoding PDCCH candidates in the subframe, in microseconds
 
   void set(const dl_metrics_t& other)
   {
@@ -132,16 +137,26 @@ struct dl_metrics_t {
     PHY_METRICS_SET(evm);
   }
 
+  /// Averages the PDCCH decoding time over the subframes with a DCI search, with or without PDSCH
+  void set_pdcch(float pdcch_us_)
+  {
+    pdcch_count++;
+    pdcch_us = SRSRAN_VEC_SAFE_CMA(pdcch_us_, pdcch_us, pdcch_count);
+  }
+
   void reset()
   {
-    count     = 0;
-    fec_iters = 0.0f;
-    mcs       = 0.0f;
-    evm       = 0.0f;
+    count       = 0;
+    pdcch_count = 0;
+    fec_iters   = 0.0f;
+    mcs         = 0.0f;
+    evm         = 0.0f;
+    pdcch_us    = 0.0f;
   }
 
 private:
-  uint32_t count = 0;
+  uint32_t count       = 0;
+  uint32_t pdcch_count = 0;
 };
 
 struct ul_metrics_t {
@@ -170,13 +185,22 @@ private:
 
 #undef PHY_METRICS_SET
 
+/// Duration of the last cell search in a band
+struct cell_search_metrics_t {
+  uint32_t band       = 0;
+  uint32_t nof_earfcn = 0;     ///< Number of EARFCN searched
+  float    search_ms  = 0.0;   ///< Time spent searching the EARFCN of the band, in milliseconds
+  bool     wideband   = false; ///< The PSS/SSS were searched in wideband captures
+};
+
 struct phy_metrics_t {
-  info_metrics_t::array_t info          = {};
-  sync_metrics_t::array_t sync          = {};
-  ch_metrics_t::array_t   ch            = {};
-  dl_metrics_t::array_t   dl            = {};
-  ul_metrics_t::array_t   ul            = {};
-  uint32_t                nof_active_cc = 0;
+  info_metrics_t::array_t            info          = {};
+  sync_metrics_t::array_t            sync          = {};
+  ch_metrics_t::array_t              ch            = {};
+  dl_metrics_t::array_t              dl            = {};
+  ul_metrics_t::array_t              ul            = {};
+  uint32_t                           nof_active_cc = 0;
+  std::vector<cell_search_metrics_t> cell_search;
 };
 
 } // namespace srsue
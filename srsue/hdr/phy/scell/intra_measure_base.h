@@ -22,9 +22,13 @@
 #define SRSUE_INTRA_MEASURE_BASE_H
 
 #include "srsran/interfaces/ue_phy_interfaces.h"
+#include <chrono>
 #include <condition_variable>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <srsran/common/common.h>
+#include <srsran/common/thread_pool.h>
 #include <srsran/common/threads.h>
 #include <srsran/common/tti_sync_cv.h>
 #include <vector>
@@ -82,6 +86,7 @@ public:
     uint32_t tti_period        = 0;    ///< Measurement TTI trigger period, set to 0 to trigger at any TTI
     uint32_t tti_offset        = 0;    ///< Measurement TTI trigger offset
     float    rx_gain_offset_db = 0.0f; ///< Gain offset, for calibrated measurements
+    uint32_t nof_workers       = 1;    ///< Number of measurement threads, including the asynchronous thread
   };
 
   /**
@@ -122,6 +127,12 @@ public:
    */
   virtual uint32_t get_earfcn() const = 0;
 
+  /**
+   * @brief Get the time the last measurement took, from reading the buffer to reporting the cells
+   * @return The latency in milliseconds, 0 if no measurement has been done yet
+   */
+  float get_meas_latency_ms() const { return meas_latency_ms; }
+
   /**
    * @brief Synchronous wait mechanism, blocks the writer thread while it is in measure state. If the asynchronous
    * thread is too slow, use this method for stalling the writing thread and wait the asynchronous thread to clear the
@@ -165,6 +176,20 @@ protected:
    */
   ~intra_measure_base() override;
 
+  /**
+   * @brief Number of workers parallel_for() spreads the tasks across
+   */
+  uint32_t get_nof_workers() const { return nof_workers; }
+
+  /**
+   * @brief Runs task for every index in [0, nof_tasks) across the measurement workers, the calling thread included,
+   * and returns once all of them have finished. Every worker claims tasks one by one, and runs them all with the same
+   * worker index, so the task can use per-worker state without locking.
+   * @param nof_tasks Number of tasks
+   * @param task Function taking the worker index and the task index
+   */
+  void parallel_for(uint32_t nof_tasks, const std::function<void(uint32_t, uint32_t)>& task);
+
   /**
    * @brief Subframe length setter, the inherited class shall set the subframe length
    * @param new_sf_len New subframe length
@@ -311,6 +336,11 @@ private:
 
   std::vector<cf_t>   search_buffer;
   srsran_ringbuffer_t ring_buffer = {};
+
+  /// Measurement workers besides the asynchronous thread, created on demand
+  std::unique_ptr<srsran::task_thread_pool> workers;
+  std::atomic<uint32_t>                     nof_workers     = {1};
+  std::atomic<float>                        meas_latency_ms = {0.0f};
 };
 
 } // namespace scell
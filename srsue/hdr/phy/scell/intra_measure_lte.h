@@ -87,8 +87,9 @@ private:
   std::mutex            mutex;
 
   /// LTE-based measuring objects
-  scell_recv                 scell_rx;               ///< Secondary cell searcher
-  srsran_refsignal_dl_sync_t refsignal_dl_sync = {}; ///< Reference signal based measurement
+  scell_recv                              scell_rx;          ///< Secondary cell searcher
+  std::vector<srsran_refsignal_dl_sync_t> refsignal_dl_sync; ///< Reference signal based measurement, one per worker
+  srsran_refsignal_dl_sync_spectrum_t     spectrum = {};     ///< Capture spectrum, shared by all the PCI
 };
 
 } // namespace scell
@@ -52,14 +52,50 @@ public:
   ret_code run(srsran_cell_t* cell, std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& bch_payload);
   void     set_cp_en(bool enable);
 
+  /**
+   * Enables the wideband search, which detects the PSS/SSS of several carriers from a single capture
+   * @param srate_hz Capture sampling rate
+   * @param nof_threads Number of threads searching the capture
+   * @return true if the wideband search is ready, false otherwise
+   */
+  bool   init_wb(double srate_hz, uint32_t nof_threads);
+  double get_wb_srate() const { return wb_srate_hz; }
+
+  /**
+   * Captures samples at the wideband sampling rate and detects the PSS/SSS of each carrier. The radio must be tuned to
+   * the capture centre frequency and sampling rate.
+   * @param freq_offset_hz Offset of each carrier from the capture centre frequency
+   * @param nof_carriers Number of carriers, up to SRSRAN_CS_WB_MAX_CARRIERS
+   * @param results PSS/SSS detection result of each carrier
+   */
+  ret_code run_wb(const double* freq_offset_hz, uint32_t nof_carriers, srsran_ue_cellsearch_wb_result_t* results);
+
+  /**
+   * Makes the next run() take the PSS/SSS detection from a wideband search result and only decode the MIB
+   */
+  void set_wb_result(const srsran_ue_cellsearch_wb_result_t& result);
+
 private:
+  /// Number of 5 ms frames in a wideband capture, the same the narrowband search scans at most
+  const static uint32_t wb_nof_frames = 8;
+
   search_callback*       p = nullptr;
   srslog::basic_logger&  logger;
-  srsran::rf_buffer_t    buffer       = {};
-  srsran_ue_cellsearch_t cs           = {};
-  srsran_ue_mib_sync_t   ue_mib_sync  = {};
-  int                    force_N_id_2 = 0;
-  int                    force_N_id_1 = 0;
+  srsran::rf_buffer_t    buffer          = {};
+  srsran_ue_cellsearch_t cs              = {};
+  srsran_ue_mib_sync_t   ue_mib_sync     = {};
+  int                    force_N_id_2    = 0;
+  int                    force_N_id_1    = 0;
+  uint32_t               nof_rx_channels = 0;
+
+  // Wideband search
+  srsran_ue_cellsearch_wb_t        cs_wb         = {};
+  double                           wb_srate_hz   = 0.0;
+  uint32_t                         wb_nsamples   = 0;
+  cf_t*                            wb_buffer     = nullptr;
+  cf_t*                            wb_scratch    = nullptr;
+  srsran_ue_cellsearch_wb_result_t wb_result     = {};
+  bool                             wb_result_set = false;
 };
 
 }; // namespace srsue
@@ -101,6 +101,7 @@ public:
 
   void     get_current_cell(srsran_cell_t* cell, uint32_t* earfcn = nullptr);
   uint32_t get_current_tti();
+  void     get_cell_search_metrics(std::vector<cell_search_metrics_t>& m);
 
   // From UE configuration
   void set_agc_enable(bool enable);
@@ -146,6 +147,15 @@ private:
    */
   void run_cell_search_state();
 
+  /**
+   * Searches the EARFCN list with wideband captures. Consecutive EARFCN of the same band that fit in the capture
+   * bandwidth are searched at once, then the MIB is decoded in the EARFCN with PSS/SSS until a cell is found.
+   */
+  void cell_search_wb();
+
+  /// Saves the duration of a cell search in a band, and logs it
+  void set_cell_search_metrics(const cell_search_metrics_t& m);
+
   /**
    * SFN synchronization using MIB. run_subframe() receives and processes 1 subframe
    * and returns
@@ -268,6 +278,15 @@ private:
 
   search::ret_code cell_search_ret = search::CELL_NOT_FOUND;
 
+  // Wideband cell search, the SYNC thread captures the carriers when wb_capture is set
+  bool                                          wb_capture = false;
+  std::vector<double>                           wb_freq_offsets;
+  std::vector<srsran_ue_cellsearch_wb_result_t> wb_results;
+
+  // Duration of the last cell search in each band
+  std::mutex                                cell_search_metrics_mutex;
+  std::map<uint32_t, cell_search_metrics_t> cell_search_metrics;
+
   // Sampling rate mode (find is 1.92 MHz, camp is the full cell BW)
   class srate_safe
   {
@@ -31,9 +31,11 @@
 #include "srsran/srslog/srslog.h"
 #include "tft_packet_filter.h"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <vector>
 
 namespace srsue {
 
@@ -47,6 +49,8 @@ struct gw_args_t {
   std::string netns;
   std::string tun_dev_name;
   std::string tun_dev_netmask;
+  uint32_t    tun_queues  = 1;     // Number of TUN queues, each one read by its own thread
+  bool        tun_offload = false; // Read TCP/UDP segmentation offload packets from the TUN and split them in the GW
 };
 
 class gw : public gw_interface_stack, public srsran::thread
@@ -76,6 +80,28 @@ public:
 private:
   static const int GW_THREAD_PRIO = -1;
 
+  // Header before every packet of a TUN with IFF_VNET_HDR, as struct virtio_net_hdr of linux/virtio_net.h
+  struct vnet_hdr_t {
+    uint8_t  flags;
+    uint8_t  gso_type;
+    uint16_t hdr_len;
+    uint16_t gso_size;
+    uint16_t csum_start;
+    uint16_t csum_offset;
+  };
+
+  // Reads the TUN queues after the first one, which is read by the GW thread
+  class tun_reader : public srsran::thread
+  {
+  public:
+    tun_reader(gw* parent_, uint32_t queue_idx_);
+
+  private:
+    void     run_thread() override;
+    gw*      parent    = nullptr;
+    uint32_t queue_idx = 0;
+  };
+
   stack_interface_gw* stack = nullptr;
 
   gw_args_t args = {};
@@ -83,7 +109,7 @@ private:
   std::atomic<bool> running    = {false};
   std::atomic<bool> run_enable = {false};
   int32_t           netns_fd   = 0;
-  int32_t           tun_fd     = 0;
+  int32_t           tun_fd     = 0; // First TUN queue, also used to write the DL packets
   struct ifreq      ifr        = {};
   int32_t           sock       = 0;
   std::atomic<bool> if_up      = {false};
@@ -101,7 +127,18 @@ private:
   uint32_t                                       dl_tput_bytes = 0;
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
+  std::vector<int32_t>                     tun_fds;
+  std::vector<std::unique_ptr<tun_reader> > tun_readers;
+
   void run_thread();
+  void read_tun_queue(uint32_t queue_idx);
+  void read_tun_packets(int32_t fd);
+  void read_tun_offload_packets(int32_t fd);
+  bool send_offload_packet(const vnet_hdr_t& vnet_hdr, uint8_t* pkt, uint32_t len);
+  bool send_ul_pdu(srsran::unique_byte_buffer_t pdu);
+  int  write_tun(srsran::unique_byte_buffer_t& pdu);
+  void stop_tun_readers();
+  void close_tun();
   int  init_if(char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
@@ -25,7 +25,10 @@
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <map>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace srsue {
 
@@ -89,9 +92,9 @@ public:
   uint8_t  ipv6_local_addr_length    = {};
   uint8_t  protocol_id               = {};
   uint16_t single_local_port         = {};
-  uint16_t local_port_range[2]       = {};
+  uint16_t local_port_range[2]       = {}; ///< Host byte order
   uint16_t single_remote_port        = {};
-  uint16_t remote_port_range[2]      = {};
+  uint16_t remote_port_range[2]      = {}; ///< Host byte order
   uint32_t security_parameter_index  = {};
   uint8_t  type_of_service           = {};
   uint8_t  type_of_service_mask      = {};
@@ -106,6 +109,69 @@ public:
   bool match_port(const srsran::unique_byte_buffer_t& pdu);
 };
 
+/**
+ * Decision structure compiled from the TFT packet filters, with the same outcome as testing the filters one by one
+ * in evaluation precedence order.
+ *
+ * The filters are grouped by the header fields they compare and the masks they compare them with. Within a group, the
+ * masked fields of the packet are looked up in a hash table, so a packet is tested against one bucket per group
+ * instead of against every filter. Port ranges and IPv6 address prefixes are checked on the filters of the bucket.
+ */
+class tft_classifier
+{
+public:
+  /// Compiles the filters, indexed by evaluation precedence
+  void compile(const std::map<uint16_t, tft_packet_filter_t>& filters);
+  void clear();
+
+  /**
+   * Finds the matching filter with the lowest evaluation precedence
+   * @return true if a filter matches, false otherwise or if the PDU is neither IPv4 nor IPv6
+   */
+  bool classify(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id) const;
+
+private:
+  // Local and remote IPv4 addresses in the first word. Ports, protocol, TOS and whether it is TCP or UDP in the second
+  struct key_t {
+    uint64_t w[2];
+    bool     operator==(const key_t& other) const { return w[0] == other.w[0] && w[1] == other.w[1]; }
+  };
+  struct key_hash {
+    size_t operator()(const key_t& k) const { return std::hash<uint64_t>{}(k.w[0] ^ (k.w[1] * 0x9e3779b97f4a7c15ULL)); }
+  };
+
+  // The components of a filter that are not compared through the hash table
+  struct rule_t {
+    uint16_t eval_precedence;
+    uint8_t  eps_bearer_id;
+    bool     has_local_port_range;
+    bool     has_remote_port_range;
+    bool     has_ipv6_remote_addr;
+    uint16_t local_port_range[2];
+    uint16_t remote_port_range[2];
+    uint8_t  ipv6_remote_addr[16]; ///< Already masked
+    uint8_t  ipv6_remote_addr_mask[16];
+  };
+
+  struct table_t {
+    key_t                                                      mask;
+    uint16_t                                                   min_precedence;
+    std::unordered_map<key_t, std::vector<uint32_t>, key_hash> buckets; ///< Rules in evaluation precedence order
+  };
+
+  // Filters compiled for the packets of one IP version
+  struct ip_version_tables_t {
+    std::vector<rule_t>  rules;
+    std::vector<table_t> tables; ///< Sorted by lowest evaluation precedence
+  };
+
+  static void compile_filter(const tft_packet_filter_t& filter, uint8_t ip_version, ip_version_tables_t& dest);
+  static bool match_rule(const rule_t& rule, uint16_t local_port, uint16_t remote_port, const uint8_t* ipv6_daddr);
+
+  ip_version_tables_t ipv4;
+  ip_version_tables_t ipv6;
+};
+
 /**
  * TFT PDU matcher class used by GW and TTCN3 DUT testloop handler
  */
@@ -123,10 +189,13 @@ public:
   void    delete_tft_for_eps_bearer(const uint8_t eps_bearer_id);
 
 private:
+  int update_tft_filter_map(const uint8_t& eps_bearer_id, const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft);
+
   srslog::basic_logger&                           logger;
   std::mutex                                      tft_mutex;
   typedef std::map<uint16_t, tft_packet_filter_t> tft_filter_map_t;
   tft_filter_map_t                                tft_filter_map;
+  tft_classifier                                  classifier; ///< Compiled from tft_filter_map on every change
 };
 
 } // namespace srsue
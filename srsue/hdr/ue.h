@@ -75,6 +75,7 @@ typedef struct {
   bool        tracing_enable;
   std::string tracing_filename;
   std::size_t tracing_buffcapacity;
+  std::string thread_placement;
 } general_args_t;
 
 typedef struct {
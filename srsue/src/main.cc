@@ -24,6 +24,8 @@
 #include "srsran/common/crash_handler.h"
 #include "srsran/common/metrics_hub.h"
 #include "srsran/common/multiqueue.h"
+#include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/common/tsan_options.h"
 #include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
@@ -104,6 +106,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.device_args", bpo::value<string>(&args->rf.device_args)->default_value("auto"), "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
     ("rf.continuous_tx", bpo::value<string>(&args->rf.continuous_tx)->default_value("auto"), "Transmit samples continuously to the radio or on bursts (auto/yes/no). Default is auto (yes for UHD, no for rest)")
+    ("rf.resampler",     bpo::value<string>(&args->rf.resampler)->default_value("fft"), "Resampler used when the fixed sampling rate differs from the cell rate (fft/poly). The polyphase resampler supports fractional ratios")
 
     ("rf.bands.rx[0].min", bpo::value<float>(&args->rf.ch_rx_bands[0].min)->default_value(0), "Lower frequency boundary for CH0-RX")
     ("rf.bands.rx[0].max", bpo::value<float>(&args->rf.ch_rx_bands[0].max)->default_value(0), "Higher frequency boundary for CH0-RX")
@@ -208,6 +211,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("gw.netns", bpo::value<string>(&args->gw.netns)->default_value(""), "Network namespace to for TUN device (empty for default netns)")
     ("gw.ip_devname", bpo::value<string>(&args->gw.tun_dev_name)->default_value("tun_srsue"), "Name of the tun_srsue device")
     ("gw.ip_netmask", bpo::value<string>(&args->gw.tun_dev_netmask)->default_value("255.255.255.0"), "Netmask of the tun_srsue device")
+    ("gw.tun_queues", bpo::value<uint32_t>(&args->gw.tun_queues)->default_value(1), "Number of queues of the tun_srsue device, each one read by its own thread")
+    ("gw.tun_offload", bpo::value<bool>(&args->gw.tun_offload)->default_value(false), "Read TCP/UDP packets of up to 64 KB from the tun_srsue device and split them in the GW")
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
@@ -322,6 +327,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
        bpo::value<uint32_t>(&args->phy.intra_freq_meas_period_ms)->default_value(200),
        "Period of intra-frequency neighbour cell measurement in ms. Maximum as per 3GPP is 200 ms.")
 
+    ("phy.intra_freq_meas_nof_workers",
+       bpo::value<uint32_t>(&args->phy.intra_freq_meas_nof_workers)->default_value(1),
+       "Number of threads measuring intra-frequency neighbour cells in parallel, for each carrier.")
+
     ("phy.correct_sync_error",
        bpo::value<bool>(&args->phy.correct_sync_error)->default_value(false),
        "Channel estimator measures and pre-compensates time synchronization error. Increases CPU usage, improves PDSCH "
@@ -401,6 +410,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
        bpo::value<bool>(&args->phy.pdsch_8bit_decoder)->default_value(false),
        "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental)")
 
+    ("phy.pdcch_llr_threshold",
+       bpo::value<float>(&args->phy.pdcch_llr_threshold)->default_value(SRSRAN_PDCCH_DEFAULT_LLR_THRESHOLD),
+       "Minimum absolute mean of the LLRs of a PDCCH candidate for it to be decoded, weaker candidates are skipped")
+
     ("phy.force_ul_amplitude",
        bpo::value<float>(&args->phy.force_ul_amplitude)->default_value(0.0),
        "Forces the peak amplitude in the PUCCH, PUSCH and SRS (set 0.0 to 1.0, set to 0 or negative for disabling)")
@@ -437,6 +450,14 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<int>(&args->phy.force_N_id_1)->default_value(-1),
      "Force using a specific SSS (set to -1 to allow all SSSs).")
 
+    ("phy.cell_search_wb_srate",
+     bpo::value<float>(&args->phy.cell_search_wb_srate)->default_value(0.0f),
+     "Sampling rate of the wideband cell search, which searches several EARFCN at once (set to 0 to search each EARFCN).")
+
+    ("phy.cell_search_wb_nof_threads",
+     bpo::value<uint32_t>(&args->phy.cell_search_wb_nof_threads)->default_value(1),
+     "Number of threads of the wideband cell search.")
+
     // PHY NR args
     ("phy.nr.store_pdsch_ko",
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
@@ -492,6 +513,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
            bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000),
            "Tracing buffer capcity")
 
+    ("general.thread_placement",
+           bpo::value<string>(&args->general.thread_placement)->default_value(""),
+           "CPU placement of the threads by role, as a list of role:rule[@node] (core, cpu, node, any or a CPU list), or auto. Empty for no placement.")
+
     ("stack.have_tti_time_stats",
         bpo::value<bool>(&args->stack.have_tti_time_stats)->default_value(true),
         "Calculate TTI execution statistics")
@@ -749,8 +774,26 @@ int main(int argc, char* argv[])
   }
 #endif
 
+  // Place the threads on the CPUs before any of them is created
+  if (not args.general.thread_placement.empty()) {
+    srsran::thread_placement&       placement   = srsran::get_thread_placement();
+    std::map<std::string, uint32_t> nof_threads = {{"sync", 1},
+                                                   {"phy", args.phy.nof_phy_threads},
+                                                   {"phy_nr", args.phy.nof_phy_threads},
+                                                   {"stack", 1},
+                                                   {"gw", args.gw.tun_queues},
+                                                   {"log", 1}};
+    if (not placement.init(args.general.thread_placement, srsran::cpu_topology::discover(), nof_threads)) {
+      return SRSRAN_ERROR;
+    }
+    srsran::console("%s", placement.to_string().c_str());
+  }
+
   // Start the log backend.
-  srslog::init();
+  {
+    srsran::scoped_thread_affinity log_affinity("log");
+    srslog::init();
+  }
 
   srslog::fetch_basic_logger("ALL").set_level(srslog::basic_levels::warning);
   srsran::log_args(argc, argv, "UE");
@@ -56,10 +56,12 @@ DECLARE_METRIC("pathloss", metric_pathloss, float, "");
 DECLARE_METRIC("cfo", metric_cfo, float, "");
 DECLARE_METRIC("dl_snr", metric_dl_snr, float, "");
 DECLARE_METRIC("dl_mcs", metric_dl_mcs, float, "");
+DECLARE_METRIC("dl_pdcch_us", metric_dl_pdcch_us, float, "");
 DECLARE_METRIC("ul_mcs", metric_ul_mcs, float, "");
 DECLARE_METRIC("ul_ta", metric_ul_ta, float, "");
 DECLARE_METRIC("distance_km", metric_distance_km, float, "");
 DECLARE_METRIC("speed_kmph", metric_speed_kmph, float, "");
+DECLARE_METRIC("intra_meas_ms", metric_intra_meas_ms, float, "");
 DECLARE_METRIC_SET("carrier_container",
                    mset_carrier_container,
                    metric_earfcn,
@@ -69,10 +71,12 @@ DECLARE_METRIC_SET("carrier_container",
                    metric_cfo,
                    metric_dl_snr,
                    metric_dl_mcs,
+                   metric_dl_pdcch_us,
                    metric_ul_mcs,
                    metric_ul_ta,
                    metric_distance_km,
                    metric_speed_kmph,
+                   metric_intra_meas_ms,
                    mset_mac_container);
 DECLARE_METRIC_LIST("carrier_list", mlist_carriers, std::vector<mset_carrier_container>);
 
@@ -87,6 +91,19 @@ DECLARE_METRIC_SET("rrc_container", mset_rrc_container, metric_rrc_state);
 DECLARE_METRIC_SET("neighbour_cell_container", mset_neighbour_cell_container, metric_pci, metric_rsrp, metric_cfo);
 DECLARE_METRIC_LIST("neighbour_cell_list", mlist_neighbours, std::vector<mset_neighbour_cell_container>);
 
+/// Cell search list, one entry per band.
+DECLARE_METRIC("band", metric_band, uint32_t, "");
+DECLARE_METRIC("nof_earfcn", metric_nof_earfcn, uint32_t, "");
+DECLARE_METRIC("search_ms", metric_search_ms, float, "");
+DECLARE_METRIC("mode", metric_search_mode, std::string, "");
+DECLARE_METRIC_SET("cell_search_container",
+                   mset_cell_search_container,
+                   metric_band,
+                   metric_nof_earfcn,
+                   metric_search_ms,
+                   metric_search_mode);
+DECLARE_METRIC_LIST("cell_search_list", mlist_cell_search, std::vector<mset_cell_search_container>);
+
 /// NAS container.
 DECLARE_METRIC("emm_state", metric_emm_state, std::string, "");
 DECLARE_METRIC_SET("nas_container", mset_nas_container, metric_emm_state);
@@ -132,6 +149,7 @@ using metric_context_t = srslog::build_context_type<metric_type_tag,
                                                     mset_gw_container,
                                                     mset_rrc_container,
                                                     mlist_neighbours,
+                                                    mlist_cell_search,
                                                     mset_nas_container,
                                                     mset_rf_container,
                                                     mset_sys_mem_container,
@@ -179,10 +197,12 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
 
     carrier.write<metric_dl_snr>(metrics.phy.ch[i].sinr);
     carrier.write<metric_dl_mcs>(metrics.phy.dl[i].mcs);
+    carrier.write<metric_dl_pdcch_us>(metrics.phy.dl[i].pdcch_us);
     carrier.write<metric_ul_mcs>(metrics.phy.ul[i].mcs);
     carrier.write<metric_ul_ta>(metrics.phy.sync[i].ta_us);
     carrier.write<metric_distance_km>(metrics.phy.sync[i].distance_km);
     carrier.write<metric_speed_kmph>(metrics.phy.sync[i].speed_kmph);
+    carrier.write<metric_intra_meas_ms>(metrics.phy.sync[i].intra_meas_ms);
 
     // MAC
     carrier.get<mset_mac_container>().write<metric_dl_brate>(metrics.stack.mac[i].rx_brate /
@@ -215,6 +235,17 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     neigbour.write<metric_cfo>(metrics.stack.rrc.neighbour_cells[i].cfo_hz);
   }
 
+  // Fill cell search list.
+  auto& cell_search_list = ctx.get<mlist_cell_search>();
+  cell_search_list.resize(metrics.phy.cell_search.size());
+  for (uint32_t i = 0, e = cell_search_list.size(); i != e; ++i) {
+    auto& cell_search = cell_search_list[i];
+    cell_search.write<metric_band>(metrics.phy.cell_search[i].band);
+    cell_search.write<metric_nof_earfcn>(metrics.phy.cell_search[i].nof_earfcn);
+    cell_search.write<metric_search_ms>(metrics.phy.cell_search[i].search_ms);
+    cell_search.write<metric_search_mode>(metrics.phy.cell_search[i].wideband ? "wideband" : "narrowband");
+  }
+
   // Fill NAS container.
   ctx.get<mset_nas_container>().write<metric_emm_state>(emm_state_text(metrics.stack.nas.state));
 
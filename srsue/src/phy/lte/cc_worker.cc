@@ -78,6 +78,10 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
     return;
   }
 
+  // Measure the DCI blind search decoding time for the PHY metrics
+  srsran_pdcch_set_meas_time(&ue_dl.pdcch, true);
+  srsran_pdcch_set_llr_threshold(&ue_dl.pdcch, phy->args->pdcch_llr_threshold);
+
   if (srsran_ue_ul_init(&ue_ul, signal_buffer_tx[0], max_prb)) {
     Error("Initiating UE UL");
     return;
@@ -217,7 +221,9 @@ bool cc_worker::work_dl_regular()
 
   mac_interface_phy_lte::tb_action_dl_t dl_action = {};
 
-  bool found_dl_grant = false;
+  bool     found_dl_grant = false;
+  bool     pdcch_decoded  = false;
+  uint32_t pdcch_us       = 0;
 
   if (!cell_initiated) {
     logger.warning("Trying to access cc_worker=%d while cell not initialized (DL)", cc_idx);
@@ -258,9 +264,17 @@ bool cc_worker::work_dl_regular()
     if (phy->cell_state.is_active(cc_idx, sf_cfg_dl.tti) and (cc_idx != 0 or not ue_dl_cfg.cfg.dci.cif_present)) {
       found_dl_grant = decode_pdcch_dl() > 0;
       decode_pdcch_ul();
+
+      // The decoding time restarts with every LLR extraction
+      pdcch_decoded = true;
+      pdcch_us += ue_dl.pdcch.meas_time_us;
     }
   }
 
+  if (pdcch_decoded) {
+    phy->set_dl_pdcch_metrics(cc_idx, pdcch_us);
+  }
+
   srsran_dci_dl_t dci_dl       = {};
   uint32_t        grant_cc_idx = 0;
   bool            has_dl_grant = phy->get_dl_pending_grant(CURRENT_TTI, cc_idx, &grant_cc_idx, &dci_dl);
@@ -348,6 +362,7 @@ bool cc_worker::work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg)
   if (phy->cell_state.is_active(cc_idx, sf_cfg_dl.tti) and (cc_idx != 0 or not ue_dl_cfg.cfg.dci.cif_present)) {
     decode_pdcch_dl();
     decode_pdcch_ul();
+    phy->set_dl_pdcch_metrics(cc_idx, ue_dl.pdcch.meas_time_us);
   }
 
   if (mbsfn_cfg.enable) {
@@ -19,6 +19,7 @@
  *
  */
 #include "srsue/hdr/phy/lte/worker_pool.h"
+#include "srsran/common/thread_placement.h"
 
 namespace srsue {
 namespace lte {
@@ -54,14 +55,21 @@ worker_pool::worker_pool(uint32_t max_workers) :
 
 bool worker_pool::init(phy_common* common, int prio)
 {
-  // Add workers to workers pool and start threads
+  // Add workers to workers pool and start threads. Without CPU mask they follow the thread placement
+  uint32_t mask = common->args->worker_cpu_mask < 0 ? 255 : common->args->worker_cpu_mask;
+  pool.set_placement_role("phy");
   for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
     srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
     log.set_level(srslog::str_to_basic_level(common->args->log.phy_level));
     log.set_hex_dump_max_size(common->args->log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
-    pool.init_worker(i, w.get(), prio, common->args->worker_cpu_mask);
+    std::unique_ptr<lte::sf_worker> w;
+    {
+      // The sample buffers are first touched on the NUMA node of the worker
+      srsran::scoped_numa_node numa_node("phy", i);
+      w.reset(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
+    }
+    pool.init_worker(i, w.get(), prio, mask);
     workers.push_back(std::move(w));
   }
 
@@ -20,6 +20,7 @@
  */
 #include "srsue/hdr/phy/nr/worker_pool.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/thread_placement.h"
 
 namespace srsue {
 namespace nr {
@@ -54,7 +55,9 @@ bool worker_pool::init(const phy_args_nr_t& args, srsran::phy_common_interface&
     return true;
   }
 
-  // Add workers to workers pool and start threads
+  // Add workers to workers pool and start threads. Without CPU mask they follow the thread placement
+  uint32_t mask = args.worker_cpu_mask == 0 ? 255 : args.worker_cpu_mask;
+  pool.set_placement_role("phy_nr");
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i));
     log.set_level(srslog::str_to_basic_level(args.log.phy_level));
@@ -62,10 +65,12 @@ bool worker_pool::init(const phy_args_nr_t& args, srsran::phy_common_interface&
 
     sf_worker* w = nullptr;
     {
+      // The sample buffers are first touched on the NUMA node of the worker
+      srsran::scoped_numa_node    numa_node("phy_nr", i);
       std::lock_guard<std::mutex> lock(cfg_mutex);
       w = new sf_worker(common, phy_state, cfg, log);
     }
-    pool.init_worker(i, w, args.workers_thread_prio, args.worker_cpu_mask);
+    pool.init_worker(i, w, args.workers_thread_prio, mask);
     workers.push_back(std::unique_ptr<sf_worker>(w));
   }
 
@@ -204,6 +204,7 @@ void phy::get_metrics(const srsran::srsran_rat_t& rat, phy_metrics_t* m)
     common.get_dl_metrics(m->dl);
     common.get_ul_metrics(m->ul);
     common.get_sync_metrics(m->sync);
+    sfsync.get_cell_search_metrics(m->cell_search);
     m->nof_active_cc = args.nof_lte_carriers;
     return;
   }
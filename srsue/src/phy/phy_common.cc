@@ -835,6 +835,12 @@ void phy_common::set_dl_metrics(uint32_t cc_idx, const dl_metrics_t& m)
   dl_metrics[cc_idx].set(m);
 }
 
+void phy_common::set_dl_pdcch_metrics(uint32_t cc_idx, float pdcch_us)
+{
+  std::unique_lock<std::mutex> lock(metrics_mutex);
+  dl_metrics[cc_idx].set_pdcch(pdcch_us);
+}
+
 void phy_common::get_dl_metrics(dl_metrics_t::array_t& m)
 {
   std::unique_lock<std::mutex> lock(metrics_mutex);
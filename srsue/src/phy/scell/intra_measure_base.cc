@@ -47,6 +47,16 @@ void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
   context.trigger_tti_offset = args.tti_offset;
   rx_gain_offset_db          = args.rx_gain_offset_db;
 
+  // Create the measurement workers, the asynchronous thread is one of them. They are kept if the number decreases
+  nof_workers = std::max(1U, args.nof_workers);
+  if (nof_workers > 1) {
+    if (workers == nullptr) {
+      workers.reset(new srsran::task_thread_pool(nof_workers - 1, false, INTRA_FREQ_MEAS_PRIO));
+    } else if (workers->nof_workers() < nof_workers - 1) {
+      workers->set_nof_workers(nof_workers - 1);
+    }
+  }
+
   // Compute subframe length from the sampling rate if available
   if (std::isnormal(args.srate_hz)) {
     context.sf_len = (uint32_t)round(args.srate_hz / 1000.0);
@@ -90,6 +100,11 @@ void intra_measure_base::stop()
   // Wait for the asynchronous thread to finish
   wait_thread_finish();
 
+  // Stop the measurement workers once they cannot get new tasks
+  if (workers != nullptr) {
+    workers->stop();
+  }
+
   srsran_ringbuffer_stop(&ring_buffer);
 }
 
@@ -196,9 +211,64 @@ void intra_measure_base::measure_proc()
   }
 
   // Perform measurements for the actual RAT
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
   if (not measure_rat(std::move(context_copy), search_buffer, rx_gain_offset_db)) {
     Log(error, "Error measuring RAT");
   }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  meas_latency_ms = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() / 1000.0f;
+  Log(debug, "Measurement took %.1f ms", meas_latency_ms.load());
+}
+
+void intra_measure_base::parallel_for(uint32_t nof_tasks, const std::function<void(uint32_t, uint32_t)>& task)
+{
+  uint32_t nof_threads = std::min(nof_workers.load(), nof_tasks);
+
+  // Run in the calling thread only if there is nothing to share
+  if (workers == nullptr or nof_threads <= 1) {
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      task(0, i);
+    }
+    return;
+  }
+
+  // State shared with the workers, it lives in this stack frame until all of them have finished
+  struct parallel_for_state_t {
+    const std::function<void(uint32_t, uint32_t)>* task      = nullptr;
+    uint32_t                                       nof_tasks = 0;
+    std::atomic<uint32_t>                          next_task = {0};
+    uint32_t                                       nof_done  = 0;
+    std::mutex                                     mutex;
+    std::condition_variable                        cvar;
+
+    // Claims tasks until there are none left
+    void run(uint32_t worker_idx)
+    {
+      for (uint32_t i = next_task++; i < nof_tasks; i = next_task++) {
+        (*task)(worker_idx, i);
+      }
+    }
+  } shared;
+  shared.task      = &task;
+  shared.nof_tasks = nof_tasks;
+
+  for (uint32_t w = 1; w < nof_threads; w++) {
+    workers->push_task([&shared, w]() {
+      shared.run(w);
+      std::lock_guard<std::mutex> lock(shared.mutex);
+      shared.nof_done++;
+      shared.cvar.notify_one();
+    });
+  }
+
+  shared.run(0);
+
+  // Wait for the other workers, as they reference the shared state
+  std::unique_lock<std::mutex> lock(shared.mutex);
+  while (shared.nof_done < nof_threads - 1) {
+    shared.cvar.wait(lock);
+  }
 }
 
 void intra_measure_base::run_thread()
@@ -35,15 +35,24 @@ intra_measure_lte::intra_measure_lte(srslog::basic_logger& logger_, meas_itf& ne
 intra_measure_lte::~intra_measure_lte()
 {
   scell_rx.deinit();
-  srsran_refsignal_dl_sync_free(&refsignal_dl_sync);
+  for (srsran_refsignal_dl_sync_t& q : refsignal_dl_sync) {
+    srsran_refsignal_dl_sync_free(&q);
+  }
+  srsran_refsignal_dl_sync_spectrum_free(&spectrum);
 }
 
 void intra_measure_lte::init(uint32_t cc_idx, const args_t& args)
 {
   init_generic(cc_idx, args);
 
-  // Initialise Reference signal measurement
-  srsran_refsignal_dl_sync_init(&refsignal_dl_sync, SRSRAN_CP_NORM);
+  // Initialise Reference signal measurement, every worker measures a different PCI at a time
+  refsignal_dl_sync.resize(get_nof_workers());
+  for (srsran_refsignal_dl_sync_t& q : refsignal_dl_sync) {
+    srsran_refsignal_dl_sync_init(&q, SRSRAN_CP_NORM);
+  }
+
+  // The capture spectrum is computed once for all the PCI
+  srsran_refsignal_dl_sync_spectrum_init(&spectrum, args.len_ms * SRSRAN_SF_LEN_MAX);
 
   // Start scell
   scell_rx.init(args.len_ms);
@@ -77,45 +86,73 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
 
   context.new_cell_itf.cell_meas_reset(context.cc_idx);
 
-  // Use Cell Reference signal to measure cells in the time domain for all known active PCI
+  // The serving cell is not measured here since it's measured by workers
+  std::vector<uint32_t> pci_list;
   for (const uint32_t& id : cells_to_measure) {
-    // Do not measure serving cell here since it's measured by workers
-    if (id == serving_cell_copy.id) {
-      continue;
+    if (id != serving_cell_copy.id) {
+      pci_list.push_back(id);
     }
-    srsran_cell_t cell = serving_cell_copy;
-    cell.id            = id;
+  }
+
+  // Compute the correlation input spectrum once for all the PCI
+  uint32_t nsamples = context.meas_len_ms * context.sf_len;
+  if (not pci_list.empty() and
+      srsran_refsignal_dl_sync_spectrum_compute(&spectrum, context.sf_len, buffer.data(), nsamples) < SRSRAN_SUCCESS) {
+    Log(error, "Error computing refsignal DL spectrum");
+    return false;
+  }
 
-    if (srsran_refsignal_dl_sync_set_cell(&refsignal_dl_sync, cell) < SRSRAN_SUCCESS) {
+  // Use Cell Reference signal to measure cells in the time domain for all known active PCI, spread across the workers
+  std::vector<phy_meas_t> meas(pci_list.size());
+  std::vector<uint32_t>   peak_index(pci_list.size(), UINT32_MAX);
+  std::atomic<bool>       failed = {false};
+  parallel_for(pci_list.size(), [&](uint32_t worker_idx, uint32_t i) {
+    srsran_refsignal_dl_sync_t& q    = refsignal_dl_sync[worker_idx];
+    srsran_cell_t               cell = serving_cell_copy;
+    cell.id                          = pci_list[i];
+
+    if (srsran_refsignal_dl_sync_set_cell(&q, cell) < SRSRAN_SUCCESS) {
       Log(error, "Error setting refsignal DL cell");
-      return false;
+      failed = true;
+      return;
     }
 
-    if (srsran_refsignal_dl_sync_run(&refsignal_dl_sync, buffer.data(), context.meas_len_ms * context.sf_len) <
-        SRSRAN_SUCCESS) {
+    if (srsran_refsignal_dl_sync_run_spectrum(&q, &spectrum, buffer.data(), nsamples) < SRSRAN_SUCCESS) {
       Log(error, "Error running refsignal DL measurements");
-      return false;
+      failed = true;
+      return;
+    }
+
+    if (q.found) {
+      meas[i].rat    = srsran::srsran_rat_t::lte;
+      meas[i].pci    = cell.id;
+      meas[i].earfcn = current_earfcn;
+      meas[i].rsrp   = q.rsrp_dBfs - rx_gain_offset_db;
+      meas[i].rsrq   = q.rsrq_dB;
+      meas[i].cfo_hz = q.cfo_Hz;
+      peak_index[i]  = q.peak_index;
     }
+  });
 
-    if (refsignal_dl_sync.found) {
-      phy_meas_t m = {};
-      m.rat        = srsran::srsran_rat_t::lte;
-      m.pci        = cell.id;
-      m.earfcn     = current_earfcn;
-      m.rsrp       = refsignal_dl_sync.rsrp_dBfs - rx_gain_offset_db;
-      m.rsrq       = refsignal_dl_sync.rsrq_dB;
-      m.cfo_hz     = refsignal_dl_sync.cfo_Hz;
-      neighbour_cells.push_back(m);
-
-      Log(info,
-          "Found neighbour cell: PCI=%03d, RSRP=%5.1f dBm, RSRQ=%5.1f, peak_idx=%5d, "
-          "CFO=%+.1fHz",
-          m.pci,
-          m.rsrp,
-          m.rsrq,
-          refsignal_dl_sync.peak_index,
-          refsignal_dl_sync.cfo_Hz);
+  if (failed) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < pci_list.size(); i++) {
+    if (peak_index[i] == UINT32_MAX) {
+      continue;
     }
+    const phy_meas_t& m = meas[i];
+    neighbour_cells.push_back(m);
+
+    Log(info,
+        "Found neighbour cell: PCI=%03d, RSRP=%5.1f dBm, RSRQ=%5.1f, peak_idx=%5d, "
+        "CFO=%+.1fHz",
+        m.pci,
+        m.rsrp,
+        m.rsrq,
+        peak_index[i],
+        m.cfo_hz);
   }
 
   // Send measurements to RRC if any cell found
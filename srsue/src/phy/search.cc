@@ -53,13 +53,21 @@ search::~search()
 {
   srsran_ue_mib_sync_free(&ue_mib_sync);
   srsran_ue_cellsearch_free(&cs);
+  srsran_ue_cellsearch_wb_free(&cs_wb);
+  if (wb_buffer) {
+    free(wb_buffer);
+  }
+  if (wb_scratch) {
+    free(wb_scratch);
+  }
 }
 
 void search::init(srsran::rf_buffer_t& buffer_, uint32_t nof_rx_channels, search_callback* parent, int force_N_id_2_, int force_N_id_1_)
 {
   p = parent;
 
-  buffer = buffer_;
+  buffer                = buffer_;
+  this->nof_rx_channels = nof_rx_channels;
 
   if (srsran_ue_cellsearch_init_multi(&cs, 8, radio_recv_callback, nof_rx_channels, parent)) {
     Error("SYNC:  Initiating UE cell search");
@@ -77,6 +85,70 @@ void search::init(srsran::rf_buffer_t& buffer_, uint32_t nof_rx_channels, search
   force_N_id_1 = force_N_id_1_;
 }
 
+bool search::init_wb(double srate_hz, uint32_t nof_threads)
+{
+  // The capture is received in 1 ms chunks
+  uint32_t sf_len = (uint32_t)(srate_hz / 1000);
+  if (sf_len == 0 || sf_len * 1000 != (uint32_t)srate_hz) {
+    Error("SYNC:  Invalid wideband cell search sampling rate %.2f MHz", srate_hz / 1e6);
+    return false;
+  }
+
+  srsran_ue_cellsearch_wb_args_t args = {};
+  args.srate_hz                       = srate_hz;
+  args.max_nsamples                   = sf_len * SRSRAN_NOF_SF_X_FRAME / 2 * wb_nof_frames;
+  args.nof_threads                    = nof_threads;
+  if (srsran_ue_cellsearch_wb_init(&cs_wb, &args) < SRSRAN_SUCCESS) {
+    Error("SYNC:  Initiating wideband cell search at %.2f MHz", srate_hz / 1e6);
+    return false;
+  }
+
+  // Only the first channel is searched, the samples of the other channels are received and discarded
+  wb_buffer  = srsran_vec_cf_malloc(args.max_nsamples);
+  wb_scratch = srsran_vec_cf_malloc(sf_len);
+  if (wb_buffer == nullptr || wb_scratch == nullptr) {
+    Error("SYNC:  Allocating wideband cell search buffers");
+    return false;
+  }
+
+  wb_srate_hz = srate_hz;
+  wb_nsamples = args.max_nsamples;
+  return true;
+}
+
+search::ret_code
+search::run_wb(const double* freq_offset_hz, uint32_t nof_carriers, srsran_ue_cellsearch_wb_result_t* results)
+{
+  uint32_t sf_len = (uint32_t)(wb_srate_hz / 1000);
+
+  cf_t*              data[SRSRAN_MAX_CHANNELS] = {};
+  srsran_timestamp_t rx_time                   = {};
+  for (uint32_t ch = 1; ch < nof_rx_channels; ch++) {
+    data[ch] = wb_scratch;
+  }
+  for (uint32_t offset = 0; offset < wb_nsamples; offset += sf_len) {
+    data[0] = &wb_buffer[offset];
+    srsran::rf_buffer_t rf_buffer(data, sf_len);
+    if (p->radio_recv_fnc(rf_buffer, &rx_time) < SRSRAN_SUCCESS) {
+      Error("SYNC:  Receiving wideband cell search samples");
+      return ERROR;
+    }
+  }
+
+  int ret = srsran_ue_cellsearch_wb_scan(&cs_wb, wb_buffer, wb_nsamples, freq_offset_hz, nof_carriers, results);
+  if (ret < SRSRAN_SUCCESS) {
+    Error("SYNC:  Error searching PSS in the wideband capture");
+    return ERROR;
+  }
+  return ret > 0 ? CELL_FOUND : CELL_NOT_FOUND;
+}
+
+void search::set_wb_result(const srsran_ue_cellsearch_wb_result_t& result)
+{
+  wb_result     = result;
+  wb_result_set = true;
+}
+
 void search::set_cp_en(bool enable)
 {
   srsran_set_detect_cp(&cs, enable);
@@ -121,7 +193,20 @@ search::ret_code search::run(srsran_cell_t* cell_, std::array<uint8_t, SRSRAN_BC
   Info("SYNC:  Searching for cell...");
   srsran::console(".");
 
-  if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
+  if (wb_result_set) {
+    // The PSS/SSS were already detected in a wideband capture, only the MIB is left to decode
+    wb_result_set = false;
+    if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
+      // Only the N_id_2 reported as a cell have a non-zero peak
+      found_cells[force_N_id_2] = wb_result.cells[force_N_id_2];
+      ret                       = found_cells[force_N_id_2].peak > 0.0f ? 1 : 0;
+      max_peak_cell             = force_N_id_2;
+    } else {
+      std::copy(std::begin(wb_result.cells), std::end(wb_result.cells), std::begin(found_cells));
+      ret           = wb_result.nof_cells;
+      max_peak_cell = wb_result.max_N_id_2;
+    }
+  } else if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
     ret           = srsran_ue_cellsearch_scan_N_id_2(&cs, force_N_id_2, &found_cells[force_N_id_2]);
     max_peak_cell = force_N_id_2;
   } else {
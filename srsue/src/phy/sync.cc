@@ -21,11 +21,13 @@
 
 #include "srsue/hdr/phy/sync.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/phy/channel/channel.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/lte/sf_worker.h"
 
 #include <algorithm>
+#include <chrono>
 #include <unistd.h>
 
 #define Error(fmt, ...)                                                                                                \
@@ -93,6 +95,10 @@ void sync::init(srsran::radio_interface_phy* _radio,
   // Initialize cell searcher
   search_p.init(sf_buffer, nof_rf_channels, this, worker_com->args->force_N_id_2, worker_com->args->force_N_id_1);
   search_p.set_cp_en(worker_com->args->detect_cp);
+  if (worker_com->args->cell_search_wb_srate > 0.0f and
+      not search_p.init_wb(worker_com->args->cell_search_wb_srate, worker_com->args->cell_search_wb_nof_threads)) {
+    phy_logger.warning("SYNC:  Wideband cell search disabled, each EARFCN is searched at 1.92 MHz");
+  }
   // Initialize SFN synchronizer, it uses only pcell buffer
   sfn_p.init(&ue_sync, worker_com->args, sf_buffer, sf_buffer.size());
 
@@ -105,6 +111,7 @@ void sync::init(srsran::radio_interface_phy* _radio,
       args.len_ms                            = worker_com->args->intra_freq_meas_len_ms;
       args.period_ms                         = worker_com->args->intra_freq_meas_period_ms;
       args.rx_gain_offset_db                 = worker_com->args->rx_gain_offset;
+      args.nof_workers                       = worker_com->args->intra_freq_meas_nof_workers;
       q->init(i, args);
       intra_freq_meas.push_back(std::unique_ptr<scell::intra_measure_lte>(q));
     }
@@ -124,7 +131,7 @@ void sync::init(srsran::radio_interface_phy* _radio,
 
   // Start main thread
   if (sync_cpu_affinity < 0) {
-    start(prio);
+    srsran::get_thread_placement().start(*this, "sync", 0, prio);
   } else {
     start_cpu(prio, sync_cpu_affinity);
   }
@@ -245,24 +252,37 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
     Info("SYNC:  Setting Cell Search sampling rate");
   }
 
-  if (earfcn < 0) {
-    try {
-      if (current_earfcn != (int)worker_com->args->dl_earfcn_list.at(cellsearch_earfcn_index)) {
-        current_earfcn = (int)worker_com->args->dl_earfcn_list[cellsearch_earfcn_index];
+  if (earfcn < 0 and search_p.get_wb_srate() > 0 and not(dl_freq > 0 and ul_freq > 0)) {
+    cell_search_wb();
+  } else {
+    if (earfcn < 0) {
+      try {
+        if (current_earfcn != (int)worker_com->args->dl_earfcn_list.at(cellsearch_earfcn_index)) {
+          current_earfcn = (int)worker_com->args->dl_earfcn_list[cellsearch_earfcn_index];
+        }
+      } catch (const std::out_of_range& oor) {
+        Error("Index %d is not a valid EARFCN element.", cellsearch_earfcn_index);
+        return ret;
       }
-    } catch (const std::out_of_range& oor) {
-      Error("Index %d is not a valid EARFCN element.", cellsearch_earfcn_index);
-      return ret;
+    } else {
+      current_earfcn = earfcn;
     }
-  } else {
-    current_earfcn = earfcn;
-  }
-  Info("Cell Search: changing frequency to EARFCN=%d", current_earfcn);
-  set_frequency();
+    auto t_start = std::chrono::steady_clock::now();
+    Info("Cell Search: changing frequency to EARFCN=%d", current_earfcn);
+    set_frequency();
+
+    // Move to CELL SEARCH and wait to finish
+    Info("Cell Search: Setting Cell search state");
+    phy_state.run_cell_search();
 
-  // Move to CELL SEARCH and wait to finish
-  Info("Cell Search: Setting Cell search state");
-  phy_state.run_cell_search();
+    std::chrono::duration<float, std::milli> search_time = std::chrono::steady_clock::now() - t_start;
+
+    cell_search_metrics_t m = {};
+    m.band                  = srsran_band_get_band(current_earfcn);
+    m.nof_earfcn            = 1;
+    m.search_ms             = search_time.count();
+    set_cell_search_metrics(m);
+  }
 
   // Check return state
   switch (cell_search_ret) {
@@ -420,8 +440,122 @@ bool sync::wait_idle()
   return true;
 }
 
+void sync::cell_search_wb()
+{
+  const std::vector<uint32_t>&              earfcn_list = worker_com->args->dl_earfcn_list;
+  double                                    wb_srate    = search_p.get_wb_srate();
+  std::map<uint32_t, cell_search_metrics_t> band_metrics;
+
+  cell_search_ret = search::CELL_NOT_FOUND;
+  for (uint32_t i = 0; i < earfcn_list.size() and cell_search_ret == search::CELL_NOT_FOUND;) {
+    auto     t_start = std::chrono::steady_clock::now();
+    uint32_t band    = srsran_band_get_band(earfcn_list[i]);
+
+    // Group the following EARFCN of the same band while every carrier fits in the capture bandwidth
+    double   f_min        = 1e6 * srsran_band_fd(earfcn_list[i]);
+    double   f_max        = f_min;
+    uint32_t nof_carriers = 1;
+    for (; i + nof_carriers < earfcn_list.size() and nof_carriers < SRSRAN_CS_WB_MAX_CARRIERS; nof_carriers++) {
+      uint32_t next_earfcn = earfcn_list[i + nof_carriers];
+      double   f           = 1e6 * srsran_band_fd(next_earfcn);
+      if (srsran_band_get_band(next_earfcn) != band or
+          std::max(f_max, f) - std::min(f_min, f) > wb_srate - SRSRAN_CS_SAMP_FREQ) {
+        break;
+      }
+      f_min = std::min(f_min, f);
+      f_max = std::max(f_max, f);
+    }
+    double f_center = (f_min + f_max) / 2;
+    wb_freq_offsets.resize(nof_carriers);
+    wb_results.resize(nof_carriers);
+    for (uint32_t k = 0; k < nof_carriers; k++) {
+      wb_freq_offsets[k] = 1e6 * srsran_band_fd(earfcn_list[i + k]) - f_center;
+    }
+
+    // Capture in the SYNC thread. The radio is no longer tuned to any EARFCN
+    Info("Cell Search: Wideband capture of %d EARFCN in band %d, f_dl=%.1f MHz, srate=%.2f MHz",
+         nof_carriers,
+         band,
+         f_center / 1e6,
+         wb_srate / 1e6);
+    current_earfcn = -1;
+    radio_h->set_rx_srate(wb_srate);
+    radio_h->set_rx_freq(0, f_center);
+    wb_capture = true;
+    phy_state.run_cell_search();
+    wb_capture = false;
+    radio_h->set_rx_srate(SRSRAN_CS_SAMP_FREQ);
+    if (cell_search_ret == search::ERROR) {
+      return;
+    }
+
+    // Decode the MIB in the EARFCN with PSS/SSS, in the list order
+    uint32_t nof_detected = 0;
+    cell_search_ret       = search::CELL_NOT_FOUND;
+    for (uint32_t k = 0; k < nof_carriers; k++) {
+      if (wb_results[k].nof_cells == 0) {
+        continue;
+      }
+      nof_detected++;
+      if (cell_search_ret != search::CELL_NOT_FOUND) {
+        continue;
+      }
+      current_earfcn = (int)earfcn_list[i + k];
+      Info("Cell Search: PSS/SSS detected in EARFCN=%d, decoding MIB", current_earfcn);
+      set_frequency();
+      search_p.set_wb_result(wb_results[k]);
+      phy_state.run_cell_search();
+    }
+
+    float search_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+    Info("Cell Search: %d/%d EARFCN with PSS/SSS in band %d, searched in %.1f ms",
+         nof_detected,
+         nof_carriers,
+         band,
+         search_ms);
+
+    cell_search_metrics_t& m = band_metrics[band];
+    m.band                   = band;
+    m.nof_earfcn += nof_carriers;
+    m.search_ms += search_ms;
+    m.wideband = true;
+    i += nof_carriers;
+  }
+
+  for (const auto& m : band_metrics) {
+    set_cell_search_metrics(m.second);
+  }
+}
+
+void sync::set_cell_search_metrics(const cell_search_metrics_t& m)
+{
+  phy_logger.info("Cell Search: Band %d: %d EARFCN searched in %.1f ms (%s)",
+                  m.band,
+                  m.nof_earfcn,
+                  m.search_ms,
+                  m.wideband ? "wideband" : "narrowband");
+
+  std::lock_guard<std::mutex> lock(cell_search_metrics_mutex);
+  cell_search_metrics[m.band] = m;
+}
+
+void sync::get_cell_search_metrics(std::vector<cell_search_metrics_t>& m)
+{
+  std::lock_guard<std::mutex> lock(cell_search_metrics_mutex);
+  m.clear();
+  for (const auto& e : cell_search_metrics) {
+    m.push_back(e.second);
+  }
+}
+
 void sync::run_cell_search_state()
 {
+  if (wb_capture) {
+    cell_search_ret = search_p.run_wb(wb_freq_offsets.data(), wb_freq_offsets.size(), wb_results.data());
+    phy_state.state_exit();
+    return;
+  }
+
   srsran_cell_t tmp_cell = cell.get();
   cell_search_ret        = search_p.run(&tmp_cell, mib);
   if (cell_search_ret == search::CELL_FOUND) {
@@ -518,6 +652,10 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
   metrics.distance_km = worker_com->ta.get_km();
   metrics.speed_kmph  = worker_com->ta.get_speed_kmph(tti);
   for (uint32_t i = 0; i < worker_com->args->nof_lte_carriers; i++) {
+    {
+      std::lock_guard<std::mutex> lock(intra_freq_cfg_mutex);
+      metrics.intra_meas_ms = (i < intra_freq_meas.size()) ? intra_freq_meas[i]->get_meas_latency_ms() : 0.0f;
+    }
     worker_com->set_sync_metrics(i, metrics);
   }
 
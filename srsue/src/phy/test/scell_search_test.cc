@@ -369,6 +369,7 @@ int parse_args(int argc, char** argv)
       ("intra_meas_log_level",      bpo::value<std::string>(&intra_meas_log_level)->default_value("none"),         "Intra measurement log level (none, warning, info, debug)")
       ("intra_freq_meas_len_ms",    bpo::value<uint32_t>(&phy_args.intra_freq_meas_len_ms)->default_value(20),     "Intra measurement measurement length")
       ("intra_freq_meas_period_ms", bpo::value<uint32_t>(&phy_args.intra_freq_meas_period_ms)->default_value(200), "Intra measurement measurement period")
+      ("intra_freq_meas_nof_workers", bpo::value<uint32_t>(&phy_args.intra_freq_meas_nof_workers)->default_value(1), "Intra measurement number of workers")
       ("phy_lib_log_level",         bpo::value<int>(&phy_lib_log_level)->default_value(SRSRAN_VERBOSE_NONE),       "Phy lib log level (0: none, 1: info, 2: debug)")
       ("active_cell_list",          bpo::value<std::string>(&active_cell_list)->default_value("10,17,24,31,38,45,52"),    "Comma separated neighbour PCI cell list")
       ("enable_json_report",        bpo::value<bool>(&enable_json_report)->default_value(false),                   "Enable JSON file reporting")
@@ -532,6 +533,7 @@ int main(int argc, char** argv)
   args.len_ms                                   = phy_args.intra_freq_meas_len_ms;
   args.period_ms                                = phy_args.intra_freq_meas_period_ms;
   args.rx_gain_offset_db                        = phy_args.rx_gain_offset;
+  args.nof_workers                              = phy_args.intra_freq_meas_nof_workers;
 
   intra_measure.init(0, args);
   intra_measure.set_primary_cell(SRSRAN_MAX(earfcn_dl, 0), cell_base);
@@ -21,6 +21,7 @@
 
 #include "srsue/hdr/stack/ue_stack_lte.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/interfaces/ue_phy_interfaces.h"
 #include "srsran/srslog/event_trace.h"
 
@@ -255,7 +256,7 @@ int ue_stack_lte::init(const stack_args_t& args_)
   }
 
   running = true;
-  start(STACK_MAIN_THREAD_PRIO);
+  srsran::get_thread_placement().start(*this, "stack", 0, STACK_MAIN_THREAD_PRIO);
 
   return SRSRAN_SUCCESS;
 }
@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/stack/ue_stack_nr.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/stack/rrc_nr/rrc_nr.h"
 
@@ -98,7 +99,7 @@ int ue_stack_nr::init(const stack_args_t& args_)
             this,
             rrc_args);
   running = true;
-  start(STACK_MAIN_THREAD_PRIO);
+  srsran::get_thread_placement().start(*this, "stack", 0, STACK_MAIN_THREAD_PRIO);
 
   return SRSRAN_SUCCESS;
 }
@@ -21,6 +21,7 @@
 
 #include "srsue/hdr/stack/upper/gw.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_placement.h"
 #include "srsran/interfaces/ue_pdcp_interfaces.h"
 #include "srsran/upper/ipv6.h"
 
@@ -32,14 +33,45 @@
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+// UDP segmentation offload, missing in older kernel headers
+#ifndef TUN_F_USO4
+#define TUN_F_USO4 0x20
+#define TUN_F_USO6 0x40
+#endif
+
 namespace srsue {
 
+static const uint32_t MAX_TUN_QUEUES = 16;
+
+// Largest packet handed by the TUN with segmentation offload, plus the link headroom
+static const uint32_t TUN_OFFLOAD_BUFFER_SIZE = 65536 + 256;
+
+// Values of the virtio-net header, linux/virtio_net.h does not build as C++
+static const uint8_t VIRTIO_NET_HDR_F_NEEDS_CSUM = 1;
+static const uint8_t VIRTIO_NET_HDR_GSO_NONE     = 0;
+static const uint8_t VIRTIO_NET_HDR_GSO_TCPV4    = 1;
+static const uint8_t VIRTIO_NET_HDR_GSO_TCPV6    = 4;
+static const uint8_t VIRTIO_NET_HDR_GSO_UDP_L4   = 5;
+static const uint8_t VIRTIO_NET_HDR_GSO_ECN      = 0x80;
+
 gw::gw(srslog::basic_logger& logger_) : thread("GW"), logger(logger_), tft_matcher(logger) {}
 
+gw::tun_reader::tun_reader(gw* parent_, uint32_t queue_idx_) :
+  thread("GW_TUN" + std::to_string(queue_idx_)), parent(parent_), queue_idx(queue_idx_)
+{}
+
+void gw::tun_reader::run_thread()
+{
+  parent->read_tun_queue(queue_idx);
+}
+
 int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
 {
   stack      = stack_;
@@ -49,6 +81,11 @@ int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
   logger.set_level(srslog::str_to_basic_level(args.log.gw_level));
   logger.set_hex_dump_max_size(args.log.gw_hex_limit);
 
+  if (args.tun_queues < 1 || args.tun_queues > MAX_TUN_QUEUES) {
+    logger.error("Invalid number of TUN queues %d, it must be between 1 and %d", args.tun_queues, MAX_TUN_QUEUES);
+    return SRSRAN_ERROR;
+  }
+
   metrics_tp = std::chrono::high_resolution_clock::now();
 
   // MBSFN
@@ -73,9 +110,7 @@ int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
 
 gw::~gw()
 {
-  if (tun_fd > 0) {
-    close(tun_fd);
-  }
+  close_tun();
 }
 
 void gw::stop()
@@ -87,6 +122,7 @@ void gw::stop()
       if (running) {
         thread_cancel();
       }
+      stop_tun_readers();
 
       // Wait thread to exit gracefully otherwise might leave a mutex locked
       int cnt = 0;
@@ -151,7 +187,7 @@ void gw::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
     // Only handle IPv4 and IPv6 packets
     struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
     if (ip_pkt->version == 4 || ip_pkt->version == 6) {
-      int n = write(tun_fd, pdu->msg, pdu->N_bytes);
+      int n = write_tun(pdu);
       if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
         logger.warning("DL TUN/TAP write failure. Wanted to write %d B but only wrote %d B.", pdu->N_bytes, n);
       }
@@ -185,7 +221,7 @@ void gw::write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
         logger.warning("TUN/TAP not up - dropping gw RX message");
       }
     } else {
-      int n = write(tun_fd, pdu->msg, pdu->N_bytes);
+      int n = write_tun(pdu);
       if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
         logger.warning("DL TUN/TAP write failure");
       }
@@ -193,6 +229,19 @@ void gw::write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
   }
 }
 
+int gw::write_tun(srsran::unique_byte_buffer_t& pdu)
+{
+  if (not args.tun_offload) {
+    return write(tun_fd, pdu->msg, pdu->N_bytes);
+  }
+
+  // The TUN expects a virtio-net header before every packet, an empty one for a complete packet
+  vnet_hdr_t   vnet_hdr = {};
+  struct iovec iov[2]   = {{&vnet_hdr, sizeof(vnet_hdr)}, {pdu->msg, pdu->N_bytes}};
+  int          n        = writev(tun_fd, iov, 2);
+  return n < (int)sizeof(vnet_hdr) ? n : n - (int)sizeof(vnet_hdr);
+}
+
 /*******************************************************************************
   NAS interface
 *******************************************************************************/
@@ -206,6 +255,7 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
     thread_cancel();
     wait_thread_finish();
   }
+  stop_tun_readers();
   if (pdn_type == LIBLTE_MME_PDN_TYPE_IPV4 || pdn_type == LIBLTE_MME_PDN_TYPE_IPV4V6) {
     err = setup_if_addr4(ip_addr, err_str);
     if (err != SRSRAN_SUCCESS) {
@@ -221,9 +271,13 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
 
   default_eps_bearer_id = static_cast<int>(eps_bearer_id);
 
-  // Setup a thread to receive packets from the TUN device
+  // Setup a thread to receive packets from every queue of the TUN device
   run_enable = true;
-  start(GW_THREAD_PRIO);
+  srsran::get_thread_placement().start(*this, "gw", 0, GW_THREAD_PRIO);
+  for (uint32_t i = 1; i < tun_fds.size(); i++) {
+    tun_readers.emplace_back(new tun_reader(this, i));
+    srsran::get_thread_placement().start(*tun_readers.back(), "gw", i, GW_THREAD_PRIO);
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -273,6 +327,26 @@ void gw::add_mch_port(uint32_t lcid, uint32_t port)
 /*    GW Receive    */
 /********************/
 void gw::run_thread()
+{
+  running = true;
+  read_tun_queue(0);
+  running = false;
+}
+
+void gw::read_tun_queue(uint32_t queue_idx)
+{
+  logger.info("GW IP packet receiver thread of TUN queue %d run_enable", queue_idx);
+
+  if (args.tun_offload) {
+    read_tun_offload_packets(tun_fds[queue_idx]);
+  } else {
+    read_tun_packets(tun_fds[queue_idx]);
+  }
+
+  logger.info("GW IP receiver thread of TUN queue %d exiting.", queue_idx);
+}
+
+void gw::read_tun_packets(int32_t fd)
 {
   uint32 idx     = 0;
   int32  N_bytes = 0;
@@ -283,22 +357,16 @@ void gw::run_thread()
     return;
   }
 
-  const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
-  uint32_t              register_wait = 0, service_wait = 0;
-
-  logger.info("GW IP packet receiver thread run_enable");
-
-  running = true;
   while (run_enable) {
     // Read packet from TUN
     if (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET > idx) {
-      N_bytes = read(tun_fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
+      N_bytes = read(fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
     } else {
       logger.error("GW pdu buffer full - gw receive thread exiting.");
       srsran::console("GW pdu buffer full - gw receive thread exiting.\n");
       break;
     }
-    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, tun_fd, idx);
+    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, fd, idx);
 
     if (N_bytes <= 0) {
       logger.error("Failed to read from TUN interface - gw receive thread exiting.");
@@ -306,96 +374,300 @@ void gw::run_thread()
       break;
     }
 
-    {
-      std::unique_lock<std::mutex> lock(gw_mutex);
-      // Check if IP version makes sense and get packtet length
-      struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-      struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-      uint16_t        pkt_len = 0;
-      pdu->N_bytes            = idx + N_bytes;
-      if (ip_pkt->version == 4) {
-        pkt_len = ntohs(ip_pkt->tot_len);
-      } else if (ip_pkt->version == 6) {
-        pkt_len = ntohs(ip6_pkt->payload_len) + 40;
-      } else {
-        logger.error(pdu->msg, pdu->N_bytes, "Unsupported IP version. Dropping packet.");
-        continue;
+    // Check if IP version makes sense and get packtet length
+    struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
+    struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
+    uint16_t        pkt_len = 0;
+    pdu->N_bytes            = idx + N_bytes;
+    if (ip_pkt->version == 4) {
+      pkt_len = ntohs(ip_pkt->tot_len);
+    } else if (ip_pkt->version == 6) {
+      pkt_len = ntohs(ip6_pkt->payload_len) + 40;
+    } else {
+      logger.error(pdu->msg, pdu->N_bytes, "Unsupported IP version. Dropping packet.");
+      continue;
+    }
+    logger.debug("IPv%d packet total length: %d Bytes", int(ip_pkt->version), pkt_len);
+
+    // Check if entire packet was received
+    if (pkt_len == pdu->N_bytes) {
+      if (!send_ul_pdu(std::move(pdu))) {
+        break;
       }
-      logger.debug("IPv%d packet total length: %d Bytes", int(ip_pkt->version), pkt_len);
+      do {
+        pdu = srsran::make_byte_buffer();
+        if (!pdu) {
+          logger.error("Fatal Error: Couldn't allocate PDU in run_thread().");
+          usleep(100000);
+        }
+      } while (!pdu);
+      idx = 0;
+    } else {
+      idx += N_bytes;
+      logger.debug("Entire packet not read from socket. Total Length %d, N_Bytes %d.", ip_pkt->tot_len, pdu->N_bytes);
+    }
+  }
+}
 
-      // Check if entire packet was received
-      if (pkt_len == pdu->N_bytes) {
-        logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
+void gw::read_tun_offload_packets(int32_t fd)
+{
+  // A single read returns up to 64 KB of TCP or UDP payload, split afterwards in packets of the segment size
+  std::vector<uint8_t> buffer(TUN_OFFLOAD_BUFFER_SIZE);
 
-        // Make sure UE is attached and has default EPS bearer activated
-        while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
-          if (!register_wait) {
-            logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
-          }
-          lock.unlock();
-          std::this_thread::sleep_for(std::chrono::microseconds(100));
-          lock.lock();
-          register_wait++;
-        }
-        register_wait = 0;
+  while (run_enable) {
+    vnet_hdr_t   vnet_hdr = {};
+    struct iovec iov[2]   = {{&vnet_hdr, sizeof(vnet_hdr)}, {buffer.data(), buffer.size()}};
+    int32_t      N_bytes  = readv(fd, iov, 2);
+    logger.debug("Read %d bytes from TUN fd=%d, gso_type=%d, gso_size=%d",
+                 N_bytes,
+                 fd,
+                 vnet_hdr.gso_type,
+                 vnet_hdr.gso_size);
+
+    if (N_bytes <= (int32_t)sizeof(vnet_hdr)) {
+      logger.error("Failed to read from TUN interface - gw receive thread exiting.");
+      srsran::console("Failed to read from TUN interface - gw receive thread exiting.\n");
+      break;
+    }
 
-        // If we are still not attached by this stage, drop packet
-        if (run_enable && default_eps_bearer_id == NOT_ASSIGNED) {
-          continue;
-        }
+    if (!send_offload_packet(vnet_hdr, buffer.data(), N_bytes - sizeof(vnet_hdr))) {
+      break;
+    }
+  }
+}
 
-        if (!run_enable) {
-          break;
-        }
+// One's complement sum of 16-bit big-endian words, as used by the IP, TCP and UDP checksums
+static uint32_t checksum_add(const uint8_t* data, uint32_t len, uint32_t sum)
+{
+  for (uint32_t i = 0; i + 1 < len; i += 2) {
+    sum += (data[i] << 8U) | data[i + 1];
+  }
+  if (len % 2 != 0) {
+    sum += data[len - 1] << 8U;
+  }
+  return sum;
+}
 
-        // Beyond this point we should have a activated default EPS bearer
-        srsran_assert(default_eps_bearer_id != NOT_ASSIGNED, "Default EPS bearer not activated");
+static uint16_t checksum_fold(uint32_t sum)
+{
+  while (sum >> 16U) {
+    sum = (sum & 0xffff) + (sum >> 16U);
+  }
+  return ~sum & 0xffff;
+}
 
-        uint8_t eps_bearer_id = default_eps_bearer_id;
-        tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
+// Computes the TCP or UDP checksum of a packet with the pseudo-header of its IP version
+static void set_l4_checksum(uint8_t* pkt, uint32_t len, uint32_t l4_offset, uint32_t csum_offset, uint8_t protocol)
+{
+  uint32_t l4_len = len - l4_offset;
+  uint32_t sum    = protocol + l4_len;
+  if ((pkt[0] >> 4U) == 4) {
+    sum = checksum_add(&pkt[12], 8, sum);
+  } else {
+    sum = checksum_add(&pkt[8], 32, sum);
+  }
+  pkt[l4_offset + csum_offset]     = 0;
+  pkt[l4_offset + csum_offset + 1] = 0;
 
-        // Wait for service request if necessary
-        while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
-          if (!service_wait) {
-            logger.info(
-                "UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
-            stack->start_service_request();
-          }
-          usleep(100000);
-          service_wait++;
-        }
-        service_wait = 0;
+  uint16_t csum = checksum_fold(checksum_add(&pkt[l4_offset], l4_len, sum));
+  if (csum == 0 && protocol == IPPROTO_UDP) {
+    csum = 0xffff;
+  }
+  pkt[l4_offset + csum_offset]     = csum >> 8U;
+  pkt[l4_offset + csum_offset + 1] = csum & 0xff;
+}
 
-        // Quit before writing packet if necessary
-        if (!run_enable) {
-          break;
-        }
+bool gw::send_offload_packet(const vnet_hdr_t& vnet_hdr, uint8_t* pkt, uint32_t len)
+{
+  const uint32_t max_pdu_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  uint32_t       l4_offset   = vnet_hdr.csum_start;
+  bool           needs_csum  = (vnet_hdr.flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) != 0;
+  if (needs_csum && l4_offset + vnet_hdr.csum_offset + 2 > len) {
+    logger.error(pkt, len, "Invalid checksum offset %d. Dropping packet.", l4_offset + vnet_hdr.csum_offset);
+    return true;
+  }
 
-        // Send PDU directly to PDCP
-        pdu->set_timestamp();
-        ul_tput_bytes += pdu->N_bytes;
-        stack->write_sdu(eps_bearer_id, std::move(pdu));
-        do {
-          pdu = srsran::make_byte_buffer();
-          if (!pdu) {
-            logger.error("Fatal Error: Couldn't allocate PDU in run_thread().");
-            usleep(100000);
-          }
-        } while (!pdu);
-        idx = 0;
-      } else {
-        idx += N_bytes;
-        logger.debug("Entire packet not read from socket. Total Length %d, N_Bytes %d.", ip_pkt->tot_len, pdu->N_bytes);
+  if (vnet_hdr.gso_type == VIRTIO_NET_HDR_GSO_NONE) {
+    if (len > max_pdu_len) {
+      logger.error("Packet of %d B exceeds the PDU size. Dropping packet.", len);
+      return true;
+    }
+    // The stored checksum is the one of the pseudo-header, the kernel left the rest to the device
+    if (needs_csum) {
+      uint16_t csum                             = checksum_fold(checksum_add(&pkt[l4_offset], len - l4_offset, 0));
+      pkt[l4_offset + vnet_hdr.csum_offset]     = csum >> 8U;
+      pkt[l4_offset + vnet_hdr.csum_offset + 1] = csum & 0xff;
+    }
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    if (!pdu) {
+      logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      return true;
+    }
+    memcpy(pdu->msg, pkt, len);
+    pdu->N_bytes = len;
+    return send_ul_pdu(std::move(pdu));
+  }
+
+  // Header length of every segment, the one announced by the kernel is only a hint
+  uint8_t  protocol = 0;
+  uint32_t hdr_len  = 0;
+  switch (vnet_hdr.gso_type & ~VIRTIO_NET_HDR_GSO_ECN) {
+    case VIRTIO_NET_HDR_GSO_TCPV4:
+    case VIRTIO_NET_HDR_GSO_TCPV6:
+      protocol = IPPROTO_TCP;
+      hdr_len  = l4_offset + sizeof(struct tcphdr) <= len ? l4_offset + (pkt[l4_offset + 12] >> 4U) * 4 : len;
+      break;
+    case VIRTIO_NET_HDR_GSO_UDP_L4:
+      protocol = IPPROTO_UDP;
+      hdr_len  = l4_offset + sizeof(struct udphdr);
+      break;
+    default:
+      logger.warning("Unsupported GSO type %d. Dropping packet.", vnet_hdr.gso_type);
+      return true;
+  }
+  if (!needs_csum || hdr_len >= len || vnet_hdr.gso_size == 0 || hdr_len + vnet_hdr.gso_size > max_pdu_len) {
+    logger.error(pkt,
+                 len,
+                 "Invalid GSO packet, header of %d B and segments of %d B. Dropping packet.",
+                 hdr_len,
+                 vnet_hdr.gso_size);
+    return true;
+  }
+
+  uint32_t payload_len = len - hdr_len;
+  for (uint32_t offset = 0, seg_idx = 0; offset < payload_len; offset += vnet_hdr.gso_size, seg_idx++) {
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    if (!pdu) {
+      logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      return true;
+    }
+    uint32_t seg_len = std::min((uint32_t)vnet_hdr.gso_size, payload_len - offset);
+    bool     last    = offset + seg_len == payload_len;
+    memcpy(pdu->msg, pkt, hdr_len);
+    memcpy(&pdu->msg[hdr_len], &pkt[hdr_len + offset], seg_len);
+    pdu->N_bytes = hdr_len + seg_len;
+
+    // The segments take the IP header of the first one, with their own length and identification
+    uint8_t* seg = pdu->msg;
+    if ((seg[0] >> 4U) == 4) {
+      struct iphdr* ip_pkt = (struct iphdr*)seg;
+      ip_pkt->tot_len      = htons(pdu->N_bytes);
+      ip_pkt->id           = htons(ntohs(ip_pkt->id) + seg_idx);
+      ip_pkt->check        = 0;
+      ip_pkt->check        = htons(checksum_fold(checksum_add(seg, ip_pkt->ihl * 4, 0)));
+    } else {
+      struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)seg;
+      ip6_pkt->payload_len    = htons(pdu->N_bytes - sizeof(struct ipv6hdr));
+    }
+
+    if (protocol == IPPROTO_TCP) {
+      // FIN and PSH only go in the last segment, CWR (0x80) only in the first one
+      struct tcphdr* tcp_pkt   = (struct tcphdr*)&seg[l4_offset];
+      uint8_t&       tcp_flags = seg[l4_offset + 13];
+      tcp_pkt->seq             = htonl(ntohl(tcp_pkt->seq) + offset);
+      if (!last) {
+        tcp_flags &= ~(TH_FIN | TH_PUSH);
+      }
+      if (seg_idx > 0) {
+        tcp_flags &= ~0x80;
       }
-    } // end of holdering gw_mutex
+    } else {
+      struct udphdr* udp_pkt = (struct udphdr*)&seg[l4_offset];
+      udp_pkt->len           = htons(pdu->N_bytes - l4_offset);
+    }
+    set_l4_checksum(seg, pdu->N_bytes, l4_offset, protocol == IPPROTO_TCP ? 16 : 6, protocol);
+
+    if (!send_ul_pdu(std::move(pdu))) {
+      return false;
+    }
   }
-  running = false;
-  logger.info("GW IP receiver thread exiting.");
+  return true;
+}
+
+bool gw::send_ul_pdu(srsran::unique_byte_buffer_t pdu)
+{
+  const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
+  uint32_t              register_wait = 0, service_wait = 0;
+
+  logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
+
+  uint8_t eps_bearer_id = 0;
+  {
+    std::unique_lock<std::mutex> lock(gw_mutex);
+
+    // Make sure UE is attached and has default EPS bearer activated
+    while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
+      if (!register_wait) {
+        logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
+      }
+      lock.unlock();
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      lock.lock();
+      register_wait++;
+    }
+
+    // If we are still not attached by this stage, drop packet
+    if (run_enable && default_eps_bearer_id == NOT_ASSIGNED) {
+      return true;
+    }
+
+    if (!run_enable) {
+      return false;
+    }
+
+    // Beyond this point we should have a activated default EPS bearer
+    srsran_assert(default_eps_bearer_id != NOT_ASSIGNED, "Default EPS bearer not activated");
+
+    eps_bearer_id = default_eps_bearer_id;
+  }
+  tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
+
+  // Wait for service request if necessary
+  while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
+    if (!service_wait) {
+      logger.info("UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
+      stack->start_service_request();
+    }
+    usleep(100000);
+    service_wait++;
+  }
+
+  // Quit before writing packet if necessary
+  if (!run_enable) {
+    return false;
+  }
+
+  // Send PDU directly to PDCP
+  pdu->set_timestamp();
+  {
+    std::lock_guard<std::mutex> lock(gw_mutex);
+    ul_tput_bytes += pdu->N_bytes;
+  }
+  stack->write_sdu(eps_bearer_id, std::move(pdu));
+  return true;
 }
 
 /**************************/
 /* TUN Interface Helpers  */
 /**************************/
+void gw::stop_tun_readers()
+{
+  for (std::unique_ptr<tun_reader>& reader : tun_readers) {
+    reader->thread_cancel();
+    reader->wait_thread_finish();
+  }
+  tun_readers.clear();
+}
+
+void gw::close_tun()
+{
+  for (int32_t fd : tun_fds) {
+    close(fd);
+  }
+  tun_fds.clear();
+  tun_fd = 0;
+}
+
 int gw::init_if(char* err_str)
 {
   if (if_up) {
@@ -419,25 +691,49 @@ int gw::init_if(char* err_str)
     }
   }
 
-  // Construct the TUN device
-  tun_fd = open("/dev/net/tun", O_RDWR);
-  logger.info("TUN file descriptor = %d", tun_fd);
-  if (0 > tun_fd) {
-    err_str = strerror(errno);
-    logger.error("Failed to open TUN device: %s", err_str);
-    return SRSRAN_ERROR_CANT_START;
+  // Construct the TUN device, every queue is attached by opening the device again with the same name
+  for (uint32_t i = 0; i < args.tun_queues; i++) {
+    int32_t fd = open("/dev/net/tun", O_RDWR);
+    logger.info("TUN file descriptor = %d", fd);
+    if (0 > fd) {
+      err_str = strerror(errno);
+      logger.error("Failed to open TUN device: %s", err_str);
+      close_tun();
+      return SRSRAN_ERROR_CANT_START;
+    }
+    tun_fds.push_back(fd);
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+    if (args.tun_queues > 1) {
+      ifr.ifr_flags |= IFF_MULTI_QUEUE;
+    }
+    if (args.tun_offload) {
+      ifr.ifr_flags |= IFF_VNET_HDR;
+    }
+    strncpy(ifr.ifr_ifrn.ifrn_name,
+            args.tun_dev_name.c_str(),
+            std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
+    ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
+    if (0 > ioctl(fd, TUNSETIFF, &ifr)) {
+      err_str = strerror(errno);
+      logger.error("Failed to set TUN device name: %s", err_str);
+      close_tun();
+      return SRSRAN_ERROR_CANT_START;
+    }
   }
+  tun_fd = tun_fds[0];
 
-  memset(&ifr, 0, sizeof(ifr));
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
-  strncpy(
-      ifr.ifr_ifrn.ifrn_name, args.tun_dev_name.c_str(), std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
-  ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
-  if (0 > ioctl(tun_fd, TUNSETIFF, &ifr)) {
-    err_str = strerror(errno);
-    logger.error("Failed to set TUN device name: %s", err_str);
-    close(tun_fd);
-    return SRSRAN_ERROR_CANT_START;
+  // Let the kernel hand TCP and UDP packets of up to 64 KB with partial checksums. UDP segmentation offload needs
+  // Linux 6.2, older kernels only get TCP segmentation offload
+  if (args.tun_offload) {
+    if (0 > ioctl(tun_fd, TUNSETOFFLOAD, TUN_F_CSUM | TUN_F_TSO4 | TUN_F_TSO6 | TUN_F_USO4 | TUN_F_USO6) &&
+        0 > ioctl(tun_fd, TUNSETOFFLOAD, TUN_F_CSUM | TUN_F_TSO4 | TUN_F_TSO6)) {
+      err_str = strerror(errno);
+      logger.error("Failed to set TUN offloads: %s", err_str);
+      close_tun();
+      return SRSRAN_ERROR_CANT_START;
+    }
   }
 
   // Bring up the interface
@@ -445,14 +741,14 @@ int gw::init_if(char* err_str)
   if (0 > ioctl(sock, SIOCGIFFLAGS, &ifr)) {
     err_str = strerror(errno);
     logger.error("Failed to bring up socket: %s", err_str);
-    close(tun_fd);
+    close_tun();
     return SRSRAN_ERROR_CANT_START;
   }
   ifr.ifr_flags |= IFF_UP | IFF_RUNNING;
   if (0 > ioctl(sock, SIOCSIFFLAGS, &ifr)) {
     err_str = strerror(errno);
     logger.error("Failed to set socket flags: %s", err_str);
-    close(tun_fd);
+    close_tun();
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -490,7 +786,7 @@ int gw::setup_if_addr4(uint32_t ip_addr, char* err_str)
     if (0 > ioctl(sock, SIOCSIFADDR, &ifr)) {
       err_str = strerror(errno);
       logger.debug("Failed to set socket address: %s", err_str);
-      close(tun_fd);
+      close_tun();
       return SRSRAN_ERROR_CANT_START;
     }
     ifr.ifr_netmask.sa_family = AF_INET;
@@ -505,7 +801,7 @@ int gw::setup_if_addr4(uint32_t ip_addr, char* err_str)
     if (0 > ioctl(sock, SIOCSIFNETMASK, &ifr)) {
       err_str = strerror(errno);
       logger.debug("Failed to set socket netmask: %s", err_str);
-      close(tun_fd);
+      close_tun();
       return SRSRAN_ERROR_CANT_START;
     }
     current_ip_addr = ip_addr;
@@ -0,0 +1,260 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/srslog/srslog.h"
+#include "srsue/hdr/stack/upper/gw.h"
+
+#include <arpa/inet.h>
+#include <getopt.h>
+#include <linux/ip.h>
+#include <netinet/udp.h>
+#include <thread>
+#include <unistd.h>
+
+/*
+ * UDP flows are sent from sockets of the UE address to a peer routed through the TUN. The dummy stack gets the
+ * packets from the GW, swaps their addresses and ports and writes them back as DL PDUs, so that they reach the
+ * sending sockets again. No radio is involved, the throughput is the one of the GW and the TUN.
+ */
+
+static uint32_t    duration_ms = 1000;
+static uint32_t    nof_flows   = 8;
+static uint32_t    nof_queues  = 0; // all the configurations when zero
+static int         offload     = -1;
+static uint32_t    pkt_size    = 1400;
+static const char* ue_addr     = "172.31.254.2";
+static const char* peer_addr   = "172.31.254.1";
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [dfqos]\n", prog);
+  printf("\t-d Duration of every configuration in ms [Default %d]\n", duration_ms);
+  printf("\t-f Number of UDP flows [Default %d]\n", nof_flows);
+  printf("\t-q Number of TUN queues [Default 1 and 4]\n");
+  printf("\t-o Segmentation offload, 0 or 1 [Default both]\n");
+  printf("\t-s UDP payload size [Default %d]\n", pkt_size);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "dfqos")) != -1) {
+    switch (opt) {
+      case 'd':
+        duration_ms = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        nof_flows = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'q':
+        nof_queues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        offload = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        pkt_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint16_t checksum(const uint8_t* data, uint32_t len, uint32_t sum)
+{
+  for (uint32_t i = 0; i + 1 < len; i += 2) {
+    sum += (data[i] << 8U) | data[i + 1];
+  }
+  if (len % 2 != 0) {
+    sum += data[len - 1] << 8U;
+  }
+  while (sum >> 16U) {
+    sum = (sum & 0xffff) + (sum >> 16U);
+  }
+  return ~sum & 0xffff;
+}
+
+class loopback_stack : public srsue::stack_interface_gw
+{
+public:
+  bool is_registered() { return true; }
+  bool start_service_request() { return true; };
+  bool has_active_radio_bearer(uint32_t eps_bearer_id) { return true; }
+
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu)
+  {
+    // Drop the packets sent by the kernel on its own, as IPv6 neighbour discovery
+    struct iphdr* ip_pkt = (struct iphdr*)sdu->msg;
+    if (ip_pkt->version != 4 || ip_pkt->protocol != IPPROTO_UDP) {
+      return;
+    }
+    if (ntohs(ip_pkt->tot_len) != sdu->N_bytes) {
+      nof_errors++;
+      return;
+    }
+
+    // The segments split by the GW must carry valid checksums
+    uint32_t ihl     = ip_pkt->ihl * 4;
+    uint32_t udp_len = sdu->N_bytes - ihl;
+    uint32_t pseudo  = IPPROTO_UDP + udp_len;
+    for (uint32_t i = 12; i < 20; i += 2) {
+      pseudo += (sdu->msg[i] << 8U) | sdu->msg[i + 1];
+    }
+    struct udphdr* udp_pkt = (struct udphdr*)&sdu->msg[ihl];
+    if (checksum(sdu->msg, ihl, 0) != 0 || checksum(&sdu->msg[ihl], udp_len, pseudo) != 0 ||
+        ntohs(udp_pkt->len) != udp_len) {
+      nof_errors++;
+      return;
+    }
+    nof_ul_pkts++;
+    nof_ul_bytes += sdu->N_bytes;
+
+    // Swapping the addresses and the ports keeps the checksums
+    std::swap(ip_pkt->saddr, ip_pkt->daddr);
+    std::swap(udp_pkt->source, udp_pkt->dest);
+    gw->write_pdu(lcid, std::move(sdu));
+  }
+
+  srsue::gw*            gw = nullptr;
+  std::atomic<uint64_t> nof_ul_pkts{0};
+  std::atomic<uint64_t> nof_ul_bytes{0};
+  std::atomic<uint64_t> nof_errors{0};
+};
+
+/// Sends a flow in batches of UDP segments, and receives the packets looped back by the stack
+static void run_flow(uint32_t flow, std::atomic<bool>& run, std::atomic<uint64_t>& nof_dl_pkts)
+{
+  int sock = socket(AF_INET, SOCK_DGRAM, 0);
+  TESTASSERT(sock >= 0);
+
+  struct sockaddr_in addr = {};
+  addr.sin_family         = AF_INET;
+  inet_pton(AF_INET, ue_addr, &addr.sin_addr);
+  int ret = bind(sock, (struct sockaddr*)&addr, sizeof(addr));
+  TESTASSERT(ret == 0);
+  addr.sin_port = htons(40000 + flow);
+  inet_pton(AF_INET, peer_addr, &addr.sin_addr);
+  ret = connect(sock, (struct sockaddr*)&addr, sizeof(addr));
+  TESTASSERT(ret == 0);
+
+  // The kernel splits the batches, or hands them whole to the TUN when it takes UDP segmentation offload
+  int segment = pkt_size;
+  ret         = setsockopt(sock, IPPROTO_UDP, UDP_SEGMENT, &segment, sizeof(segment));
+  TESTASSERT(ret == 0);
+
+  const uint32_t       nof_segments = 32;
+  std::vector<uint8_t> tx_buf(pkt_size * nof_segments, (uint8_t)flow);
+  std::vector<uint8_t> rx_buf(65536);
+  while (run) {
+    send(sock, tx_buf.data(), tx_buf.size(), MSG_DONTWAIT);
+    while (recv(sock, rx_buf.data(), rx_buf.size(), MSG_DONTWAIT) > 0) {
+      nof_dl_pkts++;
+    }
+    // Leave some room in the TUN queue
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  close(sock);
+}
+
+static int run_benchmark(uint32_t tun_queues, bool tun_offload)
+{
+  srsue::gw_args_t gw_args;
+  gw_args.tun_dev_name     = "tun_bench";
+  gw_args.tun_dev_netmask  = "255.255.255.0";
+  gw_args.tun_queues       = tun_queues;
+  gw_args.tun_offload      = tun_offload;
+  gw_args.log.gw_level     = "warning";
+  gw_args.log.gw_hex_limit = 64;
+
+  loopback_stack stack;
+  srsue::gw      gw(srslog::fetch_basic_logger("GW"));
+  stack.gw = &gw;
+  if (gw.init(gw_args, &stack) != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  struct in_addr in_addr;
+  inet_pton(AF_INET, ue_addr, &in_addr.s_addr);
+  if (gw.setup_if_addr(5, LIBLTE_MME_PDN_TYPE_IPV4, ntohl(in_addr.s_addr), nullptr, nullptr) != SRSRAN_SUCCESS) {
+    srslog::fetch_basic_logger("TEST", false)
+        .error("Failed to setup GW interface. Not possible to run the benchmark. Try to execute with sudo rights.");
+    gw.stop();
+    return SRSRAN_ERROR;
+  }
+
+  std::atomic<bool>        run{true};
+  std::atomic<uint64_t>    nof_dl_pkts{0};
+  std::vector<std::thread> flows;
+  for (uint32_t i = 0; i < nof_flows; i++) {
+    flows.emplace_back(run_flow, i, std::ref(run), std::ref(nof_dl_pkts));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+  run = false;
+  for (std::thread& t : flows) {
+    t.join();
+  }
+  gw.stop();
+
+  double secs = duration_ms / 1e3;
+  printf("TUN queues=%d, offload=%s: UL %.0f kpps, %.1f Mbps, %.0f kpps looped back\n",
+         tun_queues,
+         tun_offload ? "yes" : "no",
+         stack.nof_ul_pkts / secs / 1e3,
+         stack.nof_ul_bytes * 8 / secs / 1e6,
+         nof_dl_pkts / secs / 1e3);
+
+  TESTASSERT(stack.nof_errors == 0);
+  TESTASSERT(stack.nof_ul_pkts > 0);
+  TESTASSERT(nof_dl_pkts > 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+  parse_args(argc, argv);
+
+  std::vector<uint32_t> queues   = {1, 4};
+  std::vector<bool>     offloads = {false, true};
+  if (nof_queues > 0) {
+    queues = {nof_queues};
+  }
+  if (offload >= 0) {
+    offloads = {offload != 0};
+  }
+
+  for (bool o : offloads) {
+    for (uint32_t q : queues) {
+      if (run_benchmark(q, o) != SRSRAN_SUCCESS) {
+        // Creating the TUN needs privileges, do not fail without them
+        return SRSRAN_SUCCESS;
+      }
+    }
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -23,8 +23,12 @@
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/int_helpers.h"
 #include "srsran/srsran.h"
+#include "srsran/upper/ipv6.h"
 #include "srsue/hdr/stack/upper/tft_packet_filter.h"
+#include <chrono>
 #include <iostream>
+#include <linux/ip.h>
+#include <random>
 
 #define TESTASSERT(cond)                                                                                               \
   {                                                                                                                    \
@@ -409,6 +413,374 @@ int tft_filter_test_ipv4_tos()
   return 0;
 }
 
+int tft_filter_test_port_range()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  srsran::unique_byte_buffer_t ip_msg1, ip_msg2;
+  ip_msg1 = make_byte_buffer();
+  TESTASSERT(ip_msg1 != nullptr);
+  ip_msg2 = make_byte_buffer();
+  TESTASSERT(ip_msg2 != nullptr);
+
+  // Filter length: 10 bytes
+  // Filter type:   Local port range, 2000 to 3000
+  // Filter type:   Remote port range, 2001 to 1024 (wrong order)
+  uint8_t filter_message[10];
+  filter_message[0] = LOCAL_PORT_RANGE_TYPE;
+  srsran::uint16_to_uint8(2000, &filter_message[1]);
+  srsran::uint16_to_uint8(3000, &filter_message[3]);
+  filter_message[5] = REMOTE_PORT_RANGE_TYPE;
+  srsran::uint16_to_uint8(2001, &filter_message[6]);
+  srsran::uint16_to_uint8(1024, &filter_message[8]);
+
+  // Set IP test message, ports 2222 and 2001
+  ip_msg1->N_bytes = ip_message_len1;
+  memcpy(ip_msg1->msg, ip_tst_message1, ip_message_len1);
+
+  // Set IP test message, ports 8000 and 9000
+  ip_msg2->N_bytes = ip_message_len2;
+  memcpy(ip_msg2->msg, ip_tst_message2, ip_message_len2);
+
+  // Packet filter
+  LIBLTE_MME_PACKET_FILTER_STRUCT packet_filter;
+
+  packet_filter.dir             = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  packet_filter.id              = 1;
+  packet_filter.eval_precedence = 0;
+  packet_filter.filter_size     = sizeof(filter_message);
+  memcpy(packet_filter.filter, filter_message, sizeof(filter_message));
+
+  srsue::tft_packet_filter_t filter(EPS_BEARER_ID, packet_filter, logger);
+
+  // Check filter
+  TESTASSERT(filter.match(ip_msg1));
+  TESTASSERT(!filter.match(ip_msg2));
+
+  printf("Test TFT packet filter port range successfull\n");
+  return 0;
+}
+
+// Header fields of the packets generated for the classifier tests, in host byte order
+struct test_packet_t {
+  uint8_t  version;
+  uint32_t saddr;
+  uint32_t daddr;
+  uint8_t  daddr6[16];
+  uint8_t  protocol;
+  uint16_t sport;
+  uint16_t dport;
+  uint8_t  tos;
+};
+
+const uint32_t test_ipv4_addrs[]     = {0x0a000001, 0x0a000002, 0x0a000101, 0xc0a80101};
+const uint8_t  test_ipv6_addrs[][16] = {{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
+                                        {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2},
+                                        {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1}};
+const uint16_t test_ports[]          = {1000, 2000, 5060, 8080};
+const uint8_t  test_protocols[]      = {UDP_PROTOCOL, TCP_PROTOCOL, 1};
+const uint8_t  test_tos[]            = {0x00, 0x04, 0xb8};
+
+template <typename T, size_t N>
+static T pick(std::mt19937& rng, const T (&values)[N])
+{
+  return values[rng() % N];
+}
+
+static void write_test_packet(const test_packet_t& p, srsran::unique_byte_buffer_t& pdu)
+{
+  uint32_t l4_offset;
+  memset(pdu->msg, 0, 64);
+  if (p.version == 4) {
+    struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
+    ip_pkt->version      = 4;
+    ip_pkt->ihl          = 5;
+    ip_pkt->tos          = p.tos;
+    ip_pkt->protocol     = p.protocol;
+    ip_pkt->saddr        = htonl(p.saddr);
+    ip_pkt->daddr        = htonl(p.daddr);
+    l4_offset            = sizeof(struct iphdr);
+  } else {
+    struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
+    ip6_pkt->version        = 6;
+    ip6_pkt->nexthdr        = p.protocol;
+    memcpy(&ip6_pkt->daddr, p.daddr6, 16);
+    l4_offset = sizeof(struct ipv6hdr);
+  }
+  srsran::uint16_to_uint8(p.sport, &pdu->msg[l4_offset]);
+  srsran::uint16_to_uint8(p.dport, &pdu->msg[l4_offset + 2]);
+  pdu->N_bytes = l4_offset + 8;
+}
+
+static test_packet_t random_test_packet(std::mt19937& rng)
+{
+  test_packet_t p = {};
+  p.version       = rng() % 3 == 0 ? 6 : 4;
+  p.saddr         = pick(rng, test_ipv4_addrs);
+  p.daddr         = pick(rng, test_ipv4_addrs);
+  memcpy(p.daddr6, test_ipv6_addrs[rng() % 3], 16);
+  p.protocol = pick(rng, test_protocols);
+  p.sport    = pick(rng, test_ports);
+  p.dport    = pick(rng, test_ports);
+  p.tos      = pick(rng, test_tos);
+  return p;
+}
+
+// Writes an IPv4 address and a mask with the given prefix length
+static uint8_t* write_ipv4_component(uint8_t* buf, uint8_t type, uint32_t addr, uint32_t prefix_len)
+{
+  uint32_t mask = prefix_len == 0 ? 0 : 0xffffffffU << (32 - prefix_len);
+  *buf++        = type;
+  srsran::uint32_to_uint8(addr, buf);
+  srsran::uint32_to_uint8(mask, buf + 4);
+  return buf + 8;
+}
+
+static uint8_t* write_port_component(std::mt19937& rng, uint8_t* buf, uint8_t single_type, uint8_t range_type)
+{
+  switch (rng() % 3) {
+    case 1:
+      *buf++ = single_type;
+      srsran::uint16_to_uint8(pick(rng, test_ports), buf);
+      return buf + 2;
+    case 2:
+      // The bounds are given in any order
+      *buf++ = range_type;
+      srsran::uint16_to_uint8(pick(rng, test_ports), buf);
+      srsran::uint16_to_uint8(pick(rng, test_ports), buf + 2);
+      return buf + 4;
+    default:
+      return buf;
+  }
+}
+
+static LIBLTE_MME_PACKET_FILTER_STRUCT random_packet_filter(std::mt19937& rng, uint8_t id, uint8_t eval_precedence)
+{
+  const uint32_t prefix_lens[]  = {0, 8, 24, 32};
+  const uint8_t  prefix6_lens[] = {0, 48, 64, 127, 128};
+
+  LIBLTE_MME_PACKET_FILTER_STRUCT packet_filter = {};
+  packet_filter.dir                             = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  packet_filter.id                              = id;
+  packet_filter.eval_precedence                 = eval_precedence;
+
+  uint8_t* buf = packet_filter.filter;
+  if (rng() % 3 == 0) {
+    buf = write_ipv4_component(buf, IPV4_LOCAL_ADDR_TYPE, pick(rng, test_ipv4_addrs), pick(rng, prefix_lens));
+  }
+  switch (rng() % 4) {
+    case 0:
+      buf = write_ipv4_component(buf, IPV4_REMOTE_ADDR_TYPE, pick(rng, test_ipv4_addrs), pick(rng, prefix_lens));
+      break;
+    case 1:
+      *buf++ = IPV6_REMOTE_ADDR_LENGTH_TYPE;
+      memcpy(buf, test_ipv6_addrs[rng() % 3], 16);
+      buf[16] = pick(rng, prefix6_lens);
+      buf += 17;
+      break;
+    case 2:
+      *buf++ = IPV6_REMOTE_ADDR_TYPE;
+      memcpy(buf, test_ipv6_addrs[rng() % 3], 16);
+      memset(buf + 16, 0xff, 16);
+      buf += 32;
+      break;
+    default:
+      break;
+  }
+  if (rng() % 2 == 0) {
+    *buf++ = PROTOCOL_ID_TYPE;
+    *buf++ = pick(rng, test_protocols);
+  }
+  buf = write_port_component(rng, buf, SINGLE_LOCAL_PORT_TYPE, LOCAL_PORT_RANGE_TYPE);
+  buf = write_port_component(rng, buf, SINGLE_REMOTE_PORT_TYPE, REMOTE_PORT_RANGE_TYPE);
+  if (rng() % 6 == 0) {
+    *buf++ = TYPE_OF_SERVICE_TYPE;
+    *buf++ = pick(rng, test_tos);
+    *buf++ = 0xfc;
+  }
+  packet_filter.filter_size = buf - packet_filter.filter;
+  return packet_filter;
+}
+
+/// Tests the filters one by one in evaluation precedence order
+static int linear_tft_match(std::map<uint16_t, tft_packet_filter_t>& filters,
+                            srsran::unique_byte_buffer_t&            pdu,
+                            uint8_t&                                 eps_bearer_id)
+{
+  for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : filters) {
+    if (filter_pair.second.match(pdu)) {
+      eps_bearer_id = filter_pair.second.eps_bearer_id;
+      return SRSRAN_SUCCESS;
+    }
+  }
+  return SRSRAN_ERROR;
+}
+
+// Applies random TFTs to several EPS bearers, and keeps a copy of the filters to test them one by one
+static void apply_random_tfts(std::mt19937&                            rng,
+                              uint32_t                                 nof_bearers,
+                              uint32_t                                 nof_filters,
+                              tft_pdu_matcher&                         matcher,
+                              std::map<uint16_t, tft_packet_filter_t>& filters)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  std::vector<uint8_t> precedences(nof_bearers * nof_filters);
+  for (uint32_t i = 0; i < precedences.size(); i++) {
+    precedences[i] = i;
+  }
+  std::shuffle(precedences.begin(), precedences.end(), rng);
+
+  for (uint32_t b = 0; b < nof_bearers; b++) {
+    LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft = {};
+    tft.tft_op_code                             = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+    tft.packet_filter_list_size                 = nof_filters;
+    for (uint32_t f = 0; f < nof_filters; f++) {
+      tft.packet_filter_list[f] = random_packet_filter(rng, f + 1, precedences[b * nof_filters + f]);
+      tft_packet_filter_t filter(EPS_BEARER_ID + b, tft.packet_filter_list[f], logger);
+      filters.insert(std::make_pair(filter.eval_precedence, filter));
+    }
+    matcher.apply_traffic_flow_template(EPS_BEARER_ID + b, &tft);
+  }
+}
+
+int tft_classifier_test_random()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+  logger.set_level(srslog::basic_levels::warning);
+
+  std::mt19937                 rng(1234);
+  srsran::unique_byte_buffer_t pdu = make_byte_buffer();
+  TESTASSERT(pdu != nullptr);
+
+  uint32_t nof_matches = 0;
+  for (uint32_t round = 0; round < 50; round++) {
+    tft_pdu_matcher                         matcher(logger);
+    std::map<uint16_t, tft_packet_filter_t> filters;
+    apply_random_tfts(rng, 1 + rng() % 8, 1 + rng() % LIBLTE_MME_PACKET_FILTER_LIST_MAX_SIZE, matcher, filters);
+
+    for (uint32_t i = 0; i < 2000; i++) {
+      write_test_packet(random_test_packet(rng), pdu);
+      uint8_t linear_bearer   = 0;
+      uint8_t compiled_bearer = 0;
+      int     linear_ret      = linear_tft_match(filters, pdu, linear_bearer);
+      int     compiled_ret    = matcher.check_tft_filter_match(pdu, compiled_bearer);
+      TESTASSERT(linear_ret == compiled_ret);
+      TESTASSERT(linear_bearer == compiled_bearer);
+      nof_matches += linear_ret == SRSRAN_SUCCESS ? 1 : 0;
+    }
+  }
+  // Both outcomes are exercised
+  TESTASSERT(nof_matches > 0 && nof_matches < 50 * 2000);
+
+  logger.set_level(srslog::basic_levels::debug);
+  printf("Test TFT classifier against the packet filters successfull\n");
+  return 0;
+}
+
+// Flow of a dedicated bearer, as an IMS media stream
+static test_packet_t benchmark_flow(uint32_t bearer, uint32_t flow)
+{
+  test_packet_t p = {};
+  p.version       = 4;
+  p.saddr         = 0xac100302;
+  p.daddr         = 0x0a000000 | (bearer << 8U) | flow;
+  p.protocol      = flow % 4 == 0 ? TCP_PROTOCOL : UDP_PROTOCOL;
+  p.sport         = 5000 + flow;
+  p.dport         = 6000 + bearer * 16 + flow;
+  return p;
+}
+
+// Compares the packets per second classified by the compiled TFTs and by testing the filters one by one
+int tft_classifier_benchmark()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+  logger.set_level(srslog::basic_levels::warning);
+
+  const uint32_t nof_bearers = 8;
+  const uint32_t nof_flows   = LIBLTE_MME_PACKET_FILTER_LIST_MAX_SIZE;
+  const uint32_t nof_packets = 1024;
+  const uint32_t nof_rounds  = 200;
+
+  // One filter per flow, with remote address, protocol and ports. Every fifth one takes a remote port range instead
+  tft_pdu_matcher                         matcher(logger);
+  std::map<uint16_t, tft_packet_filter_t> filters;
+  for (uint32_t b = 0; b < nof_bearers; b++) {
+    LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft = {};
+    tft.tft_op_code                             = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+    tft.packet_filter_list_size                 = nof_flows;
+    for (uint32_t f = 0; f < nof_flows; f++) {
+      test_packet_t                    flow          = benchmark_flow(b, f);
+      LIBLTE_MME_PACKET_FILTER_STRUCT& packet_filter = tft.packet_filter_list[f];
+      packet_filter.dir                              = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+      packet_filter.id                               = f + 1;
+      packet_filter.eval_precedence                  = b * nof_flows + f;
+
+      uint8_t* buf = write_ipv4_component(packet_filter.filter, IPV4_REMOTE_ADDR_TYPE, flow.daddr, 32);
+      *buf++       = PROTOCOL_ID_TYPE;
+      *buf++       = flow.protocol;
+      *buf++       = SINGLE_LOCAL_PORT_TYPE;
+      srsran::uint16_to_uint8(flow.sport, buf);
+      buf += 2;
+      if (f % 5 == 0) {
+        *buf++ = REMOTE_PORT_RANGE_TYPE;
+        srsran::uint16_to_uint8(flow.dport, buf);
+        srsran::uint16_to_uint8(flow.dport + 3, buf + 2);
+        buf += 4;
+      } else {
+        *buf++ = SINGLE_REMOTE_PORT_TYPE;
+        srsran::uint16_to_uint8(flow.dport, buf);
+        buf += 2;
+      }
+      packet_filter.filter_size = buf - packet_filter.filter;
+
+      tft_packet_filter_t filter(EPS_BEARER_ID + b, packet_filter, logger);
+      filters.insert(std::make_pair(filter.eval_precedence, filter));
+    }
+    matcher.apply_traffic_flow_template(EPS_BEARER_ID + b, &tft);
+  }
+
+  // A quarter of the packets belong to the dedicated bearers, the rest goes to the default bearer
+  std::mt19937                              rng(5678);
+  std::vector<srsran::unique_byte_buffer_t> pdus(nof_packets);
+  for (srsran::unique_byte_buffer_t& pdu : pdus) {
+    pdu = make_byte_buffer();
+    TESTASSERT(pdu != nullptr);
+    test_packet_t p = benchmark_flow(rng() % nof_bearers, rng() % nof_flows);
+    if (rng() % 4 != 0) {
+      p.daddr = 0x08080000 | (rng() & 0xffff);
+    }
+    write_test_packet(p, pdu);
+  }
+
+  uint32_t checksum[2] = {};
+  double   pps[2]      = {};
+  for (uint32_t m = 0; m < 2; m++) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t round = 0; round < nof_rounds; round++) {
+      for (srsran::unique_byte_buffer_t& pdu : pdus) {
+        uint8_t eps_bearer_id = 0;
+        if (m == 0) {
+          linear_tft_match(filters, pdu, eps_bearer_id);
+        } else {
+          matcher.check_tft_filter_match(pdu, eps_bearer_id);
+        }
+        checksum[m] += eps_bearer_id;
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    pps[m]                                = nof_rounds * nof_packets / elapsed.count();
+  }
+  TESTASSERT(checksum[0] == checksum[1]);
+
+  logger.set_level(srslog::basic_levels::debug);
+  printf("TFT classification of %d filters: %.2f Mpps one by one, %.2f Mpps compiled\n",
+         (int)filters.size(),
+         pps[0] / 1e6,
+         pps[1] / 1e6);
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT", false);
@@ -435,4 +807,13 @@ int main(int argc, char** argv)
   if (tft_filter_test_ipv6_combined()) {
     return -1;
   }
+  if (tft_filter_test_port_range()) {
+    return -1;
+  }
+  if (tft_classifier_test_random()) {
+    return -1;
+  }
+  if (tft_classifier_benchmark()) {
+    return -1;
+  }
 }
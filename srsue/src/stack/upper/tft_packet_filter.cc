@@ -26,10 +26,16 @@ extern "C" {
 #include "srsran/config.h"
 }
 
+#include <algorithm>
+#include <arpa/inet.h>
 #include <linux/ip.h>
 #include <linux/tcp.h>
 #include <linux/udp.h>
 
+#ifdef LV_HAVE_SSE
+#include <immintrin.h>
+#endif // LV_HAVE_SSE
+
 namespace srsue {
 
 tft_packet_filter_t::tft_packet_filter_t(uint8_t                                eps_bearer_id_,
@@ -122,8 +128,8 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
 
       case LOCAL_PORT_RANGE_TYPE:
         active_filters |= LOCAL_PORT_RANGE_FLAG;
-        memcpy(&local_port_range[0], &tft.filter[idx], 2);
-        memcpy(&local_port_range[1], &tft.filter[idx + 2], 2);
+        local_port_range[0] = (tft.filter[idx] << 8U) | tft.filter[idx + 1];
+        local_port_range[1] = (tft.filter[idx + 2] << 8U) | tft.filter[idx + 3];
         if (local_port_range[0] > local_port_range[1]) { // wrong order
           uint16_t t          = local_port_range[0];
           local_port_range[0] = local_port_range[1];
@@ -134,8 +140,8 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
 
       case REMOTE_PORT_RANGE_TYPE:
         active_filters |= REMOTE_PORT_RANGE_FLAG;
-        memcpy(&remote_port_range[0], &tft.filter[idx], 2);
-        memcpy(&remote_port_range[1], &tft.filter[idx + 2], 2);
+        remote_port_range[0] = (tft.filter[idx] << 8U) | tft.filter[idx + 1];
+        remote_port_range[1] = (tft.filter[idx + 2] << 8U) | tft.filter[idx + 3];
         if (remote_port_range[0] > remote_port_range[1]) { // wrong order
           uint16_t t           = remote_port_range[0];
           remote_port_range[0] = remote_port_range[1];
@@ -248,7 +254,7 @@ bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
     // Check match on IPv6
     if (filter_contains(IPV6_REMOTE_ADDR_FLAG | IPV6_REMOTE_ADDR_LENGTH_FLAG)) {
       bool match = true;
-      for (int i = 0; i < ipv6_remote_addr_length; i++) {
+      for (int i = 0; i < IPV6_ADDR_SIZE; i++) {
         match &= ((ipv6_remote_addr[i] ^ ip6_pkt->daddr.in6_u.u6_addr8[i]) & ipv6_remote_addr_mask[i]) == 0;
         if (!match) {
           return false;
@@ -318,78 +324,259 @@ bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
 {
   struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-  struct udphdr*  udp_pkt;
-  struct tcphdr*  tcp_pkt;
+  uint32_t        l4_offset;
+  uint8_t         protocol;
 
   if (ip_pkt->version == 4) {
-    switch (ip_pkt->protocol) {
-      case UDP_PROTOCOL:
-        udp_pkt = (struct udphdr*)&pdu->msg[ip_pkt->ihl * 4];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (udp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (udp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      case TCP_PROTOCOL:
-        tcp_pkt = (struct tcphdr*)&pdu->msg[ip_pkt->ihl * 4];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (tcp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (tcp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      default:
+    l4_offset = ip_pkt->ihl * 4;
+    protocol  = ip_pkt->protocol;
+  } else if (ip_pkt->version == 6) {
+    l4_offset = sizeof(ipv6hdr);
+    protocol  = ip6_pkt->nexthdr;
+  } else {
+    return true;
+  }
+
+  // The source and destination ports are at the same offset in the UDP and TCP headers
+  uint16_t local_port, remote_port;
+  switch (protocol) {
+    case UDP_PROTOCOL:
+      local_port  = ((struct udphdr*)&pdu->msg[l4_offset])->source;
+      remote_port = ((struct udphdr*)&pdu->msg[l4_offset])->dest;
+      break;
+    case TCP_PROTOCOL:
+      local_port  = ((struct tcphdr*)&pdu->msg[l4_offset])->source;
+      remote_port = ((struct tcphdr*)&pdu->msg[l4_offset])->dest;
+      break;
+    default:
+      return false;
+  }
+
+  if ((active_filters & SINGLE_LOCAL_PORT_FLAG) && local_port != single_local_port) {
+    return false;
+  }
+  if ((active_filters & SINGLE_REMOTE_PORT_FLAG) && remote_port != single_remote_port) {
+    return false;
+  }
+  if ((active_filters & LOCAL_PORT_RANGE_FLAG) &&
+      (ntohs(local_port) < local_port_range[0] || ntohs(local_port) > local_port_range[1])) {
+    return false;
+  }
+  if ((active_filters & REMOTE_PORT_RANGE_FLAG) &&
+      (ntohs(remote_port) < remote_port_range[0] || ntohs(remote_port) > remote_port_range[1])) {
+    return false;
+  }
+  return true;
+}
+
+void tft_classifier::clear()
+{
+  ipv4 = {};
+  ipv6 = {};
+}
+
+void tft_classifier::compile(const std::map<uint16_t, tft_packet_filter_t>& filters)
+{
+  clear();
+  // The filters are visited in evaluation precedence order, which keeps the buckets sorted
+  for (const std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : filters) {
+    compile_filter(filter_pair.second, 4, ipv4);
+    compile_filter(filter_pair.second, 6, ipv6);
+  }
+  for (ip_version_tables_t* v : {&ipv4, &ipv6}) {
+    std::sort(v->tables.begin(), v->tables.end(), [](const table_t& a, const table_t& b) {
+      return a.min_precedence < b.min_precedence;
+    });
+  }
+}
+
+/*
+ * Translates the components of a filter into the packet fields compared for the given IP version, following
+ * tft_packet_filter_t::match(). Components that match() ignores for that IP version are ignored here as well.
+ */
+void tft_classifier::compile_filter(const tft_packet_filter_t& filter, uint8_t ip_version, ip_version_tables_t& dest)
+{
+  const uint32_t flags      = filter.active_filters;
+  const uint32_t port_flags = SINGLE_LOCAL_PORT_FLAG | LOCAL_PORT_RANGE_FLAG | SINGLE_REMOTE_PORT_FLAG |
+                              REMOTE_PORT_RANGE_FLAG;
+  if (flags == 0) {
+    return;
+  }
+
+  rule_t rule          = {};
+  rule.eval_precedence = filter.eval_precedence;
+  rule.eps_bearer_id   = filter.eps_bearer_id;
+  key_t mask           = {};
+  key_t value          = {};
+
+  if (ip_version == 4) {
+    if (flags & IPV4_LOCAL_ADDR_FLAG) {
+      mask.w[0] |= (uint64_t)filter.ipv4_local_addr_mask << 32U;
+      value.w[0] |= (uint64_t)(filter.ipv4_local_addr & filter.ipv4_local_addr_mask) << 32U;
+    }
+    if (flags & IPV4_REMOTE_ADDR_FLAG) {
+      mask.w[0] |= filter.ipv4_remote_addr_mask;
+      value.w[0] |= filter.ipv4_remote_addr & filter.ipv4_remote_addr_mask;
+    }
+    if (flags & TYPE_OF_SERVICE_FLAG) {
+      mask.w[1] |= (uint64_t)filter.type_of_service_mask << 40U;
+      value.w[1] |= (uint64_t)(filter.type_of_service & filter.type_of_service_mask) << 40U;
+    }
+  } else {
+    if (flags & (IPV6_REMOTE_ADDR_FLAG | IPV6_REMOTE_ADDR_LENGTH_FLAG)) {
+      rule.has_ipv6_remote_addr = true;
+      for (uint32_t i = 0; i < IPV6_ADDR_SIZE; i++) {
+        rule.ipv6_remote_addr[i]      = filter.ipv6_remote_addr[i] & filter.ipv6_remote_addr_mask[i];
+        rule.ipv6_remote_addr_mask[i] = filter.ipv6_remote_addr_mask[i];
+      }
+    }
+    if (flags & TYPE_OF_SERVICE_FLAG) {
+      // The IPv6 traffic class is not supported, the filter never matches an IPv6 packet
+      return;
+    }
+  }
+
+  if (flags & PROTOCOL_ID_FLAG) {
+    mask.w[1] |= 0xffULL << 32U;
+    value.w[1] |= (uint64_t)filter.protocol_id << 32U;
+  }
+  if (flags & port_flags) {
+    // Only UDP and TCP packets have ports
+    mask.w[1] |= 1ULL << 48U;
+    value.w[1] |= 1ULL << 48U;
+  }
+  if (flags & SINGLE_LOCAL_PORT_FLAG) {
+    mask.w[1] |= 0xffffULL;
+    value.w[1] |= filter.single_local_port;
+  }
+  if (flags & SINGLE_REMOTE_PORT_FLAG) {
+    mask.w[1] |= 0xffffULL << 16U;
+    value.w[1] |= (uint64_t)filter.single_remote_port << 16U;
+  }
+  if (flags & LOCAL_PORT_RANGE_FLAG) {
+    rule.has_local_port_range = true;
+    rule.local_port_range[0]  = filter.local_port_range[0];
+    rule.local_port_range[1]  = filter.local_port_range[1];
+  }
+  if (flags & REMOTE_PORT_RANGE_FLAG) {
+    rule.has_remote_port_range = true;
+    rule.remote_port_range[0]  = filter.remote_port_range[0];
+    rule.remote_port_range[1]  = filter.remote_port_range[1];
+  }
+
+  auto table = std::find_if(dest.tables.begin(), dest.tables.end(), [&mask](const table_t& t) {
+    return t.mask == mask;
+  });
+  if (table == dest.tables.end()) {
+    dest.tables.emplace_back();
+    table                 = dest.tables.end() - 1;
+    table->mask           = mask;
+    table->min_precedence = rule.eval_precedence;
+  }
+  table->buckets[value].push_back(dest.rules.size());
+  dest.rules.push_back(rule);
+}
+
+bool tft_classifier::match_rule(const rule_t&  rule,
+                                uint16_t       local_port,
+                                uint16_t       remote_port,
+                                const uint8_t* ipv6_daddr)
+{
+  if (rule.has_local_port_range &&
+      (ntohs(local_port) < rule.local_port_range[0] || ntohs(local_port) > rule.local_port_range[1])) {
+    return false;
+  }
+  if (rule.has_remote_port_range &&
+      (ntohs(remote_port) < rule.remote_port_range[0] || ntohs(remote_port) > rule.remote_port_range[1])) {
+    return false;
+  }
+  if (rule.has_ipv6_remote_addr) {
+#ifdef LV_HAVE_SSE
+    __m128i addr = _mm_loadu_si128((const __m128i*)ipv6_daddr);
+    __m128i mask = _mm_loadu_si128((const __m128i*)rule.ipv6_remote_addr_mask);
+    __m128i pfx  = _mm_loadu_si128((const __m128i*)rule.ipv6_remote_addr);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(addr, mask), pfx)) != 0xffff) {
+      return false;
+    }
+#else  // LV_HAVE_SSE
+    for (uint32_t i = 0; i < IPV6_ADDR_SIZE; i++) {
+      if ((ipv6_daddr[i] & rule.ipv6_remote_addr_mask[i]) != rule.ipv6_remote_addr[i]) {
         return false;
+      }
     }
+#endif // LV_HAVE_SSE
+  }
+  return true;
+}
+
+bool tft_classifier::classify(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id) const
+{
+  struct iphdr*              ip_pkt  = (struct iphdr*)pdu->msg;
+  struct ipv6hdr*            ip6_pkt = (struct ipv6hdr*)pdu->msg;
+  const ip_version_tables_t* v       = nullptr;
+  const uint8_t*             daddr   = nullptr;
+  uint32_t                   l4_offset;
+  uint8_t                    protocol;
+  key_t                      key = {};
+
+  // Extract every field compared by the filters at once
+  if (ip_pkt->version == 4) {
+    v         = &ipv4;
+    l4_offset = ip_pkt->ihl * 4;
+    protocol  = ip_pkt->protocol;
+    key.w[0]  = ((uint64_t)ip_pkt->saddr << 32U) | ip_pkt->daddr;
+    key.w[1]  = (uint64_t)ip_pkt->tos << 40U;
   } else if (ip_pkt->version == 6) {
-    switch (ip6_pkt->nexthdr) {
-      case UDP_PROTOCOL:
-        udp_pkt = (struct udphdr*)&pdu->msg[sizeof(ipv6hdr)];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (udp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (udp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
+    v         = &ipv6;
+    l4_offset = sizeof(ipv6hdr);
+    protocol  = ip6_pkt->nexthdr;
+    daddr     = ip6_pkt->daddr.in6_u.u6_addr8;
+  } else {
+    return false;
+  }
+  key.w[1] |= (uint64_t)protocol << 32U;
+
+  // The source and destination ports are at the same offset in the UDP and TCP headers
+  uint16_t local_port  = 0;
+  uint16_t remote_port = 0;
+  if (protocol == UDP_PROTOCOL || protocol == TCP_PROTOCOL) {
+    const struct udphdr* udp_pkt = (const struct udphdr*)&pdu->msg[l4_offset];
+    local_port                   = udp_pkt->source;
+    remote_port                  = udp_pkt->dest;
+    key.w[1] |= (1ULL << 48U) | ((uint64_t)remote_port << 16U) | local_port;
+  }
+
+  // The tables are visited in precedence order, a table is skipped once it cannot improve on the current match
+  uint32_t best = UINT32_MAX;
+  for (const table_t& table : v->tables) {
+    if (table.min_precedence >= best) {
+      break;
+    }
+    key_t masked = {{key.w[0] & table.mask.w[0], key.w[1] & table.mask.w[1]}};
+    auto  bucket = table.buckets.find(masked);
+    if (bucket == table.buckets.end()) {
+      continue;
+    }
+    for (uint32_t idx : bucket->second) {
+      const rule_t& rule = v->rules[idx];
+      if (rule.eval_precedence >= best) {
         break;
-      case TCP_PROTOCOL:
-        tcp_pkt = (struct tcphdr*)&pdu->msg[sizeof(ipv6hdr)];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (tcp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (tcp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
+      }
+      if (match_rule(rule, local_port, remote_port, daddr)) {
+        best          = rule.eval_precedence;
+        eps_bearer_id = rule.eps_bearer_id;
         break;
-      default:
-        return false;
+      }
     }
   }
-  return true;
+  return best != UINT32_MAX;
 }
 
 void tft_pdu_matcher::reset()
 {
+  std::lock_guard<std::mutex> lock(tft_mutex);
   tft_filter_map.clear();
+  classifier.clear();
 }
 
 /**
@@ -402,6 +589,20 @@ void tft_pdu_matcher::reset()
 int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
+  if (tft_filter_map.empty()) {
+    return SRSRAN_ERROR;
+  }
+
+  struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
+  if (ip_pkt->version == 4 || ip_pkt->version == 6) {
+    if (classifier.classify(pdu, eps_bearer_id)) {
+      logger.debug("Found filter match -- EPS bearer Id %d", eps_bearer_id);
+      return SRSRAN_SUCCESS;
+    }
+    return SRSRAN_ERROR;
+  }
+
+  // Only IP packets are compiled, anything else is tested filter by filter
   for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
     bool match = filter_pair.second.match(pdu);
     if (match) {
@@ -428,6 +629,7 @@ void tft_pdu_matcher::delete_tft_for_eps_bearer(const uint8_t eps_bearer_id)
   if (old_filter != tft_filter_map.end()) {
     logger.debug("Deleting TFT for EPS bearer %d", eps_bearer_id);
     tft_filter_map.erase(old_filter);
+    classifier.compile(tft_filter_map);
   }
 }
 
@@ -435,6 +637,15 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
                                                  const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
+  int                         ret = update_tft_filter_map(eps_bearer_id, tft);
+  // The filters applied before an error stay in place, so the classifier is compiled in any case
+  classifier.compile(tft_filter_map);
+  return ret;
+}
+
+int tft_pdu_matcher::update_tft_filter_map(const uint8_t&                                 eps_bearer_id,
+                                           const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft)
+{
   switch (tft->tft_op_code) {
     case LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT:
       for (int i = 0; i < tft->packet_filter_list_size; i++) {
@@ -35,6 +35,7 @@
 #include <srsenb/hdr/stack/mac/common/mac_metrics.h>
 #include <srsran/adt/circular_array.h>
 #include <srsran/common/phy_cfg_nr.h>
+#include <srsran/common/slot_point.h>
 #include <srsran/common/standard_streams.h>
 #include <srsran/common/string_helpers.h>
 #include <srsran/interfaces/gnb_interfaces.h>
@@ -74,6 +75,7 @@ public:
     uint32_t                            cqi_valid_count = 0;  ///< Valid CQI counter
     pucch_metrics_t                     pucch           = {};
     pucch_metrics_t                     pusch           = {};
+    uint32_t                            ul_unordered    = 0; ///< UL results delivered after those of a later slot
   };
 
 private:
@@ -100,8 +102,21 @@ private:
   bool                            wait_preamble     = false;
   std::atomic<bool>               enable_user_sched = {false};
 
-  std::mutex metrics_mutex;
-  metrics_t  metrics = {};
+  std::mutex         metrics_mutex;
+  metrics_t          metrics      = {};
+  srsran::slot_point last_ul_slot = {};
+
+  /// Counts the UL results that the PHY delivers after those of a later slot
+  void check_ul_order(const srsran_slot_cfg_t& slot_cfg)
+  {
+    std::unique_lock<std::mutex> lock(metrics_mutex);
+    srsran::slot_point           ul_slot(NUMEROLOGY_IDX, slot_cfg.idx);
+    if (last_ul_slot.valid() and ul_slot < last_ul_slot) {
+      logger.error("UL results of slot %d delivered after slot %d", ul_slot.to_uint(), last_ul_slot.to_uint());
+      metrics.ul_unordered++;
+    }
+    last_ul_slot = ul_slot;
+  }
 
   // HARQ feedback
   class pending_ack_t
@@ -653,6 +668,8 @@ public:
 
   int pucch_info(const srsran_slot_cfg_t& slot_cfg, const pucch_info_t& pucch_info) override
   {
+    check_ul_order(slot_cfg);
+
     if (not use_dummy_mac) {
       mac->pucch_info(slot_cfg, pucch_info);
     } else {
@@ -689,6 +706,8 @@ public:
 
   int pusch_info(const srsran_slot_cfg_t& slot_cfg, pusch_info_t& pusch_info) override
   {
+    check_ul_order(slot_cfg);
+
     if (not use_dummy_mac) {
       mac->pusch_info(slot_cfg, pusch_info);
     } else {
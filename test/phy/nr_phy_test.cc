@@ -89,11 +89,13 @@ test_bench::args_t::args_t(int argc, char** argv)
         ;
 
   options_gnb_phy.add_options()
-        ("gnb.phy.nof_threads",     bpo::value<uint32_t>(&gnb_phy.nof_phy_threads)->default_value(1),          "Number of threads")
-        ("gnb.phy.log.level",       bpo::value<std::string>(&gnb_phy.log.phy_level)->default_value("warning"), "gNb PHY log level")
-        ("gnb.phy.log.hex_limit",   bpo::value<int>(&gnb_phy.log.phy_hex_limit)->default_value(0),             "gNb PHY log hex limit")
-        ("gnb.phy.log.id_preamble", bpo::value<std::string>(&gnb_phy.log.id_preamble)->default_value("GNB/"),  "gNb PHY log ID preamble")
-        ("gnb.phy.pusch.max_iter",  bpo::value<uint32_t>(&gnb_phy.pusch_max_its)->default_value(10),      "PUSCH LDPC max number of iterations")
+        ("gnb.phy.nof_threads",       bpo::value<uint32_t>(&gnb_phy.nof_phy_threads)->default_value(1),          "Number of threads")
+        ("gnb.phy.log.level",         bpo::value<std::string>(&gnb_phy.log.phy_level)->default_value("warning"), "gNb PHY log level")
+        ("gnb.phy.log.hex_limit",     bpo::value<int>(&gnb_phy.log.phy_hex_limit)->default_value(0),             "gNb PHY log hex limit")
+        ("gnb.phy.log.id_preamble",   bpo::value<std::string>(&gnb_phy.log.id_preamble)->default_value("GNB/"),  "gNb PHY log ID preamble")
+        ("gnb.phy.pusch.max_iter",    bpo::value<uint32_t>(&gnb_phy.pusch_max_its)->default_value(10),           "PUSCH LDPC max number of iterations")
+        ("gnb.phy.pusch.dec_threads", bpo::value<uint32_t>(&gnb_phy.pusch_dec_threads)->default_value(0),        "PUSCH LDPC decoder threads, 0 or 1 for the worker thread")
+        ("gnb.phy.pipeline_ul",       bpo::value<bool>(&gnb_phy.pipeline_ul)->default_value(false),              "Decode the UL slot after releasing the DL slot")
         ;
 
   options_ue_phy.add_options()
@@ -439,6 +441,9 @@ int main(int argc, char** argv)
   srsran::console("   +------------+------------+------------+------------+------------+\n");
 
   // Assert metrics
+  srsran_assert(metrics.gnb_stack.ul_unordered == 0,
+                "%d UL results were delivered to the stack after those of a later slot",
+                metrics.gnb_stack.ul_unordered);
   srsran_assert(metrics.gnb_stack.mac.tx_pkts == 0 or pdsch_bler <= assert_pdsch_bler_max,
                 "PDSCH BLER (%f) exceeds the assertion maximum (%f)",
                 pdsch_bler,